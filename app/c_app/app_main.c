@@ -32,6 +32,7 @@
 #include "esp_event.h"              /* Use ESP event APIs */
 #include "mbzpl_req_m.h"            /* Use Modbus communication */
 #include "srvc_recovery.h"          /* Restore cooking data from power interruption */
+#include "srvc_rt_log.h"            /* Store realtime measurements */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -104,6 +105,9 @@ static void v_MAIN_Init (void)
     /* Initialize MicroPython service */
     s8_MP_Init ();
 
+    /* Initialize the store of realtime measurements, which uses LittleFS storage mounted by MicroPython service */
+    s32_RTLOG_Store_Init ();
+
     /* Initialize Mobus */
     MAL_REQ_init ();
 
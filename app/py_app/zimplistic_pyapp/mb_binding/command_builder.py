@@ -62,3 +62,53 @@ class CommandBuilder(object):
         self._payload.append((q16_value >> 8) & 0xFF)
         self._payload.append((q16_value >> 16) & 0xFF)
         self._payload.append((q16_value >> 24) & 0xFF)
+
+
+##
+# @brief
+# This class is used to combine several commands into one batch command, so that they are exchanged with the
+# slave board in a single modbus transaction.
+#
+# @details
+#       Batch command layout: | 0x30 | count | len 1 | command 1 | len 2 | command 2 | ... |
+#       The slave board answers with a batch response of the same layout, which is split by the C layer into one
+#       response message per command.
+# ##
+
+
+class BatchCommandBuilder(object):
+    ## Function code of batch command
+    BATCH_REQCODE = 0x30
+
+    ## Maximum length in bytes of a message sent to the C layer
+    MAX_LEN = 128
+
+    def __init__(self):
+        """
+        Constructor
+        """
+        self._payload = [self.BATCH_REQCODE, 0]
+
+    def build(self):
+        """
+        To return the payload which can be sent to the modbus.
+        """
+        return self._payload
+
+    def count(self):
+        """
+        To return number of commands in the batch.
+        """
+        return self._payload[1]
+
+    def add_command(self, command):
+        """
+        This function appends a command built by CommandBuilder to the batch.
+        Returns False if the command doesn't fit into the batch.
+        """
+        if (len(command) == 0) or (len(command) > 0xFF) or (len(self._payload) + 1 + len(command) > self.MAX_LEN):
+            return False
+        self._payload.append(len(command))
+        self._payload.extend(command)
+        self._payload[1] += 1
+        return True
@@ -2,6 +2,7 @@
 command_sender
 """
 import cmp_queue
+import utime
 
 ##
 # @brief
@@ -33,4 +34,77 @@ def send_command(buf, tout):
             break
         response = cmp_queue.exchange_bytes(buf, tout)
         cnt += 1
-    return response
\ No newline at end of file
+    return response
+
+
+##
+# @brief
+#      Send buffer to modbus and get the response without copying it.
+#
+#
+# @details
+#      This function works like send_command() but the response is a memoryview over the frame buffer on C layer,
+#       so no new object is allocated for each response. It is intended for commands polled at high rate. The
+#       response must be given back with cmp_queue.release_frame() as soon as it has been decoded, and must not be
+#       used after that.
+#
+# @param [in]
+#       buf: buffer to be sent to the modbus.
+# @param [in]
+#       tout: waiting time in miliseconds for the response from slave board.
+#
+# @return
+#      @arg    response: memoryview of the responded frame from the slave.
+# @return
+#      @arg    None: if there's any error.
+# ##
+def send_command_frame(buf, tout):
+    cnt = 0
+    response = cmp_queue.exchange_frame(buf, tout)
+    while (not response):
+        # try to resend the command
+        if cnt >= 3:
+            break
+        response = cmp_queue.exchange_frame(buf, tout)
+        cnt += 1
+    return response
+
+
+##
+# @brief
+#      Send a batch command to modbus.
+#
+#
+# @details
+#       This function sends a batch command built by BatchCommandBuilder and collects one response per command
+#       in the batch. The responses are returned in the same order as the commands were added to the batch.
+#       If the batch fails part-way, the sub-responses already received by cmp_queue are discarded by the next
+#       exchange, so they are never taken for the response to another command.
+#
+# @param [in]
+#       buf: batch command to be sent to the modbus.
+# @param [in]
+#       count: number of commands in the batch.
+# @param [in]
+#       tout: waiting time in miliseconds for all responses from slave board.
+#
+# @return
+#      @arg    responses: list of responded buffers from the slave.
+# @return
+#      @arg    None: if not all responses are received in time.
+# ##
+def send_batch_command(buf, count, tout):
+    deadline = utime.ticks_add(utime.ticks_ms(), tout)
+    response = cmp_queue.exchange_bytes(buf, tout)
+    if not response:
+        return None
+    responses = [response]
+    while len(responses) < count:
+        remaining = utime.ticks_diff(deadline, utime.ticks_ms())
+        if remaining <= 0:
+            return None
+        response = cmp_queue.receive_bytes(remaining)
+        if not response:
+            return None
+        responses.append(response)
+    return responses
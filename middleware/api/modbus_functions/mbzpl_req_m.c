@@ -81,7 +81,31 @@
  */
 #define MB_ZPL_REQ2F                        (0x2F)
 
-/** @brief  Maximum size in bytes of the message received from C environment */
+/*! \ingroup mbzpl_req_m
+ * \brief Batch Function code
+ *
+ * The PDU carries several ZPL sub-requests so that they are exchanged with the
+ * slave in one Modbus transaction. Request and response have the same layout:
+ *
+ *   | 0x30 | count | len 1 | sub-PDU 1 | len 2 | sub-PDU 2 | ... |
+ *
+ * Each sub-PDU is a complete ZPL PDU starting with its function code. The
+ * sub-responses are dispatched to the handlers in MB_ZPL_FUNC_TABLE in the
+ * order they appear in the response.
+ */
+#define MB_ZPL_REQ30                        (0x30)
+
+/*! \ingroup mbzpl_req_m
+ * \brief Offset of the number of sub-requests in a batch PDU.
+ */
+#define MB_ZPL_BATCH_COUNT_OFFSET           (0x01)
+
+/*! \ingroup mbzpl_req_m
+ * \brief Size of the batch PDU header (function code and number of sub-requests).
+ */
+#define MB_ZPL_BATCH_HDR_LEN                (0x02)
+
+/** @brief  Maximum size in bytes of the message received from MicroPython environment */
 #define MP_MAX_C_MSG_LEN                    128
 
 /* ----------------------- Static variables ------------------------------------------*/
@@ -102,6 +126,7 @@ eMBException eMBZplRequest23( UCHAR * pucFrame, USHORT * usLen );
 eMBException eMBZplRequest24( UCHAR * pucFrame, USHORT * usLen );
 eMBException eMBZplRequest25( UCHAR * pucFrame, USHORT * usLen );
 eMBException eMBZplRequest2F( UCHAR * pucFrame, USHORT * usLen );
+eMBException eMBZplRequest30( UCHAR * pucFrame, USHORT * usLen );
 BOOL mbzpl_register_all(void);
 
 static xMBFunctionHandler const MB_ZPL_FUNC_TABLE[] = {
@@ -116,7 +141,8 @@ static xMBFunctionHandler const MB_ZPL_FUNC_TABLE[] = {
         { MB_ZPL_REQ23, eMBZplRequest23},
         { MB_ZPL_REQ24, eMBZplRequest24},
         { MB_ZPL_REQ25, eMBZplRequest25},
-        { MB_ZPL_REQ2F, eMBZplRequest2F}
+        { MB_ZPL_REQ2F, eMBZplRequest2F},
+        { MB_ZPL_REQ30, eMBZplRequest30}
 };
 /* ----------------------- Start implementation -----------------------------*/
 eMBMasterReqErrCode mbzpl_MasterSendReq(UCHAR ucSndAddr, LONG lTimeOut, USHORT usLength, UCHAR *ucBufPtr)
@@ -296,7 +322,11 @@ eMBException eMBZplRequest( UCHAR * pucFrame, USHORT * usLen )
     (void)reqcode;
     (void)subcode;
 
-    s8_MP_Que_Send_To_MP(pucFrame, *usLen);
+    /* The frame pool of MicroPython may be exhausted, the response is then lost */
+    if (s8_MP_Que_Send_To_MP(pucFrame, *usLen) != MP_OK) {
+        ESP_LOGW(TAG, "Failed to deliver response 0x%02X/0x%02X to MicroPython", reqcode, subcode);
+        eStatus = MB_EX_SLAVE_BUSY;
+    }
 
     return eStatus;
 }
@@ -363,4 +393,76 @@ eMBException eMBZplRequest2F( UCHAR * pucFrame, USHORT * usLen )
     return eMBZplRequest(pucFrame, usLen);
 }
 
+static xMBFunctionHandler const * pxMBZplFindHandler( UCHAR ucFunctionCode )
+{
+    uint32_t tableEntryCnt = sizeof(MB_ZPL_FUNC_TABLE) / sizeof(MB_ZPL_FUNC_TABLE[0]);
+    uint32_t i = 0;
+
+    /* Batches can't be nested */
+    if (ucFunctionCode == MB_ZPL_REQ30) {
+        return NULL;
+    }
+
+    for (i = 0; i < tableEntryCnt; i++) {
+        if (MB_ZPL_FUNC_TABLE[i].ucFunctionCode == ucFunctionCode) {
+            return &MB_ZPL_FUNC_TABLE[i];
+        }
+    }
+    return NULL;
+}
+
+eMBException eMBZplRequest30( UCHAR * pucFrame, USHORT * usLen )
+{
+    eMBException    eStatus = MB_EX_NONE;
+    eMBException    eSubStatus;
+    xMBFunctionHandler const * pxEntry;
+    UCHAR           *pucSubFrame;
+    USHORT          usSubLen;
+    USHORT          usPos = MB_ZPL_BATCH_HDR_LEN;
+    UCHAR           ucNumRes;
+    UCHAR           i;
+
+    if (*usLen < MB_ZPL_BATCH_HDR_LEN) {
+        ESP_LOGE(TAG, "Batch response too short (%d bytes)", *usLen);
+        return MB_EX_ILLEGAL_DATA_VALUE;
+    }
+    ucNumRes = pucFrame[MB_ZPL_BATCH_COUNT_OFFSET];
+
+    for (i = 0; i < ucNumRes; i++) {
+        /* Validate length of the sub-response before touching it */
+        if (usPos >= *usLen) {
+            ESP_LOGE(TAG, "Batch response truncated at sub-response %d/%d", i, ucNumRes);
+            return MB_EX_ILLEGAL_DATA_VALUE;
+        }
+        usSubLen = pucFrame[usPos++];
+        if ((usSubLen == 0) || (usPos + usSubLen > *usLen)) {
+            ESP_LOGE(TAG, "Invalid length %d of sub-response %d/%d", usSubLen, i, ucNumRes);
+            return MB_EX_ILLEGAL_DATA_VALUE;
+        }
+        pucSubFrame = &pucFrame[usPos];
+        usPos += usSubLen;
+
+        /* Fan the sub-response out to its handler. Exceptions and unknown codes are forwarded as is,
+         * so that the application still receives one response per sub-request. */
+        pxEntry = pxMBZplFindHandler(pucSubFrame[REQ_MAL_CODE_OFFSET]);
+        if (pxEntry != NULL) {
+            eSubStatus = pxEntry->pxHandler(pucSubFrame, &usSubLen);
+        } else {
+            eSubStatus = eMBZplRequest(pucSubFrame, &usSubLen);
+        }
+        if (eSubStatus == MB_EX_SLAVE_BUSY) {
+            /* MicroPython is not reading the responses fast enough, the next ones would be lost as well. The
+             * sub-responses already delivered are discarded by the next exchange of MicroPython. */
+            ESP_LOGE(TAG, "Batch failed, %d/%d sub-responses delivered to MicroPython", i, ucNumRes);
+            return eSubStatus;
+        }
+        if (eSubStatus != MB_EX_NONE) {
+            ESP_LOGE(TAG, "Sub-response 0x%02X of batch failed (%d)", pucSubFrame[REQ_MAL_CODE_OFFSET], eSubStatus);
+            eStatus = eSubStatus;
+        }
+    }
+
+    return eStatus;
+}
+
 #endif /* #if defined(CONFIG_MODBUS_ZPL_MASTER) */
@@ -36,6 +36,11 @@
 #include "extmod/vfs.h"
 #include "shared/timeutils/timeutils.h"
 
+#if LFS_BUILD_VERSION == 2 && defined(LFS2_THREADSAFE)
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#endif
+
 STATIC int MP_VFS_LFSx(dev_ioctl)(const struct LFSx_API (config) * c, int cmd, int arg, bool must_return_int) {
     mp_obj_t ret = mp_vfs_blockdev_ioctl(c->context, cmd, arg);
     int ret_i = 0;
@@ -61,6 +66,24 @@ STATIC int MP_VFS_LFSx(dev_sync)(const struct LFSx_API (config) * c) {
     return MP_VFS_LFSx(dev_ioctl)(c, MP_BLOCKDEV_IOCTL_SYNC, 0, false);
 }
 
+#if LFS_BUILD_VERSION == 2 && defined(LFS2_THREADSAFE)
+// The filesystem is also used by other tasks through g_px_lfs2, so every LittleFS call of any task takes this mutex
+STATIC SemaphoreHandle_t MP_VFS_LFSx(lock_mutex) = NULL;
+STATIC StaticSemaphore_t MP_VFS_LFSx(lock_mutex_buffer);
+
+STATIC int MP_VFS_LFSx(dev_lock)(const struct LFSx_API (config) * c) {
+    (void)c;
+    xSemaphoreTake(MP_VFS_LFSx(lock_mutex), portMAX_DELAY);
+    return LFSx_MACRO(_ERR_OK);
+}
+
+STATIC int MP_VFS_LFSx(dev_unlock)(const struct LFSx_API (config) * c) {
+    (void)c;
+    xSemaphoreGive(MP_VFS_LFSx(lock_mutex));
+    return LFSx_MACRO(_ERR_OK);
+}
+#endif
+
 STATIC void MP_VFS_LFSx(init_config)(MP_OBJ_VFS_LFSx * self, mp_obj_t bdev, size_t read_size, size_t prog_size, size_t lookahead) {
     self->blockdev.flags = MP_BLOCKDEV_FLAG_FREE_OBJ;
     mp_vfs_blockdev_init(&self->blockdev, bdev);
@@ -74,6 +97,13 @@ STATIC void MP_VFS_LFSx(init_config)(MP_OBJ_VFS_LFSx * self, mp_obj_t bdev, size
     config->prog = MP_VFS_LFSx(dev_prog);
     config->erase = MP_VFS_LFSx(dev_erase);
     config->sync = MP_VFS_LFSx(dev_sync);
+    #if LFS_BUILD_VERSION == 2 && defined(LFS2_THREADSAFE)
+    if (MP_VFS_LFSx(lock_mutex) == NULL) {
+        MP_VFS_LFSx(lock_mutex) = xSemaphoreCreateMutexStatic(&MP_VFS_LFSx(lock_mutex_buffer));
+    }
+    config->lock = MP_VFS_LFSx(dev_lock);
+    config->unlock = MP_VFS_LFSx(dev_unlock);
+    #endif
 
     MP_VFS_LFSx(dev_ioctl)(config, MP_BLOCKDEV_IOCTL_INIT, 1, false); // initialise block device
     int bs = MP_VFS_LFSx(dev_ioctl)(config, MP_BLOCKDEV_IOCTL_BLOCK_SIZE, 0, true); // get block size
@@ -29,6 +29,7 @@
 
 #include "freertos/FreeRTOS.h"          /* Use FreeRTOS */
 #include "freertos/message_buffer.h"    /* Use FreeRTOS message buffer */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -36,15 +37,34 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
-/** @brief  Maximum size in bytes of the message received from C environment */
+/** @brief  Maximum size in bytes of the message sent from MicroPython to C environment */
 #define MP_MAX_C_MSG_LEN                128
 
-/** @brief  Size in bytes of the buffer sending messages from C to MicroPython */
-#define MP_QUE_C2MP_BUF_SIZE            256
-
 /** @brief  Size in bytes of the buffer sending messages from MicroPython to C */
 #define MP_QUE_MP2C_BUF_SIZE            256
 
+/** @brief  Size in bytes of a frame carrying a message from C to MicroPython (maximum size of a Modbus frame) */
+#define MP_QUE_FRAME_SIZE               256
+
+/** @brief  Number of frames in the pool carrying messages from C to MicroPython */
+#define MP_QUE_NUM_FRAMES               8
+
+/** @brief  Structure encapsulating a frame carrying a message from C to MicroPython */
+typedef struct
+{
+    bool                b_borrowed;                     //!< MicroPython is holding a memoryview of the frame
+    uint16_t            u16_len;                        //!< Length in bytes of the message in the frame
+    uint8_t             au8_data[MP_QUE_FRAME_SIZE];    //!< Message data
+} MP_frame_t;
+
+/** @brief  Types of MicroPython object that a received frame is delivered as */
+typedef enum
+{
+    MP_FRAME_AS_STR,                    //!< Copy of the frame as a string object, the frame is released immediately
+    MP_FRAME_AS_BYTES,                  //!< Copy of the frame as a bytes object, the frame is released immediately
+    MP_FRAME_AS_VIEW,                   //!< Memoryview over the frame, released by cmp_queue.release_frame()
+} MP_frame_obj_t;
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           VARIABLES SECTION
@@ -54,8 +74,14 @@
 /** @brief  Logging tag of this module */
 static const char * TAG = "Srvc_Micropy";
 
-/** @brief  Handle of the buffer sending messages from C to MicroPython */
-static MessageBufferHandle_t g_x_c2mp_buf;
+/** @brief  Pool of frames carrying messages from C to MicroPython */
+static MP_frame_t g_astru_frames[MP_QUE_NUM_FRAMES];
+
+/** @brief  Queue of indexes of the frames which are free to use */
+static QueueHandle_t g_x_free_frames;
+
+/** @brief  Queue of indexes of the frames which carry messages ready for MicroPython */
+static QueueHandle_t g_x_ready_frames;
 
 /** @brief  Handle of the buffer sending messages from MicroPython to C */
 static MessageBufferHandle_t g_x_mp2c_buf;
@@ -63,9 +89,6 @@ static MessageBufferHandle_t g_x_mp2c_buf;
 /** @brief  Buffer for send message */
 static uint8_t g_au8_tx_buf[MP_MAX_C_MSG_LEN];
 
-/** @brief  Buffer for receive message */
-static uint8_t g_au8_rx_buf[MP_MAX_C_MSG_LEN];
-
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -73,9 +96,13 @@ static uint8_t g_au8_rx_buf[MP_MAX_C_MSG_LEN];
 */
 
 static int8_t s8_MP_Que_Send_To_C (const void * pv_tx_msg, uint16_t u16_tx_len);
-static int8_t s8_MP_Que_Receive_From_C (void * pv_rx_msg, uint16_t * pu16_rx_len);
+static int8_t s8_MP_Que_Receive_From_C (uint8_t * pu8_frame, int32_t s32_timeout);
 static int8_t s8_MP_Que_Exchange_With_C (const void * pv_tx_msg, uint16_t u16_tx_len,
-                                         void * pv_rx_msg, uint16_t * pu16_rx_len, int32_t s32_timeout);
+                                         uint8_t * pu8_frame, int32_t s32_timeout);
+static void v_MP_Que_Release_Frame (uint8_t u8_frame);
+static void v_MP_Que_Discard_Ready_Frames (void);
+static mp_obj_t x_MP_Que_Frame_To_Obj (uint8_t u8_frame, MP_frame_obj_t enm_obj_type);
+static mp_obj_t x_MP_Que_Exchange_Array (mp_obj_t x_array_obj, mp_obj_t x_timeout, MP_frame_obj_t enm_obj_type);
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -97,17 +124,25 @@ static int8_t s8_MP_Que_Exchange_With_C (const void * pv_tx_msg, uint16_t u16_tx
 */
 int8_t s8_MP_Que_Init (void)
 {
-    /* Create buffer to send messages from C to MicroPython */
-    g_x_c2mp_buf = xMessageBufferCreate (MP_QUE_C2MP_BUF_SIZE);
-    if (g_x_c2mp_buf == NULL)
+    /* Create queues of the frames sending messages from C to MicroPython */
+    g_x_free_frames = xQueueCreate (MP_QUE_NUM_FRAMES, sizeof (uint8_t));
+    g_x_ready_frames = xQueueCreate (MP_QUE_NUM_FRAMES, sizeof (uint8_t));
+    if ((g_x_free_frames == NULL) || (g_x_ready_frames == NULL))
     {
-        LOGE ("Failed to create buffer sending message from C to MicroPython");
+        LOGE ("Failed to create frame pool sending message from C to MicroPython");
         return MP_ERR;
     }
 
+    /* All frames are free initially */
+    for (uint8_t u8_frame = 0; u8_frame < MP_QUE_NUM_FRAMES; u8_frame++)
+    {
+        g_astru_frames[u8_frame].b_borrowed = false;
+        xQueueSend (g_x_free_frames, &u8_frame, 0);
+    }
+
     /* Create buffer to send messages from MicroPython to C */
     g_x_mp2c_buf = xMessageBufferCreate (MP_QUE_MP2C_BUF_SIZE);
-    if (g_x_c2mp_buf == NULL)
+    if (g_x_mp2c_buf == NULL)
     {
         LOGE ("Failed to create buffer sending message from MicroPython to C");
         return MP_ERR;
@@ -116,6 +151,39 @@ int8_t s8_MP_Que_Init (void)
     return MP_OK;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gives all frames still borrowed by MicroPython back to the pool
+**
+** @details
+**      A Python program may raise an exception or be interrupted before calling cmp_queue.release_frame(). This
+**      function must be called by Srvc_Micropy task whenever no Python code is running any more (MicroPython engine
+**      is (re)initialized or a Python program has ended), so that such frames are not lost forever.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MP_Que_Reclaim_Frames (void)
+{
+    uint8_t u8_num_reclaimed = 0;
+
+    for (uint8_t u8_frame = 0; u8_frame < MP_QUE_NUM_FRAMES; u8_frame++)
+    {
+        if (g_astru_frames[u8_frame].b_borrowed)
+        {
+            g_astru_frames[u8_frame].b_borrowed = false;
+            v_MP_Que_Release_Frame (u8_frame);
+            u8_num_reclaimed++;
+        }
+    }
+
+    if (u8_num_reclaimed > 0)
+    {
+        LOGW ("%d frame(s) not released by Python program have been reclaimed", u8_num_reclaimed);
+    }
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -245,16 +313,16 @@ mp_obj_t x_MP_Send_Bytes (mp_obj_t x_array_obj)
 */
 mp_obj_t x_MP_Receive_Str (void)
 {
-    uint16_t u16_rx_len = sizeof (g_au8_rx_buf);
+    uint8_t u8_frame;
 
     /* Receive NULL-terminated string from C environment if any */
-    if (s8_MP_Que_Receive_From_C (g_au8_rx_buf, &u16_rx_len))
+    if (s8_MP_Que_Receive_From_C (&u8_frame, 0))
     {
         return mp_const_none;
     }
 
     /* Successful */
-    return (mp_obj_new_str ((char *)g_au8_rx_buf, u16_rx_len));
+    return x_MP_Que_Frame_To_Obj (u8_frame, MP_FRAME_AS_STR);
 }
 
 /**
@@ -269,28 +337,152 @@ mp_obj_t x_MP_Receive_Str (void)
 **      environment
 **      Example:
 **          import cmp_queue
-**          cmessage = cmp_queue.receive_bytes()
+**          cmessage = cmp_queue.receive_bytes(100)
 **          if not cmessage is None:
 **              print(cmessage)
 **
+** @param [in]
+**      x_args: Number of arguments
+**
+** @param [in]
+**      px_args: Arguments
+**      @arg    px_args[0]: (optional) Timeout in milliseconds waiting for a message, the function returns immediately
+**                          if this is omitted or 0, it waits forever if this is cmp_queue.WAIT_FOREVER or < 0
+**
 ** @return
 **      @arg    None: no receive message is available
 **      @arg    bytes object: receive message from C
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-mp_obj_t x_MP_Receive_Bytes (void)
+mp_obj_t x_MP_Receive_Bytes (size_t x_args, const mp_obj_t * px_args)
 {
-    uint16_t u16_rx_len = sizeof (g_au8_rx_buf);
+    uint8_t u8_frame;
+
+    /* Validate data type */
+    if ((x_args > 0) && !mp_obj_is_int (px_args[0]))
+    {
+        mp_raise_msg (&mp_type_TypeError, "Wait time must be an integer number");
+        return mp_const_none;
+    }
 
     /* Receive uint8_t array message from C environment if any */
-    if (s8_MP_Que_Receive_From_C (g_au8_rx_buf, &u16_rx_len))
+    if (s8_MP_Que_Receive_From_C (&u8_frame, (x_args > 0) ? mp_obj_get_int (px_args[0]) : 0))
+    {
+        return mp_const_none;
+    }
+
+    /* Successful */
+    return x_MP_Que_Frame_To_Obj (u8_frame, MP_FRAME_AS_BYTES);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Binds function cmp_queue.receive_frame() in MicroPython environment to s8_MP_Que_Receive_From_C() in C
+**      environment
+**
+** @details
+**      This function works like cmp_queue.receive_bytes() but the message is not copied. The returned memoryview
+**      refers directly to the frame in the pool, so no object of the message size is allocated on the MicroPython
+**      heap. The frame must be given back with cmp_queue.release_frame() as soon as the message has been processed,
+**      otherwise the pool runs out of frames and further messages from C are dropped.
+**      Example:
+**          import cmp_queue
+**          frame = cmp_queue.receive_frame(100)
+**          if not frame is None:
+**              print(bytes(frame))
+**              cmp_queue.release_frame(frame)
+**
+** @param [in]
+**      x_timeout: Timeout (in milliseconds) waiting for a message.
+**      @arg    0: no timeout, check receive queue and return immediately
+**      @arg    cmp_queue.WAIT_FOREVER or < 0: wait until a receive message is available
+**      @arg    > 0: if a receive message is available within x_timeout milliseconds, get the message and return.
+**                      Otheriwse return as soon as x_timeout milliseconds expires
+**
+** @return
+**      @arg    None: no receive message is available
+**      @arg    memoryview object: receive message from C
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Receive_Frame (mp_obj_t x_timeout)
+{
+    uint8_t u8_frame;
+
+    /* Validate data type */
+    if (!mp_obj_is_int (x_timeout))
+    {
+        mp_raise_msg (&mp_type_TypeError, "Wait time must be an integer number");
+        return mp_const_none;
+    }
+
+    /* Receive a frame from C environment if any */
+    if (s8_MP_Que_Receive_From_C (&u8_frame, mp_obj_get_int (x_timeout)))
     {
         return mp_const_none;
     }
 
     /* Successful */
-    return (mp_obj_new_bytes (g_au8_rx_buf, u16_rx_len));
+    return x_MP_Que_Frame_To_Obj (u8_frame, MP_FRAME_AS_VIEW);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Binds function cmp_queue.release_frame() in MicroPython environment to v_MP_Que_Release_Frame() in C
+**      environment
+**
+** @details
+**      This function gives a frame obtained by cmp_queue.receive_frame() or cmp_queue.exchange_frame() back to the
+**      pool. The memoryview (and any slice of it) must not be used after this call because the frame shall be reused
+**      for the next message from C.
+**      Example:
+**          import cmp_queue
+**          frame = cmp_queue.exchange_frame([0x11, 0x22, 0x33, 0x44], 100)
+**          if not frame is None:
+**              value = frame[2]
+**              cmp_queue.release_frame(frame)
+**
+** @param [in]
+**      x_frame_obj: memoryview object returned by cmp_queue.receive_frame() or cmp_queue.exchange_frame()
+**
+** @return
+**      @arg    None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Release_Frame (mp_obj_t x_frame_obj)
+{
+    mp_buffer_info_t x_buf_info;
+
+    /* Get the memory area referred to by the object */
+    mp_get_buffer_raise (x_frame_obj, &x_buf_info, MP_BUFFER_READ);
+
+    /* Find the frame containing the memory area */
+    for (uint8_t u8_frame = 0; u8_frame < MP_QUE_NUM_FRAMES; u8_frame++)
+    {
+        MP_frame_t * pstru_frame = &g_astru_frames[u8_frame];
+        if (((uint8_t *)x_buf_info.buf >= pstru_frame->au8_data) &&
+            ((uint8_t *)x_buf_info.buf < &pstru_frame->au8_data[MP_QUE_FRAME_SIZE]))
+        {
+            if (!pstru_frame->b_borrowed)
+            {
+                mp_raise_msg (&mp_type_ValueError, "Frame has already been released");
+            }
+
+            /* Give the frame back to the pool */
+            pstru_frame->b_borrowed = false;
+            v_MP_Que_Release_Frame (u8_frame);
+            return mp_const_none;
+        }
+    }
+
+    mp_raise_msg (&mp_type_ValueError, "Object is not a frame of cmp_queue");
+    return mp_const_none;
 }
 
 /**
@@ -351,14 +543,14 @@ mp_obj_t x_MP_Exchange_Str (mp_obj_t x_string_obj, mp_obj_t x_timeout)
     int32_t s32_timeout = mp_obj_get_int (x_timeout);
 
     /* Send the message to C environment and wait for response with timeout */
-    uint16_t u16_rx_len = sizeof (g_au8_rx_buf);
-    if (s8_MP_Que_Exchange_With_C (pstri_tx_msg, 0, g_au8_rx_buf, &u16_rx_len, s32_timeout))
+    uint8_t u8_frame;
+    if (s8_MP_Que_Exchange_With_C (pstri_tx_msg, 0, &u8_frame, s32_timeout))
     {
         return mp_const_none;
     }
 
     /* Successful */
-    return (mp_obj_new_str ((char *)g_au8_rx_buf, u16_rx_len));
+    return x_MP_Que_Frame_To_Obj (u8_frame, MP_FRAME_AS_STR);
 }
 
 /**
@@ -403,47 +595,49 @@ mp_obj_t x_MP_Exchange_Str (mp_obj_t x_string_obj, mp_obj_t x_timeout)
 */
 mp_obj_t x_MP_Exchange_Bytes (mp_obj_t x_array_obj, mp_obj_t x_timeout)
 {
-    /* Validate data type */
-    if ((!mp_obj_is_type (x_array_obj, &mp_type_tuple)) && (!mp_obj_is_type (x_array_obj, &mp_type_list)))
-    {
-        mp_raise_msg (&mp_type_TypeError, "Sending data must be a tuple or a list");
-        return mp_const_false;
-    }
-    if (!mp_obj_is_int (x_timeout))
-    {
-        mp_raise_msg (&mp_type_TypeError, "Wait time must be an integer number");
-        return mp_const_false;
-    }
-
-    /* Extract objects from the micropython input object */
-    size_t x_tx_len;
-    mp_obj_t * px_elem;
-    mp_obj_get_array (x_array_obj, &x_tx_len, &px_elem);
-
-    /* Validate */
-    if ((x_tx_len > MP_MAX_C_MSG_LEN) || (x_tx_len == 0) || (px_elem == NULL))
-    {
-        return mp_const_none;
-    }
-
-    /* Construct the message to send to C environment */
-    for (uint16_t u16_idx = 0; u16_idx < x_tx_len; u16_idx++)
-    {
-        g_au8_tx_buf[u16_idx] = (uint8_t)mp_obj_get_int (px_elem[u16_idx]);
-    }
-
-    /* Get timeout */
-    int32_t s32_timeout = mp_obj_get_int (x_timeout);
-
-    /* Send the message to C environment and wait for response with timeout */
-    uint16_t u16_rx_len = sizeof (g_au8_rx_buf);
-    if (s8_MP_Que_Exchange_With_C (g_au8_tx_buf, x_tx_len, g_au8_rx_buf, &u16_rx_len, s32_timeout))
-    {
-        return mp_const_none;
-    }
+    return x_MP_Que_Exchange_Array (x_array_obj, x_timeout, MP_FRAME_AS_BYTES);
+}
 
-    /* Successful */
-    return (mp_obj_new_bytes (g_au8_rx_buf, u16_rx_len));
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Binds function cmp_queue.exchange_frame() in MicroPython environment to s8_MP_Que_Exchange_With_C() in
+**      C environment
+**
+** @details
+**      This function works like cmp_queue.exchange_bytes() but the response is returned as a memoryview over the
+**      frame in the pool instead of a copy. The frame must be given back with cmp_queue.release_frame() as soon as
+**      the response has been processed.
+**      Example:
+**          import cmp_queue
+**          frame = cmp_queue.exchange_frame([0x11, 0x22, 0x33, 0x44], 100)
+**          if not frame is None:
+**              print(bytes(frame))
+**              cmp_queue.release_frame(frame)
+**
+** @note
+**      All elements of the sending tuple or list object must be numbers in range of 0 -> 255
+**
+** @param [in]
+**      x_array_obj: MicroPython tuple or list object
+**
+** @param [in]
+**      x_timeout: Timeout (in milliseconds) waiting for the response.
+**      @arg    0: no timeout, check receive queue and return immediately
+**      @arg    cmp_queue.WAIT_FOREVER or < 0: wait until a receive message is available
+**      @arg    > 0: if a receive message is available within x_timeout milliseconds, get the message and return.
+**                      Otheriwse return as soon as x_timeout milliseconds expires
+**
+** @return
+**      @arg    None: The given timeout expired but no receive message is available
+**      @arg    memoryview object: receive message from C
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Exchange_Frame (mp_obj_t x_array_obj, mp_obj_t x_timeout)
+{
+    return x_MP_Que_Exchange_Array (x_array_obj, x_timeout, MP_FRAME_AS_VIEW);
 }
 
 /**
@@ -452,6 +646,10 @@ mp_obj_t x_MP_Exchange_Bytes (mp_obj_t x_array_obj, mp_obj_t x_timeout)
 ** @brief
 **      Sends a message from C environment to MicroPython environment
 **
+** @details
+**      The message is copied into a free frame of the pool, which is then queued for MicroPython. If MicroPython
+**      is holding all frames, the message is dropped.
+**
 ** @note
 **      This function is exported for C-environment
 **
@@ -469,21 +667,32 @@ mp_obj_t x_MP_Exchange_Bytes (mp_obj_t x_array_obj, mp_obj_t x_timeout)
 */
 int8_t s8_MP_Que_Send_To_MP (const void * pv_msg, uint16_t u16_len)
 {
-    ASSERT_PARAM ((pv_msg != NULL) && (u16_len < MP_QUE_C2MP_BUF_SIZE));
+    ASSERT_PARAM ((pv_msg != NULL) && (u16_len <= MP_QUE_FRAME_SIZE));
 
     /* Determine length of the message */
     if (u16_len == 0)
     {
         u16_len = strlen (pv_msg);
+        if (u16_len > MP_QUE_FRAME_SIZE)
+        {
+            LOGE ("Message of %d bytes is too long to send to MicroPython", u16_len);
+            return MP_ERR;
+        }
     }
 
-    /* Put the message into the relevant buffer */
-    if (xMessageBufferSend (g_x_c2mp_buf, pv_msg, u16_len, 0) != u16_len)
+    /* Get a free frame */
+    uint8_t u8_frame;
+    if (xQueueReceive (g_x_free_frames, &u8_frame, 0) != pdTRUE)
     {
-        /* Maybe not enough space in the buffer to store the message */
+        LOGE ("No free frame to send message to MicroPython, the message is dropped");
         return MP_ERR;
     }
 
+    /* Put the message into the frame and pass the frame to MicroPython */
+    memcpy (g_astru_frames[u8_frame].au8_data, pv_msg, u16_len);
+    g_astru_frames[u8_frame].u16_len = u16_len;
+    xQueueSend (g_x_ready_frames, &u8_frame, 0);
+
     return MP_OK;
 }
 
@@ -567,35 +776,34 @@ static int8_t s8_MP_Que_Send_To_C (const void * pv_msg, uint16_t u16_len)
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Receives a message sent from C environment
+**      Receives a frame carrying a message sent from C environment
 **
-** @param [in]
-**      pv_msg: Pointer to the buffer to store the received message
+** @param [out]
+**      pu8_frame: Index of the received frame. The frame must be released by v_MP_Que_Release_Frame() after use
 **
-** @param [in,out]
-**      pu16_len: For input, this is the length in bytes of the receive buffer. For output, this indicates length
-**                in bytes of the received message
+** @param [in]
+**      s32_timeout: Timeout waiting for the message
+**      @arg    0: the function returns immediately if there is no receive message
+**      @arg    >0: the function returns as soon as a receive message is available or the given timeout expires
+**      @arg    <0: the function only returns when there is a receive message
 **
 ** @return
 **      @arg    MP_OK: A message has been received
-**      @arg    MP_ERR: No receive message available or receive buffer is not enough to store the receive message
+**      @arg    MP_ERR: No receive message available
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static int8_t s8_MP_Que_Receive_From_C (void * pv_msg, uint16_t * pu16_len)
+static int8_t s8_MP_Que_Receive_From_C (uint8_t * pu8_frame, int32_t s32_timeout)
 {
-    ASSERT_PARAM ((pv_msg != NULL) && (pu16_len != NULL) && (*pu16_len > 0));
+    ASSERT_PARAM (pu8_frame != NULL);
 
-    /* Check and receive message (if any) from the relevant queue */
-    size_t x_len = xMessageBufferReceive (g_x_c2mp_buf, pv_msg, *pu16_len, 0);
-    if (x_len == 0)
+    /* Check and wait for receive message (if any) from the relevant queue */
+    if (xQueueReceive (g_x_ready_frames, pu8_frame,
+                       (s32_timeout < 0) ? portMAX_DELAY : pdMS_TO_TICKS (s32_timeout)) != pdTRUE)
     {
-        /* No message available or receive buffer is not enough to store the receive message */
-        *pu16_len = 0;
         return MP_ERR;
     }
 
-    *pu16_len = x_len;
     return MP_OK;
 }
 
@@ -612,12 +820,9 @@ static int8_t s8_MP_Que_Receive_From_C (void * pv_msg, uint16_t * pu16_len)
 ** @param [in]
 **      u16_tx_len: Length in bytes of the message, if this is 0, strlen() shall be used to determine length
 **
-** @param [in]
-**      pv_rx_msg: Pointer to the buffer to store the received message.
-**
-** @param [in,out]
-**      pu16_rx_len: For input, this is the length in bytes of the receive buffer. For output, this indicates length
-**                   in bytes of the received message.
+** @param [out]
+**      pu8_frame: Index of the frame carrying the response. The frame must be released by v_MP_Que_Release_Frame()
+**                 after use
 **
 ** @param [in]
 **      s32_timeout: Timeout waiting for the response message
@@ -627,15 +832,14 @@ static int8_t s8_MP_Que_Receive_From_C (void * pv_msg, uint16_t * pu16_len)
 **
 ** @return
 **      @arg    MP_OK: A message has been received
-**      @arg    MP_ERR: No receive message available or receive buffer is not enough to store the receive message
-*
+**      @arg    MP_ERR: Failed to send the message or no receive message available
+**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 static int8_t s8_MP_Que_Exchange_With_C (const void * pv_tx_msg, uint16_t u16_tx_len,
-                                         void * pv_rx_msg, uint16_t * pu16_rx_len, int32_t s32_timeout)
+                                         uint8_t * pu8_frame, int32_t s32_timeout)
 {
     ASSERT_PARAM ((pv_tx_msg != NULL) && (u16_tx_len < MP_QUE_MP2C_BUF_SIZE));
-    ASSERT_PARAM ((pv_rx_msg != NULL) && (pu16_rx_len != NULL) && (*pu16_rx_len > 0));
 
     /* Determine length of the transmit message */
     if (u16_tx_len == 0)
@@ -643,6 +847,10 @@ static int8_t s8_MP_Que_Exchange_With_C (const void * pv_tx_msg, uint16_t u16_tx
         u16_tx_len = strlen (pv_tx_msg);
     }
 
+    /* Responses still queued belong to an earlier exchange which has given up, they must not be taken for the
+       response to this message */
+    v_MP_Que_Discard_Ready_Frames ();
+
     /* Put the message into the relevant buffer */
     if (xMessageBufferSend (g_x_mp2c_buf, pv_tx_msg, u16_tx_len, 0) != u16_tx_len)
     {
@@ -651,17 +859,185 @@ static int8_t s8_MP_Que_Exchange_With_C (const void * pv_tx_msg, uint16_t u16_tx
     }
 
     /* Check and wait for receive message (if any) from the relevant queue */
-    size_t x_rx_len = xMessageBufferReceive (g_x_c2mp_buf, pv_rx_msg, *pu16_rx_len,
-                                             (s32_timeout < 0) ? portMAX_DELAY : pdMS_TO_TICKS (s32_timeout));
-    if (x_rx_len == 0)
+    return s8_MP_Que_Receive_From_C (pu8_frame, s32_timeout);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gives a frame back to the pool of free frames
+**
+** @param [in]
+**      u8_frame: Index of the frame
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Que_Release_Frame (uint8_t u8_frame)
+{
+    /* The free queue can hold all frames, so this never blocks */
+    xQueueSend (g_x_free_frames, &u8_frame, 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Discards all frames queued for MicroPython and gives them back to the pool of free frames
+**
+** @details
+**      These are late responses to an exchange that timed out, or the remaining sub-responses of a batch that
+**      failed part-way.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Que_Discard_Ready_Frames (void)
+{
+    uint8_t u8_frame;
+    uint8_t u8_num_discarded = 0;
+
+    while (xQueueReceive (g_x_ready_frames, &u8_frame, 0) == pdTRUE)
     {
-        /* No message available or receive buffer is not enough to store the receive message */
-        *pu16_rx_len = 0;
-        return MP_ERR;
+        v_MP_Que_Release_Frame (u8_frame);
+        u8_num_discarded++;
     }
 
-    *pu16_rx_len = x_rx_len;
-    return MP_OK;
+    if (u8_num_discarded > 0)
+    {
+        LOGW ("%d stale response(s) from C discarded", u8_num_discarded);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Delivers a received frame to MicroPython as an object of the given type
+**
+** @details
+**      For string and bytes objects, the message is copied and the frame is released immediately. For memoryview
+**      object, the frame is marked as borrowed and is only released by cmp_queue.release_frame(). If allocating
+**      the object fails, the frame is released before the exception is propagated, so the frame is never lost.
+**
+** @param [in]
+**      u8_frame: Index of the frame
+**
+** @param [in]
+**      enm_obj_type: Type of the MicroPython object to create
+**
+** @return
+**      MicroPython object of the message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static mp_obj_t x_MP_Que_Frame_To_Obj (uint8_t u8_frame, MP_frame_obj_t enm_obj_type)
+{
+    MP_frame_t * pstru_frame = &g_astru_frames[u8_frame];
+    mp_obj_t x_obj = mp_const_none;
+    nlr_buf_t x_nlr;
+
+    if (nlr_push (&x_nlr) == 0)
+    {
+        switch (enm_obj_type)
+        {
+            case MP_FRAME_AS_STR:
+                x_obj = mp_obj_new_str ((char *)pstru_frame->au8_data, pstru_frame->u16_len);
+                break;
+
+            case MP_FRAME_AS_BYTES:
+                x_obj = mp_obj_new_bytes (pstru_frame->au8_data, pstru_frame->u16_len);
+                break;
+
+            case MP_FRAME_AS_VIEW:
+                x_obj = mp_obj_new_memoryview ('B', pstru_frame->u16_len, pstru_frame->au8_data);
+                break;
+        }
+        nlr_pop ();
+    }
+    else
+    {
+        /* Failed to create the object, give the frame back and propagate the exception */
+        v_MP_Que_Release_Frame (u8_frame);
+        nlr_jump (x_nlr.ret_val);
+    }
+
+    /* The frame is now owned by MicroPython until cmp_queue.release_frame() is called */
+    if (enm_obj_type == MP_FRAME_AS_VIEW)
+    {
+        pstru_frame->b_borrowed = true;
+    }
+    else
+    {
+        v_MP_Que_Release_Frame (u8_frame);
+    }
+
+    return x_obj;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a tuple or list object to C environment and delivers the response as an object of the given type
+**
+** @param [in]
+**      x_array_obj: MicroPython tuple or list object
+**
+** @param [in]
+**      x_timeout: Timeout (in milliseconds) waiting for the response
+**
+** @param [in]
+**      enm_obj_type: Type of the MicroPython object of the response
+**
+** @return
+**      @arg    None: The given timeout expired but no receive message is available
+**      @arg    Object of the response
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static mp_obj_t x_MP_Que_Exchange_Array (mp_obj_t x_array_obj, mp_obj_t x_timeout, MP_frame_obj_t enm_obj_type)
+{
+    /* Validate data type */
+    if ((!mp_obj_is_type (x_array_obj, &mp_type_tuple)) && (!mp_obj_is_type (x_array_obj, &mp_type_list)))
+    {
+        mp_raise_msg (&mp_type_TypeError, "Sending data must be a tuple or a list");
+        return mp_const_false;
+    }
+    if (!mp_obj_is_int (x_timeout))
+    {
+        mp_raise_msg (&mp_type_TypeError, "Wait time must be an integer number");
+        return mp_const_false;
+    }
+
+    /* Extract objects from the micropython input object */
+    size_t x_tx_len;
+    mp_obj_t * px_elem;
+    mp_obj_get_array (x_array_obj, &x_tx_len, &px_elem);
+
+    /* Validate */
+    if ((x_tx_len > MP_MAX_C_MSG_LEN) || (x_tx_len == 0) || (px_elem == NULL))
+    {
+        return mp_const_none;
+    }
+
+    /* Construct the message to send to C environment */
+    for (uint16_t u16_idx = 0; u16_idx < x_tx_len; u16_idx++)
+    {
+        g_au8_tx_buf[u16_idx] = (uint8_t)mp_obj_get_int (px_elem[u16_idx]);
+    }
+
+    /* Get timeout */
+    int32_t s32_timeout = mp_obj_get_int (x_timeout);
+
+    /* Send the message to C environment and wait for response with timeout */
+    uint8_t u8_frame;
+    if (s8_MP_Que_Exchange_With_C (g_au8_tx_buf, x_tx_len, &u8_frame, s32_timeout))
+    {
+        return mp_const_none;
+    }
+
+    /* Successful */
+    return x_MP_Que_Frame_To_Obj (u8_frame, enm_obj_type);
 }
 
 /**
@@ -48,7 +48,13 @@ extern mp_obj_t x_MP_Send_Bytes (mp_obj_t x_array_obj);
 extern mp_obj_t x_MP_Receive_Str (void);
 
 /* Binds function cmp_queue.receive_bytes() in MicroPython environment to s8_MP_Que_Receive_From_C() in C environment */
-extern mp_obj_t x_MP_Receive_Bytes (void);
+extern mp_obj_t x_MP_Receive_Bytes (size_t x_args, const mp_obj_t * px_args);
+
+/* Binds function cmp_queue.receive_frame() in MicroPython environment to s8_MP_Que_Receive_From_C() in C environment */
+extern mp_obj_t x_MP_Receive_Frame (mp_obj_t x_timeout);
+
+/* Binds function cmp_queue.release_frame() in MicroPython environment to v_MP_Que_Release_Frame() in C environment */
+extern mp_obj_t x_MP_Release_Frame (mp_obj_t x_frame_obj);
 
 /* Binds function cmp_queue.exchange_str() in MicroPython environment to s8_MP_Que_Exchange_With_C() in C environment */
 extern mp_obj_t x_MP_Exchange_Str (mp_obj_t x_string_obj, mp_obj_t x_timeout);
@@ -56,6 +62,9 @@ extern mp_obj_t x_MP_Exchange_Str (mp_obj_t x_string_obj, mp_obj_t x_timeout);
 /* Binds function cmp_queue.exchange_bytes() in MicroPython environment to s8_MP_Que_Exchange_With_C() in C environment */
 extern mp_obj_t x_MP_Exchange_Bytes (mp_obj_t x_array_obj, mp_obj_t x_timeout);
 
+/* Binds function cmp_queue.exchange_frame() in MicroPython environment to s8_MP_Que_Exchange_With_C() in C environment */
+extern mp_obj_t x_MP_Exchange_Frame (mp_obj_t x_array_obj, mp_obj_t x_timeout);
+
 #endif /* __CMP_QUEUE_H__ */
 
 /**
@@ -52,7 +52,13 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(send_bytes_fnc_obj, x_MP_Send_Bytes);
 STATIC MP_DEFINE_CONST_FUN_OBJ_0(receive_str_fnc_obj, x_MP_Receive_Str);
 
 /** @brief  Function object of x_MP_Receive_Bytes() */
-STATIC MP_DEFINE_CONST_FUN_OBJ_0(receive_bytes_fnc_obj, x_MP_Receive_Bytes);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(receive_bytes_fnc_obj, 0, 1, x_MP_Receive_Bytes);
+
+/** @brief  Function object of x_MP_Receive_Frame() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(receive_frame_fnc_obj, x_MP_Receive_Frame);
+
+/** @brief  Function object of x_MP_Release_Frame() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(release_frame_fnc_obj, x_MP_Release_Frame);
 
 /** @brief  Function object of x_MP_Exchange_Str() */
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(exchange_str_fnc_obj, x_MP_Exchange_Str);
@@ -60,6 +66,9 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_2(exchange_str_fnc_obj, x_MP_Exchange_Str);
 /** @brief  Function object of x_MP_Exchange_Bytes() */
 STATIC MP_DEFINE_CONST_FUN_OBJ_2(exchange_bytes_fnc_obj, x_MP_Exchange_Bytes);
 
+/** @brief  Function object of x_MP_Exchange_Frame() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(exchange_frame_fnc_obj, x_MP_Exchange_Frame);
+
 /** @brief  Declare all properties of the module */
 STATIC const mp_rom_map_elem_t x_cmp_queue_module_globals_table[] =
 {
@@ -73,8 +82,11 @@ STATIC const mp_rom_map_elem_t x_cmp_queue_module_globals_table[] =
     { MP_ROM_QSTR(MP_QSTR_send_bytes)       , MP_ROM_PTR(&send_bytes_fnc_obj)       },
     { MP_ROM_QSTR(MP_QSTR_receive_str)      , MP_ROM_PTR(&receive_str_fnc_obj)      },
     { MP_ROM_QSTR(MP_QSTR_receive_bytes)    , MP_ROM_PTR(&receive_bytes_fnc_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_receive_frame)    , MP_ROM_PTR(&receive_frame_fnc_obj)    },
+    { MP_ROM_QSTR(MP_QSTR_release_frame)    , MP_ROM_PTR(&release_frame_fnc_obj)    },
     { MP_ROM_QSTR(MP_QSTR_exchange_str)     , MP_ROM_PTR(&exchange_str_fnc_obj)     },
     { MP_ROM_QSTR(MP_QSTR_exchange_bytes)   , MP_ROM_PTR(&exchange_bytes_fnc_obj)   },
+    { MP_ROM_QSTR(MP_QSTR_exchange_frame)   , MP_ROM_PTR(&exchange_frame_fnc_obj)   },
 };
 STATIC MP_DEFINE_CONST_DICT(x_cmp_queue_module_globals, x_cmp_queue_module_globals_table);
 
@@ -25,6 +25,11 @@
 #include "param.h"                      /* Public header of this MP module */
 #include "srvc_micropy.h"               /* Use common return code */
 #include "nvs_flash.h"                  /* Use non-volatile storage component from ESP-IDF */
+#include "srvc_param.h"                 /* Use parameters of the firmware */
+#include "py/objint.h"                  /* Use conversion of 64-bit integers */
+
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -38,6 +43,19 @@
 */
 #define MP_NVS_PARTITION_NAME           "nvs"
 
+/** @brief  Maximum number of parameter changes pending until param.wait() is called */
+#define MP_PARAM_EVENT_QUEUE_LEN        8
+
+/** @brief  Change of a parameter queued for param.wait() */
+typedef struct
+{
+    PARAM_id_t      enm_param_id;           //!< ID of the changed parameter
+    uint16_t        u16_old_len;            //!< Length in bytes of the previous value
+    uint16_t        u16_new_len;            //!< Length in bytes of the new value
+    uint8_t         au8_values[];           //!< Previous value followed by the new value
+
+} MP_param_event_t;
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           VARIABLES SECTION
@@ -47,12 +65,36 @@
 /** @brief  Logging tag of this module */
 static const char * TAG = "Srvc_Micropy";
 
+/** @brief  Queue of pointers to the parameter changes pending until param.wait() is called */
+static QueueHandle_t g_x_event_queue = NULL;
+
+/** @brief  Indicates which parameters the script has subscribed to */
+static volatile bool g_ab_subscribed [PARAM_NUM_PARAMS];
+
+/** @brief  Indicates if the script has begun a transaction that is not committed or aborted yet */
+static bool g_b_trans_open = false;
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/* Gets ID of a parameter given its PUC */
+static PARAM_id_t enm_MP_Param_Get_ID (mp_obj_t x_puc);
+
+/* Gets value of a 64-bit integer object, raises an exception if it doesn't fit */
+static void v_MP_Param_Get_Int64 (mp_obj_t x_value, bool b_signed, void * pv_value);
+
+/* Converts a parameter value into a MicroPython object */
+static mp_obj_t x_MP_Param_To_Obj (PARAM_base_type_t enm_type, const void * pv_value, uint16_t u16_len);
+
+/* Queues a change of a parameter the script has subscribed to */
+static void v_MP_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg);
+
+/* Discards all the queued parameter changes */
+static void v_MP_Param_Flush_Events (void);
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           FUNCTIONS SECTION
@@ -204,6 +246,746 @@ mp_obj_t x_MP_Param_Erase_All (mp_obj_t x_namespace)
     return mp_const_true;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of a parameter of the firmware
+**
+** @details
+**      This function returns the current value of a parameter given its PUC (Param Unique Code). The value is an
+**      integer, a string or a bytes object depending on the data type of the parameter.
+**      Example:
+**          import param
+**          ssid = param.get(0x0000)
+**
+** @param [in]
+**      x_puc: PUC of the parameter (MicroPython integer)
+**
+** @return
+**      @arg    Value of the parameter
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Get (mp_obj_t x_puc)
+{
+    PARAM_id_t enm_param_id = enm_MP_Param_Get_ID (x_puc);
+
+    /* Get a copy of the parameter's value */
+    PARAM_base_type_t enm_type;
+    void * pv_value;
+    uint16_t u16_len;
+    s8_PARAM_Get_Type (enm_param_id, &enm_type);
+    if (s8_PARAM_Get_Value (enm_param_id, &pv_value, &u16_len) != PARAM_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to get value of the parameter");
+        return mp_const_none;
+    }
+
+    /* Convert the value into a MicroPython object, the copy must be freed even if that raises an exception */
+    mp_obj_t x_value = mp_const_none;
+    nlr_buf_t x_nlr;
+    if (nlr_push (&x_nlr) == 0)
+    {
+        x_value = x_MP_Param_To_Obj (enm_type, pv_value, u16_len);
+        nlr_pop ();
+    }
+    else
+    {
+        free (pv_value);
+        nlr_jump (x_nlr.ret_val);
+    }
+    free (pv_value);
+
+    return x_value;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Changes value of a parameter of the firmware
+**
+** @details
+**      This function validates and changes value of a parameter given its PUC (Param Unique Code). The value must be
+**      an integer, a string or a bytes-like object depending on the data type of the parameter. If a transaction has
+**      been begun by param.begin(), the value is only applied when the transaction is committed.
+**      Example:
+**          import param
+**          param.set(0x0010, 'my_group')
+**
+** @param [in]
+**      x_puc: PUC of the parameter (MicroPython integer)
+**
+** @param [in]
+**      x_value: New value of the parameter
+**
+** @return
+**      @arg    true: the value has been changed (or staged) successfully
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Set (mp_obj_t x_puc, mp_obj_t x_value)
+{
+    PARAM_id_t enm_param_id = enm_MP_Param_Get_ID (x_puc);
+    PARAM_base_type_t enm_type;
+    s8_PARAM_Get_Type (enm_param_id, &enm_type);
+
+    /* Integer value of a parameter up to 32-bit */
+    int32_t s32_value = 0;
+    if ((enm_type == BASE_TYPE_uint32_t) && mp_obj_is_type (x_value, &mp_type_int))
+    {
+        s32_value = mp_obj_int_get_uint_checked (x_value);
+    }
+    else if (enm_type <= BASE_TYPE_int32_t)
+    {
+        s32_value = mp_obj_get_int (x_value);
+    }
+    if (((enm_type == BASE_TYPE_uint8_t) && (s32_value != (uint8_t)s32_value)) ||
+        ((enm_type == BASE_TYPE_int8_t) && (s32_value != (int8_t)s32_value)) ||
+        ((enm_type == BASE_TYPE_uint16_t) && (s32_value != (uint16_t)s32_value)) ||
+        ((enm_type == BASE_TYPE_int16_t) && (s32_value != (int16_t)s32_value)) ||
+        ((enm_type == BASE_TYPE_uint32_t) && mp_obj_is_small_int (x_value) && (s32_value < 0)))
+    {
+        mp_raise_ValueError ("Value doesn't fit in the parameter's data type");
+    }
+
+    /* Change parameter value */
+    int8_t s8_result = PARAM_ERR;
+    switch (enm_type)
+    {
+        case BASE_TYPE_uint8_t:
+            s8_result = s8_PARAM_Set_Uint8 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_int8_t:
+            s8_result = s8_PARAM_Set_Int8 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_uint16_t:
+            s8_result = s8_PARAM_Set_Uint16 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_int16_t:
+            s8_result = s8_PARAM_Set_Int16 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_uint32_t:
+            s8_result = s8_PARAM_Set_Uint32 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_int32_t:
+            s8_result = s8_PARAM_Set_Int32 (enm_param_id, s32_value);
+            break;
+
+        case BASE_TYPE_uint64_t:
+        {
+            uint64_t u64_value;
+            v_MP_Param_Get_Int64 (x_value, false, &u64_value);
+            s8_result = s8_PARAM_Set_Uint64 (enm_param_id, u64_value);
+            break;
+        }
+
+        case BASE_TYPE_int64_t:
+        {
+            int64_t s64_value;
+            v_MP_Param_Get_Int64 (x_value, true, &s64_value);
+            s8_result = s8_PARAM_Set_Int64 (enm_param_id, s64_value);
+            break;
+        }
+
+        case BASE_TYPE_string:
+            s8_result = s8_PARAM_Set_String (enm_param_id, mp_obj_str_get_str (x_value));
+            break;
+
+        default:
+        {
+            mp_buffer_info_t stru_buffer;
+            mp_get_buffer_raise (x_value, &stru_buffer, MP_BUFFER_READ);
+            if ((stru_buffer.len > 0) && (stru_buffer.len <= UINT16_MAX))
+            {
+                s8_result = s8_PARAM_Set_Blob (enm_param_id, stru_buffer.buf, stru_buffer.len);
+            }
+            break;
+        }
+    }
+    if (s8_result != PARAM_OK)
+    {
+        mp_raise_ValueError ("Value is not allowed for the parameter");
+    }
+
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Begins a transaction changing several parameters of the firmware at once
+**
+** @details
+**      The values passed to param.set() are then only staged, and param.get() still returns the current values,
+**      until the transaction is committed by param.commit() or discarded by param.abort(). Only one transaction can
+**      be in progress at a time in the firmware.
+**      Example:
+**          import param
+**          param.begin()
+**          try:
+**              param.set(0x0000, 'my_ssid')
+**              param.set(0x0001, 'my_password')
+**              param.commit()
+**          except:
+**              param.abort()
+**              raise
+**
+** @return
+**      @arg    true: the transaction has begun
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Begin (void)
+{
+    if (s8_PARAM_Begin () != PARAM_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Another transaction is in progress");
+    }
+    g_b_trans_open = true;
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Commits the transaction begun by param.begin()
+**
+** @details
+**      All the values staged in the transaction are applied at once. If any of them was rejected by param.set(), or
+**      they can't be persisted, none of them is applied. The transaction ends in any case.
+**      Example:
+**          import param
+**          param.begin()
+**          param.set(0x0010, 'my_group')
+**          param.commit()
+**
+** @return
+**      @arg    true: all the values have been applied
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Commit (void)
+{
+    /* The transaction ends even if committing it fails */
+    g_b_trans_open = false;
+    if (s8_PARAM_Commit () != PARAM_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to commit the transaction");
+    }
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Aborts the transaction begun by param.begin(), discarding all the staged values
+**
+** @details
+**      Example:
+**          import param
+**          param.begin()
+**          param.set(0x0010, 'my_group')
+**          param.abort()
+**
+** @return
+**      @arg    true: the transaction has been aborted
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Abort (void)
+{
+    g_b_trans_open = false;
+    if (s8_PARAM_Abort () != PARAM_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "No transaction is in progress");
+    }
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Exports a snapshot of the parameters of the firmware
+**
+** @details
+**      The snapshot holds all the parameters which can be copied to another device, in the format described in
+**      srvc_param.h. It can be stored in a file and imported later by param.restore().
+**      Example:
+**          import param
+**          with open('params.bin', 'wb') as f:
+**              f.write(param.snapshot())
+**
+** @return
+**      @arg    bytes object of the snapshot
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Snapshot (void)
+{
+    uint8_t * pu8_snapshot;
+    uint16_t u16_len;
+    if (s8_PARAM_Export (&pu8_snapshot, &u16_len) != PARAM_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to export the parameters");
+    }
+
+    /* The snapshot must be freed even if creating the bytes object raises an exception */
+    mp_obj_t x_snapshot = mp_const_none;
+    nlr_buf_t x_nlr;
+    if (nlr_push (&x_nlr) == 0)
+    {
+        x_snapshot = mp_obj_new_bytes (pu8_snapshot, u16_len);
+        nlr_pop ();
+    }
+    else
+    {
+        free (pu8_snapshot);
+        nlr_jump (x_nlr.ret_val);
+    }
+    free (pu8_snapshot);
+
+    return x_snapshot;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Imports a snapshot exported by param.snapshot()
+**
+** @details
+**      All the parameters of the snapshot are changed at once, or none of them.
+**      Example:
+**          import param
+**          with open('params.bin', 'rb') as f:
+**              param.restore(f.read())
+**
+** @param [in]
+**      x_snapshot: bytes-like object of the snapshot
+**
+** @return
+**      @arg    true: all the parameters have been changed
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Restore (mp_obj_t x_snapshot)
+{
+    mp_buffer_info_t stru_buffer;
+    mp_get_buffer_raise (x_snapshot, &stru_buffer, MP_BUFFER_READ);
+    if (stru_buffer.len > UINT16_MAX)
+    {
+        mp_raise_ValueError ("Snapshot is too long");
+    }
+    if (s8_PARAM_Import (stru_buffer.buf, (uint16_t)stru_buffer.len) != PARAM_OK)
+    {
+        mp_raise_ValueError ("Snapshot is invalid or can't be applied");
+    }
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Subscribes to changes of parameters of the firmware
+**
+** @details
+**      This function selects the parameters whose changes are returned by param.wait(), given a list or tuple of
+**      their PUCs. The changes made before are discarded. An empty list stops the subscription.
+**      Example:
+**          import param
+**          param.subscribe([0x0000, 0x0001])
+**
+** @param [in]
+**      x_pucs: List or tuple of PUCs of the parameters
+**
+** @return
+**      @arg    true: the subscription has been made
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Subscribe (mp_obj_t x_pucs)
+{
+    /* Get IDs of all the given parameters first, so that an invalid one changes nothing */
+    size_t x_num_pucs;
+    mp_obj_t * px_pucs;
+    bool ab_subscribed [PARAM_NUM_PARAMS] = { false };
+    mp_obj_get_array (x_pucs, &x_num_pucs, &px_pucs);
+    for (size_t x_idx = 0; x_idx < x_num_pucs; x_idx++)
+    {
+        ab_subscribed[enm_MP_Param_Get_ID (px_pucs[x_idx])] = true;
+    }
+
+    /* Subscribe to changes of all parameters once, the changes are then filtered */
+    if (g_x_event_queue == NULL)
+    {
+        g_x_event_queue = xQueueCreate (MP_PARAM_EVENT_QUEUE_LEN, sizeof (MP_param_event_t *));
+        if (g_x_event_queue == NULL)
+        {
+            mp_raise_msg (&mp_type_MemoryError, "Failed to create queue of parameter changes");
+            return mp_const_false;
+        }
+        if (s8_PARAM_Subscribe (PARAM_MASK_ALL, v_MP_Param_Change_Handler, NULL) != PARAM_OK)
+        {
+            vQueueDelete (g_x_event_queue);
+            g_x_event_queue = NULL;
+            mp_raise_msg (&mp_type_OSError, "Failed to subscribe to parameter changes");
+            return mp_const_false;
+        }
+    }
+
+    /* Select the parameters and discard the changes of the previous selection */
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
+    {
+        g_ab_subscribed[u16_id] = ab_subscribed[u16_id];
+    }
+    v_MP_Param_Flush_Events ();
+
+    return mp_const_true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a change of the parameters subscribed to by param.subscribe()
+**
+** @details
+**      This function returns the next change as a tuple (puc, old_value, new_value), or None if no change is made
+**      before the timeout expires. The changes are returned in the order they are made, once they are committed.
+**      Example:
+**          import param
+**          param.subscribe([0x0010])
+**          while True:
+**              change = param.wait(1000)
+**              if change is not None:
+**                  print('Group changed from', change[1], 'to', change[2])
+**
+** @param [in]
+**      x_args: Number of arguments
+**
+** @param [in]
+**      px_args: Arguments
+**      @arg    px_args[0]: (optional) Timeout in milliseconds, the function waits forever if this is omitted or < 0
+**
+** @return
+**      @arg    None: No change has been made
+**      @arg    otherwise: MicroPython tuple (puc, old_value, new_value)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_Param_Wait (size_t x_args, const mp_obj_t * px_args)
+{
+    mp_int_t x_timeout = (x_args > 0) ? mp_obj_get_int (px_args[0]) : -1;
+
+    if (g_x_event_queue == NULL)
+    {
+        mp_raise_msg (&mp_type_OSError, "No subscription to parameter changes");
+        return mp_const_none;
+    }
+
+    /* Wait for the next change */
+    MP_param_event_t * pstru_event;
+    if (xQueueReceive (g_x_event_queue, &pstru_event,
+                       (x_timeout < 0) ? portMAX_DELAY : pdMS_TO_TICKS (x_timeout)) != pdTRUE)
+    {
+        return mp_const_none;
+    }
+
+    /* Convert the change into a MicroPython tuple, the change must be freed even if that raises an exception */
+    mp_obj_t x_change = mp_const_none;
+    nlr_buf_t x_nlr;
+    if (nlr_push (&x_nlr) == 0)
+    {
+        PARAM_base_type_t enm_type;
+        uint16_t u16_puc;
+        s8_PARAM_Get_Type (pstru_event->enm_param_id, &enm_type);
+        s8_PARAM_Convert_ID_To_PUC (pstru_event->enm_param_id, &u16_puc);
+
+        mp_obj_t ax_items[3];
+        ax_items[0] = mp_obj_new_int (u16_puc);
+        ax_items[1] = x_MP_Param_To_Obj (enm_type, pstru_event->au8_values, pstru_event->u16_old_len);
+        ax_items[2] = x_MP_Param_To_Obj (enm_type, &pstru_event->au8_values[pstru_event->u16_old_len],
+                                         pstru_event->u16_new_len);
+        x_change = mp_obj_new_tuple (3, ax_items);
+        nlr_pop ();
+    }
+    else
+    {
+        free (pstru_event);
+        nlr_jump (x_nlr.ret_val);
+    }
+    free (pstru_event);
+
+    return x_change;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Aborts the transaction left open by a Python program, stops its subscription and discards its pending
+**      parameter changes
+**
+** @details
+**      The handler registered to Srvc_Param stays registered but ignores all changes until param.subscribe() is
+**      called again. This function must be called by Srvc_Micropy task whenever no Python code is running any more
+**      (MicroPython engine is (re)initialized or a Python program has ended). As the transaction was begun by the
+**      same task, it can be aborted here.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MP_Param_Reset (void)
+{
+    /* Otherwise, no other task could change parameters any more */
+    if (g_b_trans_open)
+    {
+        LOGW ("Abort parameter transaction not committed by Python program");
+        g_b_trans_open = false;
+        s8_PARAM_Abort ();
+    }
+
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
+    {
+        g_ab_subscribed[u16_id] = false;
+    }
+
+    if (g_x_event_queue != NULL)
+    {
+        v_MP_Param_Flush_Events ();
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets ID of a parameter given its PUC, raises an exception if there is no such parameter
+**
+** @param [in]
+**      x_puc: PUC of the parameter (MicroPython integer)
+**
+** @return
+**      @arg    ID of the parameter
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static PARAM_id_t enm_MP_Param_Get_ID (mp_obj_t x_puc)
+{
+    mp_int_t x_puc_value = mp_obj_get_int (x_puc);
+    PARAM_id_t enm_param_id = PARAM_NUM_PARAMS;
+    if ((x_puc_value < 0) || (x_puc_value > UINT16_MAX) ||
+        (s8_PARAM_Convert_PUC_To_ID (x_puc_value, &enm_param_id) != PARAM_OK))
+    {
+        mp_raise_ValueError ("No parameter with the given PUC");
+    }
+    return enm_param_id;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of a 64-bit integer object, raises an exception if it doesn't fit
+**
+** @param [in]
+**      x_value: MicroPython integer
+**
+** @param [in]
+**      b_signed: true if the value is signed
+**
+** @param [out]
+**      pv_value: Pointer to the 64-bit integer receiving the value
+**
+** @return
+**      None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Param_Get_Int64 (mp_obj_t x_value, bool b_signed, void * pv_value)
+{
+    if (!mp_obj_is_int (x_value))
+    {
+        mp_raise_TypeError ("Value must be an integer");
+    }
+
+    /* Two's complement of the value, truncated to 64 bits */
+    uint64_t u64_value = 0;
+    if (mp_obj_is_small_int (x_value))
+    {
+        u64_value = (int64_t)MP_OBJ_SMALL_INT_VALUE (x_value);
+    }
+    else
+    {
+        mp_obj_int_to_bytes_impl (x_value, false, sizeof (u64_value), (byte *)&u64_value);
+    }
+
+    /* The value fits if converting it back gives the same integer */
+    mp_obj_t x_check = b_signed ? mp_obj_new_int_from_ll ((int64_t)u64_value) : mp_obj_new_int_from_ull (u64_value);
+    if (!mp_obj_equal (x_value, x_check))
+    {
+        mp_raise_ValueError ("Value doesn't fit in the parameter's data type");
+    }
+    memcpy (pv_value, &u64_value, sizeof (u64_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Converts a parameter value into a MicroPython object
+**
+** @param [in]
+**      enm_type: Data type of the parameter
+**
+** @param [in]
+**      pv_value: Buffer storing the value, which may not be aligned
+**
+** @param [in]
+**      u16_len: Length in bytes of the value
+**
+** @return
+**      @arg    MicroPython integer, string or bytes object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static mp_obj_t x_MP_Param_To_Obj (PARAM_base_type_t enm_type, const void * pv_value, uint16_t u16_len)
+{
+    /* Copy of an integer value, which is aligned */
+    union
+    {
+        uint8_t     u8_value;
+        int8_t      s8_value;
+        uint16_t    u16_value;
+        int16_t     s16_value;
+        uint32_t    u32_value;
+        int32_t     s32_value;
+        uint64_t    u64_value;
+        int64_t     s64_value;
+
+    } un_value = { 0 };
+    if ((enm_type != BASE_TYPE_string) && (enm_type != BASE_TYPE_blob))
+    {
+        memcpy (&un_value, pv_value, (u16_len < sizeof (un_value)) ? u16_len : sizeof (un_value));
+    }
+
+    switch (enm_type)
+    {
+        case BASE_TYPE_uint8_t:
+            return mp_obj_new_int_from_uint (un_value.u8_value);
+
+        case BASE_TYPE_int8_t:
+            return mp_obj_new_int (un_value.s8_value);
+
+        case BASE_TYPE_uint16_t:
+            return mp_obj_new_int_from_uint (un_value.u16_value);
+
+        case BASE_TYPE_int16_t:
+            return mp_obj_new_int (un_value.s16_value);
+
+        case BASE_TYPE_uint32_t:
+            return mp_obj_new_int_from_uint (un_value.u32_value);
+
+        case BASE_TYPE_int32_t:
+            return mp_obj_new_int (un_value.s32_value);
+
+        case BASE_TYPE_uint64_t:
+            return mp_obj_new_int_from_ull (un_value.u64_value);
+
+        case BASE_TYPE_int64_t:
+            return mp_obj_new_int_from_ll (un_value.s64_value);
+
+        case BASE_TYPE_string:
+            return mp_obj_new_str (pv_value, strnlen (pv_value, u16_len));
+
+        default:
+            return mp_obj_new_bytes (pv_value, u16_len);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Queues a change of a parameter the script has subscribed to
+**
+** @note
+**      This handler is invoked in the context of the task changing the parameter, the change is therefore copied
+**      until param.wait() gets it
+**
+** @param [in]
+**      pstru_change: The change
+**
+** @param [in]
+**      pv_arg: Not used
+**
+** @return
+**      None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg)
+{
+    if (!g_ab_subscribed[pstru_change->enm_param_id])
+    {
+        return;
+    }
+
+    /* Copy the change */
+    MP_param_event_t * pstru_event = malloc (sizeof (MP_param_event_t) +
+                                             pstru_change->u16_old_len + pstru_change->u16_new_len);
+    if (pstru_event == NULL)
+    {
+        LOGE ("Failed to allocate memory for a parameter change");
+        return;
+    }
+    pstru_event->enm_param_id = pstru_change->enm_param_id;
+    pstru_event->u16_old_len = pstru_change->u16_old_len;
+    pstru_event->u16_new_len = pstru_change->u16_new_len;
+    memcpy (pstru_event->au8_values, pstru_change->pv_old_value, pstru_change->u16_old_len);
+    memcpy (&pstru_event->au8_values[pstru_change->u16_old_len], pstru_change->pv_new_value,
+            pstru_change->u16_new_len);
+
+    /* Queue it without blocking the task changing the parameter */
+    if (xQueueSend (g_x_event_queue, &pstru_event, 0) != pdTRUE)
+    {
+        LOGW ("Too many pending parameter changes, the change of parameter %d is discarded",
+              pstru_change->enm_param_id);
+        free (pstru_event);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Discards all the queued parameter changes
+**
+** @return
+**      None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Param_Flush_Events (void)
+{
+    MP_param_event_t * pstru_event;
+    while (xQueueReceive (g_x_event_queue, &pstru_event, 0) == pdTRUE)
+    {
+        free (pstru_event);
+    }
+}
+
 /**
 ** @}
 */
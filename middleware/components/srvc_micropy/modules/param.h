@@ -44,6 +44,33 @@ extern mp_obj_t x_MP_Param_Get_All_Keys (mp_obj_t x_namespace);
 /* Erases all parameters in a non-volatile storage namespace */
 extern mp_obj_t x_MP_Param_Erase_All (mp_obj_t x_namespace);
 
+/* Gets value of a parameter of the firmware */
+extern mp_obj_t x_MP_Param_Get (mp_obj_t x_puc);
+
+/* Changes value of a parameter of the firmware */
+extern mp_obj_t x_MP_Param_Set (mp_obj_t x_puc, mp_obj_t x_value);
+
+/* Begins a transaction changing several parameters of the firmware at once */
+extern mp_obj_t x_MP_Param_Begin (void);
+
+/* Commits the transaction begun by param.begin() */
+extern mp_obj_t x_MP_Param_Commit (void);
+
+/* Aborts the transaction begun by param.begin(), discarding all the staged values */
+extern mp_obj_t x_MP_Param_Abort (void);
+
+/* Exports a snapshot of the parameters of the firmware */
+extern mp_obj_t x_MP_Param_Snapshot (void);
+
+/* Imports a snapshot exported by param.snapshot() */
+extern mp_obj_t x_MP_Param_Restore (mp_obj_t x_snapshot);
+
+/* Subscribes to changes of parameters of the firmware */
+extern mp_obj_t x_MP_Param_Subscribe (mp_obj_t x_pucs);
+
+/* Waits for a change of the parameters subscribed to by param.subscribe() */
+extern mp_obj_t x_MP_Param_Wait (size_t x_args, const mp_obj_t * px_args);
+
 #endif /* __PARAM_H__ */
 
 /**
@@ -48,6 +48,33 @@ STATIC MP_DEFINE_CONST_FUN_OBJ_1(get_all_keys_fnc_obj, x_MP_Param_Get_All_Keys);
 /** @brief  Function object of x_MP_Param_Erase_All() */
 STATIC MP_DEFINE_CONST_FUN_OBJ_1(erase_all_fnc_obj, x_MP_Param_Erase_All);
 
+/** @brief  Function object of x_MP_Param_Get() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(get_fnc_obj, x_MP_Param_Get);
+
+/** @brief  Function object of x_MP_Param_Set() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_2(set_fnc_obj, x_MP_Param_Set);
+
+/** @brief  Function object of x_MP_Param_Begin() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(begin_fnc_obj, x_MP_Param_Begin);
+
+/** @brief  Function object of x_MP_Param_Commit() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(commit_fnc_obj, x_MP_Param_Commit);
+
+/** @brief  Function object of x_MP_Param_Abort() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(abort_fnc_obj, x_MP_Param_Abort);
+
+/** @brief  Function object of x_MP_Param_Snapshot() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(snapshot_fnc_obj, x_MP_Param_Snapshot);
+
+/** @brief  Function object of x_MP_Param_Restore() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(restore_fnc_obj, x_MP_Param_Restore);
+
+/** @brief  Function object of x_MP_Param_Subscribe() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_1(subscribe_fnc_obj, x_MP_Param_Subscribe);
+
+/** @brief  Function object of x_MP_Param_Wait() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(wait_fnc_obj, 0, 1, x_MP_Param_Wait);
+
 /** @brief  Declare all properties of the module */
 STATIC const mp_rom_map_elem_t x_param_module_globals_table[] =
 {
@@ -56,6 +83,15 @@ STATIC const mp_rom_map_elem_t x_param_module_globals_table[] =
     /* Module functions */
     { MP_ROM_QSTR(MP_QSTR_get_all_keys)     , MP_ROM_PTR(&get_all_keys_fnc_obj)     },
     { MP_ROM_QSTR(MP_QSTR_erase_all)        , MP_ROM_PTR(&erase_all_fnc_obj)        },
+    { MP_ROM_QSTR(MP_QSTR_get)              , MP_ROM_PTR(&get_fnc_obj)              },
+    { MP_ROM_QSTR(MP_QSTR_set)              , MP_ROM_PTR(&set_fnc_obj)              },
+    { MP_ROM_QSTR(MP_QSTR_begin)            , MP_ROM_PTR(&begin_fnc_obj)            },
+    { MP_ROM_QSTR(MP_QSTR_commit)           , MP_ROM_PTR(&commit_fnc_obj)           },
+    { MP_ROM_QSTR(MP_QSTR_abort)            , MP_ROM_PTR(&abort_fnc_obj)            },
+    { MP_ROM_QSTR(MP_QSTR_snapshot)         , MP_ROM_PTR(&snapshot_fnc_obj)         },
+    { MP_ROM_QSTR(MP_QSTR_restore)          , MP_ROM_PTR(&restore_fnc_obj)          },
+    { MP_ROM_QSTR(MP_QSTR_subscribe)        , MP_ROM_PTR(&subscribe_fnc_obj)        },
+    { MP_ROM_QSTR(MP_QSTR_wait)             , MP_ROM_PTR(&wait_fnc_obj)             },
 };
 STATIC MP_DEFINE_CONST_DICT(x_param_module_globals, x_param_module_globals_table);
 
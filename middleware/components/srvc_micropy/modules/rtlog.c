@@ -0,0 +1,288 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : rtlog.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 15
+**  @brief      : C-implementation of rtlog MP module
+**  @namespace  : MP
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_Micropy
+** @brief       Provides MicroPython scripts with access to the realtime measurements stored on flash by Srvc_Rt_Log
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "rtlog.h"                      /* Public header of this MP module */
+#include "srvc_micropy.h"               /* Use common return code */
+#include "srvc_rt_log.h"                /* Use time-series store of realtime measurements */
+
+#include <string.h>                     /* Use strlen() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+#define TAG                 "Srvc_Micropy";
+
+/** @brief  Context of a query from rtlog.query() */
+typedef struct
+{
+    mp_obj_t        x_samples;                      //!< List of samples found
+    uint8_t         u8_num_meas;                    //!< Number of requested measurements
+    uint8_t         au8_meas_ids[RTLOG_NUM_MEAS];   //!< IDs of requested measurements in order of the tuple fields
+    void *          pv_exception;                   //!< Exception raised while building a sample, NULL if none
+
+} MP_rtlog_query_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static bool b_MP_RtLog_Add_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads realtime measurements stored on flash in a time range
+**
+** @details
+**      Samples staged in RAM are flushed onto flash before reading, so the result includes the latest samples.
+**      Example:
+**          import rtlog
+**          samples = rtlog.query(0, 60000, ids=[0, 1])
+**          for (timestamp, top_temp, bottom_temp) in samples:
+**              print(timestamp, top_temp, bottom_temp)
+**
+** @param [in]
+**      x_start_time: Timestamp (ms) of the first sample to read
+**
+** @param [in]
+**      x_end_time: Timestamp (ms) of the last sample to read
+**
+** @param [in]
+**      x_meas_ids: Tuple or list of the IDs of measurements to read, None to read all measurements
+**
+** @return
+**      List of samples. Each sample is a tuple of its timestamp followed by the value of each requested measurement
+**      (None if the measurement is not available in the sample)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_RtLog_Query (mp_obj_t x_start_time, mp_obj_t x_end_time, mp_obj_t x_meas_ids)
+{
+    MP_rtlog_query_t    stru_query;
+    uint32_t            u32_meas_mask = 0;
+
+    /* Validate the time range */
+    if (!mp_obj_is_int (x_start_time) || !mp_obj_is_int (x_end_time))
+    {
+        mp_raise_msg (&mp_type_TypeError, "Timestamps must be integer numbers");
+        return mp_const_none;
+    }
+
+    /* Build the list of requested measurements */
+    stru_query.u8_num_meas = 0;
+    if (x_meas_ids == mp_const_none)
+    {
+        for (uint8_t u8_meas_id = 0; u8_meas_id < RTLOG_NUM_MEAS; u8_meas_id++)
+        {
+            if (pstri_RTLOG_Get_Meas_Name (u8_meas_id) != NULL)
+            {
+                stru_query.au8_meas_ids[stru_query.u8_num_meas++] = u8_meas_id;
+                u32_meas_mask |= 1UL << u8_meas_id;
+            }
+        }
+    }
+    else
+    {
+        if ((!mp_obj_is_type (x_meas_ids, &mp_type_tuple)) && (!mp_obj_is_type (x_meas_ids, &mp_type_list)))
+        {
+            mp_raise_msg (&mp_type_TypeError, "Measurement IDs must be a tuple or a list");
+            return mp_const_none;
+        }
+
+        size_t      x_num_ids;
+        mp_obj_t *  px_ids;
+        mp_obj_get_array (x_meas_ids, &x_num_ids, &px_ids);
+        for (size_t x_idx = 0; x_idx < x_num_ids; x_idx++)
+        {
+            mp_int_t x_meas_id = mp_obj_get_int (px_ids[x_idx]);
+            if ((x_meas_id < 0) || (x_meas_id >= RTLOG_NUM_MEAS) ||
+                (pstri_RTLOG_Get_Meas_Name (x_meas_id) == NULL) || (u32_meas_mask & (1UL << x_meas_id)))
+            {
+                mp_raise_msg (&mp_type_ValueError, "Measurement ID is invalid or duplicated");
+                return mp_const_none;
+            }
+            stru_query.au8_meas_ids[stru_query.u8_num_meas++] = x_meas_id;
+            u32_meas_mask |= 1UL << x_meas_id;
+        }
+    }
+
+    /* Read the samples. Exceptions must not escape from the callback while the store is being accessed */
+    stru_query.x_samples = mp_obj_new_list (0, NULL);
+    stru_query.pv_exception = NULL;
+    int32_t s32_result = s32_RTLOG_Store_Query (mp_obj_get_int_truncated (x_start_time),
+                                                mp_obj_get_int_truncated (x_end_time), u32_meas_mask,
+                                                b_MP_RtLog_Add_Sample, &stru_query, NULL);
+    if (stru_query.pv_exception != NULL)
+    {
+        nlr_jump (stru_query.pv_exception);
+    }
+    if (s32_result == STATUS_ERR_NOT_INIT)
+    {
+        mp_raise_msg (&mp_type_OSError, "Realtime log store is not ready");
+        return mp_const_none;
+    }
+    if (s32_result != STATUS_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to read realtime log store");
+        return mp_const_none;
+    }
+
+    return stru_query.x_samples;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes realtime measurements staged in RAM onto flash
+**
+** @details
+**      Example:
+**          import rtlog
+**          rtlog.flush()
+**
+** @return
+**      @arg    None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_RtLog_Flush (void)
+{
+    if (s32_RTLOG_Store_Flush () != STATUS_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to flush realtime log store");
+    }
+    return mp_const_none;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets names of all realtime measurements
+**
+** @details
+**      Example:
+**          import rtlog
+**          for (meas_id, name) in rtlog.measurements().items():
+**              print(meas_id, name)
+**
+** @return
+**      Dictionary of measurement ID -> name of the measurement
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t x_MP_RtLog_Measurements (void)
+{
+    mp_obj_t x_dict = mp_obj_new_dict (0);
+
+    for (uint8_t u8_meas_id = 0; u8_meas_id < RTLOG_NUM_MEAS; u8_meas_id++)
+    {
+        const char * pstri_name = pstri_RTLOG_Get_Meas_Name (u8_meas_id);
+        if (pstri_name != NULL)
+        {
+            mp_obj_dict_store (x_dict, MP_OBJ_NEW_SMALL_INT (u8_meas_id),
+                               mp_obj_new_str (pstri_name, strlen (pstri_name)));
+        }
+    }
+    return x_dict;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends a sample found by the store to the result of rtlog.query()
+**
+** @details
+**      This function is invoked while the store is being accessed. An exception (e.g. out of memory) is caught here,
+**      stops the query and is raised again by x_MP_RtLog_Query() afterwards.
+**
+** @param [in]
+**      pstru_meas: The sample
+**
+** @param [in]
+**      pv_arg: Context of the query (MP_rtlog_query_t)
+**
+** @return
+**      @arg    true: Continue the query
+**      @arg    false: Stop the query
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MP_RtLog_Add_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg)
+{
+    MP_rtlog_query_t *  pstru_query = (MP_rtlog_query_t *)pv_arg;
+    mp_obj_t            ax_fields[1 + RTLOG_NUM_MEAS];
+    nlr_buf_t           x_nlr;
+
+    if (nlr_push (&x_nlr) == 0)
+    {
+        ax_fields[0] = mp_obj_new_int_from_uint (pstru_meas->u32_timestamp);
+        for (uint8_t u8_idx = 0; u8_idx < pstru_query->u8_num_meas; u8_idx++)
+        {
+            uint8_t u8_meas_id = pstru_query->au8_meas_ids[u8_idx];
+            ax_fields[1 + u8_idx] = (pstru_meas->u32_meas_mask & (1UL << u8_meas_id)) ?
+                                    mp_obj_new_float (flt_RTLOG_Get_Value (pstru_meas, u8_meas_id)) : mp_const_none;
+        }
+        mp_obj_list_append (pstru_query->x_samples, mp_obj_new_tuple (1 + pstru_query->u8_num_meas, ax_fields));
+        nlr_pop ();
+    }
+    else
+    {
+        pstru_query->pv_exception = x_nlr.ret_val;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
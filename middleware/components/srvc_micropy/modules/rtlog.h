@@ -0,0 +1,60 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : rtlog.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 15
+**  @brief      : Exports functions of rtlog MP module for binding into MicroPython
+**  @namespace  : MP
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_Micropy
+** @{
+*/
+
+#ifndef __RTLOG_H__
+#define __RTLOG_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "py/runtime.h"             /* Declaration of MicroPython interpreter */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Reads realtime measurements stored on flash in a time range */
+extern mp_obj_t x_MP_RtLog_Query (mp_obj_t x_start_time, mp_obj_t x_end_time, mp_obj_t x_meas_ids);
+
+/* Writes realtime measurements staged in RAM onto flash */
+extern mp_obj_t x_MP_RtLog_Flush (void);
+
+/* Gets names of all realtime measurements */
+extern mp_obj_t x_MP_RtLog_Measurements (void);
+
+#endif /* __RTLOG_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
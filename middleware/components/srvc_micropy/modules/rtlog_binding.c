@@ -0,0 +1,143 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : rtlog_binding.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 15
+**  @brief      : Registers functions and constants of rtlog MP module to MicroPython
+**  @namespace  : MP
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_Micropy
+** @brief       Declares functions and constants objects of rtlog module and registers them to MicroPython
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "rtlog.h"                  /* Use exported C-binding functions */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static mp_obj_t x_MP_Query_RtLog (size_t x_args, const mp_obj_t * px_pos_args, mp_map_t * px_kw_args);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Function object of x_MP_Query_RtLog() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_KW(query_fnc_obj, 2, x_MP_Query_RtLog);
+
+/** @brief  Function object of x_MP_RtLog_Flush() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(flush_fnc_obj, x_MP_RtLog_Flush);
+
+/** @brief  Function object of x_MP_RtLog_Measurements() */
+STATIC MP_DEFINE_CONST_FUN_OBJ_0(measurements_fnc_obj, x_MP_RtLog_Measurements);
+
+/** @brief  Declare all properties of the module */
+STATIC const mp_rom_map_elem_t x_rtlog_module_globals_table[] =
+{
+    { MP_ROM_QSTR(MP_QSTR___name__)             , MP_ROM_QSTR(MP_QSTR_rtlog)                },
+
+    /* Module functions */
+    { MP_ROM_QSTR(MP_QSTR_query)                , MP_ROM_PTR(&query_fnc_obj)                },
+    { MP_ROM_QSTR(MP_QSTR_flush)                , MP_ROM_PTR(&flush_fnc_obj)                },
+    { MP_ROM_QSTR(MP_QSTR_measurements)         , MP_ROM_PTR(&measurements_fnc_obj)         },
+};
+STATIC MP_DEFINE_CONST_DICT(x_rtlog_module_globals, x_rtlog_module_globals_table);
+
+/** @brief  Define module object */
+const mp_obj_module_t x_rtlog_module =
+{
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&x_rtlog_module_globals,
+};
+
+/** @brief  Register the module to make it available in MicroPython */
+MP_REGISTER_MODULE(MP_QSTR_rtlog, x_rtlog_module, true);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Binds rtlog.query() MP function with x_MP_RtLog_Query()
+**
+** @details
+**      Example:
+**          import rtlog
+**          rtlog.query(0, 60000)
+**          rtlog.query(0, 60000, ids=(0, 1))
+**
+** @param [in]
+**      x_args: Number of arguments passed into rtlog.query() function
+**
+** @param [in]
+**      px_pos_args: Pointer to the array of positional argruments passed into rtlog.query()
+**                   rtlog.query() requires 2 positional arguments and 1 optional keyword argument can be passed:
+**
+**                   Argument  | Type    | Default value | Description
+**                  -----------+---------+---------------+-----------------------------------------
+**                   (1st arg) | Number  |               | Timestamp (ms) of the first sample to read
+**                   (2nd arg) | Number  |               | Timestamp (ms) of the last sample to read
+**                   ids       | List    | None          | IDs of the measurements to read, None for all measurements
+**
+** @param [in]
+**      px_kw_args: Mapping for the keyword argruments
+**
+** @return
+**      List of samples found
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static mp_obj_t x_MP_Query_RtLog (size_t x_args, const mp_obj_t * px_pos_args, mp_map_t * px_kw_args)
+{
+    /* Argument description */
+    const mp_arg_t astru_allowed_args[] =
+    {
+        { MP_QSTR_start, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_end, MP_ARG_REQUIRED | MP_ARG_OBJ, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_ids, MP_ARG_OBJ, {.u_obj = mp_const_none} },
+    };
+
+    /* Parse the keyword argruments passed */
+    mp_arg_val_t ax_args [MP_ARRAY_SIZE (astru_allowed_args)];
+    mp_arg_parse_all (x_args, px_pos_args, px_kw_args, MP_ARRAY_SIZE (astru_allowed_args), astru_allowed_args, ax_args);
+
+    /* Read the samples */
+    return (x_MP_RtLog_Query (ax_args[0].u_obj, ax_args[1].u_obj, ax_args[2].u_obj));
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
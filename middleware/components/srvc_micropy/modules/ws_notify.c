@@ -62,11 +62,22 @@
 ** @brief
 **      Broadcasts status of slave board to all Websocket clients that connect to ws://<master_ip>/slave/status
 **
+** @details
+**      If a topic is given, the status is only sent to the clients subscribing to the topic, within the maximum rate
+**      of each client (see Srvc_WS_Server module)
+**
+** @param [in]
+**      x_args: Number of arguments
+**
 ** @param [in]
-**      x_status: Status to send to all Websocket clients. The status can be a string, or a tuple, or a list
-**                Examples: ws_notify.notify_slave_status("Bottom temperature = 102 Celsius degrees")
-**                          ws_notify.notify_slave_status((0x11, 0x22, 0x33, 0x44))
-**                          ws_notify.notify_slave_status([0x11, 0x22, 0x33, 0x44])
+**      px_args[0]: Status to send to all Websocket clients. The status can be a string, or a tuple, or a list
+**                  Examples: ws_notify.notify_slave_status("Bottom temperature = 102 Celsius degrees")
+**                            ws_notify.notify_slave_status((0x11, 0x22, 0x33, 0x44))
+**                            ws_notify.notify_slave_status([0x11, 0x22, 0x33, 0x44])
+**
+** @param [in]
+**      px_args[1]: (optional) Topic of the status, from 0 to 7
+**                  Example: ws_notify.notify_slave_status("Door opened", 2)
 **
 ** @return
 **      @arg    false: failed to notify status over Websocket connection
@@ -74,8 +85,12 @@
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-mp_obj_t x_MP_Notify_Slave_Status (mp_obj_t x_status)
+mp_obj_t x_MP_Notify_Slave_Status (size_t x_args, const mp_obj_t * px_args)
 {
+    mp_obj_t        x_status = px_args[0];
+    mp_int_t        x_topic = -1;
+    WSS_status_t    enm_result;
+
     /* Validate data type of the passed status */
     if ((!mp_obj_is_str (x_status)) &&
         (!mp_obj_is_type (x_status, &mp_type_tuple)) &&
@@ -85,6 +100,17 @@ mp_obj_t x_MP_Notify_Slave_Status (mp_obj_t x_status)
         return mp_const_false;
     }
 
+    /* Validate the topic if any */
+    if (x_args > 1)
+    {
+        x_topic = mp_obj_get_int (px_args[1]);
+        if ((x_topic < 0) || (x_topic >= WSS_MAX_TOPICS))
+        {
+            mp_raise_msg (&mp_type_ValueError, "Topic must be from 0 to 7");
+            return mp_const_false;
+        }
+    }
+
     /* Get instance of corresponding Websocket server channel */
     WSS_inst_t x_ws_inst = x_WSS_Get_Inst (WSS_SLAVE_STATUS);
     if (x_ws_inst == NULL)
@@ -103,11 +129,8 @@ mp_obj_t x_MP_Notify_Slave_Status (mp_obj_t x_status)
         uint16_t u16_len = strlen (pstri_data);
 
         /* Broadcast the status over the Websocket channel */
-        if (enm_WSS_Send (x_ws_inst, WSS_ALL_CLIENTS, pstri_data, u16_len) != WSS_OK)
-        {
-            mp_raise_msg (&mp_type_OSError, "Failed to broadcast the status over the Websocket channel");
-            return mp_const_false;
-        }
+        enm_result = (x_topic < 0) ? enm_WSS_Send (x_ws_inst, WSS_ALL_CLIENTS, pstri_data, u16_len) :
+                                     enm_WSS_Send_Topic (x_ws_inst, (uint8_t)x_topic, pstri_data, u16_len);
     }
     else
     {
@@ -137,16 +160,19 @@ mp_obj_t x_MP_Notify_Slave_Status (mp_obj_t x_status)
         }
 
         /* Broadcast the status over the Websocket channel */
-        if (enm_WSS_Send (x_ws_inst, WSS_ALL_CLIENTS, pu8_data, x_len) != WSS_OK)
-        {
-            mp_raise_msg (&mp_type_OSError, "Failed to broadcast the status over the Websocket channel");
-            return mp_const_false;
-        }
+        enm_result = (x_topic < 0) ? enm_WSS_Send (x_ws_inst, WSS_ALL_CLIENTS, pu8_data, x_len) :
+                                     enm_WSS_Send_Topic (x_ws_inst, (uint8_t)x_topic, pu8_data, x_len);
 
         /* Cleanup */
         free (pu8_data);
     }
 
+    if (enm_result != WSS_OK)
+    {
+        mp_raise_msg (&mp_type_OSError, "Failed to broadcast the status over the Websocket channel");
+        return mp_const_false;
+    }
+
     /* Successful */
     return mp_const_true;
 }
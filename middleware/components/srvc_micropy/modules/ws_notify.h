@@ -38,8 +38,11 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
-/* Broadcasts status of slave board to all Websocket clients that connect to ws://<master_ip>/slave/status */
-extern mp_obj_t x_MP_Notify_Slave_Status (mp_obj_t x_status);
+/*
+** Broadcasts status of slave board to all Websocket clients that connect to ws://<master_ip>/slave/status, or only to
+** the clients subscribing to the given topic
+*/
+extern mp_obj_t x_MP_Notify_Slave_Status (size_t x_args, const mp_obj_t * px_args);
 
 #endif /* __WS_NOTIFY_H__ */
 
@@ -43,7 +43,7 @@
 */
 
 /** @brief  Function object of x_MP_Notify_Slave_Status() */
-STATIC MP_DEFINE_CONST_FUN_OBJ_1(notify_slave_status_fnc_obj, x_MP_Notify_Slave_Status);
+STATIC MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(notify_slave_status_fnc_obj, 1, 2, x_MP_Notify_Slave_Status);
 
 /** @brief  Declare all properties of the module */
 STATIC const mp_rom_map_elem_t x_ws_notify_module_globals_table[] =
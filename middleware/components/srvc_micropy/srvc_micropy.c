@@ -122,8 +122,11 @@ static bool g_b_webrepl_running = MP_WEBREPL_AUTO_RUN;
 
 static void v_MP_Main_Task (void * pv_param);
 static int8_t s8_MP_Init_Env (void * pv_task_sp);
+static void v_MP_Reset_Modules (void);
 
 extern int8_t s8_MP_Que_Init (void);
+extern void v_MP_Que_Reclaim_Frames (void);
+extern void v_MP_Param_Reset (void);
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -291,6 +294,7 @@ static void v_MP_Main_Task (void * pv_param)
             LOGI ("Execute Python file %s...", g_stri_file_to_run);
             pyexec_file_if_exists (g_stri_file_to_run);
             g_stri_file_to_run[0] = 0;
+            v_MP_Reset_Modules ();
         }
 
         /* Run WebREPL service if requested so */
@@ -311,6 +315,7 @@ static void v_MP_Main_Task (void * pv_param)
             */
             if (pyexec_friendly_repl ())
             {
+                v_MP_Reset_Modules ();
                 g_b_webrepl_running = false;
                 LOGI ("Pause WebREPL service");
             }
@@ -357,6 +362,7 @@ static int8_t s8_MP_Init_Env (void * pv_task_sp)
     mp_stack_set_limit (MP_TASK_STACK_SIZE - 1024);
     gc_init (pv_micropython_heap, pv_micropython_heap + MP_MICROPYTHON_HEAP_SIZE);
     mp_init ();
+    v_MP_Reset_Modules ();
     mp_obj_list_append (mp_sys_path, MP_OBJ_NEW_QSTR (MP_QSTR__slash_lib));
     readline_init0 ();
 
@@ -370,6 +376,27 @@ static int8_t s8_MP_Init_Env (void * pv_task_sp)
     return MP_OK;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases the resources that C modules still hold on behalf of Python programs
+**
+** @details
+**      This function is called when MicroPython engine is initialized and whenever a Python program has ended
+**      (normally, by an exception or by a soft reset), i.e. when no Python code can use these resources any more.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MP_Reset_Modules (void)
+{
+    /* Give frames not released by cmp_queue.release_frame() back to the pool */
+    v_MP_Que_Reclaim_Frames ();
+
+    /* Abort the transaction begun by param.begin(), stop forwarding parameter changes to param.wait() */
+    v_MP_Param_Reset ();
+}
+
 /**
 ** @}
 */
@@ -52,9 +52,13 @@ X(  scanPost                        /* Checks aliveness of the device */
 X(  devResetPost                    /* Resets the device */                               )\
 X(  webReplRunPost                  /* Starts WebREPL interface of the device */          )\
 X(  otaUpdateCancelPost             /* Cancels an on-going OTA update process */          )\
+X(  mbTraceExportPost               /* Exports Modbus bus trace to a file */              )\
+X(  rtLogExportPost                 /* Exports stored realtime measurements to a file */  )\
                                                                                            \
 X(  paramReadRequest                /* Reads value of non-volatile settings */            )\
 X(  paramWriteRequest               /* Writes value of non-volatile settings */           )\
+X(  paramSnapshotReadRequest        /* Exports all non-volatile settings at once */       )\
+X(  paramSnapshotWriteRequest       /* Imports all non-volatile settings at once */       )\
 X(  fileListReadRequest             /* Gets list of all files in root directory */        )\
 X(  fileUploadWriteRequest          /* Uploads a file to the device */                    )\
 X(  fileDownloadReadRequest         /* Downloads an existing file from the device */      )\
@@ -74,7 +78,7 @@ X(  otaUpdateWriteRequest           /* Triggers OTA update process */
 
 /** @brief  Macro expanding an entry in request and post command table as prototype of commnad handler */
 #define EXPAND_RX_TABLE_AS_HANDLER_PROTOTYPE(COMMAND)           \
-    static void v_MQTTMN_##COMMAND##_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_command);
+    static void v_MQTTMN_##COMMAND##_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command);
 
 /** @brief  Index of request and post commands */
 #define EXPAND_RX_TABLE_AS_CMD_IDX(COMMAND, ...)                COMMAND,
@@ -84,6 +88,16 @@ enum
     MQTTMN_NUM_RX_CMD
 };
 
+/**
+** @brief   Number of slots in the hash table of request and post commands, which must be a power of 2 and at least
+**          twice the number of commands so that a lookup probes few slots
+*/
+#define MQTTMN_RX_CMD_HASH_SIZE             32
+
+/* Slots of the hash table are selected by masking the hash, and probing stops at the first empty slot */
+_Static_assert ((MQTTMN_RX_CMD_HASH_SIZE & (MQTTMN_RX_CMD_HASH_SIZE - 1)) == 0, "Hash size must be a power of 2");
+_Static_assert (MQTTMN_RX_CMD_HASH_SIZE >= 2 * MQTTMN_NUM_RX_CMD, "Hash table is too small for all commands");
+
 /** @brief  Number of concurrent communication sessions with back-office nodes */
 #define NUM_COMM_SESSIONS                   5
 
@@ -112,6 +126,7 @@ enum
     MQTTMN_OTA_DOWNLOAD_PROGRESS_EVT        = BIT1,     //!< Send notify on OTA firmware download progress
     MQTTMN_OTA_INSTALL_PROGRESS_EVT         = BIT2,     //!< Send notify on OTA firmware install progress
     MQTTMN_OTA_OVERALL_STATUS_EVT           = BIT3,     //!< Send notify on overall status of OTA firmware update
+    MQTTMN_FILE_DOWNLOAD_ACKED_EVT          = BIT4,     //!< The broker acknowledged a data message of file download
 };
 
 /** @brief  Structure encapsulating a connection session with a back-office node */
@@ -124,9 +139,23 @@ typedef struct
     char        stri_data_topic[96];                    //!< MQTT topic to send data to the back-office node
     uint32_t    u32_request_eid;                        //!< Exchange ID of current request command
     uint32_t    u32_post_eid;                           //!< Exchange ID of current post command
+    bool        b_cbor;                                 //!< Responses are in CBOR, as the last command received
 
 } MQTTMN_session_t;
 
+/**
+** @brief   Value in a received command, which is either in JSON or in CBOR format (see msg_reader.c)
+** @details A JSON command is parsed into cJSON objects. A CBOR command is read in place, without copying its data.
+*/
+typedef struct
+{
+    const cJSON *   px_json;                            //!< cJSON object of the value (JSON command)
+    const uint8_t * pu8_cbor;                           //!< First byte of the value, NULL for JSON command
+    const uint8_t * pu8_end;                            //!< End of the data of the CBOR command
+    uint32_t        u32_remaining;                      //!< Elements following this value in a CBOR array
+
+} MQTTMN_value_t;
+
 /** @brief  Structure encapsulating each command in request and post command table */
 typedef struct
 {
@@ -137,7 +166,7 @@ typedef struct
     bool b_is_request;
 
     /** @brief  Pointer to command handler */
-    void (*v_pfnc_cmd_handler) (MQTTMN_session_t * pstru_session, const cJSON * px_command);
+    void (*v_pfnc_cmd_handler) (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command);
 
 } MQTTMN_rx_cmd_t;
 
@@ -151,6 +180,8 @@ typedef struct
 #define NOTIFY_OTA_DOWNLOAD_PROGRESS        "otaDownloadProgress"
 #define NOTIFY_OTA_INSTALL_PROGRESS         "otaInstallProgress"
 #define NOTIFY_OTA_UPDATE_STATUS            "otaUpdateStatus"
+#define NOTIFY_MB_TRACE_EXPORT_STATUS       "mbTraceExportStatus"
+#define NOTIFY_RT_LOG_EXPORT_STATUS         "rtLogExportStatus"
 
 /** @brief  Values of common statuses for responses and statusNotify command */
 #define STATUS_OK                           "ok"
@@ -178,10 +209,11 @@ static bool b_MQTTMN_Parse_Topic (const char * pstri_topic, uint16_t u16_topic_l
                                   uint32_t * pu32_master_node_id, bool * pb_is_command);
 static MQTTMN_session_t * pstru_MQTTMN_Get_Session (uint32_t u32_master_node_id);
 static void v_MQTTMN_Process_Command (MQTTMN_session_t * pstru_session, const void * pv_data, uint32_t u32_len);
+static uint32_t u32_MQTTMN_Hash_Command (const char * pstri_command);
+static MQTTMN_rx_cmd_t * pstru_MQTTMN_Find_Command (const char * pstri_command);
 static void v_MQTTMN_Process_Data (MQTTMN_session_t * pstru_session, const void * pv_data,
                                    uint32_t u32_len, uint32_t u32_offset, uint32_t u32_total_len);
-static void v_MQTTMN_Data2Hex (const uint8_t * pu8_data, uint8_t u8_len, char ** ppstri_hex);
-static void v_MQTTMN_Hex2Data (const char * pstri_hex, uint8_t ** ppu8_data, uint8_t * pu8_len);
+static void v_MQTTMN_Hex2Data (const char * pstri_hex, uint8_t ** ppu8_data, uint16_t * pu16_len);
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -222,11 +254,13 @@ static uint32_t g_u32_slave_node_id = 0;
 /** @brief  Exchange ID for notify messages */
 static uint32_t g_u32_notify_eid = 0;
 
-/** @brief  Buffer storing uploading file path, if there is no file being uploaded, the buffer contains empty string */
-static char g_stri_upload_file [MAX_FILE_PATH_LEN];
-
-/** @brief  Buffer storing downloading file path, if there is no file being downloaded, the buffer contains empty string */
-static char g_stri_download_file [MAX_FILE_PATH_LEN];
+/**
+** @brief   Information obtained from the topic of the message being received, the topic is given with the first
+**          fragment of a message only
+*/
+static bool g_b_rx_topic_valid = false;
+static uint32_t g_u32_rx_master_node_id = 0;
+static bool g_b_rx_is_command = false;
 
 /** @brief  Array of all request and post commands */
 static MQTTMN_rx_cmd_t g_astru_rx_commands [MQTTMN_NUM_RX_CMD] =
@@ -234,6 +268,12 @@ static MQTTMN_rx_cmd_t g_astru_rx_commands [MQTTMN_NUM_RX_CMD] =
     MQTTMN_RX_CMD_TABLE (EXPAND_RX_TABLE_AS_STRUCT_INIT)
 };
 
+/**
+** @brief   Hash table of request and post commands, indexed by hash of their name with linear probing. Each slot holds
+**          the index in g_astru_rx_commands of a command plus 1, 0 if the slot is empty.
+*/
+static uint8_t g_au8_rx_cmd_hash [MQTTMN_RX_CMD_HASH_SIZE];
+
 /** @brief  Context data for FreeRTOS events */
 static struct
 {
@@ -250,9 +290,24 @@ static struct
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/* Reader of received commands */
+#include "msg_reader.c"
+
+/* Writer of JSON and CBOR messages */
+#include "json_writer.c"
+
 /* Response and notify commands */
 #include "tx_messages.c"
 
+/* Sending of downloaded files */
+#include "file_download.c"
+
+/* Storing of uploaded files */
+#include "file_upload.c"
+
+/* Telemetry messages */
+#include "telemetry.c"
+
 /* Request and post command handlers */
 #include "rx_messages.c"
 
@@ -307,18 +362,39 @@ int8_t s8_MQTTMN_Init (void)
         return MQTTMN_ERR;
     }
 
+    /* Allocate buffers for the messages sent by this module */
+    if (s8_MQTTMN_Json_Init () != MQTTMN_OK)
+    {
+        LOGE ("Failed to initialize JSON writer");
+        return MQTTMN_ERR;
+    }
+
+    /* Prepare sending of downloaded files */
+    if (s8_MQTTMN_Download_Init () != MQTTMN_OK)
+    {
+        LOGE ("Failed to initialize file download");
+        return MQTTMN_ERR;
+    }
+
     /* Initialize communication sessions */
     for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
     {
         g_astru_sessions[u8_idx].b_active = false;
     }
 
-    /* Determine message type of receive commands basing on their name */
+    /* Determine message type of receive commands basing on their name, and index them by hash of their name */
     for (uint8_t u8_idx = 0; u8_idx < MQTTMN_NUM_RX_CMD; u8_idx++)
     {
         MQTTMN_rx_cmd_t * pstru_cmd = &g_astru_rx_commands[u8_idx];
         uint8_t u8_cmd_len = strlen (pstru_cmd->pstri_command);
         pstru_cmd->b_is_request = (strcmp ("Request", &pstru_cmd->pstri_command[u8_cmd_len - 7]) == 0);
+
+        uint32_t u32_slot = u32_MQTTMN_Hash_Command (pstru_cmd->pstri_command) & (MQTTMN_RX_CMD_HASH_SIZE - 1);
+        while (g_au8_rx_cmd_hash[u32_slot] != 0)
+        {
+            u32_slot = (u32_slot + 1) & (MQTTMN_RX_CMD_HASH_SIZE - 1);
+        }
+        g_au8_rx_cmd_hash[u32_slot] = u8_idx + 1;
     }
 
     /* Get group ID string that this node belongs to */
@@ -352,6 +428,12 @@ int8_t s8_MQTTMN_Init (void)
               "itor3/s2m/%s/%08X/notify", g_pstri_group_id, g_u32_slave_node_id);
     v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_NOTIFY, stri_notify_topic);
 
+    /* MQTT topic for sending telemetry messages */
+    static char stri_telemetry_topic[64];
+    snprintf (stri_telemetry_topic, sizeof (stri_telemetry_topic),
+              "itor3/s2m/%s/%08X/telemetry", g_pstri_group_id, g_u32_slave_node_id);
+    v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_TELEMETRY, stri_telemetry_topic);
+
     /* Listen to MQTT events */
     v_MQTT_Register_Callback (g_x_mqtt, v_MQTTMN_Event_Handler, NULL);
 
@@ -528,6 +610,9 @@ static void v_MQTTMN_Main_Task (void * pv_param)
 {
     LOGD ("App_Mqtt_Mngr task started");
 
+    /* The messages sent by this task are written into their own buffer */
+    g_x_task_handle = xTaskGetCurrentTaskHandle ();
+
     /* Endless loop of the task */
     while (true)
     {
@@ -535,6 +620,7 @@ static void v_MQTTMN_Main_Task (void * pv_param)
         EventBits_t x_event_bits =
             xEventGroupWaitBits (g_x_event_group,       /* The event group to test the bits */
                                  MQTTMN_FILE_DOWNLOAD_STARTED_EVT |
+                                 MQTTMN_FILE_DOWNLOAD_ACKED_EVT   |
                                  MQTTMN_OTA_DOWNLOAD_PROGRESS_EVT |
                                  MQTTMN_OTA_INSTALL_PROGRESS_EVT  |
                                  MQTTMN_OTA_OVERALL_STATUS_EVT,
@@ -542,12 +628,8 @@ static void v_MQTTMN_Main_Task (void * pv_param)
                                  pdFALSE,               /* Whether to wait for all test bits to be set */
                                  pdMS_TO_TICKS (MQTTMN_TASK_PERIOD_MS));
 
-        /* If a file needs to be sent to back-office node */
-        if (x_event_bits & MQTTMN_FILE_DOWNLOAD_STARTED_EVT)
-        {
-            /* Publish content of the downloading file */
-            s8_MQTTMN_Publish_Downloading_File ();
-        }
+        /* Publish the next chunks of the file being sent to back-office node, if any */
+        v_MQTTMN_Download_Run ((x_event_bits & MQTTMN_FILE_DOWNLOAD_STARTED_EVT) != 0);
 
         /* If a notify about firmware download progress of OTA firmware update needs to be sent */
         if (x_event_bits & MQTTMN_OTA_DOWNLOAD_PROGRESS_EVT)
@@ -596,6 +678,9 @@ static void v_MQTTMN_Main_Task (void * pv_param)
             }
         }
 
+        /* Publish telemetry of the device periodically */
+        v_MQTTMN_Telemetry_Run ();
+
         /* Display remaining stack space every 30s */
         // PRINT_STACK_USAGE (30000);
     }
@@ -653,6 +738,13 @@ static void v_MQTTMN_Event_Handler (MQTT_evt_data_t * pstru_evt_data)
                                          pstru_evt_data->stru_receive.u32_totlen);
             break;
         }
+
+        /* The broker acknowledged a published message */
+        case MQTT_EVT_PUBLISHED:
+        {
+            v_MQTTMN_Download_Acked (pstru_evt_data->stru_publish.s32_msg_id);
+            break;
+        }
     }
 }
 
@@ -691,16 +783,28 @@ static void v_MQTTMN_Process_Rx_Message (const char * pstri_topic, uint16_t u16_
                                          uint32_t u32_data_len, uint32_t u32_offset, uint32_t u32_total_len)
 {
     /* Validate arguments */
-    ASSERT_PARAM ((pstri_topic != NULL) && (u16_topic_len < 256) && (pv_data != NULL));
+    ASSERT_PARAM ((u32_offset != 0) || ((pstri_topic != NULL) && (u16_topic_len < 256)));
+    ASSERT_PARAM (pv_data != NULL);
 
-    /* Parse the topic where we received the message from */
-    uint32_t u32_master_node_id;
-    bool b_is_command = false;
-    if (b_MQTTMN_Parse_Topic (pstri_topic, u16_topic_len, &u32_master_node_id, &b_is_command) == false)
+    /* Parse the topic where we received the message from, next fragments of the message don't contain the topic */
+    if (u32_offset == 0)
+    {
+        g_b_rx_is_command = false;
+        g_b_rx_topic_valid = b_MQTTMN_Parse_Topic (pstri_topic, u16_topic_len,
+                                                   &g_u32_rx_master_node_id, &g_b_rx_is_command);
+        if (!g_b_rx_topic_valid)
+        {
+            LOGE ("Topic of the received message is invalid");
+            return;
+        }
+    }
+    else if (!g_b_rx_topic_valid)
     {
-        LOGE ("Topic of the received message is invalid");
+        /* The first fragment of the message was discarded */
         return;
     }
+    uint32_t u32_master_node_id = g_u32_rx_master_node_id;
+    bool b_is_command = g_b_rx_is_command;
 
     /* Get the corresponding session with the master node */
     MQTTMN_session_t * pstru_session = pstru_MQTTMN_Get_Session (u32_master_node_id);
@@ -883,6 +987,7 @@ static MQTTMN_session_t * pstru_MQTTMN_Get_Session (uint32_t u32_master_node_id)
                       "itor3/s2m/%s/%08X/%08X/data", g_pstri_group_id, g_u32_slave_node_id, u32_master_node_id);
             pstru_session->u32_request_eid = 0;
             pstru_session->u32_post_eid = 0;
+            pstru_session->b_cbor = false;
         }
         else
         {
@@ -913,16 +1018,16 @@ static MQTTMN_session_t * pstru_MQTTMN_Get_Session (uint32_t u32_master_node_id)
 */
 static void v_MQTTMN_Process_Command (MQTTMN_session_t * pstru_session, const void * pv_data, uint32_t u32_len)
 {
-    cJSON *             px_json_root = NULL;
-    cJSON *             px_json_node = NULL;
-    char *              pstri_command = NULL;
+    MQTTMN_value_t      stru_root;
+    MQTTMN_value_t      stru_item;
+    char                stri_command[32];
+    const char *        pstri_command = NULL;
     uint32_t            u32_eid = 0;
     MQTTMN_rx_cmd_t *   pstru_cmd = NULL;
     bool                b_success = true;
 
-    /* Parse the command (JSON format) into JSON object */
-    px_json_root = cJSON_ParseWithLength (pv_data, u32_len);
-    if (px_json_root == NULL)
+    /* Parse the command (JSON or CBOR format) */
+    if (!b_MQTTMN_Msg_Parse (pv_data, u32_len, &stru_root))
     {
         LOGE ("Failed to parse received command: %.*s", u32_len, (char *)pv_data);
         b_success = false;
@@ -931,50 +1036,33 @@ static void v_MQTTMN_Process_Command (MQTTMN_session_t * pstru_session, const vo
     /* Get command name */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, JSON_KEY_CMD);
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (&stru_root, JSON_KEY_CMD, &stru_item) ||
+            ((pstri_command = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_command, sizeof (stri_command))) == NULL))
         {
             LOGE ("Invalid command received: No " JSON_KEY_CMD " key");
             b_success = false;
         }
-        else
-        {
-            pstri_command = px_json_node->valuestring;
-        }
     }
 
     /* Get exchange ID */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, JSON_KEY_EID);
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (&stru_root, JSON_KEY_EID, &stru_item) ||
+            !b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_eid))
         {
             LOGE ("Invalid request command received: No " JSON_KEY_EID " key");
             b_success = false;
         }
-        else
-        {
-            u32_eid = px_json_node->valueint;
-        }
     }
 
     /* Determine which command was received */
     if (b_success)
     {
-        b_success = false;
-        for (uint8_t u8_idx = 0; u8_idx < MQTTMN_NUM_RX_CMD; u8_idx++)
-        {
-            pstru_cmd = &g_astru_rx_commands[u8_idx];
-            if (strcmp (pstru_cmd->pstri_command, pstri_command) == 0)
-            {
-                b_success = true;
-                break;
-            }
-        }
-
-        if (!b_success)
+        pstru_cmd = pstru_MQTTMN_Find_Command (pstri_command);
+        if (pstru_cmd == NULL)
         {
             LOGE ("Received unsupported command: %s", pstri_command);
+            b_success = false;
         }
     }
 
@@ -990,7 +1078,7 @@ static void v_MQTTMN_Process_Command (MQTTMN_session_t * pstru_session, const vo
         }
         else
         {
-            /* Update session */
+            /* Update session, responses are in the format of the command */
             if (pstru_cmd->b_is_request)
             {
                 pstru_session->u32_request_eid = u32_eid;
@@ -999,170 +1087,74 @@ static void v_MQTTMN_Process_Command (MQTTMN_session_t * pstru_session, const vo
             {
                 pstru_session->u32_post_eid = u32_eid;
             }
+            pstru_session->b_cbor = (stru_root.pu8_cbor != NULL);
 
             /* Invoke command handler */
             LOGI ("Command %s received", pstri_command);
-            pstru_cmd->v_pfnc_cmd_handler (pstru_session, px_json_root);
+            pstru_cmd->v_pfnc_cmd_handler (pstru_session, &stru_root);
         }
     }
 
     /* Clean up */
-    if (px_json_root != NULL)
-    {
-        cJSON_Delete (px_json_root);
-    }
+    v_MQTTMN_Msg_Free (&stru_root);
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Processes received data message
-**
-** @note
-**      For data that exceeds the internal buffer, the data shall be split into multiple fragments. This function
-**      shall be invoked multiple times, each time for one fragment. u32_offset and u32_total_len are used to keep
-**      track of the fragmented data then.
-**
-** @param [in]
-**      pstru_session: the session through which the data message was received
-**
-** @param [in]
-**      pv_data: Pointer to fragment's data
-**
-** @param [in]
-**      u32_len: Length in bytes of the fragment's data
+**      Calculates hash of the name of a command (32-bit FNV-1a)
 **
 ** @param [in]
-**      u32_offset: Offset of this fragment in the whole topic data
+**      pstri_command: Name of the command
 **
-** @param [in]
-**      u32_total_len: Total length (in bytes) of the whole topic data
+** @return
+**      Hash of the name
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_Process_Data (MQTTMN_session_t * pstru_session, const void * pv_data,
-                                   uint32_t u32_len, uint32_t u32_offset, uint32_t u32_total_len)
+static uint32_t u32_MQTTMN_Hash_Command (const char * pstri_command)
 {
-    static lfs2_file_t x_file;
-
-    /* Check if a file is being uploaded (its file path is not an empty string) */
-    if (g_stri_upload_file[0] == 0)
-    {
-        LOGW ("Ignored received data, no file is being uploaded");
-        return;
-    }
-
-    /* Cancel uploading if received data is invalid */
-    uint32_t u32_rx_count = u32_offset + u32_len;
-    if ((u32_rx_count > u32_total_len) || (u32_total_len > MQTT_MAX_FILE_SIZE))
-    {
-        LOGE ("Received data of the uploaded file is invalid (offset = %d, length = %d, total length = %d",
-                  u32_offset, u32_len, u32_total_len);
-        g_stri_upload_file[0] = 0;
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, STATUS_ERR, "Invalid data");
-        return;
-    }
-
-    /* Open the destination file to write the data */
-    if (u32_offset == 0)
-    {
-        if (lfs2_file_open (g_px_lfs2, &x_file, g_stri_upload_file, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
-        {
-            LOGE ("Failed to open file %s for writing", g_stri_upload_file);
-            g_stri_upload_file[0] = 0;
-            s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, STATUS_ERR, "Failed to open file for writing");
-            return;
-        }
-    }
-
-    /* Store the received data to file */
-    if (lfs2_file_write (g_px_lfs2, &x_file, pv_data, u32_len) != u32_len)
+    uint32_t u32_hash = 2166136261U;
+    while (*pstri_command != 0)
     {
-        LOGE ("Failed to write data to file %s", g_stri_upload_file);
-        lfs2_file_close (g_px_lfs2, &x_file);
-        lfs2_remove (g_px_lfs2, g_stri_upload_file);
-        g_stri_upload_file[0] = 0;
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, STATUS_ERR, "Failed to write data to file");
-        return;
-    }
-
-    /* Display progress every 20% of the file has been stored */
-    if (u32_rx_count % (u32_total_len / 5) < u32_len)
-    {
-        LOGI ("%d/%d bytes of file %s has been received", u32_rx_count, u32_total_len, g_stri_upload_file);
-    }
-
-    /* If all data of this file has been written */
-    if (u32_rx_count == u32_total_len)
-    {
-        LOGI ("%d bytes of file %s has been received completely", u32_total_len, g_stri_upload_file);
-
-        /* Close and save file */
-        if (lfs2_file_close (g_px_lfs2, &x_file) < 0)
-        {
-            LOGE ("Failed to save file %s", g_stri_upload_file);
-            g_stri_upload_file[0] = 0;
-            s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, STATUS_ERR, "Failed to save file");
-            return;
-        }
-
-        /* File uploading done */
-        g_stri_upload_file[0] = 0;
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, STATUS_OK, "");
+        u32_hash = (u32_hash ^ (uint8_t)*pstri_command++) * 16777619U;
     }
+    return u32_hash;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Converts a block of data into hex string (NULL-terminated string)
-**
-** @note
-**      The memory allocated for the converted hexa string must be free after being used
+**      Finds a request or post command by its name
 **
 ** @details
-**      Example: Input  = 0x12-0x34-0x56-0x78-0x9A-0xBC
-**               Output = "12-34-56-78-9A-BC"
-**
-** @param [in]
-**      pu8_data: Pointer to the data
+**      The command is looked up in the hash table built when the module is initialized, so only the commands whose
+**      name has the same hash slot are compared, whatever the number of commands.
 **
 ** @param [in]
-**      u8_len: Length in bytes of the data
+**      pstri_command: Name of the command
 **
-** @param [out]
-**      ppstri_hex: The allocated buffer containing hexa string (NULL-terminated) representing the data, NULL if failed
+** @return
+**      @arg    NULL: The command is not supported
+**      @arg    Otherwise: The command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_Data2Hex (const uint8_t * pu8_data, uint8_t u8_len, char ** ppstri_hex)
+static MQTTMN_rx_cmd_t * pstru_MQTTMN_Find_Command (const char * pstri_command)
 {
-    /* Initialization */
-    *ppstri_hex = NULL;
-
-    /* Allocate memory for the converted string */
-    char * pstri_buf = malloc (u8_len * 3);
-    if (pstri_buf == NULL)
-    {
-        LOGE ("Failed to allocate memory for hexa converted string");
-        return;
-    }
-
-    /* Conver the data into hexa string */
-    for (uint8_t u8_idx = 0; u8_idx < u8_len; u8_idx++)
+    uint32_t u32_slot = u32_MQTTMN_Hash_Command (pstri_command) & (MQTTMN_RX_CMD_HASH_SIZE - 1);
+    while (g_au8_rx_cmd_hash[u32_slot] != 0)
     {
-        uint8_t u8_low_nibble = pu8_data[u8_idx] & 0x0F;
-        uint8_t u8_high_nibble = (pu8_data[u8_idx] >> 4) & 0x0F;
-        pstri_buf[u8_idx * 3 + 0] = (u8_high_nibble <= 9) ? ('0' + u8_high_nibble) : ('A' + (u8_high_nibble - 10));
-        pstri_buf[u8_idx * 3 + 1] = (u8_low_nibble <= 9) ? ('0' + u8_low_nibble) : ('A' + (u8_low_nibble - 10));
-        pstri_buf[u8_idx * 3 + 2] = '-';
+        MQTTMN_rx_cmd_t * pstru_cmd = &g_astru_rx_commands[g_au8_rx_cmd_hash[u32_slot] - 1];
+        if (strcmp (pstru_cmd->pstri_command, pstri_command) == 0)
+        {
+            return pstru_cmd;
+        }
+        u32_slot = (u32_slot + 1) & (MQTTMN_RX_CMD_HASH_SIZE - 1);
     }
-    pstri_buf[u8_len * 3 - 1] = 0;
-
-    /* Done */
-    *ppstri_hex = pstri_buf;
+    return NULL;
 }
 
 /**
@@ -1187,20 +1179,25 @@ static void v_MQTTMN_Data2Hex (const uint8_t * pu8_data, uint8_t u8_len, char **
 **      ppu8_data: Pointer to the allocated buffer containing the converted data, NULL if failed
 **
 ** @param [out]
-**      pu8_len: Length in bytes of the data, 0 if failed
+**      pu16_len: Length in bytes of the data, 0 if failed
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_Hex2Data (const char * pstri_hex, uint8_t ** ppu8_data, uint8_t * pu8_len)
+static void v_MQTTMN_Hex2Data (const char * pstri_hex, uint8_t ** ppu8_data, uint16_t * pu16_len)
 {
     /* Initialization */
     *ppu8_data = NULL;
-    *pu8_len = 0;
+    *pu16_len = 0;
 
     /* Allocated memory for the converted data */
-    uint8_t u8_nibbles = (uint8_t)(strlen (pstri_hex) + 1) * 2 / 3;
-    uint8_t u8_len = (u8_nibbles + 1) >> 1;
-    uint8_t * pu8_buf = malloc (u8_len);
+    size_t x_nibbles = (strlen (pstri_hex) + 1) * 2 / 3;
+    if (x_nibbles > (size_t)UINT16_MAX * 2)
+    {
+        LOGE ("Hexa string is too long");
+        return;
+    }
+    uint16_t u16_len = (uint16_t)((x_nibbles + 1) >> 1);
+    uint8_t * pu8_buf = malloc (u16_len);
     if (pu8_buf == NULL)
     {
         LOGE ("Failed to allocate memory for converted data");
@@ -1208,24 +1205,24 @@ static void v_MQTTMN_Hex2Data (const char * pstri_hex, uint8_t ** ppu8_data, uin
     }
 
     /* Convert hexa string into data */
-    for (uint8_t u8_idx = 0; u8_idx < u8_nibbles; u8_idx++)
+    for (size_t x_idx = 0; x_idx < x_nibbles; x_idx++)
     {
-        uint8_t u8_hex = pstri_hex [u8_idx * 3 / 2];
+        uint8_t u8_hex = pstri_hex [x_idx * 3 / 2];
         uint8_t u8_nibble = (u8_hex <= '9') ? (u8_hex - '0') :
                             (u8_hex <= 'F') ? (u8_hex - 'A' + 10) : (u8_hex - 'a' + 10);
-        if (u8_idx & 0x01)
+        if (x_idx & 0x01)
         {
-            pu8_buf [u8_idx >> 1] |= u8_nibble;
+            pu8_buf [x_idx >> 1] |= u8_nibble;
         }
         else
         {
-            pu8_buf [u8_idx >> 1] = (u8_nibble << 4);
+            pu8_buf [x_idx >> 1] = (u8_nibble << 4);
         }
     }
 
     /* Done */
     *ppu8_data = pu8_buf;
-    *pu8_len = u8_len;
+    *pu16_len = u16_len;
 }
 
 /**
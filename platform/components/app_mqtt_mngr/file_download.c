@@ -0,0 +1,585 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : file_download.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 9
+**  @brief      : This file contains the state machines sending content of downloaded files via data messages.
+**                Each session can download one file, the downloads in progress share the publishing fairly.
+**                app_mqtt_mngr.c includes this file directly.
+**  @namespace  : MQTTMN
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  App_Mqtt_Mngr
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "esp32/rom/crc.h"              /* Use ESP-IDF's CRC API */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @brief   Length in bytes of the header of each data message carrying a chunk of the downloaded file
+** @details The header contains, in big endian:
+**          - Offset in bytes of the chunk in the file (4 bytes)
+**          - CRC-32 (IEEE 802.3) of the chunk data (4 bytes)
+**          The chunk data follows the header, its length is the message length minus the header length.
+*/
+#define MQTTMN_DOWNLOAD_HDR_LEN             8
+
+/** @brief  Maximum time in milliseconds waiting for the broker to acknowledge a data message */
+#define MQTTMN_DOWNLOAD_ACK_TIMEOUT         30000
+
+/** @brief  Number of acknowledgements of data messages that can be pending in the queue */
+#define MQTTMN_DOWNLOAD_ACK_QUEUE_LEN       (CONFIG_MQTTMN_DOWNLOAD_WINDOW * CONFIG_MQTTMN_MAX_TRANSFERS * 2)
+
+/** @brief  States of the file download */
+typedef enum
+{
+    MQTTMN_DOWNLOAD_IDLE,                           //!< No file is being downloaded
+    MQTTMN_DOWNLOAD_REQUESTED,                      //!< A file is requested, it is opened on the next task tick
+    MQTTMN_DOWNLOAD_SENDING,                        //!< Data messages are being published
+    MQTTMN_DOWNLOAD_DRAINING,                       //!< All data messages are published, waiting for the last PUBACKs
+
+} MQTTMN_download_state_t;
+
+/** @brief  Context of the file download of a session */
+typedef struct
+{
+    volatile MQTTMN_download_state_t    enm_state;                  //!< State of the download
+    char                                stri_file_path[MAX_FILE_PATH_LEN];  //!< Path of the downloaded file
+    MQTTMN_session_t *                  pstru_session;              //!< Session requesting the download
+    uint32_t                            u32_master_node_id;         //!< Master node ID of the requesting session
+    lfs2_file_t                         x_file;                     //!< The downloaded file
+    uint32_t                            u32_file_size;              //!< Size in bytes of the downloaded file
+    uint32_t                            u32_offset;                 //!< Offset in the file of the next chunk
+    uint8_t *                           pu8_message;                //!< Buffer of a data message
+    uint8_t                             u8_num_in_flight;           //!< Number of messages waiting for PUBACK
+    int32_t                             as32_msg_ids[CONFIG_MQTTMN_DOWNLOAD_WINDOW];  //!< IDs of those messages
+    TickType_t                          x_ack_timer;                //!< Time since the last acknowledgement
+
+} MQTTMN_download_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  File downloads, one for each session (same index as in g_astru_sessions) */
+static MQTTMN_download_t g_astru_downloads[NUM_COMM_SESSIONS];
+
+/** @brief  IDs of the messages acknowledged by the broker */
+static QueueHandle_t g_x_download_ack_queue;
+
+/** @brief  Index of the download publishing first on the next task tick */
+static uint8_t g_u8_download_turn = 0;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static int8_t s8_MQTTMN_Download_Init (void);
+static int8_t s8_MQTTMN_Download_Request (MQTTMN_session_t * pstru_session, const char * pstri_file_path,
+                                          uint32_t u32_file_size, uint32_t u32_offset);
+static bool b_MQTTMN_Download_Is_Active (const MQTTMN_session_t * pstru_session);
+static uint8_t u8_MQTTMN_Download_Get_Count (void);
+static void v_MQTTMN_Download_Acked (int32_t s32_msg_id);
+static void v_MQTTMN_Download_Run (bool b_requested);
+static bool b_MQTTMN_Download_Open (MQTTMN_download_t * pstru_download);
+static void v_MQTTMN_Download_Process_Acks (void);
+static bool b_MQTTMN_Download_Publish_Chunk (MQTTMN_download_t * pstru_download);
+static void v_MQTTMN_Download_Finish (MQTTMN_download_t * pstru_download, const char * pstri_status,
+                                      const char * pstri_desc);
+static void v_MQTTMN_Download_Notify (const MQTTMN_download_t * pstru_download, const char * pstri_status,
+                                      const char * pstri_desc);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Initializes the file download state machine
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Download_Init (void)
+{
+    for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        g_astru_downloads[u8_idx].enm_state = MQTTMN_DOWNLOAD_IDLE;
+    }
+    g_x_download_ack_queue = xQueueCreate (MQTTMN_DOWNLOAD_ACK_QUEUE_LEN, sizeof (int32_t));
+    if (g_x_download_ack_queue == NULL)
+    {
+        LOGE ("Failed to create queue of acknowledged data messages");
+        return MQTTMN_ERR;
+    }
+    return MQTTMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Requests to download a file, which is then sent by App_Mqtt_Mngr task
+**
+** @param [in]
+**      pstru_session: the session requesting the download, data messages are sent to its data topic
+**
+** @param [in]
+**      pstri_file_path: Path of the file
+**
+** @param [in]
+**      u32_file_size: Size in bytes of the file
+**
+** @param [in]
+**      u32_offset: Offset in bytes in the file to start sending from, non-zero to resume an interrupted download
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR: Another file is being downloaded by the session
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Download_Request (MQTTMN_session_t * pstru_session, const char * pstri_file_path,
+                                          uint32_t u32_file_size, uint32_t u32_offset)
+{
+    MQTTMN_download_t * pstru_download = &g_astru_downloads[pstru_session - g_astru_sessions];
+    if (pstru_download->enm_state != MQTTMN_DOWNLOAD_IDLE)
+    {
+        return MQTTMN_ERR;
+    }
+
+    strncpy (pstru_download->stri_file_path, pstri_file_path, sizeof (pstru_download->stri_file_path));
+    pstru_download->stri_file_path [sizeof (pstru_download->stri_file_path) - 1] = 0;
+    pstru_download->pstru_session = pstru_session;
+    pstru_download->u32_master_node_id = pstru_session->u32_master_node_id;
+    pstru_download->u32_file_size = u32_file_size;
+    pstru_download->u32_offset = u32_offset;
+    pstru_download->enm_state = MQTTMN_DOWNLOAD_REQUESTED;
+
+    xEventGroupSetBits (g_x_event_group, MQTTMN_FILE_DOWNLOAD_STARTED_EVT);
+    return MQTTMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a file is being downloaded by a session
+**
+** @param [in]
+**      pstru_session: the session
+**
+** @return
+**      @arg    true: A file is being downloaded by the session
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Download_Is_Active (const MQTTMN_session_t * pstru_session)
+{
+    return g_astru_downloads[pstru_session - g_astru_sessions].enm_state != MQTTMN_DOWNLOAD_IDLE;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the number of files being downloaded
+**
+** @return
+**      Number of downloads in progress
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint8_t u8_MQTTMN_Download_Get_Count (void)
+{
+    uint8_t u8_count = 0;
+    for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        if (g_astru_downloads[u8_idx].enm_state != MQTTMN_DOWNLOAD_IDLE)
+        {
+            u8_count++;
+        }
+    }
+    return u8_count;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Records that the broker has acknowledged a published message
+**
+** @details
+**      This function is invoked by the task of the MQTT client. The message ID is queued and matched against the
+**      data messages in flight by App_Mqtt_Mngr task, so it does not matter if the acknowledgement comes before
+**      the message ID is recorded.
+**
+** @param [in]
+**      s32_msg_id: ID of the acknowledged message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Download_Acked (int32_t s32_msg_id)
+{
+    if (u8_MQTTMN_Download_Get_Count () == 0)
+    {
+        return;
+    }
+
+    if (xQueueSend (g_x_download_ack_queue, &s32_msg_id, 0) != pdTRUE)
+    {
+        LOGW ("Queue of acknowledged data messages is full, message %d is dropped", s32_msg_id);
+    }
+    xEventGroupSetBits (g_x_event_group, MQTTMN_FILE_DOWNLOAD_ACKED_EVT);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Advances the file downloads, this function is invoked by App_Mqtt_Mngr task on every tick
+**
+** @details
+**      Data messages of a download are published until CONFIG_MQTTMN_DOWNLOAD_WINDOW of them are waiting for
+**      acknowledgement, so this function never blocks on the network and the task keeps serving the other events
+**      meanwhile. The downloads in progress publish one chunk each in turn, starting from a different download on
+**      every tick, so that none of them delays the others. A download is aborted if the broker does not acknowledge
+**      any of its messages for MQTTMN_DOWNLOAD_ACK_TIMEOUT, the back-office node can then resume it from the last
+**      chunk received.
+**
+** @param [in]
+**      b_requested: MQTTMN_FILE_DOWNLOAD_STARTED_EVT has been received, the requests are complete
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Download_Run (bool b_requested)
+{
+    MQTTMN_download_t * pstru_download;
+    uint8_t u8_idx;
+
+    /* Open the requested files. Stop the downloads whose session has been closed or reused by another node */
+    for (u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        pstru_download = &g_astru_downloads[u8_idx];
+        if ((pstru_download->enm_state == MQTTMN_DOWNLOAD_REQUESTED) && b_requested)
+        {
+            if (b_MQTTMN_Download_Open (pstru_download))
+            {
+                pstru_download->enm_state = MQTTMN_DOWNLOAD_SENDING;
+            }
+        }
+
+        if ((pstru_download->enm_state == MQTTMN_DOWNLOAD_SENDING) ||
+            (pstru_download->enm_state == MQTTMN_DOWNLOAD_DRAINING))
+        {
+            MQTTMN_session_t * pstru_session = pstru_download->pstru_session;
+            if (!pstru_session->b_active || (pstru_session->u32_master_node_id != pstru_download->u32_master_node_id))
+            {
+                LOGW ("Session of downloading file %s has been closed", pstru_download->stri_file_path);
+                v_MQTTMN_Download_Finish (pstru_download, STATUS_ERR, "Session closed");
+            }
+        }
+    }
+
+    /* Free the window slots of the acknowledged messages */
+    v_MQTTMN_Download_Process_Acks ();
+
+    /* Publish the next chunk of each download in turn, while their window is not full */
+    bool b_published;
+    do
+    {
+        b_published = false;
+        for (u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+        {
+            pstru_download = &g_astru_downloads[(g_u8_download_turn + u8_idx) % NUM_COMM_SESSIONS];
+            if ((pstru_download->enm_state == MQTTMN_DOWNLOAD_SENDING) &&
+                (pstru_download->u8_num_in_flight < CONFIG_MQTTMN_DOWNLOAD_WINDOW))
+            {
+                if (pstru_download->u32_offset >= pstru_download->u32_file_size)
+                {
+                    pstru_download->enm_state = MQTTMN_DOWNLOAD_DRAINING;
+                }
+                else if (b_MQTTMN_Download_Publish_Chunk (pstru_download))
+                {
+                    b_published = true;
+                }
+            }
+        }
+    } while (b_published);
+    g_u8_download_turn = (g_u8_download_turn + 1) % NUM_COMM_SESSIONS;
+
+    /* A download is done once all its messages are acknowledged */
+    for (u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        pstru_download = &g_astru_downloads[u8_idx];
+        if ((pstru_download->enm_state != MQTTMN_DOWNLOAD_SENDING) &&
+            (pstru_download->enm_state != MQTTMN_DOWNLOAD_DRAINING))
+        {
+            continue;
+        }
+
+        if (pstru_download->u8_num_in_flight == 0)
+        {
+            if (pstru_download->enm_state == MQTTMN_DOWNLOAD_DRAINING)
+            {
+                LOGI ("%d bytes of file %s has been sent successfully", pstru_download->u32_file_size,
+                      pstru_download->stri_file_path);
+                v_MQTTMN_Download_Finish (pstru_download, STATUS_OK, "");
+            }
+        }
+        else if (TIMER_ELAPSED (pstru_download->x_ack_timer) >= pdMS_TO_TICKS (MQTTMN_DOWNLOAD_ACK_TIMEOUT))
+        {
+            LOGE ("Timeout waiting for acknowledgement of data of file %s", pstru_download->stri_file_path);
+            v_MQTTMN_Download_Finish (pstru_download, STATUS_ERR, "Timeout waiting for acknowledgement of file data");
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Opens the requested file and seeks to the requested offset
+**
+** @param [in]
+**      pstru_download: the download
+**
+** @return
+**      @arg    true: The file is ready to be sent
+**      @arg    false: The download has been finished with an error
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Download_Open (MQTTMN_download_t * pstru_download)
+{
+    LOGI ("Sending content of file %s from offset %d ...", pstru_download->stri_file_path,
+          pstru_download->u32_offset);
+
+    /* No message is waiting for acknowledgement yet */
+    pstru_download->u8_num_in_flight = 0;
+    TIMER_RESET (pstru_download->x_ack_timer);
+
+    /* Allocate buffer of data messages */
+    pstru_download->pu8_message = malloc (MQTTMN_DOWNLOAD_HDR_LEN + CONFIG_MQTTMN_DOWNLOAD_CHUNK_SIZE);
+    if (pstru_download->pu8_message == NULL)
+    {
+        LOGE ("Failed to allocate buffer for reading file data");
+        v_MQTTMN_Download_Notify (pstru_download, STATUS_ERR, "Failed to allocate memory for file data");
+        pstru_download->enm_state = MQTTMN_DOWNLOAD_IDLE;
+        return false;
+    }
+
+    /* Open the file for reading */
+    if (lfs2_file_open (g_px_lfs2, &pstru_download->x_file, pstru_download->stri_file_path, LFS2_O_RDONLY) < 0)
+    {
+        LOGE ("Failed to open file %s for reading", pstru_download->stri_file_path);
+        free (pstru_download->pu8_message);
+        v_MQTTMN_Download_Notify (pstru_download, STATUS_ERR, "Failed to open file for reading");
+        pstru_download->enm_state = MQTTMN_DOWNLOAD_IDLE;
+        return false;
+    }
+
+    /* Resume from the requested offset */
+    if (lfs2_file_seek (g_px_lfs2, &pstru_download->x_file, pstru_download->u32_offset, LFS2_SEEK_SET) < 0)
+    {
+        LOGE ("Failed to seek to offset %d of file %s", pstru_download->u32_offset, pstru_download->stri_file_path);
+        v_MQTTMN_Download_Finish (pstru_download, STATUS_ERR, "Failed to seek to the requested offset");
+        return false;
+    }
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Removes the messages acknowledged by the broker from the messages in flight of the downloads
+**
+** @details
+**      An acknowledgement is an activity of the session requesting the download, which is kept open meanwhile
+**
+** @note
+**      Acknowledgements of the other messages sent by this module (responses, notifies) are ignored
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Download_Process_Acks (void)
+{
+    int32_t s32_msg_id;
+    while (xQueueReceive (g_x_download_ack_queue, &s32_msg_id, 0) == pdTRUE)
+    {
+        for (uint8_t u8_dl_idx = 0; u8_dl_idx < NUM_COMM_SESSIONS; u8_dl_idx++)
+        {
+            MQTTMN_download_t * pstru_download = &g_astru_downloads[u8_dl_idx];
+            for (uint8_t u8_idx = 0; u8_idx < pstru_download->u8_num_in_flight; u8_idx++)
+            {
+                if (pstru_download->as32_msg_ids[u8_idx] == s32_msg_id)
+                {
+                    pstru_download->u8_num_in_flight--;
+                    pstru_download->as32_msg_ids[u8_idx] =
+                        pstru_download->as32_msg_ids[pstru_download->u8_num_in_flight];
+                    TIMER_RESET (pstru_download->x_ack_timer);
+                    TIMER_RESET (pstru_download->pstru_session->x_inact_timer);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads the next chunk of the file and queues it in a data message
+**
+** @param [in]
+**      pstru_download: the download
+**
+** @return
+**      @arg    true: The chunk has been queued
+**      @arg    false: The download has been finished with an error
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Download_Publish_Chunk (MQTTMN_download_t * pstru_download)
+{
+    uint8_t * pu8_message = pstru_download->pu8_message;
+    uint8_t * pu8_chunk = &pu8_message[MQTTMN_DOWNLOAD_HDR_LEN];
+    uint32_t u32_offset = pstru_download->u32_offset;
+
+    /* Read the chunk */
+    lfs2_ssize_t x_num_read = lfs2_file_read (g_px_lfs2, &pstru_download->x_file, pu8_chunk,
+                                              CONFIG_MQTTMN_DOWNLOAD_CHUNK_SIZE);
+    if (x_num_read <= 0)
+    {
+        LOGE ("Failed to read file %s at offset %d", pstru_download->stri_file_path, u32_offset);
+        v_MQTTMN_Download_Finish (pstru_download, STATUS_ERR, "Failed to read file data");
+        return false;
+    }
+
+    /* Header. Note that crc32_le() has a `~` at the beginning and the end of the function */
+    ENDIAN_PUT32_BE (&pu8_message[0], u32_offset);
+    ENDIAN_PUT32_BE (&pu8_message[4], crc32_le (0, pu8_chunk, x_num_read));
+
+    /* Queue the message to the data topic of the session */
+    int32_t s32_msg_id;
+    v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_DATA, pstru_download->pstru_session->stri_data_topic);
+    if (enm_MQTT_Enqueue (g_x_mqtt, MQTT_S2M_DATA, pu8_message, MQTTMN_DOWNLOAD_HDR_LEN + x_num_read,
+                          &s32_msg_id) != MQTT_OK)
+    {
+        LOGE ("Failed to publish file data to the master");
+        v_MQTTMN_Download_Finish (pstru_download, STATUS_ERR, "Failed to publish file data");
+        return false;
+    }
+
+    /* Messages of QoS 0 are not acknowledged */
+    if (s32_msg_id != 0)
+    {
+        if (pstru_download->u8_num_in_flight == 0)
+        {
+            TIMER_RESET (pstru_download->x_ack_timer);
+        }
+        pstru_download->as32_msg_ids[pstru_download->u8_num_in_flight++] = s32_msg_id;
+    }
+    pstru_download->u32_offset += x_num_read;
+
+    /* Display progress every 20% of the file has been sent */
+    if (pstru_download->u32_offset % (pstru_download->u32_file_size / 5 + 1) < (uint32_t)x_num_read)
+    {
+        LOGI ("%d bytes sent", pstru_download->u32_offset);
+    }
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Closes the downloaded file and reports the download status via a statusNotify command
+**
+** @param [in]
+**      pstru_download: the download
+**
+** @param [in]
+**      pstri_status: Download status
+**
+** @param [in]
+**      pstri_desc: Description of the status
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Download_Finish (MQTTMN_download_t * pstru_download, const char * pstri_status,
+                                      const char * pstri_desc)
+{
+    lfs2_file_close (g_px_lfs2, &pstru_download->x_file);
+    free (pstru_download->pu8_message);
+    pstru_download->pu8_message = NULL;
+    pstru_download->u8_num_in_flight = 0;
+    pstru_download->enm_state = MQTTMN_DOWNLOAD_IDLE;
+    v_MQTTMN_Download_Notify (pstru_download, pstri_status, pstri_desc);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reports the status of the download via a statusNotify command, which tells the downloaded file and the
+**      session downloading it
+**
+** @param [in]
+**      pstru_download: the download
+**
+** @param [in]
+**      pstri_status: Download status
+**
+** @param [in]
+**      pstri_desc: Description of the status
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Download_Notify (const MQTTMN_download_t * pstru_download, const char * pstri_status,
+                                      const char * pstri_desc)
+{
+    s8_MQTTMN_Send_Transfer_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, pstru_download->stri_file_path,
+                                          pstru_download->u32_master_node_id, pstri_status, pstri_desc);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
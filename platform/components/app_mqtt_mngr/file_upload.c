@@ -0,0 +1,605 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : file_upload.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 12
+**  @brief      : This file contains the storing of an uploaded file received via data messages. The data is written
+**                into a temporary file, which only takes the name of the uploaded file once its checksum is verified.
+**                Each session can upload one file.
+**                app_mqtt_mngr.c includes this file directly.
+**  @namespace  : MQTTMN
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  App_Mqtt_Mngr
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "esp32/rom/crc.h"              /* Use ESP-IDF's CRC API */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Suffix appended to the path of an uploaded file to get the path of its temporary file */
+#define MQTTMN_UPLOAD_TEMP_SUFFIX           ".part"
+
+/** @brief  Maximum length of the path of the temporary file of an uploaded file */
+#define MQTTMN_UPLOAD_TEMP_PATH_LEN         (MAX_FILE_PATH_LEN + sizeof (MQTTMN_UPLOAD_TEMP_SUFFIX) - 1)
+
+/** @brief  Type of the LittleFS attribute storing size and checksum of the uploaded file in its temporary file */
+#define MQTTMN_UPLOAD_ATTR_TYPE             0x55
+
+/** @brief  Length in bytes of the data read at a time when computing checksum of a partially uploaded file */
+#define MQTTMN_UPLOAD_READ_LEN              512
+
+/** @brief  Size and checksum of an uploaded file, stored in its temporary file so that the upload can be resumed */
+typedef struct
+{
+    uint32_t            u32_file_size;              //!< Size in bytes of the uploaded file
+    uint32_t            u32_checksum;               //!< CRC-32 (IEEE 802.3) of the uploaded file
+
+} MQTTMN_upload_attr_t;
+
+/** @brief  Context of the file upload of a session */
+typedef struct
+{
+    bool                                b_active;                   //!< A file is being uploaded
+    char                                stri_file_path[MAX_FILE_PATH_LEN];              //!< Path of the file
+    char                                stri_temp_path[MQTTMN_UPLOAD_TEMP_PATH_LEN];    //!< Path of temporary file
+    MQTTMN_session_t *                  pstru_session;              //!< Session uploading the file
+    uint32_t                            u32_master_node_id;         //!< Master node ID of the uploading session
+    lfs2_file_t                         x_file;                     //!< The temporary file
+    MQTTMN_upload_attr_t                stru_attr;                  //!< Expected size and checksum of the file
+    uint32_t                            u32_offset;                 //!< Number of bytes written so far
+    uint32_t                            u32_crc;                    //!< CRC-32 of the bytes written so far
+
+} MQTTMN_upload_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  File uploads, one for each session (same index as in g_astru_sessions) */
+static MQTTMN_upload_t g_astru_uploads[NUM_COMM_SESSIONS];
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static int8_t s8_MQTTMN_Upload_Start (MQTTMN_session_t * pstru_session, const char * pstri_file_path,
+                                      uint32_t u32_file_size, uint32_t u32_checksum, bool b_resume,
+                                      uint32_t * pu32_offset);
+static void v_MQTTMN_Upload_Cancel (MQTTMN_session_t * pstru_session);
+static bool b_MQTTMN_Upload_Is_Active (const MQTTMN_session_t * pstru_session);
+static const MQTTMN_session_t * pstru_MQTTMN_Upload_Get_Session (const char * pstri_file_path);
+static bool b_MQTTMN_Transfer_Available (void);
+static void v_MQTTMN_Upload_Release_Stale (void);
+static bool b_MQTTMN_Upload_Reopen (MQTTMN_upload_t * pstru_upload);
+static void v_MQTTMN_Upload_Complete (MQTTMN_session_t * pstru_session);
+static void v_MQTTMN_Upload_Abort (MQTTMN_upload_t * pstru_upload, const char * pstri_desc);
+static void v_MQTTMN_Upload_Notify (const MQTTMN_upload_t * pstru_upload, const char * pstri_status,
+                                    const char * pstri_desc);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts or resumes uploading a file
+**
+** @details
+**      When resuming, the data already stored in the temporary file is kept if it belongs to a file of the same size
+**      and checksum, and the upload continues from the end of that data. Otherwise, the upload starts from offset 0.
+**
+** @param [in]
+**      pstru_session: the session uploading the file, only data messages from its master node are accepted. The
+**                     file previously uploaded by the session, if any, is replaced by this one.
+**
+** @param [in]
+**      pstri_file_path: Path of the file
+**
+** @param [in]
+**      u32_file_size: Size in bytes of the file
+**
+** @param [in]
+**      u32_checksum: CRC-32 (IEEE 802.3) of the file
+**
+** @param [in]
+**      b_resume: true if the data already received for this file shall be kept
+**
+** @param [out]
+**      pu32_offset: Offset in the file from which the data shall be sent
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Upload_Start (MQTTMN_session_t * pstru_session, const char * pstri_file_path,
+                                      uint32_t u32_file_size, uint32_t u32_checksum, bool b_resume,
+                                      uint32_t * pu32_offset)
+{
+    MQTTMN_upload_t * pstru_upload = &g_astru_uploads[pstru_session - g_astru_sessions];
+    bool b_same_file = (strcmp (pstru_upload->stri_file_path, pstri_file_path) == 0) &&
+                       (pstru_upload->stru_attr.u32_file_size == u32_file_size) &&
+                       (pstru_upload->stru_attr.u32_checksum == u32_checksum);
+
+    /* The upload being interrupted is resumed from the data written so far, which is committed to the storage */
+    if (pstru_upload->b_active && b_same_file && b_resume)
+    {
+        if (lfs2_file_sync (g_px_lfs2, &pstru_upload->x_file) < 0)
+        {
+            LOGE ("Failed to save data of file %s", pstru_upload->stri_temp_path);
+            v_MQTTMN_Upload_Cancel (pstru_session);
+            return MQTTMN_ERR;
+        }
+        pstru_upload->u32_master_node_id = pstru_session->u32_master_node_id;
+        *pu32_offset = pstru_upload->u32_offset;
+        LOGI ("Resuming upload of file %s from offset %d", pstri_file_path, pstru_upload->u32_offset);
+        return MQTTMN_OK;
+    }
+
+    /* Stop the previous upload, its temporary file is kept so that it can be resumed later */
+    if (pstru_upload->b_active)
+    {
+        lfs2_file_close (g_px_lfs2, &pstru_upload->x_file);
+        pstru_upload->b_active = false;
+    }
+
+    /* Paths of the file and of its temporary file */
+    int s32_len = snprintf (pstru_upload->stri_temp_path, sizeof (pstru_upload->stri_temp_path), "%s%s",
+                            pstri_file_path, MQTTMN_UPLOAD_TEMP_SUFFIX);
+    if ((s32_len < 0) || (s32_len >= sizeof (pstru_upload->stri_temp_path)))
+    {
+        LOGE ("File path %s is too long", pstri_file_path);
+        pstru_upload->stri_file_path[0] = 0;
+        return MQTTMN_ERR;
+    }
+    strncpy (pstru_upload->stri_file_path, pstri_file_path, sizeof (pstru_upload->stri_file_path));
+    pstru_upload->stri_file_path[sizeof (pstru_upload->stri_file_path) - 1] = 0;
+    pstru_upload->stru_attr.u32_file_size = u32_file_size;
+    pstru_upload->stru_attr.u32_checksum = u32_checksum;
+    pstru_upload->pstru_session = pstru_session;
+    pstru_upload->u32_master_node_id = pstru_session->u32_master_node_id;
+    pstru_upload->u32_offset = 0;
+    pstru_upload->u32_crc = 0;
+
+    /* Resume from the data stored in the temporary file */
+    if (!(b_resume && b_MQTTMN_Upload_Reopen (pstru_upload)))
+    {
+        /* Start from offset 0 */
+        if (lfs2_file_open (g_px_lfs2, &pstru_upload->x_file, pstru_upload->stri_temp_path,
+                            LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
+        {
+            LOGE ("Failed to open file %s for writing", pstru_upload->stri_temp_path);
+            pstru_upload->stri_file_path[0] = 0;
+            return MQTTMN_ERR;
+        }
+        pstru_upload->u32_offset = 0;
+        pstru_upload->u32_crc = 0;
+
+        /* Tag the temporary file with the file it belongs to */
+        if (lfs2_setattr (g_px_lfs2, pstru_upload->stri_temp_path, MQTTMN_UPLOAD_ATTR_TYPE,
+                          &pstru_upload->stru_attr, sizeof (pstru_upload->stru_attr)) < 0)
+        {
+            LOGE ("Failed to set attribute of file %s", pstru_upload->stri_temp_path);
+            pstru_upload->b_active = true;
+            v_MQTTMN_Upload_Cancel (pstru_session);
+            return MQTTMN_ERR;
+        }
+    }
+
+    pstru_upload->b_active = true;
+    *pu32_offset = pstru_upload->u32_offset;
+    LOGI ("Uploading file %s from offset %d", pstri_file_path, pstru_upload->u32_offset);
+    return MQTTMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Cancels the upload that a session has just started, its temporary file is removed
+**
+** @param [in]
+**      pstru_session: the session uploading the file
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Upload_Cancel (MQTTMN_session_t * pstru_session)
+{
+    MQTTMN_upload_t * pstru_upload = &g_astru_uploads[pstru_session - g_astru_sessions];
+    if (pstru_upload->b_active)
+    {
+        lfs2_file_close (g_px_lfs2, &pstru_upload->x_file);
+        lfs2_remove (g_px_lfs2, pstru_upload->stri_temp_path);
+        pstru_upload->b_active = false;
+    }
+    pstru_upload->stri_file_path[0] = 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a file is being uploaded by a session
+**
+** @param [in]
+**      pstru_session: the session
+**
+** @return
+**      @arg    true: A file is being uploaded by the session
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Upload_Is_Active (const MQTTMN_session_t * pstru_session)
+{
+    return g_astru_uploads[pstru_session - g_astru_sessions].b_active;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the session uploading a file, such a file has not been verified yet
+**
+** @param [in]
+**      pstri_file_path: Path of the file
+**
+** @return
+**      @arg    NULL: The file is not being uploaded
+**      @arg    otherwise: The session uploading the file
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const MQTTMN_session_t * pstru_MQTTMN_Upload_Get_Session (const char * pstri_file_path)
+{
+    for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        MQTTMN_upload_t * pstru_upload = &g_astru_uploads[u8_idx];
+        if (pstru_upload->b_active && (strcmp (pstru_upload->stri_file_path, pstri_file_path) == 0))
+        {
+            return pstru_upload->pstru_session;
+        }
+    }
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a new file upload or download can be started
+**
+** @details
+**      The number of uploads and downloads in progress is limited to CONFIG_MQTTMN_MAX_TRANSFERS, which bounds the
+**      memory used by the file handles, the message buffers and the outbox of the MQTT client.
+**
+** @return
+**      @arg    true: A new transfer can be started
+**      @arg    false: Too many files are being transferred
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Transfer_Available (void)
+{
+    uint8_t u8_count = u8_MQTTMN_Download_Get_Count ();
+
+    v_MQTTMN_Upload_Release_Stale ();
+    for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        if (g_astru_uploads[u8_idx].b_active)
+        {
+            u8_count++;
+        }
+    }
+    return u8_count < CONFIG_MQTTMN_MAX_TRANSFERS;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Stops the uploads whose session has been closed or reused by another back-office node
+**
+** @details
+**      The data received so far is committed to the temporary file when it is closed, so the upload can still be
+**      resumed by a new session.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Upload_Release_Stale (void)
+{
+    for (uint8_t u8_idx = 0; u8_idx < NUM_COMM_SESSIONS; u8_idx++)
+    {
+        MQTTMN_upload_t * pstru_upload = &g_astru_uploads[u8_idx];
+        MQTTMN_session_t * pstru_session = pstru_upload->pstru_session;
+        if (pstru_upload->b_active &&
+            (!pstru_session->b_active || (pstru_session->u32_master_node_id != pstru_upload->u32_master_node_id)))
+        {
+            LOGW ("Session of uploading file %s has been closed", pstru_upload->stri_file_path);
+            lfs2_file_close (g_px_lfs2, &pstru_upload->x_file);
+            pstru_upload->b_active = false;
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Opens the temporary file left by an interrupted upload and computes checksum of the data it contains
+**
+** @details
+**      This is the case when App_Mqtt_Mngr has been restarted during the upload. Only the data committed to the
+**      storage is in the temporary file, the upload continues from the end of that data.
+**
+** @param [in]
+**      pstru_upload: the upload
+**
+** @return
+**      @arg    true: The temporary file belongs to the uploaded file and is opened at the end of its data
+**      @arg    false: The upload shall start from offset 0
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Upload_Reopen (MQTTMN_upload_t * pstru_upload)
+{
+    /* Check that the temporary file belongs to a file of the same size and checksum */
+    MQTTMN_upload_attr_t stru_attr;
+    if ((lfs2_getattr (g_px_lfs2, pstru_upload->stri_temp_path, MQTTMN_UPLOAD_ATTR_TYPE,
+                       &stru_attr, sizeof (stru_attr)) != sizeof (stru_attr)) ||
+        (memcmp (&stru_attr, &pstru_upload->stru_attr, sizeof (stru_attr)) != 0))
+    {
+        LOGW ("File %s doesn't belong to the uploaded file", pstru_upload->stri_temp_path);
+        return false;
+    }
+
+    /* Open the temporary file */
+    if (lfs2_file_open (g_px_lfs2, &pstru_upload->x_file, pstru_upload->stri_temp_path, LFS2_O_RDWR) < 0)
+    {
+        LOGW ("Failed to open file %s for reading", pstru_upload->stri_temp_path);
+        return false;
+    }
+
+    /* Compute checksum of its data */
+    uint8_t au8_data[MQTTMN_UPLOAD_READ_LEN];
+    lfs2_ssize_t x_num_read;
+    while ((x_num_read = lfs2_file_read (g_px_lfs2, &pstru_upload->x_file, au8_data, sizeof (au8_data))) > 0)
+    {
+        pstru_upload->u32_crc = crc32_le (pstru_upload->u32_crc, au8_data, x_num_read);
+        pstru_upload->u32_offset += x_num_read;
+    }
+    if ((x_num_read < 0) || (pstru_upload->u32_offset > pstru_upload->stru_attr.u32_file_size))
+    {
+        LOGW ("Data of file %s can't be resumed", pstru_upload->stri_temp_path);
+        lfs2_file_close (g_px_lfs2, &pstru_upload->x_file);
+        return false;
+    }
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Processes received data message
+**
+** @details
+**      Each data message carries the file data following the data received so far. The file can be sent in one or
+**      several data messages. The data written is committed to the storage at the end of each data message, this is
+**      the offset returned when the upload is resumed after App_Mqtt_Mngr has been restarted.
+**
+** @note
+**      For data that exceeds the internal buffer, the data shall be split into multiple fragments. This function
+**      shall be invoked multiple times, each time for one fragment. u32_offset and u32_total_len are used to keep
+**      track of the fragmented data then.
+**
+** @param [in]
+**      pstru_session: the session through which the data message was received
+**
+** @param [in]
+**      pv_data: Pointer to fragment's data
+**
+** @param [in]
+**      u32_len: Length in bytes of the fragment's data
+**
+** @param [in]
+**      u32_offset: Offset of this fragment in the whole topic data
+**
+** @param [in]
+**      u32_total_len: Total length (in bytes) of the whole topic data
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Process_Data (MQTTMN_session_t * pstru_session, const void * pv_data,
+                                   uint32_t u32_len, uint32_t u32_offset, uint32_t u32_total_len)
+{
+    MQTTMN_upload_t * pstru_upload = &g_astru_uploads[pstru_session - g_astru_sessions];
+
+    /* Check if a file is being uploaded by this master */
+    if (!pstru_upload->b_active || (pstru_session->u32_master_node_id != pstru_upload->u32_master_node_id))
+    {
+        LOGW ("Ignored received data, no file is being uploaded");
+        return;
+    }
+
+    /* Cancel uploading if received data is invalid */
+    uint32_t u32_rx_count = u32_offset + u32_len;
+    uint32_t u32_file_size = pstru_upload->stru_attr.u32_file_size;
+    if ((u32_rx_count > u32_total_len) || (pstru_upload->u32_offset + u32_len > u32_file_size))
+    {
+        LOGE ("Received data of the uploaded file is invalid (offset = %d, length = %d, total length = %d",
+                  pstru_upload->u32_offset, u32_len, u32_total_len);
+        v_MQTTMN_Upload_Abort (pstru_upload, "Invalid data");
+        return;
+    }
+
+    /* Store the received data to the temporary file */
+    if (lfs2_file_write (g_px_lfs2, &pstru_upload->x_file, pv_data, u32_len) != u32_len)
+    {
+        LOGE ("Failed to write data to file %s", pstru_upload->stri_temp_path);
+        v_MQTTMN_Upload_Abort (pstru_upload, "Failed to write data to file");
+        return;
+    }
+    pstru_upload->u32_crc = crc32_le (pstru_upload->u32_crc, pv_data, u32_len);
+    pstru_upload->u32_offset += u32_len;
+
+    /* Display progress every 20% of the file has been stored */
+    if (pstru_upload->u32_offset % (u32_file_size / 5 + 1) < u32_len)
+    {
+        LOGI ("%d/%d bytes of file %s has been received", pstru_upload->u32_offset, u32_file_size,
+              pstru_upload->stri_file_path);
+    }
+
+    /* End of the data message */
+    if (u32_rx_count == u32_total_len)
+    {
+        if (pstru_upload->u32_offset == u32_file_size)
+        {
+            v_MQTTMN_Upload_Complete (pstru_session);
+        }
+        else if (lfs2_file_sync (g_px_lfs2, &pstru_upload->x_file) < 0)
+        {
+            LOGE ("Failed to save data of file %s", pstru_upload->stri_temp_path);
+            v_MQTTMN_Upload_Abort (pstru_upload, "Failed to save file");
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Verifies checksum of the uploaded file and gives the temporary file the name of the uploaded file
+**
+** @details
+**      LittleFS renames a file atomically: the uploaded file either doesn't exist or has been verified.
+**      The upload status is reported via a statusNotify command.
+**
+** @param [in]
+**      pstru_session: the session uploading the file
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Upload_Complete (MQTTMN_session_t * pstru_session)
+{
+    MQTTMN_upload_t * pstru_upload = &g_astru_uploads[pstru_session - g_astru_sessions];
+
+    LOGI ("%d bytes of file %s has been received completely", pstru_upload->u32_offset,
+          pstru_upload->stri_file_path);
+
+    /* Close and save the temporary file */
+    pstru_upload->b_active = false;
+    if (lfs2_file_close (g_px_lfs2, &pstru_upload->x_file) < 0)
+    {
+        LOGE ("Failed to save file %s", pstru_upload->stri_temp_path);
+        lfs2_remove (g_px_lfs2, pstru_upload->stri_temp_path);
+        v_MQTTMN_Upload_Notify (pstru_upload, STATUS_ERR, "Failed to save file");
+        pstru_upload->stri_file_path[0] = 0;
+        return;
+    }
+
+    /* Verify the checksum */
+    if (pstru_upload->u32_crc != pstru_upload->stru_attr.u32_checksum)
+    {
+        LOGE ("Checksum of file %s is 0x%08X, expected 0x%08X", pstru_upload->stri_file_path,
+              pstru_upload->u32_crc, pstru_upload->stru_attr.u32_checksum);
+        lfs2_remove (g_px_lfs2, pstru_upload->stri_temp_path);
+        v_MQTTMN_Upload_Notify (pstru_upload, STATUS_ERR, "Checksum mismatch");
+        pstru_upload->stri_file_path[0] = 0;
+        return;
+    }
+
+    /* Give the verified file its name */
+    if (lfs2_rename (g_px_lfs2, pstru_upload->stri_temp_path, pstru_upload->stri_file_path) < 0)
+    {
+        LOGE ("Failed to rename file %s", pstru_upload->stri_temp_path);
+        lfs2_remove (g_px_lfs2, pstru_upload->stri_temp_path);
+        v_MQTTMN_Upload_Notify (pstru_upload, STATUS_ERR, "Failed to save file");
+        pstru_upload->stri_file_path[0] = 0;
+        return;
+    }
+
+    /* File uploading done */
+    v_MQTTMN_Upload_Notify (pstru_upload, STATUS_OK, "");
+    pstru_upload->stri_file_path[0] = 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Stops the upload on an error, removes its temporary file and reports the error via a statusNotify command
+**
+** @param [in]
+**      pstru_upload: the upload
+**
+** @param [in]
+**      pstri_desc: Description of the error
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Upload_Abort (MQTTMN_upload_t * pstru_upload, const char * pstri_desc)
+{
+    v_MQTTMN_Upload_Notify (pstru_upload, STATUS_ERR, pstri_desc);
+    v_MQTTMN_Upload_Cancel (pstru_upload->pstru_session);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reports the status of the upload via a statusNotify command, which tells the uploaded file and the session
+**      uploading it
+**
+** @param [in]
+**      pstru_upload: the upload, its file path must still be set
+**
+** @param [in]
+**      pstri_status: Upload status
+**
+** @param [in]
+**      pstri_desc: Description of the status
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Upload_Notify (const MQTTMN_upload_t * pstru_upload, const char * pstri_status,
+                                    const char * pstri_desc)
+{
+    s8_MQTTMN_Send_Transfer_statusNotify (NOTIFY_FILE_UPLOAD_STATUS, pstru_upload->stri_file_path,
+                                          pstru_upload->u32_master_node_id, pstri_status, pstri_desc);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
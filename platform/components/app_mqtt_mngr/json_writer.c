@@ -0,0 +1,813 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : json_writer.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 2
+**  @brief      : This file contains the streaming writer of compact JSON messages sent by this module, which also
+**                writes CBOR messages in response to CBOR commands. app_mqtt_mngr.c includes this file directly.
+**  @namespace  : MQTTMN
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  App_Mqtt_Mngr
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#ifdef CONFIG_MQTTMN_BENCHMARK_ENABLED
+#include "esp_timer.h"              /* Use esp_timer_get_time() */
+#endif
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @brief   Number of message buffers
+** @details Messages are sent by App_Mqtt_Mngr task (buffer 0) and by the task of MQTT client invoking
+**          v_MQTTMN_Event_Handler() (buffer 1). Each task writes its messages into its own buffer.
+*/
+#define MQTTMN_JSON_NUM_BUFS                2
+
+/** @brief  Number of messages encoded by the benchmark */
+#define MQTTMN_BENCHMARK_MESSAGES           1000
+
+/** @brief  Number of parameters in the paramReadResponse message encoded by the benchmark */
+#define MQTTMN_BENCHMARK_PARAMS             16
+
+/**
+** @brief   Writer of a JSON or CBOR message into a message buffer
+** @details CBOR messages use the same calls as JSON messages. Objects and arrays are written as maps and arrays of
+**          indefinite length, integers natively and blocks of data as byte strings.
+*/
+typedef struct
+{
+    char *          pstri_buf;                      //!< The message buffer
+    uint32_t        u32_size;                       //!< Size in bytes of the message buffer
+    uint32_t        u32_len;                        //!< Length in bytes of the message written so far
+    bool            b_comma;                        //!< A comma is needed before the next value
+    bool            b_overflow;                     //!< The message does not fit in the buffer
+    bool            b_cbor;                         //!< The message is written in CBOR
+    const char *    pstri_cmd;                      //!< Command of the message
+} MQTTMN_json_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Message buffers, allocated once with the size of the transmit buffer of the MQTT client */
+static char * g_apstri_json_bufs[MQTTMN_JSON_NUM_BUFS];
+
+/** @brief  Size in bytes of each message buffer */
+static uint32_t g_u32_json_buf_size = 0;
+
+/** @brief  Handle of App_Mqtt_Mngr task */
+static TaskHandle_t g_x_task_handle = NULL;
+
+/** @brief  Allocator of the JSON writer, replaced during the benchmark to count its allocations */
+static void * (*g_pfnc_json_malloc) (size_t x_size) = malloc;
+
+#ifdef CONFIG_MQTTMN_BENCHMARK_ENABLED
+/** @brief  Number of memory allocations made by cJSON or by the JSON writer during the benchmark */
+static uint32_t g_u32_json_num_allocs = 0;
+#endif
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static int8_t s8_MQTTMN_Json_Init (void);
+static void v_MQTTMN_Json_Begin (MQTTMN_json_t * pstru_json, const char * pstri_cmd, uint32_t u32_eid, bool b_cbor);
+static const char * pstri_MQTTMN_Json_End (MQTTMN_json_t * pstru_json, uint32_t * pu32_len);
+static void v_MQTTMN_Json_Add_String (MQTTMN_json_t * pstru_json, const char * pstri_key, const char * pstri_value);
+static void v_MQTTMN_Json_Add_Uint32 (MQTTMN_json_t * pstru_json, const char * pstri_key, uint32_t u32_value);
+static void v_MQTTMN_Json_Add_Int32 (MQTTMN_json_t * pstru_json, const char * pstri_key, int32_t s32_value);
+static void v_MQTTMN_Json_Add_Hex (MQTTMN_json_t * pstru_json, const char * pstri_key,
+                                   const uint8_t * pu8_data, uint16_t u16_len);
+static void v_MQTTMN_Json_Begin_Object (MQTTMN_json_t * pstru_json, const char * pstri_key);
+static void v_MQTTMN_Json_End_Object (MQTTMN_json_t * pstru_json);
+static void v_MQTTMN_Json_Begin_Array (MQTTMN_json_t * pstru_json, const char * pstri_key);
+static void v_MQTTMN_Json_End_Array (MQTTMN_json_t * pstru_json);
+static void v_MQTTMN_Json_Put_Key (MQTTMN_json_t * pstru_json, const char * pstri_key);
+static void v_MQTTMN_Json_Put (MQTTMN_json_t * pstru_json, const char * pstri_data, uint32_t u32_len);
+static void v_MQTTMN_Json_Put_Char (MQTTMN_json_t * pstru_json, char c_data);
+static void v_MQTTMN_Json_Put_Cbor_Head (MQTTMN_json_t * pstru_json, uint8_t u8_major, uint32_t u32_arg);
+
+#ifdef CONFIG_MQTTMN_BENCHMARK_ENABLED
+static void v_MQTTMN_Json_Run_Benchmark (void);
+static void * pv_MQTTMN_Json_Counting_Malloc (size_t x_size);
+#endif
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates the message buffers of the JSON writer
+**
+** @details
+**      A message longer than the transmit buffer of the MQTT client would be split by the client anyway, so the
+**      buffers have the same size
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Json_Init (void)
+{
+    g_u32_json_buf_size = u32_MQTT_Get_Tx_Buffer_Size (g_x_mqtt);
+    for (uint8_t u8_idx = 0; u8_idx < MQTTMN_JSON_NUM_BUFS; u8_idx++)
+    {
+        if (g_apstri_json_bufs[u8_idx] == NULL)
+        {
+            g_apstri_json_bufs[u8_idx] = g_pfnc_json_malloc (g_u32_json_buf_size);
+        }
+        if (g_apstri_json_bufs[u8_idx] == NULL)
+        {
+            LOGE ("Failed to allocate memory (%u bytes) for JSON messages", g_u32_json_buf_size);
+            return MQTTMN_ERR;
+        }
+    }
+
+#ifdef CONFIG_MQTTMN_BENCHMARK_ENABLED
+    v_MQTTMN_Json_Run_Benchmark ();
+#endif
+
+    return MQTTMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts writing a JSON or CBOR message into the message buffer of the calling task
+**
+** @details
+**      The message starts with the common keys of all commands: {"command":"<pstri_cmd>","eid":<u32_eid>
+**
+** @param [out]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_cmd: Command of the message
+**
+** @param [in]
+**      u32_eid: Exchange ID of the message
+**
+** @param [in]
+**      b_cbor: The message is written in CBOR instead of JSON
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Begin (MQTTMN_json_t * pstru_json, const char * pstri_cmd, uint32_t u32_eid, bool b_cbor)
+{
+    uint8_t u8_buf_idx = (xTaskGetCurrentTaskHandle () == g_x_task_handle) ? 0 : 1;
+
+    pstru_json->pstri_buf = g_apstri_json_bufs[u8_buf_idx];
+    pstru_json->u32_size = g_u32_json_buf_size;
+    pstru_json->u32_len = 0;
+    pstru_json->b_comma = false;
+    pstru_json->b_overflow = (pstru_json->pstri_buf == NULL);
+    pstru_json->b_cbor = b_cbor;
+    pstru_json->pstri_cmd = pstri_cmd;
+
+    v_MQTTMN_Json_Begin_Object (pstru_json, NULL);
+    v_MQTTMN_Json_Add_String (pstru_json, JSON_KEY_CMD, pstri_cmd);
+    v_MQTTMN_Json_Add_Uint32 (pstru_json, JSON_KEY_EID, u32_eid);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finishes writing a JSON or CBOR message
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [out]
+**      pu32_len: Length in bytes of the message
+**
+** @return
+**      @arg    NULL: The message does not fit in the message buffer
+**      @arg    Otherwise: NULL-terminated message, which is valid until the calling task starts another message.
+**                         A CBOR message may contain NULL characters, only the returned length tells its end
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const char * pstri_MQTTMN_Json_End (MQTTMN_json_t * pstru_json, uint32_t * pu32_len)
+{
+    v_MQTTMN_Json_End_Object (pstru_json);
+    v_MQTTMN_Json_Put_Char (pstru_json, 0);
+    if (pstru_json->b_overflow)
+    {
+        LOGE ("Command %s exceeds %u bytes", pstru_json->pstri_cmd, pstru_json->u32_size);
+        *pu32_len = 0;
+        return NULL;
+    }
+
+    *pu32_len = pstru_json->u32_len - 1;
+    return pstru_json->pstri_buf;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a string value, escaping the characters that JSON does not allow in strings (CBOR text strings need no
+**      escaping)
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the value in the current object, NULL if the value is an element of the current array
+**
+** @param [in]
+**      pstri_value: The string
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Add_String (MQTTMN_json_t * pstru_json, const char * pstri_key, const char * pstri_value)
+{
+    static const char stri_hex_digits[] = "0123456789abcdef";
+
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    if (pstru_json->b_cbor)
+    {
+        uint32_t u32_len = strlen (pstri_value);
+        v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_TEXT, u32_len);
+        v_MQTTMN_Json_Put (pstru_json, pstri_value, u32_len);
+        return;
+    }
+    v_MQTTMN_Json_Put_Char (pstru_json, '"');
+    for (const char * pc_char = pstri_value; *pc_char != 0; pc_char++)
+    {
+        /* Copy the characters that need no escaping at once */
+        const char * pc_start = pc_char;
+        while ((*pc_char != 0) && (*pc_char != '"') && (*pc_char != '\\') && ((uint8_t)*pc_char >= 0x20))
+        {
+            pc_char++;
+        }
+        v_MQTTMN_Json_Put (pstru_json, pc_start, pc_char - pc_start);
+        if (*pc_char == 0)
+        {
+            break;
+        }
+
+        /* Escape the character */
+        v_MQTTMN_Json_Put_Char (pstru_json, '\\');
+        switch (*pc_char)
+        {
+            case '"':
+            case '\\':
+                v_MQTTMN_Json_Put_Char (pstru_json, *pc_char);
+                break;
+
+            case '\n':
+                v_MQTTMN_Json_Put_Char (pstru_json, 'n');
+                break;
+
+            case '\r':
+                v_MQTTMN_Json_Put_Char (pstru_json, 'r');
+                break;
+
+            case '\t':
+                v_MQTTMN_Json_Put_Char (pstru_json, 't');
+                break;
+
+            default:
+                v_MQTTMN_Json_Put (pstru_json, "u00", 3);
+                v_MQTTMN_Json_Put_Char (pstru_json, stri_hex_digits[(uint8_t)*pc_char >> 4]);
+                v_MQTTMN_Json_Put_Char (pstru_json, stri_hex_digits[(uint8_t)*pc_char & 0x0F]);
+                break;
+        }
+    }
+    v_MQTTMN_Json_Put_Char (pstru_json, '"');
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes an unsigned integer value
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the value in the current object, NULL if the value is an element of the current array
+**
+** @param [in]
+**      u32_value: The value
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Add_Uint32 (MQTTMN_json_t * pstru_json, const char * pstri_key, uint32_t u32_value)
+{
+    char stri_value[12];
+
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    if (pstru_json->b_cbor)
+    {
+        v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_UINT, u32_value);
+        return;
+    }
+    v_MQTTMN_Json_Put (pstru_json, stri_value, snprintf (stri_value, sizeof (stri_value), "%u", u32_value));
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a signed integer value
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the value in the current object, NULL if the value is an element of the current array
+**
+** @param [in]
+**      s32_value: The value
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Add_Int32 (MQTTMN_json_t * pstru_json, const char * pstri_key, int32_t s32_value)
+{
+    char stri_value[12];
+
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    if (pstru_json->b_cbor)
+    {
+        if (s32_value < 0)
+        {
+            v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_NEGINT, (uint32_t)(-1 - s32_value));
+        }
+        else
+        {
+            v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_UINT, (uint32_t)s32_value);
+        }
+        return;
+    }
+    v_MQTTMN_Json_Put (pstru_json, stri_value, snprintf (stri_value, sizeof (stri_value), "%d", s32_value));
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a block of data as a hex string, in the format parsed by v_MQTTMN_Hex2Data()
+**
+** @details
+**      Example: Input  = 0x12-0x34-0x56-0x78-0x9A-0xBC
+**               Output = "12-34-56-78-9A-BC"
+**      A CBOR message contains the data as it is, in a byte string
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the value in the current object, NULL if the value is an element of the current array
+**
+** @param [in]
+**      pu8_data: Pointer to the data
+**
+** @param [in]
+**      u16_len: Length in bytes of the data
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Add_Hex (MQTTMN_json_t * pstru_json, const char * pstri_key,
+                                   const uint8_t * pu8_data, uint16_t u16_len)
+{
+    static const char stri_hex_digits[] = "0123456789ABCDEF";
+
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    if (pstru_json->b_cbor)
+    {
+        v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_BYTES, u16_len);
+        v_MQTTMN_Json_Put (pstru_json, (const char *)pu8_data, u16_len);
+        return;
+    }
+    v_MQTTMN_Json_Put_Char (pstru_json, '"');
+    for (uint16_t u16_idx = 0; u16_idx < u16_len; u16_idx++)
+    {
+        if (u16_idx > 0)
+        {
+            v_MQTTMN_Json_Put_Char (pstru_json, '-');
+        }
+        v_MQTTMN_Json_Put_Char (pstru_json, stri_hex_digits[pu8_data[u16_idx] >> 4]);
+        v_MQTTMN_Json_Put_Char (pstru_json, stri_hex_digits[pu8_data[u16_idx] & 0x0F]);
+    }
+    v_MQTTMN_Json_Put_Char (pstru_json, '"');
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts writing an object
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the object in the current object, NULL if the object is an element of the current array
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Begin_Object (MQTTMN_json_t * pstru_json, const char * pstri_key)
+{
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    v_MQTTMN_Json_Put_Char (pstru_json, pstru_json->b_cbor ? ((CBOR_MAJOR_MAP << 5) | CBOR_INDEFINITE) : '{');
+    pstru_json->b_comma = false;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finishes writing the current object
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_End_Object (MQTTMN_json_t * pstru_json)
+{
+    v_MQTTMN_Json_Put_Char (pstru_json, pstru_json->b_cbor ? CBOR_BREAK : '}');
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts writing an array
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the array in the current object, NULL if the array is an element of the current array
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Begin_Array (MQTTMN_json_t * pstru_json, const char * pstri_key)
+{
+    v_MQTTMN_Json_Put_Key (pstru_json, pstri_key);
+    v_MQTTMN_Json_Put_Char (pstru_json, pstru_json->b_cbor ? ((CBOR_MAJOR_ARRAY << 5) | CBOR_INDEFINITE) : '[');
+    pstru_json->b_comma = false;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finishes writing the current array
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_End_Array (MQTTMN_json_t * pstru_json)
+{
+    v_MQTTMN_Json_Put_Char (pstru_json, pstru_json->b_cbor ? CBOR_BREAK : ']');
+    pstru_json->b_comma = true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes the separator from the previous value and the key of the next value
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: The key, which must not need escaping, NULL if the next value is an element of an array
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Put_Key (MQTTMN_json_t * pstru_json, const char * pstri_key)
+{
+    if (pstru_json->b_cbor)
+    {
+        if (pstri_key != NULL)
+        {
+            uint32_t u32_len = strlen (pstri_key);
+            v_MQTTMN_Json_Put_Cbor_Head (pstru_json, CBOR_MAJOR_TEXT, u32_len);
+            v_MQTTMN_Json_Put (pstru_json, pstri_key, u32_len);
+        }
+        return;
+    }
+    if (pstru_json->b_comma)
+    {
+        v_MQTTMN_Json_Put_Char (pstru_json, ',');
+    }
+    if (pstri_key != NULL)
+    {
+        v_MQTTMN_Json_Put_Char (pstru_json, '"');
+        v_MQTTMN_Json_Put (pstru_json, pstri_key, strlen (pstri_key));
+        v_MQTTMN_Json_Put (pstru_json, "\":", 2);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends data to the message
+**
+** @details
+**      Once the data does not fit in the message buffer, nothing else is appended and the message is dropped by
+**      pstri_MQTTMN_Json_End()
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_data: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Put (MQTTMN_json_t * pstru_json, const char * pstri_data, uint32_t u32_len)
+{
+    if (pstru_json->b_overflow || (u32_len > pstru_json->u32_size - pstru_json->u32_len))
+    {
+        pstru_json->b_overflow = true;
+        return;
+    }
+    memcpy (&pstru_json->pstri_buf[pstru_json->u32_len], pstri_data, u32_len);
+    pstru_json->u32_len += u32_len;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends a character to the message
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      c_data: The character
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Put_Char (MQTTMN_json_t * pstru_json, char c_data)
+{
+    if (pstru_json->b_overflow || (pstru_json->u32_len >= pstru_json->u32_size))
+    {
+        pstru_json->b_overflow = true;
+        return;
+    }
+    pstru_json->pstri_buf[pstru_json->u32_len++] = c_data;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends the head of a CBOR data item, in its shortest form
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      u8_major: Major type of the data item
+**
+** @param [in]
+**      u32_arg: Argument of the data item (value of an integer, length of a string or number of elements)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Put_Cbor_Head (MQTTMN_json_t * pstru_json, uint8_t u8_major, uint32_t u32_arg)
+{
+    uint8_t u8_num_bytes;
+    uint8_t u8_info;
+
+    if (u32_arg < 24)
+    {
+        v_MQTTMN_Json_Put_Char (pstru_json, (u8_major << 5) | u32_arg);
+        return;
+    }
+    else if (u32_arg <= UINT8_MAX)
+    {
+        u8_num_bytes = 1;
+        u8_info = 24;
+    }
+    else if (u32_arg <= UINT16_MAX)
+    {
+        u8_num_bytes = 2;
+        u8_info = 25;
+    }
+    else
+    {
+        u8_num_bytes = 4;
+        u8_info = 26;
+    }
+
+    /* Argument follows in network byte order */
+    v_MQTTMN_Json_Put_Char (pstru_json, (u8_major << 5) | u8_info);
+    for (int8_t s8_shift = (u8_num_bytes - 1) * 8; s8_shift >= 0; s8_shift -= 8)
+    {
+        v_MQTTMN_Json_Put_Char (pstru_json, (u32_arg >> s8_shift) & 0xFF);
+    }
+}
+
+#ifdef CONFIG_MQTTMN_BENCHMARK_ENABLED
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Measures time and number of memory allocations to encode a statusNotify and a paramReadResponse message with
+**      cJSON (cJSON_Print) and with the JSON writer, and prints the results
+**
+** @note
+**      Reading parameter values and publishing are not included
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Json_Run_Benchmark (void)
+{
+    cJSON_Hooks     stru_hooks = { .malloc_fn = pv_MQTTMN_Json_Counting_Malloc, .free_fn = free };
+    MQTTMN_json_t   stru_json;
+    uint32_t        u32_len = 0;
+    uint32_t        au32_cjson_len[2] = { 0 };
+    uint32_t        au32_writer_len[2] = { 0 };
+    int64_t         as64_cjson_time[2];
+    int64_t         as64_writer_time[2];
+    uint32_t        au32_cjson_allocs[2];
+    uint32_t        au32_writer_allocs[2];
+
+    /* Count the allocations made by cJSON and by the JSON writer */
+    cJSON_InitHooks (&stru_hooks);
+    g_pfnc_json_malloc = pv_MQTTMN_Json_Counting_Malloc;
+
+    /* statusNotify with cJSON */
+    g_u32_json_num_allocs = 0;
+    int64_t s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < MQTTMN_BENCHMARK_MESSAGES; u32_idx++)
+    {
+        cJSON * px_root = cJSON_CreateObject ();
+        cJSON_AddStringToObject (px_root, JSON_KEY_CMD, "statusNotify");
+        cJSON_AddNumberToObject (px_root, JSON_KEY_EID, u32_idx);
+        cJSON_AddStringToObject (px_root, "statusType", NOTIFY_OTA_DOWNLOAD_PROGRESS);
+        cJSON_AddStringToObject (px_root, "statusValue", "50");
+        cJSON_AddStringToObject (px_root, "description", "");
+        char * pstri_message = cJSON_Print (px_root);
+        cJSON_Delete (px_root);
+        au32_cjson_len[0] = strlen (pstri_message);
+        free (pstri_message);
+    }
+    as64_cjson_time[0] = esp_timer_get_time () - s64_start;
+    au32_cjson_allocs[0] = g_u32_json_num_allocs;
+
+    /* paramReadResponse with cJSON */
+    g_u32_json_num_allocs = 0;
+    s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < MQTTMN_BENCHMARK_MESSAGES; u32_idx++)
+    {
+        cJSON * px_root = cJSON_CreateObject ();
+        cJSON_AddStringToObject (px_root, JSON_KEY_CMD, "paramReadResponse");
+        cJSON_AddNumberToObject (px_root, JSON_KEY_EID, u32_idx);
+        cJSON_AddStringToObject (px_root, "status", STATUS_OK);
+        cJSON * px_array = cJSON_CreateArray ();
+        cJSON_AddItemToObject (px_root, "parameters", px_array);
+        for (uint8_t u8_param = 0; u8_param < MQTTMN_BENCHMARK_PARAMS; u8_param++)
+        {
+            char stri_value[16];
+            cJSON * px_param = cJSON_CreateObject ();
+            cJSON_AddItemToArray (px_array, px_param);
+            cJSON_AddNumberToObject (px_param, "puc", 0x100 + u8_param);
+            sprintf (stri_value, "%d", u32_idx * u8_param);
+            cJSON_AddStringToObject (px_param, "value", stri_value);
+        }
+        char * pstri_message = cJSON_Print (px_root);
+        cJSON_Delete (px_root);
+        au32_cjson_len[1] = strlen (pstri_message);
+        free (pstri_message);
+    }
+    as64_cjson_time[1] = esp_timer_get_time () - s64_start;
+    au32_cjson_allocs[1] = g_u32_json_num_allocs;
+
+    /* statusNotify with the JSON writer */
+    g_u32_json_num_allocs = 0;
+    s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < MQTTMN_BENCHMARK_MESSAGES; u32_idx++)
+    {
+        v_MQTTMN_Json_Begin (&stru_json, "statusNotify", u32_idx, false);
+        v_MQTTMN_Json_Add_String (&stru_json, "statusType", NOTIFY_OTA_DOWNLOAD_PROGRESS);
+        v_MQTTMN_Json_Add_String (&stru_json, "statusValue", "50");
+        v_MQTTMN_Json_Add_String (&stru_json, "description", "");
+        pstri_MQTTMN_Json_End (&stru_json, &u32_len);
+        au32_writer_len[0] = u32_len;
+    }
+    as64_writer_time[0] = esp_timer_get_time () - s64_start;
+    au32_writer_allocs[0] = g_u32_json_num_allocs;
+
+    /* paramReadResponse with the JSON writer */
+    g_u32_json_num_allocs = 0;
+    s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < MQTTMN_BENCHMARK_MESSAGES; u32_idx++)
+    {
+        v_MQTTMN_Json_Begin (&stru_json, "paramReadResponse", u32_idx, false);
+        v_MQTTMN_Json_Add_String (&stru_json, "status", STATUS_OK);
+        v_MQTTMN_Json_Begin_Array (&stru_json, "parameters");
+        for (uint8_t u8_param = 0; u8_param < MQTTMN_BENCHMARK_PARAMS; u8_param++)
+        {
+            char stri_value[16];
+            v_MQTTMN_Json_Begin_Object (&stru_json, NULL);
+            v_MQTTMN_Json_Add_Uint32 (&stru_json, "puc", 0x100 + u8_param);
+            sprintf (stri_value, "%d", u32_idx * u8_param);
+            v_MQTTMN_Json_Add_String (&stru_json, "value", stri_value);
+            v_MQTTMN_Json_End_Object (&stru_json);
+        }
+        v_MQTTMN_Json_End_Array (&stru_json);
+        pstri_MQTTMN_Json_End (&stru_json, &u32_len);
+        au32_writer_len[1] = u32_len;
+    }
+    as64_writer_time[1] = esp_timer_get_time () - s64_start;
+    au32_writer_allocs[1] = g_u32_json_num_allocs;
+    g_pfnc_json_malloc = malloc;
+    cJSON_InitHooks (NULL);
+
+    LOGI ("Benchmark of %d messages on core %d:", MQTTMN_BENCHMARK_MESSAGES, xPortGetCoreID ());
+    LOGI ("  statusNotify      cJSON : %lld us/msg, %u allocs/msg, %u bytes",
+          as64_cjson_time[0] / MQTTMN_BENCHMARK_MESSAGES, au32_cjson_allocs[0] / MQTTMN_BENCHMARK_MESSAGES,
+          au32_cjson_len[0]);
+    LOGI ("  statusNotify      writer: %lld us/msg, %u allocs/msg, %u bytes",
+          as64_writer_time[0] / MQTTMN_BENCHMARK_MESSAGES, au32_writer_allocs[0] / MQTTMN_BENCHMARK_MESSAGES,
+          au32_writer_len[0]);
+    LOGI ("  paramReadResponse cJSON : %lld us/msg, %u allocs/msg, %u bytes",
+          as64_cjson_time[1] / MQTTMN_BENCHMARK_MESSAGES, au32_cjson_allocs[1] / MQTTMN_BENCHMARK_MESSAGES,
+          au32_cjson_len[1]);
+    LOGI ("  paramReadResponse writer: %lld us/msg, %u allocs/msg, %u bytes",
+          as64_writer_time[1] / MQTTMN_BENCHMARK_MESSAGES, au32_writer_allocs[1] / MQTTMN_BENCHMARK_MESSAGES,
+          au32_writer_len[1]);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates memory for cJSON or for the JSON writer and counts the allocations during the benchmark
+**
+** @param [in]
+**      x_size: Size in bytes to allocate
+**
+** @return
+**      Pointer to the allocated memory, NULL if failed
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void * pv_MQTTMN_Json_Counting_Malloc (size_t x_size)
+{
+    g_u32_json_num_allocs++;
+    return malloc (x_size);
+}
+#endif
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
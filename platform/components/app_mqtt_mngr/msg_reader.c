@@ -0,0 +1,785 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : msg_reader.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 6
+**  @brief      : This file contains the reader of received commands, which are either in JSON or in CBOR format.
+**                app_mqtt_mngr.c includes this file directly.
+**  @namespace  : MQTTMN
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  App_Mqtt_Mngr
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Major types of CBOR data items (RFC 8949) */
+enum
+{
+    CBOR_MAJOR_UINT         = 0,                    //!< Unsigned integer
+    CBOR_MAJOR_NEGINT       = 1,                    //!< Negative integer (-1 - argument)
+    CBOR_MAJOR_BYTES        = 2,                    //!< Byte string
+    CBOR_MAJOR_TEXT         = 3,                    //!< Text string (UTF-8)
+    CBOR_MAJOR_ARRAY        = 4,                    //!< Array of data items
+    CBOR_MAJOR_MAP          = 5,                    //!< Map of pairs of data items
+    CBOR_MAJOR_TAG          = 6,                    //!< Tagged data item
+    CBOR_MAJOR_SIMPLE       = 7,                    //!< Simple values, floating-point numbers and break
+};
+
+/** @brief  Simple values of CBOR */
+#define CBOR_FALSE                          0xF4
+#define CBOR_TRUE                           0xF5
+
+/** @brief  Additional information of CBOR initial byte indicating an indefinite length */
+#define CBOR_INDEFINITE                     31
+
+/** @brief  "break" stop code ending an item of indefinite length */
+#define CBOR_BREAK                          0xFF
+
+/** @brief  Number of data items of an indefinite-length array or map, which ends with a break code */
+#define CBOR_INDEFINITE_COUNT               UINT32_MAX
+
+/** @brief  Maximum nesting levels of CBOR arrays, maps and tags in a command */
+#define CBOR_MAX_DEPTH                      16
+
+/** @brief  Maximum length of CBOR text strings converted to integers */
+#define CBOR_MAX_NUMBER_LEN                 16
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static bool b_MQTTMN_Msg_Parse (const void * pv_data, uint32_t u32_len, MQTTMN_value_t * pstru_root);
+static void v_MQTTMN_Msg_Free (MQTTMN_value_t * pstru_root);
+static bool b_MQTTMN_Msg_Get_Item (const MQTTMN_value_t * pstru_object, const char * pstri_key,
+                                   MQTTMN_value_t * pstru_item);
+static bool b_MQTTMN_Msg_Get_First (const MQTTMN_value_t * pstru_array, MQTTMN_value_t * pstru_element);
+static bool b_MQTTMN_Msg_Get_Next (MQTTMN_value_t * pstru_element);
+static uint16_t u16_MQTTMN_Msg_Get_Size (const MQTTMN_value_t * pstru_array);
+static const char * pstri_MQTTMN_Msg_Get_String (const MQTTMN_value_t * pstru_value, char * pstri_buf,
+                                                 uint16_t u16_size);
+static bool b_MQTTMN_Msg_Get_Uint32 (const MQTTMN_value_t * pstru_value, uint32_t * pu32_value);
+static bool b_MQTTMN_Msg_Get_Int32 (const MQTTMN_value_t * pstru_value, int32_t * ps32_value);
+static bool b_MQTTMN_Msg_Get_Bool (const MQTTMN_value_t * pstru_value);
+static bool b_MQTTMN_Msg_Get_Bytes (const MQTTMN_value_t * pstru_value, const uint8_t ** ppu8_data,
+                                    uint16_t * pu16_len);
+static const uint8_t * pu8_MQTTMN_Cbor_Head (const uint8_t * pu8_item, const uint8_t * pu8_end,
+                                             uint8_t * pu8_major, uint64_t * pu64_arg);
+static const uint8_t * pu8_MQTTMN_Cbor_Skip (const uint8_t * pu8_item, const uint8_t * pu8_end);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Parses a received command
+**
+** @details
+**      The format of the command is determined by its first byte: a CBOR command is a map (major type 5, initial byte
+**      0xA0 to 0xBF), which is never the first character of a JSON text. A JSON command is parsed into cJSON objects.
+**      A CBOR command is only checked to be well-formed, its values are then read in place.
+**
+** @param [in]
+**      pv_data: Pointer to command data
+**
+** @param [in]
+**      u32_len: Length in bytes of the command data
+**
+** @param [out]
+**      pstru_root: The command, to be freed with v_MQTTMN_Msg_Free()
+**
+** @return
+**      @arg    true: The command is a valid JSON object or CBOR map
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Parse (const void * pv_data, uint32_t u32_len, MQTTMN_value_t * pstru_root)
+{
+    const uint8_t * pu8_data = pv_data;
+
+    pstru_root->px_json = NULL;
+    pstru_root->pu8_cbor = NULL;
+    pstru_root->pu8_end = NULL;
+    pstru_root->u32_remaining = 0;
+
+    /* JSON command */
+    if ((u32_len == 0) || ((pu8_data[0] >> 5) != CBOR_MAJOR_MAP))
+    {
+        pstru_root->px_json = cJSON_ParseWithLength (pv_data, u32_len);
+        return cJSON_IsObject (pstru_root->px_json);
+    }
+
+    /* CBOR command: one map taking all the data */
+    if (pu8_MQTTMN_Cbor_Skip (pu8_data, pu8_data + u32_len) != pu8_data + u32_len)
+    {
+        return false;
+    }
+    pstru_root->pu8_cbor = pu8_data;
+    pstru_root->pu8_end = pu8_data + u32_len;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Frees a command parsed by b_MQTTMN_Msg_Parse()
+**
+** @param [in]
+**      pstru_root: The command
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Msg_Free (MQTTMN_value_t * pstru_root)
+{
+    if (pstru_root->px_json != NULL)
+    {
+        cJSON_Delete ((cJSON *)pstru_root->px_json);
+        pstru_root->px_json = NULL;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the value of a key in an object (JSON object or CBOR map)
+**
+** @param [in]
+**      pstru_object: The object
+**
+** @param [in]
+**      pstri_key: The key
+**
+** @param [out]
+**      pstru_item: The value of the key
+**
+** @return
+**      @arg    true: The key is found
+**      @arg    false: The key is not found or pstru_object is not an object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Item (const MQTTMN_value_t * pstru_object, const char * pstri_key,
+                                   MQTTMN_value_t * pstru_item)
+{
+    *pstru_item = *pstru_object;
+
+    /* JSON object */
+    if (pstru_object->pu8_cbor == NULL)
+    {
+        pstru_item->px_json = cJSON_GetObjectItem (pstru_object->px_json, pstri_key);
+        return (pstru_item->px_json != NULL);
+    }
+
+    /* CBOR map */
+    uint8_t u8_major;
+    uint64_t u64_num_pairs;
+    const uint8_t * pu8_pos = pu8_MQTTMN_Cbor_Head (pstru_object->pu8_cbor, pstru_object->pu8_end,
+                                                    &u8_major, &u64_num_pairs);
+    if ((pu8_pos == NULL) || (u8_major != CBOR_MAJOR_MAP))
+    {
+        return false;
+    }
+
+    uint32_t u32_key_len = strlen (pstri_key);
+    for (uint64_t u64_idx = 0; u64_idx < u64_num_pairs; u64_idx++)
+    {
+        /* End of the map */
+        if ((pu8_pos == NULL) || (pu8_pos >= pstru_object->pu8_end) || (*pu8_pos == CBOR_BREAK))
+        {
+            break;
+        }
+
+        /* Compare the key */
+        uint64_t u64_len;
+        const uint8_t * pu8_key = pu8_MQTTMN_Cbor_Head (pu8_pos, pstru_object->pu8_end, &u8_major, &u64_len);
+        bool b_match = (pu8_key != NULL) && (u8_major == CBOR_MAJOR_TEXT) && (u64_len == u32_key_len) &&
+                       (u64_len <= (uint64_t)(pstru_object->pu8_end - pu8_key)) &&
+                       (memcmp (pu8_key, pstri_key, u32_key_len) == 0);
+
+        /* Value of the key */
+        pu8_pos = pu8_MQTTMN_Cbor_Skip (pu8_pos, pstru_object->pu8_end);
+        if (b_match)
+        {
+            pstru_item->pu8_cbor = pu8_pos;
+            pstru_item->u32_remaining = 0;
+            return true;
+        }
+        pu8_pos = pu8_MQTTMN_Cbor_Skip (pu8_pos, pstru_object->pu8_end);
+    }
+    return false;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the first element of an array
+**
+** @param [in]
+**      pstru_array: The array
+**
+** @param [out]
+**      pstru_element: The first element, to be passed to b_MQTTMN_Msg_Get_Next() to get the next ones
+**
+** @return
+**      @arg    true: The array has at least one element
+**      @arg    false: The array is empty or pstru_array is not an array
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_First (const MQTTMN_value_t * pstru_array, MQTTMN_value_t * pstru_element)
+{
+    *pstru_element = *pstru_array;
+
+    /* JSON array */
+    if (pstru_array->pu8_cbor == NULL)
+    {
+        pstru_element->px_json = cJSON_IsArray (pstru_array->px_json) ? pstru_array->px_json->child : NULL;
+        return (pstru_element->px_json != NULL);
+    }
+
+    /* CBOR array. An indefinite length is counted as UINT32_MAX, the break code ends the array */
+    uint8_t u8_major;
+    uint64_t u64_num_items;
+    const uint8_t * pu8_pos = pu8_MQTTMN_Cbor_Head (pstru_array->pu8_cbor, pstru_array->pu8_end,
+                                                    &u8_major, &u64_num_items);
+    if ((pu8_pos == NULL) || (u8_major != CBOR_MAJOR_ARRAY) || (u64_num_items == 0) || (*pu8_pos == CBOR_BREAK))
+    {
+        return false;
+    }
+    pstru_element->pu8_cbor = pu8_pos;
+    pstru_element->u32_remaining = (uint32_t)((u64_num_items > UINT32_MAX) ? UINT32_MAX : u64_num_items) - 1;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Moves to the next element of an array
+**
+** @param [in, out]
+**      pstru_element: An element returned by b_MQTTMN_Msg_Get_First(), which then becomes the next element
+**
+** @return
+**      @arg    true: The next element is available
+**      @arg    false: The end of the array is reached
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Next (MQTTMN_value_t * pstru_element)
+{
+    /* JSON array */
+    if (pstru_element->pu8_cbor == NULL)
+    {
+        pstru_element->px_json = pstru_element->px_json->next;
+        return (pstru_element->px_json != NULL);
+    }
+
+    /* CBOR array */
+    if (pstru_element->u32_remaining == 0)
+    {
+        return false;
+    }
+    const uint8_t * pu8_pos = pu8_MQTTMN_Cbor_Skip (pstru_element->pu8_cbor, pstru_element->pu8_end);
+    if ((pu8_pos == NULL) || (pu8_pos >= pstru_element->pu8_end) || (*pu8_pos == CBOR_BREAK))
+    {
+        return false;
+    }
+    pstru_element->pu8_cbor = pu8_pos;
+    pstru_element->u32_remaining--;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of elements of an array
+**
+** @param [in]
+**      pstru_array: The array
+**
+** @return
+**      Number of elements, 0 if pstru_array is not an array
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint16_t u16_MQTTMN_Msg_Get_Size (const MQTTMN_value_t * pstru_array)
+{
+    uint16_t u16_size = 0;
+    MQTTMN_value_t stru_element;
+
+    if (b_MQTTMN_Msg_Get_First (pstru_array, &stru_element))
+    {
+        do
+        {
+            u16_size++;
+        }
+        while ((u16_size < UINT16_MAX) && b_MQTTMN_Msg_Get_Next (&stru_element));
+    }
+    return u16_size;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a string value
+**
+** @details
+**      The string of a JSON command is returned directly. The string of a CBOR command is not NULL-terminated in the
+**      command data, so it is copied to the given buffer
+**
+** @param [in]
+**      pstru_value: The value
+**
+** @param [out]
+**      pstri_buf: Buffer to store the string of a CBOR command
+**
+** @param [in]
+**      u16_size: Size in bytes of pstri_buf
+**
+** @return
+**      @arg    NULL: The value is not a string, or it is too long for pstri_buf
+**      @arg    Otherwise: NULL-terminated string
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const char * pstri_MQTTMN_Msg_Get_String (const MQTTMN_value_t * pstru_value, char * pstri_buf,
+                                                 uint16_t u16_size)
+{
+    /* JSON string */
+    if (pstru_value->pu8_cbor == NULL)
+    {
+        return cJSON_IsString (pstru_value->px_json) ? pstru_value->px_json->valuestring : NULL;
+    }
+
+    /* CBOR text string */
+    uint8_t u8_major;
+    uint64_t u64_len;
+    const uint8_t * pu8_text = pu8_MQTTMN_Cbor_Head (pstru_value->pu8_cbor, pstru_value->pu8_end, &u8_major, &u64_len);
+    if ((pu8_text == NULL) || (u8_major != CBOR_MAJOR_TEXT) || (u64_len >= u16_size))
+    {
+        return NULL;
+    }
+    memcpy (pstri_buf, pu8_text, (size_t)u64_len);
+    pstri_buf[u64_len] = 0;
+    return pstri_buf;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets an unsigned integer value
+**
+** @param [in]
+**      pstru_value: The value
+**
+** @param [out]
+**      pu32_value: The integer
+**
+** @return
+**      @arg    true: The value is a number (JSON) or an unsigned integer of 32 bits (CBOR)
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Uint32 (const MQTTMN_value_t * pstru_value, uint32_t * pu32_value)
+{
+    /* JSON number */
+    if (pstru_value->pu8_cbor == NULL)
+    {
+        if (!cJSON_IsNumber (pstru_value->px_json))
+        {
+            return false;
+        }
+        *pu32_value = (uint32_t)pstru_value->px_json->valuedouble;
+        return true;
+    }
+
+    /* CBOR unsigned integer */
+    uint8_t u8_major;
+    uint64_t u64_arg;
+    if ((pu8_MQTTMN_Cbor_Head (pstru_value->pu8_cbor, pstru_value->pu8_end, &u8_major, &u64_arg) == NULL) ||
+        (u8_major != CBOR_MAJOR_UINT) || (u64_arg > UINT32_MAX))
+    {
+        return false;
+    }
+    *pu32_value = (uint32_t)u64_arg;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets an integer value of a parameter
+**
+** @details
+**      JSON commands carry parameter values as decimal strings, CBOR commands carry them as integers. Both forms are
+**      accepted in both formats. As with the decimal strings, an unsigned value above INT32_MAX is returned as the
+**      negative number of the same 32 bits
+**
+** @param [in]
+**      pstru_value: The value
+**
+** @param [out]
+**      ps32_value: The integer
+**
+** @return
+**      @arg    true: The value is an integer
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Int32 (const MQTTMN_value_t * pstru_value, int32_t * ps32_value)
+{
+    char stri_number[CBOR_MAX_NUMBER_LEN];
+
+    /* JSON number */
+    if ((pstru_value->pu8_cbor == NULL) && cJSON_IsNumber (pstru_value->px_json))
+    {
+        *ps32_value = pstru_value->px_json->valueint;
+        return true;
+    }
+
+    /* CBOR integer */
+    if (pstru_value->pu8_cbor != NULL)
+    {
+        uint8_t u8_major;
+        uint64_t u64_arg;
+        if (pu8_MQTTMN_Cbor_Head (pstru_value->pu8_cbor, pstru_value->pu8_end, &u8_major, &u64_arg) == NULL)
+        {
+            return false;
+        }
+        if ((u8_major == CBOR_MAJOR_UINT) && (u64_arg <= UINT32_MAX))
+        {
+            *ps32_value = (int32_t)(uint32_t)u64_arg;
+            return true;
+        }
+        if ((u8_major == CBOR_MAJOR_NEGINT) && (u64_arg <= INT32_MAX))
+        {
+            *ps32_value = -1 - (int32_t)u64_arg;
+            return true;
+        }
+    }
+
+    /* Decimal string */
+    const char * pstri_value = pstri_MQTTMN_Msg_Get_String (pstru_value, stri_number, sizeof (stri_number));
+    return (pstri_value != NULL) && (sscanf (pstri_value, "%d", ps32_value) == 1);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a boolean value
+**
+** @param [in]
+**      pstru_value: The value
+**
+** @return
+**      @arg    true: The value is true
+**      @arg    false: The value is false or not a boolean
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Bool (const MQTTMN_value_t * pstru_value)
+{
+    if (pstru_value->pu8_cbor == NULL)
+    {
+        return cJSON_IsTrue (pstru_value->px_json);
+    }
+    return (pstru_value->pu8_cbor < pstru_value->pu8_end) && (*pstru_value->pu8_cbor == CBOR_TRUE);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a block of binary data, which only CBOR commands carry (as a byte string)
+**
+** @param [in]
+**      pstru_value: The value
+**
+** @param [out]
+**      ppu8_data: Pointer to the data, inside the command data
+**
+** @param [out]
+**      pu16_len: Length in bytes of the data
+**
+** @return
+**      @arg    true: The value is a byte string
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTTMN_Msg_Get_Bytes (const MQTTMN_value_t * pstru_value, const uint8_t ** ppu8_data, uint16_t * pu16_len)
+{
+    if (pstru_value->pu8_cbor == NULL)
+    {
+        return false;
+    }
+
+    uint8_t u8_major;
+    uint64_t u64_len;
+    const uint8_t * pu8_data = pu8_MQTTMN_Cbor_Head (pstru_value->pu8_cbor, pstru_value->pu8_end, &u8_major, &u64_len);
+    if ((pu8_data == NULL) || (u8_major != CBOR_MAJOR_BYTES) || (u64_len > UINT16_MAX))
+    {
+        return false;
+    }
+    *ppu8_data = pu8_data;
+    *pu16_len = (uint16_t)u64_len;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Decodes the head (initial byte and argument) of a CBOR data item
+**
+** @param [in]
+**      pu8_item: First byte of the data item
+**
+** @param [in]
+**      pu8_end: End of the data
+**
+** @param [out]
+**      pu8_major: Major type of the data item
+**
+** @param [out]
+**      pu64_arg: Argument of the data item: value of an integer, length of a string, number of elements of an array or
+**                pairs of a map. UINT64_MAX if the length is indefinite
+**
+** @return
+**      @arg    NULL: The head is not well-formed or is truncated
+**      @arg    Otherwise: Pointer to the byte following the head
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const uint8_t * pu8_MQTTMN_Cbor_Head (const uint8_t * pu8_item, const uint8_t * pu8_end,
+                                             uint8_t * pu8_major, uint64_t * pu64_arg)
+{
+    if ((pu8_item == NULL) || (pu8_item >= pu8_end))
+    {
+        return NULL;
+    }
+
+    *pu8_major = pu8_item[0] >> 5;
+    uint8_t u8_info = pu8_item[0] & 0x1F;
+    pu8_item++;
+
+    /* Argument in the initial byte */
+    if (u8_info < 24)
+    {
+        *pu64_arg = u8_info;
+        return pu8_item;
+    }
+
+    /* Indefinite length of strings, arrays and maps, or the break code */
+    if (u8_info == CBOR_INDEFINITE)
+    {
+        if ((*pu8_major == CBOR_MAJOR_UINT) || (*pu8_major == CBOR_MAJOR_NEGINT) || (*pu8_major == CBOR_MAJOR_TAG))
+        {
+            return NULL;
+        }
+        *pu64_arg = UINT64_MAX;
+        return pu8_item;
+    }
+
+    /* Argument in the following 1, 2, 4 or 8 bytes */
+    if (u8_info > 27)
+    {
+        return NULL;
+    }
+    uint8_t u8_num_bytes = 1 << (u8_info - 24);
+    if (pu8_end - pu8_item < u8_num_bytes)
+    {
+        return NULL;
+    }
+    *pu64_arg = 0;
+    for (uint8_t u8_idx = 0; u8_idx < u8_num_bytes; u8_idx++)
+    {
+        *pu64_arg = (*pu64_arg << 8) | pu8_item[u8_idx];
+    }
+    return pu8_item + u8_num_bytes;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Skips a CBOR data item, including all data items nested in it
+**
+** @details
+**      The nested data items are counted rather than visited recursively, so the stack usage does not depend on the
+**      received data. Strings of indefinite length are not supported, and the data item is rejected if it is nested
+**      more than CBOR_MAX_DEPTH levels
+**
+** @param [in]
+**      pu8_item: First byte of the data item
+**
+** @param [in]
+**      pu8_end: End of the data
+**
+** @return
+**      @arg    NULL: The data item is not well-formed or is truncated
+**      @arg    Otherwise: Pointer to the byte following the data item
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const uint8_t * pu8_MQTTMN_Cbor_Skip (const uint8_t * pu8_item, const uint8_t * pu8_end)
+{
+    uint32_t    au32_remaining [CBOR_MAX_DEPTH];    /* Number of data items remaining in each open container */
+    uint8_t     u8_depth = 1;                       /* Number of open containers */
+
+    /* The data item to skip is seen as the only element of a container */
+    au32_remaining[0] = 1;
+    while (u8_depth > 0)
+    {
+        uint32_t * pu32_remaining = &au32_remaining[u8_depth - 1];
+
+        /* End of a definite-length container */
+        if (*pu32_remaining == 0)
+        {
+            u8_depth--;
+            continue;
+        }
+
+        /* End of an indefinite-length container */
+        if (pu8_item >= pu8_end)
+        {
+            return NULL;
+        }
+        if (*pu8_item == CBOR_BREAK)
+        {
+            if (*pu32_remaining != CBOR_INDEFINITE_COUNT)
+            {
+                return NULL;
+            }
+            pu8_item++;
+            u8_depth--;
+            continue;
+        }
+
+        /* Next data item of the container */
+        uint8_t u8_major;
+        uint64_t u64_arg;
+        pu8_item = pu8_MQTTMN_Cbor_Head (pu8_item, pu8_end, &u8_major, &u64_arg);
+        if (pu8_item == NULL)
+        {
+            return NULL;
+        }
+        if (*pu32_remaining != CBOR_INDEFINITE_COUNT)
+        {
+            (*pu32_remaining)--;
+        }
+
+        uint32_t u32_num_nested = 0;
+        switch (u8_major)
+        {
+            case CBOR_MAJOR_BYTES:
+            case CBOR_MAJOR_TEXT:
+            {
+                if (u64_arg > (uint64_t)(pu8_end - pu8_item))
+                {
+                    return NULL;
+                }
+                pu8_item += u64_arg;
+                break;
+            }
+
+            case CBOR_MAJOR_ARRAY:
+            case CBOR_MAJOR_MAP:
+            {
+                if (u64_arg == UINT64_MAX)
+                {
+                    u32_num_nested = CBOR_INDEFINITE_COUNT;
+                    break;
+                }
+
+                /* Each nested data item takes at least one byte */
+                uint64_t u64_num_nested = (u8_major == CBOR_MAJOR_MAP) ? (u64_arg * 2) : u64_arg;
+                if ((u64_arg > (uint64_t)(pu8_end - pu8_item)) || (u64_num_nested > (uint64_t)(pu8_end - pu8_item)))
+                {
+                    return NULL;
+                }
+                u32_num_nested = (uint32_t)u64_num_nested;
+                break;
+            }
+
+            case CBOR_MAJOR_TAG:
+            {
+                /* The tagged data item follows */
+                u32_num_nested = 1;
+                break;
+            }
+
+            case CBOR_MAJOR_SIMPLE:
+            {
+                /* 0xFF here is a break code outside an indefinite-length container */
+                if (u64_arg == UINT64_MAX)
+                {
+                    return NULL;
+                }
+                break;
+            }
+
+            default:
+            {
+                break;
+            }
+        }
+
+        /* Open the container of the nested data items */
+        if (u32_num_nested > 0)
+        {
+            if (u8_depth >= CBOR_MAX_DEPTH)
+            {
+                LOGE ("CBOR data is nested more than %d levels", CBOR_MAX_DEPTH);
+                return NULL;
+            }
+            au32_remaining[u8_depth++] = u32_num_nested;
+        }
+    }
+
+    return pu8_item;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -25,6 +25,9 @@
 #include "esp_system.h"                 /* Use esp_restart() */
 #include "app_ota_mngr.h"               /* Use OTA update manager */
 #include "srvc_micropy.h"               /* Use MicroPython service */
+#include "mbtrace.h"                    /* Use Modbus bus trace */
+#include "srvc_rt_log.h"                /* Use time-series store of realtime measurements */
+#include <stdlib.h>                     /* Use strtoul() */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -32,6 +35,12 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/** @brief  Maximum length in bytes of a string parameter value received in a CBOR command */
+#define MAX_PARAM_STRING_LEN                128
+
+/** @brief  Maximum length in bytes of an OTA download URL received in a CBOR command */
+#define MAX_OTA_URL_LEN                     256
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -64,11 +73,11 @@
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_scanPost_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_scanPost_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
 {
     /* Respond with scanNotify command */
     s8_MQTTMN_Send_scanNotify ();
@@ -88,11 +97,11 @@ static void v_MQTTMN_scanPost_Handler (MQTTMN_session_t * pstru_session, const c
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_devResetPost_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_devResetPost_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
 {
     LOGI ("Restarting ESP32...");
     esp_restart ();
@@ -112,11 +121,11 @@ static void v_MQTTMN_devResetPost_Handler (MQTTMN_session_t * pstru_session, con
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_webReplRunPost_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_webReplRunPost_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
 {
     /* Start WebREPL */
     s8_MP_Run_WebRepl ();
@@ -136,16 +145,168 @@ static void v_MQTTMN_webReplRunPost_Handler (MQTTMN_session_t * pstru_session, c
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_otaUpdateCancelPost_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_otaUpdateCancelPost_Handler (MQTTMN_session_t * pstru_session,
+                                                  const MQTTMN_value_t * pstru_command)
 {
     /* Request OTA manager to cancel ongoing OTA update process (if any) */
     s8_OTAMN_Cancel ();
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Handler of mbTraceExportPost command
+**
+** @details
+**      This command is used to export the Modbus bus trace to a pcap file in root directory. Result of the export is
+**      reported via statusNotify command, then the file can be downloaded with fileDownloadReadRequest command.
+**      Extra command data:
+**          "file":"<filePathName>" (optional, default is MB_TRACE_EXPORT_FILE)
+**
+** @param [in]
+**      pstru_session: the session through which the command was received
+**
+** @param [in]
+**      pstru_command: the received command
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_mbTraceExportPost_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
+{
+    const char *    pstri_file_name = MB_TRACE_EXPORT_FILE;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
+    char            stri_file_path [MAX_FILE_PATH_LEN];
+    MQTTMN_value_t  stru_item;
+    char            stri_desc [32];
+    ULONG           u32_num_records = 0;
+
+    /* File name */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item))
+    {
+        pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name, sizeof (stri_file_name));
+    }
+    if ((pstri_file_name == NULL) ||
+        (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0))
+    {
+        LOGE ("File name is invalid or too long");
+        s8_MQTTMN_Send_statusNotify (NOTIFY_MB_TRACE_EXPORT_STATUS, STATUS_ERR_INVALID_DATA, "File name is too long");
+        return;
+    }
+
+    /* Export the trace */
+    if (!xMBMasterTraceExport (stri_file_path, &u32_num_records))
+    {
+        s8_MQTTMN_Send_statusNotify (NOTIFY_MB_TRACE_EXPORT_STATUS, STATUS_ERR, "Failed to export bus trace");
+        return;
+    }
+
+    snprintf (stri_desc, sizeof (stri_desc), "%lu records", u32_num_records);
+    s8_MQTTMN_Send_statusNotify (NOTIFY_MB_TRACE_EXPORT_STATUS, STATUS_OK, stri_desc);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Handler of rtLogExportPost command
+**
+** @details
+**      This command is used to export realtime measurements stored on flash to a CSV file in root directory. Result of
+**      the export is reported via statusNotify command, then the file can be downloaded with fileDownloadReadRequest
+**      command.
+**      Extra command data:
+**          "file":"<filePathName>" (optional, default is RTLOG_EXPORT_FILE)
+**          "from":<timestamp in ms> (optional, default is 0)
+**          "to":<timestamp in ms> (optional, default is the latest sample)
+**          "measurements":[<measurement ID>, ...] (optional, default is all measurements)
+**
+** @param [in]
+**      pstru_session: the session through which the command was received
+**
+** @param [in]
+**      pstru_command: the received command
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_rtLogExportPost_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
+{
+    const char *    pstri_file_name = RTLOG_EXPORT_FILE;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
+    char            stri_file_path [MAX_FILE_PATH_LEN];
+    MQTTMN_value_t  stru_item;
+    char            stri_desc [32];
+    uint32_t        u32_start_time = 0;
+    uint32_t        u32_end_time = UINT32_MAX;
+    uint32_t        u32_meas_mask = RTLOG_ALL_MEAS;
+    uint32_t        u32_num_samples = 0;
+
+    /* File name */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item))
+    {
+        pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name, sizeof (stri_file_name));
+    }
+    if ((pstri_file_name == NULL) ||
+        (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0))
+    {
+        LOGE ("File name is invalid or too long");
+        s8_MQTTMN_Send_statusNotify (NOTIFY_RT_LOG_EXPORT_STATUS, STATUS_ERR_INVALID_DATA, "File name is too long");
+        return;
+    }
+
+    /* Time range */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "from", &stru_item))
+    {
+        b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_start_time);
+    }
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "to", &stru_item))
+    {
+        b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_end_time);
+    }
+
+    /* Measurements */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "measurements", &stru_item))
+    {
+        MQTTMN_value_t stru_meas;
+        u32_meas_mask = 0;
+        for (bool b_more = b_MQTTMN_Msg_Get_First (&stru_item, &stru_meas); b_more;
+             b_more = b_MQTTMN_Msg_Get_Next (&stru_meas))
+        {
+            uint32_t u32_meas_id;
+            if (!b_MQTTMN_Msg_Get_Uint32 (&stru_meas, &u32_meas_id) ||
+                (pstri_RTLOG_Get_Meas_Name (u32_meas_id) == NULL))
+            {
+                s8_MQTTMN_Send_statusNotify (NOTIFY_RT_LOG_EXPORT_STATUS, STATUS_ERR_INVALID_DATA,
+                                             "Invalid measurement ID");
+                return;
+            }
+            u32_meas_mask |= 1UL << u32_meas_id;
+        }
+    }
+
+    /* Export the measurements */
+    int32_t s32_result = s32_RTLOG_Store_Export (stri_file_path, u32_start_time, u32_end_time,
+                                                 u32_meas_mask, &u32_num_samples);
+    if (s32_result == STATUS_ERR_NOT_INIT)
+    {
+        s8_MQTTMN_Send_statusNotify (NOTIFY_RT_LOG_EXPORT_STATUS, STATUS_ERR_STATE_NOT_ALLOWED,
+                                     "Realtime log store is not ready");
+        return;
+    }
+    if (s32_result < 0)
+    {
+        s8_MQTTMN_Send_statusNotify (NOTIFY_RT_LOG_EXPORT_STATUS, STATUS_ERR, "Failed to export realtime log");
+        return;
+    }
+
+    snprintf (stri_desc, sizeof (stri_desc), "%u samples", u32_num_samples);
+    s8_MQTTMN_Send_statusNotify (NOTIFY_RT_LOG_EXPORT_STATUS, STATUS_OK, stri_desc);
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -161,21 +322,20 @@ static void v_MQTTMN_otaUpdateCancelPost_Handler (MQTTMN_session_t * pstru_sessi
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_paramReadRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_paramReadRequest_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_puc_array = NULL;
+    MQTTMN_value_t  stru_puc_array;
     uint16_t *      pu16_puc_list = NULL;
     uint8_t         u8_num_pucs = 0;
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
 
     /* List of PUCs to read */
-    px_puc_array = cJSON_GetObjectItem (px_json_root, "pucs");
-    if (px_puc_array == NULL)
+    if (!b_MQTTMN_Msg_Get_Item (pstru_command, "pucs", &stru_puc_array))
     {
         LOGE ("Invalid request command received: No \"pucs\" key");
         pstri_status = STATUS_ERR_INVALID_DATA;
@@ -185,7 +345,7 @@ static void v_MQTTMN_paramReadRequest_Handler (MQTTMN_session_t * pstru_session,
     /* Allocate buffer to store requested PUC list */
     if (b_success)
     {
-        u8_num_pucs = (uint8_t)cJSON_GetArraySize (px_puc_array);
+        u8_num_pucs = (uint8_t)u16_MQTTMN_Msg_Get_Size (&stru_puc_array);
         pu16_puc_list = (uint16_t *)calloc (u8_num_pucs, sizeof (uint16_t));
         if (pu16_puc_list == NULL)
         {
@@ -198,10 +358,14 @@ static void v_MQTTMN_paramReadRequest_Handler (MQTTMN_session_t * pstru_session,
     /* Get list of requested PUCs */
     if (b_success)
     {
-        for (uint8_t u8_idx = 0; u8_idx < u8_num_pucs; u8_idx++)
+        MQTTMN_value_t stru_puc_item;
+        bool b_more = b_MQTTMN_Msg_Get_First (&stru_puc_array, &stru_puc_item);
+        for (uint8_t u8_idx = 0; (u8_idx < u8_num_pucs) && b_more; u8_idx++)
         {
-            cJSON * px_puc_item = cJSON_GetArrayItem (px_puc_array, u8_idx);
-            pu16_puc_list[u8_idx] = px_puc_item->valueint;
+            uint32_t u32_puc = 0;
+            b_MQTTMN_Msg_Get_Uint32 (&stru_puc_item, &u32_puc);
+            pu16_puc_list[u8_idx] = (uint16_t)u32_puc;
+            b_more = b_MQTTMN_Msg_Get_Next (&stru_puc_item);
         }
     }
 
@@ -230,60 +394,57 @@ static void v_MQTTMN_paramReadRequest_Handler (MQTTMN_session_t * pstru_session,
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_paramWriteRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_paramWriteRequest_Handler (MQTTMN_session_t * pstru_session, const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
+    MQTTMN_value_t  stru_param_array;
+    MQTTMN_value_t  stru_param_item;
+    MQTTMN_value_t  stru_node;
     const char *    pstri_status = STATUS_OK;
-    cJSON *         px_param_array = NULL;
-    uint8_t         u8_num_params = 0;
+    bool            b_more = false;
+    bool            b_trans = false;
 
-    /* Get array of parameters to write and its size */
-    px_param_array = cJSON_GetObjectItem (px_json_root, "parameters");
-    if (px_param_array == NULL)
+    /* Get array of parameters to write */
+    if (!b_MQTTMN_Msg_Get_Item (pstru_command, "parameters", &stru_param_array))
     {
         LOGE ("Invalid request command received: No \"parameters\" key");
         pstri_status = STATUS_ERR_INVALID_DATA;
     }
+    /* All the requested parameters are changed at once, or none of them */
+    else if (s8_PARAM_Begin () != PARAM_OK)
+    {
+        pstri_status = STATUS_ERR_BUSY;
+    }
     else
     {
-        u8_num_params = (uint8_t)cJSON_GetArraySize (px_param_array);
+        b_trans = true;
+        b_more = b_MQTTMN_Msg_Get_First (&stru_param_array, &stru_param_item);
     }
 
-    /* Parse and set value of all requested parameters */
-    for (uint8_t u8_idx = 0; u8_idx < u8_num_params; u8_idx++)
+    /* Parse and stage value of all requested parameters */
+    for (; b_more; b_more = b_MQTTMN_Msg_Get_Next (&stru_param_item))
     {
-        /* Get parameter item */
-        cJSON * px_param_item = cJSON_GetArrayItem (px_param_array, u8_idx);
-        if (px_param_item == NULL)
-        {
-            LOGE ("Failed to parse parameter Json node");
-            pstri_status = STATUS_ERR_INVALID_DATA;
-            continue;
-        }
-
         /* PUC */
-        px_json_node = cJSON_GetObjectItem (px_param_item, "puc");
-        if (px_json_node == NULL)
+        uint32_t u32_puc;
+        if (!b_MQTTMN_Msg_Get_Item (&stru_param_item, "puc", &stru_node) ||
+            !b_MQTTMN_Msg_Get_Uint32 (&stru_node, &u32_puc))
         {
             LOGE ("Invalid request command received: No \"puc\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
             continue;
         }
-        uint16_t u16_puc = px_json_node->valueint;
+        uint16_t u16_puc = (uint16_t)u32_puc;
 
-        /* Parameter value */
-        px_json_node = cJSON_GetObjectItem (px_param_item, "value");
-        if (px_json_node == NULL)
+        /* Parameter value, which is a string in JSON commands and is of the parameter's type in CBOR commands */
+        if (!b_MQTTMN_Msg_Get_Item (&stru_param_item, "value", &stru_node))
         {
             LOGE ("Invalid request command received: No \"value\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
             continue;
         }
-        char * pstri_value = px_json_node->valuestring;
 
         /* Get index of the parameter */
         PARAM_id_t enm_param_id;
@@ -304,66 +465,92 @@ static void v_MQTTMN_paramWriteRequest_Handler (MQTTMN_session_t * pstru_session
             continue;
         }
 
+        /* Integer value, values of uint32_t parameters above INT32_MAX are wrapped */
+        int32_t s32_value = 0;
+        if ((enm_type != BASE_TYPE_string) && (enm_type != BASE_TYPE_blob) &&
+            !b_MQTTMN_Msg_Get_Int32 (&stru_node, &s32_value) &&
+            !b_MQTTMN_Msg_Get_Uint32 (&stru_node, (uint32_t *)&s32_value))
+        {
+            LOGW ("Value of parameter with PUC 0x%02X is not an integer", u16_puc);
+            pstri_status = STATUS_ERR_INVALID_DATA;
+            continue;
+        }
+
         /* Change value of the corresponding parameter */
-        int32_t s32_value;
+        int8_t s8_result = PARAM_ERR;
         switch (enm_type)
         {
             case BASE_TYPE_uint8_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Uint8 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Uint8 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_int8_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Int8 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Int8 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_uint16_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Uint16 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Uint16 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_int16_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Int16 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Int16 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_uint32_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Uint32 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Uint32 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_int32_t:
             {
-                sscanf (pstri_value, "%d", &s32_value);
-                s8_PARAM_Set_Int32 (enm_param_id, s32_value);
+                s8_result = s8_PARAM_Set_Int32 (enm_param_id, s32_value);
                 break;
             }
 
             case BASE_TYPE_string:
             {
-                s8_PARAM_Set_String (enm_param_id, pstri_value);
+                char stri_value[MAX_PARAM_STRING_LEN];
+                const char * pstri_value = pstri_MQTTMN_Msg_Get_String (&stru_node, stri_value, sizeof (stri_value));
+                if (pstri_value == NULL)
+                {
+                    LOGW ("Value of parameter with PUC 0x%02X is not a string or is too long", u16_puc);
+                    break;
+                }
+                s8_result = s8_PARAM_Set_String (enm_param_id, pstri_value);
                 break;
             }
 
             case BASE_TYPE_blob:
             {
+                /* Byte string of CBOR commands, used in place */
+                const uint8_t * pu8_value;
+                uint16_t u16_len;
+                if (b_MQTTMN_Msg_Get_Bytes (&stru_node, &pu8_value, &u16_len))
+                {
+                    s8_result = s8_PARAM_Set_Blob (enm_param_id, pu8_value, u16_len);
+                    break;
+                }
+
+                /* Hex string of JSON commands */
                 uint8_t * pu8_data = NULL;
-                uint8_t u8_len = 0;
-                v_MQTTMN_Hex2Data (pstri_value, &pu8_data, &u8_len);
+                char stri_value[MAX_PARAM_STRING_LEN];
+                const char * pstri_value = pstri_MQTTMN_Msg_Get_String (&stru_node, stri_value, sizeof (stri_value));
+                if (pstri_value != NULL)
+                {
+                    v_MQTTMN_Hex2Data (pstri_value, &pu8_data, &u16_len);
+                }
                 if (pu8_data != NULL)
                 {
-                    s8_PARAM_Set_Blob (enm_param_id, pu8_data, u8_len);
+                    s8_result = s8_PARAM_Set_Blob (enm_param_id, pu8_data, u16_len);
                     free (pu8_data);
                 }
                 break;
@@ -375,12 +562,233 @@ static void v_MQTTMN_paramWriteRequest_Handler (MQTTMN_session_t * pstru_session
                 break;
             }
         }
+        if (s8_result != PARAM_OK)
+        {
+            pstri_status = STATUS_ERR_INVALID_DATA;
+        }
+    }
+
+    /* Commit the changes only if all of them are valid */
+    if (b_trans)
+    {
+        if (strcmp (pstri_status, STATUS_OK) != 0)
+        {
+            s8_PARAM_Abort ();
+        }
+        else if (s8_PARAM_Commit () != PARAM_OK)
+        {
+            pstri_status = STATUS_ERR;
+        }
     }
 
     /* Publish the response */
     s8_MQTTMN_Send_paramWriteResponse (pstru_session, pstri_status);
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Handler of paramSnapshotReadRequest command
+**
+** @details
+**      This command is used to export all of Rotimatic’s non-volatile settings which can be copied to another device,
+**      as a single snapshot in the format described in srvc_param.h. The snapshot is returned in the response, or
+**      written to a file in root directory which can then be downloaded with fileDownloadReadRequest command.
+**      Extra command data:
+**          "file":"<filePathName>"         (optional)
+**
+** @param [in]
+**      pstru_session: the session through which the command was received
+**
+** @param [in]
+**      pstru_command: the received command
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_paramSnapshotReadRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                       const MQTTMN_value_t * pstru_command)
+{
+    MQTTMN_value_t  stru_item;
+    const char *    pstri_file_name = NULL;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
+    char            stri_file_path [MAX_FILE_PATH_LEN];
+    uint8_t *       pu8_snapshot = NULL;
+    uint16_t        u16_len = 0;
+    const char *    pstri_status = STATUS_OK;
+
+    /* Optional file to write the snapshot to */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item))
+    {
+        pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name, sizeof (stri_file_name));
+        if ((pstri_file_name == NULL) ||
+            (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0))
+        {
+            LOGE ("File name is invalid or too long");
+            pstri_status = STATUS_ERR_INVALID_DATA;
+        }
+    }
+
+    /* Export the snapshot */
+    if ((strcmp (pstri_status, STATUS_OK) == 0) && (s8_PARAM_Export (&pu8_snapshot, &u16_len) != PARAM_OK))
+    {
+        pstri_status = STATUS_ERR;
+    }
+
+    /* Write the snapshot to the file */
+    if ((strcmp (pstri_status, STATUS_OK) == 0) && (pstri_file_name != NULL))
+    {
+        lfs2_file_t x_file;
+        if (lfs2_file_open (g_px_lfs2, &x_file, stri_file_path, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
+        {
+            LOGE ("Failed to create file %s", pstri_file_name);
+            pstri_status = STATUS_ERR_INVALID_ACCESS;
+        }
+        else
+        {
+            if (lfs2_file_write (g_px_lfs2, &x_file, pu8_snapshot, u16_len) != u16_len)
+            {
+                LOGE ("Failed to write file %s", pstri_file_name);
+                pstri_status = STATUS_ERR_INVALID_ACCESS;
+            }
+            if ((lfs2_file_close (g_px_lfs2, &x_file) < 0) && (strcmp (pstri_status, STATUS_OK) == 0))
+            {
+                LOGE ("Failed to close file %s", pstri_file_name);
+                pstri_status = STATUS_ERR_INVALID_ACCESS;
+            }
+        }
+    }
+
+    /* Publish the response, the snapshot is part of it unless it has been written to a file */
+    s8_MQTTMN_Send_paramSnapshotReadResponse (pstru_session, pstri_status,
+                                              (pstri_file_name == NULL) ? pu8_snapshot : NULL, u16_len);
+
+    /* Clean up */
+    if (pu8_snapshot != NULL)
+    {
+        free (pu8_snapshot);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Handler of paramSnapshotWriteRequest command
+**
+** @details
+**      This command is used to import a snapshot exported by paramSnapshotReadRequest command, from the same or from
+**      another Rotimatic node. All the settings of the snapshot are changed at once, or none of them. The snapshot is
+**      sent in the command, or read from a file in root directory uploaded with fileUploadWriteRequest command.
+**      Extra command data:
+**          "snapshot":"<hexString>"        (a byte string in CBOR)
+**      or
+**          "file":"<filePathName>"
+**
+** @param [in]
+**      pstru_session: the session through which the command was received
+**
+** @param [in]
+**      pstru_command: the received command
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_paramSnapshotWriteRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                        const MQTTMN_value_t * pstru_command)
+{
+    MQTTMN_value_t  stru_item;
+    const uint8_t * pu8_snapshot = NULL;
+    uint8_t *       pu8_buf = NULL;
+    uint16_t        u16_len = 0;
+    const char *    pstri_status = STATUS_OK;
+
+    /* Snapshot sent in the command */
+    if (b_MQTTMN_Msg_Get_Item (pstru_command, "snapshot", &stru_item))
+    {
+        /* Byte string of CBOR commands is used in place, hex string of JSON commands is converted */
+        if (!b_MQTTMN_Msg_Get_Bytes (&stru_item, &pu8_snapshot, &u16_len))
+        {
+            const char * pstri_hex = pstri_MQTTMN_Msg_Get_String (&stru_item, NULL, 0);
+            if (pstri_hex != NULL)
+            {
+                v_MQTTMN_Hex2Data (pstri_hex, &pu8_buf, &u16_len);
+            }
+            pu8_snapshot = pu8_buf;
+        }
+        if (pu8_snapshot == NULL)
+        {
+            LOGE ("Invalid request command received: \"snapshot\" is not binary data");
+            pstri_status = STATUS_ERR_INVALID_DATA;
+        }
+    }
+
+    /* Snapshot stored in a file */
+    else if (b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item))
+    {
+        char stri_file_name [MAX_FILE_NAME_LEN + 1];
+        char stri_file_path [MAX_FILE_PATH_LEN];
+        const char * pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name,
+                                                                    sizeof (stri_file_name));
+        lfs2_file_t x_file;
+        if ((pstri_file_name == NULL) ||
+            (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0))
+        {
+            LOGE ("File name is invalid or too long");
+            pstri_status = STATUS_ERR_INVALID_DATA;
+        }
+        else if (lfs2_file_open (g_px_lfs2, &x_file, stri_file_path, LFS2_O_RDONLY) < 0)
+        {
+            LOGE ("Failed to open file %s", pstri_file_name);
+            pstri_status = STATUS_ERR_INVALID_ACCESS;
+        }
+        else
+        {
+            lfs2_soff_t x_size = lfs2_file_size (g_px_lfs2, &x_file);
+            if ((x_size <= 0) || (x_size > UINT16_MAX))
+            {
+                LOGE ("Size of file %s is invalid for a snapshot", pstri_file_name);
+                pstri_status = STATUS_ERR_INVALID_DATA;
+            }
+            else if ((pu8_buf = malloc (x_size)) == NULL)
+            {
+                LOGE ("Failed to allocate memory for the snapshot");
+                pstri_status = STATUS_ERR;
+            }
+            else if (lfs2_file_read (g_px_lfs2, &x_file, pu8_buf, x_size) != x_size)
+            {
+                LOGE ("Failed to read file %s", pstri_file_name);
+                pstri_status = STATUS_ERR_INVALID_ACCESS;
+            }
+            else
+            {
+                pu8_snapshot = pu8_buf;
+                u16_len = (uint16_t)x_size;
+            }
+            lfs2_file_close (g_px_lfs2, &x_file);
+        }
+    }
+    else
+    {
+        LOGE ("Invalid request command received: No \"snapshot\" or \"file\" key");
+        pstri_status = STATUS_ERR_INVALID_DATA;
+    }
+
+    /* Import all the settings at once */
+    if ((pu8_snapshot != NULL) && (s8_PARAM_Import (pu8_snapshot, u16_len) != PARAM_OK))
+    {
+        pstri_status = STATUS_ERR_INVALID_DATA;
+    }
+
+    /* Publish the response */
+    s8_MQTTMN_Send_paramSnapshotWriteResponse (pstru_session, pstri_status);
+
+    /* Clean up */
+    if (pu8_buf != NULL)
+    {
+        free (pu8_buf);
+    }
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -395,11 +803,12 @@ static void v_MQTTMN_paramWriteRequest_Handler (MQTTMN_session_t * pstru_session
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_fileListReadRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_fileListReadRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                  const MQTTMN_value_t * pstru_command)
 {
     /* Publish the response */
     s8_MQTTMN_Send_fileListReadResponse (pstru_session, STATUS_OK);
@@ -413,35 +822,43 @@ static void v_MQTTMN_fileListReadRequest_Handler (MQTTMN_session_t * pstru_sessi
 **
 ** @details
 **      This command is used to start uploading a file to filesystem of the requested Rotimatic node(s). Content of the
-**      file shall be sent through data messages
+**      file shall be sent through data messages, from the offset returned in the response (see file_upload.c). The
+**      file is only created once its checksum is verified. An interrupted upload is resumed by requesting the same
+**      file with "resume" set to true, the response then returns the offset of the data not stored yet.
 **      Extra command data:
 **          "file":"<filePathName>"
 **          "size":<fileSize>
-**          "checksum":"<fileChecksum>"
+**          "checksum":<fileChecksum>       (CRC-32, as a number or a string of hex digits)
+**          "resume":<true/false>           (optional, false by default)
 **
 ** @param [in]
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                     const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
-    char *          pstri_file_name = NULL;
+    MQTTMN_value_t  stru_item;
+    const char *    pstri_file_name = NULL;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
     char            stri_file_path [MAX_FILE_PATH_LEN];
     uint32_t        u32_file_size = 0;
-    char *          pstri_file_checksum = NULL;
+    uint32_t        u32_checksum = 0;
+    uint32_t        u32_offset = 0;
+    bool            b_resume = false;
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
 
     /* File name */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "file");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item) ||
+            ((pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name,
+                                                             sizeof (stri_file_name))) == NULL))
         {
             LOGE ("Invalid request command received: No \"file\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -449,7 +866,6 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
         }
         else
         {
-            pstri_file_name = px_json_node->valuestring;
             if (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0)
             {
                 LOGE ("File name %s is too long", pstri_file_name);
@@ -462,8 +878,8 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
     /* File size */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "size");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "size", &stru_item) ||
+            !b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_file_size))
         {
             LOGE ("Invalid request command received: No \"size\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -471,7 +887,6 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
         }
         else
         {
-            u32_file_size = px_json_node->valueint;
             if (u32_file_size > MQTT_MAX_FILE_SIZE)
             {
                 LOGE ("File size (%d bytes) is too big", u32_file_size);
@@ -484,18 +899,60 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
     /* File checksum */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "checksum");
-        if (px_json_node == NULL)
+        char stri_checksum [11];
+        const char * pstri_checksum;
+        char * pstri_end;
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "checksum", &stru_item))
         {
             LOGE ("Invalid request command received: No \"checksum\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
             b_success = false;
         }
-        else
+        else if (!b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_checksum))
         {
-            pstri_file_checksum = px_json_node->valuestring;
-            /* Currently, checksum is not used */
-            (void) pstri_file_checksum;
+            pstri_checksum = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_checksum, sizeof (stri_checksum));
+            if (pstri_checksum != NULL)
+            {
+                u32_checksum = strtoul (pstri_checksum, &pstri_end, 16);
+            }
+            if ((pstri_checksum == NULL) || (pstri_end == pstri_checksum) || (*pstri_end != 0))
+            {
+                LOGE ("Invalid request command received: Invalid \"checksum\" value");
+                pstri_status = STATUS_ERR_INVALID_DATA;
+                b_success = false;
+            }
+        }
+    }
+
+    /* Resume the upload (optional) */
+    if (b_success)
+    {
+        if (b_MQTTMN_Msg_Get_Item (pstru_command, "resume", &stru_item))
+        {
+            b_resume = b_MQTTMN_Msg_Get_Bool (&stru_item);
+        }
+    }
+
+    /* Limit the number of files transferred at a time, the file being uploaded by this session is replaced */
+    if (b_success)
+    {
+        if (!b_MQTTMN_Transfer_Available () && !b_MQTTMN_Upload_Is_Active (pstru_session))
+        {
+            LOGW ("Too many files are being transferred");
+            pstri_status = STATUS_ERR_BUSY;
+            b_success = false;
+        }
+    }
+
+    /* Check if the file is being uploaded by another session */
+    if (b_success)
+    {
+        const MQTTMN_session_t * pstru_uploading = pstru_MQTTMN_Upload_Get_Session (stri_file_path);
+        if ((pstru_uploading != NULL) && (pstru_uploading != pstru_session))
+        {
+            LOGE ("File %s is being uploaded by another session", pstri_file_name);
+            pstri_status = STATUS_ERR_BUSY;
+            b_success = false;
         }
     }
 
@@ -512,38 +969,49 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
         }
     }
 
-    /* Check if there in enough space for the file */
+    /* Open the temporary file of the new file, its data shall be sent via unicast data channel */
+    if (b_success)
+    {
+        if (s8_MQTTMN_Upload_Start (pstru_session, stri_file_path, u32_file_size, u32_checksum, b_resume,
+                                    &u32_offset) != MQTTMN_OK)
+        {
+            pstri_status = STATUS_ERR;
+            b_success = false;
+        }
+    }
+
+    /* Check if there in enough space for the data not stored yet */
     if (b_success)
     {
         uint32_t u32_free_space;
         if (s8_MQTTMN_Get_Storage_Space (NULL, &u32_free_space) != MQTTMN_OK)
         {
             LOGE ("Failed to get information of LittleFS storage");
+            v_MQTTMN_Upload_Cancel (pstru_session);
             pstri_status = STATUS_ERR;
             b_success = false;
         }
         else
         {
-            if (u32_file_size > u32_free_space)
+            if (u32_file_size - u32_offset > u32_free_space)
             {
                 LOGE ("Not enough space in LittleFS storage (required = %d bytes, free = %d bytes)",
-                          u32_file_size, u32_free_space);
+                          u32_file_size - u32_offset, u32_free_space);
+                v_MQTTMN_Upload_Cancel (pstru_session);
                 pstri_status = STATUS_ERR_INVALID_ACCESS;
                 b_success = false;
             }
         }
     }
 
-    /* Store path of the new file, its data shall be sent via unicast data channel */
-    g_stri_upload_file [0] = 0;
-    if (b_success)
+    /* Publish the response */
+    s8_MQTTMN_Send_fileUploadWriteResponse (pstru_session, pstri_status, u32_offset);
+
+    /* All data has already been stored (empty file, or restart just before the file was verified) */
+    if (b_success && (u32_offset == u32_file_size))
     {
-        strncpy (g_stri_upload_file, stri_file_path, sizeof (g_stri_upload_file));
-        g_stri_upload_file [sizeof (g_stri_upload_file) - 1] = 0;
+        v_MQTTMN_Upload_Complete (pstru_session);
     }
-
-    /* Publish the response */
-    s8_MQTTMN_Send_fileUploadWriteResponse (pstru_session, pstri_status);
 }
 
 /**
@@ -554,33 +1022,54 @@ static void v_MQTTMN_fileUploadWriteRequest_Handler (MQTTMN_session_t * pstru_se
 **
 ** @details
 **      This command is used to start downloading a file in filesystem of the requested Rotimatic node(s). Content of
-**      the file shall be sent through data messages
+**      the file shall be sent through data messages, each carrying a chunk of the file preceded by its offset and
+**      CRC-32 (see file_download.c). An interrupted download is resumed by requesting the file from the offset of
+**      the first chunk not received.
 **      Extra command data:
 **          "file":"<filePathName>"
+**          "offset":<byteOffset>           (optional, 0 by default)
 **
 ** @param [in]
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_fileDownloadReadRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_fileDownloadReadRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                      const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
-    char *          pstri_file_name = NULL;
+    MQTTMN_value_t  stru_item;
+    const char *    pstri_file_name = NULL;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
     char            stri_file_path [MAX_FILE_PATH_LEN];
     uint32_t        u32_file_size = 0;
+    uint32_t        u32_offset = 0;
     uint32_t        u32_checksum = 0;
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
 
+    /* Each session downloads one file at a time, and the number of files transferred at a time is limited */
+    if (b_MQTTMN_Download_Is_Active (pstru_session))
+    {
+        LOGW ("Another file is being downloaded");
+        pstri_status = STATUS_ERR_BUSY;
+        b_success = false;
+    }
+    else if (!b_MQTTMN_Transfer_Available ())
+    {
+        LOGW ("Too many files are being transferred");
+        pstri_status = STATUS_ERR_BUSY;
+        b_success = false;
+    }
+
     /* File name */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "file");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item) ||
+            ((pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name,
+                                                             sizeof (stri_file_name))) == NULL))
         {
             LOGE ("Invalid request command received: No \"file\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -588,7 +1077,6 @@ static void v_MQTTMN_fileDownloadReadRequest_Handler (MQTTMN_session_t * pstru_s
         }
         else
         {
-            pstri_file_name = px_json_node->valuestring;
             if (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0)
             {
                 LOGE ("File name %s is too long", pstri_file_name);
@@ -614,27 +1102,30 @@ static void v_MQTTMN_fileDownloadReadRequest_Handler (MQTTMN_session_t * pstru_s
         }
     }
 
+    /* Offset to resume the download from */
+    if (b_success && b_MQTTMN_Msg_Get_Item (pstru_command, "offset", &stru_item))
+    {
+        if (!b_MQTTMN_Msg_Get_Uint32 (&stru_item, &u32_offset) || (u32_offset > u32_file_size))
+        {
+            LOGE ("Invalid offset to download file %s from", pstri_file_name);
+            pstri_status = STATUS_ERR_INVALID_DATA;
+            b_success = false;
+        }
+    }
+
     /** @todo   Calculate file checksum */
     if (b_success)
     {
         u32_checksum = 0;
     }    
 
-    /* Store path of the file to download, its data shall be sent via unicast data channel */
-    g_stri_download_file [0] = 0;
-    if (b_success)
-    {
-        strncpy (g_stri_download_file, stri_file_path, sizeof (g_stri_download_file));
-        g_stri_download_file [sizeof (g_stri_download_file) - 1] = 0;
-    }
-    
     /* Publish the response */
     s8_MQTTMN_Send_fileDownloadReadResponse (pstru_session, pstri_status, u32_file_size, u32_checksum);
 
-    /* Publish content of the requested file */
+    /* Content of the requested file shall be sent via unicast data channel by App_Mqtt_Mngr task */
     if (b_success)
     {
-        xEventGroupSetBits (g_x_event_group, MQTTMN_FILE_DOWNLOAD_STARTED_EVT);
+        s8_MQTTMN_Download_Request (pstru_session, stri_file_path, u32_file_size, u32_offset);
     }
 }
 
@@ -653,14 +1144,16 @@ static void v_MQTTMN_fileDownloadReadRequest_Handler (MQTTMN_session_t * pstru_s
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_fileDeleteWriteRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_fileDeleteWriteRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                     const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
-    char *          pstri_file_name = NULL;
+    MQTTMN_value_t  stru_item;
+    const char *    pstri_file_name = NULL;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
     char            stri_file_path [MAX_FILE_PATH_LEN];
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
@@ -668,8 +1161,9 @@ static void v_MQTTMN_fileDeleteWriteRequest_Handler (MQTTMN_session_t * pstru_se
     /* File name */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "file");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item) ||
+            ((pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name,
+                                                             sizeof (stri_file_name))) == NULL))
         {
             LOGE ("Invalid request command received: No \"file\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -677,7 +1171,6 @@ static void v_MQTTMN_fileDeleteWriteRequest_Handler (MQTTMN_session_t * pstru_se
         }
         else
         {
-            pstri_file_name = px_json_node->valuestring;
             if (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0)
             {
                 LOGE ("File name %s is too long", pstri_file_name);
@@ -729,14 +1222,16 @@ static void v_MQTTMN_fileDeleteWriteRequest_Handler (MQTTMN_session_t * pstru_se
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                  const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
-    char *          pstri_file_name = NULL;
+    MQTTMN_value_t  stru_item;
+    const char *    pstri_file_name = NULL;
+    char            stri_file_name [MAX_FILE_NAME_LEN + 1];
     char            stri_file_path [MAX_FILE_PATH_LEN];
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
@@ -744,8 +1239,9 @@ static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_sessi
     /* File name */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "file");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item) ||
+            ((pstri_file_name = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_file_name,
+                                                             sizeof (stri_file_name))) == NULL))
         {
             LOGE ("Invalid request command received: No \"file\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -753,7 +1249,6 @@ static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_sessi
         }
         else
         {
-            pstri_file_name = px_json_node->valuestring;
             if (snprintf (stri_file_path, sizeof (stri_file_path), "%s/%s", LFS_MOUNT_POINT, pstri_file_name) < 0)
             {
                 LOGE ("File name %s is too long", pstri_file_name);
@@ -763,11 +1258,17 @@ static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_sessi
         }
     }
 
-    /* Check if the file exists */
+    /* Check if the file exists. An uploaded file only exists once its checksum has been verified */
     if (b_success)
     {
         struct lfs2_info stru_file_info;
-        if (lfs2_stat (g_px_lfs2, stri_file_path, &stru_file_info) < 0)
+        if (pstru_MQTTMN_Upload_Get_Session (stri_file_path) != NULL)
+        {
+            LOGE ("File %s is being uploaded", pstri_file_name);
+            pstri_status = STATUS_ERR_BUSY;
+            b_success = false;
+        }
+        else if (lfs2_stat (g_px_lfs2, stri_file_path, &stru_file_info) < 0)
         {
             LOGE ("File %s doesn't exist", pstri_file_name);
             pstri_status = STATUS_ERR_INVALID_ACCESS;
@@ -827,22 +1328,30 @@ static void v_MQTTMN_fileRunWriteRequest_Handler (MQTTMN_session_t * pstru_sessi
 **      pstru_session: the session through which the command was received
 **
 ** @param [in]
-**      px_json_root: cJSON object of received command
+**      pstru_command: the received command
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static void v_MQTTMN_otaUpdateWriteRequest_Handler (MQTTMN_session_t * pstru_session, const cJSON * px_json_root)
+static void v_MQTTMN_otaUpdateWriteRequest_Handler (MQTTMN_session_t * pstru_session,
+                                                    const MQTTMN_value_t * pstru_command)
 {
-    cJSON *         px_json_node = NULL;
+    MQTTMN_value_t  stru_item;
     OTAMN_config_t  stru_ota_cfg;
+    char            stri_target [16];
+    char            stri_url [MAX_OTA_URL_LEN];
+    char            stri_inst_dir [MAX_FILE_PATH_LEN];
     const char *    pstri_status = STATUS_OK;
     bool            b_success = true;
 
     /* Target of the update */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "target");
-        if (px_json_node == NULL)
+        const char * pstri_target = NULL;
+        if (b_MQTTMN_Msg_Get_Item (pstru_command, "target", &stru_item))
+        {
+            pstri_target = pstri_MQTTMN_Msg_Get_String (&stru_item, stri_target, sizeof (stri_target));
+        }
+        if (pstri_target == NULL)
         {
             LOGE ("Invalid request command received: No \"target\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
@@ -850,7 +1359,6 @@ static void v_MQTTMN_otaUpdateWriteRequest_Handler (MQTTMN_session_t * pstru_ses
         }
         else
         {
-            char * pstri_target = px_json_node->valuestring;
             if (strcmp ("masterFw", pstri_target) == 0)
             {
                 stru_ota_cfg.enm_target = OTAMN_MASTER_FW;
@@ -875,24 +1383,23 @@ static void v_MQTTMN_otaUpdateWriteRequest_Handler (MQTTMN_session_t * pstru_ses
     /* Source download URL */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "url");
-        if (px_json_node == NULL)
+        stru_ota_cfg.pstri_url = NULL;
+        if (b_MQTTMN_Msg_Get_Item (pstru_command, "url", &stru_item))
+        {
+            stru_ota_cfg.pstri_url = (char *)pstri_MQTTMN_Msg_Get_String (&stru_item, stri_url, sizeof (stri_url));
+        }
+        if (stru_ota_cfg.pstri_url == NULL)
         {
             LOGE ("Invalid request command received: No \"url\" key");
             pstri_status = STATUS_ERR_INVALID_DATA;
             b_success = false;
         }
-        else
-        {
-            stru_ota_cfg.pstri_url = px_json_node->valuestring;
-        }
     }
 
     /* Installation path (this field is optional for firmware update, but mandatory for file update) */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "file");
-        if (px_json_node == NULL)
+        if (!b_MQTTMN_Msg_Get_Item (pstru_command, "file", &stru_item))
         {
             if (stru_ota_cfg.enm_target == OTAMN_MASTER_FILE)
             {
@@ -907,15 +1414,22 @@ static void v_MQTTMN_otaUpdateWriteRequest_Handler (MQTTMN_session_t * pstru_ses
         }
         else
         {
-            stru_ota_cfg.pstri_inst_dir = px_json_node->valuestring;
+            stru_ota_cfg.pstri_inst_dir = (char *)pstri_MQTTMN_Msg_Get_String (&stru_item, stri_inst_dir,
+                                                                               sizeof (stri_inst_dir));
+            if (stru_ota_cfg.pstri_inst_dir == NULL)
+            {
+                LOGE ("Installation path is invalid or too long");
+                pstri_status = STATUS_ERR_INVALID_DATA;
+                b_success = false;
+            }
         }
     }
 
     /* Check if source is newer (this field is optional) */
     if (b_success)
     {
-        px_json_node = cJSON_GetObjectItem (px_json_root, "checkNewer");
-        stru_ota_cfg.b_check_newer = (px_json_node == NULL) ? false : cJSON_IsTrue (px_json_node);
+        stru_ota_cfg.b_check_newer = b_MQTTMN_Msg_Get_Item (pstru_command, "checkNewer", &stru_item) &&
+                                     b_MQTTMN_Msg_Get_Bool (&stru_item);
     }
 
     /* Request OTA manager to start the update */
@@ -0,0 +1,294 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : telemetry.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 14
+**  @brief      : This file contains the periodic sampling of the health of the device (heap, tasks, Wi-Fi, MQTT
+**                queues and storage) and its publishing via telemetryNotify messages.
+**                app_mqtt_mngr.c includes this file directly.
+**  @namespace  : MQTTMN
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  App_Mqtt_Mngr
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "esp_heap_caps.h"              /* Use heap_caps_get_free_size(), etc. */
+#include "esp_timer.h"                  /* Use esp_timer_get_time() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Coalescing key of telemetryNotify messages, only the latest sample waits to be published */
+#define MQTTMN_TELEMETRY_KEY                1
+
+/** @brief  Maximum number of tasks whose run time is remembered to compute their CPU usage between two samples */
+#define MQTTMN_TELEMETRY_MAX_TASKS          32
+
+/** @brief  Run time of a task at the previous sample */
+typedef struct
+{
+    TaskHandle_t    x_task;                         //!< The task
+    uint32_t        u32_run_time;                   //!< Run time counter of the task
+} MQTTMN_task_time_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Timer of the telemetry period */
+static TickType_t g_x_telemetry_timer;
+
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+/** @brief  Run time of the tasks at the previous sample */
+static MQTTMN_task_time_t g_astru_task_times[MQTTMN_TELEMETRY_MAX_TASKS];
+
+/** @brief  Number of tasks in g_astru_task_times */
+static uint8_t g_u8_num_task_times = 0;
+
+/** @brief  Total run time counter at the previous sample */
+static uint32_t g_u32_total_run_time = 0;
+#endif
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void v_MQTTMN_Telemetry_Run (void);
+static int8_t s8_MQTTMN_Send_telemetryNotify (void);
+static void v_MQTTMN_Telemetry_Add_Heap (MQTTMN_json_t * pstru_json, const char * pstri_key, uint32_t u32_caps);
+static void v_MQTTMN_Telemetry_Add_Tasks (MQTTMN_json_t * pstru_json);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Publishes a telemetryNotify message every CONFIG_MQTTMN_TELEMETRY_PERIOD seconds while the MQTT broker is
+**      connected. This function is called every cycle of App_Mqtt_Mngr task.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Telemetry_Run (void)
+{
+#if (CONFIG_MQTTMN_TELEMETRY_PERIOD > 0)
+    if (g_b_mqtt_connected &&
+        (TIMER_ELAPSED (g_x_telemetry_timer) >= pdMS_TO_TICKS (CONFIG_MQTTMN_TELEMETRY_PERIOD * 1000)))
+    {
+        TIMER_RESET (g_x_telemetry_timer);
+        s8_MQTTMN_Send_telemetryNotify ();
+    }
+#endif
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a telemetryNotify command
+**
+** @details
+**      This command is published on the telemetry topic to report the health of the device. Values that cannot be
+**      sampled are omitted.
+**      Extra command data:
+**          "uptime":<seconds since boot>
+**          "heap":{"free":<bytes>,"min":<bytes>,"blk":<bytes>}     (internal RAM: free, minimum free since boot,
+**                                                                  largest free block)
+**          "psram":{"free":<bytes>,"min":<bytes>,"blk":<bytes>}    (same for external SPI RAM)
+**          "rssi":<dBm>
+**          "mqtt":{"outbox":<bytes>,"posted":<bytes>}
+**          "fs":{"total":<bytes>,"free":<bytes>}
+**          "tasks":[["<name>",<stack>,<cpu>], ...]                 (stack high-water mark in bytes, CPU usage in
+**                                                                  percents of one CPU since the previous message)
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Send_telemetryNotify (void)
+{
+    /* Construct the notify */
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "telemetryNotify", g_u32_notify_eid, false);
+    g_u32_notify_eid = g_u32_notify_eid == 0x7FFFFFFF ? 1 : g_u32_notify_eid + 1;
+
+    v_MQTTMN_Json_Add_Uint32 (&stru_json, "uptime", (uint32_t)(esp_timer_get_time () / 1000000));
+
+    /* Heap usage */
+    v_MQTTMN_Telemetry_Add_Heap (&stru_json, "heap", MALLOC_CAP_INTERNAL);
+    if (heap_caps_get_total_size (MALLOC_CAP_SPIRAM) != 0)
+    {
+        v_MQTTMN_Telemetry_Add_Heap (&stru_json, "psram", MALLOC_CAP_SPIRAM);
+    }
+
+    /* Signal strength of the access point */
+    WIFI_ap_info_t stru_ap_info;
+    if (s8_WIFI_Get_Ap_Info (&stru_ap_info) == WIFI_OK)
+    {
+        v_MQTTMN_Json_Add_Int32 (&stru_json, "rssi", stru_ap_info.s8_rssi);
+    }
+
+    /* Data waiting to be published */
+    v_MQTTMN_Json_Begin_Object (&stru_json, "mqtt");
+    v_MQTTMN_Json_Add_Uint32 (&stru_json, "outbox", u32_MQTT_Get_Outbox_Size (g_x_mqtt));
+    v_MQTTMN_Json_Add_Uint32 (&stru_json, "posted", u32_MQTT_Get_Posted_Size (g_x_mqtt));
+    v_MQTTMN_Json_End_Object (&stru_json);
+
+    /* LittleFS usage */
+    uint32_t u32_total_space;
+    uint32_t u32_free_space;
+    if (s8_MQTTMN_Get_Storage_Space (&u32_total_space, &u32_free_space) == MQTTMN_OK)
+    {
+        v_MQTTMN_Json_Begin_Object (&stru_json, "fs");
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "total", u32_total_space);
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "free", u32_free_space);
+        v_MQTTMN_Json_End_Object (&stru_json);
+    }
+
+    /* Statistics of tasks */
+    v_MQTTMN_Telemetry_Add_Tasks (&stru_json);
+
+    /* Publish the notify, a sample that has not been published yet is replaced by this one */
+    uint32_t u32_len;
+    const char * pstri_notify = pstri_MQTTMN_Json_End (&stru_json, &u32_len);
+    if (pstri_notify == NULL)
+    {
+        return MQTTMN_ERR;
+    }
+    return (enm_MQTT_Post (g_x_mqtt, MQTT_S2M_TELEMETRY, MQTT_PRIO_TELEMETRY, MQTTMN_TELEMETRY_KEY,
+                           pstri_notify, u32_len) == MQTT_OK) ? MQTTMN_OK : MQTTMN_ERR;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes usage of a heap region as an object
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** @param [in]
+**      pstri_key: Key of the object
+**
+** @param [in]
+**      u32_caps: Capabilities of the heap region (MALLOC_CAP_INTERNAL or MALLOC_CAP_SPIRAM)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Telemetry_Add_Heap (MQTTMN_json_t * pstru_json, const char * pstri_key, uint32_t u32_caps)
+{
+    v_MQTTMN_Json_Begin_Object (pstru_json, pstri_key);
+    v_MQTTMN_Json_Add_Uint32 (pstru_json, "free", heap_caps_get_free_size (u32_caps));
+    v_MQTTMN_Json_Add_Uint32 (pstru_json, "min", heap_caps_get_minimum_free_size (u32_caps));
+    v_MQTTMN_Json_Add_Uint32 (pstru_json, "blk", heap_caps_get_largest_free_block (u32_caps));
+    v_MQTTMN_Json_End_Object (pstru_json);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes stack high-water mark and CPU usage of every task as an array
+**
+** @details
+**      The CPU usage of a task is its run time since the previous sample, in percents of the time elapsed. Hence the
+**      usages of all tasks add up to 100 times the number of CPUs. Nothing is written if FreeRTOS does not provide
+**      statistics of tasks (CONFIG_FREERTOS_USE_TRACE_FACILITY disabled), the CPU usage is omitted if FreeRTOS
+**      does not collect run time of tasks (CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS disabled).
+**
+** @param [in]
+**      pstru_json: The writer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Telemetry_Add_Tasks (MQTTMN_json_t * pstru_json)
+{
+#ifdef CONFIG_FREERTOS_USE_TRACE_FACILITY
+    /* Get state of all tasks, a few more tasks could be created meanwhile */
+    UBaseType_t x_num_tasks = uxTaskGetNumberOfTasks () + 2;
+    TaskStatus_t * pastru_tasks = malloc (x_num_tasks * sizeof (TaskStatus_t));
+    if (pastru_tasks == NULL)
+    {
+        LOGE ("Failed to allocate memory for statistics of %d tasks", x_num_tasks);
+        return;
+    }
+    uint32_t u32_total_run_time = 0;
+    x_num_tasks = uxTaskGetSystemState (pastru_tasks, x_num_tasks, &u32_total_run_time);
+
+    v_MQTTMN_Json_Begin_Array (pstru_json, "tasks");
+    for (UBaseType_t x_idx = 0; x_idx < x_num_tasks; x_idx++)
+    {
+        TaskStatus_t * pstru_task = &pastru_tasks[x_idx];
+        v_MQTTMN_Json_Begin_Array (pstru_json, NULL);
+        v_MQTTMN_Json_Add_String (pstru_json, NULL, pstru_task->pcTaskName);
+        v_MQTTMN_Json_Add_Uint32 (pstru_json, NULL, pstru_task->usStackHighWaterMark);
+
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+        /* Run time of the task since the previous sample, or since it was created */
+        uint32_t u32_run_time = pstru_task->ulRunTimeCounter;
+        for (uint8_t u8_idx = 0; u8_idx < g_u8_num_task_times; u8_idx++)
+        {
+            if (g_astru_task_times[u8_idx].x_task == pstru_task->xHandle)
+            {
+                u32_run_time -= g_astru_task_times[u8_idx].u32_run_time;
+                break;
+            }
+        }
+        uint32_t u32_elapsed = u32_total_run_time - g_u32_total_run_time;
+        uint32_t u32_percent = (u32_elapsed == 0) ? 0 : (uint32_t)((uint64_t)u32_run_time * 100 / u32_elapsed);
+        v_MQTTMN_Json_Add_Uint32 (pstru_json, NULL, u32_percent);
+#endif
+        v_MQTTMN_Json_End_Array (pstru_json);
+    }
+    v_MQTTMN_Json_End_Array (pstru_json);
+
+#ifdef CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    /* Remember run time of the tasks for the next sample */
+    g_u8_num_task_times = 0;
+    for (UBaseType_t x_idx = 0; (x_idx < x_num_tasks) && (g_u8_num_task_times < MQTTMN_TELEMETRY_MAX_TASKS); x_idx++)
+    {
+        g_astru_task_times[g_u8_num_task_times].x_task = pastru_tasks[x_idx].xHandle;
+        g_astru_task_times[g_u8_num_task_times].u32_run_time = pastru_tasks[x_idx].ulRunTimeCounter;
+        g_u8_num_task_times++;
+    }
+    g_u32_total_run_time = u32_total_run_time;
+#endif
+
+    free (pastru_tasks);
+#endif
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
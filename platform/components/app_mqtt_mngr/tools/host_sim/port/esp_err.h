@@ -0,0 +1,70 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : esp_err.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of esp_err.h of ESP-IDF, implemented by sim_esp.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_ESP_ERR_H__
+#define __SIM_PORT_ESP_ERR_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdint.h>                     /* Standard types */
+#include <stdlib.h>                     /* Use abort() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Error code of ESP-IDF functions */
+typedef int esp_err_t;
+
+/** @brief  Error codes */
+#define ESP_OK                                  0
+#define ESP_FAIL                                -1
+#define ESP_ERR_NO_MEM                          0x101
+#define ESP_ERR_INVALID_ARG                     0x102
+#define ESP_ERR_INVALID_SIZE                    0x104
+#define ESP_ERR_NOT_FOUND                       0x105
+#define ESP_ERR_NOT_SUPPORTED                   0x106
+
+/** @brief  Aborts the program if an ESP-IDF function fails */
+#define ESP_ERROR_CHECK(x)                      do { if ((x) != ESP_OK) { abort (); } } while (0)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Gets name of an error code */
+extern const char * esp_err_to_name (esp_err_t x_err);
+
+#endif /* __SIM_PORT_ESP_ERR_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
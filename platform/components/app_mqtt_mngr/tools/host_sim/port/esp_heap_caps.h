@@ -0,0 +1,67 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : esp_heap_caps.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of esp_heap_caps.h of ESP-IDF, implemented by sim_heap.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_ESP_HEAP_CAPS_H__
+#define __SIM_PORT_ESP_HEAP_CAPS_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdint.h>                     /* Standard types */
+#include <stddef.h>                     /* Use size_t */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Capabilities of heap regions */
+#define MALLOC_CAP_EXEC                         (1 << 0)
+#define MALLOC_CAP_32BIT                        (1 << 1)
+#define MALLOC_CAP_8BIT                         (1 << 2)
+#define MALLOC_CAP_DMA                          (1 << 3)
+#define MALLOC_CAP_SPIRAM                       (1 << 10)
+#define MALLOC_CAP_INTERNAL                     (1 << 11)
+#define MALLOC_CAP_DEFAULT                      (1 << 12)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Gets statistics of the heap, the simulated device has internal RAM only */
+extern size_t heap_caps_get_total_size (uint32_t u32_caps);
+extern size_t heap_caps_get_free_size (uint32_t u32_caps);
+extern size_t heap_caps_get_minimum_free_size (uint32_t u32_caps);
+extern size_t heap_caps_get_largest_free_block (uint32_t u32_caps);
+
+#endif /* __SIM_PORT_ESP_HEAP_CAPS_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,82 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : esp_log.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of esp_log.h of ESP-IDF, implemented by sim_esp.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_ESP_LOG_H__
+#define __SIM_PORT_ESP_LOG_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sdkconfig.h"                  /* Configuration of the host build */
+#include <stdint.h>                     /* Standard types */
+#include <stdlib.h>                     /* Use abort() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Log levels, the same as ESP-IDF */
+typedef enum
+{
+    ESP_LOG_NONE,                       //!< No log output
+    ESP_LOG_ERROR,                      //!< Critical errors
+    ESP_LOG_WARN,                       //!< Error conditions from which recovery measures have been taken
+    ESP_LOG_INFO,                       //!< Information messages which describe normal flow of events
+    ESP_LOG_DEBUG,                      //!< Extra information which is not necessary for normal use
+    ESP_LOG_VERBOSE,                    //!< Bigger chunks of debugging information
+} esp_log_level_t;
+
+/** @brief  Logging macros, the output looks like that of ESP-IDF */
+#define ESP_LOGE(tag, format, ...)      v_SIM_Log (ESP_LOG_ERROR, "E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...)      v_SIM_Log (ESP_LOG_WARN, "W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)      v_SIM_Log (ESP_LOG_INFO, "I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...)      v_SIM_Log (ESP_LOG_DEBUG, "D", tag, format, ##__VA_ARGS__)
+#define ESP_LOGV(tag, format, ...)      v_SIM_Log (ESP_LOG_VERBOSE, "V", tag, format, ##__VA_ARGS__)
+#define ESP_LOG_BUFFER_HEX(tag, buffer, buff_len)   v_SIM_Log_Hex (tag, buffer, buff_len)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Sets the maximum level of the logs displayed */
+extern void esp_log_level_set (const char * pstri_tag, esp_log_level_t enm_level);
+
+/* Displays a log message */
+extern void v_SIM_Log (esp_log_level_t enm_level, const char * pstri_letter, const char * pstri_tag,
+                       const char * pstri_format, ...) __attribute__ ((format (printf, 4, 5)));
+
+/* Displays a buffer in hexadecimal */
+extern void v_SIM_Log_Hex (const char * pstri_tag, const void * pv_buffer, uint16_t u16_len);
+
+#endif /* __SIM_PORT_ESP_LOG_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
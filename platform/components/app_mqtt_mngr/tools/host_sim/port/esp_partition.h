@@ -0,0 +1,79 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : esp_partition.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of esp_partition.h of ESP-IDF, implemented by sim_storage.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_ESP_PARTITION_H__
+#define __SIM_PORT_ESP_PARTITION_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdint.h>                     /* Standard types */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Partition types */
+typedef enum
+{
+    ESP_PARTITION_TYPE_APP                  = 0x00,
+    ESP_PARTITION_TYPE_DATA                 = 0x01,
+} esp_partition_type_t;
+
+/** @brief  Partition subtypes */
+typedef enum
+{
+    ESP_PARTITION_SUBTYPE_DATA_FAT          = 0x81,
+    ESP_PARTITION_SUBTYPE_ANY               = 0xFF,
+} esp_partition_subtype_t;
+
+/** @brief  Information of a partition */
+typedef struct
+{
+    esp_partition_type_t    type;       //!< Partition type
+    esp_partition_subtype_t subtype;    //!< Partition subtype
+    uint32_t                address;    //!< Starting address of the partition in flash
+    uint32_t                size;       //!< Size of the partition, in bytes
+    char                    label[17];  //!< Partition label
+} esp_partition_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Finds the first partition of the given type, subtype and label, only the "vfs" partition is simulated */
+extern const esp_partition_t * esp_partition_find_first (esp_partition_type_t enm_type,
+                                                         esp_partition_subtype_t enm_subtype, const char * pstri_label);
+
+#endif /* __SIM_PORT_ESP_PARTITION_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,80 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : FreeRTOS.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of FreeRTOS.h, the kernel is simulated on POSIX threads by sim_freertos.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_FREERTOS_FREERTOS_H__
+#define __SIM_PORT_FREERTOS_FREERTOS_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sdkconfig.h"                  /* Configuration of the host build */
+#include "esp_bit_defs.h"               /* Use BITx definitions */
+#include <stdint.h>                     /* Standard types */
+#include <stdbool.h>                    /* Boolean type */
+#include <stddef.h>                     /* NULL definition */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Base types of the port, the same sizes as those of ESP32 */
+typedef int32_t                         BaseType_t;
+typedef uint32_t                        UBaseType_t;
+typedef uint32_t                        TickType_t;
+typedef uint8_t                         StackType_t;
+
+/** @brief  Kernel configuration */
+#define configTICK_RATE_HZ              CONFIG_FREERTOS_HZ
+#define configMAX_PRIORITIES            25
+
+/** @brief  Constants */
+#define pdFALSE                         ((BaseType_t)0)
+#define pdTRUE                          ((BaseType_t)1)
+#define pdFAIL                          pdFALSE
+#define pdPASS                          pdTRUE
+#define portMAX_DELAY                   ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS              ((TickType_t)1000 / configTICK_RATE_HZ)
+#define portTICK_RATE_MS                portTICK_PERIOD_MS
+#define pdMS_TO_TICKS(xTimeInMs)        ((TickType_t)(((TickType_t)(xTimeInMs) * configTICK_RATE_HZ) / 1000))
+#define tskIDLE_PRIORITY                ((UBaseType_t)0)
+#define tskNO_AFFINITY                  ((BaseType_t)0x7FFFFFFF)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Gets ID of the CPU running the calling task, which is the CPU the task is pinned to */
+extern BaseType_t xPortGetCoreID (void);
+
+#endif /* __SIM_PORT_FREERTOS_FREERTOS_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,74 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : event_groups.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of event_groups.h of FreeRTOS, implemented by sim_freertos.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_FREERTOS_EVENT_GROUPS_H__
+#define __SIM_PORT_FREERTOS_EVENT_GROUPS_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS types */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Handle of an event group */
+typedef struct SIM_event_group *        EventGroupHandle_t;
+
+/** @brief  Bits of an event group */
+typedef TickType_t                      EventBits_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Creates an event group */
+extern EventGroupHandle_t xEventGroupCreate (void);
+
+/* Sets bits of an event group */
+extern EventBits_t xEventGroupSetBits (EventGroupHandle_t x_event_group, EventBits_t x_bits);
+
+/* Clears bits of an event group */
+extern EventBits_t xEventGroupClearBits (EventGroupHandle_t x_event_group, EventBits_t x_bits);
+
+/* Gets bits of an event group */
+extern EventBits_t xEventGroupGetBits (EventGroupHandle_t x_event_group);
+
+/* Waits for any or all of some bits of an event group to be set */
+extern EventBits_t xEventGroupWaitBits (EventGroupHandle_t x_event_group, EventBits_t x_bits,
+                                        BaseType_t x_clear_on_exit, BaseType_t x_wait_for_all,
+                                        TickType_t x_ticks_to_wait);
+
+#endif /* __SIM_PORT_FREERTOS_EVENT_GROUPS_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,83 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : queue.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of queue.h of FreeRTOS, implemented by sim_freertos.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_FREERTOS_QUEUE_H__
+#define __SIM_PORT_FREERTOS_QUEUE_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS types */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Handle of a queue */
+typedef struct SIM_queue *              QueueHandle_t;
+
+/** @brief  Sends an item to the back of a queue */
+#define xQueueSend(xQueue, pvItemToQueue, xTicksToWait)         \
+    xQueueGenericSend (xQueue, pvItemToQueue, xTicksToWait, pdFALSE)
+#define xQueueSendToBack(xQueue, pvItemToQueue, xTicksToWait)   \
+    xQueueGenericSend (xQueue, pvItemToQueue, xTicksToWait, pdFALSE)
+
+/** @brief  Sends an item to the front of a queue */
+#define xQueueSendToFront(xQueue, pvItemToQueue, xTicksToWait)  \
+    xQueueGenericSend (xQueue, pvItemToQueue, xTicksToWait, pdTRUE)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Creates a queue */
+extern QueueHandle_t xQueueCreate (UBaseType_t x_length, UBaseType_t x_item_size);
+
+/* Deletes a queue */
+extern void vQueueDelete (QueueHandle_t x_queue);
+
+/* Sends an item to a queue, waiting for at most a number of ticks if the queue is full */
+extern BaseType_t xQueueGenericSend (QueueHandle_t x_queue, const void * pv_item, TickType_t x_ticks_to_wait,
+                                     BaseType_t x_to_front);
+
+/* Receives an item from a queue, waiting for at most a number of ticks if the queue is empty */
+extern BaseType_t xQueueReceive (QueueHandle_t x_queue, void * pv_item, TickType_t x_ticks_to_wait);
+
+/* Copies the first item of a queue without removing it, waiting for at most a number of ticks if the queue is empty */
+extern BaseType_t xQueuePeek (QueueHandle_t x_queue, void * pv_item, TickType_t x_ticks_to_wait);
+
+/* Gets number of items in a queue */
+extern UBaseType_t uxQueueMessagesWaiting (QueueHandle_t x_queue);
+
+#endif /* __SIM_PORT_FREERTOS_QUEUE_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
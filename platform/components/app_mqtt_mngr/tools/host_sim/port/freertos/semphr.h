@@ -0,0 +1,74 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : semphr.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of semphr.h of FreeRTOS, semaphores are queues of empty items as in FreeRTOS
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_FREERTOS_SEMPHR_H__
+#define __SIM_PORT_FREERTOS_SEMPHR_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Handle of a semaphore */
+typedef QueueHandle_t                   SemaphoreHandle_t;
+
+/** @brief  Creates a binary semaphore, which is initially empty */
+#define xSemaphoreCreateBinary()                    xQueueCreateCountingSemaphore (1, 0)
+
+/** @brief  Creates a counting semaphore */
+#define xSemaphoreCreateCounting(uxMaxCount, uxInitialCount)    \
+    xQueueCreateCountingSemaphore (uxMaxCount, uxInitialCount)
+
+/** @brief  Creates a mutex, which is initially available (priority inheritance is not simulated) */
+#define xSemaphoreCreateMutex()                     xQueueCreateCountingSemaphore (1, 1)
+
+/** @brief  Takes and gives a semaphore */
+#define xSemaphoreTake(xSemaphore, xBlockTime)      xQueueReceive (xSemaphore, NULL, xBlockTime)
+#define xSemaphoreGive(xSemaphore)                  xQueueGenericSend (xSemaphore, NULL, 0, pdFALSE)
+
+/** @brief  Deletes a semaphore */
+#define vSemaphoreDelete(xSemaphore)                vQueueDelete (xSemaphore)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Creates a queue of empty items used as a semaphore */
+extern QueueHandle_t xQueueCreateCountingSemaphore (UBaseType_t x_max_count, UBaseType_t x_initial_count);
+
+#endif /* __SIM_PORT_FREERTOS_SEMPHR_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
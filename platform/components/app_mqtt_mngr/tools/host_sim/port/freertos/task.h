@@ -0,0 +1,129 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : task.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of task.h of FreeRTOS, each task is a POSIX thread (see sim_freertos.c)
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_FREERTOS_TASK_H__
+#define __SIM_PORT_FREERTOS_TASK_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS types */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Function implementing a task */
+typedef void (*TaskFunction_t) (void * pv_param);
+
+/** @brief  Handle of a task */
+typedef struct SIM_task *               TaskHandle_t;
+
+/** @brief  Control block of a statically allocated task, not used by the simulator */
+typedef struct
+{
+    void *                              pv_dummy;
+} StaticTask_t;
+
+/** @brief  States of a task */
+typedef enum
+{
+    eRunning = 0,
+    eReady,
+    eBlocked,
+    eSuspended,
+    eDeleted,
+    eInvalid
+} eTaskState;
+
+/** @brief  Status of a task returned by uxTaskGetSystemState() */
+typedef struct
+{
+    TaskHandle_t                        xHandle;                //!< Handle of the task
+    const char *                        pcTaskName;             //!< Name of the task
+    UBaseType_t                         xTaskNumber;            //!< Number assigned to the task when it was created
+    eTaskState                          eCurrentState;          //!< State of the task
+    UBaseType_t                         uxCurrentPriority;      //!< Priority of the task
+    UBaseType_t                         uxBasePriority;         //!< Base priority of the task
+    uint32_t                            ulRunTimeCounter;       //!< CPU time in microseconds used by the task
+    StackType_t *                       pxStackBase;            //!< Stack of the task
+    uint32_t                            usStackHighWaterMark;   //!< Stack size, the usage is not simulated
+    BaseType_t                          xCoreID;                //!< CPU the task is pinned to
+} TaskStatus_t;
+
+/** @brief  Creates a task that is not pinned to a CPU */
+#define xTaskCreate(pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask)  \
+    xTaskCreatePinnedToCore (pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask, tskNO_AFFINITY)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Creates a task */
+extern BaseType_t xTaskCreatePinnedToCore (TaskFunction_t pfnc_task, const char * pstri_name, uint32_t u32_stack_size,
+                                           void * pv_param, UBaseType_t x_priority, TaskHandle_t * px_task,
+                                           BaseType_t x_core_id);
+
+/* Creates a task whose stack and control block are provided by the caller */
+extern TaskHandle_t xTaskCreateStaticPinnedToCore (TaskFunction_t pfnc_task, const char * pstri_name,
+                                                   uint32_t u32_stack_size, void * pv_param, UBaseType_t x_priority,
+                                                   StackType_t * px_stack, StaticTask_t * px_task_buffer,
+                                                   BaseType_t x_core_id);
+
+/* Deletes a task, NULL for the calling task */
+extern void vTaskDelete (TaskHandle_t x_task);
+
+/* Blocks the calling task for a number of ticks */
+extern void vTaskDelay (TickType_t x_ticks);
+
+/* Gets number of ticks since the simulator started */
+extern TickType_t xTaskGetTickCount (void);
+
+/* Gets handle of the calling task */
+extern TaskHandle_t xTaskGetCurrentTaskHandle (void);
+
+/* Gets name of a task, NULL for the calling task */
+extern char * pcTaskGetName (TaskHandle_t x_task);
+
+/* Gets the minimum amount of stack space remaining of a task, which is its stack size in the simulator */
+extern UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t x_task);
+
+/* Gets number of tasks */
+extern UBaseType_t uxTaskGetNumberOfTasks (void);
+
+/* Gets status of all tasks */
+extern UBaseType_t uxTaskGetSystemState (TaskStatus_t * pastru_status, UBaseType_t x_array_size,
+                                         uint32_t * pu32_total_run_time);
+
+#endif /* __SIM_PORT_FREERTOS_TASK_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
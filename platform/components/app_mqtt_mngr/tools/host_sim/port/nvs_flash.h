@@ -0,0 +1,155 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : nvs_flash.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of nvs_flash.h of ESP-IDF, implemented by sim_nvs.c with a map in RAM
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_NVS_FLASH_H__
+#define __SIM_PORT_NVS_FLASH_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "esp_err.h"                    /* Use error codes */
+#include <stddef.h>                     /* Use size_t */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Error codes of NVS */
+#define ESP_ERR_NVS_BASE                        0x1100
+#define ESP_ERR_NVS_NOT_INITIALIZED             (ESP_ERR_NVS_BASE + 0x01)
+#define ESP_ERR_NVS_NOT_FOUND                   (ESP_ERR_NVS_BASE + 0x02)
+#define ESP_ERR_NVS_TYPE_MISMATCH               (ESP_ERR_NVS_BASE + 0x03)
+#define ESP_ERR_NVS_INVALID_HANDLE              (ESP_ERR_NVS_BASE + 0x07)
+#define ESP_ERR_NVS_NOT_ENOUGH_SPACE            (ESP_ERR_NVS_BASE + 0x05)
+#define ESP_ERR_NVS_INVALID_LENGTH              (ESP_ERR_NVS_BASE + 0x0c)
+#define ESP_ERR_NVS_NO_FREE_PAGES               (ESP_ERR_NVS_BASE + 0x0d)
+#define ESP_ERR_NVS_NEW_VERSION_FOUND           (ESP_ERR_NVS_BASE + 0x10)
+
+/** @brief  Handle of an NVS namespace */
+typedef uint32_t nvs_handle_t;
+
+/** @brief  Modes of opening an NVS namespace */
+typedef enum
+{
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+/** @brief  Types of the entries, to find entries with nvs_entry_find() */
+typedef enum
+{
+    NVS_TYPE_U8     = 0x01,
+    NVS_TYPE_I8     = 0x11,
+    NVS_TYPE_U16    = 0x02,
+    NVS_TYPE_I16    = 0x12,
+    NVS_TYPE_U32    = 0x04,
+    NVS_TYPE_I32    = 0x14,
+    NVS_TYPE_U64    = 0x08,
+    NVS_TYPE_I64    = 0x18,
+    NVS_TYPE_STR    = 0x21,
+    NVS_TYPE_BLOB   = 0x42,
+    NVS_TYPE_ANY    = 0xff,
+} nvs_type_t;
+
+/** @brief  Information about an entry */
+typedef struct
+{
+    char        namespace_name[16];     //!< Namespace of the entry
+    char        key[16];                //!< Key of the entry
+    nvs_type_t  type;                   //!< Type of the entry
+} nvs_entry_info_t;
+
+/** @brief  Iterator over the entries of a namespace */
+typedef struct nvs_opaque_iterator_t * nvs_iterator_t;
+
+/** @brief  Statistics of the NVS map, used by the simulator to count writes to flash */
+typedef struct
+{
+    uint32_t    u32_num_sets;           //!< Number of values set
+    uint32_t    u32_num_commits;        //!< Number of commits
+} SIM_nvs_stats_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Initializes and erases the NVS partition */
+extern esp_err_t nvs_flash_init (void);
+extern esp_err_t nvs_flash_erase (void);
+
+/* Opens a namespace and commits the values written to it */
+extern esp_err_t nvs_open (const char * pstri_name, nvs_open_mode_t enm_mode, nvs_handle_t * px_handle);
+extern void nvs_close (nvs_handle_t x_handle);
+extern esp_err_t nvs_commit (nvs_handle_t x_handle);
+extern esp_err_t nvs_erase_key (nvs_handle_t x_handle, const char * pstri_key);
+
+/* Opens a namespace of a given partition and erases all its entries, used by the MicroPython param module */
+extern esp_err_t nvs_open_from_partition (const char * pstri_part_name, const char * pstri_name,
+                                          nvs_open_mode_t enm_mode, nvs_handle_t * px_handle);
+extern esp_err_t nvs_erase_all (nvs_handle_t x_handle);
+
+/* Lists the entries of a namespace, not simulated: no entry is ever found */
+extern nvs_iterator_t nvs_entry_find (const char * pstri_part_name, const char * pstri_name, nvs_type_t enm_type);
+extern nvs_iterator_t nvs_entry_next (nvs_iterator_t x_iter);
+extern void nvs_entry_info (nvs_iterator_t x_iter, nvs_entry_info_t * pstru_info);
+extern void nvs_release_iterator (nvs_iterator_t x_iter);
+
+/* Gets and sets integer values */
+extern esp_err_t nvs_get_i8 (nvs_handle_t x_handle, const char * pstri_key, int8_t * ps8_value);
+extern esp_err_t nvs_get_u8 (nvs_handle_t x_handle, const char * pstri_key, uint8_t * pu8_value);
+extern esp_err_t nvs_get_i16 (nvs_handle_t x_handle, const char * pstri_key, int16_t * ps16_value);
+extern esp_err_t nvs_get_u16 (nvs_handle_t x_handle, const char * pstri_key, uint16_t * pu16_value);
+extern esp_err_t nvs_get_i32 (nvs_handle_t x_handle, const char * pstri_key, int32_t * ps32_value);
+extern esp_err_t nvs_get_u32 (nvs_handle_t x_handle, const char * pstri_key, uint32_t * pu32_value);
+extern esp_err_t nvs_get_i64 (nvs_handle_t x_handle, const char * pstri_key, int64_t * ps64_value);
+extern esp_err_t nvs_get_u64 (nvs_handle_t x_handle, const char * pstri_key, uint64_t * pu64_value);
+extern esp_err_t nvs_set_i8 (nvs_handle_t x_handle, const char * pstri_key, int8_t s8_value);
+extern esp_err_t nvs_set_u8 (nvs_handle_t x_handle, const char * pstri_key, uint8_t u8_value);
+extern esp_err_t nvs_set_i16 (nvs_handle_t x_handle, const char * pstri_key, int16_t s16_value);
+extern esp_err_t nvs_set_u16 (nvs_handle_t x_handle, const char * pstri_key, uint16_t u16_value);
+extern esp_err_t nvs_set_i32 (nvs_handle_t x_handle, const char * pstri_key, int32_t s32_value);
+extern esp_err_t nvs_set_u32 (nvs_handle_t x_handle, const char * pstri_key, uint32_t u32_value);
+extern esp_err_t nvs_set_i64 (nvs_handle_t x_handle, const char * pstri_key, int64_t s64_value);
+extern esp_err_t nvs_set_u64 (nvs_handle_t x_handle, const char * pstri_key, uint64_t u64_value);
+
+/* Gets and sets strings and blobs, getting with NULL buffer returns the length of the value */
+extern esp_err_t nvs_get_str (nvs_handle_t x_handle, const char * pstri_key, char * pstri_value, size_t * px_len);
+extern esp_err_t nvs_set_str (nvs_handle_t x_handle, const char * pstri_key, const char * pstri_value);
+extern esp_err_t nvs_get_blob (nvs_handle_t x_handle, const char * pstri_key, void * pv_value, size_t * px_len);
+extern esp_err_t nvs_set_blob (nvs_handle_t x_handle, const char * pstri_key, const void * pv_value, size_t x_len);
+
+/* Gets statistics of the NVS map */
+extern void v_SIM_Nvs_Get_Stats (SIM_nvs_stats_t * pstru_stats);
+
+#endif /* __SIM_PORT_NVS_FLASH_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
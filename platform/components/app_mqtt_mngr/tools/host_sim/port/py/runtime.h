@@ -0,0 +1,157 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : runtime.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Host stand-in of py/runtime.h of MicroPython, implemented by sim_micropy.c
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_PY_RUNTIME_H__
+#define __SIM_PORT_PY_RUNTIME_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdint.h>                     /* Standard types */
+#include <stdbool.h>                    /* Boolean type */
+#include <stddef.h>                     /* Use size_t */
+#include <stdlib.h>                     /* Use calloc() */
+#include <string.h>                     /* Use strlen() */
+#include <setjmp.h>                     /* Use setjmp() and longjmp() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Integer types of MicroPython */
+typedef intptr_t mp_int_t;
+typedef uintptr_t mp_uint_t;
+typedef uint8_t byte;
+
+/** @brief  A Python object, small integers are tagged pointers as in MicroPython */
+typedef void * mp_obj_t;
+
+/** @brief  Type of a Python object */
+typedef struct _mp_obj_type_t
+{
+    const char *    pstri_name;         //!< Name of the type
+} mp_obj_type_t;
+
+/** @brief  Buffer of a bytes-like object */
+typedef struct
+{
+    void *      buf;                    //!< Data of the object
+    size_t      len;                    //!< Length in bytes of the data
+    int         typecode;               //!< Type of the items
+} mp_buffer_info_t;
+
+/** @brief  Non-local return point, set by nlr_push() and reached by nlr_jump() */
+typedef struct _nlr_buf_t
+{
+    struct _nlr_buf_t * prev;           //!< Previous return point
+    void *              ret_val;        //!< Exception raised
+    jmp_buf             jmpbuf;         //!< Context of the return point
+} nlr_buf_t;
+
+/** @brief  Buffer access requested from mp_get_buffer_raise() */
+#define MP_BUFFER_READ                  (1)
+
+/** @brief  Small integers */
+#define mp_obj_is_small_int(o)          ((((mp_uint_t)(o)) & 1) != 0)
+#define MP_OBJ_SMALL_INT_VALUE(o)       (((mp_int_t)(o)) >> 1)
+
+/** @brief  Type checks */
+#define mp_obj_is_type(o, t)            (!mp_obj_is_small_int (o) && (*(const mp_obj_type_t **)(o) == (t)))
+#define mp_obj_is_int(o)                (mp_obj_is_small_int (o) || mp_obj_is_type (o, &mp_type_int))
+#define mp_obj_is_str(o)                mp_obj_is_type (o, &mp_type_str)
+
+/** @brief  Constant objects */
+#define mp_const_none                   ((mp_obj_t)&mp_const_none_obj)
+#define mp_const_false                  ((mp_obj_t)&mp_const_false_obj)
+#define mp_const_true                   ((mp_obj_t)&mp_const_true_obj)
+
+/** @brief  Sets a return point, evaluates to 0 when set and to 1 when an exception is raised */
+#define nlr_push(buf)                   (nlr_push_tail (buf), setjmp ((buf)->jmpbuf))
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Types of the objects */
+extern const mp_obj_type_t mp_type_int;
+extern const mp_obj_type_t mp_type_str;
+extern const mp_obj_type_t mp_type_bytes;
+extern const mp_obj_type_t mp_type_tuple;
+extern const mp_obj_type_t mp_type_OSError;
+extern const mp_obj_type_t mp_type_MemoryError;
+extern const mp_obj_type_t mp_type_TypeError;
+extern const mp_obj_type_t mp_type_ValueError;
+
+/* Constant objects */
+extern const mp_obj_type_t * const mp_const_none_obj;
+extern const mp_obj_type_t * const mp_const_false_obj;
+extern const mp_obj_type_t * const mp_const_true_obj;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Sets, removes and reaches return points */
+extern void nlr_push_tail (nlr_buf_t * px_nlr);
+extern void nlr_pop (void);
+extern void nlr_jump (void * pv_exc) __attribute__ ((noreturn));
+
+/* Raises exceptions */
+extern void mp_raise_msg (const mp_obj_type_t * px_type, const char * pstri_msg) __attribute__ ((noreturn));
+extern void mp_raise_ValueError (const char * pstri_msg) __attribute__ ((noreturn));
+extern void mp_raise_TypeError (const char * pstri_msg) __attribute__ ((noreturn));
+
+/* Creates objects */
+extern mp_obj_t mp_obj_new_int (mp_int_t x_value);
+extern mp_obj_t mp_obj_new_int_from_uint (mp_uint_t x_value);
+extern mp_obj_t mp_obj_new_int_from_ll (long long s64_value);
+extern mp_obj_t mp_obj_new_int_from_ull (unsigned long long u64_value);
+extern mp_obj_t mp_obj_new_str (const char * pstri_data, size_t x_len);
+extern mp_obj_t mp_obj_new_bytes (const byte * pu8_data, size_t x_len);
+extern mp_obj_t mp_obj_new_tuple (size_t x_len, const mp_obj_t * px_items);
+
+/* Gets values of objects, raises TypeError if the object has not the expected type */
+extern mp_int_t mp_obj_get_int (mp_obj_t x_obj);
+extern mp_uint_t mp_obj_int_get_uint_checked (mp_obj_t x_obj);
+extern const char * mp_obj_str_get_str (mp_obj_t x_obj);
+extern void mp_obj_get_array (mp_obj_t x_obj, size_t * px_len, mp_obj_t ** ppx_items);
+extern void mp_get_buffer_raise (mp_obj_t x_obj, mp_buffer_info_t * pstru_buffer, int s32_flags);
+extern bool mp_obj_equal (mp_obj_t x_obj1, mp_obj_t x_obj2);
+
+/* Gets message of an exception raised by the functions above */
+extern const char * pstri_SIM_Mp_Get_Exception_Msg (void * pv_exc);
+
+#endif /* __SIM_PORT_PY_RUNTIME_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
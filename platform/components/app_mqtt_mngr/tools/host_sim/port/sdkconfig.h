@@ -0,0 +1,83 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sdkconfig.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Configuration of the host build of App_Mqtt_Mngr, in place of the generated sdkconfig.h
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_PORT_SDKCONFIG_H__
+#define __SIM_PORT_SDKCONFIG_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** Values of the options in app/c_app/Kconfig.projbuild, each of them can be overridden from the command line of CMake
+** (e.g. -DCMAKE_C_FLAGS="-DCONFIG_MQTTMN_DOWNLOAD_WINDOW=8") to benchmark other configurations
+*/
+#ifndef CONFIG_MQTTMN_DOWNLOAD_CHUNK_SIZE
+ #define CONFIG_MQTTMN_DOWNLOAD_CHUNK_SIZE      4096
+#endif
+#ifndef CONFIG_MQTTMN_DOWNLOAD_WINDOW
+ #define CONFIG_MQTTMN_DOWNLOAD_WINDOW          4
+#endif
+#ifndef CONFIG_MQTTMN_MAX_TRANSFERS
+ #define CONFIG_MQTTMN_MAX_TRANSFERS            2
+#endif
+#ifndef CONFIG_MQTTMN_TELEMETRY_PERIOD
+ #define CONFIG_MQTTMN_TELEMETRY_PERIOD         60
+#endif
+#ifndef CONFIG_RTLOG_STORE_SEGMENT_SIZE
+ #define CONFIG_RTLOG_STORE_SEGMENT_SIZE        64
+#endif
+#ifndef CONFIG_RTLOG_STORE_NUM_SEGMENTS
+ #define CONFIG_RTLOG_STORE_NUM_SEGMENTS        16
+#endif
+
+/* FreeRTOS configuration of ESP-IDF (sdkconfig.defaults) */
+#define CONFIG_FREERTOS_HZ                      100
+#define CONFIG_FREERTOS_USE_TRACE_FACILITY      1
+#define CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS 1
+
+/* Modbus master with bus trace */
+#define CONFIG_MODBUS_ZPL_MASTER                1
+#define CONFIG_FMB_TRACE_ENABLE                 1
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#endif /* __SIM_PORT_SDKCONFIG_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
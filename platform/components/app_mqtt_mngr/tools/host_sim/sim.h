@@ -0,0 +1,94 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Interfaces between the modules of the host simulator of App_Mqtt_Mngr
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+#ifndef __SIM_SIM_H__
+#define __SIM_SIM_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdint.h>                     /* Standard types */
+#include <stdbool.h>                    /* Boolean type */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Statistics of the heap allocations made by the simulated device */
+typedef struct
+{
+    uint32_t    u32_num_allocs;         //!< Number of allocations (malloc, calloc and realloc of NULL)
+    uint32_t    u32_num_frees;          //!< Number of blocks freed
+    uint32_t    u32_cur_bytes;          //!< Number of bytes currently allocated
+    uint32_t    u32_peak_bytes;         //!< Maximum number of bytes allocated at a time
+} SIM_heap_stats_t;
+
+/** @brief  A message exchanged between the simulated device and the back-office */
+typedef struct
+{
+    char        stri_topic[128];        //!< Topic of the message
+    int32_t     s32_msg_id;             //!< Message ID given by enm_MQTT_Enqueue(), 0 for other messages
+    uint32_t    u32_len;                //!< Length in bytes of the message data
+    uint8_t     au8_data[];             //!< Data of the message, followed by a null terminator
+} SIM_msg_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Includes or excludes the allocations made by the calling thread from the statistics, returns previous setting */
+extern bool b_SIM_Heap_Set_Counted (bool b_counted);
+
+/* Gets statistics of the heap allocations made by the simulated device */
+extern void v_SIM_Heap_Get_Stats (SIM_heap_stats_t * pstru_stats);
+
+/* Gets number of times the simulated device requested a restart */
+extern uint32_t u32_SIM_Get_Num_Restarts (void);
+
+/* Formats and mounts LittleFS on a RAM block device */
+extern int8_t s8_SIM_Storage_Init (uint32_t u32_size);
+
+/* Sends a message from the back-office to the broker, which delivers it to the simulated device */
+extern int8_t s8_SIM_Mqtt_Send (const char * pstri_topic, const void * pv_data, uint32_t u32_len);
+
+/* Waits for a message published by the simulated device, the message must be freed with v_SIM_Mqtt_Free() */
+extern SIM_msg_t * pstru_SIM_Mqtt_Receive (uint32_t u32_timeout_ms);
+
+/* Frees a message returned by pstru_SIM_Mqtt_Receive() */
+extern void v_SIM_Mqtt_Free (SIM_msg_t * pstru_msg);
+
+/* Sets size of fragments in which the broker delivers messages to the simulated device, 0 for receive buffer size */
+extern void v_SIM_Mqtt_Set_Fragment_Size (uint32_t u32_size);
+
+#endif /* __SIM_SIM_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,402 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_esp.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : ESP-IDF system functions used by App_Mqtt_Mngr, simulated on the host
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sim.h"                        /* Interfaces between the modules of the simulator */
+#include "common_hdr.h"                 /* Use common definitions */
+#include "esp_err.h"                    /* Use error codes */
+#include "esp_log.h"                    /* Use logging */
+#include "esp_system.h"                 /* Use esp_restart() */
+#include "esp_timer.h"                  /* Use esp_timer_get_time() */
+#include "esp32/rom/crc.h"              /* Use crc32_le() */
+
+#include <stdio.h>                      /* Use vprintf() */
+#include <stdarg.h>                     /* Use variable arguments */
+#include <string.h>                     /* Use strcmp() */
+#include <time.h>                       /* Use clock_gettime() */
+#include <pthread.h>                    /* Use POSIX mutex */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Log level used by default, logs of App_Mqtt_Mngr would disturb the benchmark results */
+#define SIM_DEFAULT_LOG_LEVEL               ESP_LOG_WARN
+
+/** @brief  Maximum number of tags whose log level is set with esp_log_level_set() */
+#define SIM_MAX_LOG_TAGS                    8
+
+/** @brief  Maximum number of functions registered with esp_register_shutdown_handler(), as in ESP-IDF */
+#define SIM_MAX_SHUTDOWN_HANDLERS           5
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Log level of all tags */
+static esp_log_level_t g_enm_log_level = SIM_DEFAULT_LOG_LEVEL;
+
+/** @brief  Log level of specific tags */
+static struct
+{
+    const char *        pstri_tag;      //!< The tag
+    esp_log_level_t     enm_level;      //!< Log level of the tag
+} g_astru_log_tags[SIM_MAX_LOG_TAGS];
+
+/** @brief  Mutex serializing the logs of all threads */
+static pthread_mutex_t g_x_log_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief  Number of times the simulated device requested a restart */
+static uint32_t g_u32_num_restarts = 0;
+
+/** @brief  Functions called before the device restarts */
+static shutdown_handler_t g_apfnc_shutdown_handlers[SIM_MAX_SHUTDOWN_HANDLERS];
+
+/** @brief  Lookup table of CRC-32 (polynomial 0xEDB88320) */
+static uint32_t g_au32_crc_table[256];
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static esp_log_level_t enm_SIM_Get_Log_Level (const char * pstri_tag);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets time since the simulator started
+**
+** @return
+**      Time in microseconds
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int64_t esp_timer_get_time (void)
+{
+    static int64_t s64_start_us = -1;
+
+    struct timespec stru_now;
+    clock_gettime (CLOCK_MONOTONIC, &stru_now);
+    int64_t s64_now_us = (int64_t)stru_now.tv_sec * 1000000 + stru_now.tv_nsec / 1000;
+    if (s64_start_us < 0)
+    {
+        s64_start_us = s64_now_us;
+    }
+    return s64_now_us - s64_start_us;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Updates CRC-32 of data the same way as the ROM function of ESP32 does, hence the CRC of data split into
+**      multiple blocks is calculated by chaining the calls: crc32_le (crc32_le (0, block_1), block_2)...
+**
+** @param [in]
+**      u32_crc: CRC of the previous blocks, 0 for the first block
+**
+** @param [in]
+**      pu8_buf: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @return
+**      CRC of the previous blocks and the data
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t crc32_le (uint32_t u32_crc, const uint8_t * pu8_buf, uint32_t u32_len)
+{
+    /* Build the lookup table the first time */
+    if (g_au32_crc_table[1] == 0)
+    {
+        for (uint32_t u32_idx = 0; u32_idx < 256; u32_idx++)
+        {
+            uint32_t u32_value = u32_idx;
+            for (uint8_t u8_bit = 0; u8_bit < 8; u8_bit++)
+            {
+                u32_value = (u32_value & 1) ? ((u32_value >> 1) ^ 0xEDB88320) : (u32_value >> 1);
+            }
+            g_au32_crc_table[u32_idx] = u32_value;
+        }
+    }
+
+    u32_crc = ~u32_crc;
+    for (uint32_t u32_idx = 0; u32_idx < u32_len; u32_idx++)
+    {
+        u32_crc = g_au32_crc_table[(u32_crc ^ pu8_buf[u32_idx]) & 0xFF] ^ (u32_crc >> 8);
+    }
+    return ~u32_crc;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Registers a function called before the device restarts
+**
+** @param [in]
+**      pfnc_handler: The function
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NO_MEM: Too many functions are registered
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t esp_register_shutdown_handler (shutdown_handler_t pfnc_handler)
+{
+    for (uint8_t u8_idx = 0; u8_idx < SIM_MAX_SHUTDOWN_HANDLERS; u8_idx++)
+    {
+        if (g_apfnc_shutdown_handlers[u8_idx] == NULL)
+        {
+            g_apfnc_shutdown_handlers[u8_idx] = pfnc_handler;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_NO_MEM;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Restarts the device. The simulator calls the shutdown handlers, then only records the request, so that the
+**      back-office can check it.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void esp_restart (void)
+{
+    for (uint8_t u8_idx = 0; (u8_idx < SIM_MAX_SHUTDOWN_HANDLERS) && (g_apfnc_shutdown_handlers[u8_idx] != NULL);
+         u8_idx++)
+    {
+        g_apfnc_shutdown_handlers[u8_idx] ();
+    }
+    __atomic_add_fetch (&g_u32_num_restarts, 1, __ATOMIC_SEQ_CST);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of times the simulated device requested a restart
+**
+** @return
+**      Number of restart requests
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_SIM_Get_Num_Restarts (void)
+{
+    return __atomic_load_n (&g_u32_num_restarts, __ATOMIC_SEQ_CST);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets name of an error code
+**
+** @param [in]
+**      x_err: The error code
+**
+** @return
+**      Name of the error code
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+const char * esp_err_to_name (esp_err_t x_err)
+{
+    switch (x_err)
+    {
+        case ESP_OK:                return "ESP_OK";
+        case ESP_FAIL:              return "ESP_FAIL";
+        case ESP_ERR_NO_MEM:        return "ESP_ERR_NO_MEM";
+        case ESP_ERR_INVALID_ARG:   return "ESP_ERR_INVALID_ARG";
+        case ESP_ERR_INVALID_SIZE:  return "ESP_ERR_INVALID_SIZE";
+        case ESP_ERR_NOT_FOUND:     return "ESP_ERR_NOT_FOUND";
+        case ESP_ERR_NOT_SUPPORTED: return "ESP_ERR_NOT_SUPPORTED";
+        default:                    return "UNKNOWN ERROR";
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets the maximum level of the logs displayed
+**
+** @param [in]
+**      pstri_tag: Tag of the logs, "*" for all tags. The string must be static.
+**
+** @param [in]
+**      enm_level: The maximum level
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void esp_log_level_set (const char * pstri_tag, esp_log_level_t enm_level)
+{
+    pthread_mutex_lock (&g_x_log_mutex);
+    if (strcmp (pstri_tag, "*") == 0)
+    {
+        g_enm_log_level = enm_level;
+        memset (g_astru_log_tags, 0, sizeof (g_astru_log_tags));
+    }
+    else
+    {
+        for (uint8_t u8_idx = 0; u8_idx < SIM_MAX_LOG_TAGS; u8_idx++)
+        {
+            if ((g_astru_log_tags[u8_idx].pstri_tag == NULL) ||
+                (strcmp (g_astru_log_tags[u8_idx].pstri_tag, pstri_tag) == 0))
+            {
+                g_astru_log_tags[u8_idx].pstri_tag = pstri_tag;
+                g_astru_log_tags[u8_idx].enm_level = enm_level;
+                break;
+            }
+        }
+    }
+    pthread_mutex_unlock (&g_x_log_mutex);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Displays a log message in the same format as ESP-IDF does
+**
+** @param [in]
+**      enm_level: Level of the message
+**
+** @param [in]
+**      pstri_letter: Letter of the level
+**
+** @param [in]
+**      pstri_tag: Tag of the module logging the message
+**
+** @param [in]
+**      pstri_format: Format string of the message, followed by the arguments
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Log (esp_log_level_t enm_level, const char * pstri_letter, const char * pstri_tag,
+                const char * pstri_format, ...)
+{
+    pthread_mutex_lock (&g_x_log_mutex);
+    if (enm_level <= enm_SIM_Get_Log_Level (pstri_tag))
+    {
+        /* The buffers of stdio are not allocations of the simulated device */
+        bool b_counted = b_SIM_Heap_Set_Counted (false);
+
+        va_list x_args;
+        va_start (x_args, pstri_format);
+        printf ("%s (%u) %s: ", pstri_letter, (unsigned)(esp_timer_get_time () / 1000), pstri_tag);
+        vprintf (pstri_format, x_args);
+        printf ("\n");
+        va_end (x_args);
+
+        b_SIM_Heap_Set_Counted (b_counted);
+    }
+    pthread_mutex_unlock (&g_x_log_mutex);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Displays a buffer in hexadecimal, 16 bytes per line
+**
+** @param [in]
+**      pstri_tag: Tag of the module logging the buffer
+**
+** @param [in]
+**      pv_buffer: The buffer
+**
+** @param [in]
+**      u16_len: Length in bytes of the buffer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Log_Hex (const char * pstri_tag, const void * pv_buffer, uint16_t u16_len)
+{
+    const uint8_t * pu8_buffer = pv_buffer;
+    for (uint16_t u16_line = 0; u16_line < u16_len; u16_line += 16)
+    {
+        char stri_line[16 * 3 + 1];
+        uint16_t u16_pos = 0;
+        for (uint16_t u16_idx = u16_line; (u16_idx < u16_len) && (u16_idx < u16_line + 16); u16_idx++)
+        {
+            u16_pos += snprintf (&stri_line[u16_pos], sizeof (stri_line) - u16_pos, "%02x ", pu8_buffer[u16_idx]);
+        }
+        v_SIM_Log (ESP_LOG_INFO, "I", pstri_tag, "%s", stri_line);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the maximum level of the logs displayed for a tag, the caller must hold the log mutex
+**
+** @param [in]
+**      pstri_tag: The tag
+**
+** @return
+**      The maximum level
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static esp_log_level_t enm_SIM_Get_Log_Level (const char * pstri_tag)
+{
+    for (uint8_t u8_idx = 0; (u8_idx < SIM_MAX_LOG_TAGS) && (g_astru_log_tags[u8_idx].pstri_tag != NULL); u8_idx++)
+    {
+        if (strcmp (g_astru_log_tags[u8_idx].pstri_tag, pstri_tag) == 0)
+        {
+            return g_astru_log_tags[u8_idx].enm_level;
+        }
+    }
+    return g_enm_log_level;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
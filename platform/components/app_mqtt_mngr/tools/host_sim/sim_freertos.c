@@ -0,0 +1,1039 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_freertos.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : FreeRTOS API used by App_Mqtt_Mngr, simulated on POSIX threads
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "common_hdr.h"                 /* Use common definitions */
+#include "freertos/task.h"              /* Use FreeRTOS task */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
+#include "freertos/semphr.h"            /* Use FreeRTOS semaphore */
+#include "freertos/event_groups.h"      /* Use FreeRTOS event group */
+#include "esp_timer.h"                  /* Use esp_timer_get_time() */
+
+#include <pthread.h>                    /* Use POSIX threads */
+#include <stdio.h>                      /* Use snprintf() */
+#include <string.h>                     /* Use memcpy(), memset() */
+#include <time.h>                       /* Use clock_gettime() */
+#include <errno.h>                      /* Use ETIMEDOUT */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Maximum number of tasks, including the threads not created by xTaskCreate...() that call the API */
+#define SIM_MAX_TASKS                       16
+
+/** @brief  Maximum length of the name of a task */
+#define SIM_TASK_NAME_LEN                   16
+
+/** @brief  Structure wrapping a task, which is a POSIX thread */
+struct SIM_task
+{
+    bool                b_used;                         //!< The structure is used by a task
+    pthread_t           x_thread;                       //!< The thread running the task
+    char                stri_name[SIM_TASK_NAME_LEN];   //!< Name of the task
+    TaskFunction_t      pfnc_task;                      //!< Function implementing the task
+    void *              pv_param;                       //!< Parameter passed into the task
+    uint32_t            u32_stack_size;                 //!< Stack size in bytes
+    UBaseType_t         x_priority;                     //!< Priority of the task
+    BaseType_t          x_core_id;                      //!< CPU the task is pinned to
+    UBaseType_t         x_number;                       //!< Number assigned to the task when it was created
+};
+
+/** @brief  Structure wrapping a queue, items are copied into a ring buffer */
+struct SIM_queue
+{
+    pthread_mutex_t     x_mutex;                        //!< Mutex protecting the queue
+    pthread_cond_t      x_cond_not_empty;               //!< Signaled when an item is sent
+    pthread_cond_t      x_cond_not_full;                //!< Signaled when an item is received
+    UBaseType_t         x_length;                       //!< Maximum number of items
+    UBaseType_t         x_item_size;                    //!< Size in bytes of an item, 0 for semaphores
+    UBaseType_t         x_count;                        //!< Number of items in the queue
+    UBaseType_t         x_head;                         //!< Index of the first item
+    uint8_t *           pu8_items;                      //!< Ring buffer of the items
+};
+
+/** @brief  Structure wrapping an event group */
+struct SIM_event_group
+{
+    pthread_mutex_t     x_mutex;                        //!< Mutex protecting the event group
+    pthread_cond_t      x_cond;                         //!< Signaled when bits are set
+    EventBits_t         x_bits;                         //!< Bits of the event group
+};
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+static const char * TAG = "Sim_FreeRTOS";
+
+/** @brief  All tasks */
+static struct SIM_task g_astru_tasks[SIM_MAX_TASKS];
+
+/** @brief  Number of tasks created so far */
+static UBaseType_t g_x_num_created = 0;
+
+/** @brief  Mutex protecting the tasks */
+static pthread_mutex_t g_x_task_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief  Task run by the calling thread */
+static __thread struct SIM_task * g_pstru_current_task = NULL;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static struct SIM_task * pstru_SIM_Alloc_Task (const char * pstri_name, uint32_t u32_stack_size,
+                                               UBaseType_t x_priority, BaseType_t x_core_id);
+static void * pv_SIM_Task_Entry (void * pv_arg);
+static void v_SIM_Init_Cond (pthread_cond_t * px_cond);
+static bool b_SIM_Get_Deadline (TickType_t x_ticks, struct timespec * pstru_deadline);
+static int s_SIM_Cond_Wait (pthread_cond_t * px_cond, pthread_mutex_t * px_mutex, TickType_t x_ticks,
+                            const struct timespec * pstru_deadline);
+static uint32_t u32_SIM_Get_Cpu_Time (const struct SIM_task * pstru_task);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a task, which runs in a new POSIX thread
+**
+** @note
+**      Priorities are recorded but not enforced, all tasks run concurrently as on the two CPUs of ESP32
+**
+** @param [in]
+**      pfnc_task: Function implementing the task
+**
+** @param [in]
+**      pstri_name: Name of the task
+**
+** @param [in]
+**      u32_stack_size: Stack size in bytes
+**
+** @param [in]
+**      pv_param: Parameter passed into the task
+**
+** @param [in]
+**      x_priority: Priority of the task
+**
+** @param [out]
+**      px_task: Handle of the created task, can be NULL
+**
+** @param [in]
+**      x_core_id: CPU the task is pinned to
+**
+** @return
+**      @arg    pdPASS
+**      @arg    pdFAIL
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BaseType_t xTaskCreatePinnedToCore (TaskFunction_t pfnc_task, const char * pstri_name, uint32_t u32_stack_size,
+                                    void * pv_param, UBaseType_t x_priority, TaskHandle_t * px_task,
+                                    BaseType_t x_core_id)
+{
+    /* Allocate the task */
+    struct SIM_task * pstru_task = pstru_SIM_Alloc_Task (pstri_name, u32_stack_size, x_priority, x_core_id);
+    if (pstru_task == NULL)
+    {
+        LOGE ("Too many tasks, failed to create task %s", pstri_name);
+        return pdFAIL;
+    }
+    pstru_task->pfnc_task = pfnc_task;
+    pstru_task->pv_param = pv_param;
+
+    /* Start the thread running the task */
+    pthread_attr_t x_attr;
+    pthread_attr_init (&x_attr);
+    pthread_attr_setdetachstate (&x_attr, PTHREAD_CREATE_DETACHED);
+    int s_result = pthread_create (&pstru_task->x_thread, &x_attr, pv_SIM_Task_Entry, pstru_task);
+    pthread_attr_destroy (&x_attr);
+    if (s_result != 0)
+    {
+        LOGE ("Failed to create thread of task %s", pstri_name);
+        pstru_task->b_used = false;
+        return pdFAIL;
+    }
+
+    if (px_task != NULL)
+    {
+        *px_task = pstru_task;
+    }
+    return pdPASS;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a task whose stack and control block are provided by the caller. The thread running the task has its
+**      own stack, the buffers provided are not used.
+**
+** @return
+**      @arg    NULL: Failed to create the task
+**      @arg    Otherwise: Handle of the created task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+TaskHandle_t xTaskCreateStaticPinnedToCore (TaskFunction_t pfnc_task, const char * pstri_name,
+                                            uint32_t u32_stack_size, void * pv_param, UBaseType_t x_priority,
+                                            StackType_t * px_stack, StaticTask_t * px_task_buffer,
+                                            BaseType_t x_core_id)
+{
+    TaskHandle_t x_task = NULL;
+    xTaskCreatePinnedToCore (pfnc_task, pstri_name, u32_stack_size, pv_param, x_priority, &x_task, x_core_id);
+    return x_task;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Deletes a task. Only the calling task can be deleted, a thread can't be stopped by another one.
+**
+** @param [in]
+**      x_task: The task, NULL for the calling task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void vTaskDelete (TaskHandle_t x_task)
+{
+    struct SIM_task * pstru_current = xTaskGetCurrentTaskHandle ();
+    ASSERT_PARAM ((x_task == NULL) || (x_task == pstru_current));
+
+    pthread_mutex_lock (&g_x_task_mutex);
+    pstru_current->b_used = false;
+    pthread_mutex_unlock (&g_x_task_mutex);
+    pthread_exit (NULL);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Blocks the calling task for a number of ticks
+**
+** @param [in]
+**      x_ticks: Number of ticks
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void vTaskDelay (TickType_t x_ticks)
+{
+    uint64_t u64_ns = (uint64_t)x_ticks * portTICK_PERIOD_MS * 1000000ULL;
+    struct timespec stru_delay =
+    {
+        .tv_sec = u64_ns / 1000000000ULL,
+        .tv_nsec = u64_ns % 1000000000ULL,
+    };
+    while (nanosleep (&stru_delay, &stru_delay) != 0)
+    {
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of ticks since the simulator started
+**
+** @return
+**      Number of ticks
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+TickType_t xTaskGetTickCount (void)
+{
+    return (TickType_t)(esp_timer_get_time () / (portTICK_PERIOD_MS * 1000));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets handle of the calling task. A thread that is not created by xTaskCreate...() (e.g. the main thread) is
+**      registered as a task the first time it calls this function.
+**
+** @return
+**      Handle of the calling task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+TaskHandle_t xTaskGetCurrentTaskHandle (void)
+{
+    if (g_pstru_current_task == NULL)
+    {
+        g_pstru_current_task = pstru_SIM_Alloc_Task ("main", 0, tskIDLE_PRIORITY, 0);
+        ASSERT_PARAM (g_pstru_current_task != NULL);
+        g_pstru_current_task->x_thread = pthread_self ();
+    }
+    return g_pstru_current_task;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets name of a task
+**
+** @param [in]
+**      x_task: The task, NULL for the calling task
+**
+** @return
+**      Name of the task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+char * pcTaskGetName (TaskHandle_t x_task)
+{
+    return (x_task != NULL) ? x_task->stri_name : xTaskGetCurrentTaskHandle ()->stri_name;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the minimum amount of stack space remaining of a task. The stack usage is not simulated, the stack size of
+**      the task is returned.
+**
+** @param [in]
+**      x_task: The task, NULL for the calling task
+**
+** @return
+**      Stack size in bytes of the task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+UBaseType_t uxTaskGetStackHighWaterMark (TaskHandle_t x_task)
+{
+    return (x_task != NULL) ? x_task->u32_stack_size : xTaskGetCurrentTaskHandle ()->u32_stack_size;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of tasks
+**
+** @return
+**      Number of tasks
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+UBaseType_t uxTaskGetNumberOfTasks (void)
+{
+    UBaseType_t x_num_tasks = 0;
+
+    pthread_mutex_lock (&g_x_task_mutex);
+    for (uint8_t u8_idx = 0; u8_idx < SIM_MAX_TASKS; u8_idx++)
+    {
+        if (g_astru_tasks[u8_idx].b_used)
+        {
+            x_num_tasks++;
+        }
+    }
+    pthread_mutex_unlock (&g_x_task_mutex);
+
+    return x_num_tasks;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets status of all tasks. The run time of a task is the CPU time in microseconds used by its thread, the total
+**      run time is the time since the simulator started.
+**
+** @param [out]
+**      pastru_status: Array receiving status of the tasks
+**
+** @param [in]
+**      x_array_size: Number of elements of the array
+**
+** @param [out]
+**      pu32_total_run_time: Total run time, can be NULL
+**
+** @return
+**      Number of tasks whose status is returned, 0 if the array is too small
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+UBaseType_t uxTaskGetSystemState (TaskStatus_t * pastru_status, UBaseType_t x_array_size,
+                                  uint32_t * pu32_total_run_time)
+{
+    UBaseType_t x_num_tasks = 0;
+
+    pthread_mutex_lock (&g_x_task_mutex);
+    for (uint8_t u8_idx = 0; u8_idx < SIM_MAX_TASKS; u8_idx++)
+    {
+        struct SIM_task * pstru_task = &g_astru_tasks[u8_idx];
+        if (!pstru_task->b_used)
+        {
+            continue;
+        }
+        if (x_num_tasks == x_array_size)
+        {
+            x_num_tasks = 0;
+            break;
+        }
+
+        TaskStatus_t * pstru_status = &pastru_status[x_num_tasks++];
+        pstru_status->xHandle = pstru_task;
+        pstru_status->pcTaskName = pstru_task->stri_name;
+        pstru_status->xTaskNumber = pstru_task->x_number;
+        pstru_status->eCurrentState = (pstru_task == g_pstru_current_task) ? eRunning : eBlocked;
+        pstru_status->uxCurrentPriority = pstru_task->x_priority;
+        pstru_status->uxBasePriority = pstru_task->x_priority;
+        pstru_status->ulRunTimeCounter = u32_SIM_Get_Cpu_Time (pstru_task);
+        pstru_status->pxStackBase = NULL;
+        pstru_status->usStackHighWaterMark = pstru_task->u32_stack_size;
+        pstru_status->xCoreID = pstru_task->x_core_id;
+    }
+    pthread_mutex_unlock (&g_x_task_mutex);
+
+    if (pu32_total_run_time != NULL)
+    {
+        *pu32_total_run_time = (uint32_t)esp_timer_get_time ();
+    }
+    return x_num_tasks;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets ID of the CPU running the calling task
+**
+** @return
+**      The CPU the calling task is pinned to, 0 if it is not pinned
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BaseType_t xPortGetCoreID (void)
+{
+    BaseType_t x_core_id = xTaskGetCurrentTaskHandle ()->x_core_id;
+    return (x_core_id == tskNO_AFFINITY) ? 0 : x_core_id;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a queue
+**
+** @param [in]
+**      x_length: Maximum number of items
+**
+** @param [in]
+**      x_item_size: Size in bytes of an item
+**
+** @return
+**      @arg    NULL: Failed to create the queue
+**      @arg    Otherwise: Handle of the queue
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+QueueHandle_t xQueueCreate (UBaseType_t x_length, UBaseType_t x_item_size)
+{
+    struct SIM_queue * pstru_queue = calloc (1, sizeof (struct SIM_queue) + x_length * x_item_size);
+    if (pstru_queue == NULL)
+    {
+        return NULL;
+    }
+
+    pthread_mutex_init (&pstru_queue->x_mutex, NULL);
+    v_SIM_Init_Cond (&pstru_queue->x_cond_not_empty);
+    v_SIM_Init_Cond (&pstru_queue->x_cond_not_full);
+    pstru_queue->x_length = x_length;
+    pstru_queue->x_item_size = x_item_size;
+    pstru_queue->pu8_items = (uint8_t *)(pstru_queue + 1);
+    return pstru_queue;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a queue of empty items used as a semaphore
+**
+** @param [in]
+**      x_max_count: Maximum count of the semaphore
+**
+** @param [in]
+**      x_initial_count: Initial count of the semaphore
+**
+** @return
+**      @arg    NULL: Failed to create the semaphore
+**      @arg    Otherwise: Handle of the semaphore
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+QueueHandle_t xQueueCreateCountingSemaphore (UBaseType_t x_max_count, UBaseType_t x_initial_count)
+{
+    QueueHandle_t x_queue = xQueueCreate (x_max_count, 0);
+    if (x_queue != NULL)
+    {
+        x_queue->x_count = x_initial_count;
+    }
+    return x_queue;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Deletes a queue, no task shall be waiting on it
+**
+** @param [in]
+**      x_queue: The queue
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void vQueueDelete (QueueHandle_t x_queue)
+{
+    pthread_mutex_destroy (&x_queue->x_mutex);
+    pthread_cond_destroy (&x_queue->x_cond_not_empty);
+    pthread_cond_destroy (&x_queue->x_cond_not_full);
+    free (x_queue);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends an item to a queue
+**
+** @param [in]
+**      x_queue: The queue
+**
+** @param [in]
+**      pv_item: The item, which is copied into the queue (NULL for semaphores)
+**
+** @param [in]
+**      x_ticks_to_wait: Maximum number of ticks to wait for space in the queue
+**
+** @param [in]
+**      x_to_front: pdTRUE to send the item to the front of the queue
+**
+** @return
+**      @arg    pdPASS: The item has been sent
+**      @arg    pdFAIL: The queue is full
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BaseType_t xQueueGenericSend (QueueHandle_t x_queue, const void * pv_item, TickType_t x_ticks_to_wait,
+                              BaseType_t x_to_front)
+{
+    struct timespec stru_deadline;
+    b_SIM_Get_Deadline (x_ticks_to_wait, &stru_deadline);
+
+    pthread_mutex_lock (&x_queue->x_mutex);
+    while (x_queue->x_count == x_queue->x_length)
+    {
+        if (s_SIM_Cond_Wait (&x_queue->x_cond_not_full, &x_queue->x_mutex, x_ticks_to_wait, &stru_deadline) != 0)
+        {
+            pthread_mutex_unlock (&x_queue->x_mutex);
+            return pdFAIL;
+        }
+    }
+
+    /* Copy the item into the ring buffer */
+    UBaseType_t x_idx;
+    if (x_to_front)
+    {
+        x_queue->x_head = (x_queue->x_head + x_queue->x_length - 1) % x_queue->x_length;
+        x_idx = x_queue->x_head;
+    }
+    else
+    {
+        x_idx = (x_queue->x_head + x_queue->x_count) % x_queue->x_length;
+    }
+    if (x_queue->x_item_size != 0)
+    {
+        memcpy (&x_queue->pu8_items[x_idx * x_queue->x_item_size], pv_item, x_queue->x_item_size);
+    }
+    x_queue->x_count++;
+
+    pthread_cond_signal (&x_queue->x_cond_not_empty);
+    pthread_mutex_unlock (&x_queue->x_mutex);
+    return pdPASS;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Receives an item from a queue
+**
+** @param [in]
+**      x_queue: The queue
+**
+** @param [out]
+**      pv_item: Buffer receiving the item (NULL for semaphores)
+**
+** @param [in]
+**      x_ticks_to_wait: Maximum number of ticks to wait for an item
+**
+** @return
+**      @arg    pdPASS: An item has been received
+**      @arg    pdFAIL: The queue is empty
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BaseType_t xQueueReceive (QueueHandle_t x_queue, void * pv_item, TickType_t x_ticks_to_wait)
+{
+    struct timespec stru_deadline;
+    b_SIM_Get_Deadline (x_ticks_to_wait, &stru_deadline);
+
+    pthread_mutex_lock (&x_queue->x_mutex);
+    while (x_queue->x_count == 0)
+    {
+        if (s_SIM_Cond_Wait (&x_queue->x_cond_not_empty, &x_queue->x_mutex, x_ticks_to_wait, &stru_deadline) != 0)
+        {
+            pthread_mutex_unlock (&x_queue->x_mutex);
+            return pdFAIL;
+        }
+    }
+
+    /* Copy the first item out of the ring buffer */
+    if (x_queue->x_item_size != 0)
+    {
+        memcpy (pv_item, &x_queue->pu8_items[x_queue->x_head * x_queue->x_item_size], x_queue->x_item_size);
+    }
+    x_queue->x_head = (x_queue->x_head + 1) % x_queue->x_length;
+    x_queue->x_count--;
+
+    pthread_cond_signal (&x_queue->x_cond_not_full);
+    pthread_mutex_unlock (&x_queue->x_mutex);
+    return pdPASS;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Copies the first item of a queue without removing it
+**
+** @param [in]
+**      x_queue: The queue
+**
+** @param [out]
+**      pv_item: Buffer receiving the item (NULL for semaphores)
+**
+** @param [in]
+**      x_ticks_to_wait: Maximum number of ticks to wait for an item
+**
+** @return
+**      @arg    pdPASS: An item has been copied
+**      @arg    pdFAIL: The queue is empty
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BaseType_t xQueuePeek (QueueHandle_t x_queue, void * pv_item, TickType_t x_ticks_to_wait)
+{
+    struct timespec stru_deadline;
+    b_SIM_Get_Deadline (x_ticks_to_wait, &stru_deadline);
+
+    pthread_mutex_lock (&x_queue->x_mutex);
+    while (x_queue->x_count == 0)
+    {
+        if (s_SIM_Cond_Wait (&x_queue->x_cond_not_empty, &x_queue->x_mutex, x_ticks_to_wait, &stru_deadline) != 0)
+        {
+            pthread_mutex_unlock (&x_queue->x_mutex);
+            return pdFAIL;
+        }
+    }
+
+    /* Copy the first item, it stays in the queue for other receivers */
+    if (x_queue->x_item_size != 0)
+    {
+        memcpy (pv_item, &x_queue->pu8_items[x_queue->x_head * x_queue->x_item_size], x_queue->x_item_size);
+    }
+    pthread_cond_signal (&x_queue->x_cond_not_empty);
+    pthread_mutex_unlock (&x_queue->x_mutex);
+    return pdPASS;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of items in a queue
+**
+** @param [in]
+**      x_queue: The queue
+**
+** @return
+**      Number of items
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+UBaseType_t uxQueueMessagesWaiting (QueueHandle_t x_queue)
+{
+    pthread_mutex_lock (&x_queue->x_mutex);
+    UBaseType_t x_count = x_queue->x_count;
+    pthread_mutex_unlock (&x_queue->x_mutex);
+    return x_count;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates an event group
+**
+** @return
+**      @arg    NULL: Failed to create the event group
+**      @arg    Otherwise: Handle of the event group
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+EventGroupHandle_t xEventGroupCreate (void)
+{
+    struct SIM_event_group * pstru_group = calloc (1, sizeof (struct SIM_event_group));
+    if (pstru_group != NULL)
+    {
+        pthread_mutex_init (&pstru_group->x_mutex, NULL);
+        v_SIM_Init_Cond (&pstru_group->x_cond);
+    }
+    return pstru_group;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets bits of an event group
+**
+** @param [in]
+**      x_event_group: The event group
+**
+** @param [in]
+**      x_bits: The bits to set
+**
+** @return
+**      Bits of the event group after the bits are set
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+EventBits_t xEventGroupSetBits (EventGroupHandle_t x_event_group, EventBits_t x_bits)
+{
+    pthread_mutex_lock (&x_event_group->x_mutex);
+    x_event_group->x_bits |= x_bits;
+    EventBits_t x_result = x_event_group->x_bits;
+    pthread_cond_broadcast (&x_event_group->x_cond);
+    pthread_mutex_unlock (&x_event_group->x_mutex);
+    return x_result;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Clears bits of an event group
+**
+** @param [in]
+**      x_event_group: The event group
+**
+** @param [in]
+**      x_bits: The bits to clear
+**
+** @return
+**      Bits of the event group before the bits are cleared
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+EventBits_t xEventGroupClearBits (EventGroupHandle_t x_event_group, EventBits_t x_bits)
+{
+    pthread_mutex_lock (&x_event_group->x_mutex);
+    EventBits_t x_result = x_event_group->x_bits;
+    x_event_group->x_bits &= ~x_bits;
+    pthread_mutex_unlock (&x_event_group->x_mutex);
+    return x_result;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets bits of an event group
+**
+** @param [in]
+**      x_event_group: The event group
+**
+** @return
+**      Bits of the event group
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+EventBits_t xEventGroupGetBits (EventGroupHandle_t x_event_group)
+{
+    pthread_mutex_lock (&x_event_group->x_mutex);
+    EventBits_t x_result = x_event_group->x_bits;
+    pthread_mutex_unlock (&x_event_group->x_mutex);
+    return x_result;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for any or all of some bits of an event group to be set
+**
+** @param [in]
+**      x_event_group: The event group
+**
+** @param [in]
+**      x_bits: The bits to wait for
+**
+** @param [in]
+**      x_clear_on_exit: pdTRUE to clear the bits waited for when the wait is satisfied
+**
+** @param [in]
+**      x_wait_for_all: pdTRUE to wait for all the bits, pdFALSE to wait for any of them
+**
+** @param [in]
+**      x_ticks_to_wait: Maximum number of ticks to wait
+**
+** @return
+**      Bits of the event group when the wait is satisfied or timed out, before the bits are cleared
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+EventBits_t xEventGroupWaitBits (EventGroupHandle_t x_event_group, EventBits_t x_bits,
+                                 BaseType_t x_clear_on_exit, BaseType_t x_wait_for_all,
+                                 TickType_t x_ticks_to_wait)
+{
+    struct timespec stru_deadline;
+    b_SIM_Get_Deadline (x_ticks_to_wait, &stru_deadline);
+
+    pthread_mutex_lock (&x_event_group->x_mutex);
+    while (true)
+    {
+        EventBits_t x_set_bits = x_event_group->x_bits & x_bits;
+        if (x_wait_for_all ? (x_set_bits == x_bits) : (x_set_bits != 0))
+        {
+            EventBits_t x_result = x_event_group->x_bits;
+            if (x_clear_on_exit)
+            {
+                x_event_group->x_bits &= ~x_bits;
+            }
+            pthread_mutex_unlock (&x_event_group->x_mutex);
+            return x_result;
+        }
+        if (s_SIM_Cond_Wait (&x_event_group->x_cond, &x_event_group->x_mutex, x_ticks_to_wait, &stru_deadline) != 0)
+        {
+            EventBits_t x_result = x_event_group->x_bits;
+            pthread_mutex_unlock (&x_event_group->x_mutex);
+            return x_result;
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates the structure of a new task
+**
+** @return
+**      @arg    NULL: Too many tasks
+**      @arg    Otherwise: The structure of the task
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static struct SIM_task * pstru_SIM_Alloc_Task (const char * pstri_name, uint32_t u32_stack_size,
+                                               UBaseType_t x_priority, BaseType_t x_core_id)
+{
+    struct SIM_task * pstru_task = NULL;
+
+    pthread_mutex_lock (&g_x_task_mutex);
+    for (uint8_t u8_idx = 0; u8_idx < SIM_MAX_TASKS; u8_idx++)
+    {
+        if (!g_astru_tasks[u8_idx].b_used)
+        {
+            pstru_task = &g_astru_tasks[u8_idx];
+            memset (pstru_task, 0, sizeof (struct SIM_task));
+            pstru_task->b_used = true;
+            snprintf (pstru_task->stri_name, sizeof (pstru_task->stri_name), "%s", pstri_name);
+            pstru_task->u32_stack_size = u32_stack_size;
+            pstru_task->x_priority = x_priority;
+            pstru_task->x_core_id = x_core_id;
+            pstru_task->x_number = ++g_x_num_created;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&g_x_task_mutex);
+
+    return pstru_task;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Entry of the thread running a task
+**
+** @param [in]
+**      pv_arg: The task
+**
+** @return
+**      NULL
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void * pv_SIM_Task_Entry (void * pv_arg)
+{
+    struct SIM_task * pstru_task = pv_arg;
+
+    /* Tasks of FreeRTOS never return, a task returning is deleted as it would crash on ESP32 */
+    g_pstru_current_task = pstru_task;
+    pstru_task->pfnc_task (pstru_task->pv_param);
+    LOGE ("Task %s returned", pstru_task->stri_name);
+    vTaskDelete (NULL);
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Initializes a condition variable measuring timeouts with the monotonic clock
+**
+** @param [out]
+**      px_cond: The condition variable
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Init_Cond (pthread_cond_t * px_cond)
+{
+    pthread_condattr_t x_attr;
+    pthread_condattr_init (&x_attr);
+    pthread_condattr_setclock (&x_attr, CLOCK_MONOTONIC);
+    pthread_cond_init (px_cond, &x_attr);
+    pthread_condattr_destroy (&x_attr);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the time at which a wait of a number of ticks ends
+**
+** @param [in]
+**      x_ticks: Number of ticks, portMAX_DELAY to wait forever
+**
+** @param [out]
+**      pstru_deadline: Time at which the wait ends (monotonic clock)
+**
+** @return
+**      @arg    true: The wait has a deadline
+**      @arg    false: The wait is endless
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Get_Deadline (TickType_t x_ticks, struct timespec * pstru_deadline)
+{
+    if (x_ticks == portMAX_DELAY)
+    {
+        return false;
+    }
+
+    clock_gettime (CLOCK_MONOTONIC, pstru_deadline);
+    uint64_t u64_ns = (uint64_t)x_ticks * portTICK_PERIOD_MS * 1000000ULL + pstru_deadline->tv_nsec;
+    pstru_deadline->tv_sec += u64_ns / 1000000000ULL;
+    pstru_deadline->tv_nsec = u64_ns % 1000000000ULL;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a condition variable to be signaled
+**
+** @return
+**      @arg    0: The condition variable has been signaled
+**      @arg    ETIMEDOUT: The wait timed out, or the number of ticks is 0
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Cond_Wait (pthread_cond_t * px_cond, pthread_mutex_t * px_mutex, TickType_t x_ticks,
+                            const struct timespec * pstru_deadline)
+{
+    if (x_ticks == 0)
+    {
+        return ETIMEDOUT;
+    }
+    if (x_ticks == portMAX_DELAY)
+    {
+        return pthread_cond_wait (px_cond, px_mutex);
+    }
+    return pthread_cond_timedwait (px_cond, px_mutex, pstru_deadline);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets CPU time used by the thread of a task
+**
+** @param [in]
+**      pstru_task: The task
+**
+** @return
+**      CPU time in microseconds, 0 if it can't be read
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint32_t u32_SIM_Get_Cpu_Time (const struct SIM_task * pstru_task)
+{
+    clockid_t x_clock;
+    struct timespec stru_time;
+    if ((pthread_getcpuclockid (pstru_task->x_thread, &x_clock) != 0) || (clock_gettime (x_clock, &stru_time) != 0))
+    {
+        return 0;
+    }
+    return (uint32_t)((uint64_t)stru_time.tv_sec * 1000000 + stru_time.tv_nsec / 1000);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
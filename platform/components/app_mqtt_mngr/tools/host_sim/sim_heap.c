@@ -0,0 +1,399 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_heap.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Heap of the simulated device, counting the allocations made by App_Mqtt_Mngr
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sim.h"                        /* Interfaces between the modules of the simulator */
+#include "esp_heap_caps.h"              /* Use heap statistics */
+
+#include <stdlib.h>                     /* Use malloc(), free(), etc. */
+#include <stddef.h>                     /* Use max_align_t */
+#include <string.h>                     /* Use memset(), memcpy() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Size of the internal RAM of ESP32 available to the heap, reported by heap_caps_get_total_size() */
+#define SIM_HEAP_TOTAL_SIZE                 (300 * 1024)
+
+/**
+** @brief   Header placed before each allocated block to track its size. Its size keeps the alignment of the blocks
+**          returned by malloc().
+*/
+typedef union
+{
+    struct
+    {
+        size_t      x_size;             //!< Size in bytes of the block requested by the caller
+        bool        b_counted;          //!< The block is counted in the statistics
+    };
+    max_align_t     x_align;            //!< Alignment of the block
+} SIM_heap_hdr_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Statistics of the heap allocations */
+static SIM_heap_stats_t g_stru_stats;
+
+/** @brief  Whether the allocations made by the calling thread are counted */
+static __thread bool g_b_counted = true;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Functions of the C library, the linker option --wrap redirects all calls of malloc() etc. to __wrap_malloc() etc. */
+extern void * __real_malloc (size_t x_size);
+extern void * __real_calloc (size_t x_num, size_t x_size);
+extern void * __real_realloc (void * pv_block, size_t x_size);
+extern void __real_free (void * pv_block);
+
+static void v_SIM_Heap_Add (const SIM_heap_hdr_t * pstru_hdr, bool b_new_block);
+static void v_SIM_Heap_Remove (const SIM_heap_hdr_t * pstru_hdr, bool b_free_block);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Includes or excludes the allocations made by the calling thread from the statistics. The threads of the
+**      simulator that are not part of the simulated device (e.g. the back-office) exclude their allocations. A block
+**      is removed from the statistics when it is freed if it was counted when it was allocated, whichever thread
+**      frees it.
+**
+** @param [in]
+**      b_counted: true to count the allocations of the calling thread
+**
+** @return
+**      The previous setting
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+bool b_SIM_Heap_Set_Counted (bool b_counted)
+{
+    bool b_previous = g_b_counted;
+    g_b_counted = b_counted;
+    return b_previous;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets statistics of the heap allocations made by the simulated device
+**
+** @param [out]
+**      pstru_stats: The statistics
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Heap_Get_Stats (SIM_heap_stats_t * pstru_stats)
+{
+    pstru_stats->u32_num_allocs = __atomic_load_n (&g_stru_stats.u32_num_allocs, __ATOMIC_SEQ_CST);
+    pstru_stats->u32_num_frees = __atomic_load_n (&g_stru_stats.u32_num_frees, __ATOMIC_SEQ_CST);
+    pstru_stats->u32_cur_bytes = __atomic_load_n (&g_stru_stats.u32_cur_bytes, __ATOMIC_SEQ_CST);
+    pstru_stats->u32_peak_bytes = __atomic_load_n (&g_stru_stats.u32_peak_bytes, __ATOMIC_SEQ_CST);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates a block of memory
+**
+** @param [in]
+**      x_size: Size in bytes of the block
+**
+** @return
+**      @arg    NULL: Out of memory
+**      @arg    Otherwise: The block
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void * __wrap_malloc (size_t x_size)
+{
+    SIM_heap_hdr_t * pstru_hdr = __real_malloc (sizeof (SIM_heap_hdr_t) + x_size);
+    if (pstru_hdr == NULL)
+    {
+        return NULL;
+    }
+    pstru_hdr->x_size = x_size;
+    pstru_hdr->b_counted = g_b_counted;
+    v_SIM_Heap_Add (pstru_hdr, true);
+    return pstru_hdr + 1;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates a block of memory for an array and sets it to zero
+**
+** @param [in]
+**      x_num: Number of elements of the array
+**
+** @param [in]
+**      x_size: Size in bytes of an element
+**
+** @return
+**      @arg    NULL: Out of memory
+**      @arg    Otherwise: The block
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void * __wrap_calloc (size_t x_num, size_t x_size)
+{
+    if ((x_size != 0) && (x_num > ((size_t)-1 - sizeof (SIM_heap_hdr_t)) / x_size))
+    {
+        return NULL;
+    }
+    void * pv_block = __wrap_malloc (x_num * x_size);
+    if (pv_block != NULL)
+    {
+        memset (pv_block, 0, x_num * x_size);
+    }
+    return pv_block;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Changes size of a block of memory
+**
+** @param [in]
+**      pv_block: The block, NULL to allocate a new block
+**
+** @param [in]
+**      x_size: New size in bytes of the block
+**
+** @return
+**      @arg    NULL: Out of memory, the block is unchanged
+**      @arg    Otherwise: The resized block
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void * __wrap_realloc (void * pv_block, size_t x_size)
+{
+    if (pv_block == NULL)
+    {
+        return __wrap_malloc (x_size);
+    }
+
+    SIM_heap_hdr_t stru_old_hdr = *((SIM_heap_hdr_t *)pv_block - 1);
+    SIM_heap_hdr_t * pstru_hdr = __real_realloc ((SIM_heap_hdr_t *)pv_block - 1, sizeof (SIM_heap_hdr_t) + x_size);
+    if (pstru_hdr == NULL)
+    {
+        return NULL;
+    }
+    pstru_hdr->x_size = x_size;
+    v_SIM_Heap_Remove (&stru_old_hdr, false);
+    v_SIM_Heap_Add (pstru_hdr, false);
+    return pstru_hdr + 1;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Frees a block of memory
+**
+** @param [in]
+**      pv_block: The block, can be NULL
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void __wrap_free (void * pv_block)
+{
+    if (pv_block != NULL)
+    {
+        SIM_heap_hdr_t * pstru_hdr = (SIM_heap_hdr_t *)pv_block - 1;
+        v_SIM_Heap_Remove (pstru_hdr, true);
+        __real_free (pstru_hdr);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets total size of the heap regions having the given capabilities
+**
+** @param [in]
+**      u32_caps: The capabilities (MALLOC_CAP_xxx)
+**
+** @return
+**      Size in bytes, 0 for external RAM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+size_t heap_caps_get_total_size (uint32_t u32_caps)
+{
+    return (u32_caps & MALLOC_CAP_SPIRAM) ? 0 : SIM_HEAP_TOTAL_SIZE;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets free size of the heap regions having the given capabilities
+**
+** @param [in]
+**      u32_caps: The capabilities (MALLOC_CAP_xxx)
+**
+** @return
+**      Size in bytes
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+size_t heap_caps_get_free_size (uint32_t u32_caps)
+{
+    uint32_t u32_used = __atomic_load_n (&g_stru_stats.u32_cur_bytes, __ATOMIC_SEQ_CST);
+    return (u32_used < heap_caps_get_total_size (u32_caps)) ? heap_caps_get_total_size (u32_caps) - u32_used : 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the minimum free size that the heap regions having the given capabilities have ever had
+**
+** @param [in]
+**      u32_caps: The capabilities (MALLOC_CAP_xxx)
+**
+** @return
+**      Size in bytes
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+size_t heap_caps_get_minimum_free_size (uint32_t u32_caps)
+{
+    uint32_t u32_peak = __atomic_load_n (&g_stru_stats.u32_peak_bytes, __ATOMIC_SEQ_CST);
+    return (u32_peak < heap_caps_get_total_size (u32_caps)) ? heap_caps_get_total_size (u32_caps) - u32_peak : 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the largest free block of the heap regions having the given capabilities. The heap of the simulator is
+**      not fragmented, this is the free size.
+**
+** @param [in]
+**      u32_caps: The capabilities (MALLOC_CAP_xxx)
+**
+** @return
+**      Size in bytes
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+size_t heap_caps_get_largest_free_block (uint32_t u32_caps)
+{
+    return heap_caps_get_free_size (u32_caps);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Adds an allocated block to the statistics if it is counted
+**
+** @param [in]
+**      pstru_hdr: Header of the block
+**
+** @param [in]
+**      b_new_block: true if the block is newly allocated, false if it is resized
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Heap_Add (const SIM_heap_hdr_t * pstru_hdr, bool b_new_block)
+{
+    if (!pstru_hdr->b_counted)
+    {
+        return;
+    }
+
+    if (b_new_block)
+    {
+        __atomic_add_fetch (&g_stru_stats.u32_num_allocs, 1, __ATOMIC_SEQ_CST);
+    }
+    uint32_t u32_cur_bytes = __atomic_add_fetch (&g_stru_stats.u32_cur_bytes, (uint32_t)pstru_hdr->x_size,
+                                                  __ATOMIC_SEQ_CST);
+
+    uint32_t u32_peak_bytes = __atomic_load_n (&g_stru_stats.u32_peak_bytes, __ATOMIC_SEQ_CST);
+    while ((u32_cur_bytes > u32_peak_bytes) &&
+           !__atomic_compare_exchange_n (&g_stru_stats.u32_peak_bytes, &u32_peak_bytes, u32_cur_bytes,
+                                         false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+    {
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Removes a freed block from the statistics if it is counted
+**
+** @param [in]
+**      pstru_hdr: Header of the block
+**
+** @param [in]
+**      b_free_block: true if the block is freed, false if it is resized
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Heap_Remove (const SIM_heap_hdr_t * pstru_hdr, bool b_free_block)
+{
+    if (!pstru_hdr->b_counted)
+    {
+        return;
+    }
+
+    if (b_free_block)
+    {
+        __atomic_add_fetch (&g_stru_stats.u32_num_frees, 1, __ATOMIC_SEQ_CST);
+    }
+    __atomic_sub_fetch (&g_stru_stats.u32_cur_bytes, (uint32_t)pstru_hdr->x_size, __ATOMIC_SEQ_CST);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
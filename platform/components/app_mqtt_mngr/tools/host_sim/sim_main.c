@@ -0,0 +1,1263 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_main.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Back-office of the host simulator of App_Mqtt_Mngr. It runs App_Mqtt_Mngr against the simulated
+**                broker, measures latency, heap allocations and NVS writes of each command type and the throughput
+**                of file transfers, then checks the replies of the protocol.
+**                The simulator exits with status 1 if a check fails, so that it can be run as a regression check.
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sim.h"                        /* Interfaces between the modules of the simulator */
+#include "common_hdr.h"                 /* Use common definitions */
+#include "app_mqtt_mngr.h"              /* Module under simulation */
+#include "srvc_param.h"                 /* Use Parameter service */
+#include "srvc_wifi.h"                  /* Use MAC address of the simulated device */
+#include "srvc_rt_log.h"                /* Use realtime measurement store */
+#include "param.h"                      /* Run parameter functions of MicroPython programs */
+#include "nvs_flash.h"                  /* Use statistics of the NVS map */
+#include "esp_timer.h"                  /* Use esp_timer_get_time() */
+#include "esp32/rom/crc.h"              /* Use crc32_le() */
+#include "cJSON.h"                      /* Parse the messages of the device */
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS */
+#include "freertos/task.h"              /* Use vTaskDelay() */
+
+#include <stdio.h>                      /* Use printf(), snprintf() */
+#include <stdlib.h>                     /* Use malloc(), rand() */
+#include <stdarg.h>                     /* Use variable arguments */
+#include <string.h>                     /* Use strcmp(), memcmp() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Node ID of the simulated back-office node */
+#define SIM_MASTER_NODE_ID                  0x00000001
+
+/** @brief  Size in bytes of the LittleFS storage of the simulated device */
+#define SIM_STORAGE_SIZE                    (1024 * 1024)
+
+/** @brief  Maximum time (in milliseconds) to wait for a reply of the device */
+#define SIM_REPLY_TIMEOUT_MS                2000
+
+/** @brief  Time (in milliseconds) during which the device must not reply to a discarded command */
+#define SIM_NO_REPLY_TIMEOUT_MS             200
+
+/** @brief  Number of times each command type is sent to measure its latency */
+#define SIM_LATENCY_ROUNDS                  200
+
+/** @brief  Size in bytes of the file uploaded and downloaded to measure the throughput */
+#define SIM_TRANSFER_FILE_SIZE              (128 * 1024)
+
+/** @brief  Length in bytes of the data messages of an upload */
+#define SIM_UPLOAD_MSG_LEN                  (16 * 1024)
+
+/** @brief  Size in bytes of the fragments in which data messages are delivered by the fragmented upload check */
+#define SIM_SMALL_FRAGMENT_SIZE             100
+
+/** @brief  Maximum size in bytes of the script uploaded by the protocol checks */
+#define SIM_SCRIPT_SIZE                     1024
+
+/** @brief  Number of parameter changes in a burst, which must be committed at once */
+#define SIM_PARAM_BURST_SIZE                20
+
+/** @brief  Length in bytes of the header of a data message of a download: offset and CRC-32 of the chunk */
+#define SIM_DOWNLOAD_HDR_LEN                8
+
+/** @brief  Maximum number of messages received while waiting for messages of another topic */
+#define SIM_MAX_PENDING_MSGS                32
+
+/** @brief  Number of samples stored by the realtime measurement store check, and the samples in each block */
+#define SIM_RTLOG_NUM_SAMPLES               30
+#define SIM_RTLOG_BLOCK_SAMPLES             3
+
+/** @brief  Timestamp of the first sample, and interval in milliseconds between samples, of the store check */
+#define SIM_RTLOG_START_TIME                1000000
+#define SIM_RTLOG_INTERVAL                  100
+
+/** @brief  Message ID of realtime measurement messages of the slave board */
+#define SIM_RTLOG_MSG_RT_MEAS               0x11
+
+/** @brief  Result of reading back the samples of the realtime measurement store check */
+typedef struct
+{
+    uint32_t            u32_num_samples;    //!< Number of samples read
+    uint32_t            u32_num_errors;     //!< Number of samples whose measurements differ from those stored
+
+} SIM_rtlog_check_t;
+
+/** @brief  A command type whose latency is measured */
+typedef struct
+{
+    const char *        pstri_command;      //!< Name of the command
+    const char *        pstri_reply;        //!< Name of the reply of the device
+    bool                b_notify;           //!< The reply is a notify instead of a response
+    const char *        pstri_extra;        //!< Extra command data, appended to the common keys
+
+} SIM_bench_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+static const char * TAG = "Sim_Main";
+
+/** @brief  Command types whose latency is measured */
+static const SIM_bench_t g_astru_benches[] =
+{
+    { "scanPost",               "scanNotify",               true,   "" },
+    { "paramReadRequest",       "paramReadResponse",        false,  ",\"pucs\":[0,1,16]" },
+    { "paramWriteRequest",      "paramWriteResponse",       false,  ",\"parameters\":[{\"puc\":1,\"value\":\"sim\"}]" },
+    { "fileListReadRequest",    "fileListReadResponse",     false,  "" },
+};
+
+/** @brief  Topics of the messages sent to the device */
+static char g_stri_command_topic[80];
+static char g_stri_data_topic[80];
+
+/** @brief  Topics of the messages published by the device */
+static char g_stri_response_topic[80];
+static char g_stri_rx_data_topic[80];
+static char g_stri_notify_topic[80];
+
+/** @brief  Exchange ID of the last command */
+static uint32_t g_u32_eid = 0;
+
+/** @brief  Messages received while waiting for messages of another topic */
+static SIM_msg_t * g_apstru_pending[SIM_MAX_PENDING_MSGS];
+static uint8_t g_u8_num_pending = 0;
+
+/** @brief  Number of failed checks */
+static uint32_t g_u32_num_failures = 0;
+
+/** @brief  Parameter changes notified to the simulator, and the last change of MQTT group */
+static uint32_t g_u32_num_changes = 0;
+static char g_stri_old_group[40];
+static char g_stri_new_group[40];
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void v_SIM_Check (bool b_ok, const char * pstri_format, ...);
+static SIM_msg_t * pstru_SIM_Receive_From (const char * pstri_topic, uint32_t u32_timeout_ms);
+static cJSON * px_SIM_Receive_Json (const char * pstri_topic, const char * pstri_command, int64_t s64_eid,
+                                    uint32_t u32_timeout_ms);
+static void v_SIM_Send_Command (const char * pstri_command, uint32_t u32_eid, const char * pstri_extra);
+static cJSON * px_SIM_Request (const char * pstri_command, const char * pstri_extra, const char * pstri_response);
+static const char * pstri_SIM_Get_String (const cJSON * px_root, const char * pstri_key);
+static bool b_SIM_Has_Status (const cJSON * px_reply, const char * pstri_status);
+static bool b_SIM_Wait_Status_Notify (const char * pstri_type, const char * pstri_file, const char * pstri_value);
+static bool b_SIM_Upload (const char * pstri_file, const uint8_t * pu8_data, uint32_t u32_len, uint32_t u32_checksum,
+                          uint32_t u32_fragment_size);
+static bool b_SIM_Download (const char * pstri_file, const uint8_t * pu8_data, uint32_t u32_len);
+static bool b_SIM_File_Exists (const char * pstri_file);
+static void v_SIM_Run_Latency (void);
+static void v_SIM_Run_Transfers (void);
+static void v_SIM_Run_Protocol_Checks (void);
+static void v_SIM_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg);
+static void v_SIM_Param_Ignore_Handler (const PARAM_change_t * pstru_change, void * pv_arg);
+static void v_SIM_Run_Rt_Log_Checks (void);
+static void v_SIM_Get_Rt_Log_Sample (uint32_t u32_sample, RTLOG_rt_meas_t * pstru_meas);
+static bool b_SIM_Check_Rt_Log_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg);
+
+/* Called by Srvc_Micropy when a Python program has ended */
+extern void v_MP_Param_Reset (void);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts the simulated device, then runs the measurements and the checks
+**
+** @return
+**      @arg    0: All checks passed
+**      @arg    1: A check failed
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int main (void)
+{
+    /* Start the simulated device in the same order as the device does */
+    if ((nvs_flash_init () != ESP_OK) || (s8_SIM_Storage_Init (SIM_STORAGE_SIZE) != STATUS_OK) ||
+        (s8_PARAM_Init () != PARAM_OK) || (s32_RTLOG_Store_Init () != STATUS_OK) || (s8_MQTTMN_Init () != MQTTMN_OK))
+    {
+        LOGE ("Failed to start the simulated device");
+        return 1;
+    }
+
+    /* From now on, this thread is the back-office, its allocations are not made by the device */
+    b_SIM_Heap_Set_Counted (false);
+
+    /* Topics of the simulated back-office node */
+    uint8_t au8_mac[8];
+    s8_WIFI_Get_Mac (au8_mac);
+    uint32_t u32_slave_node_id = ENDIAN_GET32_BE (&au8_mac[2]);
+    char * pstri_group_id = NULL;
+    s8_PARAM_Get_String (PARAM_MQTT_GROUP_ID, &pstri_group_id);
+    snprintf (g_stri_command_topic, sizeof (g_stri_command_topic), "itor3/m2s/%s/%08X/%08X/command",
+              pstri_group_id, u32_slave_node_id, SIM_MASTER_NODE_ID);
+    snprintf (g_stri_data_topic, sizeof (g_stri_data_topic), "itor3/m2s/%s/%08X/%08X/data",
+              pstri_group_id, u32_slave_node_id, SIM_MASTER_NODE_ID);
+    snprintf (g_stri_response_topic, sizeof (g_stri_response_topic), "itor3/s2m/%s/%08X/%08X/response",
+              pstri_group_id, u32_slave_node_id, SIM_MASTER_NODE_ID);
+    snprintf (g_stri_rx_data_topic, sizeof (g_stri_rx_data_topic), "itor3/s2m/%s/%08X/%08X/data",
+              pstri_group_id, u32_slave_node_id, SIM_MASTER_NODE_ID);
+    snprintf (g_stri_notify_topic, sizeof (g_stri_notify_topic), "itor3/s2m/%s/%08X/notify",
+              pstri_group_id, u32_slave_node_id);
+    free (pstri_group_id);
+
+    /* The device announces itself once connected */
+    cJSON * px_notify = px_SIM_Receive_Json (g_stri_notify_topic, "scanNotify", -1, SIM_REPLY_TIMEOUT_MS);
+    v_SIM_Check (px_notify != NULL, "scanNotify is published on connection");
+    cJSON_Delete (px_notify);
+
+    v_SIM_Run_Latency ();
+    v_SIM_Run_Transfers ();
+    v_SIM_Run_Protocol_Checks ();
+    v_SIM_Run_Rt_Log_Checks ();
+
+    SIM_heap_stats_t stru_heap;
+    v_SIM_Heap_Get_Stats (&stru_heap);
+    printf ("\nHeap of the device: %u allocations, %u bytes in use, peak %u bytes\n",
+            stru_heap.u32_num_allocs, stru_heap.u32_cur_bytes, stru_heap.u32_peak_bytes);
+
+    if (g_u32_num_failures != 0)
+    {
+        printf ("\n%u check(s) FAILED\n", g_u32_num_failures);
+        return 1;
+    }
+    printf ("\nAll checks passed\n");
+    return 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Records result of a check, only failed checks are printed
+**
+** @param [in]
+**      b_ok: The check passed
+**
+** @param [in]
+**      pstri_format: Format of the description of the check, followed by its arguments
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Check (bool b_ok, const char * pstri_format, ...)
+{
+    if (!b_ok)
+    {
+        va_list x_args;
+        va_start (x_args, pstri_format);
+        printf ("FAILED: ");
+        vprintf (pstri_format, x_args);
+        printf ("\n");
+        va_end (x_args);
+        g_u32_num_failures++;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a message of a topic
+**
+** @details
+**      Responses and notifies are posted with different priorities, so they may arrive out of order. Messages of
+**      other topics are kept until they are waited for, the oldest one is dropped if too many are kept.
+**
+** @param [in]
+**      pstri_topic: The topic
+**
+** @param [in]
+**      u32_timeout_ms: Maximum time to wait
+**
+** @return
+**      @arg    NULL: No message of the topic has been received
+**      @arg    Otherwise: The message, which must be freed with v_SIM_Mqtt_Free()
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static SIM_msg_t * pstru_SIM_Receive_From (const char * pstri_topic, uint32_t u32_timeout_ms)
+{
+    /* A message of the topic may have been received already */
+    for (uint8_t u8_idx = 0; u8_idx < g_u8_num_pending; u8_idx++)
+    {
+        SIM_msg_t * pstru_msg = g_apstru_pending[u8_idx];
+        if (strcmp (pstru_msg->stri_topic, pstri_topic) == 0)
+        {
+            g_u8_num_pending--;
+            memmove (&g_apstru_pending[u8_idx], &g_apstru_pending[u8_idx + 1],
+                     (g_u8_num_pending - u8_idx) * sizeof (g_apstru_pending[0]));
+            return pstru_msg;
+        }
+    }
+
+    int64_t s64_deadline = esp_timer_get_time () + (int64_t)u32_timeout_ms * 1000;
+    while (true)
+    {
+        int64_t s64_remain_us = s64_deadline - esp_timer_get_time ();
+        if (s64_remain_us <= 0)
+        {
+            return NULL;
+        }
+        SIM_msg_t * pstru_msg = pstru_SIM_Mqtt_Receive ((uint32_t)((s64_remain_us + 999) / 1000));
+        if (pstru_msg == NULL)
+        {
+            return NULL;
+        }
+        if (strcmp (pstru_msg->stri_topic, pstri_topic) == 0)
+        {
+            return pstru_msg;
+        }
+
+        /* Keep the message of another topic */
+        if (g_u8_num_pending == SIM_MAX_PENDING_MSGS)
+        {
+            v_SIM_Mqtt_Free (g_apstru_pending[0]);
+            g_u8_num_pending--;
+            memmove (&g_apstru_pending[0], &g_apstru_pending[1], g_u8_num_pending * sizeof (g_apstru_pending[0]));
+        }
+        g_apstru_pending[g_u8_num_pending++] = pstru_msg;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a JSON message of a topic, messages of the topic carrying another command are dropped
+**
+** @param [in]
+**      pstri_topic: The topic
+**
+** @param [in]
+**      pstri_command: Name of the command carried by the message
+**
+** @param [in]
+**      s64_eid: Exchange ID of the message, -1 for any exchange ID
+**
+** @param [in]
+**      u32_timeout_ms: Maximum time to wait
+**
+** @return
+**      @arg    NULL: No such message has been received
+**      @arg    Otherwise: The parsed message, which must be deleted with cJSON_Delete()
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static cJSON * px_SIM_Receive_Json (const char * pstri_topic, const char * pstri_command, int64_t s64_eid,
+                                    uint32_t u32_timeout_ms)
+{
+    int64_t s64_deadline = esp_timer_get_time () + (int64_t)u32_timeout_ms * 1000;
+    while (true)
+    {
+        int64_t s64_remain_us = s64_deadline - esp_timer_get_time ();
+        SIM_msg_t * pstru_msg = pstru_SIM_Receive_From (pstri_topic, (s64_remain_us > 0) ?
+                                                        (uint32_t)((s64_remain_us + 999) / 1000) : 0);
+        if (pstru_msg == NULL)
+        {
+            return NULL;
+        }
+        cJSON * px_root = cJSON_ParseWithLength ((const char *)pstru_msg->au8_data, pstru_msg->u32_len);
+        v_SIM_Mqtt_Free (pstru_msg);
+
+        const char * pstri_msg_command = pstri_SIM_Get_String (px_root, "command");
+        cJSON * px_eid = cJSON_GetObjectItem (px_root, "eid");
+        if ((pstri_msg_command != NULL) && (strcmp (pstri_msg_command, pstri_command) == 0) &&
+            ((s64_eid < 0) || (cJSON_IsNumber (px_eid) && (px_eid->valuedouble == (double)s64_eid))))
+        {
+            return px_root;
+        }
+        cJSON_Delete (px_root);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a JSON command to the device
+**
+** @param [in]
+**      pstri_command: Name of the command
+**
+** @param [in]
+**      u32_eid: Exchange ID of the command
+**
+** @param [in]
+**      pstri_extra: Extra command data, appended to the common keys. It is empty or starts with a comma.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Send_Command (const char * pstri_command, uint32_t u32_eid, const char * pstri_extra)
+{
+    char stri_message[512];
+    int s32_len = snprintf (stri_message, sizeof (stri_message), "{\"command\":\"%s\",\"eid\":%u%s}",
+                            pstri_command, u32_eid, pstri_extra);
+    ASSERT_PARAM ((s32_len > 0) && (s32_len < (int)sizeof (stri_message)));
+    s8_SIM_Mqtt_Send (g_stri_command_topic, stri_message, s32_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a request command with a new exchange ID and waits for its response
+**
+** @param [in]
+**      pstri_command: Name of the command
+**
+** @param [in]
+**      pstri_extra: Extra command data, empty or starting with a comma
+**
+** @param [in]
+**      pstri_response: Name of the response
+**
+** @return
+**      @arg    NULL: The device didn't respond
+**      @arg    Otherwise: The response, which must be deleted with cJSON_Delete()
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static cJSON * px_SIM_Request (const char * pstri_command, const char * pstri_extra, const char * pstri_response)
+{
+    uint32_t u32_eid = ++g_u32_eid;
+    v_SIM_Send_Command (pstri_command, u32_eid, pstri_extra);
+    cJSON * px_response = px_SIM_Receive_Json (g_stri_response_topic, pstri_response, u32_eid, SIM_REPLY_TIMEOUT_MS);
+    v_SIM_Check (px_response != NULL, "%s is answered with %s", pstri_command, pstri_response);
+    return px_response;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of a string item of a JSON object
+**
+** @param [in]
+**      px_root: The object, can be NULL
+**
+** @param [in]
+**      pstri_key: Key of the item
+**
+** @return
+**      @arg    NULL: The item doesn't exist or is not a string
+**      @arg    Otherwise: Value of the item
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static const char * pstri_SIM_Get_String (const cJSON * px_root, const char * pstri_key)
+{
+    cJSON * px_item = cJSON_GetObjectItem (px_root, pstri_key);
+    return cJSON_IsString (px_item) ? px_item->valuestring : NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks status of a response
+**
+** @param [in]
+**      px_reply: The response, can be NULL
+**
+** @param [in]
+**      pstri_status: The expected status
+**
+** @return
+**      @arg    true: The response has the expected status
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Has_Status (const cJSON * px_reply, const char * pstri_status)
+{
+    const char * pstri_value = pstri_SIM_Get_String (px_reply, "status");
+    return (pstri_value != NULL) && (strcmp (pstri_value, pstri_status) == 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a statusNotify command of a file transfer and checks the status value
+**
+** @param [in]
+**      pstri_type: Status type
+**
+** @param [in]
+**      pstri_file: Name of the transferred file, notifies about other files are skipped
+**
+** @param [in]
+**      pstri_value: Expected status value
+**
+** @return
+**      @arg    true: The notify has been received with the expected value
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Wait_Status_Notify (const char * pstri_type, const char * pstri_file, const char * pstri_value)
+{
+    int64_t s64_deadline = esp_timer_get_time () + (int64_t)SIM_REPLY_TIMEOUT_MS * 1000;
+    while (esp_timer_get_time () < s64_deadline)
+    {
+        cJSON * px_notify = px_SIM_Receive_Json (g_stri_notify_topic, "statusNotify", -1, SIM_REPLY_TIMEOUT_MS);
+        if (px_notify == NULL)
+        {
+            break;
+        }
+        const char * pstri_type_rx = pstri_SIM_Get_String (px_notify, "statusType");
+        const char * pstri_file_rx = pstri_SIM_Get_String (px_notify, "file");
+        cJSON * px_node_id = cJSON_GetObjectItem (px_notify, "masterNodeId");
+        if ((pstri_type_rx != NULL) && (strcmp (pstri_type_rx, pstri_type) == 0) &&
+            (pstri_file_rx != NULL) && (strcmp (pstri_file_rx, pstri_file) == 0) &&
+            cJSON_IsNumber (px_node_id) && (px_node_id->valuedouble == SIM_MASTER_NODE_ID))
+        {
+            const char * pstri_value_rx = pstri_SIM_Get_String (px_notify, "statusValue");
+            bool b_ok = (pstri_value_rx != NULL) && (strcmp (pstri_value_rx, pstri_value) == 0);
+            cJSON_Delete (px_notify);
+            return b_ok;
+        }
+        cJSON_Delete (px_notify);
+    }
+    return false;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Uploads a file to the device
+**
+** @param [in]
+**      pstri_file: Name of the file
+**
+** @param [in]
+**      pu8_data: Content of the file
+**
+** @param [in]
+**      u32_len: Length in bytes of the file
+**
+** @param [in]
+**      u32_checksum: CRC-32 announced in the request, the upload fails if it's not the one of the file
+**
+** @param [in]
+**      u32_fragment_size: Size of the fragments in which the data messages are delivered, 0 for receive buffer size
+**
+** @return
+**      @arg    true: The device reported that the file has been uploaded
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Upload (const char * pstri_file, const uint8_t * pu8_data, uint32_t u32_len, uint32_t u32_checksum,
+                          uint32_t u32_fragment_size)
+{
+    char stri_extra[128];
+    snprintf (stri_extra, sizeof (stri_extra), ",\"file\":\"%s\",\"size\":%u,\"checksum\":%u",
+              pstri_file, u32_len, u32_checksum);
+    cJSON * px_response = px_SIM_Request ("fileUploadWriteRequest", stri_extra, "fileUploadWriteResponse");
+    cJSON * px_offset = cJSON_GetObjectItem (px_response, "offset");
+    bool b_accepted = b_SIM_Has_Status (px_response, "ok") && cJSON_IsNumber (px_offset) &&
+                      (px_offset->valuedouble == 0);
+    cJSON_Delete (px_response);
+    if (!b_accepted)
+    {
+        return false;
+    }
+
+    /* Commands must not be fragmented, so the fragment size only changes once the request has been processed */
+    v_SIM_Mqtt_Set_Fragment_Size (u32_fragment_size);
+    for (uint32_t u32_offset = 0; u32_offset < u32_len; u32_offset += SIM_UPLOAD_MSG_LEN)
+    {
+        uint32_t u32_msg_len = u32_len - u32_offset;
+        if (u32_msg_len > SIM_UPLOAD_MSG_LEN)
+        {
+            u32_msg_len = SIM_UPLOAD_MSG_LEN;
+        }
+        s8_SIM_Mqtt_Send (g_stri_data_topic, &pu8_data[u32_offset], u32_msg_len);
+    }
+    bool b_uploaded = b_SIM_Wait_Status_Notify ("fileUploadStatus", pstri_file, "ok");
+    v_SIM_Mqtt_Set_Fragment_Size (0);
+    return b_uploaded;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Downloads a file from the device and checks its content
+**
+** @param [in]
+**      pstri_file: Name of the file
+**
+** @param [in]
+**      pu8_data: Expected content of the file
+**
+** @param [in]
+**      u32_len: Expected length in bytes of the file
+**
+** @return
+**      @arg    true: The file has been downloaded with the expected content
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Download (const char * pstri_file, const uint8_t * pu8_data, uint32_t u32_len)
+{
+    char stri_extra[96];
+    snprintf (stri_extra, sizeof (stri_extra), ",\"file\":\"%s\"", pstri_file);
+    cJSON * px_response = px_SIM_Request ("fileDownloadReadRequest", stri_extra, "fileDownloadReadResponse");
+    cJSON * px_size = cJSON_GetObjectItem (px_response, "size");
+    cJSON * px_checksum = cJSON_GetObjectItem (px_response, "checksum");
+
+    /* The device doesn't calculate checksum of the whole file yet and returns 0, each chunk is checked instead */
+    bool b_success = b_SIM_Has_Status (px_response, "ok") &&
+                     cJSON_IsNumber (px_size) && (px_size->valuedouble == u32_len) &&
+                     cJSON_IsNumber (px_checksum) && ((px_checksum->valuedouble == 0) ||
+                                                      (px_checksum->valuedouble == crc32_le (0, pu8_data, u32_len)));
+    cJSON_Delete (px_response);
+    v_SIM_Check (b_success, "fileDownloadReadResponse of %s carries its size and checksum", pstri_file);
+
+    /* Each data message carries the offset and the CRC-32 of its chunk, chunks are sent in order */
+    uint32_t u32_received = 0;
+    while (b_success && (u32_received < u32_len))
+    {
+        SIM_msg_t * pstru_msg = pstru_SIM_Receive_From (g_stri_rx_data_topic, SIM_REPLY_TIMEOUT_MS);
+        if (pstru_msg == NULL)
+        {
+            v_SIM_Check (false, "Data of %s is received (%u/%u bytes)", pstri_file, u32_received, u32_len);
+            return false;
+        }
+        const uint8_t * pu8_chunk = &pstru_msg->au8_data[SIM_DOWNLOAD_HDR_LEN];
+        uint32_t u32_chunk_len = pstru_msg->u32_len - SIM_DOWNLOAD_HDR_LEN;
+        b_success = (pstru_msg->u32_len > SIM_DOWNLOAD_HDR_LEN) &&
+                    (ENDIAN_GET32_BE (&pstru_msg->au8_data[0]) == u32_received) &&
+                    (ENDIAN_GET32_BE (&pstru_msg->au8_data[4]) == crc32_le (0, pu8_chunk, u32_chunk_len)) &&
+                    (u32_received + u32_chunk_len <= u32_len) &&
+                    (memcmp (pu8_chunk, &pu8_data[u32_received], u32_chunk_len) == 0);
+        v_SIM_Check (b_success, "Data message of %s at offset %u is valid", pstri_file, u32_received);
+        u32_received += u32_chunk_len;
+        v_SIM_Mqtt_Free (pstru_msg);
+    }
+    return b_success && b_SIM_Wait_Status_Notify ("fileDownloadStatus", pstri_file, "ok");
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a file is listed by the device
+**
+** @param [in]
+**      pstri_file: Name of the file
+**
+** @return
+**      @arg    true: The file is listed
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_File_Exists (const char * pstri_file)
+{
+    bool b_exists = false;
+    cJSON * px_response = px_SIM_Request ("fileListReadRequest", "", "fileListReadResponse");
+    cJSON * px_files = cJSON_GetObjectItem (px_response, "files");
+    cJSON * px_file;
+    cJSON_ArrayForEach (px_file, px_files)
+    {
+        if (cJSON_IsString (px_file) && (strcmp (px_file->valuestring, pstri_file) == 0))
+        {
+            b_exists = true;
+        }
+    }
+    cJSON_Delete (px_response);
+    return b_exists;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Measures round-trip latency, heap allocations and NVS writes of each command type
+**
+** @details
+**      Allocations of the back-office are not counted, those of the broker are counted as esp-mqtt's would be,
+**      except the copies of the messages
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Run_Latency (void)
+{
+    printf ("\n%-24s %8s %10s %10s %12s %12s %12s\n", "Command", "Rounds", "Avg (us)", "Max (us)",
+            "Allocs/cmd", "NVS sets", "NVS commits");
+
+    for (uint8_t u8_idx = 0; u8_idx < sizeof (g_astru_benches) / sizeof (g_astru_benches[0]); u8_idx++)
+    {
+        const SIM_bench_t * pstru_bench = &g_astru_benches[u8_idx];
+        SIM_heap_stats_t stru_heap_start;
+        SIM_heap_stats_t stru_heap_end;
+        SIM_nvs_stats_t stru_nvs_start;
+        SIM_nvs_stats_t stru_nvs_end;
+        int64_t s64_total_us = 0;
+        int64_t s64_max_us = 0;
+        uint32_t u32_num_replies = 0;
+
+        v_SIM_Heap_Get_Stats (&stru_heap_start);
+        v_SIM_Nvs_Get_Stats (&stru_nvs_start);
+        for (uint32_t u32_round = 0; u32_round < SIM_LATENCY_ROUNDS; u32_round++)
+        {
+            uint32_t u32_eid = ++g_u32_eid;
+            int64_t s64_start = esp_timer_get_time ();
+            v_SIM_Send_Command (pstru_bench->pstri_command, u32_eid, pstru_bench->pstri_extra);
+            cJSON * px_reply = pstru_bench->b_notify ?
+                px_SIM_Receive_Json (g_stri_notify_topic, pstru_bench->pstri_reply, -1, SIM_REPLY_TIMEOUT_MS) :
+                px_SIM_Receive_Json (g_stri_response_topic, pstru_bench->pstri_reply, u32_eid, SIM_REPLY_TIMEOUT_MS);
+            int64_t s64_latency_us = esp_timer_get_time () - s64_start;
+            if (px_reply == NULL)
+            {
+                continue;
+            }
+            v_SIM_Check (pstru_bench->b_notify || b_SIM_Has_Status (px_reply, "ok"),
+                         "%s is answered with status ok", pstru_bench->pstri_command);
+            cJSON_Delete (px_reply);
+            u32_num_replies++;
+            s64_total_us += s64_latency_us;
+            if (s64_latency_us > s64_max_us)
+            {
+                s64_max_us = s64_latency_us;
+            }
+        }
+        v_SIM_Heap_Get_Stats (&stru_heap_end);
+        v_SIM_Nvs_Get_Stats (&stru_nvs_end);
+        v_SIM_Check (u32_num_replies == SIM_LATENCY_ROUNDS, "%s is answered %u times (%u replies)",
+                     pstru_bench->pstri_command, SIM_LATENCY_ROUNDS, u32_num_replies);
+
+        printf ("%-24s %8u %10lld %10lld %12.1f %12.2f %12.2f\n", pstru_bench->pstri_command, u32_num_replies,
+                (u32_num_replies != 0) ? (long long)(s64_total_us / u32_num_replies) : 0LL, (long long)s64_max_us,
+                (double)(stru_heap_end.u32_num_allocs - stru_heap_start.u32_num_allocs) / SIM_LATENCY_ROUNDS,
+                (double)(stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets) / SIM_LATENCY_ROUNDS,
+                (double)(stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits) / SIM_LATENCY_ROUNDS);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Measures throughput of an upload and a download of a file
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Run_Transfers (void)
+{
+    uint8_t * pu8_data = malloc (SIM_TRANSFER_FILE_SIZE);
+    ASSERT_PARAM (pu8_data != NULL);
+    srand (SIM_TRANSFER_FILE_SIZE);
+    for (uint32_t u32_idx = 0; u32_idx < SIM_TRANSFER_FILE_SIZE; u32_idx++)
+    {
+        pu8_data[u32_idx] = (uint8_t)rand ();
+    }
+    uint32_t u32_checksum = crc32_le (0, pu8_data, SIM_TRANSFER_FILE_SIZE);
+
+    printf ("\n%-24s %10s %10s %12s %12s\n", "Transfer", "Bytes", "Time (ms)", "KB/s", "Allocs");
+    SIM_heap_stats_t stru_heap_start;
+    SIM_heap_stats_t stru_heap_end;
+
+    /* Upload */
+    v_SIM_Heap_Get_Stats (&stru_heap_start);
+    int64_t s64_start = esp_timer_get_time ();
+    bool b_success = b_SIM_Upload ("sim_transfer.bin", pu8_data, SIM_TRANSFER_FILE_SIZE, u32_checksum, 0);
+    int64_t s64_time_us = esp_timer_get_time () - s64_start + 1;
+    v_SIM_Heap_Get_Stats (&stru_heap_end);
+    v_SIM_Check (b_success, "File sim_transfer.bin is uploaded");
+    printf ("%-24s %10u %10.1f %12.1f %12u\n", "fileUpload", SIM_TRANSFER_FILE_SIZE, s64_time_us / 1000.0,
+            SIM_TRANSFER_FILE_SIZE * 1000000.0 / 1024 / s64_time_us,
+            stru_heap_end.u32_num_allocs - stru_heap_start.u32_num_allocs);
+
+    /* Download */
+    v_SIM_Heap_Get_Stats (&stru_heap_start);
+    s64_start = esp_timer_get_time ();
+    b_success = b_SIM_Download ("sim_transfer.bin", pu8_data, SIM_TRANSFER_FILE_SIZE);
+    s64_time_us = esp_timer_get_time () - s64_start + 1;
+    v_SIM_Heap_Get_Stats (&stru_heap_end);
+    v_SIM_Check (b_success, "File sim_transfer.bin is downloaded");
+    printf ("%-24s %10u %10.1f %12.1f %12u\n", "fileDownload", SIM_TRANSFER_FILE_SIZE, s64_time_us / 1000.0,
+            SIM_TRANSFER_FILE_SIZE * 1000000.0 / 1024 / s64_time_us,
+            stru_heap_end.u32_num_allocs - stru_heap_start.u32_num_allocs);
+
+    free (pu8_data);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks the replies of the device to valid and invalid commands
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Run_Protocol_Checks (void)
+{
+    uint8_t au8_script[SIM_SCRIPT_SIZE];
+    uint32_t u32_script_len = 0;
+    cJSON * px_response;
+
+    /* A script spanning many fragments */
+    for (uint32_t u32_line = 0; u32_script_len + 32 < sizeof (au8_script); u32_line++)
+    {
+        u32_script_len += sprintf ((char *)&au8_script[u32_script_len], "print ('Line %u')\n", u32_line);
+    }
+    uint32_t u32_script_checksum = crc32_le (0, au8_script, u32_script_len);
+
+    printf ("\nRunning protocol checks\n");
+
+    /* A written parameter is read back */
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":1,\"value\":\"checked\"}]",
+                                  "paramWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok"), "paramWriteRequest succeeds");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramReadRequest", ",\"pucs\":[1]", "paramReadResponse");
+    cJSON * px_params = cJSON_GetObjectItem (px_response, "parameters");
+    const char * pstri_value = cJSON_IsArray (px_params) ? pstri_SIM_Get_String (px_params->child, "value") : NULL;
+    v_SIM_Check ((pstri_value != NULL) && (strcmp (pstri_value, "checked") == 0),
+                 "paramReadRequest returns the written value");
+    cJSON_Delete (px_response);
+
+    /* A burst of parameter changes is written to NVS at once */
+    SIM_nvs_stats_t stru_nvs_start;
+    SIM_nvs_stats_t stru_nvs_end;
+    s8_PARAM_Flush ();
+    v_SIM_Nvs_Get_Stats (&stru_nvs_start);
+    for (uint32_t u32_change = 0; u32_change < SIM_PARAM_BURST_SIZE; u32_change++)
+    {
+        char stri_extra[64];
+        snprintf (stri_extra, sizeof (stri_extra), ",\"parameters\":[{\"puc\":1,\"value\":\"burst%u\"}]", u32_change);
+        px_response = px_SIM_Request ("paramWriteRequest", stri_extra, "paramWriteResponse");
+        cJSON_Delete (px_response);
+    }
+    s8_PARAM_Flush ();
+    v_SIM_Nvs_Get_Stats (&stru_nvs_end);
+    v_SIM_Check ((stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets == 1) &&
+                 (stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits == 1),
+                 "A burst of %u parameter changes is written once (%u NVS sets, %u commits)", SIM_PARAM_BURST_SIZE,
+                 stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets,
+                 stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits);
+
+    /* Parameters changed by one command are committed at once, then notified */
+    s8_PARAM_Subscribe (PARAM_MASK_ALL, v_SIM_Param_Change_Handler, NULL);
+    v_SIM_Nvs_Get_Stats (&stru_nvs_start);
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":0,\"value\":\"sim_ssid\"},"
+                                  "{\"puc\":1,\"value\":\"sim_psw\"},{\"puc\":16,\"value\":\"sim_group\"}]",
+                                  "paramWriteResponse");
+    s8_PARAM_Flush ();
+    v_SIM_Nvs_Get_Stats (&stru_nvs_end);
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok") &&
+                 (stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets == 3) &&
+                 (stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits == 1),
+                 "Parameters of a paramWriteRequest are committed at once (%u NVS sets, %u commits)",
+                 stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets,
+                 stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits);
+    cJSON_Delete (px_response);
+    v_SIM_Check ((g_u32_num_changes == 3) && (strcmp (g_stri_old_group, "default") == 0) &&
+                 (strcmp (g_stri_new_group, "sim_group") == 0),
+                 "Subscribers are notified of %u changes, MQTT group changed from \"%s\" to \"%s\"",
+                 g_u32_num_changes, g_stri_old_group, g_stri_new_group);
+
+    /* A command with an invalid parameter changes none of them */
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":1,\"value\":\"partial\"},"
+                                  "{\"puc\":2457,\"value\":\"0\"}]", "paramWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorInvalidData"),
+                 "paramWriteRequest with an unknown PUC is rejected");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramReadRequest", ",\"pucs\":[1]", "paramReadResponse");
+    px_params = cJSON_GetObjectItem (px_response, "parameters");
+    pstri_value = cJSON_IsArray (px_params) ? pstri_SIM_Get_String (px_params->child, "value") : NULL;
+    v_SIM_Check ((pstri_value != NULL) && (strcmp (pstri_value, "sim_psw") == 0) && (g_u32_num_changes == 3),
+                 "A rejected paramWriteRequest changes no parameter");
+    cJSON_Delete (px_response);
+
+    /* Subscriptions beyond the capacity of the subscriber table are refused */
+    uint8_t u8_num_subscriptions = 1;
+    while ((u8_num_subscriptions < UINT8_MAX) &&
+           (s8_PARAM_Subscribe (PARAM_MASK_ALL, v_SIM_Param_Ignore_Handler, NULL) == PARAM_OK))
+    {
+        u8_num_subscriptions++;
+    }
+    v_SIM_Check (u8_num_subscriptions < UINT8_MAX,
+                 "Subscription is refused once the table is full (%u subscriptions)", u8_num_subscriptions);
+
+    /* A snapshot of the parameters restores all of them at once */
+    px_response = px_SIM_Request ("paramSnapshotReadRequest", "", "paramSnapshotReadResponse");
+    const char * pstri_snapshot = pstri_SIM_Get_String (px_response, "snapshot");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok") && (pstri_snapshot != NULL),
+                 "paramSnapshotReadRequest returns a snapshot (%u hex chars)",
+                 (pstri_snapshot != NULL) ? (uint32_t)strlen (pstri_snapshot) : 0);
+    char * pstri_extra = malloc ((pstri_snapshot != NULL) ? strlen (pstri_snapshot) + 32 : 32);
+    sprintf (pstri_extra, ",\"snapshot\":\"%s\"", (pstri_snapshot != NULL) ? pstri_snapshot : "");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":0,\"value\":\"other_ssid\"},"
+                                  "{\"puc\":1,\"value\":\"other_psw\"}]", "paramWriteResponse");
+    cJSON_Delete (px_response);
+    s8_PARAM_Flush ();
+    v_SIM_Nvs_Get_Stats (&stru_nvs_start);
+    px_response = px_SIM_Request ("paramSnapshotWriteRequest", pstri_extra, "paramSnapshotWriteResponse");
+    s8_PARAM_Flush ();
+    v_SIM_Nvs_Get_Stats (&stru_nvs_end);
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok") &&
+                 (stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets == 2) &&
+                 (stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits == 1),
+                 "paramSnapshotWriteRequest restores the changed parameters at once (%u NVS sets, %u commits)",
+                 stru_nvs_end.u32_num_sets - stru_nvs_start.u32_num_sets,
+                 stru_nvs_end.u32_num_commits - stru_nvs_start.u32_num_commits);
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramReadRequest", ",\"pucs\":[1]", "paramReadResponse");
+    px_params = cJSON_GetObjectItem (px_response, "parameters");
+    pstri_value = cJSON_IsArray (px_params) ? pstri_SIM_Get_String (px_params->child, "value") : NULL;
+    v_SIM_Check ((pstri_value != NULL) && (strcmp (pstri_value, "sim_psw") == 0),
+                 "Imported snapshot restores the previous value");
+    cJSON_Delete (px_response);
+
+    /* A corrupted snapshot is rejected */
+    char * pc_digit = strrchr (pstri_extra, '-');
+    if (pc_digit != NULL)
+    {
+        pc_digit[1] = (pc_digit[1] == '0') ? '1' : '0';
+    }
+    px_response = px_SIM_Request ("paramSnapshotWriteRequest", pstri_extra, "paramSnapshotWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorInvalidData"), "A snapshot with a wrong CRC is rejected");
+    cJSON_Delete (px_response);
+    free (pstri_extra);
+
+    /* A snapshot is exported to a file and imported from it */
+    px_response = px_SIM_Request ("paramSnapshotReadRequest", ",\"file\":\"sim_params.bin\"",
+                                  "paramSnapshotReadResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok") && (pstri_SIM_Get_String (px_response, "snapshot") == NULL) &&
+                 b_SIM_File_Exists ("sim_params.bin"), "paramSnapshotReadRequest writes a snapshot file");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":1,\"value\":\"other_psw\"}]",
+                                  "paramWriteResponse");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramSnapshotWriteRequest", ",\"file\":\"sim_params.bin\"",
+                                  "paramSnapshotWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok"), "paramSnapshotWriteRequest imports a snapshot file");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramReadRequest", ",\"pucs\":[1]", "paramReadResponse");
+    px_params = cJSON_GetObjectItem (px_response, "parameters");
+    pstri_value = cJSON_IsArray (px_params) ? pstri_SIM_Get_String (px_params->child, "value") : NULL;
+    v_SIM_Check ((pstri_value != NULL) && (strcmp (pstri_value, "sim_psw") == 0),
+                 "Snapshot file restores the previous value");
+    cJSON_Delete (px_response);
+
+    /* A transaction left open by a failing Python program is aborted when the program ends */
+    nlr_buf_t x_nlr;
+    if (nlr_push (&x_nlr) == 0)
+    {
+        x_MP_Param_Begin ();
+        x_MP_Param_Set (mp_obj_new_int (1), mp_obj_new_str ("script", 6));
+        x_MP_Param_Set (mp_obj_new_int (2457), mp_obj_new_int (0));
+        nlr_pop ();
+    }
+    v_SIM_Check (mp_obj_is_type (x_nlr.ret_val, &mp_type_ValueError), "Python program raises inside param.begin()");
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":1,\"value\":\"after_script\"}]",
+                                  "paramWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorBusy"),
+                 "paramWriteRequest is refused while the Python program runs its transaction");
+    cJSON_Delete (px_response);
+    v_MP_Param_Reset ();
+    px_response = px_SIM_Request ("paramWriteRequest", ",\"parameters\":[{\"puc\":1,\"value\":\"after_script\"}]",
+                                  "paramWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok"), "paramWriteRequest succeeds once the Python program ended");
+    cJSON_Delete (px_response);
+    px_response = px_SIM_Request ("paramReadRequest", ",\"pucs\":[1]", "paramReadResponse");
+    px_params = cJSON_GetObjectItem (px_response, "parameters");
+    pstri_value = cJSON_IsArray (px_params) ? pstri_SIM_Get_String (px_params->child, "value") : NULL;
+    v_SIM_Check ((pstri_value != NULL) && (strcmp (pstri_value, "after_script") == 0),
+                 "Value staged by the failed Python program is discarded");
+    cJSON_Delete (px_response);
+
+    /* A command repeating the exchange ID of the previous one is discarded */
+    v_SIM_Send_Command ("paramReadRequest", g_u32_eid, ",\"pucs\":[1]");
+    px_response = px_SIM_Receive_Json (g_stri_response_topic, "paramReadResponse", g_u32_eid, SIM_NO_REPLY_TIMEOUT_MS);
+    v_SIM_Check (px_response == NULL, "A repeated exchange ID is discarded");
+    cJSON_Delete (px_response);
+
+    /* A request without its mandatory data is rejected */
+    px_response = px_SIM_Request ("paramReadRequest", "", "paramReadResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorInvalidData"), "paramReadRequest without pucs is rejected");
+    cJSON_Delete (px_response);
+
+    /* Data messages delivered in small fragments are reassembled */
+    bool b_success = b_SIM_Upload ("sim_script.py", au8_script, u32_script_len, u32_script_checksum,
+                                   SIM_SMALL_FRAGMENT_SIZE);
+    v_SIM_Check (b_success, "File uploaded in fragments of %u bytes is stored", SIM_SMALL_FRAGMENT_SIZE);
+    v_SIM_Check (b_SIM_Download ("sim_script.py", au8_script, u32_script_len),
+                 "File uploaded in fragments is downloaded unchanged");
+
+    /* An existing file is not overwritten */
+    char stri_extra[128];
+    snprintf (stri_extra, sizeof (stri_extra), ",\"file\":\"sim_script.py\",\"size\":%u,\"checksum\":%u",
+              u32_script_len, u32_script_checksum);
+    px_response = px_SIM_Request ("fileUploadWriteRequest", stri_extra, "fileUploadWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorInvalidAccess"), "Upload of an existing file is rejected");
+    cJSON_Delete (px_response);
+
+    /* A file whose checksum doesn't match is not stored */
+    b_success = b_SIM_Upload ("sim_corrupted.py", au8_script, u32_script_len, ~u32_script_checksum, 0);
+    v_SIM_Check (!b_success, "Upload with a wrong checksum fails");
+    v_SIM_Check (!b_SIM_File_Exists ("sim_corrupted.py"), "File with a wrong checksum is not stored");
+
+    /* A missing file can't be downloaded */
+    px_response = px_SIM_Request ("fileDownloadReadRequest", ",\"file\":\"sim_missing.py\"",
+                                  "fileDownloadReadResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "errorInvalidAccess"), "Download of a missing file is rejected");
+    cJSON_Delete (px_response);
+
+    /* A file is deleted */
+    px_response = px_SIM_Request ("fileDeleteWriteRequest", ",\"file\":\"sim_script.py\"", "fileDeleteWriteResponse");
+    v_SIM_Check (b_SIM_Has_Status (px_response, "ok"), "fileDeleteWriteRequest succeeds");
+    cJSON_Delete (px_response);
+    v_SIM_Check (!b_SIM_File_Exists ("sim_script.py"), "Deleted file is not listed");
+
+    /* The device restarts on devResetPost */
+    uint32_t u32_num_restarts = u32_SIM_Get_Num_Restarts ();
+    v_SIM_Send_Command ("devResetPost", ++g_u32_eid, "");
+    int64_t s64_deadline = esp_timer_get_time () + (int64_t)SIM_REPLY_TIMEOUT_MS * 1000;
+    while ((u32_SIM_Get_Num_Restarts () == u32_num_restarts) && (esp_timer_get_time () < s64_deadline))
+    {
+        vTaskDelay (1);
+    }
+    v_SIM_Check (u32_SIM_Get_Num_Restarts () == u32_num_restarts + 1, "devResetPost restarts the device");
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Records the parameter changes notified to the simulator
+**
+** @param [in]
+**      pstru_change: The change
+**
+** @param [in]
+**      pv_arg: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg)
+{
+    g_u32_num_changes++;
+    if (pstru_change->enm_param_id == PARAM_MQTT_GROUP_ID)
+    {
+        snprintf (g_stri_old_group, sizeof (g_stri_old_group), "%s", (const char *)pstru_change->pv_old_value);
+        snprintf (g_stri_new_group, sizeof (g_stri_new_group), "%s", (const char *)pstru_change->pv_new_value);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Ignores the parameter changes, used to fill the subscriber table
+**
+** @param [in]
+**      pstru_change: The change
+**
+** @param [in]
+**      pv_arg: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Param_Ignore_Handler (const PARAM_change_t * pstru_change, void * pv_arg)
+{
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks that the realtime measurement store reads back the samples it stored
+**
+** @details
+**      The samples are flushed by groups of SIM_RTLOG_BLOCK_SAMPLES, so that each group is a block. The second
+**      measurement is missing from the first samples of each block, so that its first value in a block is encoded
+**      while another block has been filled since its previous value.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Run_Rt_Log_Checks (void)
+{
+    RTLOG_rt_meas_t     stru_meas;
+    SIM_rtlog_check_t   stru_check = { 0 };
+    uint8_t             au8_data[4 + RTLOG_NUM_MEAS * sizeof (int32_t)];
+    uint32_t            u32_num_samples = 0;
+    int32_t             s32_result = STATUS_ERR_NOT_INIT;
+
+    printf ("\nRunning realtime measurement store checks\n");
+
+    /* Wait until the store has loaded its segment files */
+    for (uint32_t u32_wait = 0; (u32_wait < SIM_REPLY_TIMEOUT_MS) && (s32_result == STATUS_ERR_NOT_INIT);
+         u32_wait += 10)
+    {
+        s32_result = s32_RTLOG_Store_Flush ();
+        if (s32_result == STATUS_ERR_NOT_INIT)
+        {
+            vTaskDelay (pdMS_TO_TICKS (10));
+        }
+    }
+    v_SIM_Check (s32_result == STATUS_OK, "Realtime measurement store is ready");
+
+    /* Store the samples as realtime measurement messages of the slave board */
+    for (uint32_t u32_sample = 0; u32_sample < SIM_RTLOG_NUM_SAMPLES; u32_sample++)
+    {
+        v_SIM_Get_Rt_Log_Sample (u32_sample, &stru_meas);
+        uint8_t u8_len = 4;
+        ENDIAN_PUT32 (au8_data, stru_meas.u32_meas_mask);
+        for (uint8_t u8_meas_id = 0; u8_meas_id < RTLOG_NUM_MEAS; u8_meas_id++)
+        {
+            if (stru_meas.u32_meas_mask & (1UL << u8_meas_id))
+            {
+                ENDIAN_PUT32 (&au8_data[u8_len], (uint32_t)stru_meas.as32_raw[u8_meas_id]);
+                u8_len += sizeof (int32_t);
+            }
+        }
+        v_RTLOG_Process_Log_Data (stru_meas.u32_timestamp, SIM_RTLOG_MSG_RT_MEAS, au8_data, u8_len);
+
+        if ((u32_sample % SIM_RTLOG_BLOCK_SAMPLES) == SIM_RTLOG_BLOCK_SAMPLES - 1)
+        {
+            s32_RTLOG_Store_Flush ();
+        }
+    }
+
+    /* Read them back */
+    s32_result = s32_RTLOG_Store_Query (SIM_RTLOG_START_TIME,
+                                        SIM_RTLOG_START_TIME + SIM_RTLOG_NUM_SAMPLES * SIM_RTLOG_INTERVAL,
+                                        RTLOG_ALL_MEAS, b_SIM_Check_Rt_Log_Sample, &stru_check, &u32_num_samples);
+    v_SIM_Check ((s32_result == STATUS_OK) && (stru_check.u32_num_samples == SIM_RTLOG_NUM_SAMPLES),
+                 "Realtime measurement store reads back %u samples (%u read)", SIM_RTLOG_NUM_SAMPLES,
+                 stru_check.u32_num_samples);
+    v_SIM_Check (stru_check.u32_num_errors == 0,
+                 "Measurements missing from the first samples of a block are read back (%u wrong samples)",
+                 stru_check.u32_num_errors);
+
+    /* Export them to a CSV file */
+    s32_result = s32_RTLOG_Store_Export (LFS_MOUNT_POINT "/" RTLOG_EXPORT_FILE, SIM_RTLOG_START_TIME,
+                                         SIM_RTLOG_START_TIME + SIM_RTLOG_NUM_SAMPLES * SIM_RTLOG_INTERVAL,
+                                         RTLOG_ALL_MEAS, &u32_num_samples);
+    v_SIM_Check ((s32_result == STATUS_OK) && (u32_num_samples == SIM_RTLOG_NUM_SAMPLES) &&
+                 b_SIM_File_Exists (RTLOG_EXPORT_FILE), "Realtime measurements are exported to a CSV file");
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a sample stored by the realtime measurement store check
+**
+** @param [in]
+**      u32_sample: Index of the sample
+**
+** @param [out]
+**      pstru_meas: The sample
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Get_Rt_Log_Sample (uint32_t u32_sample, RTLOG_rt_meas_t * pstru_meas)
+{
+    memset (pstru_meas, 0, sizeof (RTLOG_rt_meas_t));
+    pstru_meas->u32_timestamp = SIM_RTLOG_START_TIME + u32_sample * SIM_RTLOG_INTERVAL;
+
+    /* The first measurement is in every sample, the second one only in the last sample of each block */
+    pstru_meas->u32_meas_mask = 1UL << RTLOG_TOP_HEATER_TEMP;
+    pstru_meas->as32_raw[RTLOG_TOP_HEATER_TEMP] = 1000 * u32_sample + 7;
+    if ((u32_sample % SIM_RTLOG_BLOCK_SAMPLES) == SIM_RTLOG_BLOCK_SAMPLES - 1)
+    {
+        pstru_meas->u32_meas_mask |= 1UL << RTLOG_BTM_HEATER_TEMP;
+        pstru_meas->as32_raw[RTLOG_BTM_HEATER_TEMP] = -5000 - 37 * (int32_t)u32_sample;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Compares a sample read from the realtime measurement store with the one stored
+**
+** @param [in]
+**      pstru_meas: The sample read
+**
+** @param [in]
+**      pv_arg: Result of the check (SIM_rtlog_check_t)
+**
+** @return
+**      @arg    true: Continue reading the samples
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Check_Rt_Log_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg)
+{
+    SIM_rtlog_check_t * pstru_check = (SIM_rtlog_check_t *)pv_arg;
+    RTLOG_rt_meas_t     stru_expected;
+
+    v_SIM_Get_Rt_Log_Sample ((pstru_meas->u32_timestamp - SIM_RTLOG_START_TIME) / SIM_RTLOG_INTERVAL, &stru_expected);
+    bool b_ok = (pstru_meas->u32_timestamp == stru_expected.u32_timestamp) &&
+                (pstru_meas->u32_meas_mask == stru_expected.u32_meas_mask);
+    for (uint8_t u8_meas_id = 0; b_ok && (u8_meas_id < RTLOG_NUM_MEAS); u8_meas_id++)
+    {
+        if (stru_expected.u32_meas_mask & (1UL << u8_meas_id))
+        {
+            b_ok = (pstru_meas->as32_raw[u8_meas_id] == stru_expected.as32_raw[u8_meas_id]);
+        }
+    }
+
+    pstru_check->u32_num_samples++;
+    if (!b_ok)
+    {
+        pstru_check->u32_num_errors++;
+    }
+    return true;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,725 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_micropy.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Runtime of MicroPython reduced to the objects and exceptions used by the param module
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "py/runtime.h"                 /* Interface of MicroPython runtime */
+#include "py/objint.h"                  /* Interface of MicroPython integers */
+
+#include <stdio.h>                      /* Use fprintf() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Size in bytes of the heap of MicroPython, objects are never freed as there is no garbage collector */
+#define SIM_MP_HEAP_SIZE                    (64 * 1024)
+
+/** @brief  Range of the integers stored as small integers */
+#define SIM_MP_SMALL_INT_MIN                (INTPTR_MIN / 2)
+#define SIM_MP_SMALL_INT_MAX                (INTPTR_MAX / 2)
+
+/** @brief  An integer that doesn't fit in a small integer */
+typedef struct
+{
+    const mp_obj_type_t *   px_type;        //!< &mp_type_int
+    bool                    b_negative;     //!< The integer is negative
+    uint64_t                u64_magnitude;  //!< Absolute value of the integer
+} SIM_mp_int_t;
+
+/** @brief  A string or bytes object */
+typedef struct
+{
+    const mp_obj_type_t *   px_type;        //!< &mp_type_str or &mp_type_bytes
+    size_t                  x_len;          //!< Length in bytes of the data
+    char                    ac_data[];      //!< The data, followed by a null terminator
+} SIM_mp_str_t;
+
+/** @brief  A tuple */
+typedef struct
+{
+    const mp_obj_type_t *   px_type;        //!< &mp_type_tuple
+    size_t                  x_len;          //!< Number of items
+    mp_obj_t                ax_items[];     //!< The items
+} SIM_mp_tuple_t;
+
+/** @brief  An exception */
+typedef struct
+{
+    const mp_obj_type_t *   px_type;        //!< Type of the exception
+    const char *            pstri_msg;      //!< Message of the exception
+} SIM_mp_exc_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/* Types of the objects */
+const mp_obj_type_t mp_type_int = { "int" };
+const mp_obj_type_t mp_type_str = { "str" };
+const mp_obj_type_t mp_type_bytes = { "bytes" };
+const mp_obj_type_t mp_type_tuple = { "tuple" };
+const mp_obj_type_t mp_type_OSError = { "OSError" };
+const mp_obj_type_t mp_type_MemoryError = { "MemoryError" };
+const mp_obj_type_t mp_type_TypeError = { "TypeError" };
+const mp_obj_type_t mp_type_ValueError = { "ValueError" };
+static const mp_obj_type_t g_stru_type_overflow_error = { "OverflowError" };
+static const mp_obj_type_t g_stru_type_none = { "NoneType" };
+static const mp_obj_type_t g_stru_type_bool = { "bool" };
+
+/* Constant objects */
+const mp_obj_type_t * const mp_const_none_obj = &g_stru_type_none;
+const mp_obj_type_t * const mp_const_false_obj = &g_stru_type_bool;
+const mp_obj_type_t * const mp_const_true_obj = &g_stru_type_bool;
+
+/** @brief  Heap of MicroPython */
+static _Alignas (16) uint8_t g_au8_heap[SIM_MP_HEAP_SIZE];
+
+/** @brief  Number of bytes of the heap allocated */
+static size_t g_x_heap_used = 0;
+
+/** @brief  Innermost return point set by nlr_push() */
+static _Thread_local nlr_buf_t * g_px_nlr_top = NULL;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void * pv_SIM_Mp_Alloc (size_t x_size);
+static void v_SIM_Mp_Get_Int (mp_obj_t x_obj, bool * pb_negative, uint64_t * pu64_magnitude);
+static mp_obj_t x_SIM_Mp_New_Str (const mp_obj_type_t * px_type, const void * pv_data, size_t x_len);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets a return point, called by nlr_push() before saving the context with setjmp()
+**
+** @param [in]
+**      px_nlr: The return point
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nlr_push_tail (nlr_buf_t * px_nlr)
+{
+    px_nlr->prev = g_px_nlr_top;
+    g_px_nlr_top = px_nlr;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Removes the innermost return point, when the code it protects has returned without exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nlr_pop (void)
+{
+    g_px_nlr_top = g_px_nlr_top->prev;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Raises an exception, the execution continues at the innermost return point. The simulator stops if there is
+**      none, as MicroPython would do.
+**
+** @param [in]
+**      pv_exc: The exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nlr_jump (void * pv_exc)
+{
+    nlr_buf_t * px_nlr = g_px_nlr_top;
+    if (px_nlr == NULL)
+    {
+        fprintf (stderr, "Uncaught MicroPython exception: %s\n", pstri_SIM_Mp_Get_Exception_Msg (pv_exc));
+        abort ();
+    }
+    g_px_nlr_top = px_nlr->prev;
+    px_nlr->ret_val = pv_exc;
+    longjmp (px_nlr->jmpbuf, 1);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Raises an exception of a given type
+**
+** @param [in]
+**      px_type: Type of the exception
+**
+** @param [in]
+**      pstri_msg: Message of the exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_raise_msg (const mp_obj_type_t * px_type, const char * pstri_msg)
+{
+    SIM_mp_exc_t * pstru_exc = pv_SIM_Mp_Alloc (sizeof (SIM_mp_exc_t));
+    pstru_exc->px_type = px_type;
+    pstru_exc->pstri_msg = pstri_msg;
+    nlr_jump (pstru_exc);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Raises a ValueError exception
+**
+** @param [in]
+**      pstri_msg: Message of the exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_raise_ValueError (const char * pstri_msg)
+{
+    mp_raise_msg (&mp_type_ValueError, pstri_msg);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Raises a TypeError exception
+**
+** @param [in]
+**      pstri_msg: Message of the exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_raise_TypeError (const char * pstri_msg)
+{
+    mp_raise_msg (&mp_type_TypeError, pstri_msg);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets message of an exception
+**
+** @param [in]
+**      pv_exc: The exception
+**
+** @return
+**      @arg    Message of the exception
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+const char * pstri_SIM_Mp_Get_Exception_Msg (void * pv_exc)
+{
+    return ((SIM_mp_exc_t *)pv_exc)->pstri_msg;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates an integer object from a signed value
+**
+** @param [in]
+**      x_value: The value
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_int (mp_int_t x_value)
+{
+    return mp_obj_new_int_from_ll (x_value);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates an integer object from an unsigned value
+**
+** @param [in]
+**      x_value: The value
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_int_from_uint (mp_uint_t x_value)
+{
+    return mp_obj_new_int_from_ull (x_value);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates an integer object from a signed 64-bit value
+**
+** @param [in]
+**      s64_value: The value
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_int_from_ll (long long s64_value)
+{
+    if ((s64_value >= SIM_MP_SMALL_INT_MIN) && (s64_value <= SIM_MP_SMALL_INT_MAX))
+    {
+        return (mp_obj_t)(((mp_uint_t)s64_value << 1) | 1);
+    }
+
+    SIM_mp_int_t * pstru_int = pv_SIM_Mp_Alloc (sizeof (SIM_mp_int_t));
+    pstru_int->px_type = &mp_type_int;
+    pstru_int->b_negative = (s64_value < 0);
+    pstru_int->u64_magnitude = (s64_value < 0) ? (0 - (uint64_t)s64_value) : (uint64_t)s64_value;
+    return pstru_int;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates an integer object from an unsigned 64-bit value
+**
+** @param [in]
+**      u64_value: The value
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_int_from_ull (unsigned long long u64_value)
+{
+    if (u64_value <= SIM_MP_SMALL_INT_MAX)
+    {
+        return (mp_obj_t)(((mp_uint_t)u64_value << 1) | 1);
+    }
+
+    SIM_mp_int_t * pstru_int = pv_SIM_Mp_Alloc (sizeof (SIM_mp_int_t));
+    pstru_int->px_type = &mp_type_int;
+    pstru_int->b_negative = false;
+    pstru_int->u64_magnitude = u64_value;
+    return pstru_int;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a string object
+**
+** @param [in]
+**      pstri_data: Data of the string
+**
+** @param [in]
+**      x_len: Length in bytes of the data
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_str (const char * pstri_data, size_t x_len)
+{
+    return x_SIM_Mp_New_Str (&mp_type_str, pstri_data, x_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a bytes object
+**
+** @param [in]
+**      pu8_data: Data of the object
+**
+** @param [in]
+**      x_len: Length in bytes of the data
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_bytes (const byte * pu8_data, size_t x_len)
+{
+    return x_SIM_Mp_New_Str (&mp_type_bytes, pu8_data, x_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a tuple object
+**
+** @param [in]
+**      x_len: Number of items
+**
+** @param [in]
+**      px_items: The items, NULL for an empty tuple
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_obj_t mp_obj_new_tuple (size_t x_len, const mp_obj_t * px_items)
+{
+    SIM_mp_tuple_t * pstru_tuple = pv_SIM_Mp_Alloc (sizeof (SIM_mp_tuple_t) + x_len * sizeof (mp_obj_t));
+    pstru_tuple->px_type = &mp_type_tuple;
+    pstru_tuple->x_len = x_len;
+    if (x_len > 0)
+    {
+        memcpy (pstru_tuple->ax_items, px_items, x_len * sizeof (mp_obj_t));
+    }
+    return pstru_tuple;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an integer object, raises an exception if it is not an integer or doesn't fit in mp_int_t
+**
+** @param [in]
+**      x_obj: The object
+**
+** @return
+**      @arg    The value
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_int_t mp_obj_get_int (mp_obj_t x_obj)
+{
+    bool b_negative;
+    uint64_t u64_magnitude;
+    v_SIM_Mp_Get_Int (x_obj, &b_negative, &u64_magnitude);
+    if (u64_magnitude > (b_negative ? (uint64_t)INTPTR_MAX + 1 : (uint64_t)INTPTR_MAX))
+    {
+        mp_raise_msg (&g_stru_type_overflow_error, "overflow converting long int to machine word");
+    }
+    return b_negative ? (mp_int_t)(0 - u64_magnitude) : (mp_int_t)u64_magnitude;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an integer object, raises an exception if it is negative or doesn't fit in mp_uint_t
+**
+** @param [in]
+**      x_obj: The object
+**
+** @return
+**      @arg    The value
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+mp_uint_t mp_obj_int_get_uint_checked (mp_obj_t x_obj)
+{
+    bool b_negative;
+    uint64_t u64_magnitude;
+    v_SIM_Mp_Get_Int (x_obj, &b_negative, &u64_magnitude);
+    if (b_negative || (u64_magnitude > UINTPTR_MAX))
+    {
+        mp_raise_msg (&g_stru_type_overflow_error, "overflow converting long int to machine word");
+    }
+    return (mp_uint_t)u64_magnitude;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes an integer object to a buffer as two's complement
+**
+** @param [in]
+**      x_obj: The object
+**
+** @param [in]
+**      b_big_endian: Writes the most significant byte first
+**
+** @param [in]
+**      x_len: Size in bytes of the buffer
+**
+** @param [out]
+**      pu8_buf: The buffer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_obj_int_to_bytes_impl (mp_obj_t x_obj, bool b_big_endian, size_t x_len, byte * pu8_buf)
+{
+    bool b_negative;
+    uint64_t u64_magnitude;
+    v_SIM_Mp_Get_Int (x_obj, &b_negative, &u64_magnitude);
+    uint64_t u64_value = b_negative ? (0 - u64_magnitude) : u64_magnitude;
+    for (size_t x_idx = 0; x_idx < x_len; x_idx++)
+    {
+        byte u8_byte = (x_idx < sizeof (u64_value)) ? (byte)(u64_value >> (8 * x_idx)) : (b_negative ? 0xFF : 0);
+        pu8_buf[b_big_endian ? (x_len - 1 - x_idx) : x_idx] = u8_byte;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets data of a string object, raises an exception if it is not a string
+**
+** @param [in]
+**      x_obj: The object
+**
+** @return
+**      @arg    The null-terminated data
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+const char * mp_obj_str_get_str (mp_obj_t x_obj)
+{
+    if (!mp_obj_is_str (x_obj))
+    {
+        mp_raise_TypeError ("can't convert to str implicitly");
+    }
+    return ((SIM_mp_str_t *)x_obj)->ac_data;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets items of a tuple object, raises an exception if it is not a tuple
+**
+** @param [in]
+**      x_obj: The object
+**
+** @param [out]
+**      px_len: Number of items
+**
+** @param [out]
+**      ppx_items: The items
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_obj_get_array (mp_obj_t x_obj, size_t * px_len, mp_obj_t ** ppx_items)
+{
+    if (!mp_obj_is_type (x_obj, &mp_type_tuple))
+    {
+        mp_raise_TypeError ("object isn't a tuple");
+    }
+    *px_len = ((SIM_mp_tuple_t *)x_obj)->x_len;
+    *ppx_items = ((SIM_mp_tuple_t *)x_obj)->ax_items;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets data of a string or bytes object, raises an exception if it is neither
+**
+** @param [in]
+**      x_obj: The object
+**
+** @param [out]
+**      pstru_buffer: Data of the object
+**
+** @param [in]
+**      s32_flags: Access requested, only reading is simulated
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void mp_get_buffer_raise (mp_obj_t x_obj, mp_buffer_info_t * pstru_buffer, int s32_flags)
+{
+    if (!mp_obj_is_str (x_obj) && !mp_obj_is_type (x_obj, &mp_type_bytes))
+    {
+        mp_raise_TypeError ("object with buffer protocol required");
+    }
+    pstru_buffer->buf = ((SIM_mp_str_t *)x_obj)->ac_data;
+    pstru_buffer->len = ((SIM_mp_str_t *)x_obj)->x_len;
+    pstru_buffer->typecode = 'B';
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Compares two objects, integers are compared by value, strings and bytes by data, others by identity
+**
+** @param [in]
+**      x_obj1: First object
+**
+** @param [in]
+**      x_obj2: Second object
+**
+** @return
+**      @arg    true: The objects are equal
+**      @arg    false: The objects differ
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+bool mp_obj_equal (mp_obj_t x_obj1, mp_obj_t x_obj2)
+{
+    if (x_obj1 == x_obj2)
+    {
+        return true;
+    }
+    if (mp_obj_is_int (x_obj1) && mp_obj_is_int (x_obj2))
+    {
+        bool b_negative1, b_negative2;
+        uint64_t u64_magnitude1, u64_magnitude2;
+        v_SIM_Mp_Get_Int (x_obj1, &b_negative1, &u64_magnitude1);
+        v_SIM_Mp_Get_Int (x_obj2, &b_negative2, &u64_magnitude2);
+        return (b_negative1 == b_negative2) && (u64_magnitude1 == u64_magnitude2);
+    }
+    if ((mp_obj_is_str (x_obj1) && mp_obj_is_str (x_obj2)) ||
+        (mp_obj_is_type (x_obj1, &mp_type_bytes) && mp_obj_is_type (x_obj2, &mp_type_bytes)))
+    {
+        SIM_mp_str_t * pstru_str1 = x_obj1;
+        SIM_mp_str_t * pstru_str2 = x_obj2;
+        return (pstru_str1->x_len == pstru_str2->x_len) &&
+               (memcmp (pstru_str1->ac_data, pstru_str2->ac_data, pstru_str1->x_len) == 0);
+    }
+    return false;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates memory from the heap of MicroPython, raises MemoryError if the heap is full
+**
+** @param [in]
+**      x_size: Size in bytes of the memory
+**
+** @return
+**      @arg    The memory, zeroed
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void * pv_SIM_Mp_Alloc (size_t x_size)
+{
+    x_size = (x_size + 15) & ~(size_t)15;
+    if (x_size > SIM_MP_HEAP_SIZE - g_x_heap_used)
+    {
+        /* This exception can't be allocated from the heap */
+        static SIM_mp_exc_t stru_memory_error = { &mp_type_MemoryError, "memory allocation failed" };
+        nlr_jump (&stru_memory_error);
+    }
+    void * pv_mem = &g_au8_heap[g_x_heap_used];
+    g_x_heap_used += x_size;
+    memset (pv_mem, 0, x_size);
+    return pv_mem;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets sign and absolute value of an integer object, raises an exception if it is not an integer
+**
+** @param [in]
+**      x_obj: The object
+**
+** @param [out]
+**      pb_negative: The integer is negative
+**
+** @param [out]
+**      pu64_magnitude: Absolute value of the integer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_SIM_Mp_Get_Int (mp_obj_t x_obj, bool * pb_negative, uint64_t * pu64_magnitude)
+{
+    if (mp_obj_is_small_int (x_obj))
+    {
+        mp_int_t x_value = MP_OBJ_SMALL_INT_VALUE (x_obj);
+        *pb_negative = (x_value < 0);
+        *pu64_magnitude = (x_value < 0) ? (0 - (uint64_t)x_value) : (uint64_t)x_value;
+    }
+    else if (mp_obj_is_type (x_obj, &mp_type_int))
+    {
+        *pb_negative = ((SIM_mp_int_t *)x_obj)->b_negative;
+        *pu64_magnitude = ((SIM_mp_int_t *)x_obj)->u64_magnitude;
+    }
+    else
+    {
+        mp_raise_TypeError ("can't convert to int");
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Creates a string or bytes object
+**
+** @param [in]
+**      px_type: &mp_type_str or &mp_type_bytes
+**
+** @param [in]
+**      pv_data: Data of the object
+**
+** @param [in]
+**      x_len: Length in bytes of the data
+**
+** @return
+**      @arg    The object
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static mp_obj_t x_SIM_Mp_New_Str (const mp_obj_type_t * px_type, const void * pv_data, size_t x_len)
+{
+    SIM_mp_str_t * pstru_str = pv_SIM_Mp_Alloc (sizeof (SIM_mp_str_t) + x_len + 1);
+    pstru_str->px_type = px_type;
+    pstru_str->x_len = x_len;
+    memcpy (pstru_str->ac_data, pv_data, x_len);
+    return pstru_str;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
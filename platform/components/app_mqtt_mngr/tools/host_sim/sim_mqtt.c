@@ -0,0 +1,1055 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_mqtt.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Srvc_Mqtt simulated by an in-process broker routing the messages between the simulated device and
+**                the back-office
+**  @namespace  : MQTT
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sim.h"                        /* Interfaces between the modules of the simulator */
+#include "srvc_mqtt.h"                  /* Public header of Srvc_Mqtt */
+
+#include <string.h>                     /* Use memcpy(), strlen(), etc. */
+#include <pthread.h>                    /* Use POSIX mutex */
+
+#include "freertos/FreeRTOS.h"          /* Use FreeRTOS */
+#include "freertos/task.h"              /* Use FreeRTOS task */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @brief   Number of requests the broker task can queue. The callbacks run by the broker task queue requests too (e.g.
+**          acknowledgements of enqueued data), so the queue must never be filled by the back-office.
+*/
+#define MQTT_BROKER_QUEUE_LEN       1024
+
+/**
+** @brief   Number of messages published by the simulated device that can wait for the back-office. The device blocks
+**          when the queue is full, as it would when the network is congested.
+*/
+#define MQTT_BACKOFFICE_QUEUE_LEN   1024
+
+/** @brief  Stack size (in bytes) of the broker task, which runs the callbacks as the task of the MQTT client does */
+#define MQTT_BROKER_TASK_STACK_SIZE 6144
+
+/** @brief  Priority of the broker task */
+#define MQTT_BROKER_TASK_PRIORITY   (tskIDLE_PRIORITY + 5)
+
+/**
+** @brief   Number of bytes of the receive buffer of esp-mqtt taken by the fixed header, the topic length and the
+**          message ID of a received PUBLISH packet
+*/
+#define MQTT_PUBLISH_OVERHEAD       9
+
+/** @brief  Structure wrapping properties of a publish topic */
+typedef struct
+{
+    uint32_t                    u32_topic_id;       //!< Index of this topic in publish topic table
+    uint8_t                     u8_qos;             //!< Quality of service, which is 0, 1 or 2
+    bool                        b_retained;         //!< Specifies the retain flag
+    const char *                pstri_topic;        //!< The topic
+} MQTT_pub_topic_t;
+
+/** @brief  Macro expanding an entry in publish topic table as initialization values for MQTT_pub_topic_t struct */
+#define PUB_TOPIC_TABLE_EXPAND_AS_STRUCT_INIT(TOPIC_ID, QOS, RETAIN, TOPIC)     \
+{                                                                               \
+    .u32_topic_id               = TOPIC_ID,                                     \
+    .u8_qos                     = QOS,                                          \
+    .b_retained                 = RETAIN,                                       \
+    .pstri_topic                = TOPIC,                                        \
+},
+
+/** @brief  Structure wrapping properties of a subcribe topic */
+typedef struct
+{
+    uint32_t                    u32_topic_id;       //!< Index of this topic in subcribe topic table
+    uint8_t                     u8_qos;             //!< Quality of service, which is 0, 1 or 2
+    const char *                pstri_topic;        //!< The topic
+} MQTT_sub_topic_t;
+
+/** @brief  Macro expanding an entry in subcribe topic table as initialization values for MQTT_sub_topic_t struct */
+#define SUB_TOPIC_TABLE_EXPAND_AS_STRUCT_INIT(TOPIC_ID, QOS, TOPIC)             \
+{                                                                               \
+    .u32_topic_id               = TOPIC_ID,                                     \
+    .u8_qos                     = QOS,                                          \
+    .pstri_topic                = TOPIC,                                        \
+},
+
+/** @brief  Structure wrapping data of an MQTT client object */
+struct MQTT_obj
+{
+    MQTT_inst_id_t              enm_inst_id;        //!< Instance ID of this object
+    bool                        b_started;          //!< Indicates if MQTT client is running
+    MQTT_callback_t             pfnc_cb;            //!< Callback invoked when an event occurs
+    void *                      pv_cb_arg;          //!< Argument passed when the callback function was registered
+
+    MQTT_config_t               stru_config;        //!< Configuration of the client
+    uint32_t                    u32_tx_buf_size;    //!< Size in bytes of the transmit buffer
+    uint32_t                    u32_rx_buf_size;    //!< Size in bytes of the receive buffer
+
+    uint8_t                     u8_num_pub_topics;  //!< Number of publish topics
+    MQTT_pub_topic_t *          pstru_pub_topics;   //!< Pointer to array of publish topics
+
+    uint8_t                     u8_num_sub_topics;  //!< Number of subcribe topics
+    MQTT_sub_topic_t *          pstru_sub_topics;   //!< Pointer to array of subcribe topics
+
+    int32_t                     s32_last_msg_id;    //!< Last message ID returned by enm_MQTT_Enqueue()
+    uint32_t                    u32_outbox_bytes;   //!< Number of bytes enqueued and not acknowledged yet
+};
+
+/** @brief  Macro expanding MQTT_INST_TABLE as initialization values for MQTT_obj struct */
+#define INST_TABLE_EXPAND_AS_INST_STRUCT_INIT(INST_ID, PUB_TOPICS, SUB_TOPICS, URI, IP, PORT,           \
+                                              USERNAME, PASSWORD, LWT_MSG, LWT_ID, TX_BUF, RX_BUF)      \
+{                                                                                                       \
+    .enm_inst_id                = INST_ID,                                                              \
+    .b_started                  = false,                                                                \
+    .pfnc_cb                    = NULL,                                                                 \
+    .pv_cb_arg                  = NULL,                                                                 \
+                                                                                                        \
+    .stru_config                =                                                                       \
+    {                                                                                                   \
+        .stri_uri               = URI,                                                                  \
+        .stri_ip                = IP,                                                                   \
+        .u16_port               = PORT,                                                                 \
+        .stri_username          = USERNAME,                                                             \
+        .stri_password          = PASSWORD,                                                             \
+        .stri_lwt_msg           = LWT_MSG,                                                              \
+        .u32_lwt_topic_id       = LWT_ID,                                                               \
+    },                                                                                                  \
+    .u32_tx_buf_size            = TX_BUF,                                                               \
+    .u32_rx_buf_size            = RX_BUF,                                                               \
+                                                                                                        \
+    .u8_num_pub_topics          = sizeof (g_astru_pub_topic_##INST_ID) / sizeof (MQTT_pub_topic_t),     \
+    .pstru_pub_topics           = g_astru_pub_topic_##INST_ID,                                          \
+                                                                                                        \
+    .u8_num_sub_topics          = sizeof (g_astru_sub_topic_##INST_ID) / sizeof (MQTT_sub_topic_t),     \
+    .pstru_sub_topics           = g_astru_sub_topic_##INST_ID,                                          \
+},
+
+/** @brief  Request processed by the broker task */
+typedef struct
+{
+    /** @brief  Type of the request */
+    enum
+    {
+        MQTT_BROKER_CONNECT,                        //!< Connects a client
+        MQTT_BROKER_DISCONNECT,                     //!< Disconnects a client
+        MQTT_BROKER_DELIVER,                        //!< Delivers a message of the back-office to the clients
+        MQTT_BROKER_ACK,                            //!< Acknowledges a message enqueued by a client
+    } enm_type;
+
+    MQTT_inst_t                 x_inst;             //!< The client (except for MQTT_BROKER_DELIVER)
+    SIM_msg_t *                 pstru_msg;          //!< The message (MQTT_BROKER_DELIVER and MQTT_BROKER_ACK)
+} MQTT_broker_req_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+static const char * TAG = "Srvc_Mqtt";
+
+/** @brief  Indicates if this module has been initialized */
+static bool g_b_initialized = false;
+
+/**
+** @brief   Arrays of all publish topics of all MQTT clients, one array for one client
+** @note    These arrays should not be used directly but via .pstru_pub_topics member of MQTT objects
+*/
+#define INST_TABLE_EXPAND_AS_PUB_TOPIC_ARRAY_DECLARE(INST_ID, PUB_TOPICS, SUB_TOPICS, ...)  \
+    static MQTT_pub_topic_t g_astru_pub_topic_##INST_ID [] = { PUB_TOPICS (PUB_TOPIC_TABLE_EXPAND_AS_STRUCT_INIT) };
+MQTT_INST_TABLE (INST_TABLE_EXPAND_AS_PUB_TOPIC_ARRAY_DECLARE)
+
+/**
+** @brief   Arrays of all subcribe topics of all MQTT clients, one array for one client
+** @note    These arrays should not be used directly but via .pstru_sub_topics member of MQTT objects
+*/
+#define INST_TABLE_EXPAND_AS_SUB_TOPIC_ARRAY_DECLARE(INST_ID, PUB_TOPICS, SUB_TOPICS, ...)  \
+    static MQTT_sub_topic_t g_astru_sub_topic_##INST_ID [] = { SUB_TOPICS (SUB_TOPIC_TABLE_EXPAND_AS_STRUCT_INIT) };
+MQTT_INST_TABLE (INST_TABLE_EXPAND_AS_SUB_TOPIC_ARRAY_DECLARE)
+
+/** @brief  Array of all MQTT client objects */
+static struct MQTT_obj g_astru_mqtt_objs[MQTT_NUM_INST] =
+{
+    MQTT_INST_TABLE (INST_TABLE_EXPAND_AS_INST_STRUCT_INIT)
+};
+
+/** @brief  Queue of the requests processed by the broker task */
+static QueueHandle_t g_x_broker_queue = NULL;
+
+/** @brief  Queue of the messages published by the clients and waiting for the back-office */
+static QueueHandle_t g_x_backoffice_queue = NULL;
+
+/** @brief  Size of the fragments in which messages are delivered, 0 to use the receive buffer size of the clients */
+static uint32_t g_u32_fragment_size = 0;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void v_MQTT_Init_Module (void);
+static void v_MQTT_Broker_Task (void * pv_param);
+static void v_MQTT_Deliver (MQTT_inst_t x_inst, const SIM_msg_t * pstru_msg);
+static bool b_MQTT_Topic_Matches (const char * pstri_filter, const char * pstri_topic);
+static SIM_msg_t * pstru_MQTT_Alloc_Msg (const char * pstri_topic, const void * pv_data, uint32_t u32_len);
+static MQTT_status_t enm_MQTT_Publish_Msg (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, const void * pv_data,
+                                           uint32_t u32_len, int32_t s32_msg_id);
+static void v_MQTT_Send_Broker_Req (int enm_type, MQTT_inst_t x_inst, SIM_msg_t * pstru_msg);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets instance of an MQTT client
+**
+** @param [in]
+**      enm_inst_id: ID of the client
+**
+** @return
+**      @arg    NULL: The ID is invalid
+**      @arg    Otherwise: Instance of the client
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_inst_t x_MQTT_Get_Inst (MQTT_inst_id_t enm_inst_id)
+{
+    if (enm_inst_id >= MQTT_NUM_INST)
+    {
+        return NULL;
+    }
+    v_MQTT_Init_Module ();
+    return &g_astru_mqtt_objs[enm_inst_id];
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets current configuration of an MQTT client
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [out]
+**      pstru_config: The configuration
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MQTT_Get_Config (MQTT_inst_t x_inst, MQTT_config_t * pstru_config)
+{
+    *pstru_config = x_inst->stru_config;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets size in bytes of the transmit buffer of an MQTT client
+**
+** @param [in]
+**      x_inst: The client
+**
+** @return
+**      Size in bytes
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Tx_Buffer_Size (MQTT_inst_t x_inst)
+{
+    return x_inst->u32_tx_buf_size;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of bytes of the data enqueued by an MQTT client and not acknowledged by the broker yet
+**
+** @param [in]
+**      x_inst: The client
+**
+** @return
+**      Number of bytes
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Outbox_Size (MQTT_inst_t x_inst)
+{
+    return __atomic_load_n (&x_inst->u32_outbox_bytes, __ATOMIC_SEQ_CST);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of bytes of the data posted to an MQTT client and not published yet. The in-process broker is always
+**      connected, posted data is published immediately.
+**
+** @param [in]
+**      x_inst: The client
+**
+** @return
+**      0
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Posted_Size (MQTT_inst_t x_inst)
+{
+    return 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Configures an MQTT client
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      pstru_config: The configuration
+**
+** @return
+**      @arg    MQTT_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Set_Config (MQTT_inst_t x_inst, MQTT_config_t * pstru_config)
+{
+    x_inst->stru_config = *pstru_config;
+    return MQTT_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Changes a publish topic, pstri_topic must be static (i.e not in stack memory)
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic in publish topic table
+**
+** @param [in]
+**      pstri_topic: The topic
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MQTT_Set_Publish_Topic (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, const char * pstri_topic)
+{
+    ASSERT_PARAM (u32_pub_topic_id < x_inst->u8_num_pub_topics);
+    x_inst->pstru_pub_topics[u32_pub_topic_id].pstri_topic = pstri_topic;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Changes a subscribe topic, pstri_topic must be static (i.e not in stack memory)
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_sub_topic_id: Index of the topic in subscribe topic table
+**
+** @param [in]
+**      pstri_topic: The topic
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MQTT_Set_Subscribe_Topic (MQTT_inst_t x_inst, uint32_t u32_sub_topic_id, const char * pstri_topic)
+{
+    ASSERT_PARAM (u32_sub_topic_id < x_inst->u8_num_sub_topics);
+    x_inst->pstru_sub_topics[u32_sub_topic_id].pstri_topic = pstri_topic;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Registers a callback function invoked when an event occurs to an MQTT client
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      pfnc_cb: The callback, invoked by the broker task
+**
+** @param [in]
+**      pv_arg: Argument passed to the callback
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_MQTT_Register_Callback (MQTT_inst_t x_inst, MQTT_callback_t pfnc_cb, void * pv_arg)
+{
+    x_inst->pfnc_cb = pfnc_cb;
+    x_inst->pv_cb_arg = pv_arg;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts an MQTT client, which connects to the in-process broker
+**
+** @param [in]
+**      x_inst: The client
+**
+** @return
+**      @arg    MQTT_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Start_Inst (MQTT_inst_t x_inst)
+{
+    if (!x_inst->b_started)
+    {
+        x_inst->b_started = true;
+        v_MQTT_Send_Broker_Req (MQTT_BROKER_CONNECT, x_inst, NULL);
+    }
+    return MQTT_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Stops an MQTT client
+**
+** @param [in]
+**      x_inst: The client
+**
+** @return
+**      @arg    MQTT_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Stop_Inst (MQTT_inst_t x_inst)
+{
+    if (x_inst->b_started)
+    {
+        x_inst->b_started = false;
+        v_MQTT_Send_Broker_Req (MQTT_BROKER_DISCONNECT, x_inst, NULL);
+    }
+    return MQTT_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Publishes data to a topic
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic in publish topic table
+**
+** @param [in]
+**      pv_data: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Publish (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, const void * pv_data, uint32_t u32_len)
+{
+    return enm_MQTT_Publish_Msg (x_inst, u32_pub_topic_id, pv_data, u32_len, 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Queues data to publish to a topic without blocking. The broker acknowledges data of QoS 1 or 2 with event
+**      MQTT_EVT_PUBLISHED.
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic in publish topic table
+**
+** @param [in]
+**      pv_data: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @param [out]
+**      ps32_msg_id: Message ID of the data, 0 for QoS 0
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Enqueue (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id,
+                                const void * pv_data, uint32_t u32_len, int32_t * ps32_msg_id)
+{
+    ASSERT_PARAM (u32_pub_topic_id < x_inst->u8_num_pub_topics);
+
+    int32_t s32_msg_id = 0;
+    if (x_inst->pstru_pub_topics[u32_pub_topic_id].u8_qos > 0)
+    {
+        s32_msg_id = __atomic_add_fetch (&x_inst->s32_last_msg_id, 1, __ATOMIC_SEQ_CST);
+    }
+    if (ps32_msg_id != NULL)
+    {
+        *ps32_msg_id = s32_msg_id;
+    }
+    return enm_MQTT_Publish_Msg (x_inst, u32_pub_topic_id, pv_data, u32_len, s32_msg_id);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Posts data to publish to a topic. The in-process broker is always connected, the data is published immediately
+**      and the priority and coalescing key are not used.
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic in publish topic table
+**
+** @param [in]
+**      enm_prio: Priority of the data
+**
+** @param [in]
+**      u32_key: Coalescing key of the data
+**
+** @param [in]
+**      pv_data: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Post (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, MQTT_priority_t enm_prio,
+                             uint32_t u32_key, const void * pv_data, uint32_t u32_len)
+{
+    ASSERT_PARAM (enm_prio < MQTT_NUM_PRIOS);
+    return enm_MQTT_Publish_Msg (x_inst, u32_pub_topic_id, pv_data, u32_len, 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a message from the back-office to the broker, which delivers it to the clients subscribing to its topic
+**
+** @param [in]
+**      pstri_topic: Topic of the message
+**
+** @param [in]
+**      pv_data: Data of the message
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_SIM_Mqtt_Send (const char * pstri_topic, const void * pv_data, uint32_t u32_len)
+{
+    v_MQTT_Init_Module ();
+
+    SIM_msg_t * pstru_msg = pstru_MQTT_Alloc_Msg (pstri_topic, pv_data, u32_len);
+    if (pstru_msg == NULL)
+    {
+        return STATUS_ERR;
+    }
+    v_MQTT_Send_Broker_Req (MQTT_BROKER_DELIVER, NULL, pstru_msg);
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Waits for a message published by the clients
+**
+** @param [in]
+**      u32_timeout_ms: Maximum time to wait
+**
+** @return
+**      @arg    NULL: No message has been published
+**      @arg    Otherwise: The message, which must be freed with v_SIM_Mqtt_Free()
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+SIM_msg_t * pstru_SIM_Mqtt_Receive (uint32_t u32_timeout_ms)
+{
+    v_MQTT_Init_Module ();
+
+    SIM_msg_t * pstru_msg = NULL;
+    TickType_t x_ticks = (u32_timeout_ms == 0) ? 0 : pdMS_TO_TICKS (u32_timeout_ms) + 1;
+    xQueueReceive (g_x_backoffice_queue, &pstru_msg, x_ticks);
+    return pstru_msg;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Frees a message returned by pstru_SIM_Mqtt_Receive()
+**
+** @param [in]
+**      pstru_msg: The message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Mqtt_Free (SIM_msg_t * pstru_msg)
+{
+    free (pstru_msg);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets size of the fragments in which the broker delivers messages to the clients
+**
+** @param [in]
+**      u32_size: Size in bytes of the fragments, 0 to split messages as esp-mqtt does with the receive buffer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Mqtt_Set_Fragment_Size (uint32_t u32_size)
+{
+    __atomic_store_n (&g_u32_fragment_size, u32_size, __ATOMIC_SEQ_CST);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Initializes this module the first time it is used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTT_Init_Module (void)
+{
+    static pthread_mutex_t x_init_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+    pthread_mutex_lock (&x_init_mutex);
+    if (!g_b_initialized)
+    {
+        /* The broker is not part of the simulated device */
+        bool b_counted = b_SIM_Heap_Set_Counted (false);
+        g_x_broker_queue = xQueueCreate (MQTT_BROKER_QUEUE_LEN, sizeof (MQTT_broker_req_t));
+        g_x_backoffice_queue = xQueueCreate (MQTT_BACKOFFICE_QUEUE_LEN, sizeof (SIM_msg_t *));
+        b_SIM_Heap_Set_Counted (b_counted);
+        ASSERT_PARAM ((g_x_broker_queue != NULL) && (g_x_backoffice_queue != NULL));
+
+        xTaskCreatePinnedToCore (v_MQTT_Broker_Task, "mqtt_task", MQTT_BROKER_TASK_STACK_SIZE, NULL,
+                                 MQTT_BROKER_TASK_PRIORITY, NULL, tskNO_AFFINITY);
+        g_b_initialized = true;
+    }
+    pthread_mutex_unlock (&x_init_mutex);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Task of the broker, which runs the callbacks of the clients
+**
+** @param [in]
+**      pv_param: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTT_Broker_Task (void * pv_param)
+{
+    MQTT_broker_req_t stru_req;
+
+    while (true)
+    {
+        xQueueReceive (g_x_broker_queue, &stru_req, portMAX_DELAY);
+        switch (stru_req.enm_type)
+        {
+            /* A client is connected or disconnected */
+            case MQTT_BROKER_CONNECT:
+            case MQTT_BROKER_DISCONNECT:
+            {
+                MQTT_inst_t x_inst = stru_req.x_inst;
+                if (x_inst->pfnc_cb != NULL)
+                {
+                    MQTT_evt_data_t stru_evt_data =
+                    {
+                        .x_inst     = x_inst,
+                        .pv_arg     = x_inst->pv_cb_arg,
+                        .enm_evt    = (stru_req.enm_type == MQTT_BROKER_CONNECT) ?
+                                      MQTT_EVT_CONNECTED : MQTT_EVT_DISCONNECTED,
+                    };
+                    x_inst->pfnc_cb (&stru_evt_data);
+                }
+                break;
+            }
+
+            /* A message of the back-office is delivered to the clients subscribing to its topic */
+            case MQTT_BROKER_DELIVER:
+            {
+                for (uint8_t u8_idx = 0; u8_idx < MQTT_NUM_INST; u8_idx++)
+                {
+                    v_MQTT_Deliver (&g_astru_mqtt_objs[u8_idx], stru_req.pstru_msg);
+                }
+                free (stru_req.pstru_msg);
+                break;
+            }
+
+            /* A message enqueued by a client is acknowledged */
+            case MQTT_BROKER_ACK:
+            {
+                MQTT_inst_t x_inst = stru_req.x_inst;
+                __atomic_sub_fetch (&x_inst->u32_outbox_bytes, stru_req.pstru_msg->u32_len, __ATOMIC_SEQ_CST);
+                if (x_inst->pfnc_cb != NULL)
+                {
+                    MQTT_evt_data_t stru_evt_data =
+                    {
+                        .x_inst         = x_inst,
+                        .pv_arg         = x_inst->pv_cb_arg,
+                        .enm_evt        = MQTT_EVT_PUBLISHED,
+                        .stru_publish   =
+                        {
+                            .s32_msg_id = stru_req.pstru_msg->s32_msg_id,
+                        },
+                    };
+                    x_inst->pfnc_cb (&stru_evt_data);
+                }
+                break;
+            }
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Delivers a message to a client if it subscribes to the topic of the message
+**
+** @details
+**      As esp-mqtt, the message is split into fragments if it doesn't fit in the receive buffer of the client. The
+**      first fragment shares the buffer with the header and the topic of the PUBLISH packet, the next fragments don't
+**      contain the topic.
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      pstru_msg: The message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTT_Deliver (MQTT_inst_t x_inst, const SIM_msg_t * pstru_msg)
+{
+    /* Check if the client subscribes to the topic */
+    bool b_subscribed = false;
+    for (uint8_t u8_idx = 0; (u8_idx < x_inst->u8_num_sub_topics) && !b_subscribed; u8_idx++)
+    {
+        b_subscribed = b_MQTT_Topic_Matches (x_inst->pstru_sub_topics[u8_idx].pstri_topic, pstru_msg->stri_topic);
+    }
+    if (!x_inst->b_started || !b_subscribed || (x_inst->pfnc_cb == NULL))
+    {
+        return;
+    }
+
+    /* Deliver the message fragment by fragment */
+    uint16_t u16_topic_len = strlen (pstru_msg->stri_topic);
+    uint32_t u32_fragment_size = __atomic_load_n (&g_u32_fragment_size, __ATOMIC_SEQ_CST);
+    uint32_t u32_offset = 0;
+    do
+    {
+        uint32_t u32_frag_len;
+        if (u32_fragment_size != 0)
+        {
+            u32_frag_len = u32_fragment_size;
+        }
+        else
+        {
+            u32_frag_len = x_inst->u32_rx_buf_size;
+            if (u32_offset == 0)
+            {
+                u32_frag_len -= MQTT_PUBLISH_OVERHEAD + u16_topic_len;
+            }
+        }
+        if (u32_frag_len > pstru_msg->u32_len - u32_offset)
+        {
+            u32_frag_len = pstru_msg->u32_len - u32_offset;
+        }
+
+        MQTT_evt_data_t stru_evt_data =
+        {
+            .x_inst             = x_inst,
+            .pv_arg             = x_inst->pv_cb_arg,
+            .enm_evt            = MQTT_EVT_DATA_RECEIVED,
+            .stru_receive       =
+            {
+                .pstri_topic    = (u32_offset == 0) ? pstru_msg->stri_topic : NULL,
+                .u16_topic_len  = (u32_offset == 0) ? u16_topic_len : 0,
+                .pv_data        = &pstru_msg->au8_data[u32_offset],
+                .u32_data_len   = u32_frag_len,
+                .u32_offset     = u32_offset,
+                .u32_totlen     = pstru_msg->u32_len,
+            },
+        };
+        x_inst->pfnc_cb (&stru_evt_data);
+        u32_offset += u32_frag_len;
+    }
+    while (u32_offset < pstru_msg->u32_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a topic matches a topic filter, which can contain wildcards '+' and '#'
+**
+** @param [in]
+**      pstri_filter: The topic filter
+**
+** @param [in]
+**      pstri_topic: The topic
+**
+** @return
+**      @arg    true: The topic matches the filter
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_MQTT_Topic_Matches (const char * pstri_filter, const char * pstri_topic)
+{
+    while (*pstri_filter != 0)
+    {
+        if (*pstri_filter == '#')
+        {
+            /* Multi-level wildcard matches the remaining levels */
+            return true;
+        }
+        else if (*pstri_filter == '+')
+        {
+            /* Single-level wildcard matches one level */
+            while ((*pstri_topic != 0) && (*pstri_topic != '/'))
+            {
+                pstri_topic++;
+            }
+            pstri_filter++;
+        }
+        else if (*pstri_filter == *pstri_topic)
+        {
+            pstri_filter++;
+            pstri_topic++;
+        }
+        else
+        {
+            /* Filter "a/#" also matches topic "a" */
+            return (*pstri_topic == 0) && (strcmp (pstri_filter, "/#") == 0);
+        }
+    }
+    return *pstri_topic == 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates a message routed by the broker. The messages are not part of the heap of the simulated device.
+**
+** @param [in]
+**      pstri_topic: Topic of the message
+**
+** @param [in]
+**      pv_data: Data of the message
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @return
+**      @arg    NULL: The topic is too long or out of memory
+**      @arg    Otherwise: The message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static SIM_msg_t * pstru_MQTT_Alloc_Msg (const char * pstri_topic, const void * pv_data, uint32_t u32_len)
+{
+    if (strlen (pstri_topic) >= sizeof (((SIM_msg_t *)NULL)->stri_topic))
+    {
+        LOGE ("Topic %s is too long", pstri_topic);
+        return NULL;
+    }
+
+    bool b_counted = b_SIM_Heap_Set_Counted (false);
+    SIM_msg_t * pstru_msg = malloc (sizeof (SIM_msg_t) + u32_len + 1);
+    b_SIM_Heap_Set_Counted (b_counted);
+    if (pstru_msg != NULL)
+    {
+        strcpy (pstru_msg->stri_topic, pstri_topic);
+        pstru_msg->s32_msg_id = 0;
+        pstru_msg->u32_len = u32_len;
+        if (u32_len > 0)
+        {
+            memcpy (pstru_msg->au8_data, pv_data, u32_len);
+        }
+        pstru_msg->au8_data[u32_len] = 0;
+    }
+    return pstru_msg;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Publishes data of a client to the back-office
+**
+** @param [in]
+**      x_inst: The client
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic in publish topic table
+**
+** @param [in]
+**      pv_data: The data
+**
+** @param [in]
+**      u32_len: Length in bytes of the data
+**
+** @param [in]
+**      s32_msg_id: Message ID to acknowledge, 0 if the data is not acknowledged
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static MQTT_status_t enm_MQTT_Publish_Msg (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, const void * pv_data,
+                                           uint32_t u32_len, int32_t s32_msg_id)
+{
+    ASSERT_PARAM (u32_pub_topic_id < x_inst->u8_num_pub_topics);
+    if (!x_inst->b_started)
+    {
+        return MQTT_ERR;
+    }
+
+    /* Copy the data for the back-office */
+    SIM_msg_t * pstru_msg = pstru_MQTT_Alloc_Msg (x_inst->pstru_pub_topics[u32_pub_topic_id].pstri_topic,
+                                                  pv_data, u32_len);
+    if (pstru_msg == NULL)
+    {
+        return MQTT_ERR;
+    }
+    pstru_msg->s32_msg_id = s32_msg_id;
+
+    /* Request the broker to acknowledge the data, the acknowledgement needs its own copy of the message ID */
+    if (s32_msg_id != 0)
+    {
+        SIM_msg_t * pstru_ack = pstru_MQTT_Alloc_Msg ("", NULL, 0);
+        if (pstru_ack == NULL)
+        {
+            free (pstru_msg);
+            return MQTT_ERR;
+        }
+        pstru_ack->s32_msg_id = s32_msg_id;
+        pstru_ack->u32_len = u32_len;
+        __atomic_add_fetch (&x_inst->u32_outbox_bytes, u32_len, __ATOMIC_SEQ_CST);
+        xQueueSend (g_x_backoffice_queue, &pstru_msg, portMAX_DELAY);
+        v_MQTT_Send_Broker_Req (MQTT_BROKER_ACK, x_inst, pstru_ack);
+    }
+    else
+    {
+        xQueueSend (g_x_backoffice_queue, &pstru_msg, portMAX_DELAY);
+    }
+    return MQTT_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a request to the broker task
+**
+** @param [in]
+**      enm_type: Type of the request
+**
+** @param [in]
+**      x_inst: The client concerned
+**
+** @param [in]
+**      pstru_msg: The message concerned
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTT_Send_Broker_Req (int enm_type, MQTT_inst_t x_inst, SIM_msg_t * pstru_msg)
+{
+    MQTT_broker_req_t stru_req =
+    {
+        .enm_type   = enm_type,
+        .x_inst     = x_inst,
+        .pstru_msg  = pstru_msg,
+    };
+    xQueueSend (g_x_broker_queue, &stru_req, portMAX_DELAY);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
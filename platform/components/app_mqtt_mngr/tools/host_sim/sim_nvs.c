@@ -0,0 +1,723 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_nvs.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : NVS library of ESP-IDF simulated by a key-value map in RAM, used by Srvc_Param
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "nvs_flash.h"                  /* Interface of NVS library */
+
+#include <stdbool.h>                    /* Boolean type */
+#include <string.h>                     /* Use memcpy(), strcmp(), etc. */
+#include <pthread.h>                    /* Use POSIX mutex */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Maximum number of entries of the map */
+#define SIM_NVS_MAX_ENTRIES                 256
+
+/** @brief  Maximum key length of NVS, including null terminator */
+#define SIM_NVS_KEY_LEN                     16
+
+/** @brief  Maximum length in bytes of the value of an entry */
+#define SIM_NVS_MAX_VALUE_LEN               1024
+
+/** @brief  Type of the values stored in the map, a value must be read with the type it was written with */
+typedef enum
+{
+    SIM_NVS_TYPE_I8,
+    SIM_NVS_TYPE_U8,
+    SIM_NVS_TYPE_I16,
+    SIM_NVS_TYPE_U16,
+    SIM_NVS_TYPE_I32,
+    SIM_NVS_TYPE_U32,
+    SIM_NVS_TYPE_I64,
+    SIM_NVS_TYPE_U64,
+    SIM_NVS_TYPE_STR,
+    SIM_NVS_TYPE_BLOB,
+} SIM_nvs_type_t;
+
+/** @brief  Entry of the map */
+typedef struct
+{
+    bool                b_used;                         //!< The entry is used
+    nvs_handle_t        x_handle;                       //!< Namespace of the entry
+    char                stri_key[SIM_NVS_KEY_LEN];      //!< Key of the entry
+    SIM_nvs_type_t      enm_type;                       //!< Type of the value
+    size_t              x_len;                          //!< Length in bytes of the value
+    uint8_t             au8_value[SIM_NVS_MAX_VALUE_LEN];   //!< The value
+} SIM_nvs_entry_t;
+
+/** @brief  Defines functions getting and setting an integer value */
+#define SIM_NVS_DEFINE_INT_ACCESSORS(TYPE, SUFFIX, TYPE_ID)                                             \
+    esp_err_t nvs_get_##SUFFIX (nvs_handle_t x_handle, const char * pstri_key, TYPE * px_value)         \
+    {                                                                                                   \
+        size_t x_len = sizeof (TYPE);                                                                   \
+        return x_SIM_Nvs_Get (x_handle, pstri_key, TYPE_ID, px_value, &x_len);                          \
+    }                                                                                                   \
+    esp_err_t nvs_set_##SUFFIX (nvs_handle_t x_handle, const char * pstri_key, TYPE x_value)            \
+    {                                                                                                   \
+        return x_SIM_Nvs_Set (x_handle, pstri_key, TYPE_ID, &x_value, sizeof (TYPE));                   \
+    }
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  The map */
+static SIM_nvs_entry_t g_astru_entries[SIM_NVS_MAX_ENTRIES];
+
+/** @brief  Names of the namespaces opened, the handle of a namespace is its index plus 1 */
+static char g_astri_namespaces[8][SIM_NVS_KEY_LEN];
+
+/** @brief  Statistics of the map */
+static SIM_nvs_stats_t g_stru_stats;
+
+/** @brief  Whether the NVS partition has been initialized */
+static bool g_b_initialized = false;
+
+/** @brief  Mutex protecting the map */
+static pthread_mutex_t g_x_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static SIM_nvs_entry_t * pstru_SIM_Nvs_Find (nvs_handle_t x_handle, const char * pstri_key);
+static esp_err_t x_SIM_Nvs_Get (nvs_handle_t x_handle, const char * pstri_key, SIM_nvs_type_t enm_type,
+                                void * pv_value, size_t * px_len);
+static esp_err_t x_SIM_Nvs_Set (nvs_handle_t x_handle, const char * pstri_key, SIM_nvs_type_t enm_type,
+                                const void * pv_value, size_t x_len);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Initializes the NVS partition. The map starts empty at each run of the simulator, as a blank flash.
+**
+** @return
+**      @arg    ESP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_flash_init (void)
+{
+    g_b_initialized = true;
+    return ESP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Erases all entries of the NVS partition
+**
+** @return
+**      @arg    ESP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_flash_erase (void)
+{
+    pthread_mutex_lock (&g_x_mutex);
+    memset (g_astru_entries, 0, sizeof (g_astru_entries));
+    pthread_mutex_unlock (&g_x_mutex);
+    return ESP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Opens a namespace of the NVS partition
+**
+** @param [in]
+**      pstri_name: Name of the namespace
+**
+** @param [in]
+**      enm_mode: Open mode, not checked by the simulator
+**
+** @param [out]
+**      px_handle: Handle of the namespace
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_INITIALIZED
+**      @arg    ESP_ERR_NVS_NOT_ENOUGH_SPACE: Too many namespaces
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_open (const char * pstri_name, nvs_open_mode_t enm_mode, nvs_handle_t * px_handle)
+{
+    if (!g_b_initialized)
+    {
+        return ESP_ERR_NVS_NOT_INITIALIZED;
+    }
+
+    esp_err_t x_err = ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+    pthread_mutex_lock (&g_x_mutex);
+    for (uint8_t u8_idx = 0; u8_idx < sizeof (g_astri_namespaces) / sizeof (g_astri_namespaces[0]); u8_idx++)
+    {
+        if ((g_astri_namespaces[u8_idx][0] == 0) || (strcmp (g_astri_namespaces[u8_idx], pstri_name) == 0))
+        {
+            strncpy (g_astri_namespaces[u8_idx], pstri_name, SIM_NVS_KEY_LEN - 1);
+            *px_handle = u8_idx + 1;
+            x_err = ESP_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock (&g_x_mutex);
+    return x_err;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Opens a namespace of a given NVS partition. Only the default partition is simulated.
+**
+** @param [in]
+**      pstri_part_name: Name of the partition
+**
+** @param [in]
+**      pstri_name: Name of the namespace
+**
+** @param [in]
+**      enm_mode: Read-only or read-write (not checked)
+**
+** @param [out]
+**      px_handle: Handle of the namespace
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_INITIALIZED
+**      @arg    ESP_ERR_NVS_NOT_ENOUGH_SPACE: Too many namespaces
+**      @arg    ESP_ERR_NOT_FOUND: The partition is not the default one
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_open_from_partition (const char * pstri_part_name, const char * pstri_name, nvs_open_mode_t enm_mode,
+                                   nvs_handle_t * px_handle)
+{
+    if (strcmp (pstri_part_name, "nvs") != 0)
+    {
+        return ESP_ERR_NOT_FOUND;
+    }
+    return nvs_open (pstri_name, enm_mode, px_handle);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Closes a namespace of the NVS partition
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nvs_close (nvs_handle_t x_handle)
+{
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Commits the values written to a namespace. The map is updated by the set functions already, the commits are
+**      only counted.
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @return
+**      @arg    ESP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_commit (nvs_handle_t x_handle)
+{
+    pthread_mutex_lock (&g_x_mutex);
+    g_stru_stats.u32_num_commits++;
+    pthread_mutex_unlock (&g_x_mutex);
+    return ESP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Erases an entry of a namespace
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_FOUND
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_erase_key (nvs_handle_t x_handle, const char * pstri_key)
+{
+    pthread_mutex_lock (&g_x_mutex);
+    SIM_nvs_entry_t * pstru_entry = pstru_SIM_Nvs_Find (x_handle, pstri_key);
+    if (pstru_entry != NULL)
+    {
+        pstru_entry->b_used = false;
+    }
+    pthread_mutex_unlock (&g_x_mutex);
+    return (pstru_entry != NULL) ? ESP_OK : ESP_ERR_NVS_NOT_FOUND;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Erases all entries of a namespace
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @return
+**      @arg    ESP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_erase_all (nvs_handle_t x_handle)
+{
+    pthread_mutex_lock (&g_x_mutex);
+    for (uint16_t u16_idx = 0; u16_idx < SIM_NVS_MAX_ENTRIES; u16_idx++)
+    {
+        if (g_astru_entries[u16_idx].x_handle == x_handle)
+        {
+            g_astru_entries[u16_idx].b_used = false;
+        }
+    }
+    pthread_mutex_unlock (&g_x_mutex);
+    return ESP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finds the first entry of a namespace. Listing entries is not simulated, no entry is ever found.
+**
+** @param [in]
+**      pstri_part_name: Name of the partition
+**
+** @param [in]
+**      pstri_name: Name of the namespace
+**
+** @param [in]
+**      enm_type: Type of the entries to find
+**
+** @return
+**      @arg    NULL: No entry
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+nvs_iterator_t nvs_entry_find (const char * pstri_part_name, const char * pstri_name, nvs_type_t enm_type)
+{
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finds the next entry of a namespace
+**
+** @param [in]
+**      x_iter: Iterator returned by nvs_entry_find() or nvs_entry_next()
+**
+** @return
+**      @arg    NULL: No more entry
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+nvs_iterator_t nvs_entry_next (nvs_iterator_t x_iter)
+{
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets information about the entry an iterator points to
+**
+** @param [in]
+**      x_iter: The iterator
+**
+** @param [out]
+**      pstru_info: Information about the entry
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nvs_entry_info (nvs_iterator_t x_iter, nvs_entry_info_t * pstru_info)
+{
+    memset (pstru_info, 0, sizeof (nvs_entry_info_t));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases an iterator
+**
+** @param [in]
+**      x_iter: The iterator, may be NULL
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void nvs_release_iterator (nvs_iterator_t x_iter)
+{
+}
+
+/* Integer accessors */
+SIM_NVS_DEFINE_INT_ACCESSORS (int8_t,   i8,     SIM_NVS_TYPE_I8)
+SIM_NVS_DEFINE_INT_ACCESSORS (uint8_t,  u8,     SIM_NVS_TYPE_U8)
+SIM_NVS_DEFINE_INT_ACCESSORS (int16_t,  i16,    SIM_NVS_TYPE_I16)
+SIM_NVS_DEFINE_INT_ACCESSORS (uint16_t, u16,    SIM_NVS_TYPE_U16)
+SIM_NVS_DEFINE_INT_ACCESSORS (int32_t,  i32,    SIM_NVS_TYPE_I32)
+SIM_NVS_DEFINE_INT_ACCESSORS (uint32_t, u32,    SIM_NVS_TYPE_U32)
+SIM_NVS_DEFINE_INT_ACCESSORS (int64_t,  i64,    SIM_NVS_TYPE_I64)
+SIM_NVS_DEFINE_INT_ACCESSORS (uint64_t, u64,    SIM_NVS_TYPE_U64)
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a string value
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [out]
+**      pstri_value: Buffer receiving the string, NULL to get the length of the string only
+**
+** @param [in, out]
+**      px_len: Size in bytes of the buffer, then length in bytes of the string including null terminator
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_FOUND
+**      @arg    ESP_ERR_NVS_TYPE_MISMATCH
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The buffer is too small
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_get_str (nvs_handle_t x_handle, const char * pstri_key, char * pstri_value, size_t * px_len)
+{
+    return x_SIM_Nvs_Get (x_handle, pstri_key, SIM_NVS_TYPE_STR, pstri_value, px_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets a string value
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [in]
+**      pstri_value: The string
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The string is too long
+**      @arg    ESP_ERR_NVS_NOT_ENOUGH_SPACE
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_set_str (nvs_handle_t x_handle, const char * pstri_key, const char * pstri_value)
+{
+    return x_SIM_Nvs_Set (x_handle, pstri_key, SIM_NVS_TYPE_STR, pstri_value, strlen (pstri_value) + 1);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets a blob value
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [out]
+**      pv_value: Buffer receiving the blob, NULL to get the length of the blob only
+**
+** @param [in, out]
+**      px_len: Size in bytes of the buffer, then length in bytes of the blob
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_FOUND
+**      @arg    ESP_ERR_NVS_TYPE_MISMATCH
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The buffer is too small
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_get_blob (nvs_handle_t x_handle, const char * pstri_key, void * pv_value, size_t * px_len)
+{
+    return x_SIM_Nvs_Get (x_handle, pstri_key, SIM_NVS_TYPE_BLOB, pv_value, px_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets a blob value
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [in]
+**      pv_value: The blob
+**
+** @param [in]
+**      x_len: Length in bytes of the blob
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The blob is too long
+**      @arg    ESP_ERR_NVS_NOT_ENOUGH_SPACE
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+esp_err_t nvs_set_blob (nvs_handle_t x_handle, const char * pstri_key, const void * pv_value, size_t x_len)
+{
+    return x_SIM_Nvs_Set (x_handle, pstri_key, SIM_NVS_TYPE_BLOB, pv_value, x_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets statistics of the map, which tell how many times the flash would have been written on the device
+**
+** @param [out]
+**      pstru_stats: The statistics
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_SIM_Nvs_Get_Stats (SIM_nvs_stats_t * pstru_stats)
+{
+    pthread_mutex_lock (&g_x_mutex);
+    *pstru_stats = g_stru_stats;
+    pthread_mutex_unlock (&g_x_mutex);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finds an entry of the map, the caller must hold the mutex
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @return
+**      @arg    NULL: The entry is not found
+**      @arg    Otherwise: The entry
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static SIM_nvs_entry_t * pstru_SIM_Nvs_Find (nvs_handle_t x_handle, const char * pstri_key)
+{
+    for (uint16_t u16_idx = 0; u16_idx < SIM_NVS_MAX_ENTRIES; u16_idx++)
+    {
+        SIM_nvs_entry_t * pstru_entry = &g_astru_entries[u16_idx];
+        if (pstru_entry->b_used && (pstru_entry->x_handle == x_handle) &&
+            (strncmp (pstru_entry->stri_key, pstri_key, SIM_NVS_KEY_LEN) == 0))
+        {
+            return pstru_entry;
+        }
+    }
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the value of an entry
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [in]
+**      enm_type: Type of the value
+**
+** @param [out]
+**      pv_value: Buffer receiving the value, NULL to get the length of the value only
+**
+** @param [in, out]
+**      px_len: Size in bytes of the buffer, then length in bytes of the value
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_NOT_FOUND
+**      @arg    ESP_ERR_NVS_TYPE_MISMATCH
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The buffer is too small
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static esp_err_t x_SIM_Nvs_Get (nvs_handle_t x_handle, const char * pstri_key, SIM_nvs_type_t enm_type,
+                                void * pv_value, size_t * px_len)
+{
+    esp_err_t x_err = ESP_OK;
+
+    pthread_mutex_lock (&g_x_mutex);
+    SIM_nvs_entry_t * pstru_entry = pstru_SIM_Nvs_Find (x_handle, pstri_key);
+    if (pstru_entry == NULL)
+    {
+        x_err = ESP_ERR_NVS_NOT_FOUND;
+    }
+    else if (pstru_entry->enm_type != enm_type)
+    {
+        x_err = ESP_ERR_NVS_TYPE_MISMATCH;
+    }
+    else if (pv_value == NULL)
+    {
+        *px_len = pstru_entry->x_len;
+    }
+    else if (*px_len < pstru_entry->x_len)
+    {
+        x_err = ESP_ERR_NVS_INVALID_LENGTH;
+    }
+    else
+    {
+        memcpy (pv_value, pstru_entry->au8_value, pstru_entry->x_len);
+        *px_len = pstru_entry->x_len;
+    }
+    pthread_mutex_unlock (&g_x_mutex);
+
+    return x_err;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets the value of an entry, the entry is created if it doesn't exist
+**
+** @param [in]
+**      x_handle: Handle of the namespace
+**
+** @param [in]
+**      pstri_key: Key of the entry
+**
+** @param [in]
+**      enm_type: Type of the value
+**
+** @param [in]
+**      pv_value: The value
+**
+** @param [in]
+**      x_len: Length in bytes of the value
+**
+** @return
+**      @arg    ESP_OK
+**      @arg    ESP_ERR_NVS_INVALID_LENGTH: The value is too long
+**      @arg    ESP_ERR_NVS_NOT_ENOUGH_SPACE
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static esp_err_t x_SIM_Nvs_Set (nvs_handle_t x_handle, const char * pstri_key, SIM_nvs_type_t enm_type,
+                                const void * pv_value, size_t x_len)
+{
+    if (x_len > SIM_NVS_MAX_VALUE_LEN)
+    {
+        return ESP_ERR_NVS_INVALID_LENGTH;
+    }
+
+    pthread_mutex_lock (&g_x_mutex);
+    SIM_nvs_entry_t * pstru_entry = pstru_SIM_Nvs_Find (x_handle, pstri_key);
+    for (uint16_t u16_idx = 0; (pstru_entry == NULL) && (u16_idx < SIM_NVS_MAX_ENTRIES); u16_idx++)
+    {
+        if (!g_astru_entries[u16_idx].b_used)
+        {
+            pstru_entry = &g_astru_entries[u16_idx];
+            pstru_entry->b_used = true;
+            pstru_entry->x_handle = x_handle;
+            strncpy (pstru_entry->stri_key, pstri_key, SIM_NVS_KEY_LEN - 1);
+            pstru_entry->stri_key[SIM_NVS_KEY_LEN - 1] = 0;
+        }
+    }
+    if (pstru_entry != NULL)
+    {
+        pstru_entry->enm_type = enm_type;
+        pstru_entry->x_len = x_len;
+        memcpy (pstru_entry->au8_value, pv_value, x_len);
+        g_stru_stats.u32_num_sets++;
+    }
+    pthread_mutex_unlock (&g_x_mutex);
+
+    return (pstru_entry != NULL) ? ESP_OK : ESP_ERR_NVS_NOT_ENOUGH_SPACE;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,422 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_services.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : Stand-ins of the services used by the simulated modules that the host simulator doesn't run
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "common_hdr.h"                 /* Use common definitions */
+#include "app_ota_mngr.h"               /* Interface of OTA update manager */
+#include "srvc_micropy.h"               /* Interface of MicroPython service */
+#include "srvc_wifi.h"                  /* Interface of Wifi service */
+#include "srvc_fwu_esp32.h"             /* Interface of ESP32 firmware update service */
+#include "srvc_ws_server.h"             /* Interface of Websocket server */
+#include "srvc_recovery.h"              /* Interface of recovery service */
+#include "mbtrace.h"                    /* Interface of Modbus bus trace */
+
+#include <stdio.h>                      /* Use snprintf() */
+#include <string.h>                     /* Use strlen(), memcpy() */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+static const char * TAG = "Sim_Services";
+
+/** @brief  MAC address of the simulated device */
+static const uint8_t g_au8_mac[6] = { 0x24, 0x0A, 0xC4, 0x51, 0x6D, 0x1C };
+
+/** @brief  The only instance of the simulated Websocket server, which has no client */
+static uint8_t g_u8_ws_server_inst;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static bool b_SIM_Write_File (const char * pstri_file_path, const void * pv_data, uint32_t u32_len);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts an OTA update. The simulated device has no firmware to update, the request is accepted and ignored.
+**
+** @param [in]
+**      pstru_config: Configuration of the update
+**
+** @return
+**      @arg    OTAMN_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_OTAMN_Start (const OTAMN_config_t * pstru_config)
+{
+    LOGI ("OTA update requested");
+    return OTAMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Cancels the ongoing OTA update
+**
+** @return
+**      @arg    OTAMN_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_OTAMN_Cancel (void)
+{
+    return OTAMN_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Executes a Python script. MicroPython is not run by the simulator, the request is accepted and ignored.
+**
+** @param [in]
+**      pstri_file_path: Path of the script
+**
+** @return
+**      @arg    MP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_MP_Execute_File (const char * pstri_file_path)
+{
+    LOGI ("Execution of %s requested", pstri_file_path);
+    return MP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Starts WebREPL of MicroPython, not available in the simulator
+**
+** @return
+**      @arg    MP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_MP_Run_WebRepl (void)
+{
+    return MP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets MAC address of the Wifi interface
+**
+** @param [out]
+**      au8_mac: The MAC address, in the first 6 bytes
+**
+** @return
+**      @arg    WIFI_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_WIFI_Get_Mac (uint8_t au8_mac[8])
+{
+    memcpy (au8_mac, g_au8_mac, sizeof (g_au8_mac));
+    return WIFI_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets information of the access point that is being connected with
+**
+** @param [out]
+**      pstru_ap_info: Information of the access point
+**
+** @return
+**      @arg    WIFI_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_WIFI_Get_Ap_Info (WIFI_ap_info_t * pstru_ap_info)
+{
+    static const uint8_t au8_ap_mac[6] = { 0x02, 0x00, 0x00, 0x00, 0x00, 0x01 };
+
+    memcpy (pstru_ap_info->au8_mac, au8_ap_mac, sizeof (au8_ap_mac));
+    snprintf (pstru_ap_info->stri_ssid, sizeof (pstru_ap_info->stri_ssid), "host_sim");
+    pstru_ap_info->s8_rssi = -50;
+    return WIFI_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets descriptor of the running firmware
+**
+** @param [out]
+**      pstru_desc: The descriptor
+**
+** @return
+**      @arg    FWUESP_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_FWUESP_Get_Fw_Descriptor (FWUESP_fw_desc_t * pstru_desc)
+{
+    pstru_desc->pstri_name = "host_sim";
+    pstru_desc->pstri_ver = "0.0.0";
+    pstru_desc->pstri_time = __DATE__ " " __TIME__;
+    return FWUESP_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets instance of a Websocket server. The simulator has no HTTP server, all instances are the same one without
+**      any client.
+**
+** @param [in]
+**      enm_inst_id: ID of the instance
+**
+** @return
+**      The simulated instance
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_inst_t x_WSS_Get_Inst (WSS_inst_id_t enm_inst_id)
+{
+    return (WSS_inst_t)&g_u8_ws_server_inst;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Registers the function handling events of a Websocket server. No event is fired by the simulator.
+**
+** @param [in]
+**      x_inst: Instance of the server
+**
+** @param [in]
+**      pfnc_cb: Function handling the events
+**
+** @param [in]
+**      pv_arg: Argument passed to pfnc_cb
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_WSS_Register_Callback (WSS_inst_t x_inst, WSS_callback_t pfnc_cb, void * pv_arg)
+{
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends data to a client of a Websocket server. The simulated server has no client, the data is discarded.
+**
+** @param [in]
+**      x_inst: Instance of the server
+**
+** @param [in]
+**      u8_client_id: ID of the client
+**
+** @param [in]
+**      pv_data: Data to send
+**
+** @param [in]
+**      u16_len: Length in bytes of the data
+**
+** @return
+**      @arg    WSS_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Send (WSS_inst_t x_inst, uint8_t u8_client_id, const void * pv_data, uint16_t u16_len)
+{
+    return WSS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Publishes data on a topic of a Websocket server. The simulated server has no subscriber, nothing is encoded.
+**
+** @param [in]
+**      x_inst: Instance of the server
+**
+** @param [in]
+**      u8_topic: The topic
+**
+** @param [in]
+**      pfnc_encode: Function encoding the data for a class of subscribers
+**
+** @param [in]
+**      pv_arg: Argument passed to pfnc_encode
+**
+** @return
+**      @arg    WSS_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Publish (WSS_inst_t x_inst, uint8_t u8_topic, WSS_encode_cb_t pfnc_encode, void * pv_arg)
+{
+    return WSS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets encoding of the data sent to a client of a Websocket server
+**
+** @param [in]
+**      x_inst: Instance of the server
+**
+** @param [in]
+**      u8_client_id: ID of the client
+**
+** @param [in]
+**      u8_encoding: The encoding
+**
+** @return
+**      @arg    WSS_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Set_Encoding (WSS_inst_t x_inst, uint8_t u8_client_id, uint8_t u8_encoding)
+{
+    return WSS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Backs up operating data of the cooking script. MicroPython is not run by the simulator, there is nothing to
+**      back up.
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_RCVR_Backup_Data (void)
+{
+    LOGI ("Power interruption notified");
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Exports the Modbus bus trace to a pcap file. The simulator has no Modbus bus, the file has the pcap global
+**      header only.
+**
+** @param [in]
+**      pcPath: Path of the file
+**
+** @param [out]
+**      pulNumRecords: Number of records exported, 0
+**
+** @return
+**      @arg    TRUE: The file has been written
+**      @arg    FALSE: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+BOOL xMBMasterTraceExport (const CHAR * pcPath, ULONG * pulNumRecords)
+{
+    /* Magic number, version 2.4, UTC offset 0, accuracy 0, snap length 256, link type 147 (user defined) */
+    static const uint8_t au8_pcap_header[24] =
+    {
+        0xD4, 0xC3, 0xB2, 0xA1, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x93, 0x00, 0x00, 0x00,
+    };
+
+    if (pulNumRecords != NULL)
+    {
+        *pulNumRecords = 0;
+    }
+    return b_SIM_Write_File (pcPath, au8_pcap_header, sizeof (au8_pcap_header)) ? TRUE : FALSE;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a file in the LittleFS storage
+**
+** @param [in]
+**      pstri_file_path: Path of the file
+**
+** @param [in]
+**      pv_data: Content of the file
+**
+** @param [in]
+**      u32_len: Length in bytes of the content
+**
+** @return
+**      @arg    true: The file has been written
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_SIM_Write_File (const char * pstri_file_path, const void * pv_data, uint32_t u32_len)
+{
+    lfs2_file_t x_file;
+    if (lfs2_file_open (g_px_lfs2, &x_file, pstri_file_path, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
+    {
+        LOGE ("Failed to create file %s", pstri_file_path);
+        return false;
+    }
+    lfs2_ssize_t x_written = lfs2_file_write (g_px_lfs2, &x_file, pv_data, u32_len);
+    return (lfs2_file_close (g_px_lfs2, &x_file) >= 0) && (x_written == (lfs2_ssize_t)u32_len);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,317 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : sim_storage.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Dec 16
+**  @brief      : LittleFS storage of the simulated device, on a block device in RAM
+**  @namespace  : SIM
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Host_Sim
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include "sim.h"                        /* Interfaces between the modules of the simulator */
+#include "common_hdr.h"                 /* Use common definitions and g_px_lfs2 */
+#include "esp_partition.h"              /* Use partition information */
+
+#include <string.h>                     /* Use memcpy(), memset(), strcmp() */
+#include <pthread.h>                    /* Use pthread mutex */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Geometry of the block device, the same as the flash of ESP32 and the LittleFS settings of MicroPython */
+#define SIM_STORAGE_BLOCK_SIZE              4096
+#define SIM_STORAGE_READ_SIZE               32
+#define SIM_STORAGE_PROG_SIZE               32
+#define SIM_STORAGE_LOOKAHEAD_SIZE          32
+#define SIM_STORAGE_CACHE_SIZE              (4 * SIM_STORAGE_PROG_SIZE)
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Logging tag of this module */
+static const char * TAG = "Sim_Storage";
+
+/** @brief  Content of the block device */
+static uint8_t * g_pu8_blocks = NULL;
+
+/** @brief  The simulated "vfs" partition */
+static esp_partition_t g_stru_partition =
+{
+    .type       = ESP_PARTITION_TYPE_DATA,
+    .subtype    = ESP_PARTITION_SUBTYPE_DATA_FAT,
+    .address    = 0x200000,
+    .size       = 0,
+    .label      = "vfs",
+};
+
+/** @brief  Instance of LittleFS */
+static lfs2_t g_x_lfs2;
+
+/** @brief  Configuration of LittleFS */
+static struct lfs2_config g_stru_lfs2_config;
+
+/** @brief  Buffers of LittleFS */
+static uint8_t g_au8_read_buffer[SIM_STORAGE_CACHE_SIZE];
+static uint8_t g_au8_prog_buffer[SIM_STORAGE_CACHE_SIZE];
+static uint8_t g_au8_lookahead_buffer[SIM_STORAGE_LOOKAHEAD_SIZE];
+
+/** @brief  Mutex serializing the calls to LittleFS, as the lock of MicroPython's filesystem does on the device */
+static pthread_mutex_t g_x_lfs2_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/** @brief  LittleFS filesystem used by all modules, mounted by MicroPython on the device */
+lfs2_t * g_px_lfs2 = NULL;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static int s_SIM_Storage_Read (const struct lfs2_config * pstru_config, lfs2_block_t x_block, lfs2_off_t x_offset,
+                               void * pv_buffer, lfs2_size_t x_size);
+static int s_SIM_Storage_Prog (const struct lfs2_config * pstru_config, lfs2_block_t x_block, lfs2_off_t x_offset,
+                               const void * pv_buffer, lfs2_size_t x_size);
+static int s_SIM_Storage_Erase (const struct lfs2_config * pstru_config, lfs2_block_t x_block);
+static int s_SIM_Storage_Sync (const struct lfs2_config * pstru_config);
+static int s_SIM_Storage_Lock (const struct lfs2_config * pstru_config);
+static int s_SIM_Storage_Unlock (const struct lfs2_config * pstru_config);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Formats and mounts LittleFS on a block device in RAM, as MicroPython does on the "vfs" partition of the device
+**
+** @param [in]
+**      u32_size: Size in bytes of the storage, multiple of 4096
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_SIM_Storage_Init (uint32_t u32_size)
+{
+    ASSERT_PARAM ((u32_size % SIM_STORAGE_BLOCK_SIZE == 0) && (g_pu8_blocks == NULL));
+
+    /* The storage is not part of the heap of the device */
+    bool b_counted = b_SIM_Heap_Set_Counted (false);
+    g_pu8_blocks = malloc (u32_size);
+    b_SIM_Heap_Set_Counted (b_counted);
+    if (g_pu8_blocks == NULL)
+    {
+        LOGE ("Failed to allocate %d bytes of storage", u32_size);
+        return STATUS_ERR;
+    }
+    memset (g_pu8_blocks, 0xFF, u32_size);
+    g_stru_partition.size = u32_size;
+
+    /* Configure LittleFS */
+    g_stru_lfs2_config = (struct lfs2_config)
+    {
+        .read               = s_SIM_Storage_Read,
+        .prog               = s_SIM_Storage_Prog,
+        .erase              = s_SIM_Storage_Erase,
+        .sync               = s_SIM_Storage_Sync,
+        .lock               = s_SIM_Storage_Lock,
+        .unlock             = s_SIM_Storage_Unlock,
+        .read_size          = SIM_STORAGE_READ_SIZE,
+        .prog_size          = SIM_STORAGE_PROG_SIZE,
+        .block_size         = SIM_STORAGE_BLOCK_SIZE,
+        .block_count        = u32_size / SIM_STORAGE_BLOCK_SIZE,
+        .block_cycles       = 100,
+        .cache_size         = SIM_STORAGE_CACHE_SIZE,
+        .lookahead_size     = SIM_STORAGE_LOOKAHEAD_SIZE,
+        .read_buffer        = g_au8_read_buffer,
+        .prog_buffer        = g_au8_prog_buffer,
+        .lookahead_buffer   = g_au8_lookahead_buffer,
+    };
+
+    /* Format and mount the filesystem */
+    if ((lfs2_format (&g_x_lfs2, &g_stru_lfs2_config) != LFS2_ERR_OK) ||
+        (lfs2_mount (&g_x_lfs2, &g_stru_lfs2_config) != LFS2_ERR_OK))
+    {
+        LOGE ("Failed to format and mount LittleFS");
+        return STATUS_ERR;
+    }
+    g_px_lfs2 = &g_x_lfs2;
+
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finds the first partition of the given type, subtype and label. Only the "vfs" partition is simulated.
+**
+** @param [in]
+**      enm_type: Type of the partition
+**
+** @param [in]
+**      enm_subtype: Subtype of the partition, ESP_PARTITION_SUBTYPE_ANY for any subtype
+**
+** @param [in]
+**      pstri_label: Label of the partition, NULL for any label
+**
+** @return
+**      @arg    NULL: The partition is not found
+**      @arg    Otherwise: Information of the partition
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+const esp_partition_t * esp_partition_find_first (esp_partition_type_t enm_type, esp_partition_subtype_t enm_subtype,
+                                                  const char * pstri_label)
+{
+    if ((g_pu8_blocks == NULL) || (enm_type != g_stru_partition.type) ||
+        ((enm_subtype != ESP_PARTITION_SUBTYPE_ANY) && (enm_subtype != g_stru_partition.subtype)) ||
+        ((pstri_label != NULL) && (strcmp (pstri_label, g_stru_partition.label) != 0)))
+    {
+        return NULL;
+    }
+    return &g_stru_partition;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads data from a block of the block device
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Read (const struct lfs2_config * pstru_config, lfs2_block_t x_block, lfs2_off_t x_offset,
+                               void * pv_buffer, lfs2_size_t x_size)
+{
+    memcpy (pv_buffer, &g_pu8_blocks[x_block * pstru_config->block_size + x_offset], x_size);
+    return LFS2_ERR_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Programs data to an erased block of the block device. As NOR flash, programming can only clear bits.
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Prog (const struct lfs2_config * pstru_config, lfs2_block_t x_block, lfs2_off_t x_offset,
+                               const void * pv_buffer, lfs2_size_t x_size)
+{
+    uint8_t * pu8_dest = &g_pu8_blocks[x_block * pstru_config->block_size + x_offset];
+    const uint8_t * pu8_src = pv_buffer;
+    for (lfs2_size_t x_idx = 0; x_idx < x_size; x_idx++)
+    {
+        pu8_dest[x_idx] &= pu8_src[x_idx];
+    }
+    return LFS2_ERR_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Erases a block of the block device
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Erase (const struct lfs2_config * pstru_config, lfs2_block_t x_block)
+{
+    memset (&g_pu8_blocks[x_block * pstru_config->block_size], 0xFF, pstru_config->block_size);
+    return LFS2_ERR_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Flushes the writes to the block device, nothing to do for RAM
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Sync (const struct lfs2_config * pstru_config)
+{
+    return LFS2_ERR_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Takes the lock of LittleFS before a call
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Lock (const struct lfs2_config * pstru_config)
+{
+    pthread_mutex_lock (&g_x_lfs2_mutex);
+    return LFS2_ERR_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases the lock of LittleFS after a call
+**
+** @return
+**      @arg    LFS2_ERR_OK
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int s_SIM_Storage_Unlock (const struct lfs2_config * pstru_config)
+{
+    pthread_mutex_unlock (&g_x_lfs2_mutex);
+    return LFS2_ERR_OK;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
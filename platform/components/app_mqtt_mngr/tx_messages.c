@@ -30,8 +30,23 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
-/** @brief  Maximum data size in bytes that ESP32 client sends to download topic each time */
-#define MAX_DOWNLOAD_CHUNK_LEN              16384
+/** @brief  Coalescing keys of notify messages, a pending notify is replaced by a newer one of the same key */
+enum
+{
+    MQTTMN_NOTIFY_KEY_NONE = 0,             //!< The notify is never replaced
+    MQTTMN_NOTIFY_KEY_SCAN,                 //!< scanNotify
+    MQTTMN_NOTIFY_KEY_OTA_DOWNLOAD,         //!< Progress of OTA firmware download
+    MQTTMN_NOTIFY_KEY_OTA_INSTALL,          //!< Progress of OTA firmware install
+    MQTTMN_NOTIFY_KEY_OTA_STATUS,           //!< Overall status of OTA firmware update
+};
+
+/** @brief  Priority and coalescing key of statusNotify commands of a status type */
+typedef struct
+{
+    const char *        pstri_type;         //!< Type of the status
+    MQTT_priority_t     enm_prio;           //!< Priority of the notify
+    uint32_t            u32_key;            //!< Coalescing key of the notify
+} MQTTMN_notify_class_t;
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -39,12 +54,106 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/**
+** @brief   Priority and coalescing key of statusNotify commands, other status types have priority MQTT_PRIO_STATUS
+**          and are never replaced. Results of file transfers and exports are not coalesced because several of them
+**          could be pending for different back-office nodes.
+*/
+static const MQTTMN_notify_class_t g_astru_notify_classes[] =
+{
+    { NOTIFY_OTA_DOWNLOAD_PROGRESS,     MQTT_PRIO_PROGRESS,     MQTTMN_NOTIFY_KEY_OTA_DOWNLOAD  },
+    { NOTIFY_OTA_INSTALL_PROGRESS,      MQTT_PRIO_PROGRESS,     MQTTMN_NOTIFY_KEY_OTA_INSTALL   },
+    { NOTIFY_OTA_UPDATE_STATUS,         MQTT_PRIO_STATUS,       MQTTMN_NOTIFY_KEY_OTA_STATUS    },
+};
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           FUNCTIONS SECTION
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finishes a notify command and posts it to the publish queue
+**
+** @param [in]
+**      pstru_json: The writer of the notify
+**
+** @param [in]
+**      enm_prio: Priority of the notify
+**
+** @param [in]
+**      u32_key: Coalescing key of the notify, MQTTMN_NOTIFY_KEY_NONE if the notify must not be replaced
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Publish_Notify (MQTTMN_json_t * pstru_json, MQTT_priority_t enm_prio, uint32_t u32_key)
+{
+    uint32_t u32_len;
+    const char * pstri_notify = pstri_MQTTMN_Json_End (pstru_json, &u32_len);
+    if (pstri_notify == NULL)
+    {
+        LOGE ("Failed to construct command %s", pstru_json->pstri_cmd);
+        return MQTTMN_ERR;
+    }
+
+    return (enm_MQTT_Post (g_x_mqtt, MQTT_S2M_NOTIFY, enm_prio, u32_key, pstri_notify, u32_len) == MQTT_OK) ?
+            MQTTMN_OK : MQTTMN_ERR;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Finishes a response command and posts it to the response topic of a session
+**
+** @details
+**      If the response does not fit in the message buffer, a response with status of STATUS_ERR is sent instead so
+**      that the master is not left waiting. Responses have the highest priority in the publish queue, so they are not
+**      delayed by pending notify messages.
+**
+** @param [in]
+**      pstru_session: the session to send the command
+**
+** @param [in]
+**      pstru_json: The writer of the response
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Publish_Response (MQTTMN_session_t * pstru_session, MQTTMN_json_t * pstru_json)
+{
+    int8_t s8_result = MQTTMN_OK;
+    uint32_t u32_len;
+
+    const char * pstri_response = pstri_MQTTMN_Json_End (pstru_json, &u32_len);
+    if (pstri_response == NULL)
+    {
+        LOGE ("Failed to construct command %s", pstru_json->pstri_cmd);
+        v_MQTTMN_Json_Begin (pstru_json, pstru_json->pstri_cmd, pstru_session->u32_request_eid, pstru_json->b_cbor);
+        v_MQTTMN_Json_Add_String (pstru_json, "status", STATUS_ERR);
+        pstri_response = pstri_MQTTMN_Json_End (pstru_json, &u32_len);
+        s8_result = MQTTMN_ERR;
+    }
+
+    v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
+    if ((pstri_response == NULL) ||
+        (enm_MQTT_Post (g_x_mqtt, MQTT_S2M_RESPONSE, MQTT_PRIO_RESPONSE, 0, pstri_response, u32_len) != MQTT_OK))
+    {
+        s8_result = MQTTMN_ERR;
+    }
+    return s8_result;
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -68,36 +177,99 @@
 static int8_t s8_MQTTMN_Send_scanNotify (void)
 {
     /* Construct the notify */
-    cJSON * px_notify_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_notify_root, JSON_KEY_CMD, "scanNotify");
-    cJSON_AddNumberToObject (px_notify_root, JSON_KEY_EID, g_u32_notify_eid);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "scanNotify", g_u32_notify_eid, false);
     g_u32_notify_eid = g_u32_notify_eid == 0x7FFFFFFF ? 1 : g_u32_notify_eid + 1;
 
     /** @todo   Determine device state */
     const char * pstri_dev_state = "idle";
-    cJSON_AddStringToObject (px_notify_root, "state", pstri_dev_state);
+    v_MQTTMN_Json_Add_String (&stru_json, "state", pstri_dev_state);
 
     /* Version of master firmware */
     FWUESP_fw_desc_t stru_fw_desc;
     s8_FWUESP_Get_Fw_Descriptor (&stru_fw_desc);
-    cJSON_AddStringToObject (px_notify_root, "masterFwVer", stru_fw_desc.pstri_ver);
+    v_MQTTMN_Json_Add_String (&stru_json, "masterFwVer", stru_fw_desc.pstri_ver);
 
     /** @todo   Determine version of slave firmware */
     const char * pstri_slave_version = "0.0.0";
-    cJSON_AddStringToObject (px_notify_root, "slaveFwVer", pstri_slave_version);
+    v_MQTTMN_Json_Add_String (&stru_json, "slaveFwVer", pstri_slave_version);
 
     /* Publish the notify */
-    char * pstri_notify = cJSON_Print (px_notify_root);
-    cJSON_Delete (px_notify_root);
-    if (pstri_notify != NULL)
+    return s8_MQTTMN_Publish_Notify (&stru_json, MQTT_PRIO_STATUS, MQTTMN_NOTIFY_KEY_SCAN);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a statusNotify command reporting the result of a file transfer
+**
+** @details
+**      Several files can be transferred at once, so the notify also tells which transfer it is about.
+**      Extra command data:
+**          "statusType":"<statusType>"
+**          "statusValue":"<statusValue>"
+**          "description":"<statusDescription>"
+**          "file":"<filePathName>"
+**          "masterNodeId":<masterNodeId>
+**
+** @param [in]
+**      pstri_type: Type of the status, NOTIFY_FILE_UPLOAD_STATUS or NOTIFY_FILE_DOWNLOAD_STATUS
+**
+** @param [in]
+**      pstri_file_path: Path of the transferred file, NULL if the status is not about a file transfer. The notify
+**                       carries the file name relative to LFS_MOUNT_POINT, as in the request of the master.
+**
+** @param [in]
+**      u32_master_node_id: Master node ID of the session which started the transfer
+**
+** @param [in]
+**      pstri_value: Value of the status (see s8_MQTTMN_Send_statusNotify())
+**
+** @param [in]
+**      pstri_desc: Status description
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Send_Transfer_statusNotify (const char * pstri_type, const char * pstri_file_path,
+                                                    uint32_t u32_master_node_id, const char * pstri_value,
+                                                    const char * pstri_desc)
+{
+    /* Construct the notify */
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "statusNotify", g_u32_notify_eid, false);
+    g_u32_notify_eid = g_u32_notify_eid == 0x7FFFFFFF ? 1 : g_u32_notify_eid + 1;
+
+    v_MQTTMN_Json_Add_String (&stru_json, "statusType", pstri_type);
+    v_MQTTMN_Json_Add_String (&stru_json, "statusValue", pstri_value);
+    v_MQTTMN_Json_Add_String (&stru_json, "description", pstri_desc);
+    if (pstri_file_path != NULL)
     {
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_NOTIFY, pstri_notify, 0);
-        free (pstri_notify);
-        return MQTTMN_OK;
+        if (strncmp (pstri_file_path, LFS_MOUNT_POINT "/", sizeof (LFS_MOUNT_POINT)) == 0)
+        {
+            pstri_file_path += sizeof (LFS_MOUNT_POINT);
+        }
+        v_MQTTMN_Json_Add_String (&stru_json, "file", pstri_file_path);
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "masterNodeId", u32_master_node_id);
     }
 
-    LOGE ("Failed to construct command scanNotify");
-    return MQTTMN_ERR;
+    /* Publish the notify with the priority and coalescing key of its status type */
+    MQTT_priority_t enm_prio = MQTT_PRIO_STATUS;
+    uint32_t u32_key = MQTTMN_NOTIFY_KEY_NONE;
+    for (uint8_t u8_idx = 0; u8_idx < sizeof (g_astru_notify_classes) / sizeof (g_astru_notify_classes[0]); u8_idx++)
+    {
+        if (strcmp (g_astru_notify_classes[u8_idx].pstri_type, pstri_type) == 0)
+        {
+            enm_prio = g_astru_notify_classes[u8_idx].enm_prio;
+            u32_key = g_astru_notify_classes[u8_idx].u32_key;
+            break;
+        }
+    }
+    return s8_MQTTMN_Publish_Notify (&stru_json, enm_prio, u32_key);
 }
 
 /**
@@ -108,7 +280,7 @@ static int8_t s8_MQTTMN_Send_scanNotify (void)
 **
 ** @details
 **      This command is used by Rotimatic node to notify status or result of an operation such as firmware updating,
-**      file uploading, etc.
+**      bus trace exporting, etc. Results of file transfers are sent by s8_MQTTMN_Send_Transfer_statusNotify().
 **      Extra command data:
 **          "statusType":"<statusType>"
 **          "statusValue":"<statusValue>"
@@ -116,11 +288,11 @@ static int8_t s8_MQTTMN_Send_scanNotify (void)
 **
 ** @param [in]
 **      pstri_type: Type of the status
-**      @arg    NOTIFY_FILE_UPLOAD_STATUS
-**      @arg    NOTIFY_FILE_DOWNLOAD_STATUS
 **      @arg    NOTIFY_OTA_DOWNLOAD_PROGRESS
 **      @arg    NOTIFY_OTA_INSTALL_PROGRESS
 **      @arg    NOTIFY_OTA_UPDATE_STATUS
+**      @arg    NOTIFY_MB_TRACE_EXPORT_STATUS
+**      @arg    NOTIFY_RT_LOG_EXPORT_STATUS
 **
 ** @param [in]
 **      pstri_value: Value of the status
@@ -140,28 +312,42 @@ static int8_t s8_MQTTMN_Send_scanNotify (void)
 */
 static int8_t s8_MQTTMN_Send_statusNotify (const char * pstri_type, const char * pstri_value, const char * pstri_desc)
 {
-    /* Construct the notify */
-    cJSON * px_notify_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_notify_root, JSON_KEY_CMD, "statusNotify");
-    cJSON_AddNumberToObject (px_notify_root, JSON_KEY_EID, g_u32_notify_eid);
-    g_u32_notify_eid = g_u32_notify_eid == 0x7FFFFFFF ? 1 : g_u32_notify_eid + 1;
-
-    cJSON_AddStringToObject (px_notify_root, "statusType", pstri_type);
-    cJSON_AddStringToObject (px_notify_root, "statusValue", pstri_value);
-    cJSON_AddStringToObject (px_notify_root, "description", pstri_desc);
+    return s8_MQTTMN_Send_Transfer_statusNotify (pstri_type, NULL, 0, pstri_value, pstri_desc);
+}
 
-    /* Publish the notify */
-    char * pstri_notify = cJSON_Print (px_notify_root);
-    cJSON_Delete (px_notify_root);
-    if (pstri_notify != NULL)
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes value of a numeric parameter in a paramReadResponse command
+**
+** @details
+**      JSON responses carry the value as a decimal string, CBOR responses carry it as an integer
+**
+** @param [in]
+**      pstru_json: The writer of the response
+**
+** @param [in]
+**      s64_value: Value of the parameter, within range of int32_t or uint32_t
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTTMN_Add_Param_Number (MQTTMN_json_t * pstru_json, int64_t s64_value)
+{
+    if (!pstru_json->b_cbor)
     {
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_NOTIFY, pstri_notify, 0);
-        free (pstri_notify);
-        return MQTTMN_OK;
+        char stri_value[16];
+        sprintf (stri_value, "%d", (int32_t)s64_value);
+        v_MQTTMN_Json_Add_String (pstru_json, "value", stri_value);
+    }
+    else if (s64_value < 0)
+    {
+        v_MQTTMN_Json_Add_Int32 (pstru_json, "value", (int32_t)s64_value);
+    }
+    else
+    {
+        v_MQTTMN_Json_Add_Uint32 (pstru_json, "value", (uint32_t)s64_value);
     }
-
-    LOGE ("Failed to construct command statusNotify");
-    return MQTTMN_ERR;
 }
 
 /**
@@ -176,6 +362,7 @@ static int8_t s8_MQTTMN_Send_statusNotify (const char * pstri_type, const char *
 **      Extra command data:
 **          "status":"<commandStatus>"
 **          "parameters":[ { "puc":<puc1>, "value":"<value1>"}, {"puc":<puc2>, "value":"<value2>"}, ... ]
+**      In response to a CBOR command, numeric values are integers and blob values are byte strings instead.
 **
 ** @param [in]
 **      pstru_session: the session to send the command
@@ -208,15 +395,13 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
     bool b_success = (strcmp (pstri_status, STATUS_OK) == 0);
 
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "paramReadResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "paramReadResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
     if (b_success)
     {
         /* Array of PUCs and parameter values */
-        cJSON * px_param_array = cJSON_CreateArray ();
-        cJSON_AddItemToObject (px_response_root, "parameters", px_param_array);
+        v_MQTTMN_Json_Begin_Array (&stru_json, "parameters");
         for (uint8_t u8_idx = 0; u8_idx < u8_num_pucs; u8_idx++)
         {
             uint16_t u16_puc = pu16_puc_list[u8_idx];
@@ -239,20 +424,17 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
             }
 
             /* Json object of this parameter */
-            cJSON * px_param_node = cJSON_CreateObject ();
-            cJSON_AddItemToArray (px_param_array, px_param_node);
-            cJSON_AddNumberToObject (px_param_node, "puc", u16_puc);
+            v_MQTTMN_Json_Begin_Object (&stru_json, NULL);
+            v_MQTTMN_Json_Add_Uint32 (&stru_json, "puc", u16_puc);
 
             /* Get parameter value */
-            char stri_value[16];
             switch (enm_type)
             {
                 case BASE_TYPE_uint8_t:
                 {
                     uint8_t u8_value = 0;
                     s8_PARAM_Get_Uint8 (enm_param_id, &u8_value);
-                    sprintf (stri_value, "%d", u8_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, u8_value);
                     break;
                 }
 
@@ -260,8 +442,7 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                 {
                     int8_t s8_value = 0;
                     s8_PARAM_Get_Int8 (enm_param_id, &s8_value);
-                    sprintf (stri_value, "%d", s8_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, s8_value);
                     break;
                 }
 
@@ -269,8 +450,7 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                 {
                     uint16_t u16_value = 0;
                     s8_PARAM_Get_Uint16 (enm_param_id, &u16_value);
-                    sprintf (stri_value, "%d", u16_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, u16_value);
                     break;
                 }
 
@@ -278,8 +458,7 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                 {
                     int16_t s16_value = 0;
                     s8_PARAM_Get_Int16 (enm_param_id, &s16_value);
-                    sprintf (stri_value, "%d", s16_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, s16_value);
                     break;
                 }
 
@@ -287,8 +466,7 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                 {
                     uint32_t u32_value = 0;
                     s8_PARAM_Get_Uint32 (enm_param_id, &u32_value);
-                    sprintf (stri_value, "%d", u32_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, u32_value);
                     break;
                 }
 
@@ -296,30 +474,26 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                 {
                     int32_t s32_value = 0;
                     s8_PARAM_Get_Int32 (enm_param_id, &s32_value);
-                    sprintf (stri_value, "%d", s32_value);
-                    cJSON_AddStringToObject (px_param_node, "value", stri_value);
+                    v_MQTTMN_Add_Param_Number (&stru_json, s32_value);
                     break;
                 }
 
                 case BASE_TYPE_string:
                 {
-                    char * pstri_value = "";
-                    s8_PARAM_Get_String (enm_param_id, &pstri_value);
-                    cJSON_AddStringToObject (px_param_node, "value", pstri_value);
-                    free (pstri_value);
+                    const char * pstri_value;
+                    s8_PARAM_Borrow_String (enm_param_id, &pstri_value);
+                    v_MQTTMN_Json_Add_String (&stru_json, "value", pstri_value);
+                    v_PARAM_Release ();
                     break;
                 }
 
                 case BASE_TYPE_blob:
                 {
-                    uint8_t * pu8_value;
+                    const uint8_t * pu8_value;
                     uint16_t u16_len = 0;
-                    char * pstri_hex;
-                    s8_PARAM_Get_Blob (enm_param_id, &pu8_value, &u16_len);
-                    v_MQTTMN_Data2Hex (pu8_value, u16_len, &pstri_hex);
-                    cJSON_AddStringToObject (px_param_node, "value", pstri_hex);
-                    free (pu8_value);
-                    free (pstri_hex);
+                    s8_PARAM_Borrow_Blob (enm_param_id, &pu8_value, &u16_len);
+                    v_MQTTMN_Json_Add_Hex (&stru_json, "value", pu8_value, u16_len);
+                    v_PARAM_Release ();
                     break;
                 }
 
@@ -329,22 +503,13 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
                     break;
                 }
             }
+            v_MQTTMN_Json_End_Object (&stru_json);
         }
+        v_MQTTMN_Json_End_Array (&stru_json);
     }
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command paramReadResponse");
-    return MQTTMN_ERR;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -380,24 +545,108 @@ static int8_t s8_MQTTMN_Send_paramReadResponse (MQTTMN_session_t * pstru_session
 static int8_t s8_MQTTMN_Send_paramWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
 {
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "paramWriteResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "paramWriteResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a paramSnapshotReadResponse command
+**
+** @details
+**      This command is used to respond to a paramSnapshotReadRequest command.
+**      Extra command data:
+**          "status":"<commandStatus>"
+**          "snapshot":"<hexString>"        (unless the snapshot has been written to a file, a byte string in CBOR)
+**
+** @param [in]
+**      pstru_session: the session to send the command
+**
+** @param [in]
+**      pstri_status: Command status
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**      @arg    STATUS_ERR_NOT_SUPPORTED
+**      @arg    STATUS_ERR_INVALID_DATA
+**      @arg    STATUS_ERR_BUSY
+**      @arg    STATUS_ERR_STATE_NOT_ALLOWED
+**      @arg    STATUS_ERR_INVALID_ACCESS
+**
+** @param [in]
+**      pu8_snapshot: The snapshot, NULL if it is not sent in the response
+**
+** @param [in]
+**      u16_len: Length in bytes of the snapshot
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Send_paramSnapshotReadResponse (MQTTMN_session_t * pstru_session, const char * pstri_status,
+                                                        const uint8_t * pu8_snapshot, uint16_t u16_len)
+{
+    /* Construct the response */
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "paramSnapshotReadResponse", pstru_session->u32_request_eid,
+                         pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
+    if ((strcmp (pstri_status, STATUS_OK) == 0) && (pu8_snapshot != NULL))
     {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
+        v_MQTTMN_Json_Add_Hex (&stru_json, "snapshot", pu8_snapshot, u16_len);
     }
 
-    LOGE ("Failed to construct command paramWriteResponse");
-    return MQTTMN_ERR;
+    /* Publish the response */
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends a paramSnapshotWriteResponse command
+**
+** @details
+**      This command is used to respond to a paramSnapshotWriteRequest command.
+**      Extra command data:
+**          "status":"<commandStatus>"
+**
+** @param [in]
+**      pstru_session: the session to send the command
+**
+** @param [in]
+**      pstri_status: Command status
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**      @arg    STATUS_ERR_NOT_SUPPORTED
+**      @arg    STATUS_ERR_INVALID_DATA
+**      @arg    STATUS_ERR_BUSY
+**      @arg    STATUS_ERR_STATE_NOT_ALLOWED
+**      @arg    STATUS_ERR_INVALID_ACCESS
+**
+** @return
+**      @arg    MQTTMN_OK
+**      @arg    MQTTMN_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int8_t s8_MQTTMN_Send_paramSnapshotWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
+{
+    /* Construct the response */
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "paramSnapshotWriteResponse", pstru_session->u32_request_eid,
+                         pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
+
+    /* Publish the response */
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -449,39 +698,27 @@ static int8_t s8_MQTTMN_Send_fileListReadResponse (MQTTMN_session_t * pstru_sess
     }
 
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "fileListReadResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "fileListReadResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
     if (b_success)
     {
         /* Array of file names */
-        cJSON * px_filename_array = cJSON_CreateArray ();
-        cJSON_AddItemToObject (px_response_root, "files", px_filename_array);
+        v_MQTTMN_Json_Begin_Array (&stru_json, "files");
         struct lfs2_info stru_file_info;
         while (lfs2_dir_read (g_px_lfs2, &x_dir, &stru_file_info) > 0)
         {
             if (stru_file_info.type == LFS2_TYPE_REG)
             {
-                cJSON_AddItemToArray (px_filename_array, cJSON_CreateString (stru_file_info.name));
+                v_MQTTMN_Json_Add_String (&stru_json, NULL, stru_file_info.name);
             }
         }
+        v_MQTTMN_Json_End_Array (&stru_json);
         lfs2_dir_close (g_px_lfs2, &x_dir);
     }
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command fileListReadResponse");
-    return MQTTMN_ERR;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -493,10 +730,11 @@ static int8_t s8_MQTTMN_Send_fileListReadResponse (MQTTMN_session_t * pstru_sess
 ** @details
 **      This command is used to respond to a fileUploadWriteRequest command. If the file can be uploaded, the requested
 **      Rotimatic node(s) shall respond with status of ok. Upon receiving a response with ok status, the back-office
-**      node shall send content of the file via #/data channel. Rotimatic node(s) shall report status of the file
-**      uploading via statusNotify command.
+**      node shall send content of the file via #/data channel, starting from the returned offset. Rotimatic node(s)
+**      shall report status of the file uploading via statusNotify command.
 **      Extra command data:
 **          "status":"<commandStatus>"
+**          "offset":<byteOffset>
 **
 ** @param [in]
 **      pstru_session: the session to send the command
@@ -511,33 +749,31 @@ static int8_t s8_MQTTMN_Send_fileListReadResponse (MQTTMN_session_t * pstru_sess
 **      @arg    STATUS_ERR_STATE_NOT_ALLOWED
 **      @arg    STATUS_ERR_INVALID_ACCESS
 **
+** @param [in]
+**      u32_offset: offset in the file of the first byte to send. This is only used if pstri_status is STATUS_OK
+**
 ** @return
 **      @arg    MQTTMN_OK
 **      @arg    MQTTMN_ERR
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-static int8_t s8_MQTTMN_Send_fileUploadWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
+static int8_t s8_MQTTMN_Send_fileUploadWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status,
+                                                      uint32_t u32_offset)
 {
-    /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "fileUploadWriteResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    bool b_success = (strcmp (pstri_status, STATUS_OK) == 0);
 
-    /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
+    /* Construct the response */
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "fileUploadWriteResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
+    if (b_success)
     {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "offset", u32_offset);
     }
 
-    LOGE ("Failed to construct command fileUploadWriteResponse");
-    return MQTTMN_ERR;
+    /* Publish the response */
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -587,29 +823,17 @@ static int8_t s8_MQTTMN_Send_fileDownloadReadResponse (MQTTMN_session_t * pstru_
     bool b_success = (strcmp (pstri_status, STATUS_OK) == 0);
 
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "fileDownloadReadResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "fileDownloadReadResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
     if (b_success)
     {
-        cJSON_AddNumberToObject (px_response_root, "size", u32_file_size);
-        cJSON_AddNumberToObject (px_response_root, "checksum", u32_checksum);
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "size", u32_file_size);
+        v_MQTTMN_Json_Add_Uint32 (&stru_json, "checksum", u32_checksum);
     }
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command fileDownloadReadResponse");
-    return MQTTMN_ERR;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -647,24 +871,12 @@ static int8_t s8_MQTTMN_Send_fileDownloadReadResponse (MQTTMN_session_t * pstru_
 static int8_t s8_MQTTMN_Send_fileDeleteWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
 {
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "fileDeleteWriteResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "fileDeleteWriteResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command fileDeleteWriteResponse");
-    return MQTTMN_ERR;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -702,24 +914,12 @@ static int8_t s8_MQTTMN_Send_fileDeleteWriteResponse (MQTTMN_session_t * pstru_s
 static int8_t s8_MQTTMN_Send_fileRunWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
 {
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "fileRunWriteResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "fileRunWriteResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command fileRunWriteResponse");
-    return MQTTMN_ERR;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
@@ -755,117 +955,12 @@ static int8_t s8_MQTTMN_Send_fileRunWriteResponse (MQTTMN_session_t * pstru_sess
 static int8_t s8_MQTTMN_Send_otaUpdateWriteResponse (MQTTMN_session_t * pstru_session, const char * pstri_status)
 {
     /* Construct the response */
-    cJSON * px_response_root = cJSON_CreateObject ();
-    cJSON_AddStringToObject (px_response_root, JSON_KEY_CMD, "otaUpdateWriteResponse");
-    cJSON_AddNumberToObject (px_response_root, JSON_KEY_EID, pstru_session->u32_request_eid);
-    cJSON_AddStringToObject (px_response_root, "status", pstri_status);
+    MQTTMN_json_t stru_json;
+    v_MQTTMN_Json_Begin (&stru_json, "otaUpdateWriteResponse", pstru_session->u32_request_eid, pstru_session->b_cbor);
+    v_MQTTMN_Json_Add_String (&stru_json, "status", pstri_status);
 
     /* Publish the response */
-    char * pstri_response = cJSON_Print (px_response_root);
-    cJSON_Delete (px_response_root);
-    if (pstri_response != NULL)
-    {
-        v_MQTT_Set_Publish_Topic (g_x_mqtt, MQTT_S2M_RESPONSE, pstru_session->stri_response_topic);
-        enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_RESPONSE, pstri_response, 0);
-        free (pstri_response);
-        return MQTTMN_OK;
-    }
-
-    LOGE ("Failed to construct command otaUpdateWriteResponse");
-    return MQTTMN_ERR;
-}
-
-/**
-** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-**
-** @brief
-**      Publishes content of a file via MQTT_PUB_DOWNLOAD topic
-**
-** @return
-**      @arg    MQTTMN_OK
-**      @arg    MQTTMN_ERR
-**
-** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-*/
-static int8_t s8_MQTTMN_Publish_Downloading_File (void)
-{
-    LOGI ("Sending content of file %s ...", g_stri_download_file);
-
-    /* Check if a file is being downloaded (its file path is not an empty string) */
-    if (g_stri_download_file[0] == 0)
-    {
-        ESP_LOGW (TAG, "No file is being requested for downloading");
-        return MQTTMN_ERR;
-    }
-
-    /* Get file size */
-    struct lfs2_info stru_file_info;
-    if (lfs2_stat (g_px_lfs2, g_stri_download_file, &stru_file_info) < 0)
-    {
-        LOGE ("Failed to get information of file %s", g_stri_download_file);
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, STATUS_ERR, "Failed to get file information");
-        g_stri_download_file[0] = 0;
-        return MQTTMN_ERR;
-    }
-    uint32_t u32_file_size = stru_file_info.size;
-
-    /* Allocate buffer for reading file data */
-    void * pv_data = malloc (MAX_DOWNLOAD_CHUNK_LEN);
-    if (pv_data == NULL)
-    {
-        LOGE ("Failed to allocate buffer for reading file data");
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, STATUS_ERR, "Failed to allocate memory for file data");
-        g_stri_download_file[0] = 0;
-        return MQTTMN_ERR;
-    }
-
-    /* Open the file for reading */
-    lfs2_file_t x_file;
-    if (lfs2_file_open (g_px_lfs2, &x_file, g_stri_download_file, LFS2_O_RDONLY) < 0)
-    {
-        LOGE ("Failed to open file %s for reading", g_stri_download_file);
-        free (pv_data);
-        s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, STATUS_ERR, "Failed to open file for reading");
-        g_stri_download_file[0] = 0;
-        return MQTTMN_ERR;
-    }
-
-    /* Read and publish data of the file */
-    size_t x_num_read = 0;
-    uint32_t u32_tx_count = 0;
-    do
-    {
-        x_num_read = lfs2_file_read (g_px_lfs2, &x_file, pv_data, MAX_DOWNLOAD_CHUNK_LEN);
-        u32_tx_count += x_num_read;
-        if (x_num_read > 0)
-        {
-            if (enm_MQTT_Publish (g_x_mqtt, MQTT_S2M_DATA, pv_data, x_num_read) != MQTT_OK)
-            {
-                LOGE ("Failed to publish file data to the master");
-                lfs2_file_close (g_px_lfs2, &x_file);
-                free (pv_data);
-                s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, STATUS_ERR,
-                                             "Failed to publish file data");
-                g_stri_download_file[0] = 0;
-                return MQTTMN_ERR;
-            }
-
-            /* Display progress every 20% of the file has been sent */
-            if (u32_tx_count % (u32_file_size / 5) < MAX_DOWNLOAD_CHUNK_LEN)
-            {
-                LOGI ("%d bytes sent", u32_tx_count);
-            }
-        }
-    }
-    while (x_num_read == MAX_DOWNLOAD_CHUNK_LEN);
-
-    /* Downloading done */
-    lfs2_file_close (g_px_lfs2, &x_file);
-    free (pv_data);
-    LOGI ("%d bytes of file %s has been sent successfully", u32_tx_count, g_stri_download_file);
-    s8_MQTTMN_Send_statusNotify (NOTIFY_FILE_DOWNLOAD_STATUS, STATUS_OK, "");
-    g_stri_download_file[0] = 0;
-    return MQTTMN_OK;
+    return s8_MQTTMN_Publish_Response (pstru_session, &stru_json);
 }
 
 /**
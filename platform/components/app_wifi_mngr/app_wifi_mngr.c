@@ -50,12 +50,15 @@
 /** @brief  Priority of App_Wifi_Mngr task */
 #define WIFIMN_TASK_PRIORITY            (tskIDLE_PRIORITY + 0)
 
-/** @brief  Cycle in milliseconds of App_Wifi_Mngr task */
-#define WIFIMN_TASK_PERIOD_MS           100
-
 /** @brief  Wifi start scan event */
 #define WIFIMN_START_SCAN_EVENT         (BIT0)
 
+/** @brief  Event of a change of the user configurable wifi access point */
+#define WIFIMN_USER_AP_CHANGED_EVENT    (BIT1)
+
+/** @brief  Event of a request to connect to the user configurable wifi access point */
+#define WIFIMN_CONNECT_USER_AP_EVENT    (BIT2)
+
 /** @brief  Number of known wifi access points */
 #define WIFIMN_NUM_KNOWN_AP             (sizeof (g_astru_ap) / sizeof (g_astru_ap[0]))
 
@@ -160,6 +163,9 @@ static uint16_t g_u16_ap_list_count = 0;
 
 static void v_WIFIMN_Main_Task (void * pv_param);
 static void v_WIFIMN_Do_Scanning (void);
+static bool b_WIFIMN_Load_User_Ap (void);
+static void v_WIFIMN_Apply_User_Ap (bool b_forced);
+static void v_WIFIMN_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg);
 static void v_WIFIMN_Event_Handler_Normal_Station (WIFI_event_t enm_event);
 static void v_WIFIMN_Event_Handler_Test_Station (WIFI_event_t enm_event);
 
@@ -192,22 +198,7 @@ int8_t s8_WIFIMN_Init (void)
     }
 
     /* Get SSID and password of the user configurable wifi access point */
-    char * pstri_ssid;
-    if (s8_PARAM_Get_String (PARAM_WIFI_SSID, &pstri_ssid) == PARAM_OK)
-    {
-        strncpy (g_astru_ap[WIFIMN_USER_AP_IDX].stri_ssid, pstri_ssid, WIFIMN_SSID_LEN);
-        g_astru_ap[WIFIMN_USER_AP_IDX].stri_ssid [WIFIMN_SSID_LEN - 1] = 0;
-        free (pstri_ssid);
-
-        /* Get password of the selected wifi access point */
-        char * pstri_password;
-        if (s8_PARAM_Get_String (PARAM_WIFI_PSW, &pstri_password) == PARAM_OK)
-        {
-            strncpy (g_astru_ap[WIFIMN_USER_AP_IDX].stri_psw, pstri_password, WIFIMN_PSW_LEN);
-            g_astru_ap[WIFIMN_USER_AP_IDX].stri_psw [WIFIMN_PSW_LEN - 1] = 0;
-            free (pstri_password);
-        }
-    }
+    b_WIFIMN_Load_User_Ap ();
 
     /* Check if we are in test station mode */
     if (g_b_test_station_mode)
@@ -253,6 +244,13 @@ int8_t s8_WIFIMN_Init (void)
     /* Create FreeRTOS event group */
     g_x_event_group = xEventGroupCreate ();
 
+    /* Apply changes of the user configurable wifi access point as soon as they are made */
+    if (s8_PARAM_Subscribe (PARAM_MASK (PARAM_WIFI_SSID) | PARAM_MASK (PARAM_WIFI_PSW),
+                            v_WIFIMN_Param_Change_Handler, NULL) != PARAM_OK)
+    {
+        return WIFIMN_ERR;
+    }
+
     /* Create task running this module */
     xTaskCreateStaticPinnedToCore ( v_WIFIMN_Main_Task,         /* Function that implements the task */
                                     "App_Wifi_Mngr",            /* Text name for the task */
@@ -363,7 +361,8 @@ int8_t s8_WIFIMN_Get_Num_Backup_Ap (uint8_t * pu8_num_backup_ap)
 **      Forces to connect with an user access point.
 **
 ** @note
-**      This function also stores information of the given access point into non-volatile flash
+**      This function also stores information of the given access point into non-volatile flash. The connection is
+**      then made by App_Wifi_Mngr task.
 **
 ** @param [out]
 **      pstru_ap: Information of the access point to connect
@@ -378,29 +377,23 @@ int8_t s8_WIFIMN_Connect (const WIFIMN_cred_t * pstru_ap)
 {
     ASSERT_PARAM (g_b_initialized && (pstru_ap != NULL));
 
-    /* Store information of the given user access point */
-    g_astru_ap[WIFIMN_USER_AP_IDX] = *pstru_ap;
-    if (s8_PARAM_Set_String (PARAM_WIFI_SSID, g_astru_ap[WIFIMN_USER_AP_IDX].stri_ssid) != PARAM_OK)
+    /* Store information of the given user access point, SSID and password are changed together if possible */
+    bool b_trans = (s8_PARAM_Begin () == PARAM_OK);
+    if (s8_PARAM_Set_String (PARAM_WIFI_SSID, pstru_ap->stri_ssid) != PARAM_OK)
     {
         LOGE ("Failed to save wifi SSID to non-volatile storage");
     }
-    if (s8_PARAM_Set_String (PARAM_WIFI_PSW, g_astru_ap[WIFIMN_USER_AP_IDX].stri_psw) != PARAM_OK)
+    if (s8_PARAM_Set_String (PARAM_WIFI_PSW, pstru_ap->stri_psw) != PARAM_OK)
     {
         LOGE ("Failed to save wifi password to non-volatile storage");
     }
-
-    /* If we are in test station mode, switch back to normal mode */
-    if (g_b_test_station_mode)
+    if (b_trans && (s8_PARAM_Commit () != PARAM_OK))
     {
-        s8_WIFI_Register_Event_Handler (v_WIFIMN_Event_Handler_Normal_Station);
-        g_b_test_station_mode = false;
+        LOGE ("Failed to save wifi access point to non-volatile storage");
     }
 
-    /* Try to connects to the given wifi access point */
-    g_b_wifi_disconnect_forced = false;
-    g_u8_current_ap_idx = WIFIMN_USER_AP_IDX;
-    g_u8_retries = 0;
-    s8_WIFI_Connect (g_astru_ap[g_u8_current_ap_idx].stri_ssid, g_astru_ap[g_u8_current_ap_idx].stri_psw, NULL);
+    /* App_Wifi_Mngr task loads the stored access point and connects to it */
+    xEventGroupSetBits (g_x_event_group, WIFIMN_CONNECT_USER_AP_EVENT);
 
     return WIFIMN_OK;
 }
@@ -518,9 +511,11 @@ static void v_WIFIMN_Main_Task (void * pv_param)
     /* Endless loop of the task */
     while (true)
     {
-        /* Waiting for task tick or a FreeRTOS event occurs */
-        EventBits_t x_event_bits = xEventGroupWaitBits (g_x_event_group, WIFIMN_START_SCAN_EVENT, pdTRUE, pdFALSE,
-                                                        pdMS_TO_TICKS (WIFIMN_TASK_PERIOD_MS));
+        /* Waiting for a FreeRTOS event occurs */
+        EventBits_t x_event_bits = xEventGroupWaitBits (g_x_event_group,
+                                                        WIFIMN_START_SCAN_EVENT | WIFIMN_USER_AP_CHANGED_EVENT |
+                                                        WIFIMN_CONNECT_USER_AP_EVENT,
+                                                        pdTRUE, pdFALSE, portMAX_DELAY);
 
         /* If requested to start wifi scanning */
         if (x_event_bits & WIFIMN_START_SCAN_EVENT)
@@ -528,6 +523,12 @@ static void v_WIFIMN_Main_Task (void * pv_param)
             v_WIFIMN_Do_Scanning ();
         }
 
+        /* If the user configurable wifi access point has changed or connecting to it is requested */
+        if (x_event_bits & (WIFIMN_USER_AP_CHANGED_EVENT | WIFIMN_CONNECT_USER_AP_EVENT))
+        {
+            v_WIFIMN_Apply_User_Ap ((x_event_bits & WIFIMN_CONNECT_USER_AP_EVENT) != 0);
+        }
+
         /* Display remaining stack space every 30s */
         // PRINT_STACK_USAGE (30000);
     }
@@ -617,6 +618,112 @@ static void v_WIFIMN_Do_Scanning (void)
     g_enm_scanning_state = enm_scanning_state;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Loads SSID and password of the user configurable wifi access point from parameters
+**
+** @return
+**      @arg    true: The access point has changed
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_WIFIMN_Load_User_Ap (void)
+{
+    WIFIMN_cred_t stru_ap = g_astru_ap[WIFIMN_USER_AP_IDX];
+
+    /* Get SSID of the access point */
+    const char * pstri_ssid;
+    if (s8_PARAM_Borrow_String (PARAM_WIFI_SSID, &pstri_ssid) == PARAM_OK)
+    {
+        strncpy (stru_ap.stri_ssid, pstri_ssid, WIFIMN_SSID_LEN);
+        stru_ap.stri_ssid [WIFIMN_SSID_LEN - 1] = 0;
+        v_PARAM_Release ();
+
+        /* Get password of the access point */
+        const char * pstri_password;
+        if (s8_PARAM_Borrow_String (PARAM_WIFI_PSW, &pstri_password) == PARAM_OK)
+        {
+            strncpy (stru_ap.stri_psw, pstri_password, WIFIMN_PSW_LEN);
+            stru_ap.stri_psw [WIFIMN_PSW_LEN - 1] = 0;
+            v_PARAM_Release ();
+        }
+    }
+
+    /* Check if it has changed */
+    if ((strcmp (stru_ap.stri_ssid, g_astru_ap[WIFIMN_USER_AP_IDX].stri_ssid) == 0) &&
+        (strcmp (stru_ap.stri_psw, g_astru_ap[WIFIMN_USER_AP_IDX].stri_psw) == 0))
+    {
+        return false;
+    }
+
+    g_astru_ap[WIFIMN_USER_AP_IDX] = stru_ap;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Connects to the user configurable wifi access point if it has been changed through parameters or if
+**      s8_WIFIMN_Connect() has been called
+**
+** @details
+**      The parameters can be changed by MQTT commands, the GUI or MicroPython scripts. In test station mode, the new
+**      access point is only stored and used once test station mode ends, unless connecting to it is forced.
+**      The user configurable access point in g_astru_ap[] is only updated here, by App_Wifi_Mngr task.
+**
+** @param [in]
+**      b_forced: Connect to the access point even if it has not changed, switch back to normal mode if needed
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WIFIMN_Apply_User_Ap (bool b_forced)
+{
+    bool b_changed = b_WIFIMN_Load_User_Ap ();
+
+    /* If we are in test station mode and connecting is forced, switch back to normal mode */
+    if (b_forced && g_b_test_station_mode)
+    {
+        s8_WIFI_Register_Event_Handler (v_WIFIMN_Event_Handler_Normal_Station);
+        g_b_test_station_mode = false;
+    }
+
+    if ((b_changed || b_forced) && !g_b_test_station_mode)
+    {
+        LOGI ("Connecting to user wifi access point %s", g_astru_ap[WIFIMN_USER_AP_IDX].stri_ssid);
+        g_b_wifi_disconnect_forced = false;
+        g_u8_current_ap_idx = WIFIMN_USER_AP_IDX;
+        g_u8_retries = 0;
+        s8_WIFI_Connect (g_astru_ap[g_u8_current_ap_idx].stri_ssid, g_astru_ap[g_u8_current_ap_idx].stri_psw, NULL);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Handler of changes of wifi parameters
+**
+** @note
+**      This handler is invoked in the context of the task changing the parameters, the change is therefore applied
+**      by App_Wifi_Mngr task
+**
+** @param [in]
+**      pstru_change: The change
+**
+** @param [in]
+**      pv_arg: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WIFIMN_Param_Change_Handler (const PARAM_change_t * pstru_change, void * pv_arg)
+{
+    xEventGroupSetBits (g_x_event_group, WIFIMN_USER_AP_CHANGED_EVENT);
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
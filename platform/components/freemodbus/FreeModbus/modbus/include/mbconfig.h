@@ -163,6 +163,16 @@ PR_BEGIN_EXTERN_C
 /*! \brief The total slaves in Modbus Master system. Default 16.
  * \note : The slave ID must be continuous from 1.*/
 #define MB_MASTER_TOTAL_SLAVE_NUM               ( 16 )
+/*! \brief If bus trace of Modbus master frames is enabled. */
+#if defined(CONFIG_FMB_TRACE_ENABLE)
+#define MB_MASTER_TRACE_ENABLED                 (  1 )
+#else
+#define MB_MASTER_TRACE_ENABLED                 (  0 )
+#endif
 #endif /* #if defined(CONFIG_MODBUS_ZPL_MASTER) */
 
+#ifndef MB_MASTER_TRACE_ENABLED
+#define MB_MASTER_TRACE_ENABLED                 (  0 )
+#endif
+
 #endif
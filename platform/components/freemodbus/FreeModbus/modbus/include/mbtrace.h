@@ -0,0 +1,127 @@
+/*
+ * (C) Copyright 2022
+ * Zimplistic Private Limited
+ */
+#ifndef _MB_TRACE_H
+#define _MB_TRACE_H
+
+#include "port.h"
+#include "mbconfig.h"
+
+#ifdef __cplusplus
+PR_BEGIN_EXTERN_C
+#endif
+
+/*! \defgroup mbtrace Modbus Master bus trace
+ * \code #include "mbtrace.h" \endcode
+ *
+ * This module keeps an always-on binary trace of the Modbus master link. Every
+ * transmitted and received serial frame (slave address, PDU and CRC) is copied
+ * into a ring buffer in PSRAM together with a microsecond timestamp, its
+ * direction, function code and error status. Link errors without a frame
+ * (respond timeout, receive error, execute error) are recorded as events.
+ *
+ * Recording only costs a timestamp read and one memcpy, no log formatting is
+ * done in the hot path. The ring can be exported as a pcap file (link type
+ * LINKTYPE_USER0) to LittleFS, then downloaded over MQTT and decoded on the
+ * host with tools/mb_trace_decode.py or Wireshark.
+ */
+
+/* ----------------------- Defines ------------------------------------------*/
+
+/*! \ingroup mbtrace
+ * \brief Default path of the exported trace file.
+ */
+#define MB_TRACE_EXPORT_FILE    "mbtrace.pcap"
+
+/* ----------------------- Type definitions ---------------------------------*/
+
+/*! \ingroup mbtrace
+ * \brief Direction of a trace record.
+ */
+typedef enum
+{
+    MB_TRACE_DIR_TX = 0,            /*!< Frame sent by the master. */
+    MB_TRACE_DIR_RX = 1,            /*!< Frame received from a slave. */
+    MB_TRACE_DIR_EVT = 2,           /*!< Link event without frame data. */
+} eMBTraceDir;
+
+/*! \ingroup mbtrace
+ * \brief Status of a trace record.
+ */
+typedef enum
+{
+    MB_TRACE_OK = 0,                /*!< Frame is valid. */
+    MB_TRACE_ERR_FRAME = 1,         /*!< Received frame is too short or has a bad CRC. */
+    MB_TRACE_ERR_DISCARDED = 2,     /*!< Received bytes were dropped by the serial port. */
+    MB_TRACE_ERR_RECEIVE = 3,       /*!< Receive error reported to the application. */
+    MB_TRACE_ERR_TIMEOUT = 4,       /*!< Slave did not respond in time. */
+    MB_TRACE_ERR_EXECUTE = 5,       /*!< Response handler or slave returned an exception. */
+} eMBTraceStatus;
+
+/* ----------------------- Function prototypes ------------------------------*/
+#if MB_MASTER_TRACE_ENABLED > 0
+
+/*! \ingroup mbtrace
+ * \brief Allocate the trace ring in PSRAM.
+ *
+ * Called once by eMBMasterInit(). If the ring can't be allocated, tracing is
+ * disabled and all record functions become no-ops.
+ *
+ * \return TRUE if the trace ring is available.
+ */
+BOOL            xMBMasterTraceInit( void );
+
+/*! \ingroup mbtrace
+ * \brief Record a serial frame.
+ *
+ * \param eDir Direction of the frame.
+ * \param eStatus Status of the frame.
+ * \param pucFrame Serial frame starting with the slave address.
+ * \param usLength Length of the frame in bytes. Frames longer than the
+ *        configured snapshot length are truncated.
+ */
+void            vMBMasterTraceFrame( eMBTraceDir eDir, eMBTraceStatus eStatus,
+                                     const UCHAR * pucFrame, USHORT usLength );
+
+/*! \ingroup mbtrace
+ * \brief Record a link event related to the pending request.
+ *
+ * \param eStatus Error status of the event.
+ * \param ucSlaveAddress Destination address of the pending request.
+ * \param ucFunctionCode Function code of the pending request.
+ */
+void            vMBMasterTraceEvent( eMBTraceStatus eStatus, UCHAR ucSlaveAddress, UCHAR ucFunctionCode );
+
+/*! \ingroup mbtrace
+ * \brief Discard all records in the trace ring.
+ */
+void            vMBMasterTraceClear( void );
+
+/*! \ingroup mbtrace
+ * \brief Write the current content of the trace ring to a pcap file.
+ *
+ * Records are written from oldest to newest. Recording is not stopped while
+ * exporting, records overwritten during the export are skipped.
+ *
+ * \param pcPath Path of the file in LittleFS.
+ * \param pulNumRecords If not NULL, receives number of exported records.
+ *
+ * \return TRUE if the file has been written successfully.
+ */
+BOOL            xMBMasterTraceExport( const CHAR * pcPath, ULONG * pulNumRecords );
+
+#else
+
+#define xMBMasterTraceInit( )                       ( FALSE )
+#define vMBMasterTraceFrame( eDir, eStatus, pucFrame, usLength )
+#define vMBMasterTraceEvent( eStatus, ucSlaveAddress, ucFunctionCode )
+#define vMBMasterTraceClear( )
+#define xMBMasterTraceExport( pcPath, pulNumRecords )   ( FALSE )
+
+#endif /* #if MB_MASTER_TRACE_ENABLED > 0 */
+
+#ifdef __cplusplus
+PR_END_EXTERN_C
+#endif
+#endif /* _MB_TRACE_H */
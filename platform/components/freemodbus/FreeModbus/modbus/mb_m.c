@@ -45,6 +45,7 @@
 
 #include "mbport.h"
 #include "mbzpl.h"
+#include "mbtrace.h"
 
 #ifndef MB_PORT_HAS_CLOSE
 #define MB_PORT_HAS_CLOSE 1
@@ -139,6 +140,8 @@ eMBMasterInit( eMBMode eMode, UCHAR ucPort, ULONG ulBaudRate, eMBParity eParity
         }
         /* initialize the OS resource for modbus master. */
         vMBMasterOsResInit();
+        /* Bus trace is optional, the stack works without it. */
+        ( void ) xMBMasterTraceInit();
     }
     return eStatus;
 }
@@ -327,14 +330,17 @@ eMBMasterPoll( void )
             switch ( errorType )
             {
                 case EV_ERROR_RESPOND_TIMEOUT:
+                    vMBMasterTraceEvent( MB_TRACE_ERR_TIMEOUT, ucMBMasterGetDestAddress( ), ucMBFrame[MB_PDU_FUNC_OFF] );
                     vMBMasterErrorCBRespondTimeout( ucMBMasterGetDestAddress( ),
                             ucMBFrame, usMBMasterGetPDUSndLength( ) );
                     break;
                 case EV_ERROR_RECEIVE_DATA:
+                    vMBMasterTraceEvent( MB_TRACE_ERR_RECEIVE, ucMBMasterGetDestAddress( ), ucMBFrame[MB_PDU_FUNC_OFF] );
                     vMBMasterErrorCBReceiveData( ucMBMasterGetDestAddress( ),
                             ucMBFrame, usMBMasterGetPDUSndLength( ) );
                     break;
                 case EV_ERROR_EXECUTE_FUNCTION:
+                    vMBMasterTraceEvent( MB_TRACE_ERR_EXECUTE, ucMBMasterGetDestAddress( ), ucMBFrame[MB_PDU_FUNC_OFF] );
                     vMBMasterErrorCBExecuteFunction( ucMBMasterGetDestAddress( ),
                             ucMBFrame, usMBMasterGetPDUSndLength( ) );
                     break;
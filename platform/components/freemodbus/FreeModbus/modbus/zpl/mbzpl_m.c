@@ -20,6 +20,7 @@
 
 #include "mbcrc.h"
 #include "mbport.h"
+#include "mbtrace.h"
 
 /* ----------------------- Defines ------------------------------------------*/
 #define MB_ZPL_SER_PDU_SIZE_MIN 4
@@ -155,6 +156,9 @@ eMBMasterZPLReceive( UCHAR * pucRcvAddress, UCHAR ** pucFrame, USHORT * pusLengt
         eStatus = MB_EIO;
     }
 
+    vMBMasterTraceFrame( MB_TRACE_DIR_RX, ( eStatus == MB_ENOERR ) ? MB_TRACE_OK : MB_TRACE_ERR_FRAME,
+                         ( UCHAR * ) ucMasterZPLRcvBuf, usMasterRcvBufferPos );
+
     EXIT_CRITICAL_SECTION(  );
     return eStatus;
 }
@@ -187,6 +191,7 @@ eMBMasterZPLSend( UCHAR ucSlaveAddress, const UCHAR * pucFrame, USHORT usLength
         usCRC16 = usMBCRC16( ( UCHAR * ) pucMasterSndBufferCur, usMasterSndBufferCount );
         ucMasterZPLSndBuf[usMasterSndBufferCount++] = ( UCHAR )( usCRC16 & 0xFF );
         ucMasterZPLSndBuf[usMasterSndBufferCount++] = ( UCHAR )( usCRC16 >> 8 );
+        vMBMasterTraceFrame( MB_TRACE_DIR_TX, MB_TRACE_OK, ( UCHAR * ) pucMasterSndBufferCur, usMasterSndBufferCount );
 
         /* Activate the transmitter. */
         eSndState = STATE_M_TX_XMIT;
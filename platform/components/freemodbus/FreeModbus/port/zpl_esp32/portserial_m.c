@@ -40,6 +40,7 @@
 #include "mbport.h"
 #include "mbzpl.h"
 #include "mbconfig.h"
+#include "mbtrace.h"
 
 #include <string.h>
 #include "driver/uart.h"
@@ -130,10 +131,9 @@ static USHORT usMBMasterPortSerialRxPoll(size_t xEventSize)
         }
         else
         {
-            for (int i = 0; i < ucMasterRcvBufTmpIdx; i++)
-            {
-                ESP_LOGE("tuan", "data[%d] = %d", i, ucMasterRcvBufTmp[i]);
-            }
+            // Frame is dropped here, keep its bytes in the bus trace for offline analysis
+            vMBMasterTraceFrame(MB_TRACE_DIR_RX, MB_TRACE_ERR_DISCARDED,
+                                (const UCHAR *)ucMasterRcvBufTmp, ucMasterRcvBufTmpIdx);
         }
         ESP_LOGD(TAG, "Received data: %d(bytes in buffer)\n", (uint32_t)usCnt);
     }
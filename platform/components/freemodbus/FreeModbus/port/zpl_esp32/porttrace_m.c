@@ -0,0 +1,269 @@
+/*
+ * (C) Copyright 2022
+ * Zimplistic Private Limited
+ */
+
+/* ----------------------- System includes ----------------------------------*/
+#include "stdlib.h"
+#include "stddef.h"
+#include "string.h"
+
+/* ----------------------- Platform includes --------------------------------*/
+#include "port.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "common_hdr.h"
+
+/* ----------------------- Modbus includes ----------------------------------*/
+#include "mbconfig.h"
+#include "mbframe.h"
+#include "mbtrace.h"
+
+#if MB_MASTER_TRACE_ENABLED > 0
+/* ----------------------- Defines ------------------------------------------*/
+#define MB_TRACE_NUM_RECORDS    ( CONFIG_FMB_TRACE_NUM_RECORDS )
+#define MB_TRACE_SNAP_LEN       ( CONFIG_FMB_TRACE_SNAP_LEN )
+
+/* pcap file format, see https://wiki.wireshark.org/Development/LibpcapFileFormat */
+#define MB_TRACE_PCAP_MAGIC     ( 0xA1B2C3D4UL )    /* Microsecond resolution timestamps */
+#define MB_TRACE_PCAP_VER_MAJOR ( 2 )
+#define MB_TRACE_PCAP_VER_MINOR ( 4 )
+#define MB_TRACE_PCAP_LINKTYPE  ( 147 )             /* LINKTYPE_USER0 */
+
+/* Each packet in the pcap file starts with this pseudo header:
+ * byte 0: direction (eMBTraceDir), byte 1: status (eMBTraceStatus),
+ * byte 2: slave address, byte 3: function code. */
+#define MB_TRACE_PSEUDO_HDR_LEN ( 4 )
+
+/* ----------------------- Type definitions ---------------------------------*/
+typedef struct
+{
+    int64_t         llTimestamp;                    /*!< Microseconds since boot. */
+    UCHAR           ucDir;                          /*!< eMBTraceDir */
+    UCHAR           ucStatus;                       /*!< eMBTraceStatus */
+    UCHAR           ucAddress;                      /*!< Slave address */
+    UCHAR           ucFunctionCode;                 /*!< Function code */
+    USHORT          usOrigLength;                   /*!< Length of the frame on the bus */
+    USHORT          usCapLength;                    /*!< Number of bytes stored in ucData */
+    UCHAR           ucData[MB_TRACE_SNAP_LEN];      /*!< Frame data */
+} xMBTraceRecord;
+
+typedef struct
+{
+    uint32_t        ulMagic;
+    uint16_t        usVersionMajor;
+    uint16_t        usVersionMinor;
+    int32_t         lThisZone;
+    uint32_t        ulSigFigs;
+    uint32_t        ulSnapLen;
+    uint32_t        ulLinkType;
+} xMBTracePcapHdr;
+
+typedef struct
+{
+    uint32_t        ulTsSec;
+    uint32_t        ulTsUsec;
+    uint32_t        ulInclLen;
+    uint32_t        ulOrigLen;
+    UCHAR           ucPseudoHdr[MB_TRACE_PSEUDO_HDR_LEN];
+} xMBTracePcapRecHdr;
+
+/* ----------------------- Static variables ---------------------------------*/
+static const CHAR *TAG = "MB_MASTER_TRACE";
+
+static portMUX_TYPE     xTraceLock = portMUX_INITIALIZER_UNLOCKED;
+static xMBTraceRecord   *pxTraceRing = NULL;
+static volatile ULONG   ulTraceHead = 0;    /* Total number of records written since last clear */
+
+/* ----------------------- Static functions ---------------------------------*/
+static void
+vMBMasterTraceWrite( const xMBTraceRecord * pxHdr, const UCHAR * pucData )
+{
+    xMBTraceRecord *pxRecord;
+
+    if( pxTraceRing == NULL )
+    {
+        return;
+    }
+
+    portENTER_CRITICAL( &xTraceLock );
+    pxRecord = &pxTraceRing[ulTraceHead % MB_TRACE_NUM_RECORDS];
+    ulTraceHead++;
+    memcpy( pxRecord, pxHdr, offsetof( xMBTraceRecord, ucData ) );
+    if( pxHdr->usCapLength > 0 )
+    {
+        memcpy( pxRecord->ucData, pucData, pxHdr->usCapLength );
+    }
+    portEXIT_CRITICAL( &xTraceLock );
+}
+
+/* ----------------------- Start implementation -----------------------------*/
+BOOL
+xMBMasterTraceInit( void )
+{
+    if( pxTraceRing == NULL )
+    {
+        pxTraceRing = heap_caps_malloc( MB_TRACE_NUM_RECORDS * sizeof( xMBTraceRecord ), MALLOC_CAP_SPIRAM );
+        if( pxTraceRing == NULL )
+        {
+            ESP_LOGW( TAG, "Failed to allocate trace ring (%d records), bus trace is disabled", MB_TRACE_NUM_RECORDS );
+            return FALSE;
+        }
+        ulTraceHead = 0;
+        ESP_LOGI( TAG, "Bus trace ring of %d records allocated in PSRAM", MB_TRACE_NUM_RECORDS );
+    }
+    return TRUE;
+}
+
+void
+vMBMasterTraceFrame( eMBTraceDir eDir, eMBTraceStatus eStatus, const UCHAR * pucFrame, USHORT usLength )
+{
+    xMBTraceRecord xHdr;
+
+    xHdr.llTimestamp = esp_timer_get_time( );
+    xHdr.ucDir = ( UCHAR )eDir;
+    xHdr.ucStatus = ( UCHAR )eStatus;
+    xHdr.ucAddress = ( usLength > MB_SER_PDU_ADDR_OFF ) ? pucFrame[MB_SER_PDU_ADDR_OFF] : 0;
+    xHdr.ucFunctionCode = ( usLength > MB_SER_PDU_PDU_OFF ) ? pucFrame[MB_SER_PDU_PDU_OFF] : 0;
+    xHdr.usOrigLength = usLength;
+    xHdr.usCapLength = ( usLength > MB_TRACE_SNAP_LEN ) ? MB_TRACE_SNAP_LEN : usLength;
+    vMBMasterTraceWrite( &xHdr, pucFrame );
+}
+
+void
+vMBMasterTraceEvent( eMBTraceStatus eStatus, UCHAR ucSlaveAddress, UCHAR ucFunctionCode )
+{
+    xMBTraceRecord xHdr;
+
+    xHdr.llTimestamp = esp_timer_get_time( );
+    xHdr.ucDir = ( UCHAR )MB_TRACE_DIR_EVT;
+    xHdr.ucStatus = ( UCHAR )eStatus;
+    xHdr.ucAddress = ucSlaveAddress;
+    xHdr.ucFunctionCode = ucFunctionCode;
+    xHdr.usOrigLength = 0;
+    xHdr.usCapLength = 0;
+    vMBMasterTraceWrite( &xHdr, NULL );
+}
+
+void
+vMBMasterTraceClear( void )
+{
+    portENTER_CRITICAL( &xTraceLock );
+    ulTraceHead = 0;
+    portEXIT_CRITICAL( &xTraceLock );
+}
+
+BOOL
+xMBMasterTraceExport( const CHAR * pcPath, ULONG * pulNumRecords )
+{
+    lfs2_file_t         xFile;
+    xMBTraceRecord      *pxRecord;
+    xMBTracePcapHdr     xPcapHdr;
+    xMBTracePcapRecHdr  xRecHdr;
+    ULONG               ulIdx;
+    ULONG               ulHead;
+    ULONG               ulCount = 0;
+    BOOL                xResult = TRUE;
+
+    if( pulNumRecords != NULL )
+    {
+        *pulNumRecords = 0;
+    }
+    if( ( pxTraceRing == NULL ) || ( g_px_lfs2 == NULL ) )
+    {
+        return FALSE;
+    }
+
+    /* A record is copied out of the ring under the lock, so it can't be torn by the recording tasks */
+    pxRecord = malloc( sizeof( xMBTraceRecord ) );
+    if( pxRecord == NULL )
+    {
+        ESP_LOGE( TAG, "Failed to allocate buffer for exporting trace" );
+        return FALSE;
+    }
+
+    if( lfs2_file_open( g_px_lfs2, &xFile, pcPath, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC ) < 0 )
+    {
+        ESP_LOGE( TAG, "Failed to open file %s for writing", pcPath );
+        free( pxRecord );
+        return FALSE;
+    }
+
+    xPcapHdr.ulMagic = MB_TRACE_PCAP_MAGIC;
+    xPcapHdr.usVersionMajor = MB_TRACE_PCAP_VER_MAJOR;
+    xPcapHdr.usVersionMinor = MB_TRACE_PCAP_VER_MINOR;
+    xPcapHdr.lThisZone = 0;
+    xPcapHdr.ulSigFigs = 0;
+    xPcapHdr.ulSnapLen = MB_TRACE_PSEUDO_HDR_LEN + MB_TRACE_SNAP_LEN;
+    xPcapHdr.ulLinkType = MB_TRACE_PCAP_LINKTYPE;
+    if( lfs2_file_write( g_px_lfs2, &xFile, &xPcapHdr, sizeof( xPcapHdr ) ) != ( lfs2_ssize_t )sizeof( xPcapHdr ) )
+    {
+        xResult = FALSE;
+    }
+
+    /* Start from the oldest record still in the ring */
+    portENTER_CRITICAL( &xTraceLock );
+    ulHead = ulTraceHead;
+    portEXIT_CRITICAL( &xTraceLock );
+    ulIdx = ( ulHead > MB_TRACE_NUM_RECORDS ) ? ( ulHead - MB_TRACE_NUM_RECORDS ) : 0;
+
+    while( xResult && ( ulIdx < ulHead ) )
+    {
+        portENTER_CRITICAL( &xTraceLock );
+        if( ulIdx >= ulTraceHead )
+        {
+            /* The ring has been cleared since the export started */
+            portEXIT_CRITICAL( &xTraceLock );
+            break;
+        }
+        /* Skip records which have been overwritten since the export started */
+        if( ulTraceHead - ulIdx > MB_TRACE_NUM_RECORDS )
+        {
+            ulIdx = ulTraceHead - MB_TRACE_NUM_RECORDS;
+        }
+        memcpy( pxRecord, &pxTraceRing[ulIdx % MB_TRACE_NUM_RECORDS], sizeof( xMBTraceRecord ) );
+        portEXIT_CRITICAL( &xTraceLock );
+        ulIdx++;
+
+        xRecHdr.ulTsSec = ( uint32_t )( pxRecord->llTimestamp / 1000000 );
+        xRecHdr.ulTsUsec = ( uint32_t )( pxRecord->llTimestamp % 1000000 );
+        xRecHdr.ulInclLen = MB_TRACE_PSEUDO_HDR_LEN + pxRecord->usCapLength;
+        xRecHdr.ulOrigLen = MB_TRACE_PSEUDO_HDR_LEN + pxRecord->usOrigLength;
+        xRecHdr.ucPseudoHdr[0] = pxRecord->ucDir;
+        xRecHdr.ucPseudoHdr[1] = pxRecord->ucStatus;
+        xRecHdr.ucPseudoHdr[2] = pxRecord->ucAddress;
+        xRecHdr.ucPseudoHdr[3] = pxRecord->ucFunctionCode;
+
+        if( ( lfs2_file_write( g_px_lfs2, &xFile, &xRecHdr, sizeof( xRecHdr ) ) != ( lfs2_ssize_t )sizeof( xRecHdr ) ) ||
+            ( lfs2_file_write( g_px_lfs2, &xFile, pxRecord->ucData, pxRecord->usCapLength ) != pxRecord->usCapLength ) )
+        {
+            xResult = FALSE;
+            break;
+        }
+        ulCount++;
+    }
+
+    if( lfs2_file_close( g_px_lfs2, &xFile ) < 0 )
+    {
+        xResult = FALSE;
+    }
+    free( pxRecord );
+
+    if( !xResult )
+    {
+        ESP_LOGE( TAG, "Failed to write trace to file %s", pcPath );
+        lfs2_remove( g_px_lfs2, pcPath );
+        return FALSE;
+    }
+
+    ESP_LOGI( TAG, "%lu trace records exported to %s", ulCount, pcPath );
+    if( pulNumRecords != NULL )
+    {
+        *pulNumRecords = ulCount;
+    }
+    return TRUE;
+}
+
+#endif /* #if MB_MASTER_TRACE_ENABLED > 0 */
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+#
+# (C) Copyright 2022
+# Zimplistic Private Limited
+#
+# Decoder of Modbus master bus trace exported by xMBMasterTraceExport().
+#
+# The trace is a pcap file with link type LINKTYPE_USER0 (147). Every packet starts with a 4-byte pseudo header
+# (direction, status, slave address, function code) followed by the serial frame (address, PDU, CRC) as seen on
+# the bus. Timestamps are microseconds since boot of the master.
+#
+# Usage:
+#     python mb_trace_decode.py mbtrace.pcap [--errors] [--csv]
+#
+
+import argparse
+import struct
+import sys
+
+LINKTYPE_USER0 = 147
+PSEUDO_HDR_LEN = 4
+
+DIRECTIONS = {0: 'TX', 1: 'RX', 2: 'EVT'}
+
+STATUSES = {
+    0: 'ok',
+    1: 'bad frame',
+    2: 'discarded',
+    3: 'receive error',
+    4: 'respond timeout',
+    5: 'exception',
+}
+
+
+def read_records(path):
+    """Yields (timestamp_us, direction, status, address, function, orig_len, frame) of each record"""
+    with open(path, 'rb') as f:
+        global_hdr = f.read(24)
+        if len(global_hdr) < 24:
+            raise ValueError('File is too short to be a pcap file')
+
+        magic = struct.unpack('<I', global_hdr[:4])[0]
+        if magic == 0xA1B2C3D4:
+            endian = '<'
+        elif magic == 0xD4C3B2A1:
+            endian = '>'
+        else:
+            raise ValueError('Invalid pcap magic 0x%08X' % magic)
+
+        _, _, _, _, _, linktype = struct.unpack(endian + 'HHiIII', global_hdr[4:])
+        if linktype != LINKTYPE_USER0:
+            raise ValueError('Unexpected link type %d' % linktype)
+
+        while True:
+            rec_hdr = f.read(16)
+            if len(rec_hdr) < 16:
+                break
+            ts_sec, ts_usec, incl_len, orig_len = struct.unpack(endian + 'IIII', rec_hdr)
+            data = f.read(incl_len)
+            if len(data) < incl_len or incl_len < PSEUDO_HDR_LEN:
+                break
+            direction, status, address, function = data[:PSEUDO_HDR_LEN]
+            yield (ts_sec * 1000000 + ts_usec, direction, status, address, function,
+                   orig_len - PSEUDO_HDR_LEN, data[PSEUDO_HDR_LEN:])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode Modbus master bus trace')
+    parser.add_argument('file', help='pcap file exported from the device')
+    parser.add_argument('--errors', action='store_true', help='only show records with error status')
+    parser.add_argument('--csv', action='store_true', help='print records as CSV')
+    args = parser.parse_args()
+
+    if args.csv:
+        print('timestamp_us,delta_us,latency_us,direction,status,address,function,length,data')
+
+    prev_ts = None
+    last_tx_ts = None
+    num_records = 0
+    num_errors = 0
+    latencies = []
+
+    try:
+        for ts, direction, status, address, function, length, frame in read_records(args.file):
+            num_records += 1
+            delta = 0 if prev_ts is None else ts - prev_ts
+            prev_ts = ts
+
+            # Latency from the request to its response or error event
+            latency = None
+            if direction == 0:
+                last_tx_ts = ts
+            elif last_tx_ts is not None:
+                latency = ts - last_tx_ts
+                if direction == 1 and status == 0:
+                    latencies.append(latency)
+                last_tx_ts = None
+
+            if status != 0:
+                num_errors += 1
+            elif args.errors:
+                continue
+
+            dir_str = DIRECTIONS.get(direction, '?%d' % direction)
+            status_str = STATUSES.get(status, '?%d' % status)
+            data_str = frame.hex(' ')
+            if len(frame) < length:
+                data_str += ' ...'
+
+            if args.csv:
+                print('%d,%d,%s,%s,%s,%d,0x%02X,%d,%s' % (ts, delta, '' if latency is None else latency, dir_str,
+                                                         status_str, address, function, length, frame.hex()))
+            else:
+                print('%12.6f  +%9dus  %-3s  addr=%-3d func=0x%02X  len=%-4d %-15s %s%s' %
+                      (ts / 1e6, delta, dir_str, address, function, length, status_str,
+                       '' if latency is None else '(%dus) ' % latency, data_str))
+    except (OSError, ValueError) as e:
+        print('Error: %s' % e, file=sys.stderr)
+        return 1
+
+    if not args.csv:
+        print()
+        print('%d records, %d errors' % (num_records, num_errors))
+        if latencies:
+            latencies.sort()
+            print('Response latency: min %dus, median %dus, max %dus' %
+                  (latencies[0], latencies[len(latencies) // 2], latencies[-1]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
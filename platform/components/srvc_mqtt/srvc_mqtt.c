@@ -24,7 +24,10 @@
 
 #include "srvc_mqtt.h"          /* Public header of this module */
 #include "mqtt_client.h"        /* Use ESP-IDF's MQTT component */
+#include "freertos/task.h"      /* Use FreeRTOS task */
+#include "freertos/semphr.h"    /* Use FreeRTOS semaphore and mutex */
 #include <string.h>             /* Use strlen() */
+#include <stdlib.h>             /* Use malloc() */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -32,6 +35,18 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/** @brief  Byte budget of the posted data not published yet, as a multiple of the transmit buffer size of a client */
+#define MQTT_POST_BUDGET_FACTOR     4
+
+/** @brief  ID of the CPU that the task publishing posted data runs on */
+#define MQTT_POST_TASK_CPU_ID       1
+
+/** @brief  Stack size (in bytes) of the task publishing posted data */
+#define MQTT_POST_TASK_STACK_SIZE   4096
+
+/** @brief  Priority of the task publishing posted data, higher than the tasks posting the data */
+#define MQTT_POST_TASK_PRIORITY     (tskIDLE_PRIORITY + 1)
+
 /** @brief  Structure wrapping properties of a publish topic */
 typedef struct
 {
@@ -66,6 +81,18 @@ typedef struct
     .pstri_topic                = TOPIC,                                        \
 },
 
+/** @brief  Data posted with enm_MQTT_Post() and waiting to be published */
+typedef struct MQTT_post
+{
+    struct MQTT_post *          pstru_next;         //!< Next posted data of the same priority
+    uint32_t                    u32_topic_id;       //!< Index of the topic in publish topic table
+    uint32_t                    u32_key;            //!< Coalescing key, 0 if the data is never replaced
+    uint32_t                    u32_len;            //!< Length in bytes of the data
+    uint32_t                    u32_size;           //!< Size in bytes of this structure, counted in the byte budget
+    const char *                pstri_topic;        //!< Topic at the time of posting, stored right after the data
+    uint8_t                     au8_data[];         //!< The data to publish
+} MQTT_post_t;
+
 /** @brief  Structure wrapping data of an MQTT client object */
 struct MQTT_obj
 {
@@ -85,6 +112,9 @@ struct MQTT_obj
 
     uint8_t                     u8_num_sub_topics;  //!< Number of subcribe topics
     MQTT_sub_topic_t *          pstru_sub_topics;   //!< Pointer to array of subcribe topics
+
+    MQTT_post_t *               apstru_posts[MQTT_NUM_PRIOS];   //!< Queues of posted data, one for each priority
+    uint32_t                    u32_post_bytes;     //!< Number of bytes of the posted data in the queues
 };
 
 /** @brief  Macro expanding MQTT_INST_TABLE as initialization values for MQTT_obj struct */
@@ -147,6 +177,18 @@ MQTT_INST_TABLE (INST_TABLE_EXPAND_AS_PUB_TOPIC_ARRAY_DECLARE)
     static MQTT_sub_topic_t g_astru_sub_topic_##INST_ID [] = { SUB_TOPICS (SUB_TOPIC_TABLE_EXPAND_AS_STRUCT_INIT) };
 MQTT_INST_TABLE (INST_TABLE_EXPAND_AS_SUB_TOPIC_ARRAY_DECLARE)
 
+/** @brief  Mutex protecting the queues of posted data */
+static SemaphoreHandle_t g_x_post_mutex = NULL;
+
+/** @brief  Semaphore signaling the task publishing posted data */
+static SemaphoreHandle_t g_x_post_sem = NULL;
+
+/** @brief  Structure that will hold the TCB of the task publishing posted data */
+static StaticTask_t g_x_post_task_buffer;
+
+/** @brief  Buffer that the task publishing posted data will use as its stack */
+static StackType_t g_x_post_task_stack [MQTT_POST_TASK_STACK_SIZE];
+
 /** @brief  Array of all MQTT client objects */
 static struct MQTT_obj g_astru_mqtt_objs[MQTT_NUM_INST] =
 {
@@ -162,6 +204,8 @@ static struct MQTT_obj g_astru_mqtt_objs[MQTT_NUM_INST] =
 static int32_t s32_MQTT_Init_Module (void);
 static int32_t s32_MQTT_Init_Inst (MQTT_inst_t x_inst);
 static void v_MQTT_Evt_Handler (void * pv_arg, esp_event_base_t x_evt_base, int32_t s32_evt_id, void * pv_evt_data);
+static void v_MQTT_Post_Task (void * pv_param);
+static MQTT_post_t * pstru_MQTT_Pop_Post (MQTT_inst_t x_inst);
 
 #ifdef USE_MODULE_ASSERT
  static bool b_MQTT_Is_Valid_Inst (MQTT_inst_t x_inst);
@@ -254,6 +298,74 @@ void v_MQTT_Get_Config (MQTT_inst_t x_inst, MQTT_config_t * pstru_config)
     pstru_config->u32_lwt_topic_id  = x_inst->u32_lwt_topic_id;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets size in bytes of the transmit buffer of an MQTT client (Transmit buffer size in MQTT_INST_TABLE)
+**
+** @param [in]
+**      x_inst: Instance of the MQTT client returned by x_MQTT_Get_Inst()
+**
+** @return
+**      Size in bytes of the transmit buffer
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Tx_Buffer_Size (MQTT_inst_t x_inst)
+{
+    ASSERT_PARAM (b_MQTT_Is_Valid_Inst (x_inst));
+
+    return (uint32_t)x_inst->stru_mqtt_cfg.out_buffer_size;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of bytes of the data waiting in the outbox of an MQTT client
+**
+** @details
+**      The outbox holds the data queued with enm_MQTT_Enqueue() and the data of QoS 1 or 2 that has not been
+**      acknowledged by the broker yet
+**
+** @param [in]
+**      x_inst: Instance of the MQTT client returned by x_MQTT_Get_Inst()
+**
+** @return
+**      Number of bytes in the outbox
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Outbox_Size (MQTT_inst_t x_inst)
+{
+    ASSERT_PARAM (b_MQTT_Is_Valid_Inst (x_inst));
+
+    int s32_size = esp_mqtt_client_get_outbox_size (x_inst->x_mqtt_inst);
+    return (s32_size > 0) ? (uint32_t)s32_size : 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets number of bytes of the data posted to an MQTT client with enm_MQTT_Post() and not published yet
+**
+** @param [in]
+**      x_inst: Instance of the MQTT client returned by x_MQTT_Get_Inst()
+**
+** @return
+**      Number of bytes in the queues of posted data, counted against the byte budget of the client
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+uint32_t u32_MQTT_Get_Posted_Size (MQTT_inst_t x_inst)
+{
+    ASSERT_PARAM (b_MQTT_Is_Valid_Inst (x_inst));
+
+    return x_inst->u32_post_bytes;
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -523,6 +635,210 @@ MQTT_status_t enm_MQTT_Publish (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, c
     return MQTT_OK;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Queues data to publish to a topic without blocking
+**
+** @details
+**      The data is copied into the outbox of the MQTT client and sent by the task of the client. If the topic has QoS
+**      1 or 2, MQTT_EVT_PUBLISHED is fired with the returned message ID once the broker acknowledges the data.
+**
+** @param [in]
+**      x_inst: Instance of the MQTT client returned by x_MQTT_Get_Inst()
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic inside publish topic table of the client
+**
+** @param [in]
+**      pv_data: The data to publish
+**
+** @param [in]
+**      u32_len: Length in bytes of pv_data
+**
+** @param [out]
+**      ps32_msg_id: Message ID of the data, 0 if the topic has QoS 0 (no acknowledgement). NULL if not needed.
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Enqueue (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id,
+                                const void * pv_data, uint32_t u32_len, int32_t * ps32_msg_id)
+{
+    /* Validation */
+    ASSERT_PARAM (b_MQTT_Is_Valid_Inst (x_inst));
+    ASSERT_PARAM (pv_data != NULL);
+    ASSERT_PARAM (u32_pub_topic_id < x_inst->u8_num_pub_topics);
+
+    /* Store the data in the outbox of the client */
+    int32_t s32_msg_id = esp_mqtt_client_enqueue (x_inst->x_mqtt_inst,
+                                                  x_inst->pstru_pub_topics[u32_pub_topic_id].pstri_topic,
+                                                  pv_data, u32_len,
+                                                  x_inst->pstru_pub_topics[u32_pub_topic_id].u8_qos,
+                                                  x_inst->pstru_pub_topics[u32_pub_topic_id].b_retained,
+                                                  true);
+    if (s32_msg_id < 0)
+    {
+        LOGE ("Failed to queue data of topic ID %d", u32_pub_topic_id);
+        return MQTT_ERR;
+    }
+
+    if (ps32_msg_id != NULL)
+    {
+        *ps32_msg_id = s32_msg_id;
+    }
+    return MQTT_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Posts data to publish to a topic in order of priority, data of the same key could be replaced by newer one
+**
+** @details
+**      The data and the current topic are copied into a queue and published by the task of this module, so the caller
+**      is never blocked by the network. The data of the highest priority is published first, data of the same
+**      priority are published in the order they are posted. While the client is disconnected, the data is kept in the
+**      queue.
+**      If the data has a non-zero key, it replaces the data of the same topic, priority and key that has not been
+**      published yet, so that only the latest value (such as progress of an operation) is sent.
+**      The data in the queues of a client is limited to MQTT_POST_BUDGET_FACTOR times its transmit buffer size. When
+**      the budget is exceeded, the oldest data of lower priorities is discarded to make room for the new data. If
+**      the new data does not fit even so, it is rejected and no data is discarded.
+**
+** @param [in]
+**      x_inst: Instance of the MQTT client returned by x_MQTT_Get_Inst()
+**
+** @param [in]
+**      u32_pub_topic_id: Index of the topic inside publish topic table of the client
+**
+** @param [in]
+**      enm_prio: Priority of the data
+**
+** @param [in]
+**      u32_key: Coalescing key of the data, 0 if the data must not be replaced
+**
+** @param [in]
+**      pv_data: The data to publish
+**
+** @param [in]
+**      u32_len: Length in bytes of pv_data. If u32_len is zero, length of pv_data will be determined using strlen()
+**
+** @return
+**      @arg    MQTT_OK
+**      @arg    MQTT_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+MQTT_status_t enm_MQTT_Post (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, MQTT_priority_t enm_prio,
+                             uint32_t u32_key, const void * pv_data, uint32_t u32_len)
+{
+    /* Validation */
+    ASSERT_PARAM (b_MQTT_Is_Valid_Inst (x_inst));
+    ASSERT_PARAM (pv_data != NULL);
+    ASSERT_PARAM (u32_pub_topic_id < x_inst->u8_num_pub_topics);
+    ASSERT_PARAM (enm_prio < MQTT_NUM_PRIOS);
+
+    /* Copy the data and the topic */
+    const char * pstri_topic = x_inst->pstru_pub_topics[u32_pub_topic_id].pstri_topic;
+    uint32_t u32_topic_len = strlen (pstri_topic) + 1;
+    uint32_t u32_budget = (uint32_t)x_inst->stru_mqtt_cfg.out_buffer_size * MQTT_POST_BUDGET_FACTOR;
+    if (u32_len == 0)
+    {
+        u32_len = strlen (pv_data);
+    }
+    uint32_t u32_size = sizeof (MQTT_post_t) + u32_len + u32_topic_len;
+    if (u32_size > u32_budget)
+    {
+        LOGE ("Data of topic ID %d is too long (%d bytes)", u32_pub_topic_id, u32_len);
+        return MQTT_ERR;
+    }
+    MQTT_post_t * pstru_post = malloc (u32_size);
+    if (pstru_post == NULL)
+    {
+        LOGE ("Failed to allocate memory (%d bytes) for data of topic ID %d", u32_size, u32_pub_topic_id);
+        return MQTT_ERR;
+    }
+    pstru_post->pstru_next = NULL;
+    pstru_post->u32_topic_id = u32_pub_topic_id;
+    pstru_post->u32_key = u32_key;
+    pstru_post->u32_len = u32_len;
+    pstru_post->u32_size = u32_size;
+    pstru_post->pstri_topic = (const char *)&pstru_post->au8_data[u32_len];
+    memcpy (pstru_post->au8_data, pv_data, u32_len);
+    memcpy (&pstru_post->au8_data[u32_len], pstri_topic, u32_topic_len);
+
+    xSemaphoreTake (g_x_post_mutex, portMAX_DELAY);
+
+    /* Find the position of the data in its queue, which is the data it replaces or the end of the queue */
+    MQTT_post_t ** ppstru_pos = &x_inst->apstru_posts[enm_prio];
+    while ((*ppstru_pos != NULL) &&
+           ((u32_key == 0) || ((*ppstru_pos)->u32_key != u32_key) || ((*ppstru_pos)->u32_topic_id != u32_pub_topic_id)))
+    {
+        ppstru_pos = &(*ppstru_pos)->pstru_next;
+    }
+    MQTT_post_t * pstru_replaced = *ppstru_pos;
+    uint32_t u32_bytes = x_inst->u32_post_bytes + u32_size - ((pstru_replaced != NULL) ? pstru_replaced->u32_size : 0);
+
+    /* Nothing is discarded if the new data does not fit in the budget even without all data of lower priorities */
+    bool b_queued = (u32_bytes <= u32_budget);
+    if (!b_queued)
+    {
+        uint32_t u32_discardable = 0;
+        for (uint8_t u8_prio = enm_prio + 1; u8_prio < MQTT_NUM_PRIOS; u8_prio++)
+        {
+            for (MQTT_post_t * pstru_lower = x_inst->apstru_posts[u8_prio]; pstru_lower != NULL;
+                 pstru_lower = pstru_lower->pstru_next)
+            {
+                u32_discardable += pstru_lower->u32_size;
+            }
+        }
+        b_queued = (u32_bytes <= u32_budget + u32_discardable);
+    }
+
+    if (b_queued)
+    {
+        /* Discard the oldest data of lower priorities until the new data fits in the budget */
+        for (uint8_t u8_prio = MQTT_NUM_PRIOS - 1; (u8_prio > enm_prio) && (u32_bytes > u32_budget); )
+        {
+            MQTT_post_t * pstru_discarded = x_inst->apstru_posts[u8_prio];
+            if (pstru_discarded == NULL)
+            {
+                u8_prio--;
+                continue;
+            }
+            LOGW ("Discard data of topic ID %d with priority %d", pstru_discarded->u32_topic_id, u8_prio);
+            x_inst->apstru_posts[u8_prio] = pstru_discarded->pstru_next;
+            u32_bytes -= pstru_discarded->u32_size;
+            free (pstru_discarded);
+        }
+
+        /* Put the data into its queue */
+        pstru_post->pstru_next = (pstru_replaced != NULL) ? pstru_replaced->pstru_next : NULL;
+        *ppstru_pos = pstru_post;
+        x_inst->u32_post_bytes = u32_bytes;
+        free (pstru_replaced);
+    }
+
+    xSemaphoreGive (g_x_post_mutex);
+
+    if (!b_queued)
+    {
+        LOGE ("No room for data of topic ID %d with priority %d", u32_pub_topic_id, enm_prio);
+        free (pstru_post);
+        return MQTT_ERR;
+    }
+
+    /* Wake up the task publishing the data */
+    xSemaphoreGive (g_x_post_sem);
+    return MQTT_OK;
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -537,7 +853,25 @@ MQTT_status_t enm_MQTT_Publish (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, c
 */
 static int32_t s32_MQTT_Init_Module (void)
 {
-    /* Do nothing */
+    /* Create resources of the queues of posted data */
+    g_x_post_mutex = xSemaphoreCreateMutex ();
+    g_x_post_sem = xSemaphoreCreateBinary ();
+    if ((g_x_post_mutex == NULL) || (g_x_post_sem == NULL))
+    {
+        LOGE ("Failed to create resources of posted data");
+        return STATUS_ERR;
+    }
+
+    /* Create task publishing the posted data */
+    xTaskCreateStaticPinnedToCore ( v_MQTT_Post_Task,           /* Function that implements the task */
+                                    "Srvc_Mqtt",                /* Text name for the task */
+                                    MQTT_POST_TASK_STACK_SIZE,  /* Stack size in bytes, not words */
+                                    NULL,                       /* Parameter passed into the task */
+                                    MQTT_POST_TASK_PRIORITY,    /* Priority at which the task is created */
+                                    g_x_post_task_stack,        /* Array to use as the task's stack */
+                                    &g_x_post_task_buffer,      /* Variable to hold the task's data structure */
+                                    MQTT_POST_TASK_CPU_ID);     /* ID of the CPU that the task runs on */
+
     return STATUS_OK;
 }
 
@@ -653,6 +987,9 @@ static void v_MQTT_Evt_Handler (void * pv_arg, esp_event_base_t x_evt_base, int3
             {
                 LOGI ("Client %d has been connected with MQTT broker", x_inst->enm_inst_id);
                 x_inst->b_connected = true;
+
+                /* Publish the data posted while the client was disconnected */
+                xSemaphoreGive (g_x_post_sem);
                 if (x_inst->pfnc_cb)
                 {
                     MQTT_evt_data_t stru_evt_data =
@@ -725,6 +1062,30 @@ static void v_MQTT_Evt_Handler (void * pv_arg, esp_event_base_t x_evt_base, int3
             break;
         }
 
+        /* The broker acknowledged a published data of QoS 1 or 2 */
+        case MQTT_EVENT_PUBLISHED:
+        {
+            LOGD ("Event MQTT_EVENT_PUBLISHED (msg_id = %d) on client %d", stru_mqtt_event->msg_id,
+                  x_inst->enm_inst_id);
+
+            /* Invoke callback */
+            if (x_inst->pfnc_cb)
+            {
+                MQTT_evt_data_t stru_evt_data =
+                {
+                    .x_inst             = x_inst,
+                    .pv_arg             = x_inst->pv_cb_arg,
+                    .enm_evt            = MQTT_EVT_PUBLISHED,
+                    .stru_publish       =
+                    {
+                        .s32_msg_id     = stru_mqtt_event->msg_id,
+                    },
+                };
+                x_inst->pfnc_cb (&stru_evt_data);
+            }
+            break;
+        }
+
         /* Error occurs */
         case MQTT_EVENT_ERROR:
         {
@@ -741,6 +1102,78 @@ static void v_MQTT_Evt_Handler (void * pv_arg, esp_event_base_t x_evt_base, int3
     }
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Task publishing the data posted with enm_MQTT_Post() to the clients connected with the broker
+**
+** @param [in]
+**      pv_param: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_MQTT_Post_Task (void * pv_param)
+{
+    MQTT_post_t * pstru_post;
+
+    while (true)
+    {
+        xSemaphoreTake (g_x_post_sem, portMAX_DELAY);
+
+        /* The queues are checked again after each publish so that data of higher priority posted meanwhile goes next */
+        for (uint32_t u32_idx = 0; u32_idx < (uint32_t)MQTT_NUM_INST; u32_idx++)
+        {
+            MQTT_inst_t x_inst = &g_astru_mqtt_objs[u32_idx];
+            while (x_inst->b_connected && ((pstru_post = pstru_MQTT_Pop_Post (x_inst)) != NULL))
+            {
+                if (esp_mqtt_client_publish (x_inst->x_mqtt_inst, pstru_post->pstri_topic,
+                                             (const char *)pstru_post->au8_data, pstru_post->u32_len,
+                                             x_inst->pstru_pub_topics[pstru_post->u32_topic_id].u8_qos,
+                                             x_inst->pstru_pub_topics[pstru_post->u32_topic_id].b_retained) < 0)
+                {
+                    LOGE ("Failed to publish topic ID %d", pstru_post->u32_topic_id);
+                }
+                free (pstru_post);
+            }
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Removes the posted data of highest priority from the queues of an MQTT client
+**
+** @param [in]
+**      x_inst: A specific MQTT client
+**
+** @return
+**      @arg    NULL: There is no posted data
+**      @arg    Otherwise: The posted data, which must be freed by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static MQTT_post_t * pstru_MQTT_Pop_Post (MQTT_inst_t x_inst)
+{
+    MQTT_post_t * pstru_post = NULL;
+
+    xSemaphoreTake (g_x_post_mutex, portMAX_DELAY);
+    for (uint8_t u8_prio = 0; (u8_prio < MQTT_NUM_PRIOS) && (pstru_post == NULL); u8_prio++)
+    {
+        pstru_post = x_inst->apstru_posts[u8_prio];
+        if (pstru_post != NULL)
+        {
+            x_inst->apstru_posts[u8_prio] = pstru_post->pstru_next;
+            x_inst->u32_post_bytes -= pstru_post->u32_size;
+        }
+    }
+    xSemaphoreGive (g_x_post_mutex);
+
+    return pstru_post;
+}
+
 #ifdef USE_MODULE_ASSERT
 
 /**
@@ -66,6 +66,16 @@ typedef enum
     };
 MQTT_INST_TABLE (MQTT_INST_TABLE_EXPAND_AS_ALL_TOPIC_IDS)
 
+/** @brief  Priority classes of the data posted with enm_MQTT_Post(), the highest priority is sent first */
+typedef enum
+{
+    MQTT_PRIO_RESPONSE      = 0,        //!< Responses to the commands of other nodes
+    MQTT_PRIO_STATUS,                   //!< Status and result of operations
+    MQTT_PRIO_PROGRESS,                 //!< Progress of long operations
+    MQTT_PRIO_TELEMETRY,                //!< Periodic measurements
+    MQTT_NUM_PRIOS
+} MQTT_priority_t;
+
 /** @brief  MQTT client configuration */
 typedef struct
 {
@@ -90,6 +100,7 @@ typedef struct
         MQTT_EVT_CONNECTED,             //!< The MQTT client is connected to the broker
         MQTT_EVT_DISCONNECTED,          //!< The MQTT client is disconnected from the broker
         MQTT_EVT_DATA_RECEIVED,         //!< A data is received from a subscribed topic
+        MQTT_EVT_PUBLISHED,             //!< The broker acknowledged a published data of QoS 1 or 2
     } enm_evt;
 
     /**
@@ -108,6 +119,12 @@ typedef struct
         uint32_t        u32_totlen;     //!< Total length in bytes of the whole data
     } stru_receive;
 
+    /** @brief  Context data specific for MQTT_EVT_PUBLISHED */
+    struct
+    {
+        int32_t         s32_msg_id;     //!< Message ID returned by enm_MQTT_Enqueue() when the data was published
+    } stru_publish;
+
 } MQTT_evt_data_t;
 
 /** @brief  Callback invoked when an event occurs */
@@ -125,6 +142,15 @@ extern MQTT_inst_t x_MQTT_Get_Inst (MQTT_inst_id_t enm_inst_id);
 /* Gets current configuration of an MQTT client */
 extern void v_MQTT_Get_Config (MQTT_inst_t x_inst, MQTT_config_t * pstru_config);
 
+/* Gets size in bytes of the transmit buffer of an MQTT client */
+extern uint32_t u32_MQTT_Get_Tx_Buffer_Size (MQTT_inst_t x_inst);
+
+/* Gets number of bytes of the data waiting in the outbox of an MQTT client */
+extern uint32_t u32_MQTT_Get_Outbox_Size (MQTT_inst_t x_inst);
+
+/* Gets number of bytes of the data posted to an MQTT client and not published yet */
+extern uint32_t u32_MQTT_Get_Posted_Size (MQTT_inst_t x_inst);
+
 /* Configures an MQTT client */
 extern MQTT_status_t enm_MQTT_Set_Config (MQTT_inst_t x_inst, MQTT_config_t * pstru_config);
 
@@ -147,6 +173,14 @@ extern MQTT_status_t enm_MQTT_Stop_Inst (MQTT_inst_t x_inst);
 extern MQTT_status_t enm_MQTT_Publish (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id,
                                        const void * pv_data, uint32_t u32_len);
 
+/* Queues data to publish to a topic without blocking */
+extern MQTT_status_t enm_MQTT_Enqueue (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id,
+                                       const void * pv_data, uint32_t u32_len, int32_t * ps32_msg_id);
+
+/* Posts data to publish to a topic in order of priority, data of the same key could be replaced by newer one */
+extern MQTT_status_t enm_MQTT_Post (MQTT_inst_t x_inst, uint32_t u32_pub_topic_id, MQTT_priority_t enm_prio,
+                                    uint32_t u32_key, const void * pv_data, uint32_t u32_len);
+
 #endif /* __SRVC_MQTT_H__ */
 
 /**
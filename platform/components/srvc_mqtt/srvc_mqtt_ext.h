@@ -128,6 +128,9 @@ X( MQTT_S2M_DATA,           1,      false,      "itor3/s2m/<group_id>/<slave_nod
 /* Placeholder of the topic sending broadcast notify messages */                                                       \
 X( MQTT_S2M_NOTIFY,         1,      false,      "itor3/s2m/<group_id>/<slave_node_id>/notify"                         )\
                                                                                                                        \
+/* Placeholder of the topic sending broadcast telemetry messages */                                                    \
+X( MQTT_S2M_TELEMETRY,      0,      false,      "itor3/s2m/<group_id>/<slave_node_id>/telemetry"                      )\
+                                                                                                                       \
 /*-------------------------------------------------------------------------------------------------------------------*/
 
 /**
@@ -24,8 +24,15 @@
 
 #include "srvc_param.h"             /* Public header of this module */
 #include "nvs_flash.h"              /* Use non-volatile storage component from ESP-IDF */
+#include "esp32/rom/crc.h"          /* Use ESP-IDF's CRC API */
 
-#include <string.h>                 /* Use strlen() */
+#include "esp_system.h"             /* Use esp_register_shutdown_handler() */
+
+#include "freertos/FreeRTOS.h"      /* Use FreeRTOS */
+#include "freertos/task.h"          /* Use FreeRTOS task */
+#include "freertos/semphr.h"        /* Use FreeRTOS semaphore */
+
+#include <string.h>                 /* Use strlen(), memcpy(), memcmp() */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -36,6 +43,24 @@
 /** @brief  Namespace of parameter flash */
 #define PARAM_NAME_SPACE            "Params"
 
+/** @brief  ID of the CPU that Srvc_Param task runs on */
+#define PARAM_TASK_CPU_ID           0
+
+/** @brief  Stack size (in bytes) of Srvc_Param task */
+#define PARAM_TASK_STACK_SIZE       3072
+
+/** @brief  Priority of Srvc_Param task */
+#define PARAM_TASK_PRIORITY         (tskIDLE_PRIORITY + 1)
+
+/** @brief  Time in milliseconds without any parameter changes after which deferred changes are committed */
+#define PARAM_COMMIT_QUIESCENCE_MS  1000
+
+/** @brief  Maximum time in milliseconds that a deferred change waits before being committed */
+#define PARAM_COMMIT_MAX_DELAY_MS   5000
+
+/** @brief  Maximum number of subscribers to parameter changes */
+#define PARAM_MAX_NUM_SUBSCRIBERS   8
+
 /** @brief  Base type of a string parameter */
 #define string                      char
 
@@ -54,10 +79,64 @@
 #define ARRAY_SYMBOL_string                 []
 #define ARRAY_SYMBOL_blob                   []
 
+/**
+** @brief   Size in bytes of the RAM cache of a parameter
+** @note    The cache of a string or blob parameter is as large as its maximum length, which must therefore be set in
+**          param table. Size 0 indicates that the maximum length is missing.
+*/
+#define CACHE_SIZE_uint8_t(MAX)             sizeof (uint8_t)
+#define CACHE_SIZE_int8_t(MAX)              sizeof (int8_t)
+#define CACHE_SIZE_uint16_t(MAX)            sizeof (uint16_t)
+#define CACHE_SIZE_int16_t(MAX)             sizeof (int16_t)
+#define CACHE_SIZE_uint32_t(MAX)            sizeof (uint32_t)
+#define CACHE_SIZE_int32_t(MAX)             sizeof (int32_t)
+#define CACHE_SIZE_uint64_t(MAX)            sizeof (uint64_t)
+#define CACHE_SIZE_int64_t(MAX)             sizeof (int64_t)
+#define CACHE_SIZE_string(MAX)              (((MAX) != 0) ? ((MAX) + 1) : 0)
+#define CACHE_SIZE_blob(MAX)                (MAX)
+
+/** @brief  Values of the Snapshot column of param table */
+#define PARAM_SNAPSHOT_YES                  true
+#define PARAM_SNAPSHOT_NO                   false
+
 /** @brief  Macro to expand an entry in param table as constant variable definition of parameter's default value */
-#define PARAM_EXPAND_AS_DEFAULT_VALUE_DEFINITION(PARAM_ID, PUC, TYPE, MIN, MAX, ...)    \
+#define PARAM_EXPAND_AS_DEFAULT_VALUE_DEFINITION(PARAM_ID, PUC, TYPE, MIN, MAX, COMMIT, SNAPSHOT, ...) \
     const TYPE PARAM_ID##_DEFAULT ARRAY_SYMBOL_##TYPE __attribute__((aligned (8))) = __VA_ARGS__;
 
+/** @brief  Macro to expand an entry in param table as variable definitions of parameter's RAM cache and staged value */
+#define PARAM_EXPAND_AS_CACHE_DEFINITION(PARAM_ID, PUC, TYPE, MIN, MAX, COMMIT, SNAPSHOT, ...)                      \
+    _Static_assert (CACHE_SIZE_##TYPE (MAX) != 0, "Max length of " #PARAM_ID " must be set");                     \
+    _Static_assert (sizeof (PARAM_ID##_DEFAULT) <= CACHE_SIZE_##TYPE (MAX), "Default of " #PARAM_ID " too long"); \
+    static uint8_t PARAM_ID##_CACHE [CACHE_SIZE_##TYPE (MAX)] __attribute__((aligned (8)));                      \
+    static uint8_t PARAM_ID##_STAGE [CACHE_SIZE_##TYPE (MAX)] __attribute__((aligned (8)));
+
+/** @brief  Macro to expand an entry in param table as a member of the union as large as the largest parameter value */
+#define PARAM_EXPAND_AS_VALUE_UNION_MEMBER(PARAM_ID, PUC, TYPE, MIN, MAX, COMMIT, SNAPSHOT, ...)                    \
+    uint8_t au8_##PARAM_ID [CACHE_SIZE_##TYPE (MAX)];
+
+/** @brief  Macro to expand an entry in param table as the maximum size of its record in a snapshot */
+#define PARAM_EXPAND_AS_SNAPSHOT_RECORD_SIZE(PARAM_ID, PUC, TYPE, MIN, MAX, COMMIT, SNAPSHOT, ...)                  \
+    + (PARAM_SNAPSHOT_##SNAPSHOT ? (PARAM_SNAPSHOT_RECORD_HEAD_SIZE + CACHE_SIZE_##TYPE (MAX)) : 0)
+
+/** @brief  Maximum size in bytes of a snapshot of all parameters */
+#define PARAM_SNAPSHOT_MAX_SIZE                                                                                     \
+    (PARAM_SNAPSHOT_HEADER_SIZE PARAM_TABLE (PARAM_EXPAND_AS_SNAPSHOT_RECORD_SIZE) + PARAM_SNAPSHOT_CRC_SIZE)
+
+/** @brief  Union as large as the largest parameter value */
+typedef union
+{
+    PARAM_TABLE (PARAM_EXPAND_AS_VALUE_UNION_MEMBER)
+
+} PARAM_value_t;
+
+/** @brief  How a change of a parameter is persisted in non-volatile storage */
+typedef enum
+{
+    PARAM_COMMIT_DEFERRED,                  //!< The change is written later, along with other changes
+    PARAM_COMMIT_IMMEDIATE,                 //!< The change is written and committed right away
+
+} PARAM_commit_t;
+
 /** @brief  Structure type to manage a parameter information */
 typedef struct
 {
@@ -70,6 +149,12 @@ typedef struct
     /** @brief  Parameter base type */
     PARAM_base_type_t       enm_base_type;
 
+    /** @brief  How a change of the parameter is persisted */
+    const PARAM_commit_t    enm_commit;
+
+    /** @brief  Indicates if the parameter is part of snapshots */
+    const bool              b_snapshot;
+
     /** @brief  Min and max value of the parameter */
     const union
     {
@@ -92,20 +177,79 @@ typedef struct
     /** @brief  Length in bytes of the default value */
     const uint16_t          u16_def_data_len;
 
+    /** @brief  Pointer to the buffer caching value of the parameter in RAM */
+    void * const            pv_cache;
+
+    /** @brief  Size in bytes of the cache buffer */
+    const uint16_t          u16_cache_size;
+
+    /** @brief  Length in bytes of the cached value (including NUL-terminator of a string value) */
+    uint16_t                u16_cache_len;
+
+    /** @brief  Indicates if the cached value has not been written to non-volatile storage yet */
+    bool                    b_dirty;
+
+    /** @brief  Pointer to the buffer storing value of the parameter staged in the transaction in progress */
+    void * const            pv_stage;
+
+    /** @brief  Length in bytes of the staged value */
+    uint16_t                u16_stage_len;
+
+    /** @brief  Indicates if a value of the parameter is staged in the transaction in progress */
+    bool                    b_staged;
+
 } PARAM_info_t;
 
+/** @brief  Structure encapsulating a subscriber to parameter changes */
+typedef struct
+{
+    uint64_t                u64_id_mask;    //!< Mask of the parameters subscribed to
+    PARAM_callback_t        pfnc_cb;        //!< Pointer to callback function
+    void *                  pv_arg;         //!< Argument passed to the callback function when invoking it
+
+} PARAM_subscriber_t;
+
+/* Lengths in a snapshot are 16-bit */
+_Static_assert (PARAM_SNAPSHOT_MAX_SIZE <= UINT16_MAX, "Parameters are too large to fit in a snapshot");
+
+/* A bit of subscription masks is allotted to each parameter */
+_Static_assert (PARAM_NUM_PARAMS <= 64, "Subscription masks can't hold all parameters");
+
 /** @brief  Macros to expand an entry in param table as initialization value for parameter's information structure */
-#define PARAM_EXPAND_AS_INFO_STRUCT_INIT(PARAM_ID, PUC, TYPE, MIN, MAX, ...)    \
+#define PARAM_EXPAND_AS_INFO_STRUCT_INIT(PARAM_ID, PUC, TYPE, MIN, MAX, COMMIT, SNAPSHOT, ...) \
 {                                                                               \
     .pstri_key              = #PUC,                                             \
     .u16_puc                = PUC,                                              \
     .enm_base_type          = BASE_TYPE_##TYPE,                                 \
+    .enm_commit             = PARAM_COMMIT_##COMMIT,                            \
+    .b_snapshot             = PARAM_SNAPSHOT_##SNAPSHOT,                        \
     .un_min.x_##TYPE        = MIN,                                              \
     .un_max.x_##TYPE        = MAX,                                              \
     .pv_def_data            = (void *)&PARAM_ID##_DEFAULT,                      \
-    .u16_def_data_len       = sizeof (PARAM_ID##_DEFAULT)                       \
+    .u16_def_data_len       = sizeof (PARAM_ID##_DEFAULT),                      \
+    .pv_cache               = PARAM_ID##_CACHE,                                 \
+    .u16_cache_size         = sizeof (PARAM_ID##_CACHE),                        \
+    .u16_cache_len          = 0,                                                \
+    .b_dirty                = false,                                            \
+    .pv_stage               = PARAM_ID##_STAGE,                                 \
+    .u16_stage_len          = 0,                                                \
+    .b_staged               = false                                             \
 },
 
+/**
+** @brief   Macro to expand an entry in param table as a case converting its PUC to its parameter ID
+** @note    The compiler turns the cases into a jump table or a binary search and rejects duplicated PUCs
+*/
+#define PARAM_EXPAND_AS_PUC_CASE(PARAM_ID, PUC, ...)                            \
+    case PUC:                                                                   \
+        *penm_param_id = PARAM_ID;                                              \
+        return PARAM_OK;
+
+/** @brief  Macro checking if a value is within min and max range of a parameter, if the range is enabled */
+#define PARAM_IS_WITHIN_RANGE(pstru_param, TYPE, value)                                                         \
+    ((((pstru_param)->un_min.x_##TYPE == 0) && ((pstru_param)->un_max.x_##TYPE == 0)) ||                      \
+     (((value) >= (pstru_param)->un_min.x_##TYPE) && ((value) <= (pstru_param)->un_max.x_##TYPE)))
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           VARIABLES SECTION
@@ -124,15 +268,67 @@ static nvs_handle_t g_x_handle;
 /** @brief  Default values of all parameters */
 static PARAM_TABLE (PARAM_EXPAND_AS_DEFAULT_VALUE_DEFINITION);
 
+/** @brief  RAM caches and staged values of all parameters */
+PARAM_TABLE (PARAM_EXPAND_AS_CACHE_DEFINITION)
+
 /** @brief  Information of all parameters */
 static PARAM_info_t g_astru_params [PARAM_NUM_PARAMS] = { PARAM_TABLE (PARAM_EXPAND_AS_INFO_STRUCT_INIT) };
 
+/** @brief  Mutex serializing changes of parameters, it is held while a change is written to non-volatile storage */
+static SemaphoreHandle_t g_x_write_mutex = NULL;
+
+/** @brief  Mutex protecting the number of readers of RAM cache */
+static SemaphoreHandle_t g_x_reader_mutex = NULL;
+
+/** @brief  Semaphore held either by the readers of RAM cache as a whole or by the writer updating it */
+static SemaphoreHandle_t g_x_cache_sem = NULL;
+
+/** @brief  Number of readers currently holding RAM cache */
+static uint16_t g_u16_num_readers = 0;
+
+/** @brief  Semaphore signaling Srvc_Param task that a deferred change has been made */
+static SemaphoreHandle_t g_x_commit_sem = NULL;
+
+/** @brief  Indicates if changes have been written to non-volatile storage but not committed yet */
+static bool g_b_commit_pending = false;
+
+/** @brief  Task which has begun the transaction in progress, NULL if no transaction is in progress */
+static TaskHandle_t g_x_trans_task = NULL;
+
+/** @brief  Indicates if a change has been rejected in the transaction in progress */
+static bool g_b_trans_failed = false;
+
+/** @brief  Subscribers to parameter changes */
+static PARAM_subscriber_t g_astru_subscribers [PARAM_MAX_NUM_SUBSCRIBERS];
+
+/** @brief  Previous value of the parameter being changed, passed to the subscribers */
+static PARAM_value_t g_un_old_value __attribute__((aligned (8)));
+
+/** @brief  Structure that will hold the TCB of the task being created */
+static StaticTask_t g_x_task_buffer;
+
+/** @brief  Buffer that the task being created will use as its stack */
+static StackType_t g_x_task_stack [PARAM_TASK_STACK_SIZE];
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+static bool b_PARAM_Is_Valid (const PARAM_info_t * pstru_param, const void * pv_value, uint16_t u16_len);
+static esp_err_t x_PARAM_Load (PARAM_info_t * pstru_param);
+static esp_err_t x_PARAM_Store (const PARAM_info_t * pstru_param, const void * pv_value, uint16_t u16_len);
+static int8_t s8_PARAM_Write (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len);
+static void v_PARAM_Read_Cache (PARAM_id_t enm_param_id, void * pv_value);
+static void v_PARAM_Lock_Read (void);
+static void v_PARAM_Unlock_Read (void);
+static bool b_PARAM_Is_In_Transaction (void);
+static void v_PARAM_End_Transaction (void);
+static void v_PARAM_Notify (PARAM_id_t enm_param_id, const void * pv_old_value, uint16_t u16_old_len);
+static void v_PARAM_Main_Task (void * pv_param);
+static void v_PARAM_Shutdown_Handler (void);
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           FUNCTIONS SECTION
@@ -161,6 +357,18 @@ int8_t s8_PARAM_Init (void)
 
     LOGD ("Initializing Srvc_Param module");
 
+    /* Create the locks protecting RAM cache */
+    g_x_write_mutex = xSemaphoreCreateMutex ();
+    g_x_reader_mutex = xSemaphoreCreateMutex ();
+    g_x_cache_sem = xSemaphoreCreateBinary ();
+    g_x_commit_sem = xSemaphoreCreateBinary ();
+    if ((g_x_write_mutex == NULL) || (g_x_reader_mutex == NULL) || (g_x_cache_sem == NULL) || (g_x_commit_sem == NULL))
+    {
+        LOGE ("Failed to create the locks of RAM cache");
+        return PARAM_ERR;
+    }
+    xSemaphoreGive (g_x_cache_sem);
+
     /* Initialize non-volatile storage */
     esp_err_t x_ret = nvs_flash_init ();
     if ((x_ret == ESP_ERR_NVS_NO_FREE_PAGES) || (x_ret == ESP_ERR_NVS_NEW_VERSION_FOUND))
@@ -179,157 +387,39 @@ int8_t s8_PARAM_Init (void)
         return PARAM_ERR;
     }
 
-    /* If any parameters are not available or not within min and max range, create and initialize them */
+    /*
+    ** Load all parameters into RAM cache. If any parameters are not available or not within min and max range,
+    ** create and initialize them
+    */
     for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
     {
         PARAM_info_t * pstru_param = &g_astru_params[u16_id];
-        switch (pstru_param->enm_base_type)
+        if ((x_PARAM_Load (pstru_param) != ESP_OK) ||
+            !b_PARAM_Is_Valid (pstru_param, pstru_param->pv_cache, pstru_param->u16_cache_len))
         {
-            case BASE_TYPE_uint8_t:
-            {
-                uint8_t u8_val;
-                if ((nvs_get_u8 (g_x_handle, pstru_param->pstri_key, &u8_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_uint8_t != 0) || (pstru_param->un_max.x_uint8_t != 0)) &&
-                     ((u8_val < pstru_param->un_min.x_uint8_t) || (u8_val > pstru_param->un_max.x_uint8_t))))
-                {
-                    nvs_set_u8 (g_x_handle, pstru_param->pstri_key, *((uint8_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %u",
-                          pstru_param->u16_puc, *((uint8_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_int8_t:
-            {
-                int8_t s8_val;
-                if ((nvs_get_i8 (g_x_handle, pstru_param->pstri_key, &s8_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_int8_t != 0) || (pstru_param->un_max.x_int8_t != 0)) &&
-                     ((s8_val < pstru_param->un_min.x_int8_t) || (s8_val > pstru_param->un_max.x_int8_t))))
-                {
-                    nvs_set_i8 (g_x_handle, pstru_param->pstri_key, *((int8_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %d",
-                          pstru_param->u16_puc, *((int8_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_uint16_t:
-            {
-                uint16_t u16_val;
-                if ((nvs_get_u16 (g_x_handle, pstru_param->pstri_key, &u16_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_uint16_t != 0) || (pstru_param->un_max.x_uint16_t != 0)) &&
-                     ((u16_val < pstru_param->un_min.x_uint16_t) || (u16_val > pstru_param->un_max.x_uint16_t))))
-                {
-                    nvs_set_u16 (g_x_handle, pstru_param->pstri_key, *((uint16_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %u",
-                          pstru_param->u16_puc, *((uint16_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_int16_t:
-            {
-                int16_t s16_val;
-                if ((nvs_get_i16 (g_x_handle, pstru_param->pstri_key, &s16_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_int16_t != 0) || (pstru_param->un_max.x_int16_t != 0)) &&
-                     ((s16_val < pstru_param->un_min.x_int16_t) || (s16_val > pstru_param->un_max.x_int16_t))))
-                {
-                    nvs_set_i16 (g_x_handle, pstru_param->pstri_key, *((int16_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %d",
-                          pstru_param->u16_puc, *((int16_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_uint32_t:
-            {
-                uint32_t u32_val;
-                if ((nvs_get_u32 (g_x_handle, pstru_param->pstri_key, &u32_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_uint32_t != 0) || (pstru_param->un_max.x_uint32_t != 0)) &&
-                     ((u32_val < pstru_param->un_min.x_uint32_t) || (u32_val > pstru_param->un_max.x_uint32_t))))
-                {
-                    nvs_set_u32 (g_x_handle, pstru_param->pstri_key, *((uint32_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %u",
-                          pstru_param->u16_puc, *((uint32_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_int32_t:
-            {
-                int32_t s32_val;
-                if ((nvs_get_i32 (g_x_handle, pstru_param->pstri_key, &s32_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_int32_t != 0) || (pstru_param->un_max.x_int32_t != 0)) &&
-                     ((s32_val < pstru_param->un_min.x_int32_t) || (s32_val > pstru_param->un_max.x_int32_t))))
-                {
-                    nvs_set_i32 (g_x_handle, pstru_param->pstri_key, *((int32_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %d",
-                          pstru_param->u16_puc, *((int32_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_uint64_t:
-            {
-                uint64_t u64_val;
-                if ((nvs_get_u64 (g_x_handle, pstru_param->pstri_key, &u64_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_uint64_t != 0) || (pstru_param->un_max.x_uint64_t != 0)) &&
-                     ((u64_val < pstru_param->un_min.x_uint64_t) || (u64_val > pstru_param->un_max.x_uint64_t))))
-                {
-                    nvs_set_u64 (g_x_handle, pstru_param->pstri_key, *((uint64_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %llu",
-                          pstru_param->u16_puc, *((uint64_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_int64_t:
-            {
-                int64_t s64_val;
-                if ((nvs_get_i64 (g_x_handle, pstru_param->pstri_key, &s64_val) != ESP_OK) ||
-                    (((pstru_param->un_min.x_int64_t != 0) || (pstru_param->un_max.x_int64_t != 0)) &&
-                     ((s64_val < pstru_param->un_min.x_int64_t) || (s64_val > pstru_param->un_max.x_int64_t))))
-                {
-                    nvs_set_i64 (g_x_handle, pstru_param->pstri_key, *((int64_t *)pstru_param->pv_def_data));
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %lld",
-                          pstru_param->u16_puc, *((int64_t *)pstru_param->pv_def_data));
-                }
-                break;
-            }
-
-            case BASE_TYPE_string:
-            {
-                size_t x_param_size = 0;
-                if ((nvs_get_str (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size) != ESP_OK) ||
-                    (((pstru_param->un_min.x_string != 0) || (pstru_param->un_max.x_string != 0)) &&
-                     ((x_param_size < pstru_param->un_min.x_string) || (x_param_size > pstru_param->un_max.x_string))))
-                {
-                    nvs_set_str (g_x_handle, pstru_param->pstri_key, (const char *)pstru_param->pv_def_data);
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value = %s",
-                          pstru_param->u16_puc, (const char *)pstru_param->pv_def_data);
-                }
-                break;
-            }
-
-            case BASE_TYPE_blob:
-            {
-                size_t x_param_size = 0;
-                if ((nvs_get_blob (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size) != ESP_OK) ||
-                    (((pstru_param->un_min.x_blob != 0) || (pstru_param->un_max.x_blob != 0)) &&
-                     ((x_param_size < pstru_param->un_min.x_blob) || (x_param_size > pstru_param->un_max.x_blob))))
-                {
-                    nvs_set_blob (g_x_handle, pstru_param->pstri_key,
-                                  pstru_param->pv_def_data, pstru_param->u16_def_data_len);
-                    LOGW ("Parameter PUC = 0x%04X has been reset to default value", pstru_param->u16_puc);
-                }
-                break;
-            }
+            x_PARAM_Store (pstru_param, pstru_param->pv_def_data, pstru_param->u16_def_data_len);
+            memcpy (pstru_param->pv_cache, pstru_param->pv_def_data, pstru_param->u16_def_data_len);
+            pstru_param->u16_cache_len = pstru_param->u16_def_data_len;
+            LOGW ("Parameter PUC = 0x%04X has been reset to default value", pstru_param->u16_puc);
         }
     }
 
     /* Commit any changes to non-volatile storage */
     nvs_commit (g_x_handle);
 
+    /* Make sure that deferred changes are committed before the device restarts */
+    esp_register_shutdown_handler (v_PARAM_Shutdown_Handler);
+
+    /* Create task committing deferred changes */
+    xTaskCreateStaticPinnedToCore ( v_PARAM_Main_Task,          /* Function that implements the task */
+                                    "Srvc_Param",               /* Text name for the task */
+                                    PARAM_TASK_STACK_SIZE,      /* Stack size in bytes, not words */
+                                    NULL,                       /* Parameter passed into the task */
+                                    PARAM_TASK_PRIORITY,        /* Priority at which the task is created */
+                                    g_x_task_stack,             /* Array to use as the task's stack */
+                                    &g_x_task_buffer,           /* Variable to hold the task's data structure */
+                                    PARAM_TASK_CPU_ID);         /* ID of the CPU that Srvc_Param task runs on */
+
     /* Done */
     LOGD ("Initialization of Srvc_Param module is done");
     g_b_initialized = true;
@@ -354,86 +444,22 @@ int8_t s8_PARAM_Init (void)
 int8_t s8_PARAM_Reset_Default (PARAM_id_t enm_param_id)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-    esp_err_t x_err = ESP_OK;
 
     ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
 
     /* Reset to default value */
-    switch (pstru_param->enm_base_type)
-    {
-        case BASE_TYPE_uint8_t:
-        {
-            x_err = nvs_set_u8 (g_x_handle, pstru_param->pstri_key, *((uint8_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_int8_t:
-        {
-            x_err = nvs_set_i8 (g_x_handle, pstru_param->pstri_key, *((int8_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_uint16_t:
-        {
-            x_err = nvs_set_u16 (g_x_handle, pstru_param->pstri_key, *((uint16_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_int16_t:
-        {
-            x_err = nvs_set_i16 (g_x_handle, pstru_param->pstri_key, *((int16_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_uint32_t:
-        {
-            x_err = nvs_set_u32 (g_x_handle, pstru_param->pstri_key, *((uint32_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_int32_t:
-        {
-            x_err = nvs_set_i32 (g_x_handle, pstru_param->pstri_key, *((int32_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_uint64_t:
-        {
-            x_err = nvs_set_u64 (g_x_handle, pstru_param->pstri_key, *((uint64_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_int64_t:
-        {
-            x_err = nvs_set_i64 (g_x_handle, pstru_param->pstri_key, *((int64_t *)pstru_param->pv_def_data));
-            break;
-        }
-        case BASE_TYPE_string:
-        {
-            x_err = nvs_set_str (g_x_handle, pstru_param->pstri_key, (const char *)pstru_param->pv_def_data);
-            break;
-        }
-        case BASE_TYPE_blob:
-        {
-            x_err = nvs_set_blob (g_x_handle, pstru_param->pstri_key, pstru_param->pv_def_data, pstru_param->u16_def_data_len);
-            break;
-        }
-    }
-
-    /* Check result */
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to reset param %s to default value (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    return PARAM_OK;
+    return s8_PARAM_Write (enm_param_id, pstru_param->pv_def_data, pstru_param->u16_def_data_len);
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Converts Param Unique Code of a parameter to parameter ID
-**
-** @param [in]
-**      u16_param_puc: Param Unique Code of a parameter
+**      Writes and commits all deferred parameter changes to non-volatile storage
 **
-** @param [out]
-**      penm_param_id: Parameter ID
+** @details
+**      Srvc_Param task calls this function once the parameters stop changing for PARAM_COMMIT_QUIESCENCE_MS, it can
+**      also be called to persist the changes right away, for example before the device is powered off
 **
 ** @return
 **      @arg    PARAM_OK
@@ -441,98 +467,104 @@ int8_t s8_PARAM_Reset_Default (PARAM_id_t enm_param_id)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Convert_PUC_To_ID (uint16_t u16_param_puc, PARAM_id_t * penm_param_id)
+int8_t s8_PARAM_Flush (void)
 {
+    int8_t s8_result = PARAM_OK;
+
     ASSERT_PARAM (g_b_initialized);
 
-    /* Loop through all parameters */
-    for (PARAM_id_t enm_param_id = 0; enm_param_id < PARAM_NUM_PARAMS; enm_param_id++)
+    /* Changes are blocked meanwhile, RAM cache can therefore be read without locking it */
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+
+    /* Write all dirty parameters */
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
     {
-        if (g_astru_params[enm_param_id].u16_puc == u16_param_puc)
+        PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+        if (pstru_param->b_dirty)
         {
-            *penm_param_id = enm_param_id;
-            return PARAM_OK;
+            esp_err_t x_err = x_PARAM_Store (pstru_param, pstru_param->pv_cache, pstru_param->u16_cache_len);
+            if (x_err != ESP_OK)
+            {
+                LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
+                s8_result = PARAM_ERR;
+            }
+            else
+            {
+                pstru_param->b_dirty = false;
+                g_b_commit_pending = true;
+            }
         }
     }
 
-    return PARAM_ERR;
-}
-
-/**
-** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-**
-** @brief
-**      Converts parameter ID of a parameter to Param Unique Code
-**
-** @param [in]
-**      enm_param_id: Parameter ID
-**
-** @param [out]
-**      pu16_param_puc: Param Unique Code
-**
-** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
-**
-** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
-*/
-int8_t s8_PARAM_Convert_ID_To_PUC (PARAM_id_t enm_param_id, uint16_t * pu16_param_puc)
-{
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    /* Commit all of them at once */
+    if (g_b_commit_pending)
+    {
+        esp_err_t x_err = nvs_commit (g_x_handle);
+        if (x_err != ESP_OK)
+        {
+            LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
+            s8_result = PARAM_ERR;
+        }
+        else
+        {
+            g_b_commit_pending = false;
+        }
+    }
 
-    /* Get PUC of the parameter */
-    *pu16_param_puc = pstru_param->u16_puc;
-    return PARAM_OK;
+    xSemaphoreGive (g_x_write_mutex);
+    return s8_result;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets data type of a parameter
+**      Begins a transaction changing several parameters at once
 **
-** @param [in]
-**      enm_param_id: Parameter ID
-**
-** @param [out]
-**      penm_type: Type of parameter's data
+** @details
+**      Until the transaction is committed or aborted, the parameter setters called by the calling task validate the
+**      new values and only stage them, the getters still return the current values. Only one transaction can be in
+**      progress at a time. Unmanaged parameters are not part of transactions.
 **
 ** @return
 **      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      @arg    PARAM_ERR: Another transaction is in progress
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Type (PARAM_id_t enm_param_id, PARAM_base_type_t * penm_type)
+int8_t s8_PARAM_Begin (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    int8_t s8_result = PARAM_OK;
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (penm_type != NULL));
+    ASSERT_PARAM (g_b_initialized);
 
-    /* Get data type of the parameter */
-    *penm_type = pstru_param->enm_base_type;
-    return PARAM_OK;
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+    if (g_x_trans_task != NULL)
+    {
+        LOGW ("Another transaction is in progress");
+        s8_result = PARAM_ERR;
+    }
+    else
+    {
+        g_x_trans_task = xTaskGetCurrentTaskHandle ();
+        g_b_trans_failed = false;
+    }
+    xSemaphoreGive (g_x_write_mutex);
+
+    return s8_result;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Generic function to get value of a parameter
-**
-** @note
-**      The caller MUST free the memory pointed by ppv_value after using it.
-**
-** @param [in]
-**      enm_param_id: Parameter ID
-**
-** @param [out]
-**      ppv_value: Pointer to the allocated memory containing parameter's value. The value is NULL in case of failure
+**      Commits the transaction begun by the calling task
 **
-** @param [out]
-**      pu16_len: Length in bytes of the parameter's value
+** @details
+**      If all the staged values are valid, the changed ones are applied to RAM cache at once. Those which must be
+**      committed immediately are written to non-volatile storage first with a single commit, the deferred ones are
+**      written together by Srvc_Param task later. If a staged value is invalid or writing any of them fails, none of
+**      them is applied. The transaction ends in any case.
 **
 ** @return
 **      @arg    PARAM_OK
@@ -540,153 +572,187 @@ int8_t s8_PARAM_Get_Type (PARAM_id_t enm_param_id, PARAM_base_type_t * penm_type
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Value (PARAM_id_t enm_param_id, void ** ppv_value, uint16_t * pu16_len)
+int8_t s8_PARAM_Commit (void)
 {
-    esp_err_t       x_err = ESP_OK;
-    bool            b_success = true;
-    void *          pv_param_value = NULL;
-    size_t          x_param_size = 0;
-    PARAM_info_t *  pstru_param = &g_astru_params[enm_param_id];
+    int8_t      s8_result = PARAM_OK;
+    uint16_t    u16_num_checked = 0;
+    bool        b_stored = false;
+    bool        b_deferred = false;
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppv_value != NULL) && (pu16_len != NULL));
+    ASSERT_PARAM (g_b_initialized);
 
-    /* Determine length in bytes of parameter value */
-    switch (pstru_param->enm_base_type)
+    /* Changes are blocked meanwhile, RAM cache can therefore be read without locking it */
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+    if (!b_PARAM_Is_In_Transaction ())
     {
-        case BASE_TYPE_uint8_t:
-        case BASE_TYPE_int8_t:
-            x_param_size = 1;
-            break;
+        LOGE ("No transaction is in progress");
+        xSemaphoreGive (g_x_write_mutex);
+        return PARAM_ERR;
+    }
 
-        case BASE_TYPE_uint16_t:
-        case BASE_TYPE_int16_t:
-            x_param_size = 2;
-            break;
-
-        case BASE_TYPE_uint32_t:
-        case BASE_TYPE_int32_t:
-            x_param_size = 4;
-            break;
-
-        case BASE_TYPE_uint64_t:
-        case BASE_TYPE_int64_t:
-            x_param_size = 8;
-            break;
-
-        case BASE_TYPE_string:
-            x_err = nvs_get_str (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size);
-            break;
-
-        case BASE_TYPE_blob:
-            x_err = nvs_get_blob (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size);
-            break;
+    /* All or nothing */
+    if (g_b_trans_failed)
+    {
+        LOGE ("Transaction is discarded as some of its values are invalid");
+        s8_result = PARAM_ERR;
     }
 
-    /* Check result */
-    if (x_err != ESP_OK)
+    /* Keep only the staged values which differ from the current ones */
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
     {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        b_success = false;
+        PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+        if (pstru_param->b_staged && (pstru_param->u16_stage_len == pstru_param->u16_cache_len) &&
+            (memcmp (pstru_param->pv_stage, pstru_param->pv_cache, pstru_param->u16_stage_len) == 0))
+        {
+            pstru_param->b_staged = false;
+        }
     }
 
-    /* Allocate dynamic memory to store parameter value */
-    if (b_success)
+    /* Write the changes which must be persisted right away */
+    for (; (s8_result == PARAM_OK) && (u16_num_checked < PARAM_NUM_PARAMS); u16_num_checked++)
     {
-        *pu16_len = x_param_size;
-        pv_param_value = malloc (x_param_size);
-        if (pv_param_value == NULL)
+        PARAM_info_t * pstru_param = &g_astru_params[u16_num_checked];
+        if (pstru_param->b_staged && (pstru_param->enm_commit == PARAM_COMMIT_IMMEDIATE))
         {
-            LOGE ("Failed to allocate memory for param %s", pstru_param->pstri_key);
-            b_success = false;
+            esp_err_t x_err = x_PARAM_Store (pstru_param, pstru_param->pv_stage, pstru_param->u16_stage_len);
+            if (x_err != ESP_OK)
+            {
+                LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
+                s8_result = PARAM_ERR;
+            }
+            b_stored = true;
         }
     }
 
-    /* Get value of the parameter */
-    if (b_success)
+    /* If a write failed, restore the values already written from RAM cache */
+    if ((s8_result != PARAM_OK) && b_stored)
     {
-        switch (pstru_param->enm_base_type)
+        for (uint16_t u16_id = 0; u16_id < u16_num_checked; u16_id++)
         {
-            case BASE_TYPE_uint8_t:
-                x_err = nvs_get_u8 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_int8_t:
-                x_err = nvs_get_i8 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_uint16_t:
-                x_err = nvs_get_u16 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_int16_t:
-                x_err = nvs_get_i16 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_uint32_t:
-                x_err = nvs_get_u32 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_int32_t:
-                x_err = nvs_get_i32 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
-
-            case BASE_TYPE_uint64_t:
-                x_err = nvs_get_u64 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
+            PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+            if (pstru_param->b_staged && (pstru_param->enm_commit == PARAM_COMMIT_IMMEDIATE))
+            {
+                x_PARAM_Store (pstru_param, pstru_param->pv_cache, pstru_param->u16_cache_len);
+            }
+        }
+    }
 
-            case BASE_TYPE_int64_t:
-                x_err = nvs_get_i64 (g_x_handle, pstru_param->pstri_key, pv_param_value);
-                break;
+    /* Commit all of them at once */
+    if ((s8_result == PARAM_OK) && b_stored)
+    {
+        esp_err_t x_err = nvs_commit (g_x_handle);
+        if (x_err != ESP_OK)
+        {
+            LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
+            s8_result = PARAM_ERR;
+        }
+    }
 
-            case BASE_TYPE_string:
-                x_err = nvs_get_str (g_x_handle, pstru_param->pstri_key, pv_param_value, &x_param_size);
-                break;
+    /* Apply all the changes to RAM cache at once */
+    if (s8_result == PARAM_OK)
+    {
+        xSemaphoreTake (g_x_cache_sem, portMAX_DELAY);
+        for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
+        {
+            PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+            if (pstru_param->b_staged)
+            {
+                /* Keep the previous value in place of the staged one, so that it can be notified */
+                uint16_t u16_old_len = pstru_param->u16_cache_len;
+                memcpy (&g_un_old_value, pstru_param->pv_cache, u16_old_len);
+                memcpy (pstru_param->pv_cache, pstru_param->pv_stage, pstru_param->u16_stage_len);
+                pstru_param->u16_cache_len = pstru_param->u16_stage_len;
+                memcpy (pstru_param->pv_stage, &g_un_old_value, u16_old_len);
+                pstru_param->u16_stage_len = u16_old_len;
+                if (pstru_param->enm_commit == PARAM_COMMIT_DEFERRED)
+                {
+                    pstru_param->b_dirty = true;
+                    b_deferred = true;
+                }
+            }
+        }
+        xSemaphoreGive (g_x_cache_sem);
 
-            case BASE_TYPE_blob:
-                x_err = nvs_get_blob (g_x_handle, pstru_param->pstri_key, pv_param_value, &x_param_size);
-                break;
+        /* Let Srvc_Param task write the deferred changes together */
+        if (b_deferred)
+        {
+            xSemaphoreGive (g_x_commit_sem);
         }
 
-        /* Check result */
-        if (x_err != ESP_OK)
+        /* Notify the subscribers once all the changes are visible */
+        for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
         {
-            LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-            b_success = false;
+            PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+            if (pstru_param->b_staged)
+            {
+                v_PARAM_Notify (u16_id, pstru_param->pv_stage, pstru_param->u16_stage_len);
+            }
         }
     }
 
-    /* Done */
-    if (b_success)
+    v_PARAM_End_Transaction ();
+    xSemaphoreGive (g_x_write_mutex);
+
+    return s8_result;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Aborts the transaction begun by the calling task, discarding all the staged values
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR: The calling task has no transaction in progress
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Abort (void)
+{
+    int8_t s8_result = PARAM_OK;
+
+    ASSERT_PARAM (g_b_initialized);
+
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+    if (!b_PARAM_Is_In_Transaction ())
     {
-        *ppv_value = pv_param_value;
-        return PARAM_OK;
+        LOGE ("No transaction is in progress");
+        s8_result = PARAM_ERR;
     }
     else
     {
-        /* Clean up */
-        if (pv_param_value != NULL)
-        {
-            free (pv_param_value);
-        }
-        *ppv_value = NULL;
-        return PARAM_ERR;
+        v_PARAM_End_Transaction ();
     }
+    xSemaphoreGive (g_x_write_mutex);
+
+    return s8_result;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Generic function to set value of a parameter
+**      Subscribes to changes of parameters
+**
+** @details
+**      The callback is invoked once a change of any of the given parameters is applied to RAM cache, after the
+**      change has been committed to non-volatile storage if the parameter must be committed immediately. For the
+**      changes made in a transaction, it is invoked once all of them have been applied.
+**      A maximum of PARAM_MAX_NUM_SUBSCRIBERS subscriptions can be made.
+**
+** @note
+**      The callback is invoked in the context of the task changing the parameter, while further changes are blocked.
+**      It must return quickly and must not change any parameter, it can however read parameters.
 **
 ** @param [in]
-**      enm_param_id: Parameter ID
+**      u64_id_mask: Mask of the parameters to subscribe to, made of PARAM_MASK() of each of them
 **
 ** @param [in]
-**      pv_value: Buffer storing parameter's value
+**      pfnc_cb: The callback to be called
 **
 ** @param [in]
-**      u16_len: Length in bytes of the parameter
+**      pv_arg: Optional context data which will be passed into the callback when it is invoked
 **
 ** @return
 **      @arg    PARAM_OK
@@ -694,65 +760,131 @@ int8_t s8_PARAM_Get_Value (PARAM_id_t enm_param_id, void ** ppv_value, uint16_t
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Value (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len)
+int8_t s8_PARAM_Subscribe (uint64_t u64_id_mask, PARAM_callback_t pfnc_cb, void * pv_arg)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pv_value != NULL) && (u16_len > 0));
+    uint8_t u8_idx;
 
-    /* Change parameter value */
-    switch (pstru_param->enm_base_type)
-    {
-        case BASE_TYPE_uint8_t:
-            return s8_PARAM_Set_Uint8 (enm_param_id, *((uint8_t *)pv_value));
+    /* Validate arguments */
+    ASSERT_PARAM (g_b_initialized && (u64_id_mask != 0) && (pfnc_cb != NULL));
 
-        case BASE_TYPE_int8_t:
-            return s8_PARAM_Set_Int8 (enm_param_id, *((int8_t *)pv_value));
+    /* Subscribers are notified while changes are blocked */
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
 
-        case BASE_TYPE_uint16_t:
-            return s8_PARAM_Set_Uint16 (enm_param_id, *((uint16_t *)pv_value));
+    /* Store the callback function and its optional argument */
+    for (u8_idx = 0; u8_idx < PARAM_MAX_NUM_SUBSCRIBERS; u8_idx++)
+    {
+        if (g_astru_subscribers[u8_idx].pfnc_cb == NULL)
+        {
+            g_astru_subscribers[u8_idx].u64_id_mask = u64_id_mask;
+            g_astru_subscribers[u8_idx].pfnc_cb = pfnc_cb;
+            g_astru_subscribers[u8_idx].pv_arg = pv_arg;
+            break;
+        }
+    }
 
-        case BASE_TYPE_int16_t:
-            return s8_PARAM_Set_Int16 (enm_param_id, *((int16_t *)pv_value));
+    /* Cleanup */
+    xSemaphoreGive (g_x_write_mutex);
+    if (u8_idx >= PARAM_MAX_NUM_SUBSCRIBERS)
+    {
+        LOGE ("Failed to subscribe to parameter changes, maximum of %d subscriptions reached",
+              PARAM_MAX_NUM_SUBSCRIBERS);
+        return PARAM_ERR;
+    }
+    return PARAM_OK;
+}
 
-        case BASE_TYPE_uint32_t:
-            return s8_PARAM_Set_Uint32 (enm_param_id, *((uint32_t *)pv_value));
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Exports a snapshot of the parameters
+**
+** @details
+**      The snapshot holds the current values of all parameters marked as such in param table, in the format described
+**      in srvc_param.h. It can be imported by s8_PARAM_Import() on this device or on another one.
+**
+** @note
+**      The caller MUST free the memory pointed by ppu8_snapshot after using it.
+**
+** @param [out]
+**      ppu8_snapshot: Pointer to the allocated memory containing the snapshot, NULL in case of failure
+**
+** @param [out]
+**      pu16_len: Length in bytes of the snapshot
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Export (uint8_t ** ppu8_snapshot, uint16_t * pu16_len)
+{
+    uint16_t    u16_len = PARAM_SNAPSHOT_HEADER_SIZE;
+    uint16_t    u16_num_records = 0;
 
-        case BASE_TYPE_int32_t:
-            return s8_PARAM_Set_Int32 (enm_param_id, *((int32_t *)pv_value));
+    ASSERT_PARAM (g_b_initialized && (ppu8_snapshot != NULL) && (pu16_len != NULL));
+    *ppu8_snapshot = NULL;
+    *pu16_len = 0;
 
-        case BASE_TYPE_uint64_t:
-            return s8_PARAM_Set_Uint64 (enm_param_id, *((uint64_t *)pv_value));
+    /* Allocate memory for the largest snapshot */
+    uint8_t * pu8_snapshot = malloc (PARAM_SNAPSHOT_MAX_SIZE);
+    if (pu8_snapshot == NULL)
+    {
+        LOGE ("Failed to allocate memory for parameter snapshot");
+        return PARAM_ERR;
+    }
 
-        case BASE_TYPE_int64_t:
-            return s8_PARAM_Set_Int64 (enm_param_id, *((int64_t *)pv_value));
+    /* Records of the parameters, all taken from RAM cache at the same time */
+    v_PARAM_Lock_Read ();
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
+    {
+        PARAM_info_t * pstru_param = &g_astru_params[u16_id];
+        if (pstru_param->b_snapshot)
+        {
+            uint8_t * pu8_record = &pu8_snapshot[u16_len];
+            ENDIAN_PUT16 (&pu8_record[0], pstru_param->u16_puc);
+            pu8_record[2] = (uint8_t)pstru_param->enm_base_type;
+            ENDIAN_PUT16 (&pu8_record[3], pstru_param->u16_cache_len);
+            memcpy (&pu8_record[PARAM_SNAPSHOT_RECORD_HEAD_SIZE], pstru_param->pv_cache, pstru_param->u16_cache_len);
+            u16_len += PARAM_SNAPSHOT_RECORD_HEAD_SIZE + pstru_param->u16_cache_len;
+            u16_num_records++;
+        }
+    }
+    v_PARAM_Unlock_Read ();
 
-        case BASE_TYPE_string:
-            return s8_PARAM_Set_String (enm_param_id, (char *)pv_value);
+    /* Header */
+    memcpy (&pu8_snapshot[0], PARAM_SNAPSHOT_MAGIC, 4);
+    ENDIAN_PUT16 (&pu8_snapshot[4], PARAM_SNAPSHOT_VERSION);
+    ENDIAN_PUT16 (&pu8_snapshot[6], u16_num_records);
 
-        case BASE_TYPE_blob:
-            return s8_PARAM_Set_Blob (enm_param_id, pv_value, u16_len);
-    }
+    /* CRC of the whole snapshot. Note that crc32_le() has a `~` at the beginning and the end of the function */
+    uint32_t u32_crc = crc32_le (0, pu8_snapshot, u16_len);
+    ENDIAN_PUT32 (&pu8_snapshot[u16_len], u32_crc);
+    u16_len += PARAM_SNAPSHOT_CRC_SIZE;
 
-    LOGE ("Unsupported type");
-    return PARAM_ERR;
+    /* Done */
+    *ppu8_snapshot = pu8_snapshot;
+    *pu16_len = u16_len;
+    return PARAM_OK;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an unmanaged string parameter
+**      Imports a snapshot of the parameters
 **
-** @note
-**      The caller MUST free the memory pointed by ppstri_value after using it.
+** @details
+**      The snapshot is checked against its CRC, then all of its values are changed in a single transaction: either
+**      all of them are valid and changed, or none of them is. Records of parameters which are unknown to this firmware
+**      or which are not part of snapshots are ignored.
 **
 ** @param [in]
-**      pstri_key: Key identifying the parameter
+**      pu8_snapshot: The snapshot, in the format described in srvc_param.h
 **
-** @param [out]
-**      ppstri_value: Pointer to the allocated memory containing parameter's value (NULL-terminated string)
-**                    Value is NULL in case of failure
+** @param [in]
+**      u16_len: Length in bytes of the snapshot
 **
 ** @return
 **      @arg    PARAM_OK
@@ -760,77 +892,118 @@ int8_t s8_PARAM_Set_Value (PARAM_id_t enm_param_id, const void * pv_value, uint1
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_String_Unmanaged (const char * pstri_key, char ** ppstri_value)
+int8_t s8_PARAM_Import (const uint8_t * pu8_snapshot, uint16_t u16_len)
 {
-    esp_err_t   x_err = ESP_OK;
-    bool        b_success = true;
-    char *      pstri_param_value = NULL;
-    size_t      x_param_size = 0;
+    int8_t      s8_result = PARAM_OK;
+    uint16_t    u16_offset = PARAM_SNAPSHOT_HEADER_SIZE;
 
-    ASSERT_PARAM (g_b_initialized && (pstri_key != NULL) && (ppstri_value != NULL));
+    ASSERT_PARAM (g_b_initialized && (pu8_snapshot != NULL));
 
-    /* Get length in bytes of parameter value */
-    if (b_success)
+    /* Check the header */
+    if ((u16_len < PARAM_SNAPSHOT_HEADER_SIZE + PARAM_SNAPSHOT_CRC_SIZE) ||
+        (memcmp (&pu8_snapshot[0], PARAM_SNAPSHOT_MAGIC, 4) != 0))
     {
-        x_err = nvs_get_str (g_x_handle, pstri_key, NULL, &x_param_size);
-        if (x_err != ESP_OK)
-        {
-            LOGE ("Failed to access param \"%s\" (%s)", pstri_key, esp_err_to_name (x_err));
-            b_success = false;
-        }
+        LOGE ("Invalid parameter snapshot");
+        return PARAM_ERR;
+    }
+    if (ENDIAN_GET16 (&pu8_snapshot[4]) != PARAM_SNAPSHOT_VERSION)
+    {
+        LOGE ("Version %d of parameter snapshot is not supported", ENDIAN_GET16 (&pu8_snapshot[4]));
+        return PARAM_ERR;
     }
 
-    /* Allocate dynamic memory to store parameter value */
-    if (b_success)
+    /* Check integrity of the snapshot */
+    uint16_t u16_end = u16_len - PARAM_SNAPSHOT_CRC_SIZE;
+    if (ENDIAN_GET32 (&pu8_snapshot[u16_end]) != crc32_le (0, pu8_snapshot, u16_end))
     {
-        pstri_param_value = malloc (x_param_size);
-        if (pstri_param_value == NULL)
-        {
-            LOGE ("Failed to allocate memory for param %s", pstri_key);
-            b_success = false;
-        }
+        LOGE ("CRC of parameter snapshot is invalid");
+        return PARAM_ERR;
     }
 
-    /* Get NULL-terminated string value of the parameter */
-    if (b_success)
+    /* All the values are changed at once, or none of them */
+    if (s8_PARAM_Begin () != PARAM_OK)
     {
-        x_err = nvs_get_str (g_x_handle, pstri_key, pstri_param_value, &x_param_size);
-        if (x_err != ESP_OK)
+        return PARAM_ERR;
+    }
+
+    /* Stage value of each record */
+    uint16_t u16_num_records = ENDIAN_GET16 (&pu8_snapshot[6]);
+    for (uint16_t u16_idx = 0; (s8_result == PARAM_OK) && (u16_idx < u16_num_records); u16_idx++)
+    {
+        /* Head of the record */
+        const uint8_t * pu8_record = &pu8_snapshot[u16_offset];
+        if ((u16_end - u16_offset < PARAM_SNAPSHOT_RECORD_HEAD_SIZE) ||
+            (u16_end - u16_offset - PARAM_SNAPSHOT_RECORD_HEAD_SIZE < ENDIAN_GET16 (&pu8_record[3])))
         {
-            LOGE ("Failed to access param %s (%s)", pstri_key, esp_err_to_name (x_err));
-            b_success = false;
+            LOGE ("Parameter snapshot is truncated");
+            s8_result = PARAM_ERR;
+            break;
+        }
+        uint16_t u16_puc = ENDIAN_GET16 (&pu8_record[0]);
+        uint8_t u8_type = pu8_record[2];
+        uint16_t u16_value_len = ENDIAN_GET16 (&pu8_record[3]);
+        const void * pv_value = &pu8_record[PARAM_SNAPSHOT_RECORD_HEAD_SIZE];
+        u16_offset += PARAM_SNAPSHOT_RECORD_HEAD_SIZE + u16_value_len;
+
+        /* Parameters unknown to this firmware or specific to a device are left unchanged */
+        PARAM_id_t enm_param_id;
+        if ((s8_PARAM_Convert_PUC_To_ID (u16_puc, &enm_param_id) != PARAM_OK) ||
+            !g_astru_params[enm_param_id].b_snapshot)
+        {
+            LOGW ("Parameter PUC = 0x%04X of the snapshot is ignored", u16_puc);
+            continue;
+        }
+
+        /* The record must match the parameter */
+        PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+        bool b_number = (pstru_param->enm_base_type != BASE_TYPE_string) &&
+                        (pstru_param->enm_base_type != BASE_TYPE_blob);
+        if ((u8_type != pstru_param->enm_base_type) || (b_number && (u16_value_len != pstru_param->u16_cache_size)))
+        {
+            LOGE ("Type of param %s in the snapshot doesn't match", pstru_param->pstri_key);
+            s8_result = PARAM_ERR;
+            break;
+        }
+
+        /* Numbers are copied so that they are aligned */
+        uint64_t u64_number = 0;
+        if (b_number)
+        {
+            memcpy (&u64_number, pv_value, u16_value_len);
+            pv_value = &u64_number;
         }
+
+        /* Validate and stage the value */
+        s8_result = s8_PARAM_Write (enm_param_id, pv_value, u16_value_len);
     }
 
-    /* Done */
-    if (b_success)
+    /* The records must fill the snapshot */
+    if ((s8_result == PARAM_OK) && (u16_offset != u16_end))
     {
-        *ppstri_value = pstri_param_value;
-        return PARAM_OK;
+        LOGE ("Parameter snapshot has %d bytes of unexpected data", u16_end - u16_offset);
+        s8_result = PARAM_ERR;
     }
-    else
+
+    /* Commit the changes only if all of them are valid */
+    if (s8_result != PARAM_OK)
     {
-        /* Clean up */
-        if (pstri_param_value != NULL)
-        {
-            free (pstri_param_value);
-        }
-        *ppstri_value = NULL;
+        s8_PARAM_Abort ();
         return PARAM_ERR;
     }
+    return s8_PARAM_Commit ();
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an unmanaged string parameter, if the parameter doesn't exist, it will be created
+**      Converts Param Unique Code of a parameter to parameter ID
 **
 ** @param [in]
-**      pstri_key: Key identifying the parameter
+**      u16_param_puc: Param Unique Code of a parameter
 **
-** @param [in]
-**      pstri_value: Parameter's value (NULL-terminated string)
+** @param [out]
+**      penm_param_id: Parameter ID
 **
 ** @return
 **      @arg    PARAM_OK
@@ -838,44 +1011,31 @@ int8_t s8_PARAM_Get_String_Unmanaged (const char * pstri_key, char ** ppstri_val
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_String_Unmanaged (const char * pstri_key, const char * pstri_value)
+int8_t s8_PARAM_Convert_PUC_To_ID (uint16_t u16_param_puc, PARAM_id_t * penm_param_id)
 {
-    ASSERT_PARAM (g_b_initialized && (pstri_key != NULL) && (pstri_value != NULL));
+    ASSERT_PARAM (g_b_initialized);
 
-    /* Write value to the parameter value */
-    esp_err_t x_err = nvs_set_str (g_x_handle, pstri_key, pstri_value);
-    if (x_err != ESP_OK)
+    /* Look up the PUC among the cases generated from the param table */
+    switch (u16_param_puc)
     {
-        LOGE ("Failed to change value of param %s (%s)", pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+        PARAM_TABLE (PARAM_EXPAND_AS_PUC_CASE)
 
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
+        default:
+            return PARAM_ERR;
     }
-
-    return PARAM_OK;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of a string parameter
-**
-** @note
-**      The caller MUST free the memory pointed by ppstri_value after using it.
+**      Converts parameter ID of a parameter to Param Unique Code
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [out]
-**      ppstri_value: Pointer to the allocated memory containing parameter's value (NULL-terminated string)
-**                    Value is NULL in case of failure
+**      pu16_param_puc: Param Unique Code
 **
 ** @return
 **      @arg    PARAM_OK
@@ -883,79 +1043,111 @@ int8_t s8_PARAM_Set_String_Unmanaged (const char * pstri_key, const char * pstri
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_String (PARAM_id_t enm_param_id, char ** ppstri_value)
+int8_t s8_PARAM_Convert_ID_To_PUC (PARAM_id_t enm_param_id, uint16_t * pu16_param_puc)
 {
-    esp_err_t       x_err = ESP_OK;
-    bool            b_success = true;
-    char *          pstri_param_value = NULL;
-    size_t          x_param_size = 0;
-    PARAM_info_t *  pstru_param = &g_astru_params[enm_param_id];
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppstri_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_string);
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
 
-    /* Get length in bytes of parameter value */
-    if (b_success)
-    {
-        x_err = nvs_get_str (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size);
-        if (x_err != ESP_OK)
-        {
-            LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-            b_success = false;
-        }
-    }
+    /* Get PUC of the parameter */
+    *pu16_param_puc = pstru_param->u16_puc;
+    return PARAM_OK;
+}
 
-    /* Allocate dynamic memory to store parameter value */
-    if (b_success)
-    {
-        pstri_param_value = malloc (x_param_size);
-        if (pstri_param_value == NULL)
-        {
-            LOGE ("Failed to allocate memory for param %s", pstru_param->pstri_key);
-            b_success = false;
-        }
-    }
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets data type of a parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      penm_type: Type of parameter's data
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Type (PARAM_id_t enm_param_id, PARAM_base_type_t * penm_type)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    /* Get NULL-terminated string value of the parameter */
-    if (b_success)
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (penm_type != NULL));
+
+    /* Get data type of the parameter */
+    *penm_type = pstru_param->enm_base_type;
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Generic function to get value of a parameter
+**
+** @note
+**      The caller MUST free the memory pointed by ppv_value after using it.
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ppv_value: Pointer to the allocated memory containing parameter's value. The value is NULL in case of failure
+**
+** @param [out]
+**      pu16_len: Length in bytes of the parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Value (PARAM_id_t enm_param_id, void ** ppv_value, uint16_t * pu16_len)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    void * pv_param_value = NULL;
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppv_value != NULL) && (pu16_len != NULL));
+
+    /* Copy the cached value of the parameter into dynamic memory */
+    v_PARAM_Lock_Read ();
+    *pu16_len = pstru_param->u16_cache_len;
+    pv_param_value = malloc (pstru_param->u16_cache_len);
+    if (pv_param_value != NULL)
     {
-        x_err = nvs_get_str (g_x_handle, pstru_param->pstri_key, pstri_param_value, &x_param_size);
-        if (x_err != ESP_OK)
-        {
-            LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-            b_success = false;
-        }
+        memcpy (pv_param_value, pstru_param->pv_cache, pstru_param->u16_cache_len);
     }
+    v_PARAM_Unlock_Read ();
 
     /* Done */
-    if (b_success)
-    {
-        *ppstri_value = pstri_param_value;
-        return PARAM_OK;
-    }
-    else
+    *ppv_value = pv_param_value;
+    if (pv_param_value == NULL)
     {
-        /* Clean up */
-        if (pstri_param_value != NULL)
-        {
-            free (pstri_param_value);
-        }
-        *ppstri_value = NULL;
+        LOGE ("Failed to allocate memory for param %s", pstru_param->pstri_key);
         return PARAM_ERR;
     }
+    return PARAM_OK;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of a string parameter, if the parameter doesn't exist, it will be created
+**      Generic function to set value of a parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      pstri_value: Parameter's value (NULL-terminated string)
+**      pv_value: Buffer storing parameter's value
+**
+** @param [in]
+**      u16_len: Length in bytes of the parameter
 **
 ** @return
 **      @arg    PARAM_OK
@@ -963,41 +1155,89 @@ int8_t s8_PARAM_Get_String (PARAM_id_t enm_param_id, char ** ppstri_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_String (PARAM_id_t enm_param_id, const char * pstri_value)
+int8_t s8_PARAM_Set_Value (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pstri_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_string);
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pv_value != NULL) && (u16_len > 0));
 
-    /* Check data length if required */
-    if ((pstru_param->un_min.x_string != 0) || (pstru_param->un_max.x_string != 0))
+    /* Change parameter value */
+    switch (pstru_param->enm_base_type)
     {
-        uint16_t u16_len = strlen (pstri_value);
-        if ((u16_len < pstru_param->un_min.x_string) || (u16_len > pstru_param->un_max.x_string))
-        {
-            LOGE ("Data length of param %s (%d bytes) is NOT within the allowed range",
-                  pstru_param->pstri_key, u16_len);
-            return PARAM_ERR;
-        }
-    }
+        case BASE_TYPE_uint8_t:
+            return s8_PARAM_Set_Uint8 (enm_param_id, *((uint8_t *)pv_value));
 
-    /* Write value to the parameter value */
-    esp_err_t x_err = nvs_set_str (g_x_handle, pstru_param->pstri_key, pstri_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+        case BASE_TYPE_int8_t:
+            return s8_PARAM_Set_Int8 (enm_param_id, *((int8_t *)pv_value));
 
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
+        case BASE_TYPE_uint16_t:
+            return s8_PARAM_Set_Uint16 (enm_param_id, *((uint16_t *)pv_value));
+
+        case BASE_TYPE_int16_t:
+            return s8_PARAM_Set_Int16 (enm_param_id, *((int16_t *)pv_value));
+
+        case BASE_TYPE_uint32_t:
+            return s8_PARAM_Set_Uint32 (enm_param_id, *((uint32_t *)pv_value));
+
+        case BASE_TYPE_int32_t:
+            return s8_PARAM_Set_Int32 (enm_param_id, *((int32_t *)pv_value));
+
+        case BASE_TYPE_uint64_t:
+            return s8_PARAM_Set_Uint64 (enm_param_id, *((uint64_t *)pv_value));
+
+        case BASE_TYPE_int64_t:
+            return s8_PARAM_Set_Int64 (enm_param_id, *((int64_t *)pv_value));
+
+        case BASE_TYPE_string:
+            return s8_PARAM_Set_String (enm_param_id, (char *)pv_value);
+
+        case BASE_TYPE_blob:
+            return s8_PARAM_Set_Blob (enm_param_id, pv_value, u16_len);
     }
 
+    LOGE ("Unsupported type");
+    return PARAM_ERR;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Borrows value of a parameter from RAM cache, without copying it
+**
+** @details
+**      RAM cache is held for reading until v_PARAM_Release() is called, the parameters can't be changed meanwhile.
+**      Several parameters can be borrowed at once, v_PARAM_Release() must then be called once for each of them.
+**
+** @note
+**      The borrowing task MUST NOT change any parameters before releasing them, and should release them shortly.
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ppv_value: Pointer to the cached value of the parameter
+**
+** @param [out]
+**      pu16_len: Length in bytes of the parameter's value (including NUL-terminator of a string value)
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Borrow_Value (PARAM_id_t enm_param_id, const void ** ppv_value, uint16_t * pu16_len)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppv_value != NULL) && (pu16_len != NULL));
+
+    /* Hold RAM cache until the parameter is released */
+    v_PARAM_Lock_Read ();
+    *ppv_value = pstru_param->pv_cache;
+    *pu16_len = pstru_param->u16_cache_len;
+
     return PARAM_OK;
 }
 
@@ -1005,16 +1245,48 @@ int8_t s8_PARAM_Set_String (PARAM_id_t enm_param_id, const char * pstri_value)
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of a blob parameter (variable length binary data)
+**      Borrows value of a string parameter from RAM cache, without copying it
 **
 ** @note
-**      The caller MUST free the memory pointed by ppu8_value after using it.
+**      The caller MUST call v_PARAM_Release() after using the value, see s8_PARAM_Borrow_Value().
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [out]
-**      ppu8_value: Pointer to the allocated memory containing parameter's value. The value is NULL in case of failure
+**      ppstri_value: Pointer to the cached value of the parameter (NULL-terminated string)
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Borrow_String (PARAM_id_t enm_param_id, const char ** ppstri_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    uint16_t u16_len;
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppstri_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_string);
+
+    return s8_PARAM_Borrow_Value (enm_param_id, (const void **)ppstri_value, &u16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Borrows value of a blob parameter from RAM cache, without copying it
+**
+** @note
+**      The caller MUST call v_PARAM_Release() after using the value, see s8_PARAM_Borrow_Value().
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ppu8_value: Pointer to the cached value of the parameter
 **
 ** @param [out]
 **      pu16_len: Length in bytes of the parameter's value
@@ -1025,83 +1297,624 @@ int8_t s8_PARAM_Set_String (PARAM_id_t enm_param_id, const char * pstri_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Blob (PARAM_id_t enm_param_id, uint8_t ** ppu8_value, uint16_t * pu16_len)
+int8_t s8_PARAM_Borrow_Blob (PARAM_id_t enm_param_id, const uint8_t ** ppu8_value, uint16_t * pu16_len)
 {
-    esp_err_t       x_err = ESP_OK;
-    bool            b_success = true;
-    uint8_t *       pu8_param_value = NULL;
-    size_t          x_param_size = 0;
-    PARAM_info_t *  pstru_param = &g_astru_params[enm_param_id];
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
     ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppu8_value != NULL) && (pu16_len != NULL));
     ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_blob);
 
-    /* Get length in bytes of parameter value */
-    if (b_success)
-    {
-        x_err = nvs_get_blob (g_x_handle, pstru_param->pstri_key, NULL, &x_param_size);
-        if (x_err != ESP_OK)
-        {
-            LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-            b_success = false;
-        }
-    }
+    return s8_PARAM_Borrow_Value (enm_param_id, (const void **)ppu8_value, pu16_len);
+}
 
-    /* Allocate dynamic memory to store parameter value */
-    if (b_success)
-    {
-        *pu16_len = x_param_size;
-        pu8_param_value = malloc (x_param_size);
-        if (pu8_param_value == NULL)
-        {
-            LOGE ("Failed to allocate memory for param %s", pstru_param->pstri_key);
-            b_success = false;
-        }
-    }
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases a parameter borrowed by s8_PARAM_Borrow_Value(), s8_PARAM_Borrow_String() or s8_PARAM_Borrow_Blob()
+**
+** @return
+**      None
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+void v_PARAM_Release (void)
+{
+    ASSERT_PARAM (g_b_initialized && (g_u16_num_readers > 0));
 
-    /* Get blob value of the parameter */
-    if (b_success)
-    {
-        x_err = nvs_get_blob (g_x_handle, pstru_param->pstri_key, pu8_param_value, &x_param_size);
-        if (x_err != ESP_OK)
-        {
-            LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-            b_success = false;
-        }
-    }
+    /* Let the parameters be changed once all of them have been released */
+    v_PARAM_Unlock_Read ();
+}
 
-    /* Done */
-    if (b_success)
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an unmanaged string parameter
+**
+** @note
+**      The caller MUST free the memory pointed by ppstri_value after using it.
+**
+** @param [in]
+**      pstri_key: Key identifying the parameter
+**
+** @param [out]
+**      ppstri_value: Pointer to the allocated memory containing parameter's value (NULL-terminated string)
+**                    Value is NULL in case of failure
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_String_Unmanaged (const char * pstri_key, char ** ppstri_value)
+{
+    esp_err_t   x_err = ESP_OK;
+    bool        b_success = true;
+    char *      pstri_param_value = NULL;
+    size_t      x_param_size = 0;
+
+    ASSERT_PARAM (g_b_initialized && (pstri_key != NULL) && (ppstri_value != NULL));
+
+    /* Get length in bytes of parameter value */
+    if (b_success)
+    {
+        x_err = nvs_get_str (g_x_handle, pstri_key, NULL, &x_param_size);
+        if (x_err != ESP_OK)
+        {
+            LOGE ("Failed to access param \"%s\" (%s)", pstri_key, esp_err_to_name (x_err));
+            b_success = false;
+        }
+    }
+
+    /* Allocate dynamic memory to store parameter value */
+    if (b_success)
+    {
+        pstri_param_value = malloc (x_param_size);
+        if (pstri_param_value == NULL)
+        {
+            LOGE ("Failed to allocate memory for param %s", pstri_key);
+            b_success = false;
+        }
+    }
+
+    /* Get NULL-terminated string value of the parameter */
+    if (b_success)
+    {
+        x_err = nvs_get_str (g_x_handle, pstri_key, pstri_param_value, &x_param_size);
+        if (x_err != ESP_OK)
+        {
+            LOGE ("Failed to access param %s (%s)", pstri_key, esp_err_to_name (x_err));
+            b_success = false;
+        }
+    }
+
+    /* Done */
+    if (b_success)
     {
-        *ppu8_value = pu8_param_value;
+        *ppstri_value = pstri_param_value;
         return PARAM_OK;
     }
     else
     {
         /* Clean up */
-        if (pu8_param_value != NULL)
+        if (pstri_param_value != NULL)
         {
-            free (pu8_param_value);
+            free (pstri_param_value);
         }
-        *ppu8_value = NULL;
+        *ppstri_value = NULL;
+        return PARAM_ERR;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an unmanaged string parameter, if the parameter doesn't exist, it will be created
+**
+** @param [in]
+**      pstri_key: Key identifying the parameter
+**
+** @param [in]
+**      pstri_value: Parameter's value (NULL-terminated string)
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_String_Unmanaged (const char * pstri_key, const char * pstri_value)
+{
+    ASSERT_PARAM (g_b_initialized && (pstri_key != NULL) && (pstri_value != NULL));
+
+    /* Write value to the parameter value */
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+    esp_err_t x_err = nvs_set_str (g_x_handle, pstri_key, pstri_value);
+    if (x_err == ESP_OK)
+    {
+        /* The change is committed by Srvc_Param task, along with other changes */
+        g_b_commit_pending = true;
+        xSemaphoreGive (g_x_commit_sem);
+    }
+    xSemaphoreGive (g_x_write_mutex);
+
+    if (x_err != ESP_OK)
+    {
+        LOGE ("Failed to change value of param %s (%s)", pstri_key, esp_err_to_name (x_err));
         return PARAM_ERR;
     }
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of a string parameter
+**
+** @note
+**      The caller MUST free the memory pointed by ppstri_value after using it.
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ppstri_value: Pointer to the allocated memory containing parameter's value (NULL-terminated string)
+**                    Value is NULL in case of failure
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_String (PARAM_id_t enm_param_id, char ** ppstri_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    uint16_t u16_len;
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppstri_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_string);
+
+    /* Get a copy of NULL-terminated string value of the parameter */
+    return s8_PARAM_Get_Value (enm_param_id, (void **)ppstri_value, &u16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of a string parameter, if the parameter doesn't exist, it will be created
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      pstri_value: Parameter's value (NULL-terminated string)
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_String (PARAM_id_t enm_param_id, const char * pstri_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pstri_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_string);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, pstri_value, strlen (pstri_value) + 1);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of a blob parameter (variable length binary data)
+**
+** @note
+**      The caller MUST free the memory pointed by ppu8_value after using it.
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ppu8_value: Pointer to the allocated memory containing parameter's value. The value is NULL in case of failure
+**
+** @param [out]
+**      pu16_len: Length in bytes of the parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Blob (PARAM_id_t enm_param_id, uint8_t ** ppu8_value, uint16_t * pu16_len)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ppu8_value != NULL) && (pu16_len != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_blob);
+
+    /* Get a copy of blob value of the parameter */
+    return s8_PARAM_Get_Value (enm_param_id, (void **)ppu8_value, pu16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of a blob parameter (variable length binary data)
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      pv_value: Buffer storing parameter's value
+**
+** @param [in]
+**      u16_len: Length in bytes of the parameter
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Blob (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pv_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_blob);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, pv_value, u16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an int8_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ps8_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Int8 (PARAM_id_t enm_param_id, int8_t * ps8_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps8_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int8_t);
+
+    /* Get int8_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, ps8_value);
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an int8_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      s8_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Int8 (PARAM_id_t enm_param_id, int8_t s8_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int8_t);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &s8_value, sizeof (s8_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an uint8_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      pu8_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Uint8 (PARAM_id_t enm_param_id, uint8_t * pu8_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu8_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint8_t);
+
+    /* Get uint8_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, pu8_value);
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an uint8_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      u8_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Uint8 (PARAM_id_t enm_param_id, uint8_t u8_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint8_t);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &u8_value, sizeof (u8_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an int16_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ps16_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Int16 (PARAM_id_t enm_param_id, int16_t * ps16_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps16_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int16_t);
+
+    /* Get int16_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, ps16_value);
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an int16_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      s16_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Int16 (PARAM_id_t enm_param_id, int16_t s16_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int16_t);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &s16_value, sizeof (s16_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an uint16_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      pu16_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Uint16 (PARAM_id_t enm_param_id, uint16_t * pu16_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu16_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint16_t);
+
+    /* Get uint16_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, pu16_value);
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an uint16_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      u16_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Uint16 (PARAM_id_t enm_param_id, uint16_t u16_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint16_t);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &u16_value, sizeof (u16_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an int32_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      ps32_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Int32 (PARAM_id_t enm_param_id, int32_t * ps32_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps32_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int32_t);
+
+    /* Get int32_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, ps32_value);
+    return PARAM_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets value of an int32_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [in]
+**      s32_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Set_Int32 (PARAM_id_t enm_param_id, int32_t s32_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int32_t);
+
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &s32_value, sizeof (s32_value));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets value of an uint32_t parameter
+**
+** @param [in]
+**      enm_param_id: Parameter ID
+**
+** @param [out]
+**      pu32_value: Parameter's value
+**
+** @return
+**      @arg    PARAM_OK
+**      @arg    PARAM_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int8_t s8_PARAM_Get_Uint32 (PARAM_id_t enm_param_id, uint32_t * pu32_value)
+{
+    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu32_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint32_t);
+
+    /* Get uint32_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, pu32_value);
+    return PARAM_OK;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of a blob parameter (variable length binary data)
+**      Sets value of an uint32_t parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      pv_value: Buffer storing parameter's value
-**
-** @param [in]
-**      u16_len: Length in bytes of the parameter
+**      u32_value: Parameter's value
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1109,54 +1922,28 @@ int8_t s8_PARAM_Get_Blob (PARAM_id_t enm_param_id, uint8_t ** ppu8_value, uint16
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Blob (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len)
+int8_t s8_PARAM_Set_Uint32 (PARAM_id_t enm_param_id, uint32_t u32_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pv_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_blob);
-
-    /* Check data length if required */
-    if ((pstru_param->un_min.x_blob != 0) || (pstru_param->un_max.x_blob != 0))
-    {
-        if ((u16_len < pstru_param->un_min.x_blob) || (u16_len > pstru_param->un_max.x_blob))
-        {
-            LOGE ("Data length of param %s (%d bytes) is NOT within the allowed range",
-                  pstru_param->pstri_key, u16_len);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    esp_err_t x_err = nvs_set_blob (g_x_handle, pstru_param->pstri_key, pv_value, u16_len);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint32_t);
 
-    return PARAM_OK;
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &u32_value, sizeof (u32_value));
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an int8_t parameter
+**      Gets value of an int64_t parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [out]
-**      ps8_value: Parameter's value
+**      ps64_value: Parameter's value
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1164,21 +1951,15 @@ int8_t s8_PARAM_Set_Blob (PARAM_id_t enm_param_id, const void * pv_value, uint16
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Int8 (PARAM_id_t enm_param_id, int8_t * ps8_value)
+int8_t s8_PARAM_Get_Int64 (PARAM_id_t enm_param_id, int64_t * ps64_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps8_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int8_t);
-
-    /* Get int8_t value of the parameter */
-    esp_err_t x_err = nvs_get_i8 (g_x_handle, pstru_param->pstri_key, ps8_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps64_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int64_t);
 
+    /* Get int64_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, ps64_value);
     return PARAM_OK;
 }
 
@@ -1186,13 +1967,13 @@ int8_t s8_PARAM_Get_Int8 (PARAM_id_t enm_param_id, int8_t * ps8_value)
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an int8_t parameter
+**      Sets value of an int64_t parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      s8_value: Parameter's value
+**      s64_value: Parameter's value
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1200,61 +1981,28 @@ int8_t s8_PARAM_Get_Int8 (PARAM_id_t enm_param_id, int8_t * ps8_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Int8 (PARAM_id_t enm_param_id, int8_t s8_value)
+int8_t s8_PARAM_Set_Int64 (PARAM_id_t enm_param_id, int64_t s64_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
     ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int8_t);
-
-    /* Check if new value is different than the current value */
-    int8_t s8_current;
-    esp_err_t x_err = nvs_get_i8 (g_x_handle, pstru_param->pstri_key, &s8_current);
-    if ((x_err == ESP_OK) && (s8_current == s8_value))
-    {
-        return PARAM_OK;
-    }
-
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_int8_t != 0) || (pstru_param->un_max.x_int8_t != 0))
-    {
-        if ((s8_value < pstru_param->un_min.x_int8_t) || (s8_value > pstru_param->un_max.x_int8_t))
-        {
-            LOGE ("Value of param %s (%d) is NOT within the allowed range", pstru_param->pstri_key, s8_value);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_i8 (g_x_handle, pstru_param->pstri_key, s8_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int64_t);
 
-    return PARAM_OK;
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &s64_value, sizeof (s64_value));
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an uint8_t parameter
+**      Gets value of an uint64_t parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [out]
-**      pu8_value: Parameter's value
+**      pu64_value: Parameter's value
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1262,21 +2010,15 @@ int8_t s8_PARAM_Set_Int8 (PARAM_id_t enm_param_id, int8_t s8_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Uint8 (PARAM_id_t enm_param_id, uint8_t * pu8_value)
+int8_t s8_PARAM_Get_Uint64 (PARAM_id_t enm_param_id, uint64_t * pu64_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu8_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint8_t);
-
-    /* Get uint8_t value of the parameter */
-    esp_err_t x_err = nvs_get_u8 (g_x_handle, pstru_param->pstri_key, pu8_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu64_value != NULL));
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint64_t);
 
+    /* Get uint64_t value of the parameter from RAM cache */
+    v_PARAM_Read_Cache (enm_param_id, pu64_value);
     return PARAM_OK;
 }
 
@@ -1284,13 +2026,13 @@ int8_t s8_PARAM_Get_Uint8 (PARAM_id_t enm_param_id, uint8_t * pu8_value)
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an uint8_t parameter
+**      Sets value of an uint64_t parameter
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      u8_value: Parameter's value
+**      u64_value: Parameter's value
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1298,195 +2040,234 @@ int8_t s8_PARAM_Get_Uint8 (PARAM_id_t enm_param_id, uint8_t * pu8_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Uint8 (PARAM_id_t enm_param_id, uint8_t u8_value)
+int8_t s8_PARAM_Set_Uint64 (PARAM_id_t enm_param_id, uint64_t u64_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
     ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint8_t);
-
-    /* Check if new value is different than the current value */
-    uint8_t u8_current;
-    esp_err_t x_err = nvs_get_u8 (g_x_handle, pstru_param->pstri_key, &u8_current);
-    if ((x_err == ESP_OK) && (u8_current == u8_value))
-    {
-        return PARAM_OK;
-    }
-
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_uint8_t != 0) || (pstru_param->un_max.x_uint8_t != 0))
-    {
-        if ((u8_value < pstru_param->un_min.x_uint8_t) || (u8_value > pstru_param->un_max.x_uint8_t))
-        {
-            LOGE ("Value of param %s (%u) is NOT within the allowed range", pstru_param->pstri_key, u8_value);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_u8 (g_x_handle, pstru_param->pstri_key, u8_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint64_t);
 
-    return PARAM_OK;
+    /* Validate and write value of the parameter to non-volatile storage and RAM cache */
+    return s8_PARAM_Write (enm_param_id, &u64_value, sizeof (u64_value));
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an int16_t parameter
+**      Checks if a value is valid for a parameter
+**
+** @details
+**      The value must fit in RAM cache of the parameter, and be within min and max range of the parameter if the range
+**      is enabled. For a string parameter, the range applies to the string length excluding NUL-terminator.
 **
 ** @param [in]
-**      enm_param_id: Parameter ID
+**      pstru_param: Information of the parameter
 **
-** @param [out]
-**      ps16_value: Parameter's value
+** @param [in]
+**      pv_value: Buffer storing the value
+**
+** @param [in]
+**      u16_len: Length in bytes of the value (including NUL-terminator of a string value)
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      @arg    true: The value is valid
+**      @arg    false: The value is invalid
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Int16 (PARAM_id_t enm_param_id, int16_t * ps16_value)
+static bool b_PARAM_Is_Valid (const PARAM_info_t * pstru_param, const void * pv_value, uint16_t u16_len)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps16_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int16_t);
+    /* The value must fit in RAM cache */
+    if (u16_len > pstru_param->u16_cache_size)
+    {
+        return false;
+    }
 
-    /* Get int16_t value of the parameter */
-    esp_err_t x_err = nvs_get_i16 (g_x_handle, pstru_param->pstri_key, ps16_value);
-    if (x_err != ESP_OK)
+    switch (pstru_param->enm_base_type)
     {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
+        case BASE_TYPE_uint8_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, uint8_t, *((const uint8_t *)pv_value));
+
+        case BASE_TYPE_int8_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, int8_t, *((const int8_t *)pv_value));
+
+        case BASE_TYPE_uint16_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, uint16_t, *((const uint16_t *)pv_value));
+
+        case BASE_TYPE_int16_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, int16_t, *((const int16_t *)pv_value));
+
+        case BASE_TYPE_uint32_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, uint32_t, *((const uint32_t *)pv_value));
+
+        case BASE_TYPE_int32_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, int32_t, *((const int32_t *)pv_value));
+
+        case BASE_TYPE_uint64_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, uint64_t, *((const uint64_t *)pv_value));
+
+        case BASE_TYPE_int64_t:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, int64_t, *((const int64_t *)pv_value));
+
+        case BASE_TYPE_string:
+            return ((u16_len > 0) && (strnlen (pv_value, u16_len) == u16_len - 1) &&
+                    PARAM_IS_WITHIN_RANGE (pstru_param, string, u16_len - 1));
+
+        case BASE_TYPE_blob:
+            return PARAM_IS_WITHIN_RANGE (pstru_param, blob, u16_len);
     }
 
-    return PARAM_OK;
+    return false;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an int16_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
+**      Loads value of a parameter from non-volatile storage into its RAM cache
 **
 ** @param [in]
-**      s16_value: Parameter's value
+**      pstru_param: Information of the parameter
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      @arg    ESP_OK
+**      @arg    Other error code of NVS component
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Int16 (PARAM_id_t enm_param_id, int16_t s16_value)
+static esp_err_t x_PARAM_Load (PARAM_info_t * pstru_param)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int16_t);
+    esp_err_t   x_err = ESP_OK;
+    size_t      x_param_size = pstru_param->u16_cache_size;
 
-    /* Check if new value is different than the current value */
-    int16_t s16_current;
-    esp_err_t x_err = nvs_get_i16 (g_x_handle, pstru_param->pstri_key, &s16_current);
-    if ((x_err == ESP_OK) && (s16_current == s16_value))
+    switch (pstru_param->enm_base_type)
     {
-        return PARAM_OK;
-    }
+        case BASE_TYPE_uint8_t:
+            x_err = nvs_get_u8 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
 
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_int16_t != 0) || (pstru_param->un_max.x_int16_t != 0))
-    {
-        if ((s16_value < pstru_param->un_min.x_int16_t) || (s16_value > pstru_param->un_max.x_int16_t))
-        {
-            LOGE ("Value of param %s (%d) is NOT within the allowed range", pstru_param->pstri_key, s16_value);
-            return PARAM_ERR;
-        }
-    }
+        case BASE_TYPE_int8_t:
+            x_err = nvs_get_i8 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
 
-    /* Write value to the parameter value */
-    x_err = nvs_set_i16 (g_x_handle, pstru_param->pstri_key, s16_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+        case BASE_TYPE_uint16_t:
+            x_err = nvs_get_u16 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
 
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
+        case BASE_TYPE_int16_t:
+            x_err = nvs_get_i16 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
+
+        case BASE_TYPE_uint32_t:
+            x_err = nvs_get_u32 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
+
+        case BASE_TYPE_int32_t:
+            x_err = nvs_get_i32 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
+
+        case BASE_TYPE_uint64_t:
+            x_err = nvs_get_u64 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
+
+        case BASE_TYPE_int64_t:
+            x_err = nvs_get_i64 (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache);
+            break;
+
+        case BASE_TYPE_string:
+            x_err = nvs_get_str (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache, &x_param_size);
+            break;
+
+        case BASE_TYPE_blob:
+            x_err = nvs_get_blob (g_x_handle, pstru_param->pstri_key, pstru_param->pv_cache, &x_param_size);
+            break;
     }
 
-    return PARAM_OK;
+    pstru_param->u16_cache_len = (x_err == ESP_OK) ? x_param_size : 0;
+    return x_err;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an uint16_t parameter
+**      Writes value of a parameter to non-volatile storage, without committing it
 **
 ** @param [in]
-**      enm_param_id: Parameter ID
+**      pstru_param: Information of the parameter
 **
-** @param [out]
-**      pu16_value: Parameter's value
+** @param [in]
+**      pv_value: Buffer storing the value
+**
+** @param [in]
+**      u16_len: Length in bytes of the value (including NUL-terminator of a string value)
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      @arg    ESP_OK
+**      @arg    Other error code of NVS component
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Uint16 (PARAM_id_t enm_param_id, uint16_t * pu16_value)
+static esp_err_t x_PARAM_Store (const PARAM_info_t * pstru_param, const void * pv_value, uint16_t u16_len)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    switch (pstru_param->enm_base_type)
+    {
+        case BASE_TYPE_uint8_t:
+            return nvs_set_u8 (g_x_handle, pstru_param->pstri_key, *((const uint8_t *)pv_value));
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu16_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint16_t);
+        case BASE_TYPE_int8_t:
+            return nvs_set_i8 (g_x_handle, pstru_param->pstri_key, *((const int8_t *)pv_value));
+
+        case BASE_TYPE_uint16_t:
+            return nvs_set_u16 (g_x_handle, pstru_param->pstri_key, *((const uint16_t *)pv_value));
+
+        case BASE_TYPE_int16_t:
+            return nvs_set_i16 (g_x_handle, pstru_param->pstri_key, *((const int16_t *)pv_value));
+
+        case BASE_TYPE_uint32_t:
+            return nvs_set_u32 (g_x_handle, pstru_param->pstri_key, *((const uint32_t *)pv_value));
+
+        case BASE_TYPE_int32_t:
+            return nvs_set_i32 (g_x_handle, pstru_param->pstri_key, *((const int32_t *)pv_value));
+
+        case BASE_TYPE_uint64_t:
+            return nvs_set_u64 (g_x_handle, pstru_param->pstri_key, *((const uint64_t *)pv_value));
+
+        case BASE_TYPE_int64_t:
+            return nvs_set_i64 (g_x_handle, pstru_param->pstri_key, *((const int64_t *)pv_value));
+
+        case BASE_TYPE_string:
+            return nvs_set_str (g_x_handle, pstru_param->pstri_key, (const char *)pv_value);
 
-    /* Get uint16_t value of the parameter */
-    esp_err_t x_err = nvs_get_u16 (g_x_handle, pstru_param->pstri_key, pu16_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
+        case BASE_TYPE_blob:
+            return nvs_set_blob (g_x_handle, pstru_param->pstri_key, pv_value, u16_len);
     }
 
-    return PARAM_OK;
+    return ESP_ERR_NOT_SUPPORTED;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an uint16_t parameter
+**      Validates and changes value of a parameter in non-volatile storage and RAM cache
+**
+** @details
+**      If the calling task has begun a transaction, the value is only staged until the transaction is committed.
+**      Otherwise, if the parameter must be committed immediately, the value is written and committed to non-volatile
+**      storage first and RAM cache is only updated if that succeeds. Otherwise, RAM cache is updated and the parameter
+**      is marked dirty, Srvc_Param task writes it later. The subscribers are then notified of the change. Nothing is
+**      written if the value is unchanged.
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      u16_value: Parameter's value
+**      pv_value: Buffer storing the value
+**
+** @param [in]
+**      u16_len: Length in bytes of the value (including NUL-terminator of a string value)
 **
 ** @return
 **      @arg    PARAM_OK
@@ -1494,440 +2275,299 @@ int8_t s8_PARAM_Get_Uint16 (PARAM_id_t enm_param_id, uint16_t * pu16_value)
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Uint16 (PARAM_id_t enm_param_id, uint16_t u16_value)
+static int8_t s8_PARAM_Write (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint16_t);
+    PARAM_info_t *  pstru_param = &g_astru_params[enm_param_id];
+    int8_t          s8_result = PARAM_OK;
 
-    /* Check if new value is different than the current value */
-    uint16_t u16_current;
-    esp_err_t x_err = nvs_get_u16 (g_x_handle, pstru_param->pstri_key, &u16_current);
-    if ((x_err == ESP_OK) && (u16_current == u16_value))
+    /* Only one change at a time. Because only the writer changes RAM cache, it can be compared without locking it */
+    xSemaphoreTake (g_x_write_mutex, portMAX_DELAY);
+    if (!b_PARAM_Is_Valid (pstru_param, pv_value, u16_len))
     {
-        return PARAM_OK;
-    }
+        LOGE ("Value of param %s (%d bytes) is NOT within the allowed range", pstru_param->pstri_key, u16_len);
+        s8_result = PARAM_ERR;
 
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_uint16_t != 0) || (pstru_param->un_max.x_uint16_t != 0))
-    {
-        if ((u16_value < pstru_param->un_min.x_uint16_t) || (u16_value > pstru_param->un_max.x_uint16_t))
+        /* The transaction in progress can't be committed any more */
+        if (b_PARAM_Is_In_Transaction ())
         {
-            LOGE ("Value of param %s (%u) is NOT within the allowed range", pstru_param->pstri_key, u16_value);
-            return PARAM_ERR;
+            g_b_trans_failed = true;
         }
     }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_u16 (g_x_handle, pstru_param->pstri_key, u16_value);
-    if (x_err != ESP_OK)
+    else if (b_PARAM_Is_In_Transaction ())
     {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
+        /* Stage the change, it is persisted when the transaction is committed */
+        memcpy (pstru_param->pv_stage, pv_value, u16_len);
+        pstru_param->u16_stage_len = u16_len;
+        pstru_param->b_staged = true;
     }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
+    else if ((u16_len != pstru_param->u16_cache_len) || (memcmp (pv_value, pstru_param->pv_cache, u16_len) != 0))
     {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
+        /* Persist the change right away if required */
+        if (pstru_param->enm_commit == PARAM_COMMIT_IMMEDIATE)
+        {
+            /* Write value to the parameter value */
+            esp_err_t x_err = x_PARAM_Store (pstru_param, pv_value, u16_len);
+            if (x_err != ESP_OK)
+            {
+                LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
+                s8_result = PARAM_ERR;
+            }
+
+            /* Commit the change to non-volatile storage */
+            if (s8_result == PARAM_OK)
+            {
+                x_err = nvs_commit (g_x_handle);
+                if (x_err != ESP_OK)
+                {
+                    LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
+                    s8_result = PARAM_ERR;
+                }
+            }
+        }
+
+        /* Update RAM cache once the change has been persisted or scheduled */
+        if (s8_result == PARAM_OK)
+        {
+            uint16_t u16_old_len = pstru_param->u16_cache_len;
+            memcpy (&g_un_old_value, pstru_param->pv_cache, u16_old_len);
+
+            xSemaphoreTake (g_x_cache_sem, portMAX_DELAY);
+            memcpy (pstru_param->pv_cache, pv_value, u16_len);
+            pstru_param->u16_cache_len = u16_len;
+            xSemaphoreGive (g_x_cache_sem);
+
+            /* Let Srvc_Param task write a deferred change once the parameters stop changing */
+            if (pstru_param->enm_commit == PARAM_COMMIT_DEFERRED)
+            {
+                pstru_param->b_dirty = true;
+                xSemaphoreGive (g_x_commit_sem);
+            }
+
+            /* Notify the subscribers */
+            v_PARAM_Notify (enm_param_id, &g_un_old_value, u16_old_len);
+        }
     }
+    xSemaphoreGive (g_x_write_mutex);
 
-    return PARAM_OK;
+    return s8_result;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an int32_t parameter
+**      Copies value of a fixed size parameter from RAM cache
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [out]
-**      ps32_value: Parameter's value
+**      pv_value: Buffer receiving the value, its size must be the size of the parameter's type
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Int32 (PARAM_id_t enm_param_id, int32_t * ps32_value)
+static void v_PARAM_Read_Cache (PARAM_id_t enm_param_id, void * pv_value)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps32_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int32_t);
-
-    /* Get int32_t value of the parameter */
-    esp_err_t x_err = nvs_get_i32 (g_x_handle, pstru_param->pstri_key, ps32_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    return PARAM_OK;
+    v_PARAM_Lock_Read ();
+    memcpy (pv_value, pstru_param->pv_cache, pstru_param->u16_cache_len);
+    v_PARAM_Unlock_Read ();
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an int32_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
+**      Holds RAM cache for reading
 **
-** @param [in]
-**      s32_value: Parameter's value
+** @details
+**      Readers don't block each other, the first reader takes the cache semaphore on behalf of all readers so that the
+**      cache can't be updated until the last reader leaves.
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Int32 (PARAM_id_t enm_param_id, int32_t s32_value)
+static void v_PARAM_Lock_Read (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int32_t);
-
-    /* Check if new value is different than the current value */
-    int32_t s32_current;
-    esp_err_t x_err = nvs_get_i32 (g_x_handle, pstru_param->pstri_key, &s32_current);
-    if ((x_err == ESP_OK) && (s32_current == s32_value))
-    {
-        return PARAM_OK;
-    }
-
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_int32_t != 0) || (pstru_param->un_max.x_int32_t != 0))
-    {
-        if ((s32_value < pstru_param->un_min.x_int32_t) || (s32_value > pstru_param->un_max.x_int32_t))
-        {
-            LOGE ("Value of param %s (%d) is NOT within the allowed range", pstru_param->pstri_key, s32_value);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_i32 (g_x_handle, pstru_param->pstri_key, s32_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
+    xSemaphoreTake (g_x_reader_mutex, portMAX_DELAY);
+    if (++g_u16_num_readers == 1)
     {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
+        xSemaphoreTake (g_x_cache_sem, portMAX_DELAY);
     }
-
-    return PARAM_OK;
+    xSemaphoreGive (g_x_reader_mutex);
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an uint32_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
-**
-** @param [out]
-**      pu32_value: Parameter's value
+**      Releases RAM cache held by v_PARAM_Lock_Read()
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Uint32 (PARAM_id_t enm_param_id, uint32_t * pu32_value)
+static void v_PARAM_Unlock_Read (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu32_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint32_t);
-
-    /* Get uint32_t value of the parameter */
-    esp_err_t x_err = nvs_get_u32 (g_x_handle, pstru_param->pstri_key, pu32_value);
-    if (x_err != ESP_OK)
+    xSemaphoreTake (g_x_reader_mutex, portMAX_DELAY);
+    if (--g_u16_num_readers == 0)
     {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
+        xSemaphoreGive (g_x_cache_sem);
     }
-
-    return PARAM_OK;
+    xSemaphoreGive (g_x_reader_mutex);
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an uint32_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
+**      Checks if the calling task has begun the transaction in progress
 **
-** @param [in]
-**      u32_value: Parameter's value
+** @note
+**      The caller must hold g_x_write_mutex
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      @arg    true: The calling task is in a transaction
+**      @arg    false: Otherwise
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Uint32 (PARAM_id_t enm_param_id, uint32_t u32_value)
+static bool b_PARAM_Is_In_Transaction (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint32_t);
-
-    /* Check if new value is different than the current value */
-    uint32_t u32_current;
-    esp_err_t x_err = nvs_get_u32 (g_x_handle, pstru_param->pstri_key, &u32_current);
-    if ((x_err == ESP_OK) && (u32_current == u32_value))
-    {
-        return PARAM_OK;
-    }
-
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_uint32_t != 0) || (pstru_param->un_max.x_uint32_t != 0))
-    {
-        if ((u32_value < pstru_param->un_min.x_uint32_t) || (u32_value > pstru_param->un_max.x_uint32_t))
-        {
-            LOGE ("Value of param %s (%u) is NOT within the allowed range", pstru_param->pstri_key, u32_value);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_u32 (g_x_handle, pstru_param->pstri_key, u32_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    return PARAM_OK;
+    return ((g_x_trans_task != NULL) && (g_x_trans_task == xTaskGetCurrentTaskHandle ()));
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an int64_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
+**      Ends the transaction in progress, discarding all the staged values
 **
-** @param [out]
-**      ps64_value: Parameter's value
+** @note
+**      The caller must hold g_x_write_mutex
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Int64 (PARAM_id_t enm_param_id, int64_t * ps64_value)
+static void v_PARAM_End_Transaction (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (ps64_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int64_t);
-
-    /* Get int64_t value of the parameter */
-    esp_err_t x_err = nvs_get_i64 (g_x_handle, pstru_param->pstri_key, ps64_value);
-    if (x_err != ESP_OK)
+    for (uint16_t u16_id = 0; u16_id < PARAM_NUM_PARAMS; u16_id++)
     {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
+        g_astru_params[u16_id].b_staged = false;
     }
-
-    return PARAM_OK;
+    g_x_trans_task = NULL;
+    g_b_trans_failed = false;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an int64_t parameter
+**      Notifies the subscribers of a change of a parameter
+**
+** @note
+**      The caller must hold g_x_write_mutex, and RAM cache must contain the new value
 **
 ** @param [in]
 **      enm_param_id: Parameter ID
 **
 ** @param [in]
-**      s64_value: Parameter's value
+**      pv_old_value: Buffer storing the previous value
+**
+** @param [in]
+**      u16_old_len: Length in bytes of the previous value
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Int64 (PARAM_id_t enm_param_id, int64_t s64_value)
+static void v_PARAM_Notify (PARAM_id_t enm_param_id, const void * pv_old_value, uint16_t u16_old_len)
 {
     PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_int64_t);
-
-    /* Check if new value is different than the current value */
-    int64_t s64_current;
-    esp_err_t x_err = nvs_get_i64 (g_x_handle, pstru_param->pstri_key, &s64_current);
-    if ((x_err == ESP_OK) && (s64_current == s64_value))
+    PARAM_change_t stru_change =
     {
-        return PARAM_OK;
-    }
+        .enm_param_id   = enm_param_id,
+        .pv_old_value   = pv_old_value,
+        .u16_old_len    = u16_old_len,
+        .pv_new_value   = pstru_param->pv_cache,
+        .u16_new_len    = pstru_param->u16_cache_len,
+    };
 
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_int64_t != 0) || (pstru_param->un_max.x_int64_t != 0))
+    for (uint8_t u8_idx = 0; u8_idx < PARAM_MAX_NUM_SUBSCRIBERS; u8_idx++)
     {
-        if ((s64_value < pstru_param->un_min.x_int64_t) || (s64_value > pstru_param->un_max.x_int64_t))
+        PARAM_subscriber_t * pstru_subscriber = &g_astru_subscribers[u8_idx];
+        if ((pstru_subscriber->pfnc_cb != NULL) && (pstru_subscriber->u64_id_mask & PARAM_MASK (enm_param_id)))
         {
-            LOGE ("Value of param %s (%lld) is NOT within the allowed range", pstru_param->pstri_key, s64_value);
-            return PARAM_ERR;
+            pstru_subscriber->pfnc_cb (&stru_change, pstru_subscriber->pv_arg);
         }
     }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_i64 (g_x_handle, pstru_param->pstri_key, s64_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    return PARAM_OK;
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Gets value of an uint64_t parameter
+**      Task running Srvc_Param module
 **
-** @param [in]
-**      enm_param_id: Parameter ID
+** @details
+**      The task waits for a deferred change, then for the parameters to stop changing for PARAM_COMMIT_QUIESCENCE_MS
+**      (but no longer than PARAM_COMMIT_MAX_DELAY_MS), and commits all the changes at once
 **
-** @param [out]
-**      pu64_value: Parameter's value
+** @param [in]
+**      pv_param: Parameter passed into the task, not used
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Get_Uint64 (PARAM_id_t enm_param_id, uint64_t * pu64_value)
+static void v_PARAM_Main_Task (void * pv_param)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
+    LOGI ("Srvc_Param task started");
 
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS) && (pu64_value != NULL));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint64_t);
-
-    /* Get uint64_t value of the parameter */
-    esp_err_t x_err = nvs_get_u64 (g_x_handle, pstru_param->pstri_key, pu64_value);
-    if (x_err != ESP_OK)
+    /* Endless loop of the task */
+    while (true)
     {
-        LOGE ("Failed to access param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
+        /* Wait for a deferred change */
+        xSemaphoreTake (g_x_commit_sem, portMAX_DELAY);
 
-    return PARAM_OK;
+        /* Wait until the parameters stop changing */
+        TickType_t x_first_change = xTaskGetTickCount ();
+        while (((xTaskGetTickCount () - x_first_change) < pdMS_TO_TICKS (PARAM_COMMIT_MAX_DELAY_MS)) &&
+               (xSemaphoreTake (g_x_commit_sem, pdMS_TO_TICKS (PARAM_COMMIT_QUIESCENCE_MS)) == pdTRUE))
+        {
+        }
+
+        /* Commit all the changes at once */
+        s8_PARAM_Flush ();
+    }
 }
 
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Sets value of an uint64_t parameter
-**
-** @param [in]
-**      enm_param_id: Parameter ID
-**
-** @param [in]
-**      u64_value: Parameter's value
+**      Commits deferred parameter changes before the device restarts
 **
 ** @return
-**      @arg    PARAM_OK
-**      @arg    PARAM_ERR
+**      None
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
-int8_t s8_PARAM_Set_Uint64 (PARAM_id_t enm_param_id, uint64_t u64_value)
+static void v_PARAM_Shutdown_Handler (void)
 {
-    PARAM_info_t * pstru_param = &g_astru_params[enm_param_id];
-
-    ASSERT_PARAM (g_b_initialized && (enm_param_id < PARAM_NUM_PARAMS));
-    ASSERT_PARAM (pstru_param->enm_base_type == BASE_TYPE_uint64_t);
-
-    /* Check if new value is different than the current value */
-    uint64_t u64_current;
-    esp_err_t x_err = nvs_get_u64 (g_x_handle, pstru_param->pstri_key, &u64_current);
-    if ((x_err == ESP_OK) && (u64_current == u64_value))
-    {
-        return PARAM_OK;
-    }
-
-    /* Validate data value if required */
-    if ((pstru_param->un_min.x_uint64_t != 0) || (pstru_param->un_max.x_uint64_t != 0))
-    {
-        if ((u64_value < pstru_param->un_min.x_uint64_t) || (u64_value > pstru_param->un_max.x_uint64_t))
-        {
-            LOGE ("Value of param %s (%llu) is NOT within the allowed range", pstru_param->pstri_key, u64_value);
-            return PARAM_ERR;
-        }
-    }
-
-    /* Write value to the parameter value */
-    x_err = nvs_set_u64 (g_x_handle, pstru_param->pstri_key, u64_value);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to change value of param %s (%s)", pstru_param->pstri_key, esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    /* Commit the change to non-volatile storage */
-    x_err = nvs_commit (g_x_handle);
-    if (x_err != ESP_OK)
-    {
-        LOGE ("Failed to commit parameter change to non-volatile storage (%s)", esp_err_to_name (x_err));
-        return PARAM_ERR;
-    }
-
-    return PARAM_OK;
+    s8_PARAM_Flush ();
 }
 
 /**
@@ -66,6 +66,57 @@ typedef enum
 
 } PARAM_base_type_t;
 
+/** @brief  Mask of a parameter, used to subscribe to changes of several parameters at once */
+#define PARAM_MASK(enm_param_id)    ((uint64_t)1 << (enm_param_id))
+
+/** @brief  Mask of all parameters */
+#define PARAM_MASK_ALL              (UINT64_MAX >> (64 - PARAM_NUM_PARAMS))
+
+/** @brief  Change of a parameter notified to the subscribers */
+typedef struct
+{
+    PARAM_id_t      enm_param_id;           //!< ID of the changed parameter
+    const void *    pv_old_value;           //!< Previous value
+    uint16_t        u16_old_len;            //!< Length in bytes of the previous value
+    const void *    pv_new_value;           //!< New value
+    uint16_t        u16_new_len;            //!< Length in bytes of the new value
+
+} PARAM_change_t;
+
+/**
+** @brief   Callback invoked when a subscribed parameter has changed
+** @note    The callback is invoked in the context of the task changing the parameter. The values are only valid until
+**          the callback returns.
+*/
+typedef void (*PARAM_callback_t) (const PARAM_change_t * pstru_change, void * pv_arg);
+
+/**
+** @brief   Format of a snapshot of parameters
+** @details
+**
+** A snapshot holds the values of all parameters marked as such in param table, so that they can be backed up or copied
+** to another device at once. All numbers are little-endian.
+**
+**      Offset  | Size  | Content
+**    ----------+-------+------------------------------------------------------------------------
+**      0       | 4     | Magic: "PRMS"
+**      4       | 2     | Version of the format: PARAM_SNAPSHOT_VERSION
+**      6       | 2     | Number of records
+**      8       | ...   | Records, each made of:
+**              | 2     |   + PUC of the parameter
+**              | 1     |   + Base type of the parameter (PARAM_base_type_t)
+**              | 2     |   + Length in bytes of the value
+**              | ...   |   + Value: little-endian integer, NUL-terminated string or blob data
+**      ...     | 4     | CRC32 of all the preceding bytes, as computed by crc32_le (0, ...) of ESP-IDF
+**
+** The base types are part of the format, new types must therefore be added at the end of PARAM_base_type_t.
+*/
+#define PARAM_SNAPSHOT_MAGIC                "PRMS"
+#define PARAM_SNAPSHOT_VERSION              1
+#define PARAM_SNAPSHOT_HEADER_SIZE          8
+#define PARAM_SNAPSHOT_RECORD_HEAD_SIZE     5
+#define PARAM_SNAPSHOT_CRC_SIZE             4
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -78,6 +129,30 @@ extern int8_t s8_PARAM_Init (void);
 /* Resets a parameter to its default value */
 extern int8_t s8_PARAM_Reset_Default (PARAM_id_t enm_param_id);
 
+/* Writes and commits all deferred parameter changes to non-volatile storage */
+extern int8_t s8_PARAM_Flush (void);
+
+/* Begins a transaction, the parameters changed by the calling task are then staged until it is committed */
+extern int8_t s8_PARAM_Begin (void);
+
+/* Validates and persists all the values staged in the transaction at once, or none of them */
+extern int8_t s8_PARAM_Commit (void);
+
+/* Aborts the transaction, discarding all the staged values */
+extern int8_t s8_PARAM_Abort (void);
+
+/* Subscribes to changes of parameters */
+extern int8_t s8_PARAM_Subscribe (uint64_t u64_id_mask, PARAM_callback_t pfnc_cb, void * pv_arg);
+
+/*
+** Exports a snapshot of the parameters
+** NOTE: The caller MUST free the memory pointed by ppu8_snapshot after using it.
+*/
+extern int8_t s8_PARAM_Export (uint8_t ** ppu8_snapshot, uint16_t * pu16_len);
+
+/* Imports a snapshot of the parameters, all of its values are changed at once or none of them */
+extern int8_t s8_PARAM_Import (const uint8_t * pu8_snapshot, uint16_t u16_len);
+
 /* Converts Param Unique Code of a parameter to parameter ID */
 extern int8_t s8_PARAM_Convert_PUC_To_ID (uint16_t u16_param_puc, PARAM_id_t * penm_param_id);
 
@@ -96,6 +171,27 @@ extern int8_t s8_PARAM_Get_Value (PARAM_id_t enm_param_id, void ** ppv_value, ui
 /* Generic function to set value of a parameter */
 extern int8_t s8_PARAM_Set_Value (PARAM_id_t enm_param_id, const void * pv_value, uint16_t u16_len);
 
+/*
+** Borrows value of a parameter from RAM cache, without copying it
+** NOTE: The caller MUST call v_PARAM_Release() after using the value, and MUST NOT change any parameters before that.
+*/
+extern int8_t s8_PARAM_Borrow_Value (PARAM_id_t enm_param_id, const void ** ppv_value, uint16_t * pu16_len);
+
+/*
+** Borrows value of a string parameter from RAM cache, without copying it
+** NOTE: The caller MUST call v_PARAM_Release() after using the value, and MUST NOT change any parameters before that.
+*/
+extern int8_t s8_PARAM_Borrow_String (PARAM_id_t enm_param_id, const char ** ppstri_value);
+
+/*
+** Borrows value of a blob parameter from RAM cache, without copying it
+** NOTE: The caller MUST call v_PARAM_Release() after using the value, and MUST NOT change any parameters before that.
+*/
+extern int8_t s8_PARAM_Borrow_Blob (PARAM_id_t enm_param_id, const uint8_t ** ppu8_value, uint16_t * pu16_len);
+
+/* Releases a parameter borrowed from RAM cache */
+extern void v_PARAM_Release (void);
+
 /*
 ** Gets value of an unmanaged string parameter, remember to free the memory pointed by ppstri_value after using it
 ** NOTE: The caller MUST free the memory pointed by ppstri_value after using it.
@@ -53,6 +53,20 @@
 **                    shall disable these limits.
 **                    For parameters of types string and blob, these settings are minimum and maximum length in bytes
 **                    of data stored.
+**                    Values of all parameters are cached in RAM, hence Max length of a string or blob parameter must
+**                    be set as it determines the size of the cache.
+**
+** - Commit         : How a change of a parameter is persisted in non-volatile storage:
+**                      + DEFERRED: The change is applied in RAM right away, and written to non-volatile storage by a
+**                                  background task once the parameters stop changing for a short time, or when
+**                                  s8_PARAM_Flush() is called, or before the device restarts. Several changes are
+**                                  then written at once.
+**                      + IMMEDIATE: The change is written to non-volatile storage before the setter returns. This is
+**                                  intended for parameters which must survive a power loss.
+**
+** - Snapshot       : Whether the parameter is part of the snapshots exported by s8_PARAM_Export() and imported by
+**                    s8_PARAM_Import() (YES or NO). Parameters specific to a device, such as its operating data, should
+**                    not be copied from one device to another.
 **
 ** - Default        : Initialized value of the parameter when it is first created or restored from a corruption.
 **                    Some examples:
@@ -66,20 +80,20 @@
 #define PARAM_TABLE(X)                                                                                                 \
                                                                                                                        \
 /*-------------------------------------------------------------------------------------------------------------------*/\
-/* Param_ID                         PUC         Type        Min         Max         Default                          */\
+/* Param_ID                    PUC         Type        Min         Max         Commit      Snapshot  Default         */\
 /*-------------------------------------------------------------------------------------------------------------------*/\
                                                                                                                        \
 /* Wifi SSID */                                                                                                        \
-X( PARAM_WIFI_SSID,                 0x0000,     string,     0,          33,         "Zimplistic"                         )\
+X( PARAM_WIFI_SSID,            0x0000,     string,     0,          33,         DEFERRED,   YES,      "Zimplistic"     )\
                                                                                                                        \
 /* Wifi password */                                                                                                    \
-X( PARAM_WIFI_PSW,                  0x0001,     string,     0,          65,         "Zimplistic123"                     )\
+X( PARAM_WIFI_PSW,             0x0001,     string,     0,          65,         DEFERRED,   YES,      "Zimplistic123"  )\
                                                                                                                        \
 /* MQTT group that this MQTT client belongs to */                                                                      \
-X( PARAM_MQTT_GROUP_ID,             0x0010,     string,     0,          33,         "default"                         )\
+X( PARAM_MQTT_GROUP_ID,        0x0010,     string,     0,          33,         DEFERRED,   YES,      "default"        )\
                                                                                                                        \
 /* Operating data of cooking script */                                                                                 \
-X( PARAM_COOKING_SCRIPT_DATA,       0x0020,     blob,       0,          256,        {0}                               )\
+X( PARAM_COOKING_SCRIPT_DATA,  0x0020,     blob,       0,          256,        IMMEDIATE,  NO,       {0}              )\
                                                                                                                        \
 /*-------------------------------------------------------------------------------------------------------------------*/
 
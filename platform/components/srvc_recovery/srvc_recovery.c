@@ -319,6 +319,9 @@ void v_RCVR_Backup_Data (void)
         ASSERT_PARAM (s8_PARAM_Set_Blob (PARAM_COOKING_SCRIPT_DATA, g_au8_cache, g_u16_data_len) == PARAM_OK);
     }
 
+    /* Persist deferred changes of other parameters too, in the remaining time */
+    s8_PARAM_Flush ();
+
     /* Done */
     xSemaphoreGive (g_x_mutex);
 }
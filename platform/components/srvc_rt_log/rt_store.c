@@ -0,0 +1,1314 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : rt_store.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 15
+**  @brief      : This file contains the time-series store keeping realtime measurements on LittleFS storage.
+**                srvc_rt_log.c includes this file directly.
+**  @namespace  : RTLOG
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_Rt_Log
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#include <stdio.h>                      /* Use snprintf(), vsnprintf(), sscanf() */
+#include <stdarg.h>                     /* Use variable arguments */
+#include <inttypes.h>                   /* Use PRIu32 */
+#include "freertos/task.h"              /* Use FreeRTOS task */
+#include "freertos/queue.h"             /* Use FreeRTOS queue */
+#include "freertos/semphr.h"            /* Use FreeRTOS mutex */
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Directory of LittleFS storage containing segment files */
+#define RTLOG_STORE_DIR                 LFS_MOUNT_POINT "/rtlog"
+
+/** @brief  Size in bytes of a block, which is the unit of writing to a segment file */
+#define RTLOG_STORE_BLOCK_SIZE          512
+
+/** @brief  Maximum number of blocks in a segment file */
+#define RTLOG_STORE_SEGMENT_BLOCKS      (CONFIG_RTLOG_STORE_SEGMENT_SIZE * 1024 / RTLOG_STORE_BLOCK_SIZE)
+
+/** @brief  Maximum number of segment files. When a new segment is needed, the oldest one is deleted */
+#define RTLOG_STORE_NUM_SEGMENTS        CONFIG_RTLOG_STORE_NUM_SEGMENTS
+
+/** @brief  Number of blocks staged in RAM while waiting to be written onto flash */
+#define RTLOG_STORE_NUM_STAGING_BLOCKS  4
+
+/** @brief  Index indicating that no staging block is available */
+#define RTLOG_STORE_NO_BLOCK            0xFF
+
+/** @brief  Period in milliseconds after which a partially filled block is written onto flash if nothing else is */
+#define RTLOG_STORE_FLUSH_PERIOD_MS     10000
+
+/** @brief  ID of the CPU that the task writing blocks onto flash runs on */
+#define RTLOG_STORE_TASK_CPU_ID         1
+
+/** @brief  Stack size (in bytes) of the task writing blocks onto flash */
+#define RTLOG_STORE_TASK_STACK_SIZE     4096
+
+/** @brief  Priority of the task writing blocks onto flash */
+#define RTLOG_STORE_TASK_PRIORITY       (tskIDLE_PRIORITY + 1)
+
+/**
+** @brief   Layout of a block (all fields are little endian)
+** @details
+**      Offset  Size    Field
+**      0       1       Format version (RTLOG_STORE_VERSION)
+**      1       1       Reserved (0)
+**      2       2       Number of samples in the block
+**      4       2       Length in bytes of the block, including this header
+**      6       2       Reserved (0)
+**      8       4       Timestamp of the first sample
+**      12      4       Timestamp of the last sample
+**      16      ...     Samples, then 0 padding up to RTLOG_STORE_BLOCK_SIZE
+**
+**      Each sample is a sequence of unsigned LEB128 varints:
+**      + Timestamp minus timestamp of the previous sample (of the first sample for the first one)
+**      + Measurement mask
+**      + For each measurement in the mask in ascending order of ID: zigzag-encoded difference between its raw value
+**        and its previous raw value in the block (0 if the measurement is not in any previous sample of the block)
+**
+**      Every block can be decoded on its own. Because all blocks of a segment file have the same size, timestamps in
+**      block headers form an index that range queries binary-search without decoding any sample.
+*/
+#define RTLOG_STORE_VERSION             1
+#define RTLOG_STORE_HDR_LEN             16
+
+/** @brief  Maximum length in bytes of a line of exported CSV file */
+#define RTLOG_STORE_MAX_CSV_LINE_LEN    (12 + RTLOG_NUM_MEAS * 16)
+
+/** @brief  Maximum length in bytes of an encoded sample */
+#define RTLOG_STORE_MAX_SAMPLE_LEN      (5 + 5 + RTLOG_NUM_MEAS * 5)
+
+/** @brief  Block being filled with samples in RAM */
+typedef struct
+{
+    uint8_t     u8_block_idx;                       //!< Index of the staging block, RTLOG_STORE_NO_BLOCK if none
+    uint16_t    u16_num_samples;                    //!< Number of samples in the block
+    uint16_t    u16_len;                            //!< Length in bytes of the block, including header
+    uint32_t    u32_first_timestamp;                //!< Timestamp of the first sample
+    uint32_t    u32_last_timestamp;                 //!< Timestamp of the last sample
+    int32_t     as32_prev_raw[RTLOG_NUM_MEAS];      //!< Previous raw value of each measurement in the block
+
+} RTLOG_active_block_t;
+
+/** @brief  Information of a segment file */
+typedef struct
+{
+    uint32_t    u32_seq;                            //!< Sequence number, which is also the name of the file
+    uint16_t    u16_num_blocks;                     //!< Number of blocks in the file
+    uint32_t    u32_first_timestamp;                //!< Timestamp of the first sample in the file
+    uint32_t    u32_last_timestamp;                 //!< Timestamp of the last sample in the file
+
+} RTLOG_segment_t;
+
+/** @brief  Context of exporting samples to a CSV file */
+typedef struct
+{
+    lfs2_file_t *   px_file;                        //!< The CSV file opened for writing
+    uint32_t        u32_meas_mask;                  //!< Measurements exported as columns of the file
+    char *          pstri_line;                     //!< Buffer of RTLOG_STORE_MAX_CSV_LINE_LEN bytes to print a line
+    bool            b_ok;                           //!< Indicates if all lines have been printed and written
+
+} RTLOG_csv_export_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Indicates if the time-series store has been initialized */
+static bool g_b_store_initialized = false;
+
+/** @brief  Structure that will hold the TCB of the task writing blocks onto flash */
+static StaticTask_t g_x_store_task_buffer;
+
+/** @brief  Buffer that the task writing blocks onto flash will use as its stack */
+static StackType_t g_x_store_task_stack [RTLOG_STORE_TASK_STACK_SIZE];
+
+/** @brief  Blocks staged in RAM */
+static uint8_t g_au8_staging_blocks [RTLOG_STORE_NUM_STAGING_BLOCKS][RTLOG_STORE_BLOCK_SIZE];
+
+/** @brief  Queue of indexes of the staging blocks that are free */
+static QueueHandle_t g_x_free_blocks = NULL;
+
+/** @brief  Queue of indexes of the staging blocks that are ready to be written onto flash */
+static QueueHandle_t g_x_ready_blocks = NULL;
+
+/** @brief  Mutex protecting the block being filled */
+static SemaphoreHandle_t g_x_staging_mutex = NULL;
+
+/**
+** @brief   Mutex serializing accesses to segment files and g_b_storage_ready
+** @note    Each LittleFS call is also serialized with those of other tasks by the lock of LittleFS configuration
+*/
+static SemaphoreHandle_t g_x_storage_mutex = NULL;
+
+/** @brief  Block being filled with samples */
+static RTLOG_active_block_t g_stru_active_block;
+
+/** @brief  Number of samples dropped because no staging block was available */
+static uint32_t g_u32_num_dropped = 0;
+
+/** @brief  Indicates if segment files have been loaded from LittleFS storage */
+static bool g_b_storage_ready = false;
+
+/** @brief  Information of existing segment files, from the oldest to the newest */
+static RTLOG_segment_t g_astru_segments [RTLOG_STORE_NUM_SEGMENTS];
+
+/** @brief  Number of existing segment files */
+static uint8_t g_u8_num_segments = 0;
+
+/** @brief  Segment file being written, which is the newest one in g_astru_segments */
+static lfs2_file_t g_x_segment_file;
+
+/** @brief  Indicates if g_x_segment_file is opened */
+static bool g_b_segment_opened = false;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static void v_RTLOG_Store_Append (const RTLOG_rt_meas_t * pstru_meas);
+static uint16_t u16_RTLOG_Store_Encode_Sample (const RTLOG_rt_meas_t * pstru_meas, uint8_t * pu8_sample);
+static void v_RTLOG_Store_Seal_Block (void);
+static void v_RTLOG_Store_Task (void * pv_param);
+static void v_RTLOG_Store_Write_Ready_Blocks (void);
+static int32_t s32_RTLOG_Store_Write_Block (const uint8_t * pu8_block);
+static int32_t s32_RTLOG_Store_Open_Segment (void);
+static void v_RTLOG_Store_Load_Segments (void);
+static bool b_RTLOG_Store_Read_Header (lfs2_file_t * px_file, uint16_t u16_block, uint8_t * pu8_header);
+static bool b_RTLOG_Store_Query_Segment (const RTLOG_segment_t * pstru_segment, uint32_t u32_start_time,
+                                         uint32_t u32_end_time, uint32_t u32_meas_mask,
+                                         RTLOG_query_cb_t pfnc_cb, void * pv_arg, uint32_t * pu32_num_samples);
+static bool b_RTLOG_Store_Export_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg);
+static bool b_RTLOG_Store_Print_Csv (char * pstri_line, uint16_t * pu16_len, const char * pstri_format, ...);
+static uint8_t u8_RTLOG_Put_Varint (uint8_t * pu8_data, uint32_t u32_value);
+static bool b_RTLOG_Get_Varint (const uint8_t ** ppu8_data, const uint8_t * pu8_end, uint32_t * pu32_value);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Initializes the time-series store of realtime measurements
+**
+** @details
+**      Samples are staged in RAM from now on. Segment files are loaded and written as soon as LittleFS storage is
+**      mounted by MicroPython service.
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int32_t s32_RTLOG_Store_Init (void)
+{
+    /* Do nothing if the store has been initialized */
+    if (g_b_store_initialized)
+    {
+        return STATUS_OK;
+    }
+
+    /* Create queues of staging blocks and the mutexes */
+    g_x_free_blocks = xQueueCreate (RTLOG_STORE_NUM_STAGING_BLOCKS, sizeof (uint8_t));
+    g_x_ready_blocks = xQueueCreate (RTLOG_STORE_NUM_STAGING_BLOCKS, sizeof (uint8_t));
+    g_x_staging_mutex = xSemaphoreCreateMutex ();
+    g_x_storage_mutex = xSemaphoreCreateMutex ();
+    if ((g_x_free_blocks == NULL) || (g_x_ready_blocks == NULL) ||
+        (g_x_staging_mutex == NULL) || (g_x_storage_mutex == NULL))
+    {
+        LOGE ("Failed to create resources of realtime measurement store");
+        return STATUS_ERR;
+    }
+
+    /* All staging blocks are free, the first one is filled first */
+    for (uint8_t u8_block_idx = 1; u8_block_idx < RTLOG_STORE_NUM_STAGING_BLOCKS; u8_block_idx++)
+    {
+        xQueueSend (g_x_free_blocks, &u8_block_idx, 0);
+    }
+    g_stru_active_block.u8_block_idx = 0;
+    g_stru_active_block.u16_num_samples = 0;
+    g_stru_active_block.u16_len = RTLOG_STORE_HDR_LEN;
+    memset (g_stru_active_block.as32_prev_raw, 0, sizeof (g_stru_active_block.as32_prev_raw));
+
+    /* Create task writing the blocks onto flash */
+    xTaskCreateStaticPinnedToCore ( v_RTLOG_Store_Task,         /* Function that implements the task */
+                                    "Srvc_Rt_Log",              /* Text name for the task */
+                                    RTLOG_STORE_TASK_STACK_SIZE,/* Stack size in bytes, not words */
+                                    NULL,                       /* Parameter passed into the task */
+                                    RTLOG_STORE_TASK_PRIORITY,  /* Priority at which the task is created */
+                                    g_x_store_task_stack,       /* Array to use as the task's stack */
+                                    &g_x_store_task_buffer,     /* Variable to hold the task's data structure */
+                                    RTLOG_STORE_TASK_CPU_ID);   /* ID of the CPU that the task runs on */
+
+    g_b_store_initialized = true;
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes the samples staged in RAM onto flash
+**
+** @details
+**      The block being filled is closed even if it is not full, so this function should only be called when the
+**      latest samples must be persisted (for example before a query or a reset).
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR_NOT_INIT: The store or LittleFS storage is not ready
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int32_t s32_RTLOG_Store_Flush (void)
+{
+    if (!g_b_store_initialized)
+    {
+        return STATUS_ERR_NOT_INIT;
+    }
+
+    /* Close the block being filled */
+    xSemaphoreTake (g_x_staging_mutex, portMAX_DELAY);
+    v_RTLOG_Store_Seal_Block ();
+    xSemaphoreGive (g_x_staging_mutex);
+
+    /* Write it and other ready blocks */
+    xSemaphoreTake (g_x_storage_mutex, portMAX_DELAY);
+    bool b_storage_ready = g_b_storage_ready;
+    if (b_storage_ready)
+    {
+        v_RTLOG_Store_Write_Ready_Blocks ();
+    }
+    xSemaphoreGive (g_x_storage_mutex);
+
+    return b_storage_ready ? STATUS_OK : STATUS_ERR_NOT_INIT;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads stored realtime measurements in a time range
+**
+** @details
+**      The samples staged in RAM are written onto flash first, so that the latest samples are included. Samples are
+**      reported in the order they were stored. Only the segments and blocks overlapping the time range are read.
+**
+** @param [in]
+**      u32_start_time: Timestamp in milliseconds of the first sample to read
+**
+** @param [in]
+**      u32_end_time: Timestamp in milliseconds of the last sample to read
+**
+** @param [in]
+**      u32_meas_mask: Measurement ID x is read if bit x is 1. Samples without any of these measurements are skipped
+**
+** @param [in]
+**      pfnc_cb: Function invoked for each sample found, it returns false to stop the query
+**
+** @param [in]
+**      pv_arg: Argument passed to pfnc_cb
+**
+** @param [out]
+**      pu32_num_samples: Number of samples reported to pfnc_cb. NULL if not needed
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR_NOT_INIT: The store or LittleFS storage is not ready
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int32_t s32_RTLOG_Store_Query (uint32_t u32_start_time, uint32_t u32_end_time, uint32_t u32_meas_mask,
+                               RTLOG_query_cb_t pfnc_cb, void * pv_arg, uint32_t * pu32_num_samples)
+{
+    uint32_t u32_num_samples = 0;
+
+    ASSERT_PARAM (pfnc_cb != NULL);
+
+    /* Persist the latest samples */
+    int32_t s32_result = s32_RTLOG_Store_Flush ();
+    if (s32_result != STATUS_OK)
+    {
+        return s32_result;
+    }
+
+    /* Go through the segments overlapping the time range, from the oldest one */
+    xSemaphoreTake (g_x_storage_mutex, portMAX_DELAY);
+    for (uint8_t u8_idx = 0; u8_idx < g_u8_num_segments; u8_idx++)
+    {
+        const RTLOG_segment_t * pstru_segment = &g_astru_segments[u8_idx];
+        if ((pstru_segment->u16_num_blocks == 0) ||
+            (pstru_segment->u32_last_timestamp < u32_start_time) ||
+            (pstru_segment->u32_first_timestamp > u32_end_time))
+        {
+            continue;
+        }
+        if (!b_RTLOG_Store_Query_Segment (pstru_segment, u32_start_time, u32_end_time, u32_meas_mask,
+                                          pfnc_cb, pv_arg, &u32_num_samples))
+        {
+            break;
+        }
+    }
+    xSemaphoreGive (g_x_storage_mutex);
+
+    if (pu32_num_samples != NULL)
+    {
+        *pu32_num_samples = u32_num_samples;
+    }
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Exports stored realtime measurements in a time range to a CSV file
+**
+** @details
+**      The first line of the file contains "Timestamp" and the names of the exported measurements. Each following line
+**      is a sample, a value is empty if the measurement is not available in the sample.
+**
+** @param [in]
+**      pstri_file_path: Path of the CSV file on LittleFS storage, it is overwritten if existing
+**
+** @param [in]
+**      u32_start_time, u32_end_time, u32_meas_mask: See s32_RTLOG_Store_Query()
+**
+** @param [out]
+**      pu32_num_samples: Number of samples exported. NULL if not needed
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**      @arg    STATUS_ERR_NOT_INIT: The store or LittleFS storage is not ready
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+int32_t s32_RTLOG_Store_Export (const char * pstri_file_path, uint32_t u32_start_time, uint32_t u32_end_time,
+                                uint32_t u32_meas_mask, uint32_t * pu32_num_samples)
+{
+    lfs2_file_t         x_file;
+    RTLOG_csv_export_t  stru_export;
+    uint16_t            u16_len;
+
+    if (!g_b_store_initialized)
+    {
+        return STATUS_ERR_NOT_INIT;
+    }
+    xSemaphoreTake (g_x_storage_mutex, portMAX_DELAY);
+    bool b_storage_ready = g_b_storage_ready;
+    xSemaphoreGive (g_x_storage_mutex);
+    if (!b_storage_ready)
+    {
+        return STATUS_ERR_NOT_INIT;
+    }
+
+    /* Only defined measurements are exported */
+    u32_meas_mask &= RTLOG_DEFINED_MEAS_MASK;
+    stru_export.px_file = &x_file;
+    stru_export.u32_meas_mask = u32_meas_mask;
+    stru_export.pstri_line = malloc (RTLOG_STORE_MAX_CSV_LINE_LEN);
+    if (stru_export.pstri_line == NULL)
+    {
+        LOGE ("Failed to allocate buffer to export realtime measurements");
+        return STATUS_ERR;
+    }
+    if (lfs2_file_open (g_px_lfs2, &x_file, pstri_file_path, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
+    {
+        LOGE ("Failed to create file %s", pstri_file_path);
+        free (stru_export.pstri_line);
+        return STATUS_ERR;
+    }
+
+    /* Header line */
+    u16_len = 0;
+    stru_export.b_ok = b_RTLOG_Store_Print_Csv (stru_export.pstri_line, &u16_len, "Timestamp");
+    while ((u32_meas_mask != 0) && stru_export.b_ok)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+        stru_export.b_ok = b_RTLOG_Store_Print_Csv (stru_export.pstri_line, &u16_len, ",%s",
+                                                    g_astru_meas_descs[u8_meas_id].pstri_name);
+    }
+    stru_export.b_ok = stru_export.b_ok && b_RTLOG_Store_Print_Csv (stru_export.pstri_line, &u16_len, "\n") &&
+                       (lfs2_file_write (g_px_lfs2, &x_file, stru_export.pstri_line, u16_len) == u16_len);
+
+    /* A line for each sample */
+    int32_t s32_result = STATUS_ERR;
+    if (stru_export.b_ok)
+    {
+        s32_result = s32_RTLOG_Store_Query (u32_start_time, u32_end_time, stru_export.u32_meas_mask,
+                                            b_RTLOG_Store_Export_Sample, &stru_export, pu32_num_samples);
+    }
+    if ((lfs2_file_close (g_px_lfs2, &x_file) < 0) || !stru_export.b_ok)
+    {
+        LOGE ("Failed to write file %s", pstri_file_path);
+        s32_result = STATUS_ERR;
+    }
+    if (s32_result != STATUS_OK)
+    {
+        lfs2_remove (g_px_lfs2, pstri_file_path);
+    }
+
+    free (stru_export.pstri_line);
+    return s32_result;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends a sample of realtime measurements to the block being filled
+**
+** @details
+**      This function is invoked for every realtime measurement message, so it never waits for flash. If the block is
+**      full, it is handed over to the store task and a free staging block is used. If there is no free staging block
+**      because flash is too slow, the sample is dropped.
+**
+** @param [in]
+**      pstru_meas: The sample to append
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Store_Append (const RTLOG_rt_meas_t * pstru_meas)
+{
+    RTLOG_active_block_t *  pstru_block = &g_stru_active_block;
+    uint8_t                 au8_sample[RTLOG_STORE_MAX_SAMPLE_LEN];
+
+    if (!g_b_store_initialized)
+    {
+        return;
+    }
+
+    /* The block is being closed by another task, don't wait for it */
+    if (xSemaphoreTake (g_x_staging_mutex, 0) != pdTRUE)
+    {
+        g_u32_num_dropped++;
+        return;
+    }
+
+    /* Timestamp going backwards (slave board restarted) breaks delta encoding, start a new block */
+    if ((pstru_block->u16_num_samples != 0) && (pstru_meas->u32_timestamp < pstru_block->u32_last_timestamp))
+    {
+        v_RTLOG_Store_Seal_Block ();
+    }
+
+    /* Get a free block if there is none */
+    if (pstru_block->u8_block_idx == RTLOG_STORE_NO_BLOCK)
+    {
+        v_RTLOG_Store_Seal_Block ();
+    }
+
+    if (pstru_block->u8_block_idx != RTLOG_STORE_NO_BLOCK)
+    {
+        /* Encode the sample, start a new block if it doesn't fit in the current one */
+        uint16_t u16_sample_len = u16_RTLOG_Store_Encode_Sample (pstru_meas, au8_sample);
+        if (pstru_block->u16_len + u16_sample_len > RTLOG_STORE_BLOCK_SIZE)
+        {
+            v_RTLOG_Store_Seal_Block ();
+            if (pstru_block->u8_block_idx != RTLOG_STORE_NO_BLOCK)
+            {
+                u16_sample_len = u16_RTLOG_Store_Encode_Sample (pstru_meas, au8_sample);
+            }
+        }
+
+        /* Append the sample and keep the raw values as reference of the next sample */
+        if (pstru_block->u8_block_idx != RTLOG_STORE_NO_BLOCK)
+        {
+            uint32_t u32_meas_mask = pstru_meas->u32_meas_mask;
+            while (u32_meas_mask != 0)
+            {
+                uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+                u32_meas_mask &= u32_meas_mask - 1;
+                pstru_block->as32_prev_raw[u8_meas_id] = pstru_meas->as32_raw[u8_meas_id];
+            }
+
+            if (pstru_block->u16_num_samples == 0)
+            {
+                pstru_block->u32_first_timestamp = pstru_meas->u32_timestamp;
+            }
+            pstru_block->u32_last_timestamp = pstru_meas->u32_timestamp;
+            pstru_block->u16_num_samples++;
+
+            memcpy (&g_au8_staging_blocks[pstru_block->u8_block_idx][pstru_block->u16_len], au8_sample, u16_sample_len);
+            pstru_block->u16_len += u16_sample_len;
+        }
+    }
+
+    if (pstru_block->u8_block_idx == RTLOG_STORE_NO_BLOCK)
+    {
+        g_u32_num_dropped++;
+    }
+    xSemaphoreGive (g_x_staging_mutex);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes a sample relative to the previous sample in the block being filled
+**
+** @details
+**      See RTLOG_STORE_VERSION for encoding of the sample
+**
+** @param [in]
+**      pstru_meas: The sample to encode
+**
+** @param [out]
+**      pu8_sample: Buffer of at least RTLOG_STORE_MAX_SAMPLE_LEN bytes to store the encoded sample
+**
+** @return
+**      Length in bytes of the encoded sample
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint16_t u16_RTLOG_Store_Encode_Sample (const RTLOG_rt_meas_t * pstru_meas, uint8_t * pu8_sample)
+{
+    const RTLOG_active_block_t *    pstru_block = &g_stru_active_block;
+    uint16_t                        u16_len = 0;
+    uint32_t                        u32_meas_mask = pstru_meas->u32_meas_mask;
+
+    /* Timestamp and measurement mask */
+    uint32_t u32_prev_timestamp = (pstru_block->u16_num_samples == 0) ? pstru_meas->u32_timestamp :
+                                                                          pstru_block->u32_last_timestamp;
+    u16_len += u8_RTLOG_Put_Varint (&pu8_sample[u16_len], pstru_meas->u32_timestamp - u32_prev_timestamp);
+    u16_len += u8_RTLOG_Put_Varint (&pu8_sample[u16_len], u32_meas_mask);
+
+    /* Difference of each raw value from its previous value */
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+
+        uint32_t u32_delta = (uint32_t)pstru_meas->as32_raw[u8_meas_id] -
+                             (uint32_t)pstru_block->as32_prev_raw[u8_meas_id];
+        u16_len += u8_RTLOG_Put_Varint (&pu8_sample[u16_len], (u32_delta << 1) ^ (uint32_t)((int32_t)u32_delta >> 31));
+    }
+
+    return u16_len;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Closes the block being filled, hands it over to the store task, and starts filling a free block
+**
+** @note
+**      g_x_staging_mutex must be held by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Store_Seal_Block (void)
+{
+    RTLOG_active_block_t * pstru_block = &g_stru_active_block;
+
+    /* Hand over the block if it contains samples */
+    if ((pstru_block->u8_block_idx != RTLOG_STORE_NO_BLOCK) && (pstru_block->u16_num_samples != 0))
+    {
+        uint8_t * pu8_block = g_au8_staging_blocks[pstru_block->u8_block_idx];
+        pu8_block[0] = RTLOG_STORE_VERSION;
+        pu8_block[1] = 0;
+        ENDIAN_PUT16 (&pu8_block[2], pstru_block->u16_num_samples);
+        ENDIAN_PUT16 (&pu8_block[4], pstru_block->u16_len);
+        ENDIAN_PUT16 (&pu8_block[6], 0);
+        ENDIAN_PUT32 (&pu8_block[8], pstru_block->u32_first_timestamp);
+        ENDIAN_PUT32 (&pu8_block[12], pstru_block->u32_last_timestamp);
+        memset (&pu8_block[pstru_block->u16_len], 0, RTLOG_STORE_BLOCK_SIZE - pstru_block->u16_len);
+
+        xQueueSend (g_x_ready_blocks, &pstru_block->u8_block_idx, 0);
+        pstru_block->u8_block_idx = RTLOG_STORE_NO_BLOCK;
+    }
+
+    /* Get a free block */
+    if (pstru_block->u8_block_idx == RTLOG_STORE_NO_BLOCK)
+    {
+        if (xQueueReceive (g_x_free_blocks, &pstru_block->u8_block_idx, 0) != pdTRUE)
+        {
+            pstru_block->u8_block_idx = RTLOG_STORE_NO_BLOCK;
+        }
+    }
+
+    /* Decoding of every block starts from 0, including the measurements that are missing from its first samples */
+    pstru_block->u16_num_samples = 0;
+    pstru_block->u16_len = RTLOG_STORE_HDR_LEN;
+    memset (pstru_block->as32_prev_raw, 0, sizeof (pstru_block->as32_prev_raw));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Task writing staged blocks onto flash
+**
+** @details
+**      The block being filled is also closed and written if no block has been written for
+**      RTLOG_STORE_FLUSH_PERIOD_MS, so that samples before a fault are persisted even if the samples stop.
+**
+** @param [in]
+**      pv_param: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Store_Task (void * pv_param)
+{
+    uint8_t u8_block_idx;
+
+    /* Wait until LittleFS storage is mounted */
+    while (g_px_lfs2 == NULL)
+    {
+        vTaskDelay (pdMS_TO_TICKS (RTLOG_STORE_FLUSH_PERIOD_MS / 10));
+    }
+
+    /* Load existing segment files */
+    xSemaphoreTake (g_x_storage_mutex, portMAX_DELAY);
+    v_RTLOG_Store_Load_Segments ();
+    g_b_storage_ready = true;
+    xSemaphoreGive (g_x_storage_mutex);
+
+    while (1)
+    {
+        /* Wait for a ready block, or close the block being filled after a while */
+        if (xQueuePeek (g_x_ready_blocks, &u8_block_idx, pdMS_TO_TICKS (RTLOG_STORE_FLUSH_PERIOD_MS)) != pdTRUE)
+        {
+            xSemaphoreTake (g_x_staging_mutex, portMAX_DELAY);
+            v_RTLOG_Store_Seal_Block ();
+            xSemaphoreGive (g_x_staging_mutex);
+        }
+
+        /* Write the ready blocks */
+        xSemaphoreTake (g_x_storage_mutex, portMAX_DELAY);
+        v_RTLOG_Store_Write_Ready_Blocks ();
+        xSemaphoreGive (g_x_storage_mutex);
+
+        /* Report the dropped samples */
+        if (g_u32_num_dropped != 0)
+        {
+            LOGW ("%" PRIu32 " realtime measurement samples were not stored because flash is too slow",
+                  g_u32_num_dropped);
+            g_u32_num_dropped = 0;
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes all ready blocks onto flash and gives them back to the free queue
+**
+** @note
+**      g_x_storage_mutex must be held by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Store_Write_Ready_Blocks (void)
+{
+    uint8_t u8_block_idx;
+
+    while (xQueueReceive (g_x_ready_blocks, &u8_block_idx, 0) == pdTRUE)
+    {
+        if (s32_RTLOG_Store_Write_Block (g_au8_staging_blocks[u8_block_idx]) != STATUS_OK)
+        {
+            LOGE ("Failed to store %d realtime measurement samples",
+                  ENDIAN_GET16 (&g_au8_staging_blocks[u8_block_idx][2]));
+        }
+        xQueueSend (g_x_free_blocks, &u8_block_idx, 0);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends a block to the newest segment file
+**
+** @details
+**      A new segment file is started if the newest one is full, or if the block is older than the last sample in the
+**      segment (slave board restarted), so that timestamps in every segment file are in ascending order.
+**
+** @note
+**      g_x_storage_mutex must be held by the caller
+**
+** @param [in]
+**      pu8_block: The block to write
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int32_t s32_RTLOG_Store_Write_Block (const uint8_t * pu8_block)
+{
+    uint32_t u32_first_timestamp = ENDIAN_GET32 (&pu8_block[8]);
+    uint32_t u32_last_timestamp = ENDIAN_GET32 (&pu8_block[12]);
+
+    /* Start a new segment file if needed */
+    if ((!g_b_segment_opened) ||
+        (g_astru_segments[g_u8_num_segments - 1].u16_num_blocks >= RTLOG_STORE_SEGMENT_BLOCKS) ||
+        (u32_first_timestamp < g_astru_segments[g_u8_num_segments - 1].u32_last_timestamp))
+    {
+        if (s32_RTLOG_Store_Open_Segment () != STATUS_OK)
+        {
+            return STATUS_ERR;
+        }
+    }
+    RTLOG_segment_t * pstru_segment = &g_astru_segments[g_u8_num_segments - 1];
+
+    /* Write the block and commit it, so that it survives a power loss */
+    if ((lfs2_file_write (g_px_lfs2, &g_x_segment_file, pu8_block, RTLOG_STORE_BLOCK_SIZE) != RTLOG_STORE_BLOCK_SIZE) ||
+        (lfs2_file_sync (g_px_lfs2, &g_x_segment_file) < 0))
+    {
+        LOGE ("Failed to write segment file %08X", pstru_segment->u32_seq);
+        lfs2_file_close (g_px_lfs2, &g_x_segment_file);
+        g_b_segment_opened = false;
+        return STATUS_ERR;
+    }
+
+    if (pstru_segment->u16_num_blocks == 0)
+    {
+        pstru_segment->u32_first_timestamp = u32_first_timestamp;
+    }
+    pstru_segment->u32_last_timestamp = u32_last_timestamp;
+    pstru_segment->u16_num_blocks++;
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Closes the segment file being written and creates a new one, deleting the oldest segment file if the maximum
+**      number of segment files is reached
+**
+** @note
+**      g_x_storage_mutex must be held by the caller
+**
+** @return
+**      @arg    STATUS_OK
+**      @arg    STATUS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int32_t s32_RTLOG_Store_Open_Segment (void)
+{
+    char stri_file_path [MAX_FILE_PATH_LEN];
+
+    /* Close the current segment file */
+    if (g_b_segment_opened)
+    {
+        lfs2_file_close (g_px_lfs2, &g_x_segment_file);
+        g_b_segment_opened = false;
+    }
+
+    /* Sequence number of the new segment */
+    uint32_t u32_seq = (g_u8_num_segments == 0) ? 0 : (g_astru_segments[g_u8_num_segments - 1].u32_seq + 1);
+
+    /* Delete the oldest segment files */
+    while (g_u8_num_segments >= RTLOG_STORE_NUM_SEGMENTS)
+    {
+        snprintf (stri_file_path, sizeof (stri_file_path), RTLOG_STORE_DIR "/%08X.seg", g_astru_segments[0].u32_seq);
+        lfs2_remove (g_px_lfs2, stri_file_path);
+        g_u8_num_segments--;
+        memmove (&g_astru_segments[0], &g_astru_segments[1], g_u8_num_segments * sizeof (RTLOG_segment_t));
+    }
+
+    /* Create the new segment file */
+    snprintf (stri_file_path, sizeof (stri_file_path), RTLOG_STORE_DIR "/%08X.seg", u32_seq);
+    if (lfs2_file_open (g_px_lfs2, &g_x_segment_file, stri_file_path, LFS2_O_WRONLY | LFS2_O_CREAT | LFS2_O_TRUNC) < 0)
+    {
+        LOGE ("Failed to create segment file %s", stri_file_path);
+        return STATUS_ERR;
+    }
+    g_b_segment_opened = true;
+
+    RTLOG_segment_t * pstru_segment = &g_astru_segments[g_u8_num_segments++];
+    pstru_segment->u32_seq = u32_seq;
+    pstru_segment->u16_num_blocks = 0;
+    pstru_segment->u32_first_timestamp = 0;
+    pstru_segment->u32_last_timestamp = 0;
+    return STATUS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Loads information of existing segment files from LittleFS storage
+**
+** @details
+**      Time range of a segment file is read from headers of its first and last blocks. Files are sorted by sequence
+**      number. If there are more files than RTLOG_STORE_NUM_SEGMENTS (the configuration was changed), the oldest ones
+**      are deleted. Samples of the current power cycle are always written to a new segment file.
+**
+** @note
+**      g_x_storage_mutex must be held by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Store_Load_Segments (void)
+{
+    lfs2_dir_t          x_dir;
+    lfs2_file_t         x_file;
+    struct lfs2_info    stru_info;
+    char                stri_file_path [MAX_FILE_PATH_LEN];
+    uint8_t             au8_header [RTLOG_STORE_HDR_LEN];
+
+    g_u8_num_segments = 0;
+
+    /* Create the directory if it doesn't exist */
+    int s32_err = lfs2_mkdir (g_px_lfs2, RTLOG_STORE_DIR);
+    if ((s32_err < 0) && (s32_err != LFS2_ERR_EXIST))
+    {
+        LOGE ("Failed to create directory %s", RTLOG_STORE_DIR);
+        return;
+    }
+    if (lfs2_dir_open (g_px_lfs2, &x_dir, RTLOG_STORE_DIR) < 0)
+    {
+        LOGE ("Failed to open directory %s", RTLOG_STORE_DIR);
+        return;
+    }
+
+    while (lfs2_dir_read (g_px_lfs2, &x_dir, &stru_info) > 0)
+    {
+        RTLOG_segment_t stru_segment;
+        char            c_dummy;
+
+        /* Segment file names are sequence numbers in hexadecimal */
+        if ((stru_info.type != LFS2_TYPE_REG) ||
+            (sscanf (stru_info.name, "%8x.se%c", &stru_segment.u32_seq, &c_dummy) != 2) || (c_dummy != 'g'))
+        {
+            continue;
+        }
+
+        /* Time range of the segment */
+        stru_segment.u16_num_blocks = stru_info.size / RTLOG_STORE_BLOCK_SIZE;
+        stru_segment.u32_first_timestamp = 0;
+        stru_segment.u32_last_timestamp = 0;
+        snprintf (stri_file_path, sizeof (stri_file_path), RTLOG_STORE_DIR "/%s", stru_info.name);
+        if ((stru_segment.u16_num_blocks != 0) &&
+            (lfs2_file_open (g_px_lfs2, &x_file, stri_file_path, LFS2_O_RDONLY) >= 0))
+        {
+            if (b_RTLOG_Store_Read_Header (&x_file, 0, au8_header))
+            {
+                stru_segment.u32_first_timestamp = ENDIAN_GET32 (&au8_header[8]);
+            }
+            if (b_RTLOG_Store_Read_Header (&x_file, stru_segment.u16_num_blocks - 1, au8_header))
+            {
+                stru_segment.u32_last_timestamp = ENDIAN_GET32 (&au8_header[12]);
+            }
+            lfs2_file_close (g_px_lfs2, &x_file);
+        }
+
+        /* Insert the segment in ascending order of sequence number */
+        uint8_t u8_pos = g_u8_num_segments;
+        while ((u8_pos > 0) && (g_astru_segments[u8_pos - 1].u32_seq > stru_segment.u32_seq))
+        {
+            u8_pos--;
+        }
+
+        /* If there is no room, only the newest segment files are kept */
+        if (g_u8_num_segments == RTLOG_STORE_NUM_SEGMENTS)
+        {
+            if (u8_pos == 0)
+            {
+                lfs2_remove (g_px_lfs2, stri_file_path);
+                continue;
+            }
+            snprintf (stri_file_path, sizeof (stri_file_path), RTLOG_STORE_DIR "/%08X.seg",
+                      g_astru_segments[0].u32_seq);
+            lfs2_remove (g_px_lfs2, stri_file_path);
+            g_u8_num_segments--;
+            memmove (&g_astru_segments[0], &g_astru_segments[1], g_u8_num_segments * sizeof (RTLOG_segment_t));
+            u8_pos--;
+        }
+        memmove (&g_astru_segments[u8_pos + 1], &g_astru_segments[u8_pos],
+                 (g_u8_num_segments - u8_pos) * sizeof (RTLOG_segment_t));
+        g_astru_segments[u8_pos] = stru_segment;
+        g_u8_num_segments++;
+    }
+    lfs2_dir_close (g_px_lfs2, &x_dir);
+
+    LOGI ("Found %d segment files of realtime measurements", g_u8_num_segments);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads header of a block in a segment file
+**
+** @param [in]
+**      px_file: The segment file opened for reading
+**
+** @param [in]
+**      u16_block: Index of the block in the file
+**
+** @param [out]
+**      pu8_header: Buffer of RTLOG_STORE_HDR_LEN bytes to store the header
+**
+** @return
+**      @arg    true: The header is valid
+**      @arg    false: Failed to read the header or it is invalid
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Store_Read_Header (lfs2_file_t * px_file, uint16_t u16_block, uint8_t * pu8_header)
+{
+    if ((lfs2_file_seek (g_px_lfs2, px_file, (lfs2_soff_t)u16_block * RTLOG_STORE_BLOCK_SIZE, LFS2_SEEK_SET) < 0) ||
+        (lfs2_file_read (g_px_lfs2, px_file, pu8_header, RTLOG_STORE_HDR_LEN) != RTLOG_STORE_HDR_LEN))
+    {
+        return false;
+    }
+    return ((pu8_header[0] == RTLOG_STORE_VERSION) && (ENDIAN_GET16 (&pu8_header[4]) >= RTLOG_STORE_HDR_LEN) &&
+            (ENDIAN_GET16 (&pu8_header[4]) <= RTLOG_STORE_BLOCK_SIZE));
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Reads the samples in a time range from a segment file
+**
+** @details
+**      The first block that may contain samples in the time range is found by binary search on block headers, then
+**      blocks are decoded one by one until a block starts after the time range.
+**
+** @note
+**      g_x_storage_mutex must be held by the caller
+**
+** @param [in]
+**      pstru_segment: The segment file to read
+**
+** @param [in]
+**      u32_start_time, u32_end_time, u32_meas_mask, pfnc_cb, pv_arg: See s32_RTLOG_Store_Query()
+**
+** @param [in, out]
+**      pu32_num_samples: Number of samples reported to pfnc_cb, increased by the number of samples found
+**
+** @return
+**      @arg    true: Continue with the next segment
+**      @arg    false: pfnc_cb requested to stop the query
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Store_Query_Segment (const RTLOG_segment_t * pstru_segment, uint32_t u32_start_time,
+                                         uint32_t u32_end_time, uint32_t u32_meas_mask,
+                                         RTLOG_query_cb_t pfnc_cb, void * pv_arg, uint32_t * pu32_num_samples)
+{
+    lfs2_file_t     x_file;
+    char            stri_file_path [MAX_FILE_PATH_LEN];
+    uint8_t         au8_block [RTLOG_STORE_BLOCK_SIZE];
+    RTLOG_rt_meas_t stru_meas;
+    bool            b_continue = true;
+    bool            b_end_reached = false;
+
+    snprintf (stri_file_path, sizeof (stri_file_path), RTLOG_STORE_DIR "/%08X.seg", pstru_segment->u32_seq);
+    if (lfs2_file_open (g_px_lfs2, &x_file, stri_file_path, LFS2_O_RDONLY) < 0)
+    {
+        LOGE ("Failed to open segment file %s", stri_file_path);
+        return true;
+    }
+
+    /* Find the first block whose last sample is not before the time range */
+    uint16_t u16_low = 0;
+    uint16_t u16_high = pstru_segment->u16_num_blocks;
+    while (u16_low < u16_high)
+    {
+        uint16_t u16_mid = u16_low + (u16_high - u16_low) / 2;
+        if (b_RTLOG_Store_Read_Header (&x_file, u16_mid, au8_block) &&
+            (ENDIAN_GET32 (&au8_block[12]) < u32_start_time))
+        {
+            u16_low = u16_mid + 1;
+        }
+        else
+        {
+            u16_high = u16_mid;
+        }
+    }
+
+    /* Decode the blocks from there */
+    lfs2_file_seek (g_px_lfs2, &x_file, (lfs2_soff_t)u16_low * RTLOG_STORE_BLOCK_SIZE, LFS2_SEEK_SET);
+    for (uint16_t u16_block = u16_low; (u16_block < pstru_segment->u16_num_blocks) && b_continue && !b_end_reached;
+         u16_block++)
+    {
+        if (lfs2_file_read (g_px_lfs2, &x_file, au8_block, RTLOG_STORE_BLOCK_SIZE) != RTLOG_STORE_BLOCK_SIZE)
+        {
+            break;
+        }
+        uint16_t u16_block_len = ENDIAN_GET16 (&au8_block[4]);
+        if ((au8_block[0] != RTLOG_STORE_VERSION) ||
+            (u16_block_len < RTLOG_STORE_HDR_LEN) || (u16_block_len > RTLOG_STORE_BLOCK_SIZE))
+        {
+            LOGW ("Block %d of segment file %s is corrupted", u16_block, stri_file_path);
+            continue;
+        }
+        if (ENDIAN_GET32 (&au8_block[8]) > u32_end_time)
+        {
+            b_end_reached = true;
+            break;
+        }
+
+        /* Decode the samples */
+        const uint8_t * pu8_data = &au8_block[RTLOG_STORE_HDR_LEN];
+        const uint8_t * pu8_end = &au8_block[u16_block_len];
+        uint16_t        u16_num_samples = ENDIAN_GET16 (&au8_block[2]);
+        uint32_t        u32_timestamp = ENDIAN_GET32 (&au8_block[8]);
+        memset (stru_meas.as32_raw, 0, sizeof (stru_meas.as32_raw));
+
+        for (uint16_t u16_sample = 0; (u16_sample < u16_num_samples) && b_continue; u16_sample++)
+        {
+            uint32_t u32_value;
+
+            /* Timestamp and measurement mask */
+            if (!b_RTLOG_Get_Varint (&pu8_data, pu8_end, &u32_value))
+            {
+                break;
+            }
+            u32_timestamp += u32_value;
+            if (!b_RTLOG_Get_Varint (&pu8_data, pu8_end, &u32_value))
+            {
+                break;
+            }
+            if ((u32_value & ~RTLOG_DEFINED_MEAS_MASK) != 0)
+            {
+                /* Measurement IDs index the raw values, a corrupt mask would write out of them */
+                LOGW ("Block %d of segment file %s has an invalid measurement mask 0x%08X", u16_block, stri_file_path,
+                      u32_value);
+                break;
+            }
+            stru_meas.u32_timestamp = u32_timestamp;
+            stru_meas.u32_meas_mask = u32_value;
+
+            /* Raw values */
+            uint32_t u32_remain_mask = u32_value;
+            while (u32_remain_mask != 0)
+            {
+                uint8_t u8_meas_id = __builtin_ctz (u32_remain_mask);
+                u32_remain_mask &= u32_remain_mask - 1;
+                if (!b_RTLOG_Get_Varint (&pu8_data, pu8_end, &u32_value))
+                {
+                    break;
+                }
+                stru_meas.as32_raw[u8_meas_id] += (int32_t)((u32_value >> 1) ^ (0U - (u32_value & 1)));
+            }
+            if (u32_remain_mask != 0)
+            {
+                LOGW ("Block %d of segment file %s is truncated", u16_block, stri_file_path);
+                break;
+            }
+
+            /* Report the sample if it is in the time range and contains the requested measurements */
+            if (u32_timestamp > u32_end_time)
+            {
+                b_end_reached = true;
+                break;
+            }
+            if ((u32_timestamp >= u32_start_time) && ((stru_meas.u32_meas_mask & u32_meas_mask) != 0))
+            {
+                stru_meas.u32_meas_mask &= u32_meas_mask;
+                (*pu32_num_samples)++;
+                b_continue = pfnc_cb (&stru_meas, pv_arg);
+            }
+        }
+    }
+
+    lfs2_file_close (g_px_lfs2, &x_file);
+    return b_continue;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a sample as a line of the CSV file being exported
+**
+** @param [in]
+**      pstru_meas: The sample
+**
+** @param [in]
+**      pv_arg: Context of the export (RTLOG_csv_export_t)
+**
+** @return
+**      @arg    true: Continue the export
+**      @arg    false: Failed to write the file
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Store_Export_Sample (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg)
+{
+    RTLOG_csv_export_t *    pstru_export = (RTLOG_csv_export_t *)pv_arg;
+    uint32_t                u32_meas_mask = pstru_export->u32_meas_mask;
+    char *                  pstri_line = pstru_export->pstri_line;
+    uint16_t                u16_len = 0;
+    bool                    b_printed;
+
+    /* An empty column for each measurement missing from the sample */
+    b_printed = b_RTLOG_Store_Print_Csv (pstri_line, &u16_len, "%u", pstru_meas->u32_timestamp);
+    while ((u32_meas_mask != 0) && b_printed)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+        if (pstru_meas->u32_meas_mask & (1UL << u8_meas_id))
+        {
+            b_printed = b_RTLOG_Store_Print_Csv (pstri_line, &u16_len, ",%.3f",
+                                                 flt_RTLOG_Get_Value (pstru_meas, u8_meas_id));
+        }
+        else
+        {
+            b_printed = b_RTLOG_Store_Print_Csv (pstri_line, &u16_len, ",");
+        }
+    }
+    b_printed = b_printed && b_RTLOG_Store_Print_Csv (pstri_line, &u16_len, "\n");
+
+    pstru_export->b_ok = b_printed &&
+                         (lfs2_file_write (g_px_lfs2, pstru_export->px_file, pstri_line, u16_len) == u16_len);
+    return pstru_export->b_ok;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Appends formatted text to a line of the CSV file being exported
+**
+** @param [in, out]
+**      pstri_line: Buffer of RTLOG_STORE_MAX_CSV_LINE_LEN bytes containing the line
+**
+** @param [in, out]
+**      pu16_len: Length in bytes of the line, increased by the length of the text appended
+**
+** @param [in]
+**      pstri_format: Format of the text, followed by its arguments
+**
+** @return
+**      @arg    true: The text has been appended
+**      @arg    false: The text doesn't fit in the rest of the buffer, the line is truncated
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Store_Print_Csv (char * pstri_line, uint16_t * pu16_len, const char * pstri_format, ...)
+{
+    va_list x_args;
+    uint16_t u16_space = RTLOG_STORE_MAX_CSV_LINE_LEN - *pu16_len;
+
+    va_start (x_args, pstri_format);
+    int s32_len = vsnprintf (&pstri_line[*pu16_len], u16_space, pstri_format, x_args);
+    va_end (x_args);
+
+    if ((s32_len < 0) || (s32_len >= u16_space))
+    {
+        LOGE ("Line of exported CSV file exceeds %d bytes", RTLOG_STORE_MAX_CSV_LINE_LEN);
+        return false;
+    }
+    *pu16_len += s32_len;
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes an unsigned integer as LEB128 varint (7 bits per byte, least significant group first)
+**
+** @param [out]
+**      pu8_data: Buffer of at least 5 bytes to store the varint
+**
+** @param [in]
+**      u32_value: The value to encode
+**
+** @return
+**      Length in bytes of the varint
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint8_t u8_RTLOG_Put_Varint (uint8_t * pu8_data, uint32_t u32_value)
+{
+    uint8_t u8_len = 0;
+
+    while (u32_value >= 0x80)
+    {
+        pu8_data[u8_len++] = (uint8_t)(u32_value | 0x80);
+        u32_value >>= 7;
+    }
+    pu8_data[u8_len++] = (uint8_t)u32_value;
+    return u8_len;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Decodes an unsigned LEB128 varint
+**
+** @param [in, out]
+**      ppu8_data: Pointer to the varint, moved past the varint if it is decoded
+**
+** @param [in]
+**      pu8_end: End of the data containing the varint
+**
+** @param [out]
+**      pu32_value: The decoded value
+**
+** @return
+**      @arg    true: The varint has been decoded
+**      @arg    false: The varint is truncated or too long
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Get_Varint (const uint8_t ** ppu8_data, const uint8_t * pu8_end, uint32_t * pu32_value)
+{
+    const uint8_t * pu8_data = *ppu8_data;
+    uint32_t        u32_value = 0;
+
+    for (uint8_t u8_shift = 0; (u8_shift < 35) && (pu8_data < pu8_end); u8_shift += 7)
+    {
+        uint8_t u8_byte = *pu8_data++;
+        u32_value |= (uint32_t)(u8_byte & 0x7F) << u8_shift;
+        if ((u8_byte & 0x80) == 0)
+        {
+            *ppu8_data = pu8_data;
+            *pu32_value = u32_value;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -29,6 +29,8 @@
 
 #include "cJSON.h"                      /* Use ESP-IDF's JSON component */
 #include "string.h"                     /* Use strlen() */
+#include "esp_timer.h"                  /* Use esp_timer_get_time() */
+#include "freertos/FreeRTOS.h"          /* Use xPortGetCoreID() */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -40,16 +42,156 @@
 enum
 {
     RTLOG_MSG_RT_MEAS               = 0x11,     //!< Realtime measurement message
+    RTLOG_MSG_RT_AGGR               = 0x12,     //!< Aggregated realtime measurements, only sent to Websocket clients
     RTLOG_MSG_POWER_INTERRUPTED     = 0x22,     //!< Notification sent when power interruption is detected
 };
 
-/** @brief  ID of realtime measurement */
+/** @brief  Wire types of raw measurement values, used in Type column of RTLOG_MEAS_TABLE */
 typedef enum
 {
-    RTLOG_TOP_HEATER_TEMP           = 0,        //!< Temperature of top heater in Celsius degrees (fix16_t)
-    RTLOG_BTM_HEATER_TEMP           = 1,        //!< Temperature of bottom heater in Celsius degrees (fix16_t)
+    RTLOG_U8,                                   //!< Unsigned 8-bit integer
+    RTLOG_I8,                                   //!< Signed 8-bit integer
+    RTLOG_U16,                                  //!< Unsigned 16-bit integer, little endian
+    RTLOG_I16,                                  //!< Signed 16-bit integer, little endian
+    RTLOG_U32,                                  //!< Unsigned 32-bit integer, little endian
+    RTLOG_I32,                                  //!< Signed 32-bit integer, little endian
+} RTLOG_wire_type_t;
 
-} RTLOG_meas_id_t;
+/** @brief  Size in bytes of each wire type */
+#define RTLOG_SIZE_OF_RTLOG_U8          1
+#define RTLOG_SIZE_OF_RTLOG_I8          1
+#define RTLOG_SIZE_OF_RTLOG_U16         2
+#define RTLOG_SIZE_OF_RTLOG_I16         2
+#define RTLOG_SIZE_OF_RTLOG_U32         4
+#define RTLOG_SIZE_OF_RTLOG_I32         4
+
+/** @brief  Name of each wire type used in the schema */
+#define RTLOG_NAME_OF_RTLOG_U8          "u8"
+#define RTLOG_NAME_OF_RTLOG_I8          "i8"
+#define RTLOG_NAME_OF_RTLOG_U16         "u16"
+#define RTLOG_NAME_OF_RTLOG_I16         "i16"
+#define RTLOG_NAME_OF_RTLOG_U32         "u32"
+#define RTLOG_NAME_OF_RTLOG_I32         "i32"
+
+/** @brief  Structure describing a realtime measurement */
+typedef struct
+{
+    const char *        pstri_name;             //!< Name of the measurement
+    RTLOG_wire_type_t   enm_type;               //!< Wire type of raw value
+    uint8_t             u8_size;                //!< Size in bytes of raw value, 0 if the measurement is not defined
+    float               flt_scale;              //!< Physical value = raw value / scale
+} RTLOG_meas_desc_t;
+
+/** @brief  Macro expanding RTLOG_MEAS_TABLE as initialization value for RTLOG_meas_desc_t struct */
+#define MEAS_TABLE_EXPAND_AS_DESC(MEAS_ID, BIT, NAME, TYPE, SCALE, UNIT)    \
+    [MEAS_ID] =                                                             \
+    {                                                                       \
+        .pstri_name     = NAME,                                             \
+        .enm_type       = TYPE,                                             \
+        .u8_size        = RTLOG_SIZE_OF_##TYPE,                             \
+        .flt_scale      = SCALE,                                            \
+    },
+
+/** @brief  Macro expanding RTLOG_MEAS_TABLE as a measurement entry of the schema */
+#define MEAS_TABLE_EXPAND_AS_SCHEMA(MEAS_ID, BIT, NAME, TYPE, SCALE, UNIT)  \
+    ",{\"id\":" #BIT ",\"name\":\"" NAME "\",\"type\":\"" RTLOG_NAME_OF_##TYPE      \
+    "\",\"scale\":" #SCALE ",\"unit\":\"" UNIT "\"}"
+
+/** @brief  Macro expanding RTLOG_MEAS_TABLE as bit mask of all defined measurements */
+#define MEAS_TABLE_EXPAND_AS_MASK(MEAS_ID, ...)                             \
+    | (1UL << MEAS_ID)
+
+/** @brief  Format of the realtime measurement messages sent to a Websocket client */
+typedef enum
+{
+    RTLOG_FORMAT_NONE,                          //!< The client is not connected
+    RTLOG_FORMAT_BINARY,                        //!< Binary frame (default)
+    RTLOG_FORMAT_JSON,                          //!< JSON message
+} RTLOG_format_t;
+
+/**
+** @brief   Layout of binary realtime measurement frame (all fields are little endian)
+** @details
+**      Offset  Size    Field
+**      0       1       Format version (RTLOG_BIN_VERSION)
+**      1       1       Message ID (RTLOG_MSG_RT_MEAS)
+**      2       2       Sequence number, increased by 1 for each sample, used to detect lost frames
+**      4       4       Timestamp in milliseconds
+**      8       4       Measurement mask, measurement ID x is available in the values if bit x is 1
+**      12      ...     Raw values of the available measurements in ascending order of ID, each value is encoded in
+**                      its wire type in RTLOG_MEAS_TABLE
+**
+**      The schema describing the measurements is sent to every client as a JSON message before the first frame, or
+**      whenever the client requests it. A message starting with '{' is a JSON message, otherwise a binary frame.
+*/
+#define RTLOG_BIN_VERSION               2
+#define RTLOG_BIN_HDR_LEN               12
+#define RTLOG_BIN_MAX_LEN               (RTLOG_BIN_HDR_LEN + RTLOG_NUM_MEAS * sizeof (int32_t))
+
+/**
+** @brief   Layout of binary aggregated realtime measurement frame (all fields are little endian)
+** @details
+**      Offset  Size    Field
+**      0       1       Format version (RTLOG_BIN_VERSION)
+**      1       1       Message ID (RTLOG_MSG_RT_AGGR)
+**      2       2       Sequence number, increased by 1 for each frame of the same period
+**      4       4       Timestamp in milliseconds of the start of the window
+**      8       4       Measurement mask, measurement ID x is available in the values if bit x is 1
+**      12      4       Length in milliseconds of the window, which is the period requested by the client
+**      16      2       Number of samples aggregated in the window, saturated at 65535
+**      18      ...     Minimum, maximum and mean raw values of each available measurement in ascending order of ID,
+**                      each value is encoded in its wire type in RTLOG_MEAS_TABLE
+**
+**      Windows are aligned on multiples of the period. A window is sent when the first sample after it arrives.
+*/
+#define RTLOG_AGGR_HDR_LEN              18
+#define RTLOG_AGGR_MAX_LEN              (RTLOG_AGGR_HDR_LEN + 3 * RTLOG_NUM_MEAS * sizeof (int32_t))
+
+/** @brief  Maximum number of different periods that can be aggregated at the same time */
+#define RTLOG_MAX_AGGREGATORS           4
+
+/** @brief  Maximum period in milliseconds of aggregated messages that a client can request */
+#define RTLOG_MAX_AGGR_PERIOD           3600000
+
+/** @brief  Windowed statistics of realtime measurements aggregated for a period */
+typedef struct
+{
+    uint32_t    u32_period;                     //!< Length in milliseconds of the window, 0 if not used
+    uint32_t    u32_window_start;               //!< Timestamp in milliseconds of the start of the current window
+    uint16_t    u16_seq;                        //!< Sequence number of the next binary frame
+    uint32_t    u32_num_samples;                //!< Number of samples in the current window
+    uint32_t    u32_meas_mask;                  //!< Measurement ID x has been available in the window if bit x is 1
+    int32_t     as32_min[RTLOG_NUM_MEAS];       //!< Minimum raw value of each measurement
+    int32_t     as32_max[RTLOG_NUM_MEAS];       //!< Maximum raw value of each measurement
+    int64_t     as64_sum[RTLOG_NUM_MEAS];       //!< Sum of raw values of each measurement
+    uint32_t    au32_count[RTLOG_NUM_MEAS];     //!< Number of values of each measurement
+} RTLOG_aggregator_t;
+
+/** @brief  Bit mask of all measurements defined in RTLOG_MEAS_TABLE */
+#define RTLOG_DEFINED_MEAS_MASK         (0 RTLOG_MEAS_TABLE (MEAS_TABLE_EXPAND_AS_MASK))
+
+/** @brief  Macros converting a literal number to string */
+#define RTLOG_STR(x)                    #x
+#define RTLOG_XSTR(x)                   RTLOG_STR(x)
+
+/** @brief  Maximum number of Websocket clients of realtime log channel tracked by this module */
+#define RTLOG_MAX_CLIENTS               8
+
+/** @brief  Maximum length in bytes of the request sent by a Websocket client to select its message format */
+#define RTLOG_MAX_REQUEST_LEN           64
+
+/** @brief  Topic of the realtime measurement samples published on the Websocket channel */
+#define RTLOG_TOPIC_SAMPLES             0
+
+/** @brief  Context of the encoding of a realtime measurement sample for a class of Websocket clients */
+typedef struct
+{
+    const RTLOG_rt_meas_t * pstru_meas;         //!< The sample to encode
+    char *                  pstri_json;         //!< Last JSON message encoded, NULL if none
+} RTLOG_publish_ctx_t;
+
+/** @brief  Number of samples encoded by the benchmark */
+#define RTLOG_BENCHMARK_SAMPLES         1000
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -66,6 +208,40 @@ static bool g_b_initialized = false;
 /** @brief  Instance of the Websocket server to send realtime log messages to */
 static WSS_inst_t g_x_ws_server_inst = NULL;
 
+/** @brief  Message format requested by each Websocket client */
+static volatile RTLOG_format_t g_aenm_client_formats[RTLOG_MAX_CLIENTS];
+
+/** @brief  Indicates if the schema should be sent to each Websocket client */
+static volatile bool g_ab_schema_pending[RTLOG_MAX_CLIENTS];
+
+/** @brief  Period in milliseconds of aggregated messages requested by each Websocket client, 0 for every sample */
+static volatile uint32_t g_au32_client_periods[RTLOG_MAX_CLIENTS];
+
+/** @brief  Aggregators of the periods requested by the clients */
+static RTLOG_aggregator_t g_astru_aggregators[RTLOG_MAX_AGGREGATORS];
+
+/** @brief  Description of all measurements, indexed by measurement ID */
+static const RTLOG_meas_desc_t g_astru_meas_descs[RTLOG_NUM_MEAS] =
+{
+    RTLOG_MEAS_TABLE (MEAS_TABLE_EXPAND_AS_DESC)
+};
+
+/** @brief  Schema describing fields of realtime measurement messages, generated at compile time */
+static const char g_stri_schema[] =
+    "{\"schema\":\"rtlog\",\"version\":" RTLOG_XSTR (RTLOG_BIN_VERSION) ",\"fields\":["
+    "{\"name\":\"Timestamp\",\"type\":\"u32\",\"scale\":1,\"unit\":\"ms\"}"
+    RTLOG_MEAS_TABLE (MEAS_TABLE_EXPAND_AS_SCHEMA)
+    "]}";
+
+/** @brief  Buffer of binary realtime measurement frame */
+static uint8_t g_au8_bin_frame[RTLOG_BIN_MAX_LEN];
+
+/** @brief  Sequence number of the next binary realtime measurement frame */
+static uint16_t g_u16_bin_seq = 0;
+
+/** @brief  Buffer of binary aggregated realtime measurement frame */
+static uint8_t g_au8_aggr_frame[RTLOG_AGGR_MAX_LEN];
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -74,6 +250,27 @@ static WSS_inst_t g_x_ws_server_inst = NULL;
 
 static int32_t s32_RTLOG_Init_Module (void);
 static void v_RTLOG_Process_Rt_Meas (uint32_t u32_timestamp, uint8_t * pu8_data, uint8_t u8_len);
+static bool b_RTLOG_Decode_Rt_Meas (uint32_t u32_timestamp, const uint8_t * pu8_data, uint8_t u8_len,
+                                    RTLOG_rt_meas_t * pstru_meas);
+static float flt_RTLOG_Scale_Raw (uint8_t u8_meas_id, int32_t s32_raw);
+static uint16_t u16_RTLOG_Encode_Binary (const RTLOG_rt_meas_t * pstru_meas, uint8_t * pu8_frame);
+static char * pstri_RTLOG_Encode_Json (const RTLOG_rt_meas_t * pstru_meas);
+static uint16_t u16_RTLOG_Encode_For_Clients (uint32_t u32_mask, uint8_t u8_encoding, void * pv_arg,
+                                              const void ** ppv_data);
+static uint8_t * pu8_RTLOG_Put_Raw (uint8_t * pu8_value, uint8_t u8_meas_id, int32_t s32_raw);
+static void v_RTLOG_Process_Aggregation (const RTLOG_rt_meas_t * pstru_meas);
+static void v_RTLOG_Aggregate_Sample (RTLOG_aggregator_t * pstru_aggr, const RTLOG_rt_meas_t * pstru_meas);
+static void v_RTLOG_Send_Aggregation (RTLOG_aggregator_t * pstru_aggr);
+static uint16_t u16_RTLOG_Encode_Aggr_Binary (RTLOG_aggregator_t * pstru_aggr, uint8_t * pu8_frame);
+static char * pstri_RTLOG_Encode_Aggr_Json (const RTLOG_aggregator_t * pstru_aggr);
+static int32_t s32_RTLOG_Get_Aggr_Mean (const RTLOG_aggregator_t * pstru_aggr, uint8_t u8_meas_id);
+static bool b_RTLOG_Raw_Less (uint8_t u8_meas_id, int32_t s32_raw_1, int32_t s32_raw_2);
+static void v_RTLOG_WSS_Callback (WSS_evt_data_t * pstru_evt_data);
+static void v_RTLOG_Set_Client_Period (uint8_t u8_client_id, const cJSON * px_json_period);
+static void v_RTLOG_Update_Encoding (uint8_t u8_client_id);
+#ifdef CONFIG_RTLOG_BENCHMARK_ENABLED
+static void v_RTLOG_Run_Benchmark (void);
+#endif
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -81,6 +278,9 @@ static void v_RTLOG_Process_Rt_Meas (uint32_t u32_timestamp, uint8_t * pu8_data,
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/* Time-series store of realtime measurements */
+#include "rt_store.c"
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -155,6 +355,22 @@ static int32_t s32_RTLOG_Init_Module (void)
         return STATUS_ERR;
     }
 
+    /* No client has connected yet */
+    for (uint8_t u8_client_id = 0; u8_client_id < RTLOG_MAX_CLIENTS; u8_client_id++)
+    {
+        g_aenm_client_formats[u8_client_id] = RTLOG_FORMAT_NONE;
+        g_ab_schema_pending[u8_client_id] = false;
+        g_au32_client_periods[u8_client_id] = 0;
+    }
+    memset (g_astru_aggregators, 0, sizeof (g_astru_aggregators));
+
+    /* Track the clients and their requested message format */
+    v_WSS_Register_Callback (g_x_ws_server_inst, v_RTLOG_WSS_Callback, NULL);
+
+#ifdef CONFIG_RTLOG_BENCHMARK_ENABLED
+    v_RTLOG_Run_Benchmark ();
+#endif
+
     return STATUS_OK;
 }
 
@@ -162,21 +378,19 @@ static int32_t s32_RTLOG_Init_Module (void)
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
 ** @brief
-**      Parses the raw data from a realtime measurement message (message type 0x11) into JSON message and sends it to
-**      Websocket server
+**      Parses the raw data from a realtime measurement message (message type 0x11) and sends it to the clients of
+**      Websocket server in the format and at the rate requested by each client
 **
 ** @details
-**      Structure of au8_data[] part of the message:
-**      + u32_meas_mask: Measurement ID x is available in the following data if bit x in this mask is 1
-**      + ... : data of measurement ID x if its bit is 1 in u32_meas_mask
+**      The measurements are also appended to the time-series store. The sample is published on topic
+**      RTLOG_TOPIC_SAMPLES, so that it is encoded once per format and measurement mask subscribed by the clients.
+**      Binary frame is encoded into a preallocated buffer. Clients having requested a period only receive the
+**      aggregated measurements.
 **
 ** @param [in]
 **      u32_timestamp: Timestamp in milliseconds of the log message
 **
 ** @param [in]
-**      u8_msg_id: Message ID help differentiate types of realtime logs
-**
-** @param [in]
 **      pu8_data: Raw data of the log
 **
 ** @param [in]
@@ -186,56 +400,1024 @@ static int32_t s32_RTLOG_Init_Module (void)
 */
 static void v_RTLOG_Process_Rt_Meas (uint32_t u32_timestamp, uint8_t * pu8_data, uint8_t u8_len)
 {
-    uint32_t    u32_meas_mask = ENDIAN_GET32 (pu8_data);
-    float       flt_top_temp = -1;
-    float       flt_btm_temp = -1;
+    RTLOG_rt_meas_t stru_meas;
 
-    /* Do nothing if there is no measurement */
-    if (u32_meas_mask == 0)
+    /* Parse measurement values, do nothing if there is no measurement */
+    if (!b_RTLOG_Decode_Rt_Meas (u32_timestamp, pu8_data, u8_len, &stru_meas))
     {
         return;
     }
 
-    /* Skip 4 bytes of measurement mask */
+    /* Keep the measurements on flash regardless of Websocket clients */
+    v_RTLOG_Store_Append (&stru_meas);
+
+    /* Send the schema to the clients requiring it */
+    for (uint8_t u8_client_id = 0; u8_client_id < RTLOG_MAX_CLIENTS; u8_client_id++)
+    {
+        if (g_ab_schema_pending[u8_client_id] && (g_aenm_client_formats[u8_client_id] != RTLOG_FORMAT_NONE))
+        {
+            g_ab_schema_pending[u8_client_id] = false;
+            enm_WSS_Send (g_x_ws_server_inst, u8_client_id, g_stri_schema, sizeof (g_stri_schema) - 1);
+        }
+    }
+
+    /* Publish the sample to the clients receiving every sample, in the format and filter of each client */
+    RTLOG_publish_ctx_t stru_ctx = { .pstru_meas = &stru_meas, .pstri_json = NULL };
+    enm_WSS_Publish (g_x_ws_server_inst, RTLOG_TOPIC_SAMPLES, u16_RTLOG_Encode_For_Clients, &stru_ctx);
+    free (stru_ctx.pstri_json);
+    g_u16_bin_seq++;
+
+    /* Aggregate the measurements for the clients requiring a lower rate */
+    v_RTLOG_Process_Aggregation (&stru_meas);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Decodes the raw data of a realtime measurement message into measurement values
+**
+** @details
+**      Structure of au8_data[] part of the message:
+**      + u32_meas_mask: Measurement ID x is available in the following data if bit x in this mask is 1
+**      + ... : data of measurement ID x if its bit is 1 in u32_meas_mask, encoded in its wire type in RTLOG_MEAS_TABLE
+**
+**      Only the bits set in the mask are visited. If a measurement is not defined in RTLOG_MEAS_TABLE, its size is
+**      unknown, so decoding stops there and only the measurements before it are available.
+**
+** @param [in]
+**      u32_timestamp: Timestamp in milliseconds of the log message
+**
+** @param [in]
+**      pu8_data: Raw data of the log
+**
+** @param [in]
+**      u8_len: Length in bytes of the data stored in pu8_data
+**
+** @param [out]
+**      pstru_meas: The decoded measurement values
+**
+** @return
+**      @arg    true: At least one measurement has been decoded
+**      @arg    false: There is no measurement in the message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Decode_Rt_Meas (uint32_t u32_timestamp, const uint8_t * pu8_data, uint8_t u8_len,
+                                    RTLOG_rt_meas_t * pstru_meas)
+{
+    static uint32_t u32_reported_mask = 0;
+
+    /* Get measurement mask */
+    if (u8_len < 4)
+    {
+        return false;
+    }
+    uint32_t u32_meas_mask = ENDIAN_GET32 (pu8_data);
     pu8_data += 4;
+    u8_len -= 4;
 
-    /* Construct JSON message object */
-    cJSON * px_notify_root = cJSON_CreateObject ();
-    cJSON_AddNumberToObject (px_notify_root, "Timestamp", u32_timestamp);
+    pstru_meas->u32_timestamp = u32_timestamp;
+    pstru_meas->u32_meas_mask = 0;
 
-    /* Parse measurement values */
-    for (uint8_t u8_meas_id = 0; u8_meas_id < 32; u8_meas_id++)
+    /* Parse values of the measurements whose bit is set, from the lowest bit */
+    while (u32_meas_mask != 0)
     {
-        if (u32_meas_mask & 0x1)
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        const RTLOG_meas_desc_t * pstru_desc = &g_astru_meas_descs[u8_meas_id];
+        u32_meas_mask &= u32_meas_mask - 1;
+
+        /* Unknown size of the value, the following values can't be located */
+        if ((pstru_desc->u8_size == 0) || (pstru_desc->u8_size > u8_len))
         {
-            switch (u8_meas_id)
+            if (ALL_BITS_CLR (u32_reported_mask, 1UL << u8_meas_id))
             {
-                case RTLOG_TOP_HEATER_TEMP:
-                    flt_top_temp = ((int32_t)ENDIAN_GET32 (pu8_data)) / 65536.0;
-                    pu8_data += 4;
-                    cJSON_AddNumberToObject (px_notify_root, "Top heater temperature", flt_top_temp);
-                    break;
-
-                case RTLOG_BTM_HEATER_TEMP:
-                    flt_btm_temp = ((int32_t)ENDIAN_GET32 (pu8_data)) / 65536.0;
-                    pu8_data += 4;
-                    cJSON_AddNumberToObject (px_notify_root, "Bottom heater temperature", flt_btm_temp);
-                    break;
+                SET_BITS (u32_reported_mask, 1UL << u8_meas_id);
+                LOGW ("Measurement ID %d is %s, the following measurements are discarded", u8_meas_id,
+                      (pstru_desc->u8_size == 0) ? "not defined" : "truncated");
             }
+            break;
+        }
+
+        /* Get raw value */
+        switch (pstru_desc->enm_type)
+        {
+            case RTLOG_U8:
+                pstru_meas->as32_raw[u8_meas_id] = pu8_data[0];
+                break;
+
+            case RTLOG_I8:
+                pstru_meas->as32_raw[u8_meas_id] = (int8_t)pu8_data[0];
+                break;
+
+            case RTLOG_U16:
+                pstru_meas->as32_raw[u8_meas_id] = ENDIAN_GET16 (pu8_data);
+                break;
+
+            case RTLOG_I16:
+                pstru_meas->as32_raw[u8_meas_id] = (int16_t)ENDIAN_GET16 (pu8_data);
+                break;
+
+            case RTLOG_U32:
+            case RTLOG_I32:
+                pstru_meas->as32_raw[u8_meas_id] = (int32_t)ENDIAN_GET32 (pu8_data);
+                break;
         }
+        pstru_meas->u32_meas_mask |= (1UL << u8_meas_id);
+        pu8_data += pstru_desc->u8_size;
+        u8_len -= pstru_desc->u8_size;
+    }
+
+    return (pstru_meas->u32_meas_mask != 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets name of a measurement
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement
+**
+** @return
+**      @arg    NULL: The measurement is not defined in RTLOG_MEAS_TABLE
+**      @arg    Otherwise: Name of the measurement
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+const char * pstri_RTLOG_Get_Meas_Name (uint8_t u8_meas_id)
+{
+    if ((u8_meas_id >= RTLOG_NUM_MEAS) || (g_astru_meas_descs[u8_meas_id].u8_size == 0))
+    {
+        return NULL;
+    }
+    return g_astru_meas_descs[u8_meas_id].pstri_name;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets physical value of a measurement
+**
+** @param [in]
+**      pstru_meas: Decoded measurement values
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement, its bit must be set in the mask of pstru_meas
+**
+** @return
+**      Physical value of the measurement
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+float flt_RTLOG_Get_Value (const RTLOG_rt_meas_t * pstru_meas, uint8_t u8_meas_id)
+{
+    return flt_RTLOG_Scale_Raw (u8_meas_id, pstru_meas->as32_raw[u8_meas_id]);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Converts a raw value of a measurement into physical value
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement
+**
+** @param [in]
+**      s32_raw: Raw value of the measurement
+**
+** @return
+**      Physical value of the measurement
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static float flt_RTLOG_Scale_Raw (uint8_t u8_meas_id, int32_t s32_raw)
+{
+    const RTLOG_meas_desc_t * pstru_desc = &g_astru_meas_descs[u8_meas_id];
+
+    if (pstru_desc->enm_type == RTLOG_U32)
+    {
+        return (uint32_t)s32_raw / pstru_desc->flt_scale;
+    }
+    return s32_raw / pstru_desc->flt_scale;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes realtime measurement values into a binary frame
+**
+** @details
+**      See RTLOG_BIN_VERSION for layout of the frame. The sequence number is the one of the current sample, all frames
+**      of a sample have the same sequence number.
+**
+** @param [in]
+**      pstru_meas: Realtime measurement values to encode
+**
+** @param [out]
+**      pu8_frame: Buffer of at least RTLOG_BIN_MAX_LEN bytes to store the frame
+**
+** @return
+**      Length in bytes of the encoded frame
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint16_t u16_RTLOG_Encode_Binary (const RTLOG_rt_meas_t * pstru_meas, uint8_t * pu8_frame)
+{
+    uint8_t *   pu8_value = &pu8_frame[RTLOG_BIN_HDR_LEN];
+    uint32_t    u32_meas_mask = pstru_meas->u32_meas_mask;
+
+    /* Header */
+    pu8_frame[0] = RTLOG_BIN_VERSION;
+    pu8_frame[1] = RTLOG_MSG_RT_MEAS;
+    ENDIAN_PUT16 (&pu8_frame[2], g_u16_bin_seq);
+    ENDIAN_PUT32 (&pu8_frame[4], pstru_meas->u32_timestamp);
+    ENDIAN_PUT32 (&pu8_frame[8], u32_meas_mask);
+
+    /* Packed values in their wire types */
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+        pu8_value = pu8_RTLOG_Put_Raw (pu8_value, u8_meas_id, pstru_meas->as32_raw[u8_meas_id]);
+    }
+
+    return (uint16_t)(pu8_value - pu8_frame);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes realtime measurement values into a JSON message
+**
+** @param [in]
+**      pstru_meas: Realtime measurement values to encode
+**
+** @return
+**      @arg    NULL: Failed to encode the message
+**      @arg    Otherwise: NULL-terminated JSON message, which must be freed by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static char * pstri_RTLOG_Encode_Json (const RTLOG_rt_meas_t * pstru_meas)
+{
+    uint32_t u32_meas_mask = pstru_meas->u32_meas_mask;
+
+    /* Construct JSON message object */
+    cJSON * px_notify_root = cJSON_CreateObject ();
+    if (px_notify_root == NULL)
+    {
+        return NULL;
+    }
+    cJSON_AddNumberToObject (px_notify_root, "Timestamp", pstru_meas->u32_timestamp);
+
+    /* Add measurement values */
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
 
-        u32_meas_mask >>= 1;
+        cJSON_AddNumberToObject (px_notify_root, g_astru_meas_descs[u8_meas_id].pstri_name,
+                                 flt_RTLOG_Get_Value (pstru_meas, u8_meas_id));
     }
 
-    /* Send the JSON message through Websocket server */
-    char * pstri_notify = cJSON_Print (px_notify_root);
+    /* Print the message without formatting to keep it short */
+    char * pstri_notify = cJSON_PrintUnformatted (px_notify_root);
     cJSON_Delete (px_notify_root);
-    if (pstri_notify != NULL)
+    return pstri_notify;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes a realtime measurement sample for a class of Websocket clients having the same format and filter
+**
+** @details
+**      Only the measurements in the mask subscribed by the clients are encoded. This function is invoked by
+**      enm_WSS_Publish().
+**
+** @param [in]
+**      u32_mask: Mask of the measurements subscribed by the clients
+**
+** @param [in]
+**      u8_encoding: Message format of the clients (RTLOG_format_t), RTLOG_FORMAT_NONE if they do not receive every
+**                   sample
+**
+** @param [in]
+**      pv_arg: Context of the encoding (RTLOG_publish_ctx_t)
+**
+** @param [out]
+**      ppv_data: Pointer to the encoded message
+**
+** @return
+**      Length in bytes of the encoded message, 0 if nothing is sent to the clients
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint16_t u16_RTLOG_Encode_For_Clients (uint32_t u32_mask, uint8_t u8_encoding, void * pv_arg,
+                                              const void ** ppv_data)
+{
+    RTLOG_publish_ctx_t *   pstru_ctx = (RTLOG_publish_ctx_t *)pv_arg;
+    RTLOG_rt_meas_t         stru_meas = *pstru_ctx->pstru_meas;
+
+    /* Nothing to send if none of the subscribed measurements is available */
+    stru_meas.u32_meas_mask &= u32_mask;
+    if (stru_meas.u32_meas_mask == 0)
     {
-        enm_WSS_Send (g_x_ws_server_inst, WSS_ALL_CLIENTS, pstri_notify, strlen (pstri_notify));
-        free (pstri_notify);
+        return 0;
+    }
+
+    if (u8_encoding == RTLOG_FORMAT_BINARY)
+    {
+        *ppv_data = g_au8_bin_frame;
+        return u16_RTLOG_Encode_Binary (&stru_meas, g_au8_bin_frame);
+    }
+    if (u8_encoding == RTLOG_FORMAT_JSON)
+    {
+        /* The previous message has already been queued */
+        free (pstru_ctx->pstri_json);
+        pstru_ctx->pstri_json = pstri_RTLOG_Encode_Json (&stru_meas);
+        *ppv_data = pstru_ctx->pstri_json;
+        return (pstru_ctx->pstri_json != NULL) ? strlen (pstru_ctx->pstri_json) : 0;
+    }
+    return 0;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes a raw value of a measurement in its wire type
+**
+** @param [in]
+**      pu8_value: Buffer to store the encoded value
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement
+**
+** @param [in]
+**      s32_raw: Raw value of the measurement
+**
+** @return
+**      Pointer to the byte following the encoded value
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint8_t * pu8_RTLOG_Put_Raw (uint8_t * pu8_value, uint8_t u8_meas_id, int32_t s32_raw)
+{
+    uint32_t u32_raw = (uint32_t)s32_raw;
+
+    switch (g_astru_meas_descs[u8_meas_id].u8_size)
+    {
+        case 1:
+            pu8_value[0] = (uint8_t)u32_raw;
+            break;
+
+        case 2:
+            ENDIAN_PUT16 (pu8_value, (uint16_t)u32_raw);
+            break;
+
+        case 4:
+            ENDIAN_PUT32 (pu8_value, u32_raw);
+            break;
     }
+    return pu8_value + g_astru_meas_descs[u8_meas_id].u8_size;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Aggregates a sample of realtime measurements for the periods requested by the Websocket clients
+**
+** @details
+**      Each period requested by at least one client has its own aggregator, which is shared by all clients requesting
+**      the same period. An aggregator is released when no client requests its period anymore. The aggregated
+**      measurements of a window are sent when the first sample after the window arrives, or when the timestamp goes
+**      backwards (slave board has been reset).
+**
+** @param [in]
+**      pstru_meas: The sample
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Process_Aggregation (const RTLOG_rt_meas_t * pstru_meas)
+{
+    uint32_t u32_used_aggrs = 0;
+    uint32_t u32_timestamp = pstru_meas->u32_timestamp;
+
+    /* Keep the aggregators of the periods still requested */
+    for (uint8_t u8_client_id = 0; u8_client_id < RTLOG_MAX_CLIENTS; u8_client_id++)
+    {
+        uint32_t u32_period = g_au32_client_periods[u8_client_id];
+        if ((u32_period == 0) || (g_aenm_client_formats[u8_client_id] == RTLOG_FORMAT_NONE))
+        {
+            continue;
+        }
+        for (uint8_t u8_aggr_idx = 0; u8_aggr_idx < RTLOG_MAX_AGGREGATORS; u8_aggr_idx++)
+        {
+            if (g_astru_aggregators[u8_aggr_idx].u32_period == u32_period)
+            {
+                SET_BITS (u32_used_aggrs, 1UL << u8_aggr_idx);
+                break;
+            }
+        }
+    }
+
+    /* Release the aggregators of the periods no longer requested */
+    for (uint8_t u8_aggr_idx = 0; u8_aggr_idx < RTLOG_MAX_AGGREGATORS; u8_aggr_idx++)
+    {
+        if (ALL_BITS_CLR (u32_used_aggrs, 1UL << u8_aggr_idx))
+        {
+            g_astru_aggregators[u8_aggr_idx].u32_period = 0;
+        }
+    }
+
+    /* Start aggregating the periods newly requested */
+    for (uint8_t u8_client_id = 0; u8_client_id < RTLOG_MAX_CLIENTS; u8_client_id++)
+    {
+        uint32_t u32_period = g_au32_client_periods[u8_client_id];
+        if ((u32_period == 0) || (g_aenm_client_formats[u8_client_id] == RTLOG_FORMAT_NONE))
+        {
+            continue;
+        }
+
+        uint8_t u8_free_idx = RTLOG_MAX_AGGREGATORS;
+        uint8_t u8_aggr_idx;
+        for (u8_aggr_idx = 0; u8_aggr_idx < RTLOG_MAX_AGGREGATORS; u8_aggr_idx++)
+        {
+            if (g_astru_aggregators[u8_aggr_idx].u32_period == u32_period)
+            {
+                break;
+            }
+            if ((g_astru_aggregators[u8_aggr_idx].u32_period == 0) && (u8_free_idx == RTLOG_MAX_AGGREGATORS))
+            {
+                u8_free_idx = u8_aggr_idx;
+            }
+        }
+        if ((u8_aggr_idx == RTLOG_MAX_AGGREGATORS) && (u8_free_idx < RTLOG_MAX_AGGREGATORS))
+        {
+            RTLOG_aggregator_t * pstru_aggr = &g_astru_aggregators[u8_free_idx];
+            pstru_aggr->u32_period = u32_period;
+            pstru_aggr->u32_window_start = u32_timestamp - (u32_timestamp % u32_period);
+            pstru_aggr->u32_num_samples = 0;
+            pstru_aggr->u32_meas_mask = 0;
+        }
+    }
+
+    /* Send the windows that have ended, then add the sample to the current windows */
+    for (uint8_t u8_aggr_idx = 0; u8_aggr_idx < RTLOG_MAX_AGGREGATORS; u8_aggr_idx++)
+    {
+        RTLOG_aggregator_t * pstru_aggr = &g_astru_aggregators[u8_aggr_idx];
+        if (pstru_aggr->u32_period == 0)
+        {
+            continue;
+        }
+        if ((u32_timestamp < pstru_aggr->u32_window_start) ||
+            (u32_timestamp - pstru_aggr->u32_window_start >= pstru_aggr->u32_period))
+        {
+            if (pstru_aggr->u32_num_samples != 0)
+            {
+                v_RTLOG_Send_Aggregation (pstru_aggr);
+            }
+            pstru_aggr->u32_window_start = u32_timestamp - (u32_timestamp % pstru_aggr->u32_period);
+            pstru_aggr->u32_num_samples = 0;
+            pstru_aggr->u32_meas_mask = 0;
+        }
+        v_RTLOG_Aggregate_Sample (pstru_aggr, pstru_meas);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Adds a sample of realtime measurements to the current window of an aggregator
+**
+** @param [in]
+**      pstru_aggr: The aggregator
+**
+** @param [in]
+**      pstru_meas: The sample
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Aggregate_Sample (RTLOG_aggregator_t * pstru_aggr, const RTLOG_rt_meas_t * pstru_meas)
+{
+    uint32_t u32_meas_mask = pstru_meas->u32_meas_mask;
+
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        int32_t s32_raw = pstru_meas->as32_raw[u8_meas_id];
+        u32_meas_mask &= u32_meas_mask - 1;
+
+        /* First value of the measurement in the window */
+        if (ALL_BITS_CLR (pstru_aggr->u32_meas_mask, 1UL << u8_meas_id))
+        {
+            SET_BITS (pstru_aggr->u32_meas_mask, 1UL << u8_meas_id);
+            pstru_aggr->as32_min[u8_meas_id] = s32_raw;
+            pstru_aggr->as32_max[u8_meas_id] = s32_raw;
+            pstru_aggr->as64_sum[u8_meas_id] = 0;
+            pstru_aggr->au32_count[u8_meas_id] = 0;
+        }
+        else if (b_RTLOG_Raw_Less (u8_meas_id, s32_raw, pstru_aggr->as32_min[u8_meas_id]))
+        {
+            pstru_aggr->as32_min[u8_meas_id] = s32_raw;
+        }
+        else if (b_RTLOG_Raw_Less (u8_meas_id, pstru_aggr->as32_max[u8_meas_id], s32_raw))
+        {
+            pstru_aggr->as32_max[u8_meas_id] = s32_raw;
+        }
+
+        pstru_aggr->as64_sum[u8_meas_id] += (g_astru_meas_descs[u8_meas_id].enm_type == RTLOG_U32) ?
+                                            (int64_t)(uint32_t)s32_raw : (int64_t)s32_raw;
+        pstru_aggr->au32_count[u8_meas_id]++;
+    }
+
+    pstru_aggr->u32_num_samples++;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends the aggregated measurements of the current window of an aggregator to the clients requesting its period
+**
+** @param [in]
+**      pstru_aggr: The aggregator
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Send_Aggregation (RTLOG_aggregator_t * pstru_aggr)
+{
+    uint16_t    u16_frame_len = 0;
+    char *      pstri_notify = NULL;
+
+    for (uint8_t u8_client_id = 0; u8_client_id < RTLOG_MAX_CLIENTS; u8_client_id++)
+    {
+        if (g_au32_client_periods[u8_client_id] != pstru_aggr->u32_period)
+        {
+            continue;
+        }
+
+        /* Each format is encoded once, only when a client requires it */
+        if (g_aenm_client_formats[u8_client_id] == RTLOG_FORMAT_BINARY)
+        {
+            if (u16_frame_len == 0)
+            {
+                u16_frame_len = u16_RTLOG_Encode_Aggr_Binary (pstru_aggr, g_au8_aggr_frame);
+            }
+            enm_WSS_Send (g_x_ws_server_inst, u8_client_id, g_au8_aggr_frame, u16_frame_len);
+        }
+        else if (g_aenm_client_formats[u8_client_id] == RTLOG_FORMAT_JSON)
+        {
+            if (pstri_notify == NULL)
+            {
+                pstri_notify = pstri_RTLOG_Encode_Aggr_Json (pstru_aggr);
+            }
+            if (pstri_notify != NULL)
+            {
+                enm_WSS_Send (g_x_ws_server_inst, u8_client_id, pstri_notify, strlen (pstri_notify));
+            }
+        }
+    }
+
+    if (pstri_notify != NULL)
+    {
+        free (pstri_notify);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes the aggregated measurements of the current window of an aggregator into a binary frame
+**
+** @details
+**      See RTLOG_AGGR_HDR_LEN for layout of the frame
+**
+** @param [in]
+**      pstru_aggr: The aggregator, its sequence number is increased
+**
+** @param [out]
+**      pu8_frame: Buffer of at least RTLOG_AGGR_MAX_LEN bytes to store the frame
+**
+** @return
+**      Length in bytes of the encoded frame
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint16_t u16_RTLOG_Encode_Aggr_Binary (RTLOG_aggregator_t * pstru_aggr, uint8_t * pu8_frame)
+{
+    uint8_t *   pu8_value = &pu8_frame[RTLOG_AGGR_HDR_LEN];
+    uint32_t    u32_meas_mask = pstru_aggr->u32_meas_mask;
+
+    /* Header */
+    pu8_frame[0] = RTLOG_BIN_VERSION;
+    pu8_frame[1] = RTLOG_MSG_RT_AGGR;
+    ENDIAN_PUT16 (&pu8_frame[2], pstru_aggr->u16_seq);
+    ENDIAN_PUT32 (&pu8_frame[4], pstru_aggr->u32_window_start);
+    ENDIAN_PUT32 (&pu8_frame[8], u32_meas_mask);
+    ENDIAN_PUT32 (&pu8_frame[12], pstru_aggr->u32_period);
+    ENDIAN_PUT16 (&pu8_frame[16], (pstru_aggr->u32_num_samples < UINT16_MAX) ?
+                                  (uint16_t)pstru_aggr->u32_num_samples : UINT16_MAX);
+    pstru_aggr->u16_seq++;
+
+    /* Minimum, maximum and mean values in their wire types */
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+
+        pu8_value = pu8_RTLOG_Put_Raw (pu8_value, u8_meas_id, pstru_aggr->as32_min[u8_meas_id]);
+        pu8_value = pu8_RTLOG_Put_Raw (pu8_value, u8_meas_id, pstru_aggr->as32_max[u8_meas_id]);
+        pu8_value = pu8_RTLOG_Put_Raw (pu8_value, u8_meas_id, s32_RTLOG_Get_Aggr_Mean (pstru_aggr, u8_meas_id));
+    }
+
+    return (uint16_t)(pu8_value - pu8_frame);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Encodes the aggregated measurements of the current window of an aggregator into a JSON message
+**
+** @details
+**      Format of the message:
+**          {"Timestamp":<start of window>,"Period":<ms>,"Samples":<n>,"<name>":{"min":x,"max":y,"mean":z},...}
+**
+** @param [in]
+**      pstru_aggr: The aggregator
+**
+** @return
+**      @arg    NULL: Failed to encode the message
+**      @arg    Otherwise: NULL-terminated JSON message, which must be freed by the caller
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static char * pstri_RTLOG_Encode_Aggr_Json (const RTLOG_aggregator_t * pstru_aggr)
+{
+    uint32_t u32_meas_mask = pstru_aggr->u32_meas_mask;
+
+    /* Construct JSON message object */
+    cJSON * px_notify_root = cJSON_CreateObject ();
+    if (px_notify_root == NULL)
+    {
+        return NULL;
+    }
+    cJSON_AddNumberToObject (px_notify_root, "Timestamp", pstru_aggr->u32_window_start);
+    cJSON_AddNumberToObject (px_notify_root, "Period", pstru_aggr->u32_period);
+    cJSON_AddNumberToObject (px_notify_root, "Samples", pstru_aggr->u32_num_samples);
+
+    /* Add statistics of each measurement */
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+
+        cJSON * px_json_stats = cJSON_AddObjectToObject (px_notify_root, g_astru_meas_descs[u8_meas_id].pstri_name);
+        if (px_json_stats != NULL)
+        {
+            cJSON_AddNumberToObject (px_json_stats, "min",
+                                     flt_RTLOG_Scale_Raw (u8_meas_id, pstru_aggr->as32_min[u8_meas_id]));
+            cJSON_AddNumberToObject (px_json_stats, "max",
+                                     flt_RTLOG_Scale_Raw (u8_meas_id, pstru_aggr->as32_max[u8_meas_id]));
+            cJSON_AddNumberToObject (px_json_stats, "mean",
+                                     (double)pstru_aggr->as64_sum[u8_meas_id] / pstru_aggr->au32_count[u8_meas_id] /
+                                     g_astru_meas_descs[u8_meas_id].flt_scale);
+        }
+    }
+
+    /* Print the message without formatting to keep it short */
+    char * pstri_notify = cJSON_PrintUnformatted (px_notify_root);
+    cJSON_Delete (px_notify_root);
+    return pstri_notify;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets mean raw value of a measurement in the current window of an aggregator, rounded to nearest
+**
+** @param [in]
+**      pstru_aggr: The aggregator
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement, its bit must be set in the mask of the aggregator
+**
+** @return
+**      Mean raw value, in the range of the wire type of the measurement
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static int32_t s32_RTLOG_Get_Aggr_Mean (const RTLOG_aggregator_t * pstru_aggr, uint8_t u8_meas_id)
+{
+    int64_t s64_sum = pstru_aggr->as64_sum[u8_meas_id];
+    int64_t s64_count = pstru_aggr->au32_count[u8_meas_id];
+
+    return (int32_t)((s64_sum + ((s64_sum >= 0) ? s64_count / 2 : -s64_count / 2)) / s64_count);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Compares 2 raw values of a measurement according to its wire type
+**
+** @param [in]
+**      u8_meas_id: ID of the measurement
+**
+** @param [in]
+**      s32_raw_1, s32_raw_2: The raw values to compare
+**
+** @return
+**      @arg    true: s32_raw_1 is less than s32_raw_2
+**      @arg    false: Otherwise
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_RTLOG_Raw_Less (uint8_t u8_meas_id, int32_t s32_raw_1, int32_t s32_raw_2)
+{
+    if (g_astru_meas_descs[u8_meas_id].enm_type == RTLOG_U32)
+    {
+        return ((uint32_t)s32_raw_1 < (uint32_t)s32_raw_2);
+    }
+    return (s32_raw_1 < s32_raw_2);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Callback invoked when an event occurs to the Websocket channel of realtime log messages
+**
+** @details
+**      A newly connected client receives the schema then binary frames of every sample. A client can send the
+**      following requests (keys can be combined in one request):
+**          {"format": "binary"}    : receive binary frames
+**          {"format": "json"}      : receive JSON messages
+**          {"schema": true}        : receive the schema again before the next message
+**          {"period": <ms>}        : receive minimum, maximum and mean of the measurements in each window of <ms>
+**                                    milliseconds instead of every sample, 0 to receive every sample again
+**
+**      A client receiving every sample can also subscribe to a part of them (see Srvc_WS_Server module):
+**          {"subscribe": {"topics": [0], "mask": <mask>, "rate": <hz>}}
+**      + mask: bit x is 1 to receive measurement ID x, the samples without any of these measurements are not sent
+**      + rate: maximum number of samples per second, the other samples are skipped (gaps in sequence numbers)
+**
+** @param [in]
+**      pstru_evt_data: Context data of the event
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_WSS_Callback (WSS_evt_data_t * pstru_evt_data)
+{
+    uint8_t u8_client_id = pstru_evt_data->u8_client_id;
+
+    /* Validation */
+    if (u8_client_id >= RTLOG_MAX_CLIENTS)
+    {
+        LOGE ("Websocket client index %d exceeds the maximum number of clients tracked", u8_client_id);
+        return;
+    }
+
+    switch (pstru_evt_data->enm_evt)
+    {
+        case WSS_EVT_CLIENT_CONNECTED:
+            g_au32_client_periods[u8_client_id] = 0;
+            g_aenm_client_formats[u8_client_id] = RTLOG_FORMAT_BINARY;
+            g_ab_schema_pending[u8_client_id] = true;
+            v_RTLOG_Update_Encoding (u8_client_id);
+            break;
+
+        case WSS_EVT_CLIENT_DISCONNECTED:
+            g_aenm_client_formats[u8_client_id] = RTLOG_FORMAT_NONE;
+            g_ab_schema_pending[u8_client_id] = false;
+            g_au32_client_periods[u8_client_id] = 0;
+            break;
+
+        case WSS_EVT_SUBSCRIBED:
+            LOGI ("Realtime log client %d subscribes to measurement mask 0x%08X every %u ms (0: every sample)",
+                  u8_client_id, pstru_evt_data->stru_sub.u32_mask, pstru_evt_data->stru_sub.u32_min_period);
+            break;
+
+        case WSS_EVT_DATA_RECEIVED:
+        {
+            /* Parse the request */
+            cJSON * px_json_root = cJSON_ParseWithLength ((const char *)pstru_evt_data->stru_receive.pu8_data,
+                                                          pstru_evt_data->stru_receive.u16_len);
+            cJSON * px_json_format = cJSON_GetObjectItem (px_json_root, "format");
+            cJSON * px_json_schema = cJSON_GetObjectItem (px_json_root, "schema");
+            cJSON * px_json_period = cJSON_GetObjectItem (px_json_root, "period");
+            if (cJSON_IsTrue (px_json_schema))
+            {
+                g_ab_schema_pending[u8_client_id] = true;
+            }
+            if (px_json_period != NULL)
+            {
+                v_RTLOG_Set_Client_Period (u8_client_id, px_json_period);
+            }
+            if (px_json_format == NULL)
+            {
+                if ((px_json_schema == NULL) && (px_json_period == NULL))
+                {
+                    LOGW ("Invalid request from realtime log client %d: %.*s", u8_client_id,
+                          (pstru_evt_data->stru_receive.u16_len < RTLOG_MAX_REQUEST_LEN) ?
+                          pstru_evt_data->stru_receive.u16_len : RTLOG_MAX_REQUEST_LEN,
+                          (const char *)pstru_evt_data->stru_receive.pu8_data);
+                }
+            }
+            else if (cJSON_IsString (px_json_format) && (strcmp (px_json_format->valuestring, "json") == 0))
+            {
+                LOGI ("Realtime log client %d selects JSON format", u8_client_id);
+                g_aenm_client_formats[u8_client_id] = RTLOG_FORMAT_JSON;
+            }
+            else if (cJSON_IsString (px_json_format) && (strcmp (px_json_format->valuestring, "binary") == 0))
+            {
+                LOGI ("Realtime log client %d selects binary format", u8_client_id);
+                g_aenm_client_formats[u8_client_id] = RTLOG_FORMAT_BINARY;
+            }
+            else
+            {
+                LOGW ("Unknown format requested by realtime log client %d", u8_client_id);
+            }
+            cJSON_Delete (px_json_root);
+            v_RTLOG_Update_Encoding (u8_client_id);
+            break;
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sets the period of aggregated messages requested by a Websocket client
+**
+** @details
+**      The request is rejected if the period is invalid, or if RTLOG_MAX_AGGREGATORS different periods are already
+**      requested by the other clients. The client then keeps its current period.
+**
+** @param [in]
+**      u8_client_id: Index of the client
+**
+** @param [in]
+**      px_json_period: Value of "period" key in the request of the client
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Set_Client_Period (uint8_t u8_client_id, const cJSON * px_json_period)
+{
+    uint32_t au32_periods[RTLOG_MAX_CLIENTS];
+    uint8_t  u8_num_periods = 0;
+    bool     b_shared = false;
+
+    if (!cJSON_IsNumber (px_json_period) || (px_json_period->valuedouble < 0) ||
+        (px_json_period->valuedouble > RTLOG_MAX_AGGR_PERIOD))
+    {
+        LOGW ("Invalid period requested by realtime log client %d", u8_client_id);
+        return;
+    }
+    uint32_t u32_period = (uint32_t)px_json_period->valuedouble;
+
+    /* Count the different periods requested by the other clients */
+    for (uint8_t u8_idx = 0; (u8_idx < RTLOG_MAX_CLIENTS) && (u32_period != 0); u8_idx++)
+    {
+        uint32_t u32_other_period = g_au32_client_periods[u8_idx];
+        uint8_t  u8_period_idx;
+
+        if ((u8_idx == u8_client_id) || (u32_other_period == 0) ||
+            (g_aenm_client_formats[u8_idx] == RTLOG_FORMAT_NONE))
+        {
+            continue;
+        }
+        if (u32_other_period == u32_period)
+        {
+            /* The period is already aggregated for another client */
+            b_shared = true;
+            break;
+        }
+        for (u8_period_idx = 0; u8_period_idx < u8_num_periods; u8_period_idx++)
+        {
+            if (au32_periods[u8_period_idx] == u32_other_period)
+            {
+                break;
+            }
+        }
+        if (u8_period_idx == u8_num_periods)
+        {
+            au32_periods[u8_num_periods++] = u32_other_period;
+        }
+    }
+    if (!b_shared && (u8_num_periods >= RTLOG_MAX_AGGREGATORS))
+    {
+        LOGW ("Too many different periods requested by realtime log clients, request of client %d is rejected",
+              u8_client_id);
+        return;
+    }
+
+    LOGI ("Realtime log client %d selects period %u ms", u8_client_id, u32_period);
+    g_au32_client_periods[u8_client_id] = u32_period;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Selects the encoding of the samples published to a Websocket client according to its format and period
+**
+** @details
+**      A client having requested a period only receives the aggregated measurements, so its encoding is
+**      RTLOG_FORMAT_NONE and no sample is encoded for it.
+**
+** @param [in]
+**      u8_client_id: Index of the client
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Update_Encoding (uint8_t u8_client_id)
+{
+    RTLOG_format_t enm_format = (g_au32_client_periods[u8_client_id] == 0) ?
+                                g_aenm_client_formats[u8_client_id] : RTLOG_FORMAT_NONE;
+    enm_WSS_Set_Encoding (g_x_ws_server_inst, u8_client_id, (uint8_t)enm_format);
+}
+
+#ifdef CONFIG_RTLOG_BENCHMARK_ENABLED
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Measures the number of realtime measurement samples per second that one core can decode and encode in binary
+**      and JSON formats, and prints the results
+**
+** @note
+**      Sending over Websocket is not included because it depends on the network
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_RTLOG_Run_Benchmark (void)
+{
+    RTLOG_rt_meas_t stru_meas;
+    uint8_t         au8_data[4 + RTLOG_NUM_MEAS * sizeof (int32_t)];
+    uint8_t         u8_data_len = 4;
+    uint32_t        u32_meas_mask = RTLOG_DEFINED_MEAS_MASK;
+    uint16_t        u16_bin_len = 0;
+    uint32_t        u32_json_len = 0;
+
+    /* Construct a message containing all defined measurements */
+    ENDIAN_PUT32 (au8_data, u32_meas_mask);
+    while (u32_meas_mask != 0)
+    {
+        uint8_t u8_meas_id = __builtin_ctz (u32_meas_mask);
+        u32_meas_mask &= u32_meas_mask - 1;
+        memset (&au8_data[u8_data_len], u8_meas_id, g_astru_meas_descs[u8_meas_id].u8_size);
+        u8_data_len += g_astru_meas_descs[u8_meas_id].u8_size;
+    }
+
+    /* Binary format */
+    int64_t s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < RTLOG_BENCHMARK_SAMPLES; u32_idx++)
+    {
+        b_RTLOG_Decode_Rt_Meas (u32_idx, au8_data, u8_data_len, &stru_meas);
+        u16_bin_len = u16_RTLOG_Encode_Binary (&stru_meas, g_au8_bin_frame);
+    }
+    int64_t s64_bin_time = esp_timer_get_time () - s64_start;
+
+    /* JSON format */
+    s64_start = esp_timer_get_time ();
+    for (uint32_t u32_idx = 0; u32_idx < RTLOG_BENCHMARK_SAMPLES; u32_idx++)
+    {
+        b_RTLOG_Decode_Rt_Meas (u32_idx, au8_data, u8_data_len, &stru_meas);
+        char * pstri_notify = pstri_RTLOG_Encode_Json (&stru_meas);
+        if (pstri_notify != NULL)
+        {
+            u32_json_len = strlen (pstri_notify);
+            free (pstri_notify);
+        }
+    }
+    int64_t s64_json_time = esp_timer_get_time () - s64_start;
+
+    /* Avoid division by zero */
+    s64_bin_time = (s64_bin_time > 0) ? s64_bin_time : 1;
+    s64_json_time = (s64_json_time > 0) ? s64_json_time : 1;
+
+    LOGI ("Benchmark of %d samples on core %d:", RTLOG_BENCHMARK_SAMPLES, xPortGetCoreID ());
+    LOGI ("  Binary: %lld us, %lld samples/s, %d bytes/sample", s64_bin_time,
+          RTLOG_BENCHMARK_SAMPLES * 1000000LL / s64_bin_time, u16_bin_len);
+    LOGI ("  JSON  : %lld us, %lld samples/s, %d bytes/sample", s64_json_time,
+          RTLOG_BENCHMARK_SAMPLES * 1000000LL / s64_json_time, (int)u32_json_len);
 }
+#endif
 
 /**
 ** @}
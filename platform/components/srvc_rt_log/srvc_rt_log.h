@@ -26,6 +26,7 @@
 */
 
 #include "common_hdr.h"             /* Use common definitions */
+#include "srvc_rt_log_ext.h"        /* Table of realtime measurements */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -33,6 +34,34 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/** @brief  Expand an entry in RTLOG_MEAS_TABLE as enumeration of measurement ID */
+#define RTLOG_MEAS_TABLE_EXPAND_AS_MEAS_ID(MEAS_ID, BIT, ...)       MEAS_ID = BIT,
+typedef enum
+{
+    RTLOG_MEAS_TABLE (RTLOG_MEAS_TABLE_EXPAND_AS_MEAS_ID)
+    RTLOG_NUM_MEAS = 32                 //!< Number of measurement IDs supported by the measurement mask
+} RTLOG_meas_id_t;
+
+/** @brief  Default name of the CSV file exported by s32_RTLOG_Store_Export() */
+#define RTLOG_EXPORT_FILE               "rtlog.csv"
+
+/** @brief  Bit mask selecting all measurements */
+#define RTLOG_ALL_MEAS                  0xFFFFFFFFUL
+
+/** @brief  Realtime measurement values of a sample */
+typedef struct
+{
+    uint32_t            u32_timestamp;                  //!< Timestamp in milliseconds of the sample
+    uint32_t            u32_meas_mask;                  //!< Measurement ID x is available if bit x is 1
+    int32_t             as32_raw[RTLOG_NUM_MEAS];       //!< Raw value of measurement ID x (see RTLOG_MEAS_TABLE)
+} RTLOG_rt_meas_t;
+
+/**
+** @brief   Function invoked for each sample found by s32_RTLOG_Store_Query()
+** @return  true to continue the query, false to stop it
+*/
+typedef bool (*RTLOG_query_cb_t) (const RTLOG_rt_meas_t * pstru_meas, void * pv_arg);
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -42,6 +71,26 @@
 /* Parses the raw data of realtime log message and processes it */
 extern void v_RTLOG_Process_Log_Data (uint32_t u32_timestamp, uint8_t u8_msg_id, const void * pv_data, uint8_t u8_len);
 
+/* Gets name of a measurement */
+extern const char * pstri_RTLOG_Get_Meas_Name (uint8_t u8_meas_id);
+
+/* Gets physical value of a measurement */
+extern float flt_RTLOG_Get_Value (const RTLOG_rt_meas_t * pstru_meas, uint8_t u8_meas_id);
+
+/* Initializes the time-series store of realtime measurements */
+extern int32_t s32_RTLOG_Store_Init (void);
+
+/* Writes the samples staged in RAM onto flash */
+extern int32_t s32_RTLOG_Store_Flush (void);
+
+/* Reads stored realtime measurements in a time range */
+extern int32_t s32_RTLOG_Store_Query (uint32_t u32_start_time, uint32_t u32_end_time, uint32_t u32_meas_mask,
+                                      RTLOG_query_cb_t pfnc_cb, void * pv_arg, uint32_t * pu32_num_samples);
+
+/* Exports stored realtime measurements in a time range to a CSV file */
+extern int32_t s32_RTLOG_Store_Export (const char * pstri_file_path, uint32_t u32_start_time, uint32_t u32_end_time,
+                                       uint32_t u32_meas_mask, uint32_t * pu32_num_samples);
+
 #endif /* __SRVC_RT_LOG_H__ */
 
 /**
@@ -0,0 +1,90 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : srvc_rt_log_ext.h
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 8
+**  @brief      : Header file containing configuration of Srvc_Rt_Log module
+**  @namespace  : RTLOG
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_Rt_Log
+** @{
+*/
+
+#ifndef __SRVC_RT_LOG_EXT_H__
+#define __SRVC_RT_LOG_EXT_H__
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @brief   This table defines realtime measurements that slave board can send in realtime measurement messages
+** @details
+**
+** Each realtime measurement message starts with a 32-bit mask. Measurement ID x is available in the message if bit x
+** of the mask is 1, and the values of available measurements follow the mask in ascending order of ID. Each entry in
+** this table describes one measurement and has the following properties:
+**
+** - Meas_ID                : Alias of the measurement. Its value is the bit position of the measurement in the mask
+**
+** - Bit                    : Bit position of the measurement in the mask (0 -> 31). This must be a literal number
+**
+** - Name                   : Name of the measurement, used as key of JSON messages and in the schema
+**
+** - Type                   : Wire type of the raw value (RTLOG_U8, RTLOG_I8, RTLOG_U16, RTLOG_I16, RTLOG_U32, RTLOG_I32)
+**
+** - Scale                  : Physical value = raw value / Scale. For example, fix16_t values have scale of 65536.
+**                            This must be a literal number
+**
+** - Unit                   : Unit of the physical value
+**
+** The decoder, the JSON and binary encoders and the schema sent to Websocket clients are all generated from this
+** table, so adding a measurement only requires a new entry here.
+*/
+#define RTLOG_MEAS_TABLE(X)                                                                                             \
+                                                                                                                        \
+/*--------------------------------------------------------------------------------------------------------------------*/\
+/*  Meas_ID                   Bit   Name                            Type        Scale       Unit                      */\
+/*--------------------------------------------------------------------------------------------------------------------*/\
+                                                                                                                        \
+X(  RTLOG_TOP_HEATER_TEMP,    0,    "Top heater temperature",       RTLOG_I32,  65536,      "degC"                    )\
+X(  RTLOG_BTM_HEATER_TEMP,    1,    "Bottom heater temperature",    RTLOG_I32,  65536,      "degC"                    )\
+                                                                                                                        \
+/*--------------------------------------------------------------------------------------------------------------------*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+#endif /* __SRVC_RT_LOG_EXT_H__ */
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
@@ -0,0 +1,114 @@
+/*
+ * (C) Copyright 2022
+ * Zimplistic Private Limited
+ *
+ * Decoder of binary realtime log frames sent by Srvc_Rt_Log on Websocket channel /slave/rtlog.
+ * See rtlog_decode.py for the frame layout. Aggregated frames (after sending {"period": <ms>}) are decoded into
+ * {min, max, mean} objects per measurement.
+ *
+ * Opening /slave/rtlog?deflate=1 requests compressed messages (raw DEFLATE, permessage-deflate format of RFC 7692).
+ * Feed each message appended with 00 00 FF FF to one raw inflater kept for the connection (e.g. pako.Inflate with
+ * {raw: true}) before decoding it.
+ *
+ * Sending {"subscribe": {"mask": <mask>, "rate": <hz>}} limits the measurements and the number of samples per second
+ * received. The skipped samples appear as gaps in sequence numbers.
+ *
+ * Usage in browser:
+ *     let schema = null;
+ *     const ws = new WebSocket('ws://' + deviceIp + '/slave/rtlog');
+ *     ws.binaryType = 'arraybuffer';
+ *     ws.onmessage = (evt) => {
+ *         const bytes = new Uint8Array(evt.data);
+ *         if (bytes[0] === 0x7B) {    // '{'
+ *             schema = parseRtLogSchema(new TextDecoder().decode(bytes));
+ *         } else if (schema) {
+ *             console.log(decodeRtLog(evt.data, schema));
+ *         }
+ *     };
+ */
+
+const RTLOG_FORMAT_VERSION = 2;
+const RTLOG_MSG_RT_MEAS = 0x11;
+const RTLOG_MSG_RT_AGGR = 0x12;
+const RTLOG_HDR_LEN = 12;
+const RTLOG_AGGR_HDR_LEN = 18;
+
+/* Size and DataView getter of each wire type in the schema */
+const RTLOG_WIRE_TYPES = {
+    u8: [1, 'getUint8'], i8: [1, 'getInt8'],
+    u16: [2, 'getUint16'], i16: [2, 'getInt16'],
+    u32: [4, 'getUint32'], i32: [4, 'getInt32'],
+};
+
+/* Parses the schema message into a map of measurement ID -> {name, size, getter, scale} */
+function parseRtLogSchema(text) {
+    const schema = JSON.parse(text);
+    if (schema.schema !== 'rtlog' || schema.version !== RTLOG_FORMAT_VERSION) {
+        throw new Error('Unsupported schema ' + text);
+    }
+    const measurements = {};
+    for (const field of schema.fields) {
+        if (field.id !== undefined) {
+            const [size, getter] = RTLOG_WIRE_TYPES[field.type];
+            measurements[field.id] = { name: field.name, size: size, getter: getter, scale: field.scale };
+        }
+    }
+    return measurements;
+}
+
+/* Decodes a binary frame (ArrayBuffer) into an object of the same keys as JSON messages, plus sequence number */
+function decodeRtLog(buffer, measurements) {
+    const view = new DataView(buffer);
+    if (view.byteLength < RTLOG_HDR_LEN) {
+        throw new Error('Frame is too short (' + view.byteLength + ' bytes)');
+    }
+    if (view.getUint8(0) !== RTLOG_FORMAT_VERSION) {
+        throw new Error('Unsupported format version ' + view.getUint8(0));
+    }
+
+    const msgId = view.getUint8(1);
+    const sample = {
+        Seq: view.getUint16(2, true),
+        Timestamp: view.getUint32(4, true),
+    };
+    let offset = RTLOG_HDR_LEN;
+    if (msgId === RTLOG_MSG_RT_AGGR) {
+        if (view.byteLength < RTLOG_AGGR_HDR_LEN) {
+            throw new Error('Frame is too short (' + view.byteLength + ' bytes)');
+        }
+        sample.Period = view.getUint32(12, true);
+        sample.Samples = view.getUint16(16, true);
+        offset = RTLOG_AGGR_HDR_LEN;
+    } else if (msgId !== RTLOG_MSG_RT_MEAS) {
+        throw new Error('Unsupported message ID ' + msgId);
+    }
+
+    const numValues = (msgId === RTLOG_MSG_RT_AGGR) ? 3 : 1;
+    let mask = view.getUint32(8, true);
+    for (let measId = 0; mask !== 0; measId++, mask >>>= 1) {
+        if (mask & 1) {
+            const meas = measurements[measId];
+            if (meas === undefined) {
+                throw new Error('Measurement ID ' + measId + ' is not in the schema');
+            }
+            if (offset + numValues * meas.size > view.byteLength) {
+                throw new Error('Frame is truncated at measurement ID ' + measId);
+            }
+            const values = [];
+            for (let idx = 0; idx < numValues; idx++) {
+                values.push(view[meas.getter](offset + idx * meas.size, true) / meas.scale);
+            }
+            if (msgId === RTLOG_MSG_RT_AGGR) {
+                sample[meas.name] = { min: values[0], max: values[1], mean: values[2] };
+            } else {
+                sample[meas.name] = values[0];
+            }
+            offset += numValues * meas.size;
+        }
+    }
+    return sample;
+}
+
+if (typeof module !== 'undefined') {
+    module.exports = { parseRtLogSchema, decodeRtLog };
+}
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+#
+# (C) Copyright 2022
+# Zimplistic Private Limited
+#
+# Decoder of binary realtime log frames sent by Srvc_Rt_Log on Websocket channel /slave/rtlog.
+#
+# Frame layout (little endian):
+#     0   u8      format version (2)
+#     1   u8      message ID (0x11: realtime measurement)
+#     2   u16     sequence number
+#     4   u32     timestamp in milliseconds
+#     8   u32     measurement mask, measurement ID x is available if bit x is 1
+#     12  ...     raw values of the available measurements in ascending order of ID
+#
+# A client requesting a period ({"period": <ms>}) receives aggregated frames instead, one per window of the period:
+#     0   u8      format version (2)
+#     1   u8      message ID (0x12: aggregated realtime measurements)
+#     2   u16     sequence number
+#     4   u32     timestamp in milliseconds of the start of the window
+#     8   u32     measurement mask, measurement ID x is available if bit x is 1
+#     12  u32     length of the window in milliseconds
+#     16  u16     number of samples in the window
+#     18  ...     minimum, maximum and mean raw values of each available measurement in ascending order of ID
+#
+# Type, scale and unit of each measurement are given by the schema, a JSON message sent by the device before the
+# first frame (or on request {"schema": true}). Messages starting with '{' are JSON, others are binary frames.
+# A client receives binary frames by default. It can switch to JSON messages by sending {"format": "json"}.
+#
+# A client opening /slave/rtlog?deflate=1 receives every message compressed with raw DEFLATE (permessage-deflate
+# format, RFC 7692). Each message is inflated after appending 00 00 FF FF, with one inflater kept for the connection.
+#
+# A client receiving every sample can subscribe to some measurements and limit the number of samples per second by
+# sending {"subscribe": {"mask": <mask>, "rate": <hz>}}. The skipped samples appear as gaps in sequence numbers.
+#
+# Usage:
+#     python rtlog_decode.py <device_ip> [--json] [--period MS] [--deflate] [--mask MASK] [--rate HZ] [--count N]
+#
+# Connecting to the device requires websocket-client package (pip install websocket-client).
+#
+
+import argparse
+import json
+import struct
+import sys
+import time
+import zlib
+
+FORMAT_VERSION = 2
+MSG_RT_MEAS = 0x11
+MSG_RT_AGGR = 0x12
+HDR_FORMAT = '<BBHII'
+HDR_LEN = struct.calcsize(HDR_FORMAT)
+AGGR_HDR_FORMAT = '<IH'
+AGGR_HDR_LEN = HDR_LEN + struct.calcsize(AGGR_HDR_FORMAT)
+
+# struct format of each wire type in the schema
+WIRE_TYPES = {'u8': '<B', 'i8': '<b', 'u16': '<H', 'i16': '<h', 'u32': '<I', 'i32': '<i'}
+
+
+def parse_schema(message):
+    """Parses the schema message into a dictionary of measurement ID -> (name, struct format, scale)"""
+    schema = json.loads(message)
+    if schema.get('schema') != 'rtlog' or schema.get('version') != FORMAT_VERSION:
+        raise ValueError('Unsupported schema %s' % message)
+    return {field['id']: (field['name'], WIRE_TYPES[field['type']], field['scale'])
+            for field in schema['fields'] if 'id' in field}
+
+
+def decode(frame, measurements):
+    """Decodes a binary frame into a dictionary of the same keys as JSON messages, plus sequence number"""
+    if len(frame) < HDR_LEN:
+        raise ValueError('Frame is too short (%d bytes)' % len(frame))
+
+    version, msg_id, seq, timestamp, mask = struct.unpack_from(HDR_FORMAT, frame)
+    if version != FORMAT_VERSION:
+        raise ValueError('Unsupported format version %d' % version)
+
+    sample = {'Seq': seq, 'Timestamp': timestamp}
+    if msg_id == MSG_RT_MEAS:
+        offset = HDR_LEN
+        num_values = 1
+    elif msg_id == MSG_RT_AGGR:
+        if len(frame) < AGGR_HDR_LEN:
+            raise ValueError('Frame is too short (%d bytes)' % len(frame))
+        sample['Period'], sample['Samples'] = struct.unpack_from(AGGR_HDR_FORMAT, frame, HDR_LEN)
+        offset = AGGR_HDR_LEN
+        num_values = 3
+    else:
+        raise ValueError('Unsupported message ID 0x%02X' % msg_id)
+
+    meas_id = 0
+    while mask:
+        if mask & 1:
+            if meas_id not in measurements:
+                raise ValueError('Measurement ID %d is not in the schema' % meas_id)
+            name, fmt, scale = measurements[meas_id]
+            if offset + num_values * struct.calcsize(fmt) > len(frame):
+                raise ValueError('Frame is truncated at measurement ID %d' % meas_id)
+            values = [struct.unpack_from(fmt, frame, offset + idx * struct.calcsize(fmt))[0] / scale
+                      for idx in range(num_values)]
+            if msg_id == MSG_RT_MEAS:
+                sample[name] = values[0]
+            else:
+                sample[name] = {'min': values[0], 'max': values[1], 'mean': values[2]}
+            offset += num_values * struct.calcsize(fmt)
+        mask >>= 1
+        meas_id += 1
+    return sample
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Receive and decode realtime log of the device')
+    parser.add_argument('device', help='IP address of the device')
+    parser.add_argument('--json', action='store_true', help='request JSON messages instead of binary frames')
+    parser.add_argument('--period', type=int, default=0,
+                        help='receive min/max/mean of each window of this period in ms instead of every sample')
+    parser.add_argument('--deflate', action='store_true', help='request compressed messages')
+    parser.add_argument('--mask', type=lambda text: int(text, 0), default=None,
+                        help='receive only the measurements whose ID bit is 1 in this mask (e.g. 0x0F)')
+    parser.add_argument('--rate', type=int, default=0, help='receive at most this number of samples per second')
+    parser.add_argument('--count', type=int, default=0, help='stop after receiving this number of samples')
+    args = parser.parse_args()
+
+    try:
+        import websocket
+    except ImportError:
+        print('Error: websocket-client package is required', file=sys.stderr)
+        return 1
+
+    ws = websocket.create_connection('ws://%s/slave/rtlog%s' % (args.device, '?deflate=1' if args.deflate else ''))
+    inflater = zlib.decompressobj(-zlib.MAX_WBITS) if args.deflate else None
+    if args.json:
+        ws.send(json.dumps({'format': 'json'}))
+    if args.period:
+        ws.send(json.dumps({'period': args.period}))
+    subscription = {}
+    if args.mask is not None:
+        subscription['mask'] = args.mask
+    if args.rate:
+        subscription['rate'] = args.rate
+    if subscription:
+        ws.send(json.dumps({'subscribe': subscription}))
+
+    measurements = None
+    num_samples = 0
+    num_lost = 0
+    num_bytes = 0
+    last_seq = None
+    start = time.monotonic()
+    try:
+        while (args.count == 0) or (num_samples < args.count):
+            data = ws.recv()
+            num_bytes += len(data)
+            if inflater is not None:
+                data = inflater.decompress(data + b'\x00\x00\xff\xff')
+            if data[:1] in ('{', b'{'):
+                message = json.loads(data)
+                if 'schema' in message:
+                    measurements = parse_schema(data)
+                    continue
+                sample = message
+            elif measurements is None:
+                continue
+            else:
+                sample = decode(data, measurements)
+                if last_seq is not None:
+                    num_lost += (sample['Seq'] - last_seq - 1) & 0xFFFF
+                last_seq = sample['Seq']
+            num_samples += 1
+            print(sample)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        ws.close()
+
+    elapsed = max(time.monotonic() - start, 1e-6)
+    print('%d samples in %.1f s (%.1f samples/s, %.1f bytes/sample), %d %s' %
+          (num_samples, elapsed, num_samples / elapsed, num_bytes / max(num_samples, 1), num_lost,
+           'skipped or lost' if subscription else 'lost'))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
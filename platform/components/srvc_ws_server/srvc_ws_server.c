@@ -15,7 +15,9 @@
 **
 ** @brief       This module provides one Websocket server which has multiple communication channels. Each channel is
 **              represented by and accessed via a URI. Multiple Websocket clients can concurrently connect to the same
-**              channel.
+**              channel. Each client has a bounded queue of data waiting to be sent, so that a slow client can neither
+**              stall the producers nor exhaust the memory. A client can request the data to be compressed, and can
+**              subscribe to a part of the data published on the channel.
 ** @{
 */
 
@@ -27,6 +29,15 @@
 
 #include "srvc_ws_server.h"         /* Public header of this module */
 #include "esp_http_server.h"        /* Use ESP-IDF HTTP Server component */
+#include "esp_timer.h"              /* Use esp_timer_get_time() */
+#include "freertos/FreeRTOS.h"      /* Use FreeRTOS */
+#include "freertos/task.h"          /* Use xTaskGetTickCount() */
+#include "freertos/semphr.h"        /* Use FreeRTOS semaphore */
+
+#include "cJSON.h"                  /* Use ESP-IDF's JSON component */
+
+#include <string.h>                 /* Use memcpy() */
+#include <unistd.h>                 /* Use close() */
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -34,11 +45,66 @@
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/** @brief  Maximum time in milliseconds enm_WSS_Send() waits for room in the queue of a client (policy WSS_BLOCK) */
+#define WSS_BLOCK_TIMEOUT_MS        200
+
+/** @brief  Maximum number of clients of a channel, so that a set of clients fits in a 32-bit mask */
+#define WSS_MAX_CHANNEL_CLIENTS     32
+
+/** @brief  Maximum rate (messages per second) that a client can subscribe to */
+#define WSS_MAX_SUB_RATE            1000
+
+/** @brief  Maximum period (ms) between 2 messages that a client can subscribe to, lower rates are rounded up */
+#define WSS_MAX_SUB_PERIOD          (24UL * 3600 * 1000)
+
+/** @brief  Clients of a channel receiving the same encoding of the data published by enm_WSS_Publish() */
+typedef struct
+{
+    uint32_t            u32_mask;               //!< Filter subscribed by the clients
+    uint8_t             u8_encoding;            //!< Encoding selected for the clients by the channel owner
+    uint32_t            u32_clients;            //!< Client x is in the class if bit x is 1
+} WSS_sub_class_t;
+
+/**
+** @brief   Data sent to one or several clients by enm_WSS_Send(). It is allocated once and shared by the queues of
+**          all destination clients, and is freed when the last client has sent or dropped it.
+*/
+typedef struct WSS_payload
+{
+    uint32_t                u32_ref_count;      //!< Number of queues holding the payload
+    int64_t                 s64_queued_time;    //!< Time (us) when the payload was queued, to measure latency
+    uint16_t                u16_len;            //!< Length in bytes of the data
+    uint8_t                 au8_data[];         //!< The data
+} WSS_payload_t;
+
 /** @brief  Structure encapsulating connection with a Websocket client */
 typedef struct
 {
     bool                b_active;               //!< Indicate if this connection is active
     int                 x_socket_fd;            //!< Socket descriptor of the client connection
+    WSS_inst_t          x_inst;                 //!< Channel instance of the client
+    uint8_t             u8_client_id;           //!< Index of the client in the channel
+
+    WSS_payload_t **    ppstru_queue;           //!< Ring buffer of payloads waiting to be sent to the client
+    uint8_t             u8_head;                //!< Index of the oldest payload in the queue
+    uint8_t             u8_count;               //!< Number of payloads in the queue
+    bool                b_draining;             //!< A request to send the queued payloads is pending
+    bool                b_closing;              //!< The connection is being closed, nothing is sent any more
+    SemaphoreHandle_t   x_space_sem;            //!< Given when room is made in the queue
+    struct WSS_deflater * pstru_deflater;       //!< Compression context, NULL if the data is sent uncompressed
+
+    WSS_sub_t           stru_sub;               //!< Subscription of the client
+    uint8_t             u8_encoding;            //!< Encoding of published data, set by enm_WSS_Set_Encoding()
+    uint32_t            au32_topic_times[WSS_MAX_TOPICS];   //!< Time (ms) of the last message of each topic
+
+    uint32_t            u32_num_queued;         //!< Number of payloads queued since the client connected
+    uint32_t            u32_num_sent;           //!< Number of payloads sent since the client connected
+    uint32_t            u32_num_dropped;        //!< Number of payloads dropped since the client connected
+    uint32_t            u32_num_drops_in_row;   //!< Number of payloads dropped since the last payload was sent
+    uint64_t            u64_latency_sum;        //!< Sum of latency (us) of all payloads sent
+    uint32_t            u32_max_latency;        //!< Maximum latency (us) of the payloads sent
+    uint32_t            u32_num_raw_bytes;      //!< Number of bytes of the payloads sent, before compression
+    uint32_t            u32_num_tx_bytes;       //!< Number of bytes of the payloads sent, after compression
 } WSS_client_t;
 
 /** @brief  Structure encapsulating a Websocket Server's channel object */
@@ -53,25 +119,40 @@ struct WSS_obj
     const char *        pstri_uri;              //!< URI of the channel
     uint8_t             u8_num_clients;         //!< Maximum number of clients that can connect to the channel at a time
     WSS_client_t *      pstru_clients;          //!< Pointer to the array of Websocket clients
+
+    uint8_t             u8_queue_size;          //!< Maximum number of payloads in the queue of each client
+    WSS_policy_t        enm_policy;             //!< What to do when the queue of a client is full
+    uint32_t            u32_max_drops;          //!< Number of drops in a row disconnecting a client, 0 to never
+    bool                b_deflate;              //!< Clients can request the data to be compressed
+    WSS_payload_t **    ppstru_queues;          //!< Storage of the queues of all clients
+    SemaphoreHandle_t   x_mutex;                //!< Mutex protecting the queues of all clients
 };
 
 /** @brief  Macro expanding WSS_INST_TABLE as initialization value for WSS_obj struct */
-#define INST_TABLE_EXPAND_AS_STRUCT_INIT(INST_ID, URI, CLIENTS)     \
-{                                                                   \
-    .b_initialized      = false,                                    \
-    .enm_inst_id        = INST_ID,                                  \
-                                                                    \
-    .pfnc_cb            = NULL,                                     \
-    .pv_cb_arg          = NULL,                                     \
-                                                                    \
-    .pstri_uri          = URI,                                      \
-    .u8_num_clients     = CLIENTS,                                  \
-    .pstru_clients      = g_astru_clients_##INST_ID,                \
+#define INST_TABLE_EXPAND_AS_STRUCT_INIT(INST_ID, URI, CLIENTS, QUEUE_SIZE, POLICY, MAX_DROPS, DEFLATE) \
+{                                                                                                  \
+    .b_initialized      = false,                                                                   \
+    .enm_inst_id        = INST_ID,                                                                 \
+                                                                                                   \
+    .pfnc_cb            = NULL,                                                                    \
+    .pv_cb_arg          = NULL,                                                                    \
+                                                                                                   \
+    .pstri_uri          = URI,                                                                     \
+    .u8_num_clients     = CLIENTS,                                                                 \
+    .pstru_clients      = g_astru_clients_##INST_ID,                                               \
+                                                                                                   \
+    .u8_queue_size      = QUEUE_SIZE,                                                              \
+    .enm_policy         = POLICY,                                                                  \
+    .u32_max_drops      = MAX_DROPS,                                                               \
+    .b_deflate          = DEFLATE,                                                                 \
+    .ppstru_queues      = &g_apstru_queues_##INST_ID[0][0],                                        \
+    .x_mutex            = NULL,                                                                    \
 },
 
-/** @brief  Macro expanding WSS_INST_TABLE as array of Websocket clients */
-#define INST_TABLE_EXPAND_AS_CLIENT_ARRAY(INST_ID, URI, CLIENTS)    \
-    static WSS_client_t g_astru_clients_##INST_ID [CLIENTS];
+/** @brief  Macro expanding WSS_INST_TABLE as array of Websocket clients and their queues */
+#define INST_TABLE_EXPAND_AS_CLIENT_ARRAY(INST_ID, URI, CLIENTS, QUEUE_SIZE, ...)                  \
+    static WSS_client_t g_astru_clients_##INST_ID [CLIENTS];                                       \
+    static WSS_payload_t * g_apstru_queues_##INST_ID [CLIENTS][QUEUE_SIZE];
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -85,7 +166,7 @@ static const char * TAG = "Srvc_WS_Server";
 /** @brief  Indicates if this module has been initialized */
 static bool g_b_initialized = false;
 
-/** @brief  Arrays of all Websocket clients */
+/** @brief  Arrays of all Websocket clients and their queues */
 WSS_INST_TABLE (INST_TABLE_EXPAND_AS_CLIENT_ARRAY)
 
 /** @brief  Array of all channel objects of the Websocket server */
@@ -97,6 +178,9 @@ static struct WSS_obj g_astru_channel_objs[WSS_NUM_INST] =
 /** @brief  Handle of the Websocket server */
 static httpd_handle_t g_x_server;
 
+/** @brief  Handle of the task of HTTP server, which must never wait for room in the queue of a client */
+static TaskHandle_t g_x_server_task = NULL;
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -106,7 +190,20 @@ static httpd_handle_t g_x_server;
 static int32_t s32_WSS_Init_Module (void);
 static int32_t s32_WSS_Init_Inst (WSS_inst_t x_inst);
 static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * stru_request);
+static void v_WSS_Close_Session (httpd_handle_t x_server, int x_sock_fd);
 static bool b_WSS_Is_Client_Active (WSS_inst_t x_inst, uint8_t u8_client_id);
+static void v_WSS_Remove_Client (WSS_inst_t x_inst, uint8_t u8_client_id);
+static bool b_WSS_Enqueue (WSS_client_t * pstru_client, WSS_payload_t * pstru_payload);
+static void v_WSS_Drain_Work (void * pv_arg);
+static void v_WSS_Get_Server_Task (void * pv_arg);
+static void v_WSS_Flush_Queue (WSS_client_t * pstru_client);
+static void v_WSS_Release_Payload (WSS_payload_t * pstru_payload);
+static void v_WSS_Check_All_Clients (void);
+static WSS_status_t enm_WSS_Send_To_Clients (WSS_inst_t x_inst, uint32_t u32_clients, const void * pv_data,
+                                             uint16_t u16_len);
+static uint32_t u32_WSS_Get_Subscribers (WSS_inst_t x_inst, uint8_t u8_topic);
+static bool b_WSS_Process_Subscription (WSS_inst_t x_inst, uint8_t u8_client_id, const uint8_t * pu8_data,
+                                        uint16_t u16_len);
 
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -114,6 +211,9 @@ static bool b_WSS_Is_Client_Active (WSS_inst_t x_inst, uint8_t u8_client_id);
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
 
+/* Compressor of the data sent to clients */
+#include "ws_deflate.c"
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -197,8 +297,15 @@ void v_WSS_Register_Callback (WSS_inst_t x_inst, WSS_callback_t pfnc_cb, void *
 ** @brief
 **      Sends data to a Websocket Client
 **
-** @note
-**      This function cannot be called inside the context of event callback handler of this module
+** @details
+**      The data is copied once into a payload shared by the queues of all destination clients. The task of HTTP
+**      server sends the queued payloads and frees the payload after the last client. If the queue of a client is
+**      full, the Policy of the channel (see WSS_INST_TABLE) applies:
+**          + WSS_DROP_OLDEST: the oldest payload in the queue is dropped, this function never waits
+**          + WSS_BLOCK: this function waits up to WSS_BLOCK_TIMEOUT_MS for room, then drops the data. When called
+**            by the task of HTTP server (e.g. from the callback of the channel), it never waits because only this
+**            task can make room, the data is dropped right away.
+**      The caller can reuse its buffer right after this function returns.
 **
 ** @param [in]
 **      x_inst: Channel instance returned by x_WSS_Get_Inst() function
@@ -214,7 +321,7 @@ void v_WSS_Register_Callback (WSS_inst_t x_inst, WSS_callback_t pfnc_cb, void *
 **      u16_len: Length in bytes of the data to send
 **
 ** @return
-**      @arg    WSS_OK
+**      @arg    WSS_OK: The data has been queued to be sent to at least one client, or there is no client connected
 **      @arg    WSS_ERR
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -230,58 +337,239 @@ WSS_status_t enm_WSS_Send (WSS_inst_t x_inst, uint8_t u8_client_id, const void *
         LOGE ("Invalid Websocket client index %d", u8_client_id);
         return WSS_ERR;
     }
+    if ((u8_client_id < x_inst->u8_num_clients) && !x_inst->pstru_clients[u8_client_id].b_active)
+    {
+        LOGE ("The client index %d is not active", u8_client_id);
+        return WSS_ERR;
+    }
 
-    /* Construct data to send */
-    httpd_ws_frame_t stru_tx_frame =
+    /* Send to the given client or to all clients */
+    uint32_t u32_clients = (u8_client_id == WSS_ALL_CLIENTS) ? UINT32_MAX : (1UL << u8_client_id);
+    return enm_WSS_Send_To_Clients (x_inst, u32_clients, pv_data, u16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends data of a topic to the Websocket clients subscribing to it
+**
+** @details
+**      The same data is sent to all subscribers, regardless of their subscribed filter (mask). A subscriber that has
+**      received a message of the topic more recently than its maximum rate allows does not receive the data.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_topic: The topic (0 to WSS_MAX_TOPICS - 1)
+**
+** @param [in]
+**      pv_data: Pointer to the data to send
+**
+** @param [in]
+**      u16_len: Length in bytes of the data to send
+**
+** @return
+**      @arg    WSS_OK: The data has been queued to be sent to at least one subscriber, or there is no subscriber
+**      @arg    WSS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Send_Topic (WSS_inst_t x_inst, uint8_t u8_topic, const void * pv_data, uint16_t u16_len)
+{
+    /* Validation */
+    ASSERT_PARAM ((x_inst != NULL) && (x_inst->b_initialized) && (pv_data != NULL) && (u16_len > 0));
+    if (u8_topic >= WSS_MAX_TOPICS)
     {
-        .final          = true,
-        .fragmented     = false,
-        .type           = HTTPD_WS_TYPE_BINARY,
-        .len            = u16_len,
-        .payload        = (uint8_t *)pv_data,
-    };
+        LOGE ("Invalid topic %d", u8_topic);
+        return WSS_ERR;
+    }
+
+    return enm_WSS_Send_To_Clients (x_inst, u32_WSS_Get_Subscribers (x_inst, u8_topic), pv_data, u16_len);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Publishes data of a topic to the Websocket clients subscribing to it, encoding the data once per class of
+**      subscribers
+**
+** @details
+**      The subscribers having the same filter (mask) and the same encoding (see enm_WSS_Set_Encoding()) form a class.
+**      The encoding function is invoked once per class, then the encoded data is copied once and shared by the queues
+**      of all subscribers of the class. A subscriber that has received a message of the topic more recently than its
+**      maximum rate allows does not receive the data.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_topic: The topic (0 to WSS_MAX_TOPICS - 1)
+**
+** @param [in]
+**      pfnc_encode: Function encoding the data for a class of subscribers
+**
+** @param [in]
+**      pv_arg: Argument passed to pfnc_encode
+**
+** @return
+**      @arg    WSS_OK: The data has been queued to be sent to the subscribers, or there is no subscriber
+**      @arg    WSS_ERR: The data could not be queued to at least one class of subscribers
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Publish (WSS_inst_t x_inst, uint8_t u8_topic, WSS_encode_cb_t pfnc_encode, void * pv_arg)
+{
+    WSS_sub_class_t astru_classes[WSS_MAX_CHANNEL_CLIENTS];
+    uint8_t         u8_num_classes = 0;
+    WSS_status_t    enm_status = WSS_OK;
 
-    /* Sends data to the specified websocket channel(s) synchronously */
-    if (u8_client_id < x_inst->u8_num_clients)
+    /* Validation */
+    ASSERT_PARAM ((x_inst != NULL) && (x_inst->b_initialized) && (pfnc_encode != NULL));
+    if (u8_topic >= WSS_MAX_TOPICS)
+    {
+        LOGE ("Invalid topic %d", u8_topic);
+        return WSS_ERR;
+    }
+
+    /* Group the subscribers into classes */
+    uint32_t u32_subscribers = u32_WSS_Get_Subscribers (x_inst, u8_topic);
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    while (u32_subscribers != 0)
     {
+        uint8_t u8_client_id = __builtin_ctz (u32_subscribers);
+        u32_subscribers &= u32_subscribers - 1;
+
         WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
-        if (!pstru_client->b_active)
+        uint8_t u8_class_idx;
+        for (u8_class_idx = 0; u8_class_idx < u8_num_classes; u8_class_idx++)
         {
-            LOGE ("The client index %d is not active", u8_client_id);
-            return WSS_ERR;
+            if ((astru_classes[u8_class_idx].u32_mask == pstru_client->stru_sub.u32_mask) &&
+                (astru_classes[u8_class_idx].u8_encoding == pstru_client->u8_encoding))
+            {
+                break;
+            }
         }
-
-        esp_err_t x_err = httpd_ws_send_data (g_x_server, pstru_client->x_socket_fd, &stru_tx_frame);
-        if (x_err != ESP_OK)
+        if (u8_class_idx == u8_num_classes)
         {
-            LOGE ("Failed to send data to client index %d (%s)", u8_client_id, esp_err_to_name (x_err));
-
-            /* This client may be not active any more */
-            b_WSS_Is_Client_Active (x_inst, u8_client_id);
-            return WSS_ERR;
+            astru_classes[u8_class_idx].u32_mask = pstru_client->stru_sub.u32_mask;
+            astru_classes[u8_class_idx].u8_encoding = pstru_client->u8_encoding;
+            astru_classes[u8_class_idx].u32_clients = 0;
+            u8_num_classes++;
         }
+        SET_BITS (astru_classes[u8_class_idx].u32_clients, 1UL << u8_client_id);
     }
-    else
+    xSemaphoreGive (x_inst->x_mutex);
+
+    /* Encode the data once per class and send it to the subscribers of the class */
+    for (uint8_t u8_class_idx = 0; u8_class_idx < u8_num_classes; u8_class_idx++)
     {
-        /* Broadcast the data to all clients connecting with the channels */
-        for (uint8_t u8_idx = 0; u8_idx < x_inst->u8_num_clients; u8_idx++)
+        const void * pv_data = NULL;
+        uint16_t u16_len = pfnc_encode (astru_classes[u8_class_idx].u32_mask, astru_classes[u8_class_idx].u8_encoding,
+                                        pv_arg, &pv_data);
+        if ((u16_len > 0) && (pv_data != NULL) &&
+            (enm_WSS_Send_To_Clients (x_inst, astru_classes[u8_class_idx].u32_clients, pv_data, u16_len) != WSS_OK))
         {
-            /* Only send data to active client */
-            WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_idx];
-            if (pstru_client->b_active)
-            {
-                esp_err_t x_err = httpd_ws_send_data (g_x_server, pstru_client->x_socket_fd, &stru_tx_frame);
-                if (x_err != ESP_OK)
-                {
-                    LOGE ("Failed to send data to client index %d (%s)", u8_idx, esp_err_to_name (x_err));
-
-                    /* This client may be not active any more */
-                    b_WSS_Is_Client_Active (x_inst, u8_idx);
-                }
-            }
+            enm_status = WSS_ERR;
         }
     }
 
+    return enm_status;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Selects how the data published by enm_WSS_Publish() is encoded for a Websocket client
+**
+** @details
+**      The encoding is a value defined by the owner of the channel (e.g. binary or JSON format), it is passed to the
+**      encoding function of enm_WSS_Publish(). It is reset to 0 when a client connects to the slot.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_client_id: Index number of the client
+**
+** @param [in]
+**      u8_encoding: The encoding
+**
+** @return
+**      @arg    WSS_OK
+**      @arg    WSS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Set_Encoding (WSS_inst_t x_inst, uint8_t u8_client_id, uint8_t u8_encoding)
+{
+    /* Validation */
+    ASSERT_PARAM ((x_inst != NULL) && (x_inst->b_initialized));
+    if (u8_client_id >= x_inst->u8_num_clients)
+    {
+        LOGE ("Invalid Websocket client index %d", u8_client_id);
+        return WSS_ERR;
+    }
+
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    x_inst->pstru_clients[u8_client_id].u8_encoding = u8_encoding;
+    xSemaphoreGive (x_inst->x_mutex);
+
+    return WSS_OK;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets statistics of the queue of a Websocket client
+**
+** @details
+**      The statistics are reset when a client connects to the slot.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_client_id: Index number of the client
+**
+** @param [out]
+**      pstru_stats: The statistics of the client
+**
+** @return
+**      @arg    WSS_OK
+**      @arg    WSS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+WSS_status_t enm_WSS_Get_Stats (WSS_inst_t x_inst, uint8_t u8_client_id, WSS_stats_t * pstru_stats)
+{
+    /* Validation */
+    ASSERT_PARAM ((x_inst != NULL) && (x_inst->b_initialized) && (pstru_stats != NULL));
+    if (u8_client_id >= x_inst->u8_num_clients)
+    {
+        LOGE ("Invalid Websocket client index %d", u8_client_id);
+        return WSS_ERR;
+    }
+
+    /* Take a consistent snapshot of the counters */
+    WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    pstru_stats->b_active = pstru_client->b_active;
+    pstru_stats->u8_backlog = pstru_client->u8_count;
+    pstru_stats->u32_num_queued = pstru_client->u32_num_queued;
+    pstru_stats->u32_num_sent = pstru_client->u32_num_sent;
+    pstru_stats->u32_num_dropped = pstru_client->u32_num_dropped;
+    pstru_stats->u32_avg_latency = (pstru_client->u32_num_sent > 0) ?
+                                   (uint32_t)(pstru_client->u64_latency_sum / pstru_client->u32_num_sent) : 0;
+    pstru_stats->u32_max_latency = pstru_client->u32_max_latency;
+    pstru_stats->u32_num_raw_bytes = pstru_client->u32_num_raw_bytes;
+    pstru_stats->u32_num_tx_bytes = pstru_client->u32_num_tx_bytes;
+    xSemaphoreGive (x_inst->x_mutex);
+
     return WSS_OK;
 }
 
@@ -311,6 +599,7 @@ static int32_t s32_WSS_Init_Module (void)
     httpd_config_t stru_config = HTTPD_DEFAULT_CONFIG ();
     stru_config.max_open_sockets = u8_max_clients;
     stru_config.max_uri_handlers = WSS_NUM_INST;
+    stru_config.close_fn = v_WSS_Close_Session;
 
     esp_err_t x_err = httpd_start (&g_x_server, &stru_config);
     if (x_err != ESP_OK)
@@ -319,6 +608,14 @@ static int32_t s32_WSS_Init_Module (void)
         return STATUS_ERR;
     }
 
+    /* Find out which task runs the server */
+    x_err = httpd_queue_work (g_x_server, v_WSS_Get_Server_Task, NULL);
+    if (x_err != ESP_OK)
+    {
+        LOGE ("Failed to get the task of the Websocket server (%s)", esp_err_to_name (x_err));
+        return STATUS_ERR;
+    }
+
     return STATUS_OK;
 }
 
@@ -355,12 +652,38 @@ static int32_t s32_WSS_Init_Inst (WSS_inst_t x_inst)
         return STATUS_ERR;
     }
 
+    /* A set of clients must fit in a 32-bit mask */
+    if (x_inst->u8_num_clients > WSS_MAX_CHANNEL_CLIENTS)
+    {
+        LOGE ("Channel \"%s\" has more than %d clients", x_inst->pstri_uri, WSS_MAX_CHANNEL_CLIENTS);
+        return STATUS_ERR;
+    }
+
+    /* Create mutex protecting the queues of the clients */
+    x_inst->x_mutex = xSemaphoreCreateMutex ();
+    if (x_inst->x_mutex == NULL)
+    {
+        LOGE ("Failed to create mutex protecting the queues of Websocket clients");
+        return STATUS_ERR;
+    }
+
     /* Initialize Websocket client data of the channel */
     for (uint8_t u8_idx = 0; u8_idx < x_inst->u8_num_clients; u8_idx++)
     {
         WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_idx];
+        memset (pstru_client, 0, sizeof (WSS_client_t));
         pstru_client->b_active = false;
         pstru_client->x_socket_fd = -1;
+        pstru_client->x_inst = x_inst;
+        pstru_client->u8_client_id = u8_idx;
+        pstru_client->ppstru_queue = &x_inst->ppstru_queues[u8_idx * x_inst->u8_queue_size];
+
+        pstru_client->x_space_sem = xSemaphoreCreateBinary ();
+        if (pstru_client->x_space_sem == NULL)
+        {
+            LOGE ("Failed to create semaphore of Websocket client queue");
+            return STATUS_ERR;
+        }
     }
 
     return STATUS_OK;
@@ -390,6 +713,26 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
     {
         LOGI ("Handshake for URI \"%s\" done, the new connection was opened", pstru_request->uri);
 
+        /* Reserve a compression context if the client requests compressed data */
+        WSS_deflater_t * pstru_deflater = NULL;
+        if (x_inst->b_deflate && b_WSS_Deflate_Requested (pstru_request))
+        {
+            pstru_deflater = pstru_WSS_Deflate_Alloc ();
+            if (pstru_deflater == NULL)
+            {
+                /* Contexts of the clients that have gone may not have been released yet */
+                v_WSS_Check_All_Clients ();
+                pstru_deflater = pstru_WSS_Deflate_Alloc ();
+            }
+            if (pstru_deflater == NULL)
+            {
+                LOGE ("Number of clients requesting compressed data exceeds the maximum number. "
+                      "Closing the new connection");
+                httpd_sess_trigger_close (g_x_server, x_sock_fd);
+                return ESP_ERR_NO_MEM;
+            }
+        }
+
         /* Add this client connection to the channel */
         bool b_client_added = false;
         for (uint8_t u8_client_id = 0; u8_client_id < x_inst->u8_num_clients; u8_client_id++)
@@ -397,8 +740,26 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
             WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
             if (b_WSS_Is_Client_Active (x_inst, u8_client_id) == false)
             {
-                pstru_client->b_active = true;
+                /* Start with an empty queue and fresh statistics */
+                xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+                v_WSS_Flush_Queue (pstru_client);
+                pstru_client->u32_num_queued = 0;
+                pstru_client->u32_num_sent = 0;
+                pstru_client->u32_num_dropped = 0;
+                pstru_client->u32_num_drops_in_row = 0;
+                pstru_client->u64_latency_sum = 0;
+                pstru_client->u32_max_latency = 0;
+                pstru_client->u32_num_raw_bytes = 0;
+                pstru_client->u32_num_tx_bytes = 0;
+                pstru_client->pstru_deflater = pstru_deflater;
+                pstru_client->stru_sub.u8_topics = WSS_ALL_TOPICS;
+                pstru_client->stru_sub.u32_mask = UINT32_MAX;
+                pstru_client->stru_sub.u32_min_period = 0;
+                pstru_client->u8_encoding = 0;
+                pstru_client->b_closing = false;
                 pstru_client->x_socket_fd = x_sock_fd;
+                pstru_client->b_active = true;
+                xSemaphoreGive (x_inst->x_mutex);
                 b_client_added = true;
 
                 /* Invoke callback */
@@ -420,6 +781,7 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
         /* If there is no available room to add the client */
         if (!b_client_added)
         {
+            v_WSS_Deflate_Free (pstru_deflater);
             LOGE ("Number of clients exceeds the maximum number. Closing the new connection");
             httpd_sess_trigger_close (g_x_server, x_sock_fd);
             return ESP_ERR_NO_MEM;
@@ -476,11 +838,16 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
             if (u8_client_id == x_inst->u8_num_clients)
             {
                 LOGE ("There is no client corresponding with the received data");
+                free (stru_rx_frame.payload);
                 return ESP_ERR_NOT_FOUND;
             }
 
-            /* Invoke callback */
-            if (x_inst->pfnc_cb != NULL)
+            /* Subscription requests are processed by this module, other data is forwarded to the callback */
+            if (b_WSS_Process_Subscription (x_inst, u8_client_id, stru_rx_frame.payload, stru_rx_frame.len))
+            {
+                free (stru_rx_frame.payload);
+            }
+            else if (x_inst->pfnc_cb != NULL)
             {
                 WSS_evt_data_t stru_evt_data =
                 {
@@ -497,12 +864,56 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
                 x_inst->pfnc_cb (&stru_evt_data);
                 free (stru_rx_frame.payload);
             }
+            else
+            {
+                free (stru_rx_frame.payload);
+            }
         }
     }
 
     return x_err;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Callback invoked by the task of HTTP server when a session is closed, either by the client or by this module
+**
+** @details
+**      The client using the socket, if any, is removed right away, so that its slot and its compression context can
+**      be reused and the owner of the channel is notified. The socket is then closed.
+**
+** @param [in]
+**      x_server: Handle of the Websocket server
+**
+** @param [in]
+**      x_sock_fd: Socket descriptor of the session
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Close_Session (httpd_handle_t x_server, int x_sock_fd)
+{
+    for (uint8_t u8_inst_idx = 0; u8_inst_idx < WSS_NUM_INST; u8_inst_idx++)
+    {
+        WSS_inst_t x_inst = &g_astru_channel_objs[u8_inst_idx];
+        if (x_inst->b_initialized)
+        {
+            for (uint8_t u8_client_id = 0; u8_client_id < x_inst->u8_num_clients; u8_client_id++)
+            {
+                WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
+                if (pstru_client->b_active && (pstru_client->x_socket_fd == x_sock_fd))
+                {
+                    v_WSS_Remove_Client (x_inst, u8_client_id);
+                }
+            }
+        }
+    }
+
+    /* The server does not close the socket itself once this callback is set */
+    close (x_sock_fd);
+}
+
 /**
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **
@@ -517,7 +928,7 @@ static esp_err_t enm_WSS_Channel_Handler (httpd_req_t * pstru_request)
 **
 ** @return
 **      @arg    true: the client is still active
-**      @arg    true: the client is not active
+**      @arg    false: the client is not active
 **
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 */
@@ -535,26 +946,639 @@ static bool b_WSS_Is_Client_Active (WSS_inst_t x_inst, uint8_t u8_client_id)
         if (httpd_ws_get_fd_info (g_x_server, pstru_client->x_socket_fd) != HTTPD_WS_CLIENT_WEBSOCKET)
         {
             LOGW ("Client with socket descriptor %d is not active any more", pstru_client->x_socket_fd);
-            pstru_client->b_active = false;
-
-            /* Invoke callback */
-            if (x_inst->pfnc_cb != NULL)
-            {
-                WSS_evt_data_t stru_evt_data =
-                {
-                    .x_inst             = x_inst,
-                    .pv_arg             = x_inst->pv_cb_arg,
-                    .u8_client_id       = u8_client_id,
-                    .enm_evt            = WSS_EVT_CLIENT_DISCONNECTED,
-                };
-                x_inst->pfnc_cb (&stru_evt_data);
-            }
+            v_WSS_Remove_Client (x_inst, u8_client_id);
         }
     }
 
     return pstru_client->b_active;
 }
 
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Marks a client as inactive, releases its resources and invokes the relevant event callback. This function
+**      is executed by the task of HTTP server.
+**
+** @details
+**      Nothing is done if the client has already been removed.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_client_id: Index of the client to remove
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Remove_Client (WSS_inst_t x_inst, uint8_t u8_client_id)
+{
+    WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
+
+    /* Drop the data waiting to be sent to the client */
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    bool b_was_active = pstru_client->b_active;
+    pstru_client->b_active = false;
+    v_WSS_Flush_Queue (pstru_client);
+    xSemaphoreGive (x_inst->x_mutex);
+    if (!b_was_active)
+    {
+        return;
+    }
+
+    /* Release its compression context */
+    v_WSS_Deflate_Free (pstru_client->pstru_deflater);
+    pstru_client->pstru_deflater = NULL;
+
+    /* Invoke callback */
+    if (x_inst->pfnc_cb != NULL)
+    {
+        WSS_evt_data_t stru_evt_data =
+        {
+            .x_inst             = x_inst,
+            .pv_arg             = x_inst->pv_cb_arg,
+            .u8_client_id       = u8_client_id,
+            .enm_evt            = WSS_EVT_CLIENT_DISCONNECTED,
+        };
+        x_inst->pfnc_cb (&stru_evt_data);
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Adds a payload to the queue of a client, applying the policy of the channel if the queue is full
+**
+** @details
+**      The client is disconnected if Max_Drops payloads have been dropped since the last payload sent to it.
+**      With policy WSS_BLOCK, this function waits for room in the queue unless it is called by the task of HTTP
+**      server.
+**
+** @param [in]
+**      pstru_client: The client
+**
+** @param [in]
+**      pstru_payload: The payload
+**
+** @return
+**      @arg    true: The payload has been queued
+**      @arg    false: The payload has been dropped or the client is not connected
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_WSS_Enqueue (WSS_client_t * pstru_client, WSS_payload_t * pstru_payload)
+{
+    WSS_inst_t  x_inst = pstru_client->x_inst;
+    TickType_t  x_start_tick = xTaskGetTickCount ();
+    TickType_t  x_timeout = pdMS_TO_TICKS (WSS_BLOCK_TIMEOUT_MS);
+    bool        b_queued = false;
+
+    /* The task of HTTP server sends the payloads, so it would wait for itself */
+    bool b_wait = (x_inst->enm_policy == WSS_BLOCK) && (xTaskGetCurrentTaskHandle () != g_x_server_task);
+
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    int x_socket_fd = pstru_client->x_socket_fd;
+
+    /* If policy is WSS_BLOCK, wait until the client sends a payload, disconnects or the timeout expires */
+    while (b_wait && pstru_client->b_active &&
+           (pstru_client->u8_count >= x_inst->u8_queue_size))
+    {
+        TickType_t x_elapsed = xTaskGetTickCount () - x_start_tick;
+        if (x_elapsed >= x_timeout)
+        {
+            break;
+        }
+        xSemaphoreGive (x_inst->x_mutex);
+        xSemaphoreTake (pstru_client->x_space_sem, x_timeout - x_elapsed);
+        xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    }
+
+    /* The client may have disconnected (and its slot may be reused) meanwhile */
+    if (!pstru_client->b_active || pstru_client->b_closing || (pstru_client->x_socket_fd != x_socket_fd))
+    {
+        xSemaphoreGive (x_inst->x_mutex);
+        return false;
+    }
+
+    /* If the queue is full, make room by dropping the oldest payload, or drop the new one */
+    if (pstru_client->u8_count >= x_inst->u8_queue_size)
+    {
+        pstru_client->u32_num_dropped++;
+        pstru_client->u32_num_drops_in_row++;
+        if (x_inst->enm_policy == WSS_DROP_OLDEST)
+        {
+            v_WSS_Release_Payload (pstru_client->ppstru_queue[pstru_client->u8_head]);
+            pstru_client->u8_head = (pstru_client->u8_head + 1) % x_inst->u8_queue_size;
+            pstru_client->u8_count--;
+        }
+    }
+
+    /* Add the payload to the queue */
+    if (pstru_client->u8_count < x_inst->u8_queue_size)
+    {
+        uint8_t u8_tail = (pstru_client->u8_head + pstru_client->u8_count) % x_inst->u8_queue_size;
+        __atomic_add_fetch (&pstru_payload->u32_ref_count, 1, __ATOMIC_SEQ_CST);
+        pstru_client->ppstru_queue[u8_tail] = pstru_payload;
+        pstru_client->u8_count++;
+        pstru_client->u32_num_queued++;
+        b_queued = true;
+    }
+
+    /* Disconnect the client if it does not keep up with the data any more */
+    if ((x_inst->u32_max_drops != 0) && (pstru_client->u32_num_drops_in_row >= x_inst->u32_max_drops))
+    {
+        LOGW ("Client index %d of URI \"%s\" dropped %u messages in a row. Closing the connection",
+              pstru_client->u8_client_id, x_inst->pstri_uri, pstru_client->u32_num_drops_in_row);
+
+        /* Nothing is sent to the client any more, it is removed by v_WSS_Close_Session() once the session closes */
+        pstru_client->b_closing = true;
+        httpd_sess_trigger_close (g_x_server, x_socket_fd);
+    }
+
+    /* Request the task of HTTP server to send the queued payloads */
+    else if (b_queued && !pstru_client->b_draining)
+    {
+        esp_err_t x_err = httpd_queue_work (g_x_server, v_WSS_Drain_Work, pstru_client);
+        if (x_err == ESP_OK)
+        {
+            pstru_client->b_draining = true;
+        }
+        else
+        {
+            LOGE ("Failed to queue data to client index %d (%s)", pstru_client->u8_client_id,
+                  esp_err_to_name (x_err));
+        }
+    }
+
+    xSemaphoreGive (x_inst->x_mutex);
+    return b_queued;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Sends the oldest payload in the queue of a client. This function is executed by the task of HTTP server.
+**
+** @details
+**      Only one payload is sent per execution, then the request is queued again if the queue is not empty. This way
+**      the task of HTTP server serves all clients in turn and a slow client cannot hold it up.
+**
+** @param [in]
+**      pv_arg: The client (WSS_client_t)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Drain_Work (void * pv_arg)
+{
+    WSS_client_t *  pstru_client = (WSS_client_t *)pv_arg;
+    WSS_inst_t      x_inst = pstru_client->x_inst;
+
+    /* Take the oldest payload out of the queue */
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    if (pstru_client->b_closing)
+    {
+        v_WSS_Flush_Queue (pstru_client);
+    }
+    if (!pstru_client->b_active || (pstru_client->u8_count == 0))
+    {
+        pstru_client->b_draining = false;
+        xSemaphoreGive (x_inst->x_mutex);
+        return;
+    }
+    WSS_payload_t * pstru_payload = pstru_client->ppstru_queue[pstru_client->u8_head];
+    pstru_client->u8_head = (pstru_client->u8_head + 1) % x_inst->u8_queue_size;
+    pstru_client->u8_count--;
+    int x_socket_fd = pstru_client->x_socket_fd;
+    xSemaphoreGive (pstru_client->x_space_sem);
+    xSemaphoreGive (x_inst->x_mutex);
+
+    httpd_ws_frame_t stru_tx_frame =
+    {
+        .final          = true,
+        .fragmented     = false,
+        .type           = HTTPD_WS_TYPE_BINARY,
+        .len            = pstru_payload->u16_len,
+        .payload        = pstru_payload->au8_data,
+    };
+
+    /* Compress the payload if the client requested so */
+    uint8_t * pu8_deflated = NULL;
+    bool b_skipped = false;
+    if (pstru_client->pstru_deflater != NULL)
+    {
+        pu8_deflated = malloc (u32_WSS_Deflate_Bound (pstru_payload->u16_len));
+        if (pu8_deflated == NULL)
+        {
+            LOGE ("Failed to allocate memory (%d bytes) for compressed data", pstru_payload->u16_len);
+            b_skipped = true;
+        }
+        else
+        {
+            stru_tx_frame.len = u32_WSS_Deflate (pstru_client->pstru_deflater, pstru_payload->au8_data,
+                                                 pstru_payload->u16_len, pu8_deflated);
+            stru_tx_frame.payload = pu8_deflated;
+        }
+    }
+
+    /* Send the payload */
+    esp_err_t x_err = ESP_ERR_NO_MEM;
+    if (!b_skipped)
+    {
+        x_err = httpd_ws_send_frame_async (g_x_server, x_socket_fd, &stru_tx_frame);
+    }
+    uint32_t u32_latency = (uint32_t)(esp_timer_get_time () - pstru_payload->s64_queued_time);
+    uint16_t u16_raw_len = pstru_payload->u16_len;
+    v_WSS_Release_Payload (pstru_payload);
+    free (pu8_deflated);
+
+    /* Update statistics and continue with the next payload */
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    if ((x_err == ESP_OK) && (pstru_client->x_socket_fd == x_socket_fd))
+    {
+        pstru_client->u32_num_sent++;
+        pstru_client->u32_num_drops_in_row = 0;
+        pstru_client->u32_num_raw_bytes += u16_raw_len;
+        pstru_client->u32_num_tx_bytes += stru_tx_frame.len;
+        pstru_client->u64_latency_sum += u32_latency;
+        if (u32_latency > pstru_client->u32_max_latency)
+        {
+            pstru_client->u32_max_latency = u32_latency;
+        }
+    }
+    pstru_client->b_draining = false;
+    if (pstru_client->b_active && (pstru_client->u8_count > 0))
+    {
+        pstru_client->b_draining = (httpd_queue_work (g_x_server, v_WSS_Drain_Work, pstru_client) == ESP_OK);
+    }
+    xSemaphoreGive (x_inst->x_mutex);
+
+    if (b_skipped)
+    {
+        /* The payload has not been compressed, so the client can still decompress the next ones */
+        xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+        pstru_client->u32_num_dropped++;
+        xSemaphoreGive (x_inst->x_mutex);
+    }
+    else if (x_err != ESP_OK)
+    {
+        LOGE ("Failed to send data to client index %d (%s)", pstru_client->u8_client_id, esp_err_to_name (x_err));
+
+        /* This client may be not active any more, in which case its queued payloads are dropped */
+        /* Otherwise, the lost payload breaks the compressed stream of the client, so close the connection */
+        if (b_WSS_Is_Client_Active (x_inst, pstru_client->u8_client_id) && (pstru_client->pstru_deflater != NULL))
+        {
+            xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+            pstru_client->b_closing = true;
+            xSemaphoreGive (x_inst->x_mutex);
+            httpd_sess_trigger_close (g_x_server, x_socket_fd);
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Records the handle of the task of HTTP server. This function is executed by that task.
+**
+** @param [in]
+**      pv_arg: Not used
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Get_Server_Task (void * pv_arg)
+{
+    g_x_server_task = xTaskGetCurrentTaskHandle ();
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Drops all payloads in the queue of a client. The mutex of the channel must be held by the caller.
+**
+** @param [in]
+**      pstru_client: The client
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Flush_Queue (WSS_client_t * pstru_client)
+{
+    WSS_inst_t x_inst = pstru_client->x_inst;
+
+    while (pstru_client->u8_count > 0)
+    {
+        v_WSS_Release_Payload (pstru_client->ppstru_queue[pstru_client->u8_head]);
+        pstru_client->u8_head = (pstru_client->u8_head + 1) % x_inst->u8_queue_size;
+        pstru_client->u8_count--;
+    }
+    pstru_client->u8_head = 0;
+
+    /* Wake up the task waiting for room in the queue */
+    xSemaphoreGive (pstru_client->x_space_sem);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Queues data to a set of Websocket clients of a channel
+**
+** @details
+**      The data is copied once into a payload shared by the queues of all destination clients. Inactive clients in the
+**      set are ignored.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u32_clients: Client x is a destination if bit x is 1
+**
+** @param [in]
+**      pv_data: Pointer to the data to send
+**
+** @param [in]
+**      u16_len: Length in bytes of the data to send
+**
+** @return
+**      @arg    WSS_OK: The data has been queued to be sent to at least one client, or there is no active destination
+**      @arg    WSS_ERR
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static WSS_status_t enm_WSS_Send_To_Clients (WSS_inst_t x_inst, uint32_t u32_clients, const void * pv_data,
+                                             uint16_t u16_len)
+{
+    uint8_t u8_num_clients = 0;
+    uint8_t u8_num_queued = 0;
+
+    /* Count the destination clients */
+    for (uint8_t u8_idx = 0; u8_idx < x_inst->u8_num_clients; u8_idx++)
+    {
+        WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_idx];
+        if ((u32_clients & (1UL << u8_idx)) && pstru_client->b_active && !pstru_client->b_closing)
+        {
+            u8_num_clients++;
+        }
+    }
+    if (u8_num_clients == 0)
+    {
+        return WSS_OK;
+    }
+
+    /* Allocate the payload and copy the data */
+    WSS_payload_t * pstru_payload = malloc (sizeof (WSS_payload_t) + u16_len);
+    if (pstru_payload == NULL)
+    {
+        LOGE ("Failed to allocate memory (%d bytes) for data to send", u16_len);
+        return WSS_ERR;
+    }
+    pstru_payload->s64_queued_time = esp_timer_get_time ();
+    pstru_payload->u16_len = u16_len;
+    memcpy (pstru_payload->au8_data, pv_data, u16_len);
+
+    /* Hold a reference while queuing, so that the payload is not freed by a client sending it meanwhile */
+    pstru_payload->u32_ref_count = 1;
+
+    /* Queue the payload to each destination client */
+    for (uint8_t u8_idx = 0; u8_idx < x_inst->u8_num_clients; u8_idx++)
+    {
+        if ((u32_clients & (1UL << u8_idx)) && b_WSS_Enqueue (&x_inst->pstru_clients[u8_idx], pstru_payload))
+        {
+            u8_num_queued++;
+        }
+    }
+
+    /* Release the reference held while queuing */
+    v_WSS_Release_Payload (pstru_payload);
+
+    return (u8_num_queued > 0) ? WSS_OK : WSS_ERR;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the clients that subscribe to a topic and can receive a message of the topic now
+**
+** @details
+**      The time of the last message of the topic is updated for the returned clients, which are expected to receive
+**      the message.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_topic: The topic
+**
+** @return
+**      Client x can receive the message if bit x is 1
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint32_t u32_WSS_Get_Subscribers (WSS_inst_t x_inst, uint8_t u8_topic)
+{
+    uint32_t u32_clients = 0;
+    uint32_t u32_now = (uint32_t)(esp_timer_get_time () / 1000);
+
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    for (uint8_t u8_idx = 0; u8_idx < x_inst->u8_num_clients; u8_idx++)
+    {
+        WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_idx];
+        if (!pstru_client->b_active || pstru_client->b_closing ||
+            ALL_BITS_CLR (pstru_client->stru_sub.u8_topics, 1U << u8_topic))
+        {
+            continue;
+        }
+
+        /* Skip the client if its maximum rate of the topic would be exceeded */
+        if (pstru_client->stru_sub.u32_min_period != 0)
+        {
+            if (u32_now - pstru_client->au32_topic_times[u8_topic] < pstru_client->stru_sub.u32_min_period)
+            {
+                continue;
+            }
+            pstru_client->au32_topic_times[u8_topic] = u32_now;
+        }
+        SET_BITS (u32_clients, 1UL << u8_idx);
+    }
+    xSemaphoreGive (x_inst->x_mutex);
+
+    return u32_clients;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Records the subscription of a Websocket client if the received data is a subscription request
+**
+** @details
+**      A subscription request is a JSON message, all keys are optional:
+**          {"subscribe": {"topics": [<topic>, ...], "mask": <filter>, "rate": <messages per second>}}
+**      + topics: topics to receive, all topics if omitted
+**      + mask: channel-specific filter of the content (e.g. mask of measurements), everything if omitted
+**      + rate: maximum number of messages per second of each topic, no limit if omitted or 0. Rates below 1 are
+**        allowed (e.g. 0.1 for one message every 10 seconds).
+**      An invalid request is ignored and the client keeps its current subscription.
+**
+** @param [in]
+**      x_inst: Channel instance returned by x_WSS_Get_Inst() function
+**
+** @param [in]
+**      u8_client_id: Index of the client that sent the data
+**
+** @param [in]
+**      pu8_data: The received data
+**
+** @param [in]
+**      u16_len: Length in bytes of the received data
+**
+** @return
+**      @arg    true: The data is a subscription request, it has been processed
+**      @arg    false: The data is not a subscription request
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_WSS_Process_Subscription (WSS_inst_t x_inst, uint8_t u8_client_id, const uint8_t * pu8_data,
+                                        uint16_t u16_len)
+{
+    WSS_sub_t   stru_sub = { .u8_topics = WSS_ALL_TOPICS, .u32_mask = UINT32_MAX, .u32_min_period = 0 };
+    bool        b_valid = true;
+
+    /* Only JSON objects can be subscription requests */
+    if ((u16_len == 0) || (pu8_data[0] != '{'))
+    {
+        return false;
+    }
+    cJSON * px_json_root = cJSON_ParseWithLength ((const char *)pu8_data, u16_len);
+    cJSON * px_json_sub = cJSON_GetObjectItem (px_json_root, "subscribe");
+    if (!cJSON_IsObject (px_json_sub))
+    {
+        cJSON_Delete (px_json_root);
+        return false;
+    }
+
+    /* Parse the subscription */
+    cJSON * px_json_topics = cJSON_GetObjectItem (px_json_sub, "topics");
+    cJSON * px_json_mask = cJSON_GetObjectItem (px_json_sub, "mask");
+    cJSON * px_json_rate = cJSON_GetObjectItem (px_json_sub, "rate");
+    if (px_json_topics != NULL)
+    {
+        cJSON * px_json_topic;
+        stru_sub.u8_topics = 0;
+        b_valid = cJSON_IsArray (px_json_topics);
+        cJSON_ArrayForEach (px_json_topic, px_json_topics)
+        {
+            if (!cJSON_IsNumber (px_json_topic) || (px_json_topic->valueint < 0) ||
+                (px_json_topic->valueint >= WSS_MAX_TOPICS))
+            {
+                b_valid = false;
+                break;
+            }
+            SET_BITS (stru_sub.u8_topics, 1U << px_json_topic->valueint);
+        }
+    }
+    if (px_json_mask != NULL)
+    {
+        b_valid &= cJSON_IsNumber (px_json_mask) && (px_json_mask->valuedouble >= 0) &&
+                   (px_json_mask->valuedouble <= UINT32_MAX);
+        stru_sub.u32_mask = b_valid ? (uint32_t)px_json_mask->valuedouble : 0;
+    }
+    if (px_json_rate != NULL)
+    {
+        b_valid &= cJSON_IsNumber (px_json_rate) && (px_json_rate->valuedouble >= 0) &&
+                   (px_json_rate->valuedouble <= WSS_MAX_SUB_RATE);
+
+        /* The rate is converted into a period so that rates below 1 message per second are kept */
+        if (b_valid && (px_json_rate->valuedouble > 0))
+        {
+            double d_period = 1000.0 / px_json_rate->valuedouble;
+            stru_sub.u32_min_period = (d_period < WSS_MAX_SUB_PERIOD) ? (uint32_t)d_period : WSS_MAX_SUB_PERIOD;
+        }
+    }
+    cJSON_Delete (px_json_root);
+
+    if (!b_valid)
+    {
+        LOGW ("Invalid subscription request from client index %d of URI \"%s\"", u8_client_id, x_inst->pstri_uri);
+        return true;
+    }
+
+    /* Record the subscription, the client can receive a message of every topic right away */
+    WSS_client_t * pstru_client = &x_inst->pstru_clients[u8_client_id];
+    uint32_t u32_now = (uint32_t)(esp_timer_get_time () / 1000);
+    xSemaphoreTake (x_inst->x_mutex, portMAX_DELAY);
+    pstru_client->stru_sub = stru_sub;
+    for (uint8_t u8_topic = 0; u8_topic < WSS_MAX_TOPICS; u8_topic++)
+    {
+        pstru_client->au32_topic_times[u8_topic] = u32_now - stru_sub.u32_min_period;
+    }
+    xSemaphoreGive (x_inst->x_mutex);
+    LOGI ("Client index %d of URI \"%s\" subscribes to topics 0x%02X, mask 0x%08X, period %u ms",
+          u8_client_id, x_inst->pstri_uri, stru_sub.u8_topics, stru_sub.u32_mask, stru_sub.u32_min_period);
+
+    /* Invoke callback */
+    if (x_inst->pfnc_cb != NULL)
+    {
+        WSS_evt_data_t stru_evt_data =
+        {
+            .x_inst             = x_inst,
+            .pv_arg             = x_inst->pv_cb_arg,
+            .u8_client_id       = u8_client_id,
+            .enm_evt            = WSS_EVT_SUBSCRIBED,
+            .stru_sub           = stru_sub,
+        };
+        x_inst->pfnc_cb (&stru_evt_data);
+    }
+
+    return true;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks all clients of all channels, so that the resources of the clients that have gone are released
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Check_All_Clients (void)
+{
+    for (uint8_t u8_inst_idx = 0; u8_inst_idx < WSS_NUM_INST; u8_inst_idx++)
+    {
+        WSS_inst_t x_inst = &g_astru_channel_objs[u8_inst_idx];
+        if (x_inst->b_initialized)
+        {
+            for (uint8_t u8_client_id = 0; u8_client_id < x_inst->u8_num_clients; u8_client_id++)
+            {
+                b_WSS_Is_Client_Active (x_inst, u8_client_id);
+            }
+        }
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases a reference to a payload, the payload is freed when its last reference is released
+**
+** @param [in]
+**      pstru_payload: The payload
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Release_Payload (WSS_payload_t * pstru_payload)
+{
+    if (__atomic_sub_fetch (&pstru_payload->u32_ref_count, 1, __ATOMIC_SEQ_CST) == 0)
+    {
+        free (pstru_payload);
+    }
+}
+
 /**
 ** @}
 */
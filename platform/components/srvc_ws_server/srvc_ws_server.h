@@ -44,6 +44,27 @@ typedef enum
     WSS_ERR             = -1,           //!< There is unknown error while executing the function
 } WSS_status_t;
 
+/** @brief  What enm_WSS_Send() does when the queue of a client is full (Policy column of WSS_INST_TABLE) */
+typedef enum
+{
+    WSS_DROP_OLDEST,                    //!< Drop the oldest data in the queue, never wait
+    WSS_BLOCK,                          //!< Wait for room in the queue for a while, then drop the new data
+} WSS_policy_t;
+
+/** @brief  Number of topics a channel can publish with enm_WSS_Send_Topic() and enm_WSS_Publish() */
+#define WSS_MAX_TOPICS                  8
+
+/** @brief  All topics of one channel */
+#define WSS_ALL_TOPICS                  0xFF
+
+/** @brief  Subscription of a Websocket client to the data published on a channel */
+typedef struct
+{
+    uint8_t             u8_topics;      //!< Client receives topic x if bit x is 1
+    uint32_t            u32_mask;       //!< Channel-specific filter of the content (e.g. mask of measurements)
+    uint32_t            u32_min_period; //!< Minimum time (ms) between 2 messages of each topic, 0 = no limit
+} WSS_sub_t;
+
 /** @brief  Expand an entry in WSS_INST_TABLE as enumeration of instance ID */
 #define WSS_INST_TABLE_EXPAND_AS_INST_ID(INST_ID, ...)         INST_ID,
 typedef enum
@@ -65,6 +86,7 @@ typedef struct
         WSS_EVT_CLIENT_CONNECTED,       //!< A Websocket Client has been connected with the Server
         WSS_EVT_CLIENT_DISCONNECTED,    //!< A Websocket Client has been disconnected from the Server
         WSS_EVT_DATA_RECEIVED,          //!< The Server just received data from a Client
+        WSS_EVT_SUBSCRIBED,             //!< A Client has changed its subscription
     } enm_evt;
 
     /** @brief  Context data specific for WSS_EVT_DATA_RECEIVED */
@@ -74,6 +96,9 @@ typedef struct
         uint16_t        u16_len;        //!< Length in bytes of the received data
     } stru_receive;
 
+    /** @brief  Context data specific for WSS_EVT_SUBSCRIBED: the new subscription of the client */
+    WSS_sub_t           stru_sub;
+
 } WSS_evt_data_t;
 
 /** @brief  Callback invoked when an event occurs */
@@ -82,6 +107,30 @@ typedef void (*WSS_callback_t) (WSS_evt_data_t * pstru_evt_data);
 /** @brief  All clients of one channel. This is used for enm_WSS_Send() */
 #define WSS_ALL_CLIENTS                 0xFF
 
+/**
+** @brief   Function encoding data published with enm_WSS_Publish() for a class of subscribers
+** @param   u32_mask: Filter subscribed by the clients of the class
+** @param   u8_encoding: Encoding selected with enm_WSS_Set_Encoding() for the clients of the class
+** @param   pv_arg: Argument passed to enm_WSS_Publish()
+** @param   ppv_data: Pointer to the encoded data, which is copied before the function is invoked again
+** @return  Length in bytes of the encoded data, 0 if nothing is sent to the clients of the class
+*/
+typedef uint16_t (*WSS_encode_cb_t) (uint32_t u32_mask, uint8_t u8_encoding, void * pv_arg, const void ** ppv_data);
+
+/** @brief  Statistics of the queue of a Websocket client since it connected */
+typedef struct
+{
+    bool                b_active;           //!< The client is connected
+    uint8_t             u8_backlog;         //!< Number of messages currently waiting in the queue
+    uint32_t            u32_num_queued;     //!< Number of messages added to the queue
+    uint32_t            u32_num_sent;       //!< Number of messages sent
+    uint32_t            u32_num_dropped;    //!< Number of messages dropped because the queue was full
+    uint32_t            u32_avg_latency;    //!< Average time (us) from queuing to sending a message
+    uint32_t            u32_max_latency;    //!< Maximum time (us) from queuing to sending a message
+    uint32_t            u32_num_raw_bytes;  //!< Number of bytes of the messages sent, before compression
+    uint32_t            u32_num_tx_bytes;   //!< Number of bytes of the messages sent, after compression
+} WSS_stats_t;
+
 /*
 ** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 **                           PROTOTYPES SECTION
@@ -96,10 +145,26 @@ extern void v_WSS_Register_Callback (WSS_inst_t x_inst, WSS_callback_t pfnc_cb,
 
 /*
 ** Sends data to a Websocket Client of a channel. Use WSS_ALL_CLIENTS for u8_client_id to broadcast to all clients
-** Note: This function cannot be called inside the context of event callback handler of this module
+** Note: The data is queued and sent asynchronously by the task of HTTP server. If the queue of a client is full, the
+**       policy of the channel applies (see WSS_INST_TABLE)
 */
 extern WSS_status_t enm_WSS_Send (WSS_inst_t x_inst, uint8_t u8_client_id, const void * pv_data, uint16_t u16_len);
 
+/* Sends data of a topic to the clients subscribing to it, within the maximum rate of each client */
+extern WSS_status_t enm_WSS_Send_Topic (WSS_inst_t x_inst, uint8_t u8_topic, const void * pv_data, uint16_t u16_len);
+
+/*
+** Publishes data of a topic to the clients subscribing to it, within the maximum rate of each client. The data is
+** encoded once per class of clients having the same subscribed filter and the same encoding
+*/
+extern WSS_status_t enm_WSS_Publish (WSS_inst_t x_inst, uint8_t u8_topic, WSS_encode_cb_t pfnc_encode, void * pv_arg);
+
+/* Selects how the data published by enm_WSS_Publish() is encoded for a client */
+extern WSS_status_t enm_WSS_Set_Encoding (WSS_inst_t x_inst, uint8_t u8_client_id, uint8_t u8_encoding);
+
+/* Gets statistics of the queue of a Websocket client */
+extern WSS_status_t enm_WSS_Get_Stats (WSS_inst_t x_inst, uint8_t u8_client_id, WSS_stats_t * pstru_stats);
+
 #endif /* __SRVC_WS_SERVER_H__ */
 
 /**
@@ -46,6 +46,22 @@
 **
 ** - Max_Clients            : Maximum number of clients that can connect to the channel at a time
 **
+** - Queue_Size             : Maximum number of messages waiting to be sent to each client of the channel
+**
+** - Policy                 : What enm_WSS_Send() does when the queue of a client is full (slow client):
+**                              + WSS_DROP_OLDEST: Drop the oldest message in the queue to make room for the new one
+**                              + WSS_BLOCK: Wait up to WSS_BLOCK_TIMEOUT_MS for room, then drop the new message
+**
+** - Max_Drops              : The client is disconnected if this number of messages have been dropped since the last
+**                            message successfully sent to it. 0 to never disconnect the client.
+**
+** - Deflate                : true if clients can request compressed data by opening the URI with query "?deflate=1".
+**                            Every message is then sent as a binary frame compressed with DEFLATE (raw, no header),
+**                            in the format of permessage-deflate (RFC 7692) with context takeover: the client inflates
+**                            each message appended with bytes 0x00 0x00 0xFF 0xFF, keeping the same inflater for the
+**                            whole connection. At most CONFIG_WSS_DEFLATE_MAX_CLIENTS clients (of all channels) can
+**                            receive compressed data at a time.
+**
 */
 #define WSS_INST_TABLE(X)                                                        \
                                                                                  \
@@ -55,11 +71,19 @@
                                                                                  \
 /*  Channel monitoring slave board's status                                    */\
 X(  WSS_SLAVE_STATUS,       /* URI          */  "/slave/status"                 ,\
-                            /* Max_Clients  */  3                               )\
+                            /* Max_Clients  */  3                               ,\
+                            /* Queue_Size   */  16                              ,\
+                            /* Policy       */  WSS_BLOCK                       ,\
+                            /* Max_Drops    */  0                               ,\
+                            /* Deflate      */  true                            )\
                                                                                  \
 /*  Channel of slave board's realtime log messages                             */\
 X(  WSS_SLAVE_RTLOG,        /* URI          */  "/slave/rtlog"                  ,\
-                            /* Max_Clients  */  3                               )\
+                            /* Max_Clients  */  3                               ,\
+                            /* Queue_Size   */  8                               ,\
+                            /* Policy       */  WSS_DROP_OLDEST                 ,\
+                            /* Max_Drops    */  200                             ,\
+                            /* Deflate      */  true                            )\
                                                                                  \
 /*-----------------------------------------------------------------------------*/
 
@@ -0,0 +1,497 @@
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+**  @file       : ws_deflate.c
+**  @author     : Nguyen Ngoc Tung (ngoctung.dhbk@gmail.com)
+**  @date       : 2022 Nov 28
+**  @brief      : This file contains the small-window DEFLATE compressor of the data sent to Websocket clients.
+**                srvc_ws_server.c includes this file directly.
+**  @namespace  : WSS
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** @addtogroup  Srvc_WS_Server
+** @{
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           INCLUDES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           DEFINES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Maximum number of clients that can receive compressed data at a time */
+#define WSS_DEFLATE_MAX_CLIENTS         CONFIG_WSS_DEFLATE_MAX_CLIENTS
+
+/** @brief  Size in bytes of the history window that compressed data can refer to */
+#define WSS_DEFLATE_WINDOW_SIZE         (1U << CONFIG_WSS_DEFLATE_WINDOW_BITS)
+
+/** @brief  Number of bits of the hash of 3 bytes used to find matches in the history */
+#define WSS_DEFLATE_HASH_BITS           (CONFIG_WSS_DEFLATE_WINDOW_BITS - 1)
+
+/** @brief  Minimum and maximum length of a match (RFC 1951) */
+#define WSS_DEFLATE_MIN_MATCH           3
+#define WSS_DEFLATE_MAX_MATCH           258
+
+/** @brief  Symbol of the end of a block (RFC 1951) */
+#define WSS_DEFLATE_END_OF_BLOCK        256
+
+/** @brief  Name and value of the query parameter of the URI requesting compression */
+#define WSS_DEFLATE_QUERY_KEY           "deflate"
+#define WSS_DEFLATE_QUERY_VALUE         "1"
+
+/**
+** @brief   Compression context of a client. The history and the hash table are kept from a message to the next
+**          ones (context takeover), so that a message can refer to the data of previous messages.
+*/
+typedef struct WSS_deflater
+{
+    bool            b_in_use;                                       //!< The context is used by a client
+    uint32_t        u32_total_len;                                  //!< Number of bytes compressed so far
+    uint16_t        au16_hash [1U << WSS_DEFLATE_HASH_BITS];        //!< Last position (mod 65536) of each hash
+    uint8_t         au8_window [WSS_DEFLATE_WINDOW_SIZE];           //!< Last bytes compressed, indexed by position
+} WSS_deflater_t;
+
+/** @brief  Writer of a bit stream, least significant bit first (RFC 1951) */
+typedef struct
+{
+    uint8_t *       pu8_out;                //!< Output buffer
+    uint32_t        u32_len;                //!< Number of complete bytes written
+    uint32_t        u32_bits;               //!< Bits not written yet
+    uint8_t         u8_num_bits;            //!< Number of bits not written yet
+} WSS_bit_writer_t;
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           VARIABLES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/** @brief  Compression contexts, only accessed by the task of HTTP server */
+static WSS_deflater_t g_astru_deflaters [WSS_DEFLATE_MAX_CLIENTS];
+
+/** @brief  Base length and number of extra bits of length codes 257..285 */
+static const uint16_t g_au16_length_base [] =
+{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t g_au8_length_extra [] =
+{
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/** @brief  Base distance and number of extra bits of distance codes 0..29 */
+static const uint16_t g_au16_dist_base [] =
+{
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097,
+    6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t g_au8_dist_extra [] =
+{
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           PROTOTYPES SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+static bool b_WSS_Deflate_Requested (httpd_req_t * pstru_request);
+static WSS_deflater_t * pstru_WSS_Deflate_Alloc (void);
+static void v_WSS_Deflate_Free (WSS_deflater_t * pstru_deflater);
+static uint32_t u32_WSS_Deflate_Bound (uint16_t u16_len);
+static uint32_t u32_WSS_Deflate (WSS_deflater_t * pstru_deflater, const uint8_t * pu8_data, uint16_t u16_len,
+                                 uint8_t * pu8_out);
+static uint8_t u8_WSS_Deflate_Byte_At (const WSS_deflater_t * pstru_deflater, const uint8_t * pu8_data,
+                                       uint32_t u32_pos);
+static uint32_t u32_WSS_Deflate_Hash (const uint8_t * pu8_data);
+static void v_WSS_Put_Bits (WSS_bit_writer_t * pstru_writer, uint32_t u32_value, uint8_t u8_num_bits);
+static void v_WSS_Put_Symbol (WSS_bit_writer_t * pstru_writer, uint16_t u16_symbol);
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           FUNCTIONS SECTION
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Checks if a client requests compressed data when it opens the connection (URI query "deflate=1")
+**
+** @param [in]
+**      pstru_request: The handshake request of the client
+**
+** @return
+**      @arg    true: Compression is requested
+**      @arg    false: Compression is not requested
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static bool b_WSS_Deflate_Requested (httpd_req_t * pstru_request)
+{
+    char stri_query[32];
+    char stri_value[4];
+
+    if ((httpd_req_get_url_query_len (pstru_request) == 0) ||
+        (httpd_req_get_url_query_str (pstru_request, stri_query, sizeof (stri_query)) != ESP_OK) ||
+        (httpd_query_key_value (stri_query, WSS_DEFLATE_QUERY_KEY, stri_value, sizeof (stri_value)) != ESP_OK))
+    {
+        return false;
+    }
+    return (strcmp (stri_value, WSS_DEFLATE_QUERY_VALUE) == 0);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Allocates a fresh compression context for a client
+**
+** @return
+**      @arg    NULL: All contexts are in use
+**      @arg    Otherwise: The context
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static WSS_deflater_t * pstru_WSS_Deflate_Alloc (void)
+{
+    for (uint8_t u8_idx = 0; u8_idx < WSS_DEFLATE_MAX_CLIENTS; u8_idx++)
+    {
+        WSS_deflater_t * pstru_deflater = &g_astru_deflaters[u8_idx];
+        if (!pstru_deflater->b_in_use)
+        {
+            pstru_deflater->b_in_use = true;
+            pstru_deflater->u32_total_len = 0;
+            memset (pstru_deflater->au16_hash, 0, sizeof (pstru_deflater->au16_hash));
+            return pstru_deflater;
+        }
+    }
+    return NULL;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Releases the compression context of a client
+**
+** @param [in]
+**      pstru_deflater: The context, NULL is ignored
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Deflate_Free (WSS_deflater_t * pstru_deflater)
+{
+    if (pstru_deflater != NULL)
+    {
+        pstru_deflater->b_in_use = false;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the maximum length of the compressed data of a message
+**
+** @details
+**      In the worst case, every byte is a literal of 9 bits. The block header, the end of block and the empty stored
+**      block of the flush take 13 more bits.
+**
+** @param [in]
+**      u16_len: Length in bytes of the message
+**
+** @return
+**      Maximum length in bytes of the compressed message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint32_t u32_WSS_Deflate_Bound (uint16_t u16_len)
+{
+    return (u16_len * 9UL) / 8 + 4;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Compresses a message in the format of permessage-deflate (RFC 7692)
+**
+** @details
+**      The message is encoded as one DEFLATE block with fixed Huffman codes, followed by an empty stored block to
+**      align the stream on a byte boundary. The last 4 bytes of the stored block (0x00 0x00 0xFF 0xFF) are not
+**      output, the client appends them before inflating. Matches are found with a hash table of the last position
+**      of each 3-byte sequence, and can refer to the previous messages within the history window.
+**
+** @param [in]
+**      pstru_deflater: Compression context of the client
+**
+** @param [in]
+**      pu8_data: The message
+**
+** @param [in]
+**      u16_len: Length in bytes of the message
+**
+** @param [out]
+**      pu8_out: Buffer of at least u32_WSS_Deflate_Bound() bytes receiving the compressed message
+**
+** @return
+**      Length in bytes of the compressed message
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint32_t u32_WSS_Deflate (WSS_deflater_t * pstru_deflater, const uint8_t * pu8_data, uint16_t u16_len,
+                                 uint8_t * pu8_out)
+{
+    WSS_bit_writer_t stru_writer =
+    {
+        .pu8_out        = pu8_out,
+        .u32_len        = 0,
+        .u32_bits       = 0,
+        .u8_num_bits    = 0,
+    };
+    uint32_t u32_base = pstru_deflater->u32_total_len;
+    uint16_t u16_idx = 0;
+
+    /* Block header: not final, fixed Huffman codes */
+    v_WSS_Put_Bits (&stru_writer, 0, 1);
+    v_WSS_Put_Bits (&stru_writer, 1, 2);
+
+    while (u16_idx < u16_len)
+    {
+        uint32_t    u32_pos = u32_base + u16_idx;
+        uint16_t    u16_match_len = 0;
+        uint16_t    u16_match_dist = 0;
+        uint16_t    u16_max_len = u16_len - u16_idx;
+        uint32_t    u32_hash = 0;
+
+        /* Look for a match at the last position of the same hash */
+        if (u16_max_len >= WSS_DEFLATE_MIN_MATCH)
+        {
+            u32_hash = u32_WSS_Deflate_Hash (&pu8_data[u16_idx]);
+            uint16_t u16_dist = (uint16_t)(u32_pos - pstru_deflater->au16_hash[u32_hash]);
+            if ((u16_dist > 0) && (u16_dist <= WSS_DEFLATE_WINDOW_SIZE) && (u16_dist <= u32_pos))
+            {
+                if (u16_max_len > WSS_DEFLATE_MAX_MATCH)
+                {
+                    u16_max_len = WSS_DEFLATE_MAX_MATCH;
+                }
+                while ((u16_match_len < u16_max_len) &&
+                       (u8_WSS_Deflate_Byte_At (pstru_deflater, pu8_data, u32_pos - u16_dist + u16_match_len) ==
+                        pu8_data[u16_idx + u16_match_len]))
+                {
+                    u16_match_len++;
+                }
+                u16_match_dist = u16_dist;
+            }
+            pstru_deflater->au16_hash[u32_hash] = (uint16_t)u32_pos;
+        }
+
+        /* Output a literal */
+        if (u16_match_len < WSS_DEFLATE_MIN_MATCH)
+        {
+            v_WSS_Put_Symbol (&stru_writer, pu8_data[u16_idx]);
+            u16_idx++;
+            continue;
+        }
+
+        /* Output a match: length code and its extra bits, then distance code and its extra bits */
+        uint8_t u8_code = sizeof (g_au16_length_base) / sizeof (g_au16_length_base[0]) - 1;
+        while (g_au16_length_base[u8_code] > u16_match_len)
+        {
+            u8_code--;
+        }
+        v_WSS_Put_Symbol (&stru_writer, 257 + u8_code);
+        v_WSS_Put_Bits (&stru_writer, u16_match_len - g_au16_length_base[u8_code], g_au8_length_extra[u8_code]);
+
+        u8_code = sizeof (g_au16_dist_base) / sizeof (g_au16_dist_base[0]) - 1;
+        while (g_au16_dist_base[u8_code] > u16_match_dist)
+        {
+            u8_code--;
+        }
+        uint8_t u8_reversed = 0;
+        for (uint8_t u8_bit = 0; u8_bit < 5; u8_bit++)
+        {
+            u8_reversed |= ((u8_code >> u8_bit) & 1) << (4 - u8_bit);
+        }
+        v_WSS_Put_Bits (&stru_writer, u8_reversed, 5);
+        v_WSS_Put_Bits (&stru_writer, u16_match_dist - g_au16_dist_base[u8_code], g_au8_dist_extra[u8_code]);
+
+        /* Index the positions inside the match so that following data can refer to them */
+        for (uint16_t u16_next = u16_idx + 1; u16_next < u16_idx + u16_match_len; u16_next++)
+        {
+            if (u16_next + WSS_DEFLATE_MIN_MATCH <= u16_len)
+            {
+                pstru_deflater->au16_hash[u32_WSS_Deflate_Hash (&pu8_data[u16_next])] = (uint16_t)(u32_base + u16_next);
+            }
+        }
+        u16_idx += u16_match_len;
+    }
+
+    /* End of block, then the header of an empty stored block (not final) aligned on a byte boundary */
+    v_WSS_Put_Symbol (&stru_writer, WSS_DEFLATE_END_OF_BLOCK);
+    v_WSS_Put_Bits (&stru_writer, 0, 3);
+    if (stru_writer.u8_num_bits > 0)
+    {
+        v_WSS_Put_Bits (&stru_writer, 0, 8 - stru_writer.u8_num_bits);
+    }
+
+    /* Keep the end of the message in the history */
+    uint16_t u16_start = (u16_len > WSS_DEFLATE_WINDOW_SIZE) ? (u16_len - WSS_DEFLATE_WINDOW_SIZE) : 0;
+    for (u16_idx = u16_start; u16_idx < u16_len; u16_idx++)
+    {
+        pstru_deflater->au8_window[(u32_base + u16_idx) & (WSS_DEFLATE_WINDOW_SIZE - 1)] = pu8_data[u16_idx];
+    }
+    pstru_deflater->u32_total_len += u16_len;
+
+    return stru_writer.u32_len;
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the byte at a position of the stream, either in the history or in the message being compressed
+**
+** @param [in]
+**      pstru_deflater: Compression context of the client
+**
+** @param [in]
+**      pu8_data: The message being compressed
+**
+** @param [in]
+**      u32_pos: Position of the byte in the stream, not older than the history window
+**
+** @return
+**      The byte
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint8_t u8_WSS_Deflate_Byte_At (const WSS_deflater_t * pstru_deflater, const uint8_t * pu8_data,
+                                       uint32_t u32_pos)
+{
+    if (u32_pos < pstru_deflater->u32_total_len)
+    {
+        return pstru_deflater->au8_window[u32_pos & (WSS_DEFLATE_WINDOW_SIZE - 1)];
+    }
+    return pu8_data[u32_pos - pstru_deflater->u32_total_len];
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Gets the hash of 3 consecutive bytes
+**
+** @param [in]
+**      pu8_data: Pointer to the bytes
+**
+** @return
+**      The hash, in range [0, 2^WSS_DEFLATE_HASH_BITS)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static uint32_t u32_WSS_Deflate_Hash (const uint8_t * pu8_data)
+{
+    uint32_t u32_key = ((uint32_t)pu8_data[0] << 16) | ((uint32_t)pu8_data[1] << 8) | pu8_data[2];
+    return (uint32_t)(u32_key * 2654435761U) >> (32 - WSS_DEFLATE_HASH_BITS);
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes bits to a bit stream, least significant bit first
+**
+** @param [in]
+**      pstru_writer: The bit stream
+**
+** @param [in]
+**      u32_value: The bits
+**
+** @param [in]
+**      u8_num_bits: Number of bits to write (at most 16)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Put_Bits (WSS_bit_writer_t * pstru_writer, uint32_t u32_value, uint8_t u8_num_bits)
+{
+    pstru_writer->u32_bits |= u32_value << pstru_writer->u8_num_bits;
+    pstru_writer->u8_num_bits += u8_num_bits;
+    while (pstru_writer->u8_num_bits >= 8)
+    {
+        pstru_writer->pu8_out[pstru_writer->u32_len++] = (uint8_t)pstru_writer->u32_bits;
+        pstru_writer->u32_bits >>= 8;
+        pstru_writer->u8_num_bits -= 8;
+    }
+}
+
+/**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**
+** @brief
+**      Writes a literal/length symbol with its fixed Huffman code (RFC 1951 section 3.2.6)
+**
+** @param [in]
+**      pstru_writer: The bit stream
+**
+** @param [in]
+**      u16_symbol: The symbol (0..287)
+**
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/
+static void v_WSS_Put_Symbol (WSS_bit_writer_t * pstru_writer, uint16_t u16_symbol)
+{
+    uint16_t    u16_code;
+    uint8_t     u8_num_bits;
+
+    if (u16_symbol < 144)
+    {
+        u16_code = 0x30 + u16_symbol;
+        u8_num_bits = 8;
+    }
+    else if (u16_symbol < 256)
+    {
+        u16_code = 0x190 + (u16_symbol - 144);
+        u8_num_bits = 9;
+    }
+    else if (u16_symbol < 280)
+    {
+        u16_code = u16_symbol - 256;
+        u8_num_bits = 7;
+    }
+    else
+    {
+        u16_code = 0xC0 + (u16_symbol - 280);
+        u8_num_bits = 8;
+    }
+
+    /* Huffman codes are packed starting with their most significant bit */
+    uint16_t u16_reversed = 0;
+    for (uint8_t u8_bit = 0; u8_bit < u8_num_bits; u8_bit++)
+    {
+        u16_reversed |= ((u16_code >> u8_bit) & 1) << (u8_num_bits - 1 - u8_bit);
+    }
+    v_WSS_Put_Bits (pstru_writer, u16_reversed, u8_num_bits);
+}
+
+/**
+** @}
+*/
+
+/*
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+**                           END OF FILE
+** * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+*/